@@ -43,6 +43,9 @@
 #include <errno.h>
 #include <dirent.h>
 #include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <time.h>
 
 /* <bf_syslib> includes */
 #include <target-sys/bf_sal/bf_sys_intf.h>
@@ -2801,13 +2804,13 @@ bf_status_t bf_switchd_device_remove(bf_dev_id_t dev_id) {
   if (!bf_dev_id_validate(dev_id)) return BF_INVALID_ARG;
   if (!switchd_ctx->asic[dev_id].configured) return BF_OBJECT_NOT_FOUND;
 
-  bf_sys_mutex_lock(&switchd_ctx->asic[dev_id].switch_mutex);
+  bf_sys_rwlock_wrlock(&switchd_ctx->asic[dev_id].switch_lock);
   if (!switchd_ctx->state[dev_id].device_ready) {
-    bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
+    bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
     return BF_OBJECT_NOT_FOUND;
   }
   switchd_ctx->state[dev_id].device_ready = false;
-  bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
+  bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
   bf_status_t sts = bf_device_remove(dev_id);
   if (sts != BF_SUCCESS) return sts;
   bf_switchd_release_dma_mem(dev_id, 0);
@@ -2887,7 +2890,8 @@ static int bf_switchd_check_for_interrupts_or_timeout(
                          "ERROR: select() failed with ret_code %d",
                          err);
   }
-  return 0;
+  /* Number of devices with pending interrupts. */
+  return err > 0 ? err : 0;
 }
 
 static bf_status_t bf_switchd_check_for_port_interrupts(void) {
@@ -3613,9 +3617,9 @@ static bf_status_t bf_switchd_warm_init_begin(
   }
 
   /* Only if device is ready do fast-reconfig */
-  bf_sys_mutex_lock(&switchd_ctx->asic[dev_id].switch_mutex);
+  bf_sys_rwlock_wrlock(&switchd_ctx->asic[dev_id].switch_lock);
   if (switchd_ctx->state[dev_id].device_ready == false) {
-    bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
+    bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
     return BF_NOT_READY;
   }
 
@@ -3638,7 +3642,7 @@ static bf_status_t bf_switchd_warm_init_begin(
   switchd_ctx->state[dev_id].device_locked = true;
   switchd_ctx->state[dev_id].device_pktmgr_ready = false;
   bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].pktmgr_mutex);
-  bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
+  bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
 
   if (upgrade_agents) {
 #ifdef THRIFT_ENABLED
@@ -4418,80 +4422,342 @@ static bf_status_t bf_switchd_reg_rd_fn(bf_dev_id_t dev_id,
   return BF_SUCCESS;
 }
 
+/* DMA completion service.
+ *
+ * The DRs the DMA thread services are split into classes, one per service
+ * routine.  The devices are spread round-robin over a pool of worker threads
+ * (one by default) which may optionally be pinned to consecutive CPUs, so
+ * all the DRs of a device are serviced by the same worker, in order.  Each
+ * worker adapts its polling rate to the completion traffic: while completions
+ * are arriving it polls back to back, once they stop it backs off with an
+ * exponentially growing sleep, capped at dma_svc_max_sleep_us.  A sleeping
+ * worker can be woken early through its eventfd, see
+ * bf_switchd_dma_svc_wakeup(), which the interrupt thread calls after
+ * servicing device interrupts. */
+#define BF_SWITCHD_DMA_SVC_MAX_SLEEP_US 300
+#define BF_SWITCHD_DMA_SVC_MIN_SLEEP_US 10
+/* Number of idle passes a worker spins (yielding the CPU) before it starts
+ * sleeping. */
+#define BF_SWITCHD_DMA_SVC_IDLE_SPINS 64
+
+typedef struct bf_switchd_dma_svc_class_s {
+  const char *name;
+  bool needs_pipe_mgr; /* Only serviced when pipe_mgr is not skipped. */
+  bool tof2_plus;      /* DRs which do not exist on Tofino. */
+  void (*service)(bf_dev_id_t dev_id);
+  /* Completion DRs used to measure the pending work of this class. */
+  int num_drs;
+  bf_dma_dr_id_t drs[4];
+} bf_switchd_dma_svc_class_t;
+
+static void dma_svc_learn(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_learning(dev_id);
+}
+static void dma_svc_idle(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_idle_time(dev_id);
+}
+static void dma_svc_stats(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_stats(dev_id);
+}
+static void dma_svc_rb(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_read_block_completion(dev_id);
+}
+static void dma_svc_wb(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_write_block_completion(dev_id);
+}
+static void dma_svc_ilist(bf_dev_id_t dev_id) {
+  bf_dma_service_pipe_ilist_completion(dev_id);
+}
+static void dma_svc_wl(bf_dev_id_t dev_id) {
+  bf_dma_service_write_list_completion(dev_id);
+}
+static void dma_svc_mac_stats(bf_dev_id_t dev_id) {
+  bf_dma_service_mac_stats(dev_id, 256);
+}
+static void dma_svc_rb0(bf_dev_id_t dev_id) {
+  bf_dma_service_read_block0_completion(dev_id);
+}
+static void dma_svc_rb1(bf_dev_id_t dev_id) {
+  bf_dma_service_read_block1_completion(dev_id);
+}
+static void dma_svc_wl1(bf_dev_id_t dev_id) {
+  bf_dma_service_write_list1_completion(dev_id);
+}
+
+static const bf_switchd_dma_svc_class_t dma_svc_classes[] = {
+    {"learn", true, false, dma_svc_learn, 1, {lld_dr_rx_learn}},
+    {"idle", true, false, dma_svc_idle, 1, {lld_dr_rx_idle}},
+    {"stats", true, false, dma_svc_stats, 1, {lld_dr_rx_lrt}},
+    {"read_blk", true, false, dma_svc_rb, 1, {lld_dr_cmp_pipe_read_blk}},
+    {"write_blk", true, false, dma_svc_wb, 1, {lld_dr_cmp_pipe_write_blk}},
+    {"ilist",
+     true,
+     false,
+     dma_svc_ilist,
+     4,
+     {lld_dr_cmp_pipe_inst_list_0,
+      lld_dr_cmp_pipe_inst_list_1,
+      lld_dr_cmp_pipe_inst_list_2,
+      lld_dr_cmp_pipe_inst_list_3}},
+    {"write_list", false, false, dma_svc_wl, 1, {lld_dr_cmp_que_write_list}},
+    {"mac_stats", false, false, dma_svc_mac_stats, 1, {lld_dr_cmp_mac_stat}},
+    {"que_rb0", false, true, dma_svc_rb0, 1, {lld_dr_cmp_que_read_block_0}},
+    {"que_rb1", false, true, dma_svc_rb1, 1, {lld_dr_cmp_que_read_block_1}},
+    {"write_list1",
+     false,
+     true,
+     dma_svc_wl1,
+     1,
+     {lld_dr_cmp_que_write_list_1}},
+};
+#define BF_SWITCHD_DMA_SVC_NUM_CLASSES \
+  (int)(sizeof dma_svc_classes / sizeof dma_svc_classes[0])
+
+typedef struct bf_switchd_dma_svc_worker_s {
+  int idx;
+  int efd; /* eventfd used to wake the worker while it sleeps. */
+  pthread_t t_id;
+  bf_switchd_dma_svc_stats_t stats;
+  /* Start and completion count of the current one second rate window. */
+  uint64_t window_start_ns;
+  uint64_t window_completions;
+} bf_switchd_dma_svc_worker_t;
+
+static bf_switchd_dma_svc_worker_t dma_svc_workers[BF_MAX_DEV_COUNT];
+static int dma_svc_num_workers = 0;
+
+static uint64_t dma_svc_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* Return the number of completions waiting in the DRs of a service class. */
+static int dma_svc_pending(bf_dev_id_t dev_id,
+                           uint32_t num_subdev,
+                           const bf_switchd_dma_svc_class_t *cls) {
+  int pending = 0;
+  /* Subdevices which are not present report an error rather than a count. */
+  for (uint32_t subdev_id = 0; subdev_id < num_subdev; subdev_id++) {
+    for (int i = 0; i < cls->num_drs; i++) {
+      int used = lld_dr_get_used_count(dev_id, subdev_id, cls->drs[i], true);
+      if (used > 0) pending += used;
+    }
+  }
+  return pending;
+}
+
+/* Run one service pass over the devices owned by a worker and return the
+ * number of completions which were waiting. */
+static uint64_t dma_svc_pass(bf_switchd_dma_svc_worker_t *w) {
+  uint64_t completions = 0;
+  bf_dev_id_t dev_id;
+
+  for (dev_id = w->idx; dev_id < BF_MAX_DEV_COUNT;
+       dev_id += dma_svc_num_workers) {
+    switchd_state_t *dev_state = &(switchd_ctx->state[dev_id]);
+    uint32_t num_subdev = 1;
+
+    if (!switchd_ctx->asic[dev_id].configured) continue;
+
+    bf_sys_rwlock_rdlock(&switchd_ctx->asic[dev_id].switch_lock);
+    if (!dev_state->device_ready || switchd_ctx->asic[dev_id].is_virtual ||
+        dev_state->device_locked) {
+      bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
+      continue;
+    }
+    if (lld_sku_get_num_subdev(dev_id, &num_subdev, NULL) != LLD_OK) {
+      num_subdev = 1;
+    }
+
+    /* Perform per-device periodic processing tasks */
+    for (int c = 0; c < BF_SWITCHD_DMA_SVC_NUM_CLASSES; c++) {
+      const bf_switchd_dma_svc_class_t *cls = &dma_svc_classes[c];
+      if (cls->needs_pipe_mgr && switchd_ctx->args.skip_hld.pipe_mgr) continue;
+      if (cls->tof2_plus &&
+          switchd_ctx->asic[dev_id].chip_family == BF_DEV_FAMILY_TOFINO)
+        continue;
+      completions += dma_svc_pending(dev_id, num_subdev, cls);
+      cls->service(dev_id);
+    }
+    bf_sys_rwlock_unlock(&switchd_ctx->asic[dev_id].switch_lock);
+  }
+  return completions;
+}
+
+/* Sleep for up to sleep_us or until the worker's eventfd is signalled. */
+static void dma_svc_sleep(bf_switchd_dma_svc_worker_t *w, uint32_t sleep_us) {
+  struct pollfd pfd = {.fd = w->efd, .events = POLLIN};
+  struct timespec ts = {.tv_sec = sleep_us / 1000000,
+                        .tv_nsec = (sleep_us % 1000000) * 1000};
+  uint64_t v;
+
+  w->stats.sleeps++;
+  if (w->efd < 0) {
+    bf_sys_usleep(sleep_us);
+    return;
+  }
+  if (ppoll(&pfd, 1, &ts, NULL) > 0 && (pfd.revents & POLLIN)) {
+    if (read(w->efd, &v, sizeof v) == sizeof v) w->stats.wakeups++;
+  }
+}
+
 /* Routine to process async updates from HW (DMA resp) */
 static void *bf_switchd_process_async_dma_notifs(void *arg) {
-  (void)arg;
-  bf_dev_id_t dev_id = 0;
-  switchd_state_t *dev_state;
+  bf_switchd_dma_svc_worker_t *w = arg;
   bf_mc_session_hdl_t mc_session_handle;
-
-  /* Get a handle for multicast node garbage collection. */
-  if (!switchd_ctx->args.skip_hld.mc_mgr) {
+  uint32_t max_sleep_us = switchd_ctx->args.dma_svc_max_sleep_us
+                              ? switchd_ctx->args.dma_svc_max_sleep_us
+                              : BF_SWITCHD_DMA_SVC_MAX_SLEEP_US;
+  uint32_t sleep_us = 0;
+  int idle_passes = 0;
+
+  /* Get a handle for multicast node garbage collection, only the first
+   * worker does it. */
+  bool do_mc_gc = w->idx == 0 && !switchd_ctx->args.skip_hld.mc_mgr;
+  if (do_mc_gc) {
     bf_status_t sts = bf_mc_create_session(&mc_session_handle);
     bf_sys_assert(BF_SUCCESS == sts);
   }
 
+  w->window_start_ns = dma_svc_now_ns();
+
   /* Device update processing loop
    *  a) Process DMA responses
    *  b) Reclaim freed up MC nodes
    */
   while (1) {
-    /* The number of DRs processed per second decreases above this value.
-     * There may be additional tuning required for different CPUs.
-     * Around 100K DRs/sec observed with this interval on the ref platform
-     */
-    usleep(300);
     if (reg_dir_i2c_rd_func && reg_dir_i2c_wr_func) {
+      bf_sys_usleep(max_sleep_us);
       continue;
     }
 
-    for (dev_id = 0; dev_id < BF_MAX_DEV_COUNT; dev_id++) {
-      dev_state = &(switchd_ctx->state[dev_id]);
+    uint64_t start_ns = dma_svc_now_ns();
+    uint64_t completions = dma_svc_pass(w);
+    uint64_t end_ns = dma_svc_now_ns();
+
+    w->stats.passes++;
+    if (completions) {
+      /* Completions are flowing, poll again right away. */
+      uint64_t svc_ns = end_ns - start_ns;
+      w->stats.busy_passes++;
+      w->stats.completions += completions;
+      w->stats.svc_ns_total += svc_ns;
+      if (svc_ns > w->stats.svc_ns_max) w->stats.svc_ns_max = svc_ns;
+      w->window_completions += completions;
+      idle_passes = 0;
+      sleep_us = 0;
+    } else if (++idle_passes <= BF_SWITCHD_DMA_SVC_IDLE_SPINS) {
+      sched_yield();
+    } else {
+      sleep_us = sleep_us ? sleep_us * 2 : BF_SWITCHD_DMA_SVC_MIN_SLEEP_US;
+      if (sleep_us > max_sleep_us) sleep_us = max_sleep_us;
+    }
 
-      if (!switchd_ctx->asic[dev_id].configured) continue;
+    if (end_ns - w->window_start_ns >= 1000000000ull) {
+      w->stats.completions_per_sec = w->window_completions * 1000000000ull /
+                                     (end_ns - w->window_start_ns);
+      w->window_completions = 0;
+      w->window_start_ns = end_ns;
+    }
 
-      bf_sys_mutex_lock(&switchd_ctx->asic[dev_id].switch_mutex);
+    /* Perform multicast driver background node garbage collection */
+    if (do_mc_gc) {
+      bf_mc_do_node_garbage_collection(mc_session_handle);
+    }
 
-      if (!dev_state->device_ready) {
-        bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
-        continue;
-      }
+    if (sleep_us) dma_svc_sleep(w, sleep_us);
+  }
+  return NULL;
+}
 
-      if (switchd_ctx->asic[dev_id].is_virtual) {
-        bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
-        continue;
-      }
+void bf_switchd_dma_svc_wakeup(void) {
+  uint64_t one = 1;
+  for (int i = 0; i < dma_svc_num_workers; i++) {
+    if (dma_svc_workers[i].efd < 0) continue;
+    if (write(dma_svc_workers[i].efd, &one, sizeof one) != sizeof one) {
+      /* The counter is saturated, the worker will wake up anyway. */
+    }
+  }
+}
 
-      if (dev_state->device_locked) {
-        bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
-        continue;
-      }
+int bf_switchd_dma_svc_num_workers(void) { return dma_svc_num_workers; }
 
-      /* Perform per-device periodic processing tasks */
-      if (!switchd_ctx->args.skip_hld.pipe_mgr) {
-        bf_dma_service_pipe_learning(dev_id);
-        bf_dma_service_pipe_idle_time(dev_id);
-        bf_dma_service_pipe_stats(dev_id);
-        bf_dma_service_pipe_read_block_completion(dev_id);
-        bf_dma_service_pipe_write_block_completion(dev_id);
-        bf_dma_service_pipe_ilist_completion(dev_id);
-      }
-      bf_dma_service_write_list_completion(dev_id);
-      bf_dma_service_mac_stats(dev_id, 256);
-      if (switchd_ctx->asic[dev_id].chip_family != BF_DEV_FAMILY_TOFINO) {
-        bf_dma_service_read_block0_completion(dev_id);
-        bf_dma_service_read_block1_completion(dev_id);
-        bf_dma_service_write_list1_completion(dev_id);
-      }
-      bf_sys_mutex_unlock(&switchd_ctx->asic[dev_id].switch_mutex);
+bf_status_t bf_switchd_dma_svc_stats_get(int worker,
+                                         bf_switchd_dma_svc_stats_t *stats) {
+  if (worker < 0 || worker >= dma_svc_num_workers || !stats)
+    return BF_INVALID_ARG;
+  *stats = dma_svc_workers[worker].stats;
+  return BF_SUCCESS;
+}
+
+void bf_switchd_dma_svc_stats_clear(void) {
+  for (int i = 0; i < dma_svc_num_workers; i++) {
+    memset(&dma_svc_workers[i].stats, 0, sizeof dma_svc_workers[i].stats);
+  }
+}
+
+/* Start the DMA completion service worker pool. */
+static int bf_switchd_dma_svc_start(void) {
+  int num_workers = switchd_ctx->args.dma_svc_workers;
+  int ret;
+
+  if (num_workers <= 0) num_workers = 1;
+  if (num_workers > BF_MAX_DEV_COUNT) num_workers = BF_MAX_DEV_COUNT;
+  dma_svc_num_workers = num_workers;
+
+  for (int i = 0; i < num_workers; i++) {
+    bf_switchd_dma_svc_worker_t *w = &dma_svc_workers[i];
+    char name[16];
+
+    w->idx = i;
+    w->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (w->efd < 0) {
+      bf_sys_log_and_trace(BF_MOD_SWITCHD,
+                           BF_LOG_WARN,
+                           "eventfd failed for dma service worker %d: %s, "
+                           "falling back to timed sleeps",
+                           i,
+                           strerror(errno));
     }
 
-    /* Perform multicast driver background node garbage collection */
-    if (!switchd_ctx->args.skip_hld.mc_mgr) {
-      bf_mc_do_node_garbage_collection(mc_session_handle);
+    pthread_attr_t dma_t_attr;
+    pthread_attr_init(&dma_t_attr);
+    if ((ret = pthread_create(
+             &w->t_id, &dma_t_attr, bf_switchd_process_async_dma_notifs, w)) !=
+        0) {
+      bf_sys_log_and_trace(
+          BF_MOD_SWITCHD,
+          BF_LOG_ERR,
+          "ERROR: thread creation failed for dma handling service: %d",
+          ret);
+      return ret;
+    }
+    if (i == 0) switchd_ctx->args.dma_t_id = w->t_id;
+    if (num_workers == 1) {
+      snprintf(name, sizeof name, "bf_dma");
+    } else {
+      snprintf(name, sizeof name, "bf_dma_%d", i);
+    }
+    pthread_setname_np(w->t_id, name);
+
+    if (switchd_ctx->args.dma_svc_pin_cpu) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(switchd_ctx->args.dma_svc_cpu + i, &cpus);
+      ret = pthread_setaffinity_np(w->t_id, sizeof cpus, &cpus);
+      if (ret != 0) {
+        bf_sys_log_and_trace(BF_MOD_SWITCHD,
+                             BF_LOG_WARN,
+                             "Failed to pin dma service worker %d to CPU %d: "
+                             "%d",
+                             i,
+                             switchd_ctx->args.dma_svc_cpu + i,
+                             ret);
+      }
     }
   }
-  return NULL;
+  return 0;
 }
 
 /* Routine to process async updates from HW (Interrupts)
@@ -4507,7 +4773,8 @@ static void *bf_switchd_process_async_int_notifs(void *arg) {
 
   /* Device interrupt processing loop */
   while (1) {
-    bf_switchd_check_for_interrupts_or_timeout(&dev_fd_set, 1000);
+    int num_ready =
+        bf_switchd_check_for_interrupts_or_timeout(&dev_fd_set, 1000);
 
     for (dev_id = 0; dev_id < BF_MAX_DEV_COUNT; dev_id++) {
       dev_state = &(switchd_ctx->state[dev_id]);
@@ -4526,6 +4793,9 @@ static void *bf_switchd_process_async_int_notifs(void *arg) {
 
       bf_switchd_service_interrupts(dev_id, &dev_fd_set);
     }
+    /* Interrupts usually mean DMA completions are on their way, make sure an
+     * idle DMA service worker does not sleep through them. */
+    if (num_ready > 0) bf_switchd_dma_svc_wakeup();
   }
   return NULL;
 }
@@ -4998,20 +5268,7 @@ static int bf_switchd_driver_init(bool kernel_pkt_proc) {
   /* Start a thread to handle asynchronous DMA notifications.  Note this doesn't
    * include DMA notifications for packet I/O over DMA. */
   if (!switchd_ctx->args.skip_dma_thread) {
-    pthread_attr_t dma_t_attr;
-    pthread_attr_init(&dma_t_attr);
-    if ((ret = pthread_create(&switchd_ctx->args.dma_t_id,
-                              &dma_t_attr,
-                              bf_switchd_process_async_dma_notifs,
-                              NULL)) != 0) {
-      bf_sys_log_and_trace(
-          BF_MOD_SWITCHD,
-          BF_LOG_ERR,
-          "ERROR: thread creation failed for dma handling service: %d",
-          ret);
-      return ret;
-    }
-    pthread_setname_np(switchd_ctx->args.dma_t_id, "bf_dma");
+    if ((ret = bf_switchd_dma_svc_start()) != 0) return ret;
   }
 
   /* Start a thread to handle interrupts from all devices. */
@@ -5882,12 +6139,21 @@ int bf_switchd_lib_init(bf_switchd_context_t *ctx) {
       num_active_devices++;
     }
 
-    ret = bf_sys_mutex_init(&switchd_ctx->asic[dev_id].switch_mutex);
+    /* The DMA service polls back to back under the read lock while
+     * completions keep coming, prefer writers so that device remove and warm
+     * init are not held off by it. */
+    pthread_rwlockattr_t switch_lock_attr;
+    pthread_rwlockattr_init(&switch_lock_attr);
+    pthread_rwlockattr_setkind_np(&switch_lock_attr,
+                                  PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    ret = bf_sys_rwlock_init(&switchd_ctx->asic[dev_id].switch_lock,
+                             &switch_lock_attr);
+    pthread_rwlockattr_destroy(&switch_lock_attr);
     if (ret != BF_SUCCESS) {
       bf_sys_log_and_trace(
           BF_MOD_SWITCHD,
           BF_LOG_ERR,
-          "bf_sys_mutex_init failed (%d), switch_mutex, dev_id %d",
+          "bf_sys_rwlock_init failed (%d), switch_lock, dev_id %d",
           ret,
           dev_id);
     }
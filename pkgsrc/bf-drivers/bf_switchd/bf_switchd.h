@@ -70,7 +70,9 @@ typedef struct switch_asic_s {
   bool is_sw_model;
   switchd_pcie_cfg_t pcie_cfg;
   switchd_serdes_cfg_t serdes_cfg;
-  bf_sys_mutex_t switch_mutex; /* A mutex to protect device_ready. */
+  /* Protects device_ready, held shared by the DMA service worker of the
+   * device.  Writers are preferred. */
+  bf_sys_rwlock_t switch_lock;
   bf_sys_mutex_t pktmgr_mutex;
   unsigned short subdev_pres_msk;  // subdev mask bit=1 means presence
 } switch_asic_t;
@@ -246,6 +248,15 @@ typedef struct bf_switchd_context_s {
    */
   bool skip_dma_thread;
 
+  /* DMA completion service tuning.  The devices are spread over
+   * dma_svc_workers threads (one when zero).  When dma_svc_pin_cpu is set
+   * worker n is pinned to CPU dma_svc_cpu + n.  An idle worker sleeps at
+   * most dma_svc_max_sleep_us between polls (300us when zero). */
+  int dma_svc_workers;
+  bool dma_svc_pin_cpu;
+  int dma_svc_cpu;
+  uint32_t dma_svc_max_sleep_us;
+
   /* For low level debug only!  Bypass the initialization of various low level
    * SDE driver components, not to be used during normal switch operation. */
   switchd_skip_hld_t skip_hld;
@@ -318,6 +329,24 @@ bf_status_t bf_switchd_kpkt_enable_traffic(bf_dev_id_t dev_id);
 bf_status_t bf_switchd_device_remove(bf_dev_id_t dev_id);
 bf_status_t bf_switchd_device_add(bf_dev_id_t dev_id, bool setup_dma);
 
+/* Per worker counters of the DMA completion service. */
+typedef struct bf_switchd_dma_svc_stats_s {
+  uint64_t passes;              /* Service passes over all devices. */
+  uint64_t busy_passes;         /* Passes which found completions waiting. */
+  uint64_t sleeps;              /* Times the worker slept while idle. */
+  uint64_t wakeups;             /* Sleeps cut short by a wakeup. */
+  uint64_t completions;         /* Completions serviced. */
+  uint64_t completions_per_sec; /* Rate over the last full second. */
+  uint64_t svc_ns_total;        /* Time spent in busy passes. */
+  uint64_t svc_ns_max;          /* Longest busy pass. */
+} bf_switchd_dma_svc_stats_t;
+
+void bf_switchd_dma_svc_wakeup(void);
+int bf_switchd_dma_svc_num_workers(void);
+bf_status_t bf_switchd_dma_svc_stats_get(int worker,
+                                         bf_switchd_dma_svc_stats_t *stats);
+void bf_switchd_dma_svc_stats_clear(void);
+
 /******************************************************************************
 *******************************************************************************
                           BF_SWITCHD OPERATIONAL MODE SETTINGS
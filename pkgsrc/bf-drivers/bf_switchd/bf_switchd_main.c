@@ -94,6 +94,9 @@ static void bf_switchd_parse_options(bf_switchd_context_t *ctx,
       OPT_P4RT_SERVER,
       OPT_SHELL_NO_WAIT,
       OPT_SERVER_LISTEN_ON_LOCALHOST_ONLY,
+      OPT_DMA_SVC_WORKERS,
+      OPT_DMA_SVC_CPU,
+      OPT_DMA_SVC_MAX_SLEEP,
     };
     static struct option long_options[] = {
         {"help", no_argument, 0, 'h'},
@@ -116,6 +119,9 @@ static void bf_switchd_parse_options(bf_switchd_context_t *ctx,
         {"init-mode", required_argument, 0, OPT_INIT_MODE},
         {"p4rt-server", required_argument, 0, OPT_P4RT_SERVER},
         {"shell-no-wait", no_argument, 0, OPT_SHELL_NO_WAIT},
+        {"dma-svc-workers", required_argument, 0, OPT_DMA_SVC_WORKERS},
+        {"dma-svc-cpu", required_argument, 0, OPT_DMA_SVC_CPU},
+        {"dma-svc-max-sleep-us", required_argument, 0, OPT_DMA_SVC_MAX_SLEEP},
         {0, 0, 0, 0}};
     int c = getopt_long(argc, argv, "h", long_options, &option_index);
     if (c == -1) {
@@ -185,6 +191,16 @@ static void bf_switchd_parse_options(bf_switchd_context_t *ctx,
       case OPT_SHELL_NO_WAIT:
         ctx->shell_before_dev_add = true;
         break;
+      case OPT_DMA_SVC_WORKERS:
+        ctx->dma_svc_workers = atoi(optarg);
+        break;
+      case OPT_DMA_SVC_CPU:
+        ctx->dma_svc_pin_cpu = true;
+        ctx->dma_svc_cpu = atoi(optarg);
+        break;
+      case OPT_DMA_SVC_MAX_SLEEP:
+        ctx->dma_svc_max_sleep_us = atoi(optarg);
+        break;
       case 'h':
       case '?':
         printf("bf_switchd \n");
@@ -209,6 +225,17 @@ static void bf_switchd_parse_options(bf_switchd_context_t *ctx,
             "device\n");
         printf(" --p4rt-server=<addr:port> Run the P4Runtime gRPC server\n");
         printf(" --shell-no-wait Start the shell before devices are added\n");
+        printf(
+            " --dma-svc-workers=<n> Number of DMA completion service "
+            "threads,\n"
+            "              each device is serviced by one of them\n");
+        printf(
+            " --dma-svc-cpu=<cpu> Pin the DMA completion service threads to\n"
+            "              consecutive CPUs starting at <cpu>\n");
+        printf(
+            " --dma-svc-max-sleep-us=<us> Longest sleep of an idle DMA "
+            "completion\n"
+            "              service thread, default 300\n");
         printf(" -h,--help Display this help message and exit\n");
         exit(c == 'h' ? 0 : 1);
         break;
@@ -141,6 +141,47 @@ static ucli_status_t switchd_ucli_ucli__rmv_dev__(ucli_context_t *uc) {
   return 0;
 }
 
+static ucli_status_t switchd_ucli_ucli__dma_svc__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(uc,
+                    "dma-svc",
+                    -1,
+                    "Show DMA completion service counters: dma-svc [clear]");
+
+  if (uc->pargs->count > 0 && !strcmp(uc->pargs->args[0], "clear")) {
+    bf_switchd_dma_svc_stats_clear();
+    return 0;
+  }
+
+  aim_printf(&uc->pvs,
+             "%-6s %12s %12s %10s %10s %14s %12s %12s %12s\n",
+             "Worker",
+             "Passes",
+             "Busy",
+             "Sleeps",
+             "Wakeups",
+             "Completions",
+             "Compl/s",
+             "Avg svc(us)",
+             "Max svc(us)");
+  for (int i = 0; i < bf_switchd_dma_svc_num_workers(); i++) {
+    bf_switchd_dma_svc_stats_t st;
+    if (bf_switchd_dma_svc_stats_get(i, &st) != BF_SUCCESS) continue;
+    aim_printf(&uc->pvs,
+               "%-6d %12" PRIu64 " %12" PRIu64 " %10" PRIu64 " %10" PRIu64
+               " %14" PRIu64 " %12" PRIu64 " %12.1f %12.1f\n",
+               i,
+               st.passes,
+               st.busy_passes,
+               st.sleeps,
+               st.wakeups,
+               st.completions,
+               st.completions_per_sec,
+               st.busy_passes ? st.svc_ns_total / 1000.0 / st.busy_passes : 0,
+               st.svc_ns_max / 1000.0);
+  }
+  return 0;
+}
+
 static ucli_status_t switchd_ucli_ucli__board_port_map__(ucli_context_t *uc) {
   bf_dev_id_t dev_id;
   int num_ports = 0, num_ch = 0;
@@ -269,6 +310,7 @@ static ucli_command_handler_f switchd_ucli_ucli_handlers__[] = {
     switchd_ucli_ucli__rmv_dev__,
     switchd_ucli_ucli__add_dev__,
     switchd_ucli_ucli__board_port_map__,
+    switchd_ucli_ucli__dma_svc__,
     NULL};
 
 static ucli_module_t switchd_ucli_module__ = {
@@ -104,6 +104,7 @@ DECLARE_HANDLE(bf_rt_session_hdl);
 DECLARE_HANDLE(bf_rt_table_hdl);
 DECLARE_HANDLE(bf_rt_table_key_hdl);
 DECLARE_HANDLE(bf_rt_table_data_hdl);
+DECLARE_HANDLE(bf_rt_table_cursor_hdl);
 DECLARE_HANDLE(bf_rt_table_attributes_hdl);
 DECLARE_HANDLE(bf_rt_entry_scope_arguments_hdl);
 DECLARE_HANDLE(bf_rt_learn_hdl);
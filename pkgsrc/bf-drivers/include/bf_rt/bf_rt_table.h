@@ -533,6 +533,81 @@ bf_status_t bf_rt_table_entry_get_next_n(const bf_rt_table_hdl *table_hdl,
                                          uint32_t n,
                                          uint32_t *num_returned);
 
+/**
+ * @brief Allocate a cursor to walk the entries of the table with. A new
+ * cursor is positioned before the first entry of the table.
+ *
+ * @param[in] table_hdl Table object
+ * @param[out] cursor_hdl_ret Cursor object returned
+ *
+ * @return Status of the API call
+ */
+bf_status_t bf_rt_table_cursor_allocate(
+    const bf_rt_table_hdl *table_hdl, bf_rt_table_cursor_hdl **cursor_hdl_ret);
+
+/**
+ * @brief Deallocate a cursor
+ *
+ * @param[in] cursor_hdl Cursor object
+ *
+ * @return Status of the API call
+ */
+bf_status_t bf_rt_table_cursor_deallocate(bf_rt_table_cursor_hdl *cursor_hdl);
+
+/**
+ * @brief Position a cursor at the entry specified by key, the next
+ * bf_rt_table_cursor_get_next_n() returns the entries following it.
+ *
+ * @param[in] table_hdl Table object
+ * @param[in] session Session Object
+ * @param[in] dev_tgt Device target
+ * @param[in] flags Call flags
+ * @param[in] key Entry Key
+ * @param[inout] cursor Cursor allocated on this table
+ *
+ * @return Status of the API call
+ */
+bf_status_t bf_rt_table_cursor_set(const bf_rt_table_hdl *table_hdl,
+                                   const bf_rt_session_hdl *session,
+                                   const bf_rt_target_t *dev_tgt,
+                                   const uint64_t flags,
+                                   const bf_rt_table_key_hdl *key,
+                                   bf_rt_table_cursor_hdl *cursor);
+
+/**
+ * @brief Get the next N entries of the table following the position of the
+ * cursor and advance the cursor past them. Unlike
+ * bf_rt_table_entry_get_next_n() no key is looked up, which makes walking a
+ * whole table a page at a time cheap. A cursor is bound to the session and
+ * device target of the first call made with it.
+ * N must be greater than zero.
+ *
+ * @param[in] table_hdl Table object
+ * @param[in] session Session Object
+ * @param[in] dev_tgt Device target
+ * @param[in] flags Call flags
+ * @param[inout] cursor Cursor allocated on this table
+ * @param[out] output_keys Array of allocated Key objects.
+ * Size should be equal to n
+ * @param[out] output_data Array of allocated Data objects.
+ * Size should be equal to n
+ * @param[in] n Number of entries queried 'N'
+ * @param[out] num_returned Actual number of entries returned, less than N
+ * once the end of the table has been reached
+ *
+ * @return Status of the API call. BF_OBJECT_NOT_FOUND if no entry follows
+ * the cursor
+ */
+bf_status_t bf_rt_table_cursor_get_next_n(const bf_rt_table_hdl *table_hdl,
+                                          const bf_rt_session_hdl *session,
+                                          const bf_rt_target_t *dev_tgt,
+                                          const uint64_t flags,
+                                          bf_rt_table_cursor_hdl *cursor,
+                                          bf_rt_table_key_hdl **output_keys,
+                                          bf_rt_table_data_hdl **output_data,
+                                          uint32_t n,
+                                          uint32_t *num_returned);
+
 /**
  * @brief Current Usage of the table
  *
@@ -96,6 +96,20 @@ class Annotation {
 using AnnotationSet =
     std::set<std::reference_wrapper<const Annotation>, Annotation::Less>;
 
+/**
+ * @brief Opaque position of a walk over the entries of a table.<br>
+ * A cursor remembers the last entry returned to it, so paging through a table
+ * with \ref bfrt::BfRtTable::tableCursorGetNext_n() does not have to look the
+ * entry up by key on every call. Every walk has its own cursor, walks of
+ * different sessions do not interfere with each other.<br>
+ * <B>Creation: </B> Can only be created using \ref
+ * bfrt::BfRtTable::tableCursorAllocate()
+ */
+class BfRtTableCursor {
+ public:
+  virtual ~BfRtTableCursor() = default;
+};
+
 /**
  * @brief Class to contain metadata of Table Objs like Data and Key Fields,
  *  and perform functions like EntryAdd, AttributeSet, OperationsExecute etc<br>
@@ -963,6 +977,66 @@ class BfRtTable {
                                           keyDataPairs *key_data_pairs,
                                           uint32_t *num_returned) const = 0;
 
+  /**
+   * @brief Allocate a cursor to walk the entries of the table with. A new
+   * cursor is positioned before the first entry of the table.
+   *
+   * @param[out] cursor_ret Cursor object returned
+   *
+   * @return Status of the API call. BF_NOT_SUPPORTED if the table cannot be
+   * walked with a cursor
+   */
+  virtual bf_status_t tableCursorAllocate(
+      std::unique_ptr<BfRtTableCursor> *cursor_ret) const = 0;
+
+  /**
+   * @brief Position a cursor at the entry specified by key, the next
+   * tableCursorGetNext_n() on the cursor returns the entries following it.
+   * This is the only cursor call resolving a key.
+   *
+   * @param[in] session Session Object
+   * @param[in] dev_tgt Device target
+   * @param[in] flags Call flags
+   * @param[in] key Entry Key
+   * @param[inout] cursor Cursor allocated on this table
+   *
+   * @return Status of the API call
+   */
+  virtual bf_status_t tableCursorSet(const BfRtSession &session,
+                                     const bf_rt_target_t &dev_tgt,
+                                     const uint64_t &flags,
+                                     const BfRtTableKey &key,
+                                     BfRtTableCursor *cursor) const = 0;
+
+  /**
+   * @brief Get the next N entries of the table following the position of the
+   * cursor and advance the cursor past them.
+   * A cursor is bound to the session and device target of the first call
+   * made with it. The walk continues from the last returned entry even if
+   * that entry has been deleted in the meantime.
+   * N must be greater than zero.
+   *
+   * @param[in] session Session Object
+   * @param[in] dev_tgt Device target
+   * @param[in] flags Call flags
+   * @param[inout] cursor Cursor allocated on this table
+   * @param[in] n Number of entries queried 'N'
+   * @param[out] key_data_pairs Vector of N Pairs(key, data). This vector needs
+   * to have N entries before the API call is made, else error is returned
+   * @param[out] num_returned Actual number of entries returned, less than N
+   * once the end of the table has been reached
+   *
+   * @return Status of the API call. BF_OBJECT_NOT_FOUND if no entry follows
+   * the cursor
+   */
+  virtual bf_status_t tableCursorGetNext_n(const BfRtSession &session,
+                                           const bf_rt_target_t &dev_tgt,
+                                           const uint64_t &flags,
+                                           BfRtTableCursor *cursor,
+                                           const uint32_t &n,
+                                           keyDataPairs *key_data_pairs,
+                                           uint32_t *num_returned) const = 0;
+
   /**
    * @brief Current Usage of the table
    *
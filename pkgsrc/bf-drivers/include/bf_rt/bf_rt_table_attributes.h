@@ -438,6 +438,26 @@ bf_status_t bf_rt_attributes_pre_max_nodes_threshold_get(
     uint32_t *node_count,
     uint32_t *node_port_lag_count);
 
+/**
+ * @brief Get PRE RDM usage in the PRE Attributes Object
+ *
+ * @param[in] tbl_attr             Table attribute object handle
+ * @param[out] used_entries        RDM entries holding multicast nodes
+ * @param[out] free_entries        RDM entries available for allocation
+ * @param[out] largest_free_block  Largest run of free entries a single
+ *                                 allocation can use
+ * @param[out] fragmentation       Percent of the free entries outside the
+ *                                 largest free run of their RDM block
+ *
+ * @return Status of the API call
+ */
+bf_status_t bf_rt_attributes_pre_rdm_usage_get(
+    bf_rt_table_attributes_hdl *tbl_attr,
+    uint32_t *used_entries,
+    uint32_t *free_entries,
+    uint32_t *largest_free_block,
+    uint32_t *fragmentation);
+
 /**
  * @brief Get Dynamic Key Mask supported fields number
  *
@@ -649,6 +649,26 @@ class BfRtTableAttributes {
                                           BfRtSession **session,
                                           selUpdateCb *callback_fn,
                                           void **cookie) const = 0;
+
+  /**
+   * @brief Get PRE RDM usage in the PRE Attributes Object.  Read only, it is
+   * filled in by tableAttributesGet on the PRE MGID table.
+   * @param[out] used_entries  RDM entries holding multicast nodes
+   * @param[out] free_entries  RDM entries available for allocation
+   * @param[out] largest_free_block  Largest run of free entries a single
+   * allocation can use
+   * @param[out] fragmentation  Percent of the free entries outside the largest
+   * free run of their RDM block
+   *
+   * @return Status of the API call. BF_NOT_SUPPORTED if the attributes object
+   * does not implement it
+   */
+  virtual bf_status_t preRdmUsageGet(uint32_t * /*used_entries*/,
+                                     uint32_t * /*free_entries*/,
+                                     uint32_t * /*largest_free_block*/,
+                                     uint32_t * /*fragmentation*/) const {
+    return BF_NOT_SUPPORTED;
+  }
 };
 }  // namespace bfrt
 
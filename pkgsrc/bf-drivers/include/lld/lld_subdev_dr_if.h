@@ -52,6 +52,15 @@ int lld_subdev_push_ilist_mcast(bf_dev_id_t dev_id,
                                 uint32_t mcast_vector,
                                 bf_dma_addr_t ack_ptr,
                                 uint64_t msg_id);
+int lld_subdev_push_ilist_mcast_n(bf_dev_id_t dev_id,
+                                  bf_subdev_id_t subdev_id,
+                                  int dr_0_3,
+                                  int n,
+                                  bf_dma_addr_t *list,
+                                  int *list_len,
+                                  bool s_f,
+                                  uint32_t *mcast_vector,
+                                  uint64_t *msg_id);
 int lld_subdev_push_wb(bf_dev_id_t dev_id,
                        bf_subdev_id_t subdev_id,
                        int entry_sz,
@@ -121,6 +130,12 @@ int lld_subdev_push_fm(bf_dev_id_t dev_id,
                        bf_dma_dr_id_t dr_e,
                        bf_dma_addr_t buf,
                        int buf_len);
+int lld_subdev_push_fm_n(bf_dev_id_t dev_id,
+                         bf_subdev_id_t subdev_id,
+                         bf_dma_dr_id_t dr_e,
+                         int n,
+                         bf_dma_addr_t *buf,
+                         int buf_len);
 
 int lld_subdev_push_mac_stats_read(bf_dev_id_t dev_id,
                                    bf_subdev_id_t subdev_id,
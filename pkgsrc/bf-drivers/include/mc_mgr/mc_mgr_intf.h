@@ -1246,6 +1246,36 @@ bf_status_t bf_mc_node_garbage_collection_scheduler_mode(
  */
 bf_status_t bf_mc_do_node_garbage_collection(bf_mc_session_hdl_t shdl);
 
+/**
+ * Read how the replication data memory (RDM) holding multicast nodes is used
+ * and how fragmented its free space is.
+ * @param shdl Session handle.
+ * @param dev The ASIC id.
+ * @param usage Pointer to a struct where the usage will be stored.
+ * @return Status of the API call.
+ */
+bf_status_t bf_mc_rdm_usage_get(bf_mc_session_hdl_t shdl,
+                                bf_dev_id_t dev,
+                                bf_mc_rdm_usage_t *usage);
+/**
+ * Compact the replication data memory without disrupting traffic.  The L2
+ * chains of nodes held in sparsely used RDM blocks are rewritten into other
+ * blocks and the old copies are released through the normal garbage
+ * collection, after which the emptied blocks are available to any pipe and
+ * node type.  May be called repeatedly with a small @c max_nodes to spread
+ * the work out.
+ * @param shdl Session handle.
+ * @param dev The ASIC id.
+ * @param max_nodes The maximum number of nodes to rewrite, zero for no limit.
+ * @param nodes_moved Pointer to where the number of nodes rewritten will be
+ *                    stored, may be NULL.
+ * @return Status of the API call.
+ */
+bf_status_t bf_mc_rdm_compact(bf_mc_session_hdl_t shdl,
+                              bf_dev_id_t dev,
+                              uint32_t max_nodes,
+                              uint32_t *nodes_moved);
+
 /* @} */
 
 /* Used by TM API to set copy-to-cpu port */
@@ -235,6 +235,23 @@ typedef struct bf_mc_debug_int_fifo_credit_t {
   uint8_t l2_lag_port_fifo_credit;
 } bf_mc_debug_int_fifo_credit_t;
 
+/** RDM (replication data memory) usage of a device.  Counts are in RDM
+ * entries, a node uses one or two entries. */
+typedef struct bf_mc_rdm_usage_t {
+  uint32_t total_entries;   /**< Entries on the device. */
+  uint32_t used_entries;    /**< Entries holding nodes. */
+  uint32_t pending_entries; /**< Released entries waiting on an RDM change. */
+  uint32_t free_entries;    /**< Entries available for allocation. */
+  uint32_t total_blocks;    /**< RDM blocks on the device. */
+  uint32_t free_blocks;     /**< Blocks not assigned to any pipe. */
+  uint32_t reclaimable_blocks; /**< Assigned blocks which would be freed if
+                                  their nodes were packed together. */
+  uint32_t largest_free_block; /**< Largest run of free entries a single
+                                  allocation can use. */
+  uint32_t fragmentation; /**< Percent of the free entries outside the largest
+                             free run of their block. */
+} bf_mc_rdm_usage_t;
+
 /* @} */
 
 typedef bf_mc_ecmp_hdl_t mc_l1_ecmp_hdl_t;
@@ -78,6 +78,7 @@ typedef enum pipe_mgr_tbl_prop_type_ {
   PIPE_MGR_TERN_TABLE_ENTRY_PLACEMENT,
   PIPE_MGR_DUPLICATE_ENTRY_CHECK,
   PIPE_MGR_IDLETIME_REPEATED_NOTIFICATION,
+  PIPE_MGR_TERN_TABLE_GAP_POLICY,
 } pipe_mgr_tbl_prop_type_t;
 
 typedef enum pipe_mgr_tbl_prop_scope_value {
@@ -101,6 +102,16 @@ typedef enum pipe_mgr_tbl_prop_idletime_repeated_notification_enable_value {
   PIPE_MGR_IDLETIME_REPEATED_NOTIFICATION_ENABLE = 1,
 } pipe_mgr_tbl_prop_idletime_repeated_notification_enable_value_t;
 
+/* Free space left between priority bands by the batch placement of ternary
+ * tables.  NONE packs the entries together, FIXED leaves the number of free
+ * entries given in the property args after every band and SPREAD divides all
+ * the free space evenly between the bands. */
+typedef enum pipe_mgr_tbl_prop_tern_gap_policy_value {
+  PIPE_MGR_TERN_GAP_POLICY_NONE = 0,
+  PIPE_MGR_TERN_GAP_POLICY_FIXED = 1,
+  PIPE_MGR_TERN_GAP_POLICY_SPREAD = 2,
+} pipe_mgr_tbl_prop_tern_gap_policy_value_t;
+
 typedef union pipe_mgr_tbl_prop_value {
   uint32_t value;
   pipe_mgr_tbl_prop_scope_value_t scope;
@@ -108,6 +119,7 @@ typedef union pipe_mgr_tbl_prop_value {
   pipe_mgr_tbl_prop_duplicate_entry_check_value_t duplicate_check;
   pipe_mgr_tbl_prop_idletime_repeated_notification_enable_value_t
       repeated_notify;
+  pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy;
 } pipe_mgr_tbl_prop_value_t;
 
 #define PIPE_MGR_MAX_USER_DEFINED_SCOPES 8
@@ -1549,6 +1561,31 @@ pipe_status_t pipe_mgr_mat_ent_add(
     uint32_t pipe_api_flags,
     pipe_mat_ent_hdl_t *ent_hdl_p);
 
+/*!
+ * API to install a batch of entries into a ternary or ALPM match action
+ * table.  The placement of the whole batch is planned at once, so each
+ * existing entry is moved at most once no matter how many entries are added.
+ * An empty ALPM table outside a transaction is bulk loaded: the trie is
+ * built from the whole batch and carved into partitions in a single pass.  On
+ * success ent_hdl_p[i] holds the handle of the entry match_spec[i].  ttl may
+ * be NULL if idle time is not used.  All entries are checked before any is
+ * placed.  If placement fails part way outside a transaction the entries
+ * placed before the failure stay installed: ent_hdl_p[i] is non-zero for
+ * exactly those, num_added (may be NULL) returns their count and the error
+ * is returned.  Use a transaction to undo the whole batch on a failure.
+ */
+pipe_status_t pipe_mgr_mat_ent_add_batch(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                         uint32_t num_entries,
+                                         pipe_tbl_match_spec_t **match_spec,
+                                         pipe_act_fn_hdl_t *act_fn_hdl,
+                                         pipe_action_spec_t **act_spec,
+                                         uint32_t *ttl,
+                                         uint32_t pipe_api_flags,
+                                         pipe_mat_ent_hdl_t *ent_hdl_p,
+                                         uint32_t *num_added);
+
 /*!
  * API to install an entry into a match action table,
  * if the entry already exist modify that entry
@@ -1959,6 +1996,32 @@ pipe_status_t pipe_mgr_sel_grp_mbrs_set(pipe_sess_hdl_t sess_hdl,
                                         bool *enable,
                                         uint32_t pipe_api_flags);
 
+typedef enum pipe_mgr_sel_mbr_op_e {
+  PIPE_MGR_SEL_MBR_OP_ADD = 0,
+  PIPE_MGR_SEL_MBR_OP_ADD_DISABLED,
+  PIPE_MGR_SEL_MBR_OP_DEL,
+  PIPE_MGR_SEL_MBR_OP_ENABLE,
+  PIPE_MGR_SEL_MBR_OP_DISABLE,
+} pipe_mgr_sel_mbr_op_e;
+
+/*!
+ * API function to apply a batch of member operations to a group.  The
+ * operations are applied in order on top of the current membership: an add
+ * appends one instance of the member, a delete removes its last instance and
+ * enable/disable act on every instance.  The resulting membership is then
+ * programmed as a single update, so operations which cancel each other out
+ * cause no hardware writes and each selector word is written at most once.
+ * Either all operations are applied or, on error, none are.
+ */
+pipe_status_t pipe_mgr_sel_grp_mbrs_update(pipe_sess_hdl_t sess_hdl,
+                                           bf_dev_id_t device_id,
+                                           pipe_sel_tbl_hdl_t sel_tbl_hdl,
+                                           pipe_sel_grp_hdl_t sel_grp_hdl,
+                                           uint32_t num_ops,
+                                           pipe_mgr_sel_mbr_op_e *ops,
+                                           pipe_adt_ent_hdl_t *mbrs,
+                                           uint32_t pipe_api_flags);
+
 /*!
  * API function to get membership of a group
  */
@@ -110,6 +110,23 @@ int bf_pkt_data_copy(bf_pkt *pkt, const uint8_t *pkt_buf, uint16_t size);
  */
 int bf_pkt_free(bf_dev_id_t id, bf_pkt *pkt);
 
+/**
+ * free a burst of packets, e.g. as delivered by a burst RX callback
+ *
+ * RX buffers are handed back to their free memory DRs with one batched push
+ * and one DR start per ring instead of one per buffer.
+ *
+ * @param id
+ *   chip id
+ * @param pkts
+ *   array of bf packets
+ * @param n_pkts
+ *   number of packets in the array
+ * @return
+ *   0 on success, -1 if any packet could not be freed
+ */
+int bf_pkt_free_burst(bf_dev_id_t id, bf_pkt **pkts, int n_pkts);
+
 /**
  * free all packets allocated for a device
  *
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*!
+ * @file bf_pkt_shm.h
+ * \brief shared memory packet rings exported by the packet manager
+ * @date
+ *
+ * A packet manager export is a single file backed memory region holding a
+ * header, four descriptor rings and an array of fixed size frames:
+ *
+ *   rx   - packet manager -> application, received frames
+ *   fill - application -> packet manager, free frames to receive into
+ *   tx   - application -> packet manager, frames to transmit
+ *   comp - packet manager -> application, transmitted frames
+ *
+ * Every ring has exactly one producer and one consumer. Producer and consumer
+ * indices are free running and live on their own cache lines; a side makes a
+ * batch of descriptors visible with a single release store of its index, so
+ * the index update doubles as the doorbell. A frame is owned by whoever holds
+ * its descriptor. At export time the first half of the frames is posted to
+ * the fill ring and the second half is owned by the application for TX.
+ *
+ * The application side needs nothing but this header: attach with
+ * bf_pkt_shm_attach() and drive the rings with the inline helpers below.
+ */
+
+#ifndef _BF_PKT_SHM_H
+#define _BF_PKT_SHM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Allow the use in C++ code.  */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup pkt_mgr-shm
+ * @{
+ */
+
+#define BF_PKT_SHM_MAGIC 0x62667368 /* "bfsh" */
+#define BF_PKT_SHM_VERSION 1
+#define BF_PKT_SHM_CACHE_LINE 64
+/* Default location of the export of a device */
+#define BF_PKT_SHM_PATH_FMT "/dev/shm/bf_pkt_shm.%d"
+
+/* Descriptor flags */
+#define BF_PKT_SHM_F_ERR 0x1 /* comp: the frame could not be transmitted */
+
+/*!
+ * Descriptor, identifies a frame and the length of the data in it
+ */
+typedef struct bf_pkt_shm_desc_s {
+  uint32_t frame;
+  uint16_t len;
+  uint16_t flags;
+} bf_pkt_shm_desc_t;
+
+/*!
+ * Single producer single consumer descriptor ring
+ */
+typedef struct bf_pkt_shm_ring_s {
+  uint32_t size;     /* number of descriptors, power of 2 */
+  uint32_t desc_off; /* offset of the descriptor array in the region */
+  uint8_t pad0[BF_PKT_SHM_CACHE_LINE - 8];
+  uint32_t prod; /* written by the producer only */
+  uint8_t pad1[BF_PKT_SHM_CACHE_LINE - 4];
+  uint32_t cons; /* written by the consumer only */
+  uint8_t pad2[BF_PKT_SHM_CACHE_LINE - 4];
+} bf_pkt_shm_ring_t;
+
+/*!
+ * Header at the start of an exported region
+ */
+typedef struct bf_pkt_shm_hdr_s {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t n_frames;
+  uint32_t frame_size;
+  uint64_t frames_off; /* offset of frame 0 in the region */
+  uint64_t region_size;
+  uint8_t pad[BF_PKT_SHM_CACHE_LINE - 32];
+  bf_pkt_shm_ring_t rx;
+  bf_pkt_shm_ring_t fill;
+  bf_pkt_shm_ring_t tx;
+  bf_pkt_shm_ring_t comp;
+} bf_pkt_shm_hdr_t;
+
+static inline bf_pkt_shm_desc_t *bf_pkt_shm_desc(bf_pkt_shm_hdr_t *hdr,
+                                                 bf_pkt_shm_ring_t *ring,
+                                                 uint32_t idx) {
+  bf_pkt_shm_desc_t *descs =
+      (bf_pkt_shm_desc_t *)((uint8_t *)hdr + ring->desc_off);
+  return &descs[idx & (ring->size - 1)];
+}
+
+static inline uint8_t *bf_pkt_shm_frame(bf_pkt_shm_hdr_t *hdr,
+                                        uint32_t frame) {
+  return (uint8_t *)hdr + hdr->frames_off + (uint64_t)frame * hdr->frame_size;
+}
+
+/**
+ * Producer: number of descriptors, up to n, that can be written starting at
+ * index ring->prod
+ */
+static inline uint32_t bf_pkt_shm_prod_reserve(bf_pkt_shm_ring_t *ring,
+                                               uint32_t n) {
+  uint32_t cons = __atomic_load_n(&ring->cons, __ATOMIC_ACQUIRE);
+  uint32_t space = ring->size - (ring->prod - cons);
+  return n < space ? n : space;
+}
+
+/**
+ * Producer: publish n descriptors written since the last submit
+ */
+static inline void bf_pkt_shm_prod_submit(bf_pkt_shm_ring_t *ring,
+                                          uint32_t n) {
+  __atomic_store_n(&ring->prod, ring->prod + n, __ATOMIC_RELEASE);
+}
+
+/**
+ * Consumer: number of descriptors, up to n, ready starting at index
+ * ring->cons
+ */
+static inline uint32_t bf_pkt_shm_cons_peek(bf_pkt_shm_ring_t *ring,
+                                            uint32_t n) {
+  uint32_t prod = __atomic_load_n(&ring->prod, __ATOMIC_ACQUIRE);
+  uint32_t avail = prod - ring->cons;
+  return n < avail ? n : avail;
+}
+
+/**
+ * Consumer: hand n consumed descriptors back to the producer
+ */
+static inline void bf_pkt_shm_cons_release(bf_pkt_shm_ring_t *ring,
+                                           uint32_t n) {
+  __atomic_store_n(&ring->cons, ring->cons + n, __ATOMIC_RELEASE);
+}
+
+/**
+ * map an exported region
+ *
+ * @param path
+ *   path of the export, see BF_PKT_SHM_PATH_FMT
+ * @param hdr
+ *   returns the mapped region
+ * @return
+ *   0 on success, -1 on failure
+ */
+static inline int bf_pkt_shm_attach(const char *path, bf_pkt_shm_hdr_t **hdr) {
+  struct stat st;
+  void *p;
+  int fd;
+
+  fd = open(path, O_RDWR);
+  if (fd < 0) return -1;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(bf_pkt_shm_hdr_t)) {
+    close(fd);
+    return -1;
+  }
+  p = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return -1;
+  if (((bf_pkt_shm_hdr_t *)p)->magic != BF_PKT_SHM_MAGIC ||
+      ((bf_pkt_shm_hdr_t *)p)->version != BF_PKT_SHM_VERSION ||
+      ((bf_pkt_shm_hdr_t *)p)->region_size != (uint64_t)st.st_size) {
+    munmap(p, st.st_size);
+    return -1;
+  }
+  *hdr = (bf_pkt_shm_hdr_t *)p;
+  return 0;
+}
+
+/**
+ * unmap a region mapped with bf_pkt_shm_attach
+ */
+static inline void bf_pkt_shm_detach(bf_pkt_shm_hdr_t *hdr) {
+  munmap(hdr, hdr->region_size);
+}
+
+/* @} */
+
+#ifdef __cplusplus
+}
+#endif /* C++ */
+
+#endif
@@ -102,6 +102,28 @@ typedef bf_status_t (*bf_pkt_rx_callback)(bf_dev_id_t dev_id,
                                           void *cookie,
                                           bf_pkt_rx_ring_t rx_ring);
 
+/**
+ * Maximum number of packets delivered by one burst rx callback
+ */
+#define BF_PKT_RX_BURST_MAX 64
+
+/**
+ * Packet rx callback for burst processing. The packets array is only valid
+ * for the duration of the callback; ownership of each packet passes to the
+ * callback, which must free it (bf_pkt_free_burst frees a whole burst).
+ *
+ * The callback runs without any packet manager lock held, so it may transmit
+ * or register and deregister handlers of other rings. It must not deregister
+ * its own ring: bf_pkt_rx_deregister waits for a running callback of the ring
+ * to return. If the DMA of a ring is serviced from more than one thread, its
+ * callbacks are not serialized against each other.
+ */
+typedef bf_status_t (*bf_pkt_rx_burst_callback)(bf_dev_id_t dev_id,
+                                                bf_pkt **pkts,
+                                                int n_pkts,
+                                                void *cookie,
+                                                bf_pkt_rx_ring_t rx_ring);
+
 /**
  * @brief Check if the packet manager is initialized or not
  *
@@ -132,6 +154,9 @@ bf_status_t bf_pkt_rx_register(bf_dev_id_t dev_id,
 /**
  * @brief Deregister callback from RX packet processing
  *
+ * For a burst callback, packets still pending are delivered and any callback
+ * running on another thread has returned by the time this returns.
+ *
  * @param[in] dev_id Device identifier
  * @param[in] rx_ring RX DR ring index
  *
@@ -140,6 +165,28 @@ bf_status_t bf_pkt_rx_register(bf_dev_id_t dev_id,
  */
 bf_status_t bf_pkt_rx_deregister(bf_dev_id_t dev_id, bf_pkt_rx_ring_t rx_ring);
 
+/**
+ * @brief Register a burst callback for RX packet processing
+ *
+ * Received packets are accumulated per ring and delivered up to max_burst at
+ * a time, at the latest when the ring has been serviced by
+ * bf_dma_service_pkt. Deregister with bf_pkt_rx_deregister.
+ *
+ * @param[in] dev_id Device identifier
+ * @param[in] cb Burst callback handler
+ * @param[in] rx_ring RX DR ring index
+ * @param[in] max_burst Maximum packets per callback, 1 to BF_PKT_RX_BURST_MAX
+ * @param[in] rx_cookie Cookie to pass back to callback function
+ *
+ * @return Status of the API call
+ *
+ */
+bf_status_t bf_pkt_rx_register_burst(bf_dev_id_t dev_id,
+                                     bf_pkt_rx_burst_callback cb,
+                                     bf_pkt_rx_ring_t rx_ring,
+                                     int max_burst,
+                                     void *rx_cookie);
+
 /**
  * @brief Transmit a packet
  *
@@ -156,6 +203,32 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
                       bf_pkt_tx_ring_t tx_ring,
                       void *tx_cookie);
 
+/**
+ * @brief Transmit a burst of packets
+ *
+ * All packets are pushed under one acquisition of the TX ring and the DR is
+ * started once for the whole burst. Transmission stops at the first packet
+ * that cannot be pushed; packets before it have been sent and will complete
+ * through the TX done notification, the caller still owns the rest.
+ *
+ * @param[in] dev_id Device identifier
+ * @param[in] pkts Packets to be transmitted
+ * @param[in] tx_cookies Per packet cookies to pass back to TX done
+ * notification
+ * @param[in] n_pkts Number of packets
+ * @param[in] tx_ring TX DR ring index
+ * @param[out] n_sent Number of packets transmitted
+ *
+ * @return Status of the API call
+ *
+ */
+bf_status_t bf_pkt_tx_burst(bf_dev_id_t dev_id,
+                            bf_pkt **pkts,
+                            void **tx_cookies,
+                            int n_pkts,
+                            bf_pkt_tx_ring_t tx_ring,
+                            int *n_sent);
+
 /**
  * @brief Register callback for TX done notification
  *
@@ -182,6 +255,42 @@ bf_status_t bf_pkt_tx_done_notif_register(bf_dev_id_t dev_id,
 bf_status_t bf_pkt_tx_done_notif_deregister(bf_dev_id_t dev_id,
                                             bf_pkt_tx_ring_t tx_ring);
 
+/**
+ * @brief Export an RX and a TX ring through shared memory
+ *
+ * Packets received on rx_ring are handed to the rx ring of the export and
+ * frames posted on its tx ring are transmitted on tx_ring, see
+ * pkt_mgr/bf_pkt_shm.h for the layout. The rings are serviced from
+ * bf_dma_service_pkt. Only one export per device is supported.
+ *
+ * @param[in] dev_id Device identifier
+ * @param[in] rx_ring RX DR ring index
+ * @param[in] tx_ring TX DR ring index
+ * @param[in] n_frames Number of frames, a power of 2
+ * @param[in] frame_size Size of a frame in bytes
+ * @param[in] path File backing the export, NULL for BF_PKT_SHM_PATH_FMT
+ *
+ * @return Status of the API call
+ *
+ */
+bf_status_t bf_pkt_shm_export(bf_dev_id_t dev_id,
+                              bf_pkt_rx_ring_t rx_ring,
+                              bf_pkt_tx_ring_t tx_ring,
+                              uint32_t n_frames,
+                              uint32_t frame_size,
+                              const char *path);
+
+/**
+ * @brief Remove the shared memory export of a device
+ *
+ * @param[in] dev_id Device identifier
+ *
+ * @return Status of the API call, BF_IN_USE while frames are being
+ * transmitted
+ *
+ */
+bf_status_t bf_pkt_shm_unexport(bf_dev_id_t dev_id);
+
 /**
  * @brief Packet manager lock device message handler
  *
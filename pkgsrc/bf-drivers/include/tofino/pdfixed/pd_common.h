@@ -267,6 +267,7 @@ typedef enum p4_pd_tbl_prop_type_ {
   PD_TERN_TABLE_ENTRY_PLACEMENT,
   PD_DUPLICATE_ENTRY_CHECK,
   PD_IDLETIME_REPEATED_NOTIFICATION,
+  PD_TERN_TABLE_GAP_POLICY,
   PD_MAX_PROPERTY
 } p4_pd_tbl_prop_type_t;
 
@@ -291,12 +292,19 @@ typedef enum p4_pd_tbl_prop_idletime_repeated_notification_enable_value {
   PD_IDLETIME_REPEATED_NOTIFICATION_ENABLE = 1,
 } p4_pd_tbl_prop_idletime_repeated_notification_enable_value_t;
 
+typedef enum p4_pd_tbl_prop_tern_gap_policy_value {
+  PD_TERN_GAP_POLICY_NONE = 0,
+  PD_TERN_GAP_POLICY_FIXED = 1,
+  PD_TERN_GAP_POLICY_SPREAD = 2,
+} p4_pd_tbl_prop_tern_gap_policy_value_t;
+
 typedef union p4_pd_tbl_prop_value {
   uint32_t value;
   p4_pd_tbl_prop_scope_value_t scope;
   p4_pd_tbl_prop_tern_placement_value_t tern_placement;
   p4_pd_tbl_prop_duplicate_entry_check_value_t duplicate_check;
   p4_pd_tbl_prop_idletime_repeated_notification_enable_value_t repeated_notify;
+  p4_pd_tbl_prop_tern_gap_policy_value_t gap_policy;
 } p4_pd_tbl_prop_value_t;
 
 #define PD_MAX_USER_DEFINED_SCOPES 4
@@ -743,6 +743,51 @@ bf_status_t BfRtTableAttributesPREDeviceConfig::preMaxNodeThresholdParamGet(
   return BF_SUCCESS;
 }
 
+bf_status_t BfRtTableAttributesPREDeviceConfig::preRdmUsageParamSet(
+    const uint32_t &used_entries,
+    const uint32_t &free_entries,
+    const uint32_t &largest_free_block,
+    const uint32_t &fragmentation) {
+  this->active_pre_attributes_.insert(this->PREAttributeType::PRE_RDM_USAGE);
+
+  rdm_used_entries_ = used_entries;
+  rdm_free_entries_ = free_entries;
+  rdm_largest_free_block_ = largest_free_block;
+  rdm_fragmentation_ = fragmentation;
+
+  return BF_SUCCESS;
+}
+
+bf_status_t BfRtTableAttributesPREDeviceConfig::preRdmUsageParamGet(
+    uint32_t *used_entries,
+    uint32_t *free_entries,
+    uint32_t *largest_free_block,
+    uint32_t *fragmentation) const {
+  if (used_entries == NULL || free_entries == NULL ||
+      largest_free_block == NULL || fragmentation == NULL) {
+    LOG_ERROR(
+        "%s:%d No memory assigned for out-param(s) to get PRE RDM usage "
+        "attribute",
+        __func__,
+        __LINE__);
+    return BF_INVALID_ARG;
+  }
+
+  // Only present once the attributes have been read from a PRE table
+  auto elem =
+      this->active_pre_attributes_.find(this->PREAttributeType::PRE_RDM_USAGE);
+  if (elem == this->active_pre_attributes_.end()) {
+    return BF_OBJECT_NOT_FOUND;
+  }
+
+  *used_entries = rdm_used_entries_;
+  *free_entries = rdm_free_entries_;
+  *largest_free_block = rdm_largest_free_block_;
+  *fragmentation = rdm_fragmentation_;
+
+  return BF_SUCCESS;
+}
+
 void BfRtTableAttributesPREDeviceConfig::preDeviceConfigParamsClear() {
   // Clear the active PRE attributes set
   this->active_pre_attributes_.clear();
@@ -756,6 +801,10 @@ void BfRtTableAttributesPREDeviceConfig::preDeviceConfigParamsClear() {
   max_nodes_before_yield_ = 0;
   max_node_threshold_node_count_ = 0;
   max_node_threshold_port_lag_count_ = 0;
+  rdm_used_entries_ = 0;
+  rdm_free_entries_ = 0;
+  rdm_largest_free_block_ = 0;
+  rdm_fragmentation_ = 0;
 }
 
 BfRtTableAttributesSelectorUpdateCallback::
@@ -1580,6 +1629,40 @@ bf_status_t BfRtTableAttributesImpl::preMaxNodeThresholdGet(
                                                         node_port_lag_count);
 }
 
+bf_status_t BfRtTableAttributesImpl::preRdmUsageSet(
+    const uint32_t &used_entries,
+    const uint32_t &free_entries,
+    const uint32_t &largest_free_block,
+    const uint32_t &fragmentation) {
+  if (attr_type_ != TableAttributesType::PRE_DEVICE_CONFIG) {
+    LOG_ERROR(
+        "%s:%d Can't set PRE RDM Usage Attribute with Object of type %d",
+        __func__,
+        __LINE__,
+        static_cast<int>(attr_type_));
+    return BF_INVALID_ARG;
+  }
+  return pre_device_config_.preRdmUsageParamSet(
+      used_entries, free_entries, largest_free_block, fragmentation);
+}
+
+bf_status_t BfRtTableAttributesImpl::preRdmUsageGet(
+    uint32_t *used_entries,
+    uint32_t *free_entries,
+    uint32_t *largest_free_block,
+    uint32_t *fragmentation) const {
+  if (attr_type_ != TableAttributesType::PRE_DEVICE_CONFIG) {
+    LOG_ERROR(
+        "%s:%d Can't get PRE RDM Usage Attribute with Object of type %d",
+        __func__,
+        __LINE__,
+        static_cast<int>(attr_type_));
+    return BF_INVALID_ARG;
+  }
+  return pre_device_config_.preRdmUsageParamGet(
+      used_entries, free_entries, largest_free_block, fragmentation);
+}
+
 bf_status_t BfRtTableAttributesImpl::selectorUpdateCbSet(
     const bool &enable,
     const std::shared_ptr<BfRtSession> session,
@@ -257,7 +257,8 @@ class BfRtTableAttributesPREDeviceConfig {
     PRE_FAST_FAILOVER = 1,
     PRE_PORT_PROTECTION = 2,
     PRE_MAX_NODES_BEFORE_YIELD = 3,
-    PRE_MAX_NODE_THRESHOLD = 4
+    PRE_MAX_NODE_THRESHOLD = 4,
+    PRE_RDM_USAGE = 5
   };
 
   BfRtTableAttributesPREDeviceConfig();
@@ -268,6 +269,10 @@ class BfRtTableAttributesPREDeviceConfig {
   bf_status_t preMaxNodesBeforeYieldParamSet(const uint32_t &count);
   bf_status_t preMaxNodeThresholdParamSet(const uint32_t &node_count,
                                           const uint32_t &node_port_lag_count);
+  bf_status_t preRdmUsageParamSet(const uint32_t &used_entries,
+                                  const uint32_t &free_entries,
+                                  const uint32_t &largest_free_block,
+                                  const uint32_t &fragmentation);
 
   void preDeviceConfigParamsClear();
 
@@ -277,6 +282,10 @@ class BfRtTableAttributesPREDeviceConfig {
   bf_status_t preMaxNodesBeforeYieldParamGet(uint32_t *count) const;
   bf_status_t preMaxNodeThresholdParamGet(uint32_t *node_count,
                                           uint32_t *node_port_lag_count) const;
+  bf_status_t preRdmUsageParamGet(uint32_t *used_entries,
+                                  uint32_t *free_entries,
+                                  uint32_t *largest_free_block,
+                                  uint32_t *fragmentation) const;
 
  private:
   std::set<PREAttributeType> active_pre_attributes_;
@@ -286,6 +295,10 @@ class BfRtTableAttributesPREDeviceConfig {
   uint32_t max_nodes_before_yield_;             // Initialized by constructor
   uint32_t max_node_threshold_node_count_;      // Initialized by constructor
   uint32_t max_node_threshold_port_lag_count_;  // Initialized by constructor
+  uint32_t rdm_used_entries_;                   // Initialized by constructor
+  uint32_t rdm_free_entries_;                   // Initialized by constructor
+  uint32_t rdm_largest_free_block_;             // Initialized by constructor
+  uint32_t rdm_fragmentation_;                  // Initialized by constructor
 };
 
 class BfRtTableAttributesSelectorUpdateCallback {
@@ -452,8 +465,19 @@ class BfRtTableAttributesImpl : public BfRtTableAttributes {
                                   selUpdateCb *callback_fn,
                                   void **cookie) const override final;
 
+  bf_status_t preRdmUsageGet(uint32_t *used_entries,
+                             uint32_t *free_entries,
+                             uint32_t *largest_free_block,
+                             uint32_t *fragmentation) const override final;
+
   // Hidden functions
   TableAttributesType getAttributeType() const { return attr_type_; }
+  // Read only from the application, set by the PRE MGID table when reading
+  // the attributes.
+  bf_status_t preRdmUsageSet(const uint32_t &used_entries,
+                             const uint32_t &free_entries,
+                             const uint32_t &largest_free_block,
+                             const uint32_t &fragmentation);
   bf_status_t resetAttributeType(const TableAttributesType &attr);
   bf_status_t resetAttributeType(const TableAttributesType &attr,
                                  const TableAttributesIdleTableMode &idle_mode);
@@ -695,6 +695,44 @@ bf_status_t BfRtTableObj::tableEntryGetNext_n(
   return BF_NOT_SUPPORTED;
 }
 
+bf_status_t BfRtTableObj::tableCursorAllocate(
+    std::unique_ptr<BfRtTableCursor> * /*cursor_ret*/) const {
+  // Callers probe for cursor support and fall back to key based walks, so
+  // this is not worth an error log
+  LOG_TRACE("%s:%d %s Table cursor not supported",
+            __func__,
+            __LINE__,
+            table_name_get().c_str());
+  return BF_NOT_SUPPORTED;
+}
+
+bf_status_t BfRtTableObj::tableCursorSet(const BfRtSession & /*session*/,
+                                         const bf_rt_target_t & /*dev_tgt*/,
+                                         const uint64_t & /*flags*/,
+                                         const BfRtTableKey & /*key*/,
+                                         BfRtTableCursor * /*cursor*/) const {
+  LOG_ERROR("%s:%d %s ERROR Table cursor set not supported",
+            __func__,
+            __LINE__,
+            table_name_get().c_str());
+  return BF_NOT_SUPPORTED;
+}
+
+bf_status_t BfRtTableObj::tableCursorGetNext_n(
+    const BfRtSession & /*session*/,
+    const bf_rt_target_t & /*dev_tgt*/,
+    const uint64_t & /*flags*/,
+    BfRtTableCursor * /*cursor*/,
+    const uint32_t & /*n*/,
+    keyDataPairs * /*key_data_pairs*/,
+    uint32_t * /*num_returned*/) const {
+  LOG_ERROR("%s:%d %s ERROR Table cursor get next_n not supported",
+            __func__,
+            __LINE__,
+            table_name_get().c_str());
+  return BF_NOT_SUPPORTED;
+}
+
 bf_status_t BfRtTableObj::tableUsageGet(const BfRtSession & /*session*/,
                                         const bf_rt_target_t & /*dev_tgt*/,
                                         const uint64_t & /*flags*/,
@@ -76,6 +76,52 @@ typedef struct bf_rt_info_action_info_ {
   std::set<Annotation> annotations{};
 } bf_rt_info_action_info_t;
 
+class BfRtTableObj;
+
+// Position of a walk over the entries of a table. The position is the
+// pipe_mgr handle of the last entry returned, which pipe_mgr can continue
+// from even after the entry is gone. A new cursor is positioned before the
+// first entry and is bound to a session and target by its first use.
+class BfRtTableCursorImpl : public BfRtTableCursor {
+ public:
+  BfRtTableCursorImpl(const BfRtTableObj *table) : table_(table) {}
+
+  const BfRtTableObj *tableGet() const { return table_; }
+  bool atStart() const { return !is_set_; }
+  bool atEnd() const { return at_end_; }
+  const bf_rt_handle_t &entHdlGet() const { return ent_hdl_; }
+
+  // Check that a call is made with the session and target the cursor is
+  // bound to
+  bool matches(const BfRtSession &session,
+               const bf_rt_target_t &dev_tgt) const {
+    return !is_bound_ || (sess_hdl_ == session.sessHandleGet() &&
+                          dev_tgt_.dev_id == dev_tgt.dev_id &&
+                          dev_tgt_.pipe_id == dev_tgt.pipe_id);
+  }
+  void bind(const BfRtSession &session, const bf_rt_target_t &dev_tgt) {
+    sess_hdl_ = session.sessHandleGet();
+    dev_tgt_ = dev_tgt;
+    is_bound_ = true;
+  }
+  // Position the cursor after the entry with handle ent_hdl
+  void set(const bf_rt_handle_t &ent_hdl) {
+    ent_hdl_ = ent_hdl;
+    is_set_ = true;
+    at_end_ = false;
+  }
+  void endSet() { at_end_ = true; }
+
+ private:
+  const BfRtTableObj *table_;
+  bool is_bound_{false};
+  bool is_set_{false};
+  bool at_end_{false};
+  bf_rt_id_t sess_hdl_{0};
+  bf_rt_target_t dev_tgt_{};
+  bf_rt_handle_t ent_hdl_{0};
+};
+
 class BfRtTableObj : public BfRtTable {
  public:
   virtual ~BfRtTableObj() = default;
@@ -299,6 +345,24 @@ class BfRtTableObj : public BfRtTable {
       keyDataPairs *key_data_pairs,
       uint32_t *num_returned) const override;
 
+  virtual bf_status_t tableCursorAllocate(
+      std::unique_ptr<BfRtTableCursor> *cursor_ret) const override;
+
+  virtual bf_status_t tableCursorSet(const BfRtSession &session,
+                                     const bf_rt_target_t &dev_tgt,
+                                     const uint64_t &flags,
+                                     const BfRtTableKey &key,
+                                     BfRtTableCursor *cursor) const override;
+
+  virtual bf_status_t tableCursorGetNext_n(
+      const BfRtSession &session,
+      const bf_rt_target_t &dev_tgt,
+      const uint64_t &flags,
+      BfRtTableCursor *cursor,
+      const uint32_t &n,
+      keyDataPairs *key_data_pairs,
+      uint32_t *num_returned) const override;
+
   virtual bf_status_t tableUsageGet(const BfRtSession &session,
                                     const bf_rt_target_t &dev_tgt,
                                     const uint64_t &flags,
@@ -299,66 +299,24 @@ static bf_status_t populate_data_fields(const BfRtTableObj &table,
   return BF_SUCCESS;
 }
 
-bf_status_t get_next_n_entries(const BfRtTableObj &table,
-                               const BfRtSession &session,
-                               const bf_rt_target_t &dev_tgt,
-                               const uint64_t &flags,
-                               const BfRtTableKey &key,
-                               const uint32_t &n,
-                               BfRtTable::keyDataPairs *key_data_pairs,
-                               uint32_t *num_returned) {
+// Fetch the n entries following pipe_entry_hdl into the key/data pairs
+// starting at index first of key_data_pairs.
+bf_status_t get_next_n_entries_from_hdl(
+    const BfRtTableObj &table,
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t &flags,
+    const pipe_mat_ent_hdl_t &pipe_entry_hdl,
+    const uint32_t &n,
+    const uint32_t &first,
+    BfRtTable::keyDataPairs *key_data_pairs,
+    uint32_t *num_returned,
+    pipe_mat_ent_hdl_t *last_ent_hdl) {
   auto *pipeMgr = PipeMgrIntf::getInstance(session);
-
-  const BfRtMatchActionKey &match_key =
-      static_cast<const BfRtMatchActionKey &>(key);
-
   dev_target_t pipe_dev_tgt;
   pipe_dev_tgt.device_id = dev_tgt.dev_id;
   pipe_dev_tgt.dev_pipe_id = dev_tgt.pipe_id;
-
-  // First, get pipe-mgr entry handle associated with this key, since any get
-  // API exposed by pipe-mgr needs entry handle
-  pipe_mat_ent_hdl_t pipe_entry_hdl;
-  pipe_tbl_match_spec_t pipe_match_spec = {0};
-  match_key.populate_match_spec(&pipe_match_spec);
-  bf_status_t status =
-      pipeMgr->pipeMgrMatchSpecToEntHdl(session.sessHandleGet(),
-                                        pipe_dev_tgt,
-                                        table.tablePipeHandleGet(),
-                                        &pipe_match_spec,
-                                        &pipe_entry_hdl,
-                                        false /* light_pipe_validation */);
-  // If key is not found and this is subsequent call, API should continue
-  // from previous call.
-  if (status == BF_OBJECT_NOT_FOUND) {
-    // Warn the user that currently used key no longer exist.
-    LOG_WARN("%s:%d %s Provided key does not exist, trying previous handle",
-             __func__,
-             __LINE__,
-             table.table_name_get().c_str());
-    auto device_state = BfRtDevMgrImpl::bfRtDeviceStateGet(
-        dev_tgt.dev_id, table.programNameGet());
-    if (nullptr == device_state) {
-      LOG_ERROR("%s:%d Failed to get device state for dev_id=%d",
-                __func__,
-                __LINE__,
-                dev_tgt.dev_id);
-      BF_RT_DBGCHK(0);
-      return BF_UNEXPECTED;
-    }
-
-    auto nextRef = device_state->nextRefState.getObjState(table.table_id_get());
-    status = nextRef->getRef(
-        session.sessHandleGet(), dev_tgt.pipe_id, &pipe_entry_hdl);
-  }
-
-  if (status != BF_SUCCESS) {
-    LOG_TRACE("%s:%d %s ERROR : Entry does not exist",
-              __func__,
-              __LINE__,
-              table.table_name_get().c_str());
-    return status;
-  }
+  bf_status_t status = BF_SUCCESS;
 
   std::vector<pipe_action_spec_t *> pipe_action_specs(n, nullptr);
   std::vector<pipe_tbl_match_spec_t> pipe_match_specs(n, {0});
@@ -367,9 +325,9 @@ bf_status_t get_next_n_entries(const BfRtTableObj &table,
   unsigned i = 0;
   BfRtMatchActionKey *this_key = nullptr;
   for (i = 0; i < n; i++) {
-    this_key = static_cast<BfRtMatchActionKey *>((*key_data_pairs)[i].first);
-    auto this_data =
-        static_cast<BfRtMatchActionTableData *>((*key_data_pairs)[i].second);
+    const auto &key_data = (*key_data_pairs)[first + i];
+    this_key = static_cast<BfRtMatchActionKey *>(key_data.first);
+    auto this_data = static_cast<BfRtMatchActionTableData *>(key_data.second);
     bf_rt_id_t table_id_from_data;
     const BfRtTable *table_from_data;
     this_data->getParent(&table_from_data);
@@ -433,7 +391,7 @@ bf_status_t get_next_n_entries(const BfRtTableObj &table,
   std::vector<pipe_act_fn_hdl_t> act_fn_hdls(n, 0);
   std::vector<pipe_res_get_data_t> res_data(n, {0});
   pipe_action_spec_t **aspecs = pipe_action_specs.data();
-  pipe_mat_ent_hdl_t last_ent_hdl = 0;
+  *num_returned = 0;
 
   status =
       pipeMgr->pipeMgrGetNextEntries(session.sessHandleGet(),
@@ -447,7 +405,7 @@ bf_status_t get_next_n_entries(const BfRtTableObj &table,
                                      aspecs,
                                      act_fn_hdls.data(),
                                      res_data.data(),
-                                     &last_ent_hdl,
+                                     last_ent_hdl,
                                      num_returned);
   if (PIPE_SUCCESS != status) {
     LOG_TRACE("%s:%d %s ERROR : Error fetching %d next entries.",
@@ -459,15 +417,97 @@ bf_status_t get_next_n_entries(const BfRtTableObj &table,
   }
 
   for (i = 0; i < *num_returned; i++) {
-    this_key = static_cast<BfRtMatchActionKey *>((*key_data_pairs)[i].first);
-    auto this_data = (*key_data_pairs)[i].second;
-    if (populate_data_fields(
-            table, session, dev_tgt, res_data[i], act_fn_hdls[i], this_data)) {
-      (*key_data_pairs)[i].second = nullptr;
+    auto &key_data = (*key_data_pairs)[first + i];
+    this_key = static_cast<BfRtMatchActionKey *>(key_data.first);
+    if (populate_data_fields(table,
+                             session,
+                             dev_tgt,
+                             res_data[i],
+                             act_fn_hdls[i],
+                             key_data.second)) {
+      key_data.second = nullptr;
     }
     this_key->setPriority(pipe_match_specs[i].priority);
     this_key->setPartitionIndex(pipe_match_specs[i].partition_index);
   }
+  return BF_SUCCESS;
+}
+
+bf_status_t get_next_n_entries(const BfRtTableObj &table,
+                               const BfRtSession &session,
+                               const bf_rt_target_t &dev_tgt,
+                               const uint64_t &flags,
+                               const BfRtTableKey &key,
+                               const uint32_t &n,
+                               BfRtTable::keyDataPairs *key_data_pairs,
+                               uint32_t *num_returned) {
+  auto *pipeMgr = PipeMgrIntf::getInstance(session);
+
+  const BfRtMatchActionKey &match_key =
+      static_cast<const BfRtMatchActionKey &>(key);
+
+  dev_target_t pipe_dev_tgt;
+  pipe_dev_tgt.device_id = dev_tgt.dev_id;
+  pipe_dev_tgt.dev_pipe_id = dev_tgt.pipe_id;
+
+  // First, get pipe-mgr entry handle associated with this key, since any get
+  // API exposed by pipe-mgr needs entry handle
+  pipe_mat_ent_hdl_t pipe_entry_hdl;
+  pipe_tbl_match_spec_t pipe_match_spec = {0};
+  match_key.populate_match_spec(&pipe_match_spec);
+  bf_status_t status =
+      pipeMgr->pipeMgrMatchSpecToEntHdl(session.sessHandleGet(),
+                                        pipe_dev_tgt,
+                                        table.tablePipeHandleGet(),
+                                        &pipe_match_spec,
+                                        &pipe_entry_hdl,
+                                        false /* light_pipe_validation */);
+  // If key is not found and this is subsequent call, API should continue
+  // from previous call.
+  if (status == BF_OBJECT_NOT_FOUND) {
+    // Warn the user that currently used key no longer exist.
+    LOG_WARN("%s:%d %s Provided key does not exist, trying previous handle",
+             __func__,
+             __LINE__,
+             table.table_name_get().c_str());
+    auto device_state = BfRtDevMgrImpl::bfRtDeviceStateGet(
+        dev_tgt.dev_id, table.programNameGet());
+    if (nullptr == device_state) {
+      LOG_ERROR("%s:%d Failed to get device state for dev_id=%d",
+                __func__,
+                __LINE__,
+                dev_tgt.dev_id);
+      BF_RT_DBGCHK(0);
+      return BF_UNEXPECTED;
+    }
+
+    auto nextRef = device_state->nextRefState.getObjState(table.table_id_get());
+    status = nextRef->getRef(
+        session.sessHandleGet(), dev_tgt.pipe_id, &pipe_entry_hdl);
+  }
+
+  if (status != BF_SUCCESS) {
+    LOG_TRACE("%s:%d %s ERROR : Entry does not exist",
+              __func__,
+              __LINE__,
+              table.table_name_get().c_str());
+    return status;
+  }
+
+  pipe_mat_ent_hdl_t last_ent_hdl = 0;
+  status = get_next_n_entries_from_hdl(table,
+                                       session,
+                                       dev_tgt,
+                                       flags,
+                                       pipe_entry_hdl,
+                                       n,
+                                       0,
+                                       key_data_pairs,
+                                       num_returned,
+                                       &last_ent_hdl);
+  if (status != BF_SUCCESS) {
+    return status;
+  }
 
   auto device_state = BfRtDevMgrImpl::bfRtDeviceStateGet(
       dev_tgt.dev_id, table.programNameGet());
@@ -489,6 +529,145 @@ bf_status_t get_next_n_entries(const BfRtTableObj &table,
   return BF_SUCCESS;
 }
 
+bf_status_t cursor_impl_get(const BfRtTableObj &table,
+                            BfRtTableCursor *cursor,
+                            BfRtTableCursorImpl **cursor_impl) {
+  auto impl = static_cast<BfRtTableCursorImpl *>(cursor);
+  if (impl == nullptr || impl->tableGet() != &table) {
+    LOG_TRACE("%s:%d %s ERROR : Cursor was not allocated on this table",
+              __func__,
+              __LINE__,
+              table.table_name_get().c_str());
+    return BF_INVALID_ARG;
+  }
+  *cursor_impl = impl;
+  return BF_SUCCESS;
+}
+
+bf_status_t cursor_set(const BfRtTableObj &table,
+                       const BfRtSession &session,
+                       const bf_rt_target_t &dev_tgt,
+                       const uint64_t &flags,
+                       const BfRtTableKey &key,
+                       BfRtTableCursor *cursor) {
+  BfRtTableCursorImpl *cursor_impl;
+  bf_status_t status = cursor_impl_get(table, cursor, &cursor_impl);
+  if (status != BF_SUCCESS) {
+    return status;
+  }
+  bf_rt_handle_t entry_hdl;
+  status = table.tableEntryHandleGet(session, dev_tgt, flags, key, &entry_hdl);
+  if (status != BF_SUCCESS) {
+    return status;
+  }
+  cursor_impl->bind(session, dev_tgt);
+  cursor_impl->set(entry_hdl);
+  return BF_SUCCESS;
+}
+
+bf_status_t get_next_n_entries_cursor(const BfRtTableObj &table,
+                                      const BfRtSession &session,
+                                      const bf_rt_target_t &dev_tgt,
+                                      const uint64_t &flags,
+                                      BfRtTableCursor *cursor,
+                                      const uint32_t &n,
+                                      BfRtTable::keyDataPairs *key_data_pairs,
+                                      uint32_t *num_returned) {
+  BfRtTableCursorImpl *cursor_impl;
+  bf_status_t status = cursor_impl_get(table, cursor, &cursor_impl);
+  if (status != BF_SUCCESS) {
+    return status;
+  }
+  if (n == 0 || key_data_pairs == nullptr || key_data_pairs->size() < n ||
+      num_returned == nullptr) {
+    LOG_TRACE("%s:%d %s ERROR : Invalid arguments",
+              __func__,
+              __LINE__,
+              table.table_name_get().c_str());
+    return BF_INVALID_ARG;
+  }
+  if (!cursor_impl->matches(session, dev_tgt)) {
+    LOG_TRACE("%s:%d %s ERROR : Cursor is in use by another session/target",
+              __func__,
+              __LINE__,
+              table.table_name_get().c_str());
+    return BF_INVALID_ARG;
+  }
+  *num_returned = 0;
+  if (cursor_impl->atEnd()) {
+    return BF_OBJECT_NOT_FOUND;
+  }
+  cursor_impl->bind(session, dev_tgt);
+
+  uint32_t first = 0;
+  pipe_mat_ent_hdl_t pipe_entry_hdl = cursor_impl->entHdlGet();
+  if (cursor_impl->atStart()) {
+    // There is no entry to continue from yet, return the first one by handle
+    auto *pipeMgr = PipeMgrIntf::getInstance(session);
+    dev_target_t pipe_dev_tgt;
+    pipe_dev_tgt.device_id = dev_tgt.dev_id;
+    pipe_dev_tgt.dev_pipe_id = dev_tgt.pipe_id;
+    int first_entry_hdl;
+    status = pipeMgr->pipeMgrGetFirstEntryHandle(session.sessHandleGet(),
+                                                 table.tablePipeHandleGet(),
+                                                 pipe_dev_tgt,
+                                                 &first_entry_hdl);
+    if (status == BF_OBJECT_NOT_FOUND) {
+      cursor_impl->endSet();
+      return status;
+    } else if (status != BF_SUCCESS) {
+      LOG_TRACE("%s:%d %s ERROR : cannot get first, status %d",
+                __func__,
+                __LINE__,
+                table.table_name_get().c_str(),
+                status);
+      return status;
+    }
+    pipe_entry_hdl = static_cast<pipe_mat_ent_hdl_t>(first_entry_hdl);
+    status = table.tableEntryGet(session,
+                                 dev_tgt,
+                                 flags,
+                                 pipe_entry_hdl,
+                                 (*key_data_pairs)[0].first,
+                                 (*key_data_pairs)[0].second);
+    if (status != BF_SUCCESS) {
+      return status;
+    }
+    cursor_impl->set(pipe_entry_hdl);
+    first = 1;
+    *num_returned = 1;
+    if (n == 1) {
+      return BF_SUCCESS;
+    }
+  }
+
+  uint32_t n_next = 0;
+  pipe_mat_ent_hdl_t last_ent_hdl = pipe_entry_hdl;
+  status = get_next_n_entries_from_hdl(table,
+                                       session,
+                                       dev_tgt,
+                                       flags,
+                                       pipe_entry_hdl,
+                                       n - first,
+                                       first,
+                                       key_data_pairs,
+                                       &n_next,
+                                       &last_ent_hdl);
+  if (status == BF_OBJECT_NOT_FOUND) {
+    n_next = 0;
+  } else if (status != BF_SUCCESS) {
+    return status;
+  }
+  if (n_next) {
+    cursor_impl->set(last_ent_hdl);
+  }
+  if (n_next < n - first) {
+    cursor_impl->endSet();
+  }
+  *num_returned += n_next;
+  return *num_returned ? BF_SUCCESS : BF_OBJECT_NOT_FOUND;
+}
+
 template <class T>
 bf_status_t getStfulSpecFromPipeMgr(const BfRtSession &session,
                                     const bf_rt_target_t &dev_tgt,
@@ -2705,6 +2884,37 @@ bf_status_t BfRtMatchActionTable::tableEntryGetNext_n(
       *this, session, dev_tgt, flags, key, n, key_data_pairs, num_returned);
 }
 
+bf_status_t BfRtMatchActionTable::tableCursorAllocate(
+    std::unique_ptr<BfRtTableCursor> *cursor_ret) const {
+  *cursor_ret =
+      std::unique_ptr<BfRtTableCursor>(new BfRtTableCursorImpl(this));
+  if (*cursor_ret == nullptr) {
+    return BF_NO_SYS_RESOURCES;
+  }
+  return BF_SUCCESS;
+}
+
+bf_status_t BfRtMatchActionTable::tableCursorSet(
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t &flags,
+    const BfRtTableKey &key,
+    BfRtTableCursor *cursor) const {
+  return cursor_set(*this, session, dev_tgt, flags, key, cursor);
+}
+
+bf_status_t BfRtMatchActionTable::tableCursorGetNext_n(
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t &flags,
+    BfRtTableCursor *cursor,
+    const uint32_t &n,
+    keyDataPairs *key_data_pairs,
+    uint32_t *num_returned) const {
+  return get_next_n_entries_cursor(
+      *this, session, dev_tgt, flags, cursor, n, key_data_pairs, num_returned);
+}
+
 bf_status_t BfRtMatchActionTable::tableSizeGet(const BfRtSession &session,
                                                const bf_rt_target_t &dev_tgt,
                                                const uint64_t &flags,
@@ -3927,6 +4137,37 @@ bf_status_t BfRtMatchActionIndirectTable::tableEntryGetNext_n(
       *this, session, dev_tgt, flags, key, n, key_data_pairs, num_returned);
 }
 
+bf_status_t BfRtMatchActionIndirectTable::tableCursorAllocate(
+    std::unique_ptr<BfRtTableCursor> *cursor_ret) const {
+  *cursor_ret =
+      std::unique_ptr<BfRtTableCursor>(new BfRtTableCursorImpl(this));
+  if (*cursor_ret == nullptr) {
+    return BF_NO_SYS_RESOURCES;
+  }
+  return BF_SUCCESS;
+}
+
+bf_status_t BfRtMatchActionIndirectTable::tableCursorSet(
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t &flags,
+    const BfRtTableKey &key,
+    BfRtTableCursor *cursor) const {
+  return cursor_set(*this, session, dev_tgt, flags, key, cursor);
+}
+
+bf_status_t BfRtMatchActionIndirectTable::tableCursorGetNext_n(
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t &flags,
+    BfRtTableCursor *cursor,
+    const uint32_t &n,
+    keyDataPairs *key_data_pairs,
+    uint32_t *num_returned) const {
+  return get_next_n_entries_cursor(
+      *this, session, dev_tgt, flags, cursor, n, key_data_pairs, num_returned);
+}
+
 bf_status_t BfRtMatchActionIndirectTable::tableDefaultEntrySet(
     const BfRtSession &session,
     const bf_rt_target_t &dev_tgt,
@@ -179,6 +179,23 @@ class BfRtMatchActionTable : public BfRtTableObj {
                                   keyDataPairs *key_data_pairs,
                                   uint32_t *num_returned) const override;
 
+  bf_status_t tableCursorAllocate(
+      std::unique_ptr<BfRtTableCursor> *cursor_ret) const override;
+
+  bf_status_t tableCursorSet(const BfRtSession &session,
+                             const bf_rt_target_t &dev_tgt,
+                             const uint64_t &flags,
+                             const BfRtTableKey &key,
+                             BfRtTableCursor *cursor) const override;
+
+  bf_status_t tableCursorGetNext_n(const BfRtSession &session,
+                                   const bf_rt_target_t &dev_tgt,
+                                   const uint64_t &flags,
+                                   BfRtTableCursor *cursor,
+                                   const uint32_t &n,
+                                   keyDataPairs *key_data_pairs,
+                                   uint32_t *num_returned) const override;
+
   bf_status_t tableSizeGet(const BfRtSession &session,
                            const bf_rt_target_t &dev_tgt,
                            const uint64_t &flags,
@@ -416,6 +433,23 @@ class BfRtMatchActionIndirectTable : public BfRtTableObj {
                                   keyDataPairs *key_data_pairs,
                                   uint32_t *num_returned) const override;
 
+  bf_status_t tableCursorAllocate(
+      std::unique_ptr<BfRtTableCursor> *cursor_ret) const override;
+
+  bf_status_t tableCursorSet(const BfRtSession &session,
+                             const bf_rt_target_t &dev_tgt,
+                             const uint64_t &flags,
+                             const BfRtTableKey &key,
+                             BfRtTableCursor *cursor) const override;
+
+  bf_status_t tableCursorGetNext_n(const BfRtSession &session,
+                                   const bf_rt_target_t &dev_tgt,
+                                   const uint64_t &flags,
+                                   BfRtTableCursor *cursor,
+                                   const uint32_t &n,
+                                   keyDataPairs *key_data_pairs,
+                                   uint32_t *num_returned) const override;
+
   bf_status_t tableSizeGet(const BfRtSession &session,
                            const bf_rt_target_t &dev_tgt,
                            const uint64_t &flags,
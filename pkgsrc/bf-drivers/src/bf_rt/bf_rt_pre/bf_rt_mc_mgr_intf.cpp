@@ -466,6 +466,12 @@ bf_status_t McMgrIntf::mcMgrSetMaxNodeThreshold(bf_mc_session_hdl_t shdl,
       shdl, dev, node_count, node_port_lag_count);
 }
 
+bf_status_t McMgrIntf::mcMgrRdmUsageGet(bf_mc_session_hdl_t shdl,
+                                        bf_dev_id_t dev,
+                                        bf_mc_rdm_usage_t *usage) {
+  return bf_mc_rdm_usage_get(shdl, dev, usage);
+}
+
 bf_status_t McMgrIntf::mcMgrSetPortForwardState(bf_mc_session_hdl_t shdl,
                                                 bf_dev_id_t dev,
                                                 bf_dev_port_t port_id,
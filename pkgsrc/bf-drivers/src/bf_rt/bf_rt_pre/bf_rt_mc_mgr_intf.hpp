@@ -276,6 +276,10 @@ class IMcMgrIntf {
                                                int node_count,
                                                int node_port_lag_count) = 0;
 
+  virtual bf_status_t mcMgrRdmUsageGet(bf_mc_session_hdl_t shdl,
+                                       bf_dev_id_t dev,
+                                       bf_mc_rdm_usage_t *usage) = 0;
+
   virtual bf_status_t mcMgrSetPortForwardState(bf_mc_session_hdl_t shdl,
                                                bf_dev_id_t dev,
                                                bf_dev_port_t port_id,
@@ -578,6 +582,10 @@ class McMgrIntf : public IMcMgrIntf {
                                        int node_count,
                                        int node_port_lag_count);
 
+  bf_status_t mcMgrRdmUsageGet(bf_mc_session_hdl_t shdl,
+                               bf_dev_id_t dev,
+                               bf_mc_rdm_usage_t *usage);
+
   bf_status_t mcMgrSetPortForwardState(bf_mc_session_hdl_t shdl,
                                        bf_dev_id_t dev,
                                        bf_dev_port_t port_id,
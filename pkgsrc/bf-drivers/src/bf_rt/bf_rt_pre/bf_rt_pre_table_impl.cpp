@@ -2077,6 +2077,66 @@ bf_status_t BfRtPREMGIDTable::tableAttributesSet(
   return BF_SUCCESS;
 }
 
+bf_status_t BfRtPREMGIDTable::tableAttributesGet(
+    const BfRtSession &session,
+    const bf_rt_target_t &dev_tgt,
+    const uint64_t & /*flags*/,
+    BfRtTableAttributes *tableAttributes) const {
+  // Check for out param memory
+  if (!tableAttributes) {
+    LOG_TRACE("%s:%d %s Please pass in the tableAttributes",
+              __func__,
+              __LINE__,
+              table_name_get().c_str());
+    return BF_INVALID_ARG;
+  }
+
+  auto tbl_attr_impl = static_cast<BfRtTableAttributesImpl *>(tableAttributes);
+  const auto attr_type = tbl_attr_impl->getAttributeType();
+
+  std::set<TableAttributesType> attribute_type_set;
+  bf_status_t status = tableAttributesSupported(&attribute_type_set);
+  if (status != BF_SUCCESS ||
+      (attribute_type_set.find(attr_type) == attribute_type_set.end())) {
+    LOG_TRACE("%s:%d %s Error : Attribute %d is not supported",
+              __func__,
+              __LINE__,
+              table_name_get().c_str(),
+              static_cast<int>(attr_type));
+    return BF_NOT_SUPPORTED;
+  }
+
+  if (attr_type != TableAttributesType::PRE_DEVICE_CONFIG) {
+    LOG_TRACE("%s:%d %s Error : Invalid Attribute Type %d",
+              __func__,
+              __LINE__,
+              table_name_get().c_str(),
+              static_cast<int>(attr_type));
+    return BF_INVALID_ARG;
+  }
+
+  // Only the RDM usage is read back, the other PRE attributes are write
+  // only.
+  bf_mc_rdm_usage_t usage;
+  auto *mcMgr = McMgrIntf::getInstance(session);
+  status = mcMgr->mcMgrRdmUsageGet(
+      session.preSessHandleGet(), dev_tgt.dev_id, &usage);
+  if (status != BF_SUCCESS) {
+    LOG_TRACE(
+        "%s:%d %s Error : Failed to get PRE RDM usage, status = %d",
+        __func__,
+        __LINE__,
+        table_name_get().c_str(),
+        status);
+    return status;
+  }
+
+  return tbl_attr_impl->preRdmUsageSet(usage.used_entries,
+                                       usage.free_entries,
+                                       usage.largest_free_block,
+                                       usage.fragmentation);
+}
+
 // Node Table APIs
 bf_status_t BfRtPREMulticastNodeTable::tableEntryAdd(
     const BfRtSession &session,
@@ -127,6 +127,11 @@ class BfRtPREMGIDTable : public BfRtTableObj {
       const bf_rt_target_t &dev_tgt,
       const uint64_t &flag,
       const BfRtTableAttributes &tableAttributes) const override final;
+  bf_status_t tableAttributesGet(
+      const BfRtSession &session,
+      const bf_rt_target_t &dev_tgt,
+      const uint64_t &flag,
+      BfRtTableAttributes *tableAttributes) const override final;
 
  private:
   // Helper methods for EntryAdd. EntryMod and EntryModInc
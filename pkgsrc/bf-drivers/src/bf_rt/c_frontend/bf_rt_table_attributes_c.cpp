@@ -255,6 +255,18 @@ bf_status_t bf_rt_attributes_pre_max_nodes_threshold_get(
                                                   node_port_lag_count);
 }
 
+bf_status_t bf_rt_attributes_pre_rdm_usage_get(
+    bf_rt_table_attributes_hdl *tbl_attr,
+    uint32_t *used_entries,
+    uint32_t *free_entries,
+    uint32_t *largest_free_block,
+    uint32_t *fragmentation) {
+  auto table_attributes =
+      reinterpret_cast<const bfrt::BfRtTableAttributesImpl *>(tbl_attr);
+  return table_attributes->preRdmUsageGet(
+      used_entries, free_entries, largest_free_block, fragmentation);
+}
+
 bf_status_t bf_rt_attributes_entry_scope_symmetric_mode_set(
     bf_rt_table_attributes_hdl *tbl_attr, const bool symmetric_mode) {
   auto table_attributes =
@@ -319,6 +319,69 @@ bf_status_t bf_rt_table_entry_get_next_n(const bf_rt_table_hdl *table_hdl,
       num_returned);
 }
 
+bf_status_t bf_rt_table_cursor_allocate(
+    const bf_rt_table_hdl *table_hdl, bf_rt_table_cursor_hdl **cursor_hdl_ret) {
+  auto table = reinterpret_cast<const bfrt::BfRtTable *>(table_hdl);
+  std::unique_ptr<bfrt::BfRtTableCursor> cursor_hdl;
+  auto status = table->tableCursorAllocate(&cursor_hdl);
+  *cursor_hdl_ret =
+      reinterpret_cast<bf_rt_table_cursor_hdl *>(cursor_hdl.release());
+  return status;
+}
+
+bf_status_t bf_rt_table_cursor_deallocate(bf_rt_table_cursor_hdl *cursor_hdl) {
+  auto cursor = reinterpret_cast<bfrt::BfRtTableCursor *>(cursor_hdl);
+  if (cursor == nullptr) {
+    LOG_ERROR("%s:%d null param passed", __func__, __LINE__);
+    return BF_INVALID_ARG;
+  }
+  delete cursor;
+  return BF_SUCCESS;
+}
+
+bf_status_t bf_rt_table_cursor_set(const bf_rt_table_hdl *table_hdl,
+                                   const bf_rt_session_hdl *session,
+                                   const bf_rt_target_t *dev_tgt,
+                                   const uint64_t flags,
+                                   const bf_rt_table_key_hdl *key,
+                                   bf_rt_table_cursor_hdl *cursor) {
+  auto table = reinterpret_cast<const bfrt::BfRtTable *>(table_hdl);
+  return table->tableCursorSet(
+      *reinterpret_cast<const bfrt::BfRtSession *>(session),
+      *dev_tgt,
+      flags,
+      *reinterpret_cast<const bfrt::BfRtTableKey *>(key),
+      reinterpret_cast<bfrt::BfRtTableCursor *>(cursor));
+}
+
+bf_status_t bf_rt_table_cursor_get_next_n(const bf_rt_table_hdl *table_hdl,
+                                          const bf_rt_session_hdl *session,
+                                          const bf_rt_target_t *dev_tgt,
+                                          const uint64_t flags,
+                                          bf_rt_table_cursor_hdl *cursor,
+                                          bf_rt_table_key_hdl **output_keys,
+                                          bf_rt_table_data_hdl **output_data,
+                                          uint32_t n,
+                                          uint32_t *num_returned) {
+  auto table = reinterpret_cast<const bfrt::BfRtTable *>(table_hdl);
+  bfrt::BfRtTable::keyDataPairs key_data_pairs;
+  unsigned i = 0;
+  for (i = 0; i < n; i++) {
+    key_data_pairs.push_back(std::make_pair(
+        reinterpret_cast<bfrt::BfRtTableKey *>(output_keys[i]),
+        reinterpret_cast<bfrt::BfRtTableData *>(output_data[i])));
+  }
+
+  return table->tableCursorGetNext_n(
+      *reinterpret_cast<const bfrt::BfRtSession *>(session),
+      *dev_tgt,
+      flags,
+      reinterpret_cast<bfrt::BfRtTableCursor *>(cursor),
+      n,
+      &key_data_pairs,
+      num_returned);
+}
+
 bf_status_t bf_rt_table_usage_get(const bf_rt_table_hdl *table_hdl,
                                   const bf_rt_session_hdl *session,
                                   const bf_rt_target_t *dev_tgt,
@@ -20,6 +20,7 @@
 
 #include <time.h>
 #include <chrono>
+#include <algorithm>
 #include <ctime>
 #include <future>
 #include <sstream>
@@ -2341,11 +2342,167 @@ Status table_read_default_entry(const BfRtInfo &info,
   return grpc_status;
 }
 
+// Default chunking of Read responses. A client can override both through the
+// "read_chunk_entries" and "read_chunk_bytes" metadata, 0 disables a limit.
+// The byte limit stays well below the 4MB default receive limit of gRPC
+// clients.
+constexpr uint32_t kReadChunkEntriesDefault = 1024;
+constexpr size_t kReadChunkBytesDefault = 1024 * 1024;
+
+// Streams a Read RPC back to the client as a sequence of ReadResponse
+// messages instead of a single one holding every entity read.
+class ReadResponseStreamer {
+ public:
+  ReadResponseStreamer(ServerWriter<bfrt_proto::ReadResponse> *writer,
+                       const uint32_t &chunk_entries,
+                       const size_t &chunk_bytes)
+      : writer_(writer),
+        chunk_entries_(chunk_entries),
+        chunk_bytes_(chunk_bytes) {}
+
+  bfrt_proto::ReadResponse *response() { return &response_; }
+  uint32_t chunkEntries() const { return chunk_entries_; }
+  bool cancelled() const { return cancelled_; }
+
+  // Account for an entity just added to the response. Once the pending
+  // response reaches one of the chunk limits it is written out. Write blocks
+  // while the flow control window of the stream is full, so a slow client
+  // throttles the table walk rather than having the server queue up the
+  // whole table.
+  Status entityAdded(const bfrt_proto::Entity &entity) {
+    pending_entries_++;
+    pending_bytes_ += entity.ByteSizeLong();
+    if ((chunk_entries_ && pending_entries_ >= chunk_entries_) ||
+        (chunk_bytes_ && pending_bytes_ >= chunk_bytes_)) {
+      return flush();
+    }
+    return Status();
+  }
+
+  // Write whatever is left as the last message of the stream. An empty
+  // response is still sent if nothing has been written so far.
+  void finish() {
+    if (cancelled_) return;
+    if (chunks_written_ && !response_.entities_size() &&
+        !response_.status_size()) {
+      return;
+    }
+    writer_->Write(response_);
+  }
+
+ private:
+  Status flush() {
+    if (cancelled_ || !writer_->Write(response_)) {
+      cancelled_ = true;
+      return Status(StatusCode::CANCELLED, "Read RPC stream was closed");
+    }
+    response_.Clear();
+    pending_entries_ = 0;
+    pending_bytes_ = 0;
+    chunks_written_++;
+    return Status();
+  }
+
+  ServerWriter<bfrt_proto::ReadResponse> *writer_;
+  bfrt_proto::ReadResponse response_;
+  const uint32_t chunk_entries_;
+  const size_t chunk_bytes_;
+  uint32_t pending_entries_ = 0;
+  size_t pending_bytes_ = 0;
+  uint32_t chunks_written_ = 0;
+  bool cancelled_ = false;
+};
+
+// One batch of entries returned by tableEntryGetNext_n
+struct ReadAllBatch {
+  std::vector<std::unique_ptr<BfRtTableKey>> keys;
+  std::vector<std::unique_ptr<BfRtTableData>> data;
+  BfRtTable::keyDataPairs key_data_pairs;
+  uint32_t num_returned = 0;
+  // Set once the end of the table has been reached
+  bool end = false;
+};
+
+Status table_read_all_batch_get(const BfRtTable &table,
+                                const BfRtSession &session,
+                                const bf_rt_target_t &target,
+                                const uint64_t &flags,
+                                const bf_rt_id_t &action_id,
+                                const std::vector<bf_rt_id_t> &field_id_vec,
+                                const BfRtTableKey &start_key,
+                                BfRtTableCursor *cursor,
+                                const uint32_t &n,
+                                ReadAllBatch *batch) {
+  bf_status_t bf_status;
+  batch->keys.resize(n);
+  batch->data.resize(n);
+  // Make vector of pair of out params for tableEntryGetNext_n
+  for (uint32_t i = 0; i < n; i++) {
+    bf_status = table.keyAllocate(&batch->keys[i]);
+    check_and_return(bf_status,
+                     "Key Allocate failed for table:%s",
+                     table_name_get(&table).c_str());
+    if (action_id == 0) {
+      if (field_id_vec.size()) {
+        bf_status = table.dataAllocate(field_id_vec, &batch->data[i]);
+      } else {
+        bf_status = table.dataAllocate(&batch->data[i]);
+      }
+    } else {
+      if (field_id_vec.size()) {
+        bf_status =
+            table.dataAllocate(field_id_vec, action_id, &batch->data[i]);
+      } else {
+        bf_status = table.dataAllocate(action_id, &batch->data[i]);
+      }
+    }
+    check_and_return(bf_status,
+                     "Data Allocate failed for table:%s",
+                     table_name_get(&table).c_str());
+    batch->key_data_pairs.push_back(
+        std::make_pair(batch->keys[i].get(), batch->data[i].get()));
+  }
+
+  // With a cursor pipe_mgr continues from where the previous batch ended,
+  // otherwise start_key has to be looked up again
+  if (cursor) {
+    bf_status = table.tableCursorGetNext_n(session,
+                                           target,
+                                           flags,
+                                           cursor,
+                                           n,
+                                           &batch->key_data_pairs,
+                                           &batch->num_returned);
+  } else {
+    bf_status = table.tableEntryGetNext_n(session,
+                                          target,
+                                          flags,
+                                          start_key,
+                                          n,
+                                          &batch->key_data_pairs,
+                                          &batch->num_returned);
+  }
+
+  // BF_OBJECT_NOT_FOUND is not an error here, it is returned in case the
+  // function didn't find all 'n' entries, which is possible and this
+  // is not an error. In such case we shall use num_returned as a number
+  // of entries really read from the table.
+  if (bf_status == BF_OBJECT_NOT_FOUND || batch->num_returned < n) {
+    batch->end = true;
+  } else {
+    check_and_return(bf_status,
+                     "Get next %d entries failed table:%s",
+                     n,
+                     table_name_get(&table).c_str());
+  }
+  return Status();
+}
+
 Status table_read_all(const BfRtInfo &info,
                       const BfRtSession &session,
                       const bf_rt_target_t &target,
                       const bfrt_proto::TableEntry &table_entry,
-                      bfrt_proto::ReadResponse *response) {
+                      ReadResponseStreamer *streamer) {
   LOG_DBG("%s:%d Read all request: %s",
           __func__,
           __LINE__,
@@ -2412,8 +2569,10 @@ Status table_read_all(const BfRtInfo &info,
   bf_rt_id_t actual_action_id;
   bf_status = data_single->actionIdGet(&actual_action_id);
   Status grpc_status;
+  uint32_t entries_read = 0;
   if (!action_id || (action_id && actual_action_id == action_id)) {
-    auto response_table_entry = response->add_entities()->mutable_table_entry();
+    auto entity = streamer->response()->add_entities();
+    auto response_table_entry = entity->mutable_table_entry();
     response_table_entry->set_table_id(table_entry.table_id());
 
     // Update entry_tgt in response only if the request has entry_tgt under
@@ -2429,6 +2588,9 @@ Status table_read_all(const BfRtInfo &info,
     grpc_status = formulateReadResponse(
         *table, field_id_vec, *table_key, *data_single, response_table_entry);
     grpc_check_and_return(grpc_status, "Error forming Read response");
+    entries_read++;
+    grpc_status = streamer->entityAdded(*entity);
+    grpc_check_and_return(grpc_status, "Error sending Read response");
   }
 
   // 5. Get table usage
@@ -2466,100 +2628,121 @@ Status table_read_all(const BfRtInfo &info,
   if (n == 1) {
     return Status();
   }
-  // 6 Prepare for get_all_entries
-  // Allocate data and key for the n
-  unsigned i = 0;
-  BfRtTable::keyDataPairs key_data_pairs;
-  std::vector<std::unique_ptr<BfRtTableKey>> keys(n - 1);
-  std::vector<std::unique_ptr<BfRtTableData>> data(n - 1);
-
-  // Make vector of pair of out params for tableEntryGetNext_n
-  for (i = 0; i < n - 1; i++) {
-    bf_status = table->keyAllocate(&keys[i]);
-    check_and_return(bf_status,
-                     "Key Allocate failed for table:%s",
-                     table_name_get(table).c_str());
-    if (action_id == 0) {
-      if (field_id_vec.size()) {
-        bf_status = table->dataAllocate(field_id_vec, &data[i]);
-      } else {
-        bf_status = table->dataAllocate(&data[i]);
-      }
-    } else {
-      if (field_id_vec.size()) {
-        bf_status = table->dataAllocate(field_id_vec, action_id, &data[i]);
-      } else {
-        bf_status = table->dataAllocate(action_id, &data[i]);
-      }
-    }
-    check_and_return(bf_status,
-                     "Data Allocate failed for table:%s",
-                     table_name_get(table).c_str());
-    key_data_pairs.push_back(std::make_pair(keys[i].get(), data[i].get()));
-  }
-
-  // 7 Get next n entries
-  uint32_t num_returned = 0;
-  bf_status = table->tableEntryGetNext_n(session,
+  // 6 Get the remaining n - 1 entries, a chunk at a time when the response
+  // is streamed in chunks
+  uint32_t remaining = n - 1;
+  uint32_t batch_size = remaining;
+  if (streamer->chunkEntries() && streamer->chunkEntries() < remaining) {
+    batch_size = streamer->chunkEntries();
+  }
+  // Walk the table with a cursor positioned at the first entry where the
+  // table supports it
+  std::unique_ptr<BfRtTableCursor> cursor;
+  if (table->tableCursorAllocate(&cursor) != BF_SUCCESS ||
+      table->tableCursorSet(
+          session, target, flags, *table_key, cursor.get()) != BF_SUCCESS) {
+    cursor.reset();
+  }
+  std::unique_ptr<ReadAllBatch> batch(new ReadAllBatch());
+  grpc_status = table_read_all_batch_get(*table,
+                                         session,
                                          target,
                                          flags,
-                                         *table_key.get(),
-                                         n - 1,
-                                         &key_data_pairs,
-                                         &num_returned);
+                                         action_id,
+                                         field_id_vec,
+                                         *table_key,
+                                         cursor.get(),
+                                         batch_size,
+                                         batch.get());
+  grpc_check_and_return(grpc_status,
+                        "Error reading entries of table:%s",
+                        table_name_get(table).c_str());
 
-  // BF_OBJECT_NOT_FOUND is not an error here, it is returned in case the
-  // function didn't find all 'n - 1' entries, which is possible and this
-  // is not an error. In such case we shall use num_returned as a number
-  // of entries really read from the table.
-  if (bf_status != BF_OBJECT_NOT_FOUND) {
-    check_and_return(bf_status,
-                     "Get last %d entries failed table:%s",
-                     n - 1,
-                     table_name_get(table).c_str());
-  }
+  while (true) {
+    remaining -= batch->num_returned;
+    // 7 Start fetching the next batch from the last key of this one, so
+    // that pipe_mgr walks the table while this batch is serialized and
+    // written to the client. The task only touches the table and next_batch,
+    // and the future is declared after next_batch so that an early return
+    // waits for the task before next_batch goes away.
+    bool more = !batch->end && batch->num_returned && remaining;
+    std::unique_ptr<ReadAllBatch> next_batch;
+    std::future<Status> next_status;
+    if (more) {
+      next_batch.reset(new ReadAllBatch());
+      const BfRtTableKey *start_key =
+          batch->keys[batch->num_returned - 1].get();
+      ReadAllBatch *next = next_batch.get();
+      uint32_t next_n = std::min(batch_size, remaining);
+      next_status = std::async(
+          std::launch::async, [&, start_key, next, next_n]() {
+            return table_read_all_batch_get(*table,
+                                            session,
+                                            target,
+                                            flags,
+                                            action_id,
+                                            field_id_vec,
+                                            *start_key,
+                                            cursor.get(),
+                                            next_n,
+                                            next);
+          });
+    }
 
-  // 8 Formulate read response for all the n entries
-  for (i = 0; i < num_returned; i++) {
-    // Start constructing the proto response
-    auto response_table_entry = response->add_entities()->mutable_table_entry();
-    response_table_entry->set_table_id(table_entry.table_id());
+    // 8 Formulate read response for the entries of this batch
+    for (uint32_t i = 0; i < batch->num_returned; i++) {
+      // Start constructing the proto response
+      auto entity = streamer->response()->add_entities();
+      auto response_table_entry = entity->mutable_table_entry();
+      response_table_entry->set_table_id(table_entry.table_id());
+
+      // Update entry_tgt in response only if the request has entry_tgt under
+      // table_entry
+      if (table_entry.has_entry_tgt()) {
+        response_table_entry->mutable_entry_tgt()->set_device_id(
+            target.dev_id);
+        response_table_entry->mutable_entry_tgt()->set_direction(
+            target.direction);
+        response_table_entry->mutable_entry_tgt()->set_pipe_id(
+            target.pipe_id);
+        response_table_entry->mutable_entry_tgt()->set_prsr_id(
+            target.prsr_id);
+      }
 
-    // Update entry_tgt in response only if the request has entry_tgt under
-    // table_entry
-    if (table_entry.has_entry_tgt()) {
-      response_table_entry->mutable_entry_tgt()->set_device_id(target.dev_id);
-      response_table_entry->mutable_entry_tgt()->set_direction(
-          target.direction);
-      response_table_entry->mutable_entry_tgt()->set_pipe_id(target.pipe_id);
-      response_table_entry->mutable_entry_tgt()->set_prsr_id(target.prsr_id);
+      if ((batch->key_data_pairs[i].second) == nullptr) {
+        continue;
+      }
+      grpc_status = formulateReadResponse(*table,
+                                          field_id_vec,
+                                          *(batch->key_data_pairs[i].first),
+                                          *(batch->key_data_pairs[i].second),
+                                          response_table_entry);
+      if (grpc_status.error_code() != grpc::OK) {
+        LOG_ERROR("%s:%d ERROR in forming read response for the %dth entry",
+                  __func__,
+                  __LINE__,
+                  entries_read + 1);
+        return grpc_status;
+      }
+      entries_read++;
+      grpc_status = streamer->entityAdded(*entity);
+      grpc_check_and_return(grpc_status, "Error sending Read response");
     }
+    if (!more) break;
 
-    if ((key_data_pairs[i].second) == nullptr) {
-      continue;
-    }
-    grpc_status = formulateReadResponse(*table,
-                                        field_id_vec,
-                                        *(key_data_pairs[i].first),
-                                        *(key_data_pairs[i].second),
-                                        response_table_entry);
-    if (grpc_status.error_code() != grpc::OK) {
-      LOG_ERROR("%s:%d ERROR in forming read response for the %dth entry",
-                __func__,
-                __LINE__,
-                i + 2);
-      return grpc_status;
-    }
+    grpc_status = next_status.get();
+    grpc_check_and_return(grpc_status,
+                          "Error reading entries of table:%s",
+                          table_name_get(table).c_str());
+    batch = std::move(next_batch);
   }
 
   // 9 Debug log of returned values.
-  if (grpc_status.error_code() == grpc::OK) {
-    LOG_DBG("%s:%d Sending read all reply for %d entries : \n%s",
-            __func__,
-            __LINE__,
-            n,
-            response->DebugString().c_str());
-  }
+  LOG_DBG("%s:%d Sent read all reply for %d entries of table:%s",
+          __func__,
+          __LINE__,
+          entries_read,
+          table_name_get(table).c_str());
 
   return Status();
 }
@@ -2704,7 +2887,8 @@ Status read_entry(const BfRtInfo &info,
                   const BfRtSession &session,
                   const bf_rt_target_t &target,
                   const bfrt_proto::TableEntry &table_entry,
-                  bfrt_proto::ReadResponse *response) {
+                  ReadResponseStreamer *streamer) {
+  auto response = streamer->response();
   // If key doesn't exist then get all entries
   Status grpc_status = Status();
   if (table_entry.value_case()) {
@@ -2717,7 +2901,7 @@ Status read_entry(const BfRtInfo &info,
       // Even though the read_all might fail, continue reading the default
       // entry before checking and returning error
       auto grpc_all_status =
-          table_read_all(info, session, target, table_entry, response);
+          table_read_all(info, session, target, table_entry, streamer);
       auto grpc_default_status = table_read_default_entry(
           info, session, target, table_entry, response);
       grpc_check_and_return(grpc_all_status, "Error reading all entries");
@@ -3594,7 +3778,9 @@ void processClientMetadata(const ServerContext &context,
                            timespec *deadline_tspec,
                            timespec *deadline_tspec_relative,
                            bool *error_in_resp,
-                           bool *ignore_not_found) {
+                           bool *ignore_not_found,
+                           uint32_t *read_chunk_entries = nullptr,
+                           size_t *read_chunk_bytes = nullptr) {
   const auto &c_metadata = context.client_metadata();
   int deadline_sec = INT_MIN;
   int deadline_nsec = INT_MIN;
@@ -3643,6 +3829,27 @@ void processClientMetadata(const ServerContext &context,
       if (ignore_not_found) {
         *ignore_not_found = true;
       }
+    } else if ((iter->first == "read_chunk_entries" && read_chunk_entries) ||
+               (iter->first == "read_chunk_bytes" && read_chunk_bytes)) {
+      // Limits of the ReadResponse messages a Read is streamed in, 0 means
+      // no limit
+      long long limit = std::stoll(
+          std::string(iter->second.data(), iter->second.length()));
+      if (limit < 0 || limit > UINT32_MAX) {
+        LOG_ERROR(
+            "%s:%d Trying to set %s to an invalid value of %lld. "
+            "Hence using the default",
+            __func__,
+            __LINE__,
+            std::string(iter->first.data(), iter->first.length()).c_str(),
+            limit);
+        continue;
+      }
+      if (iter->first == "read_chunk_entries") {
+        *read_chunk_entries = static_cast<uint32_t>(limit);
+      } else {
+        *read_chunk_bytes = static_cast<size_t>(limit);
+      }
     }
   }
   if (deadline_sec != INT_MIN || deadline_nsec != INT_MIN) {
@@ -4190,11 +4397,15 @@ Status BfRuntimeServiceImpl::Read(
   timespec deadline_tspec = {INT_MIN};
   timespec deadline_tspec_relative = {INT_MIN};
   bool error_in_resp = false;
+  uint32_t read_chunk_entries = kReadChunkEntriesDefault;
+  size_t read_chunk_bytes = kReadChunkBytesDefault;
   processClientMetadata(*context,
                         &deadline_tspec,
                         &deadline_tspec_relative,
                         &error_in_resp,
-                        nullptr);
+                        nullptr,
+                        &read_chunk_entries,
+                        &read_chunk_bytes);
 
   const auto client_id = request->client_id();
   // If it is an independent client performing an RPC, it may not exist
@@ -4210,7 +4421,8 @@ Status BfRuntimeServiceImpl::Read(
                         " for client with id %d",
                         client_id);
   auto device_id = static_cast<bf_dev_id_t>(request->target().device_id());
-  bfrt_proto::ReadResponse response;
+  ReadResponseStreamer streamer(writer, read_chunk_entries, read_chunk_bytes);
+  bfrt_proto::ReadResponse &response = *streamer.response();
   BfRtServerErrorReporter error_reporter("Read Error Status");
   SetFwdConfigLockGuard read_lock(BfRtServer::getInstance().setFwdRwLockget(),
                                   false);
@@ -4295,7 +4507,7 @@ Status BfRuntimeServiceImpl::Read(
         }
 
         grpc_status = read_entry(
-            *info, *session, entry_tgt, entity.table_entry(), &response);
+            *info, *session, entry_tgt, entity.table_entry(), &streamer);
         break;
       }
       case bfrt_proto::Entity::kTableUsage: {
@@ -4340,11 +4552,13 @@ Status BfRuntimeServiceImpl::Read(
       // Push the status to the error reporter
       error_reporter.push_back(grpc_status);
     }
+    // Nobody is listening anymore, no point reading the rest
+    if (streamer.cancelled()) break;
   }
 
   session->sessionCompleteOperations();
 
-  writer->Write(response);
+  streamer.finish();
 
   // Remove ConnectionData object from map for independent clients
   // only if it was inserted as an independent client in this RPC
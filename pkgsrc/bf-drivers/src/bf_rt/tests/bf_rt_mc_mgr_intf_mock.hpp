@@ -332,6 +332,10 @@ class MockIMcMgrIntf : public IMcMgrIntf {
       bf_status_t(bf_mc_session_hdl_t, bf_dev_id_t, bf_mc_lag_id_t, int, int));
   MOCK_METHOD4(mcMgrSetMaxNodeThreshold,
                bf_status_t(bf_mc_session_hdl_t, bf_dev_id_t, int, int));
+  MOCK_METHOD3(mcMgrRdmUsageGet,
+               bf_status_t(bf_mc_session_hdl_t,
+                           bf_dev_id_t,
+                           bf_mc_rdm_usage_t *));
   MOCK_METHOD3(mcMgrSetMaxNodesBeforeYield,
                bf_status_t(bf_mc_session_hdl_t, bf_dev_id_t, int));
   MOCK_METHOD4(
@@ -102,6 +102,13 @@ static ucli_status_t bf_drv_ucli_ucli__reset_trace__(ucli_context_t *uc) {
   return 0;
 }
 
+static ucli_status_t bf_drv_ucli_ucli__enable_trace__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(uc, "enable-trace", 1, "enable-trace <0|1>");
+
+  bf_sys_trace_enable(strtoul(uc->pargs->args[0], NULL, 0) != 0);
+  return 0;
+}
+
 static ucli_status_t bf_drv_ucli_ucli__set_trace_level__(ucli_context_t *uc) {
   UCLI_COMMAND_INFO(
       uc, "set-trace-level", -1, "Set the trace level for a module");
@@ -284,13 +291,13 @@ static ucli_status_t bf_drv_ucli_ucli__trace_buff__(ucli_context_t *uc) {
   /* allocate the buffer to read the trace buffer into */
   buf = (uint8_t *)bf_sys_malloc(size);
   if (!buf) {
-    printf("Error malloc\n");
+    aim_printf(&uc->pvs, "Error malloc\n");
     return 0;
   }
   if (bf_sys_trace_get(buf, size, &len_written) == 0) {
-    printf("%s\n", buf);
+    aim_printf(&uc->pvs, "%s\n", buf);
   } else {
-    printf("Error reading Trace buffer\n");
+    aim_printf(&uc->pvs, "Error reading Trace buffer\n");
   }
   bf_sys_free(buf);
   return 0;
@@ -510,6 +517,7 @@ cleanup:
 static ucli_command_handler_f bf_drv_ucli_handlers__[] = {
     bf_drv_ucli_ucli__dump_trace__,
     bf_drv_ucli_ucli__reset_trace__,
+    bf_drv_ucli_ucli__enable_trace__,
     bf_drv_ucli_ucli__set_trace_level__,
     bf_drv_ucli_ucli__set_log_level__,
     bf_drv_ucli_ucli__trace_buff__,
@@ -201,6 +201,62 @@ void lld_log_dma(int dir,
   }
 }
 
+/* Log a batch of n_descs pushed descriptors, each n_wds words long, laid out
+ * back to back in data.  The log entries are reserved under a single lock
+ * acquisition and share one timestamp.  If the batch is larger than the log
+ * only its newest descriptors are kept.
+ */
+void lld_log_dma_n(bf_dev_id_t dev_id,
+                   bf_subdev_id_t subdev_id,
+                   uint32_t dr,
+                   uint64_t *data,
+                   int n_wds,
+                   int n_descs,
+                   uint64_t head,
+                   uint64_t tail) {
+  struct timeval tm;
+  int e, i, w;
+  int x;
+
+  if (n_descs <= 0) return;
+  if (n_descs > LLD_DMA_LOG_SZ) {
+    data += (n_descs - LLD_DMA_LOG_SZ) * n_wds;
+    n_descs = LLD_DMA_LOG_SZ;
+  }
+  // lock entry determination
+  x = bf_sys_mutex_lock(&lld_dma_log_mtx);
+  if (x) {
+    lld_log_error("Error: DMA Log lock acquire failed: <%d>", x);
+  }
+
+  e = lld_dma_log.next;
+  lld_dma_log.next = (lld_dma_log.next + n_descs) % LLD_DMA_LOG_SZ;
+  x = bf_sys_mutex_unlock(&lld_dma_log_mtx);
+  if (x) {
+    lld_log_error("Error: DMA Log lock release failed: <%d>", x);
+  }
+
+  gettimeofday(&tm, NULL);
+
+  for (i = 0; i < n_descs; i++) {
+    lld_dma_log_entry_t *p_ent = &lld_dma_log.entry[e];
+
+    p_ent->tm = tm;
+    p_ent->dir = 0; /*push*/
+    p_ent->dev_id = dev_id;
+    p_ent->subdev_id = subdev_id;
+    p_ent->dr = dr;
+    p_ent->n_wds = n_wds;
+    p_ent->head = head;
+    p_ent->tail = tail;
+    for (w = 0; w < n_wds && w < 4; w++) {
+      p_ent->data[w] = data[w];
+    }
+    data += n_wds;
+    e = (e == (LLD_DMA_LOG_SZ - 1)) ? 0 : (e + 1);
+  }
+}
+
 // TBD need to pass subdev_id, work with dru_sim on this
 void lld_log_dma_op(bf_dev_id_t dev_id, int is_wr, int len, uint64_t addr) {
   uint64_t tmp[4];
@@ -720,6 +720,97 @@ int dr_push_4(struct lld_dr_view_s *view, uint64_t *desc) {
   return LLD_OK;
 }
 
+/***********************************************************
+ * dr_push_n
+ *
+ * Push up to n_descs DR descriptors into DMA'able memory and
+ * update the tail pointer in the DR view once for the whole
+ * batch.
+ *
+ * The descriptors are laid out back to back in desc, each
+ * view->n_words_per_desc 64b words long.  The ring lock is
+ * taken once, as many descriptors as fit in the free space
+ * are reserved, and they are copied in at most two spans
+ * (before and after the ring wraps).  As with the single
+ * descriptor variants the tail is only published to the
+ * device by a later dr_publish_view().
+ *
+ * Returns the number of descriptors pushed (which may be less
+ * than n_descs if the ring fills) or a negative error code if
+ * none could be pushed.
+ ***********************************************************/
+int dr_push_n(struct lld_dr_view_s *view, uint64_t *desc, int n_descs) {
+  int lock_failed;
+  uint32_t tail_ptr, tail_wrap_bit;
+  uint64_t volatile *dr_desc_addr;
+  int dr_wrap_bit_pos;
+  int n_wds = view->n_words_per_desc;
+  int n, n_first, i;
+
+  if (n_descs <= 0) return LLD_ERR_BAD_PARM;
+  lock_failed = lld_dr_lock(view, LLD_DR_LOCK_RING);
+  if (lock_failed) {
+    return LLD_ERR_LOCK_FAILED;
+  }
+  n = dr_space(view);
+  if (n <= 0) {
+    lld_dr_unlock(view, LLD_DR_LOCK_RING);
+    return LLD_ERR_DR_FULL;
+  }
+  if (n > n_descs) n = n_descs;
+  if (get_dr_pos(view->dev_id,
+                 view->tail,
+                 &dr_wrap_bit_pos,
+                 &tail_ptr,
+                 &tail_wrap_bit)) {
+    lld_dr_unlock(view, LLD_DR_LOCK_RING);
+    return LLD_ERR_BAD_PARM;
+  }
+
+  /* First span runs from the tail up to the end of the ring, the second (if
+   * any) restarts at the base. */
+  n_first = (uint32_t)view->n_entries - tail_ptr;
+  if (n_first > n) n_first = n;
+
+  dr_desc_addr =
+      (uint64_t *)(uintptr_t)(view->base + (tail_ptr * (uint64_t)n_wds * 8));
+  for (i = 0; i < n_first * n_wds; i++) {
+#if __BYTE_ORDER == __ORDER_LITTLE_ENDIAN__
+    dr_desc_addr[i] = desc[i];
+#else
+    dr_desc_addr[i] = htole64(desc[i]);
+#endif
+  }
+  dr_desc_addr = (uint64_t *)(uintptr_t)view->base;
+  for (; i < n * n_wds; i++) {
+#if __BYTE_ORDER == __ORDER_LITTLE_ENDIAN__
+    dr_desc_addr[i - n_first * n_wds] = desc[i];
+#else
+    dr_desc_addr[i - n_first * n_wds] = htole64(desc[i]);
+#endif
+  }
+
+  tail_ptr += n;
+  if (tail_ptr >= (uint32_t)view->n_entries) {  // wrap
+    tail_ptr -= view->n_entries;
+    tail_wrap_bit ^= 0x1;  // toggle wrap bit
+  }
+  view->tail = tail_ptr | (tail_wrap_bit << dr_wrap_bit_pos);
+
+  lld_log_dma_n(view->dev_id,
+                view->subdev_id,
+                view->dr_id,
+                desc,
+                n_wds,
+                n,
+                view->head,
+                view->tail);
+  view->n_descs += n;
+  lld_dr_unlock(view, LLD_DR_LOCK_RING);
+
+  return n;
+}
+
 /***********************************************************
  * dr_pull
  *
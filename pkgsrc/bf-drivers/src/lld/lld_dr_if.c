@@ -49,6 +49,10 @@
 #include "lld_map.h"
 #include "lld_dev.h"
 
+/* Number of descriptors built on the stack per dr_push_n() call by the batch
+ * push APIs. */
+#define LLD_DR_PUSH_N_CHUNK 64
+
 // fwd ref
 static lld_err_t lld_dr_buf_misaligned(bf_dma_addr_t addr, int requirement);
 
@@ -331,6 +335,95 @@ int lld_push_ilist_mcast(bf_dev_id_t dev_id,
                                       msg_id));
 }
 
+/** \brief lld_subdev_push_ilist_mcast_n:
+ *         Push a batch of multicast Instruction List descriptors
+ *         into the IL DR, only for Tof2 and Tof3
+ *
+ * The descriptors are built up front and copied into the DR under a single
+ * lock acquisition with one tail update, see dr_push_n().  None of the lists
+ * request per-instruction responses.  As with the single descriptor API the
+ * caller must still call lld_dr_start to hand the descriptors to the device.
+ *
+ * \param dev_id      : dev_id #
+ * \param subdev_id   : subdev_id #
+ * \param dr_0_3      : which of the 4 inst-list DRs to use
+ * \param n           : number of instruction lists to push
+ * \param list        : bus address of each instruction-list
+ * \param list_len    : length, in bytes, of each instruction-list
+ * \param s_f         : store and forward enable, applies to all lists
+ * \param mcast_vector: 4b mask of pipes to write for each list
+ * \param msg_id      : opaque value for each list, returned on completion
+ *
+ * \return number of descriptors pushed (1..n), fewer than n if the DR filled
+ * \return LLD_ERR_BAD_PARM : invalid chip, DR index or first list
+ * \return LLD_ERR_NOT_READY: chip_add in still progress
+ * \return LLD_ERR_DR_FULL  : no space in DR for any descriptor
+ */
+int lld_subdev_push_ilist_mcast_n(bf_dev_id_t dev_id,
+                                  bf_subdev_id_t subdev_id,
+                                  int dr_0_3,
+                                  int n,
+                                  bf_dma_addr_t *list,
+                                  int *list_len,
+                                  bool s_f,
+                                  uint32_t *mcast_vector,
+                                  uint64_t *msg_id) {
+  lld_dr_view_t *view;
+  bf_dma_dr_id_t dr_id;
+  uint64_t desc[LLD_DR_PUSH_N_CHUNK * 4];
+  int done = 0, cnt, pushed;
+
+  if ((!lld_dev_is_tof2(dev_id)) && (!lld_dev_is_tof3(dev_id)))
+    return LLD_ERR_BAD_PARM;  // invalid chip
+  if (!lld_dev_ready(dev_id, subdev_id))
+    return LLD_ERR_NOT_READY;  // chip not ready to use
+
+  if (dr_0_3 > 3) return LLD_ERR_BAD_PARM;  // invalid inst-list DR index
+  if (n <= 0) return LLD_ERR_BAD_PARM;
+  if (!list || !list_len || !mcast_vector || !msg_id) return LLD_ERR_BAD_PARM;
+  dr_id = lld_dr_tx_pipe_inst_list_0 + dr_0_3;
+  view = lld_map_subdev_id_and_dr_to_view(dev_id, subdev_id, dr_id);
+  if (view == NULL) return LLD_ERR_BAD_PARM;  // invalid chip
+  if (view->n_words_per_desc != 4) return LLD_ERR_BAD_PARM;
+
+  while (done < n) {
+    /* Build as many descriptors as are valid, stopping at the first bad one
+     * so that everything before it is still pushed. */
+    int bad = 0;
+    for (cnt = 0; cnt < LLD_DR_PUSH_N_CHUNK && done + cnt < n; cnt++) {
+      int k = done + cnt;
+      uint32_t attr = 0;
+      dr_msg_tx_t *msg = (dr_msg_tx_t *)&desc[cnt * 4];
+
+      if (list_len[k] <= 0 || list_len[k] > LLD_MAX_DMA_SZ ||
+          (s_f && list_len[k] > LLD_MAX_DMA_SZ_SF) || list[k] == 0 ||
+          lld_dr_buf_misaligned(list[k], 64) || mcast_vector[k] <= 0 ||
+          mcast_vector[k] > 0xF) {
+        bad = 1;
+        break;
+      }
+      attr |= (1 << 4);  // mcast enable
+      attr |= (mcast_vector[k] << 5);
+      attr |= (s_f ? 1 : 0) << 9;
+      format_dr_msg_tx_wd0(
+          desc[cnt * 4], list_len[k], attr, tx_m_type_il, 1, 1);
+      msg->source_address = list[k];
+      msg->destination_address = 0;
+      msg->message_id = msg_id[k];
+    }
+    if (cnt == 0) {
+      return done ? done : LLD_ERR_BAD_PARM;
+    }
+    pushed = dr_push_n(view, desc, cnt);
+    if (pushed < 0) {
+      return done ? done : pushed;
+    }
+    done += pushed;
+    if (pushed < cnt || bad) break;
+  }
+  return done;
+}
+
 /** \brief lld_subdev_push_wb:
  *         Push a write-block descriptor
  *         into the WB DR
@@ -1374,6 +1467,77 @@ int lld_push_fm(bf_dev_id_t dev_id,
   return (lld_subdev_push_fm(dev_id, 0, dr_id, buf, buf_len));
 }
 
+/** \brief lld_subdev_push_fm_n:
+ *         Push a batch of equally sized free buffers to the specified FM DR
+ *
+ * All descriptors are copied into the DR under a single lock acquisition with
+ * one tail update, see dr_push_n().  The caller must still call lld_dr_start
+ * to hand the buffers to the device.
+ *
+ * \param dev_id   : dev_id #
+ * \param subdev_id: subdev_id #
+ * \param dr_id    : enum for associated dr
+ * \param n        : number of buffers in buf
+ * \param buf      : bus address of each free buffer (256B aligned)
+ * \param buf_len  : length of each buffer
+ *
+ * \return number of buffers pushed (1..n), fewer than n if the DR filled
+ * \return LLD_ERR_BAD_PARM : bad chip, dr, buf_len or first buffer
+ * \return LLD_ERR_NOT_READY: chip_add in still progress
+ * \return LLD_ERR_DR_FULL  : no space in DR for any descriptor
+ *
+ */
+int lld_subdev_push_fm_n(bf_dev_id_t dev_id,
+                         bf_subdev_id_t subdev_id,
+                         bf_dma_dr_id_t dr_id,
+                         int n,
+                         bf_dma_addr_t *buf,
+                         int buf_len) {
+  lld_dr_view_t *view;
+  uint64_t desc[LLD_DR_PUSH_N_CHUNK];
+  int buf_sz_fld;
+  int done = 0, cnt, pushed;
+
+  if (!lld_dev_ready(dev_id, subdev_id))
+    return LLD_ERR_NOT_READY;  // chip not ready to use
+
+  if (dr_id < lld_dr_fm_pkt_0) return LLD_ERR_BAD_PARM;  // bad dr
+  if (dr_id > lld_dr_fm_diag) return LLD_ERR_BAD_PARM;   // bad dr
+  if (n <= 0 || buf == NULL) return LLD_ERR_BAD_PARM;
+
+  view = lld_map_subdev_id_and_dr_to_view(dev_id, subdev_id, dr_id);
+  if (view == NULL) return LLD_ERR_BAD_PARM;  // invalid chip
+  if (view->n_words_per_desc != 1) return LLD_ERR_BAD_PARM;
+  if (buf_len < 256) return LLD_ERR_BAD_PARM;             // bad buffer len
+  if (buf_len > LLD_MAX_DMA_SZ) return LLD_ERR_BAD_PARM;  // bad buffer len
+
+  for (buf_sz_fld = 0; buf_sz_fld < 7; buf_sz_fld++) {
+    if (buf_len < (512 << buf_sz_fld)) break;
+  }
+
+  while (done < n) {
+    int bad = 0;
+    for (cnt = 0; cnt < LLD_DR_PUSH_N_CHUNK && done + cnt < n; cnt++) {
+      bf_dma_addr_t b = buf[done + cnt];
+      if (b == 0 || lld_dr_buf_misaligned(b, 256)) {
+        bad = 1;  // bad buffer ptr
+        break;
+      }
+      format_dr_msg_fm_wd0(desc[cnt], (uint64_t)b, buf_sz_fld);
+    }
+    if (cnt == 0) {
+      return done ? done : LLD_ERR_BAD_PARM;
+    }
+    pushed = dr_push_n(view, desc, cnt);
+    if (pushed < 0) {
+      return done ? done : pushed;
+    }
+    done += pushed;
+    if (pushed < cnt || bad) break;
+  }
+  return done;
+}
+
 /** \brief lld_subdev_push_wl:
  *         Push a write list descriptor to the WL DR
  *
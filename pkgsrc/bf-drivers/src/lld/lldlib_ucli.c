@@ -23,6 +23,7 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <time.h>
 #include <target-sys/bf_sal/bf_sys_intf.h>
 #include <lld/lldlib_config.h>
 
@@ -1800,6 +1801,114 @@ static ucli_status_t lld_ucli_ucli__dma_start__(ucli_context_t *uc) {
   return 0;
 }
 
+/* Time pushing n_descs ilist sized descriptors into a host memory copy of a
+ * DR, one descriptor at a time and then in batches.  The ring is drained by
+ * simply moving the head whenever it fills, so only the host side of the push
+ * path (ring lock, descriptor copy, DMA log) is measured.  The test
+ * descriptors do show up in the DMA log. */
+static uint64_t lld_dr_push_perf_run(lld_dr_view_t *view,
+                                     uint64_t *desc,
+                                     int n_descs,
+                                     int batch) {
+  struct timespec start, stop;
+  int done = 0, ret;
+
+  view->head = view->tail = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  while (done < n_descs) {
+    int n = (n_descs - done < batch) ? n_descs - done : batch;
+    if (batch == 1) {
+      ret = dr_push_4(view, desc) == LLD_OK ? 1 : LLD_ERR_DR_FULL;
+    } else {
+      ret = dr_push_n(view, desc, n);
+    }
+    if (ret == LLD_ERR_DR_FULL) {
+      view->head = view->tail;
+      continue;
+    }
+    if (ret < 0) break;
+    done += ret;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  return (stop.tv_sec - start.tv_sec) * 1000000000ull + stop.tv_nsec -
+         start.tv_nsec;
+}
+
+static ucli_status_t lld_ucli_ucli__dr_push_perf__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(uc,
+                    "dr_push_perf",
+                    3,
+                    "Compare single and batched DR descriptor push rates "
+                    "<dev_id> <# descriptors> <batch size>");
+  const int depth = 1024, n_wds = 4;
+  lld_dr_view_t view;
+  uint64_t *desc, ns_single, ns_batch;
+  void *ring;
+  bf_dev_id_t dev_id;
+  int n_descs, batch;
+
+  dev_id = strtoul(uc->pargs->args[0], NULL, 10);
+  n_descs = strtoul(uc->pargs->args[1], NULL, 10);
+  batch = strtoul(uc->pargs->args[2], NULL, 10);
+  if (lld_map_dev_id_to_dev_p(dev_id) == NULL) {
+    aim_printf(&uc->pvs, "Error: Invalid dev_id\n");
+    return 0;
+  }
+  if (n_descs <= 0 || batch <= 1 || batch > depth) {
+    aim_printf(&uc->pvs, "Error: Invalid descriptor count or batch size\n");
+    return 0;
+  }
+
+  ring = bf_sys_malloc(depth * n_wds * 8 + 63);
+  desc = bf_sys_calloc(batch * n_wds, sizeof *desc);
+  if (!ring || !desc) {
+    aim_printf(&uc->pvs, "Error: Out of memory\n");
+    if (ring) bf_sys_free(ring);
+    if (desc) bf_sys_free(desc);
+    return 0;
+  }
+  for (int i = 0; i < batch; i++) {
+    format_dr_msg_tx_wd0(desc[i * n_wds], 64, 1 << 4, tx_m_type_il, 1, 1);
+    desc[i * n_wds + 3] = i;
+  }
+
+  /* The view never touches the device, it only needs the dev_id to decode
+   * the ring pointers for the device family. */
+  memset(&view, 0, sizeof view);
+  view.base = ((uintptr_t)ring + 63ull) & ~63ull;
+  view.n_words_per_desc = n_wds;
+  view.n_entries = depth;
+  view.dev_id = dev_id;
+  view.dr_id = lld_dr_tx_pipe_inst_list_0;
+  view.producer = true;
+  view.lock_reqd = true;
+  bf_sys_mutex_init(&view.mtx[0]);
+  bf_sys_mutex_init(&view.mtx[1]);
+
+  ns_single = lld_dr_push_perf_run(&view, desc, n_descs, 1);
+  ns_batch = lld_dr_push_perf_run(&view, desc, n_descs, batch);
+
+  aim_printf(&uc->pvs,
+             "%d descriptors, DR depth %d, batch size %d\n",
+             n_descs,
+             depth,
+             batch);
+  aim_printf(&uc->pvs,
+             "  single: %8.2f ns/desc %10.0f desc/s\n",
+             (double)ns_single / n_descs,
+             ns_single ? n_descs * 1e9 / ns_single : 0);
+  aim_printf(&uc->pvs,
+             "  batch : %8.2f ns/desc %10.0f desc/s\n",
+             (double)ns_batch / n_descs,
+             ns_batch ? n_descs * 1e9 / ns_batch : 0);
+
+  bf_sys_mutex_del(&view.mtx[0]);
+  bf_sys_mutex_del(&view.mtx[1]);
+  bf_sys_free(desc);
+  bf_sys_free(ring);
+  return 0;
+}
+
 bf_dma_addr_t il_buf_p = 0;
 void *il_buf_v = 0;
 int il_buf_initd = 0;
@@ -6147,6 +6256,7 @@ static ucli_command_handler_f lld_ucli_ucli_handlers__[] = {
     lld_ucli_ucli__mem_info__,
     lld_ucli_ucli__dma_start__,
     lld_ucli_ucli__dma_service__,
+    lld_ucli_ucli__dr_push_perf__,
     lld_ucli_ucli__efuse__,
     lld_ucli_ucli__cfg_diff__,
     lld_ucli_ucli__cfg_load__,
@@ -92,6 +92,12 @@ bf_status_t mc_mgr_init() {
 
   /* Initialize all locks. */
   MC_MGR_LOCK_INIT_R(ctx.mtx_top);
+  for (int i = 0; i < MC_MGR_NUM_DEVICES; ++i) {
+    mc_mgr_lanes_init(&ctx.dev_lanes[i]);
+  }
+  for (int i = 0; i < MC_MGR_NUM_SESSIONS; ++i) {
+    MC_MGR_LOCK_INIT_R(ctx.mtx_session[i]);
+  }
 
   mc_mgr_ctx_p = &ctx;
 
@@ -268,9 +274,11 @@ static bf_status_t mc_mgr_add_device(bf_dev_id_t dev,
   for (subdev = 0; subdev < (int)d->num_subdevices; ++subdev) {
     bf_map_init(&d->tree_len[subdev]);
   }
-  for (int p = 0; p < (int)d->num_max_pipes; ++p) {
-    for (subdev = 0; subdev < (int)d->num_subdevices; ++subdev) {
-      bf_map_init(&d->trees_with_len_updated[subdev][p]);
+  for (int ses = 0; ses < MC_MGR_NUM_SESSIONS; ++ses) {
+    for (int p = 0; p < (int)d->num_max_pipes; ++p) {
+      for (subdev = 0; subdev < (int)d->num_subdevices; ++subdev) {
+        bf_map_init(&d->trees_with_len_updated[ses][subdev][p]);
+      }
     }
   }
 
@@ -418,8 +426,10 @@ static bf_status_t mc_mgr_add_device(bf_dev_id_t dev,
       mc_mgr_set_pmt_wrl(sid, dev, ver, yid);
     }
   }
-  bf_map_init(&d->mgrpinfo_map);
-  (void)mc_mgr_drv_wrl_send(sid, true);
+  for (int lane = 0; lane < MC_MGR_NUM_LANES; ++lane) {
+    bf_map_init(&d->mgrpinfo_map[lane]);
+  }
+  (void)mc_mgr_drv_wrl_send_dev(sid, dev, true);
 
   LOG_TRACE("%s: Device %d add successful.", __func__, dev);
   return BF_SUCCESS;
@@ -448,24 +458,29 @@ static bf_status_t mc_mgr_rmv_device(bf_dev_id_t dev) {
     return BF_INVALID_ARG;
   }
 
-  /* Iterate through group info map and clean up the group state. */
-  while (BF_MAP_OK == bf_map_get_first_rmv(mc_mgr_ctx_mgrp_info_map(dev),
-                                           &not_used,
-                                           (void *)&mgrp_info)) {
-    if (!mgrp_info) continue;
-    bf_map_t *mbrs_map = &mgrp_info->node_mbrs;
+  /* Iterate through group info maps and clean up the group state. */
+  for (int lane = 0; lane < MC_MGR_NUM_LANES; ++lane) {
+    bf_map_t *grpinfo_map = mc_mgr_ctx_lane_mgrp_info_map(dev, lane);
+    while (BF_MAP_OK ==
+           bf_map_get_first_rmv(grpinfo_map, &not_used, (void *)&mgrp_info)) {
+      if (!mgrp_info) continue;
+      bf_map_t *mbrs_map = &mgrp_info->node_mbrs;
 
-    /* Clean up the nodes associated to the group members map. */
-    do {
-      s = bf_map_get_first_rmv(mbrs_map, &not_used, (void *)&node);
-    } while (s == BF_MAP_OK);
+      /* Clean up the nodes associated to the group members map. */
+      do {
+        s = bf_map_get_first_rmv(mbrs_map, &not_used, (void *)&node);
+      } while (s == BF_MAP_OK);
+
+      bf_map_destroy(mbrs_map);
+      MC_MGR_FREE(mgrp_info);
+    }
 
-    bf_map_destroy(mbrs_map);
-    MC_MGR_FREE(mgrp_info);
+    /* Destroy the mgroup info map. */
+    bf_map_destroy(grpinfo_map);
   }
 
-  /* Destroy the mgroup info map. */
-  bf_map_destroy(mc_mgr_ctx_mgrp_info_map(dev));
+  /* Drop work handed to the lanes for the removed RDM. */
+  mc_mgr_lanes_cleanup(mc_mgr_ctx_dev_lanes(dev));
 
   /* Cleanup L1 nodes for device */
   for (s = bf_map_get_first(mc_mgr_ctx_db_l1(dev), &not_used, (void *)&node);
@@ -536,10 +551,13 @@ static bf_status_t mc_mgr_rmv_device(bf_dev_id_t dev) {
 
   for (subdev = 0; subdev < (int)mc_mgr_ctx_num_subdevices(dev); ++subdev) {
     mc_mgr_ctx_tree_len_lock(dev, subdev);
-    for (int p = 0; p < (int)mc_mgr_ctx_num_max_pipes(dev); ++p) {
-      while (-1 != mc_mgr_ctx_get_rmv_len_update(0, dev, subdev, p)) {
+    for (int ses = 0; ses < MC_MGR_NUM_SESSIONS; ++ses) {
+      for (int p = 0; p < (int)mc_mgr_ctx_num_max_pipes(dev); ++p) {
+        while (-1 != mc_mgr_ctx_get_rmv_len_update(ses, dev, subdev, p)) {
+        }
+        bf_map_destroy(
+            mc_mgr_ctx_trees_with_len_updated(ses, dev, subdev, p));
       }
-      bf_map_destroy(mc_mgr_ctx_trees_with_len_updated(dev, subdev, p));
     }
     mc_mgr_ctx_tree_len_unlock(dev, subdev);
 
@@ -737,10 +755,12 @@ static bf_status_t mc_mgr_warm_init_quick(bf_dev_id_t dev) {
   /* Cleanup trees_with_len_updated */
   for (uint32_t subdev = 0; subdev < mc_mgr_ctx_num_subdevices(dev); subdev++) {
     mc_mgr_ctx_tree_len_lock(dev, subdev);
-    for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
-      int mgid = 0;
-      while (-1 != mgid) {
-        mgid = mc_mgr_ctx_get_rmv_len_update(0, dev, subdev, pipe);
+    for (int ses = 0; ses < MC_MGR_NUM_SESSIONS; ++ses) {
+      for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
+        int mgid = 0;
+        while (-1 != mgid) {
+          mgid = mc_mgr_ctx_get_rmv_len_update(ses, dev, subdev, pipe);
+        }
       }
     }
     mc_mgr_ctx_tree_len_unlock(dev, subdev);
@@ -757,6 +777,9 @@ static bf_status_t mc_mgr_warm_init_quick(bf_dev_id_t dev) {
     }
   }
 
+  /* Drop work handed to the lanes. */
+  mc_mgr_lanes_cleanup(mc_mgr_ctx_dev_lanes(dev));
+
   /* Zero DMA pool. */
   mc_mgr_drv_warm_init_quick(dev);
 
@@ -787,38 +810,45 @@ bf_status_t mc_mgr_mgrp_destroy(int sid, bf_dev_id_t dev, bf_mc_grp_id_t mgid) {
   mc_l1_node_t *node = NULL;
   mc_ecmp_grp_t *ecmp = NULL;
   unsigned long not_used;
+  struct mc_mgr_grp_info *mgrp_info = NULL;
+  s = bf_map_get(
+      mc_mgr_ctx_mgrp_info_map(dev, mgid), mgid, (void **)&mgrp_info);
+  if (BF_MAP_OK != s || !mgrp_info) return BF_OBJECT_NOT_FOUND;
+
   /* Find all ECMP groups associated with this MGID and remove their
-   * association.  */
-  for (s = bf_map_get_first(mc_mgr_ctx_db_ecmp(dev), &not_used, (void *)&ecmp);
-       BF_MAP_OK == s;
-       s = bf_map_get_next(mc_mgr_ctx_db_ecmp(dev), &not_used, (void *)&ecmp)) {
-    for (mc_l1_node_t *n = ecmp->refs; n; n = n->ecmp_next) {
-      if (mgid == n->mgid) {
-        sts = mc_mgr_ecmp_dissociate(sid, dev, mgid, ecmp);
-        if (BF_SUCCESS != sts) {
-          LOG_ERROR("Failed to remove ECMP 0x%x from MGID 0x%x on dev %d",
-                    ecmp->handle,
-                    mgid,
-                    dev);
-          return sts;
+   * association.  Only groups with ECMP associations walk the ECMP groups, the
+   * caller then holds the whole device. */
+  if (mc_mgr_mgrp_ecmp_l1_count(dev, mgrp_info)) {
+    bf_map_t *db_ecmp = mc_mgr_ctx_db_ecmp(dev);
+    for (s = bf_map_get_first(db_ecmp, &not_used, (void *)&ecmp);
+         BF_MAP_OK == s;
+         s = bf_map_get_next(db_ecmp, &not_used, (void *)&ecmp)) {
+      for (mc_l1_node_t *n = ecmp->refs; n; n = n->ecmp_next) {
+        if (mgid == n->mgid) {
+          sts = mc_mgr_ecmp_dissociate(sid, dev, mgid, ecmp);
+          if (BF_SUCCESS != sts) {
+            LOG_ERROR("Failed to remove ECMP 0x%x from MGID 0x%x on dev %d",
+                      ecmp->handle,
+                      mgid,
+                      dev);
+            return sts;
+          }
+          break;
         }
-        break;
       }
     }
   }
-  /* Find all nodes associated with this MGID and remove their association. */
-  for (s = bf_map_get_first(mc_mgr_ctx_db_l1(dev), &not_used, (void *)&node);
-       BF_MAP_OK == s;
-       s = bf_map_get_next(mc_mgr_ctx_db_l1(dev), &not_used, (void *)&node)) {
-    if (mgid == node->mgid) {
-      sts = mc_mgr_l1_dissociate(sid, node, mgid);
-      if (BF_SUCCESS != sts) {
-        LOG_ERROR("Failed to remove node 0x%x from MGID 0x%x on dev %d",
-                  node->handle,
-                  mgid,
-                  dev);
-        return sts;
-      }
+  /* Remove the association of every node left in the group, this takes the
+   * node out of the group's member map. */
+  while (BF_MAP_OK == bf_map_get_first(
+                          &mgrp_info->node_mbrs, &not_used, (void *)&node)) {
+    sts = mc_mgr_l1_dissociate(sid, node, mgid);
+    if (BF_SUCCESS != sts) {
+      LOG_ERROR("Failed to remove node 0x%x from MGID 0x%x on dev %d",
+                node->handle,
+                mgid,
+                dev);
+      return sts;
     }
   }
   /* Clean up the tree length memory. */
@@ -841,7 +871,7 @@ bf_status_t mc_mgr_mgrp_get_first_node_mbr(int sid,
   struct mc_mgr_grp_info *mgrp_info = NULL;
   (void)sid;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_WARN("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -885,7 +915,7 @@ bf_status_t mc_mgr_mgrp_get_node_mbr_count(int sid,
   MC_MGR_DBGCHK(mc_mgr_get_mgid_map_bit(dev, mgid) == true);
 
   struct mc_mgr_grp_info *mgrp_info = NULL;
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   bf_status_t s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   MC_MGR_DBGCHK(BF_MAP_OK == s);
 
@@ -908,7 +938,7 @@ bf_status_t mc_mgr_mgrp_get_next_i_node_mbr(int sid,
   struct mc_mgr_grp_info *mgrp_info = NULL;
   (void)sid;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_WARN("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -1012,7 +1042,7 @@ bf_status_t mc_mgr_mgrp_get_ecmp_mbr_count(int sid,
   MC_MGR_DBGCHK(mc_mgr_get_mgid_map_bit(dev, mgid) == true);
 
   struct mc_mgr_grp_info *mgrp_info = NULL;
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   MC_MGR_DBGCHK(BF_MAP_OK == s);
 
@@ -1122,7 +1152,8 @@ bf_status_t mc_mgr_ecmp_alloc(int sid, bf_dev_id_t dev, bf_mc_ecmp_hdl_t h) {
   for (ver = 0; ver < 2; ++ver) {
     for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
       uint32_t a;
-      a = mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_vector, 1);
+      a = mc_mgr_rdm_map_get(
+          sid, dev, -1, pipe, mc_mgr_rdm_node_type_vector, 1);
       if (!a) {
         goto cleanup1;
       }
@@ -1500,7 +1531,7 @@ bf_status_t mc_mgr_l1_associate(int sid,
   bf_status_t sts = BF_SUCCESS;
   struct mc_mgr_grp_info *mgrp_info = NULL;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   bf_map_sts_t s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_ERROR("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -1510,25 +1541,33 @@ bf_status_t mc_mgr_l1_associate(int sid,
     return BF_OBJECT_NOT_FOUND;
   }
 
-  if (-1 != node->mgid) {
+  if (node->ecmp_grp) {
     LOG_ERROR(
         "Failed to associated L1 node %#x with group %#x, already "
-        "associated with group %#x",
+        "associated with ecmp group %#x",
         node->handle,
         mgid,
-        node->mgid);
+        node->ecmp_grp->handle);
     return BF_ALREADY_EXISTS;
-  } else if (node->ecmp_grp) {
+  }
+
+  /* Sessions holding other lanes may try to claim the node at the same time,
+   * only one of them gets it. */
+  int cur_mgid = -1;
+  if (!__atomic_compare_exchange_n(&node->mgid,
+                                   &cur_mgid,
+                                   mgid,
+                                   false,
+                                   __ATOMIC_ACQUIRE,
+                                   __ATOMIC_ACQUIRE)) {
     LOG_ERROR(
         "Failed to associated L1 node %#x with group %#x, already "
-        "associated with ecmp group %#x",
+        "associated with group %#x",
         node->handle,
         mgid,
-        node->ecmp_grp->handle);
+        cur_mgid);
     return BF_ALREADY_EXISTS;
   }
-
-  node->mgid = mgid;
   node->dev = dev;
   node->xid = use_xid ? xid : 0;
   node->xid_valid = use_xid;
@@ -1556,7 +1595,7 @@ bf_status_t mc_mgr_l1_dissociate(int sid,
                                  bf_mc_grp_id_t mgid) {
   struct mc_mgr_grp_info *mgrp_info = NULL;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(node->dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(node->dev, mgid);
   bf_map_sts_t s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_ERROR("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -1566,20 +1605,23 @@ bf_status_t mc_mgr_l1_dissociate(int sid,
     return BF_OBJECT_NOT_FOUND;
   }
 
-  if (-1 == node->mgid) {
+  /* The node may be claimed or released from another lane meanwhile; it can
+   * only belong to this group while this lane is held. */
+  int cur_mgid = __atomic_load_n(&node->mgid, __ATOMIC_ACQUIRE);
+  if (-1 == cur_mgid) {
     LOG_ERROR(
         "Failed to dissocaited L1 node %#x from group %#x, already "
         "dissocaited",
         node->handle,
         mgid);
     return BF_ALREADY_EXISTS;
-  } else if (mgid != node->mgid) {
+  } else if (mgid != cur_mgid) {
     LOG_ERROR(
         "Failed to dissocaited L1 node %#x from group %#x, "
         "associated with group %#x",
         node->handle,
         mgid,
-        node->mgid);
+        cur_mgid);
     return BF_ALREADY_EXISTS;
   } else if (node->ecmp_grp) {
     LOG_ERROR(
@@ -1620,7 +1662,7 @@ bf_status_t mc_mgr_ecmp_associate(int sid,
   bf_status_t sts = BF_SUCCESS;
   struct mc_mgr_grp_info *mgrp_info = NULL;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   bf_map_sts_t s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_ERROR("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -1674,7 +1716,7 @@ bf_status_t mc_mgr_ecmp_dissociate(int sid,
   bf_status_t sts = BF_SUCCESS;
   struct mc_mgr_grp_info *mgrp_info = NULL;
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, mgid);
   bf_map_sts_t s = bf_map_get(grpinfo_map, mgid, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_WARN("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -1843,7 +1885,7 @@ bf_status_t mc_mgr_lag_update(int sid,
 
     /* Perform versioning switch if needed. */
     if (mc_mgr_versioning_on(sid, dev)) {
-      if (BF_SUCCESS != (sts = mc_mgr_drv_wrl_send(sid, false))) {
+      if (BF_SUCCESS != (sts = mc_mgr_drv_wrl_send_dev(sid, dev, false))) {
         MC_MGR_DBGCHK(BF_SUCCESS == sts);
         return sts;
       }
@@ -1905,7 +1947,7 @@ bf_status_t mc_mgr_lag_update_rmt_cnt(
     return sts;
   }
   if (mc_mgr_versioning_on(sid, dev)) {
-    if (BF_SUCCESS != (sts = mc_mgr_drv_wrl_send(sid, false))) {
+    if (BF_SUCCESS != (sts = mc_mgr_drv_wrl_send_dev(sid, dev, false))) {
       MC_MGR_DBGCHK(BF_SUCCESS == sts);
       return sts;
     }
@@ -1971,7 +2013,7 @@ bf_status_t mc_mgr_set_port_fwd_state(int sid,
 
   if (mc_mgr_versioning_on(sid, dev)) {
     /* Push the operations to hardware. */
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to send write list to set port mask dev %d sts %s",
                 dev,
@@ -2185,8 +2227,8 @@ bf_status_t mc_mgr_set_backup_port(int sid,
 
       /* Check if an L1 needs to be added to this pipe. */
       if ((l1_add_mask & (1 << p))) {
-        uint32_t new_l1_rdm_addr =
-            mc_mgr_rdm_map_get(sid, dev, p, mc_mgr_rdm_node_type_rid, 1);
+        uint32_t new_l1_rdm_addr = mc_mgr_rdm_map_get(
+            sid, dev, node->mgid, p, mc_mgr_rdm_node_type_rid, 1);
         if (!new_l1_rdm_addr) {
           sts = BF_NO_SYS_RESOURCES;
           goto cleanup;
@@ -2201,7 +2243,7 @@ bf_status_t mc_mgr_set_backup_port(int sid,
       mc_mgr_get_port_node_size(dev, p, node, &block_sz, NULL);
       if (block_sz) {
         uint32_t new_l2_rdm_addr = mc_mgr_rdm_map_get(
-            sid, dev, p, mc_mgr_rdm_node_type_port72, block_sz);
+            sid, dev, node->mgid, p, mc_mgr_rdm_node_type_port72, block_sz);
         if (!new_l2_rdm_addr) {
           sts = BF_NO_SYS_RESOURCES;
           goto cleanup;
@@ -2220,8 +2262,8 @@ bf_status_t mc_mgr_set_backup_port(int sid,
         if (!((new_lag_pm[lag_id] & (1 << p)) &&
               (~old_lag_pm[lag_id] & (1 << p))))
           continue;
-        uint32_t x =
-            mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_lag, 1);
+        uint32_t x = mc_mgr_rdm_map_get(
+            sid, dev, node->mgid, pipe, mc_mgr_rdm_node_type_lag, 1);
         if (!x) goto cleanup;
         mc_mgr_rdm_addr_append(&to_write_lags, x);
       }
@@ -2362,7 +2404,7 @@ bf_status_t mc_mgr_set_backup_port(int sid,
     }
 
     /* Pushing the pending deleted nodes from the mc-mgr write list. */
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
                 node->handle,
@@ -2440,7 +2482,7 @@ bf_status_t mc_mgr_set_backup_port(int sid,
     /* Pushing the pending deleted nodes from the mc-mgr write list.
      * This also intiates RDM change for deleted nodes amd tail update
      * post DMA completion. */
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
                 node->handle,
@@ -38,7 +38,18 @@
 
 uint8_t mc_mgr_get_tvt(int dev, int mgid);
 
-void mc_mgr_one_at_a_time_begin() { MC_MGR_LOCK_R(mc_mgr_ctx_lock()); }
+/* APIs which span devices take the top level lock and then every device
+ * exclusively, always in increasing device order.  APIs scoped to a single
+ * device hold only that device so different devices can be programmed
+ * concurrently.  APIs scoped to a single MGID hold only the MGID's lane of the
+ * device, see mc_mgr_lane.h, so sessions working on MGIDs in different lanes
+ * of one device also run concurrently. */
+void mc_mgr_one_at_a_time_begin() {
+  MC_MGR_LOCK_R(mc_mgr_ctx_lock());
+  for (bf_dev_id_t dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
+    mc_mgr_lanes_lock_all(mc_mgr_ctx_dev_lanes(dev));
+  }
+}
 
 bf_status_t mc_mgr_one_at_a_time_begin_try() {
   int err;
@@ -46,10 +57,74 @@ bf_status_t mc_mgr_one_at_a_time_begin_try() {
   if (err != 0) {
     return BF_IN_USE;
   }
+  for (bf_dev_id_t dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
+    if (BF_SUCCESS != mc_mgr_lanes_trylock_all(mc_mgr_ctx_dev_lanes(dev))) {
+      while (dev--) mc_mgr_lanes_unlock_all(mc_mgr_ctx_dev_lanes(dev));
+      MC_MGR_UNLOCK_R(mc_mgr_ctx_lock());
+      return BF_IN_USE;
+    }
+  }
   return BF_SUCCESS;
 }
 
-void mc_mgr_one_at_a_time_end() { MC_MGR_UNLOCK_R(mc_mgr_ctx_lock()); }
+void mc_mgr_one_at_a_time_end() {
+  for (bf_dev_id_t dev = MC_MGR_NUM_DEVICES; dev--;) {
+    mc_mgr_lanes_unlock_all(mc_mgr_ctx_dev_lanes(dev));
+  }
+  MC_MGR_UNLOCK_R(mc_mgr_ctx_lock());
+}
+
+/* A device id out of range falls back to the global lock; the caller's own
+ * checks will then reject the request. */
+void mc_mgr_dev_one_at_a_time_begin(bf_dev_id_t dev) {
+  if (0 > dev || MC_MGR_NUM_DEVICES <= dev) {
+    mc_mgr_one_at_a_time_begin();
+    return;
+  }
+  mc_mgr_lanes_lock_all(mc_mgr_ctx_dev_lanes(dev));
+}
+
+bf_status_t mc_mgr_dev_one_at_a_time_begin_try(bf_dev_id_t dev) {
+  if (0 > dev || MC_MGR_NUM_DEVICES <= dev) {
+    return mc_mgr_one_at_a_time_begin_try();
+  }
+  return mc_mgr_lanes_trylock_all(mc_mgr_ctx_dev_lanes(dev));
+}
+
+void mc_mgr_dev_one_at_a_time_end(bf_dev_id_t dev) {
+  if (0 > dev || MC_MGR_NUM_DEVICES <= dev) {
+    mc_mgr_one_at_a_time_end();
+    return;
+  }
+  mc_mgr_lanes_unlock_all(mc_mgr_ctx_dev_lanes(dev));
+}
+
+/* Holds only the MGID's lane, and the session since another lane may be using
+ * it.  The caller must not go on to wait for the device or another lane while
+ * holding it.  An invalid session, device or MGID falls back to the device (or
+ * global) lock and is rejected by the caller's checks. */
+static bool mgid_lock_valid(int sid, bf_dev_id_t dev, int mgid) {
+  return MC_MGR_VALID_SID(sid) && 0 <= dev && MC_MGR_NUM_DEVICES > dev &&
+         0 <= mgid && BF_MGID_COUNT > mgid;
+}
+
+void mc_mgr_mgid_one_at_a_time_begin(int sid, bf_dev_id_t dev, int mgid) {
+  if (!mgid_lock_valid(sid, dev, mgid)) {
+    mc_mgr_dev_one_at_a_time_begin(dev);
+    return;
+  }
+  MC_MGR_LOCK_R(mc_mgr_ctx_session_lock(sid));
+  mc_mgr_lane_lock(mc_mgr_ctx_dev_lanes(dev), mc_mgr_mgid_lane(mgid));
+}
+
+void mc_mgr_mgid_one_at_a_time_end(int sid, bf_dev_id_t dev, int mgid) {
+  if (!mgid_lock_valid(sid, dev, mgid)) {
+    mc_mgr_dev_one_at_a_time_end(dev);
+    return;
+  }
+  mc_mgr_lane_unlock(mc_mgr_ctx_dev_lanes(dev), mc_mgr_mgid_lane(mgid));
+  MC_MGR_UNLOCK_R(mc_mgr_ctx_session_lock(sid));
+}
 
 mc_l1_node_t *mc_mgr_lookup_l1_node(bf_dev_id_t dev,
                                     bf_mc_node_hdl_t h,
@@ -724,7 +799,7 @@ bf_status_t mc_mgr_ecc_correct_mit(bf_dev_id_t dev,
   }
 
   /* Push the write list to correct ecc */
-  return mc_mgr_drv_wrl_send(sid, false);
+  return mc_mgr_drv_wrl_send_dev(sid, dev, false);
 }
 
 mc_mgr_pvt_entry_t mc_mgr_get_pvt_row(bf_dev_id_t dev, int row) {
@@ -1156,14 +1231,14 @@ bf_status_t mc_mgr_allocate_l2_chain(int sid,
 
   if (port_sz) {
     uint32_t x = mc_mgr_rdm_map_get(
-        sid, node->dev, pipe, mc_mgr_rdm_node_type_port72, port_sz);
+        sid, node->dev, node->mgid, pipe, mc_mgr_rdm_node_type_port72, port_sz);
     if (!x) goto not_enough_nodes;
     ++port_addr_cnt;
     mc_mgr_rdm_addr_append(port_addrs, x);
   }
   for (i = 0; i < lag_cnt; ++i) {
-    uint32_t x =
-        mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_lag, 1);
+    uint32_t x = mc_mgr_rdm_map_get(
+        sid, dev, node->mgid, pipe, mc_mgr_rdm_node_type_lag, 1);
     if (!x) goto not_enough_nodes;
     ++lag_addr_cnt;
     mc_mgr_rdm_addr_append(lag_addrs, x);
@@ -1388,7 +1463,8 @@ bf_status_t mc_mgr_l1_remove(int sid, mc_l1_node_t *node) {
   int mgid = node->mgid;
 
   mc_mgr_delete_all_trees(sid, node);
-  node->mgid = -1;
+  /* Last write to the node, it may now be claimed from another lane. */
+  __atomic_store_n(&node->mgid, -1, __ATOMIC_RELEASE);
 
   for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
     /* Get the length of the longest L2 chain in the pipe. */
@@ -1486,7 +1562,7 @@ bf_status_t mc_mgr_ecmp_ptr_write(int sid, mc_l1_node_t *node) {
     if (!(pipe_mask & curr_mask)) continue;
 
     rdm_addrs[p] =
-        mc_mgr_rdm_map_get(sid, dev, p, mc_mgr_rdm_node_type_ecmp, 1);
+        mc_mgr_rdm_map_get(sid, dev, mgid, p, mc_mgr_rdm_node_type_ecmp, 1);
     if (!rdm_addrs[p]) {
       goto not_enough_nodes;
     }
@@ -1725,7 +1801,7 @@ bf_status_t mc_mgr_ecmp_first_mbr_add(int sid,
   }
 
   /* Send all pending RDM writes to HW. */
-  sts = mc_mgr_drv_wrl_send(sid, true);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -1944,7 +2020,7 @@ bf_status_t mc_mgr_ecmp_mbr_add_to_hole(int sid,
   /* Update the active vector. */
   if ((g->refs) && (mc_mgr_versioning_on(sid, dev))) {
     /* Switch versions. */
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != sts) goto not_enough_nodes;
     mc_mgr_drv_cmplt_operations(sid, dev);
     /* Flip table version. */
@@ -1959,7 +2035,7 @@ bf_status_t mc_mgr_ecmp_mbr_add_to_hole(int sid,
   } else {
     /* Write active vector to use a new mask. */
     mc_mgr_write_actv_vector(sid, dev, g, new_vec, g->base);
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   }
 
   /* Update the TVT/PVT such that traffic sees new pipes if added.*/
@@ -2215,7 +2291,7 @@ bf_status_t mc_mgr_ecmp_mbr_add_to_end(int sid,
   /* Update the active vector. */
   if ((g->refs) && (mc_mgr_versioning_on(sid, dev))) {
     /* Switch versions. */
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != sts) goto not_enough_nodes;
     mc_mgr_drv_cmplt_operations(sid, dev);
     /* Flip table version. */
@@ -2230,7 +2306,7 @@ bf_status_t mc_mgr_ecmp_mbr_add_to_end(int sid,
   } else {
     /* Write active vector to use a new mask. */
     mc_mgr_write_actv_vector(sid, dev, g, new_vec, g->base);
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   }
 
   /* As ecmp grp may got associated to l1-ecmp nodes on some pipes, we update
@@ -2396,7 +2472,7 @@ bf_status_t mc_mgr_ecmp_mbr_rem_one_mbr(int sid,
   /* If the group is associated to any MGIDs a version update must
    * be done to ensure no traffic loss or duplication. */
   if ((g->refs) && (mc_mgr_versioning_on(sid, dev))) {
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
     /* Flip table version. */
     bool ver = mc_mgr_ctx_tbl_ver(dev);
@@ -2409,7 +2485,7 @@ bf_status_t mc_mgr_ecmp_mbr_rem_one_mbr(int sid,
     mc_mgr_write_stby_vector(sid, dev, g, new_vec, g->base);
   } else {
     mc_mgr_write_actv_vector(sid, dev, g, new_vec, g->base);
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   }
 
   /* Go ahead and safely free the L1-End block and the associated L2
@@ -2495,7 +2571,7 @@ bf_status_t mc_mgr_ecmp_mbr_rem_one_mbr(int sid,
   /* Push the write list for "Delete/Update" such that HW does not see the new
    * nodes after TVT/PVT update . Also intiate the RDM change for the freed
    * buffers and tail update. */
-  sts = mc_mgr_drv_wrl_send(sid, true);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -2604,7 +2680,7 @@ bf_status_t mc_mgr_set_backup_ecmps(int sid,
       mc_mgr_get_port_node_size(dev, p, node, &block_sz, NULL);
       if (block_sz) {
         uint32_t new_l2_rdm_addr = mc_mgr_rdm_map_get(
-            sid, dev, p, mc_mgr_rdm_node_type_port72, block_sz);
+            sid, dev, -1, p, mc_mgr_rdm_node_type_port72, block_sz);
         if (!new_l2_rdm_addr) {
           sts = BF_NO_SYS_RESOURCES;
           goto not_enough_nodes;
@@ -2625,7 +2701,7 @@ bf_status_t mc_mgr_set_backup_ecmps(int sid,
               (~old_lag_pm[lag_id] & (1 << p))))
           continue;
         uint32_t x =
-            mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_lag, 1);
+            mc_mgr_rdm_map_get(sid, dev, -1, pipe, mc_mgr_rdm_node_type_lag, 1);
         if (!x) {
           sts = BF_NO_SYS_RESOURCES;
           goto not_enough_nodes;
@@ -2844,7 +2920,7 @@ bf_status_t mc_mgr_set_backup_ecmps(int sid,
     }
 
     /* Pushing the pending add/RDM changes from the mc-mgr write list. */
-    sts = mc_mgr_drv_wrl_send(sid, false);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
                 node->handle,
@@ -2972,7 +3048,7 @@ bf_status_t mc_mgr_set_backup_ecmps(int sid,
      * This also intiates the RDM change post completion, Hence, we
      * get a grace period for the inflight packets to be flushed before
      * deletion of L1 and L2 nodes. */
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
                 node->handle,
@@ -3113,7 +3189,7 @@ bf_status_t mc_mgr_ecmp_l1_write(int sid, mc_l1_node_t *node) {
       if (add_mask & pm) {
         /* Adding the tree to this pipe; get an L1 node. */
         uint32_t new_l1_ecmp_addr =
-            mc_mgr_rdm_map_get(sid, dev, p, mc_mgr_rdm_node_type_ecmp, 1);
+            mc_mgr_rdm_map_get(sid, dev, -1, p, mc_mgr_rdm_node_type_ecmp, 1);
         if (!new_l1_ecmp_addr) {
           goto not_enough_nodes;
         }
@@ -3129,7 +3205,7 @@ bf_status_t mc_mgr_ecmp_l1_write(int sid, mc_l1_node_t *node) {
     int pm = 1 << p;
     if (add_mask & pm) {
       uint32_t new_l1_end_addr = mc_mgr_rdm_map_get(
-          sid, dev, p, mc_mgr_rdm_node_type_end, l1_end_block_sz);
+          sid, dev, -1, p, mc_mgr_rdm_node_type_end, l1_end_block_sz);
       if (!new_l1_end_addr) {
         goto not_enough_nodes;
       }
@@ -3259,7 +3335,7 @@ bf_status_t mc_mgr_ecmp_l1_write(int sid, mc_l1_node_t *node) {
   /* Push the write list for "ADD" such that HW can see the new nodes after
    * TVT/PVT update. Don't return incase of failure, as we will retry after
    * update or delete mask. */
-  sts = mc_mgr_drv_wrl_send(sid, false);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -3435,7 +3511,7 @@ bf_status_t mc_mgr_ecmp_l1_write(int sid, mc_l1_node_t *node) {
 
   /* Push the write list for "Delete/Update" such that HW does not see the old
    * nodes removed after TVT/PVT update */
-  sts = mc_mgr_drv_wrl_send(sid, true);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -3545,8 +3621,8 @@ bf_status_t mc_mgr_l1_write(int sid, mc_l1_node_t *node) {
     int pm = 1 << p;
     if (add_mask & pm) {
       /* Adding the tree to this pipe; get an L1 node. */
-      uint32_t new_l1_addr =
-          mc_mgr_rdm_map_get(sid, dev, p, mc_mgr_rdm_node_type_rid, 1);
+      uint32_t new_l1_addr = mc_mgr_rdm_map_get(
+          sid, dev, node->mgid, p, mc_mgr_rdm_node_type_rid, 1);
       if (!new_l1_addr) {
         goto not_enough_nodes;
       }
@@ -3596,7 +3672,7 @@ bf_status_t mc_mgr_l1_write(int sid, mc_l1_node_t *node) {
   /* Push the write list for "ADD" such that HW can see the new nodes after
    * TVT/PVT update. Don't return if there is a failure to send write list.
    * It will be send again post updates/del commands. */
-  sts = mc_mgr_drv_wrl_send(sid, false);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -3698,7 +3774,7 @@ bf_status_t mc_mgr_l1_write(int sid, mc_l1_node_t *node) {
 
   /* Push the write list for "Delete/Update" such that HW can see the new
    * nodes after TVT/PVT update */
-  sts = mc_mgr_drv_wrl_send(sid, true);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Failed to push mc-mgr write list node 0x%x in group 0x%x",
               node->handle,
@@ -3795,7 +3871,7 @@ bf_status_t mc_mgr_get_l1_ecmps(
     int pm_mask = 1 << pipe;
     if (!(add_mask & pm_mask)) continue;
     uint32_t new_l1_ecmp_addr =
-        mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_ecmp, 1);
+        mc_mgr_rdm_map_get(sid, dev, -1, pipe, mc_mgr_rdm_node_type_ecmp, 1);
     if (!new_l1_ecmp_addr) goto failure;
     l1_ecmp_addr_cnt[pipe]++;
     mc_mgr_rdm_addr_append(&l1_ecmp_addrs[pipe], new_l1_ecmp_addr);
@@ -4011,7 +4087,7 @@ bf_status_t mc_mgr_get_ecmp_blocks(
   for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
     if (!(add_mask & (1 << pipe))) continue;
     uint32_t l1_end_addr =
-        mc_mgr_rdm_map_get(sid, dev, pipe, mc_mgr_rdm_node_type_end, size);
+        mc_mgr_rdm_map_get(sid, dev, -1, pipe, mc_mgr_rdm_node_type_end, size);
     if (!l1_end_addr) goto failure;
     mc_mgr_rdm_addr_append(&l1_end_addrs[pipe], l1_end_addr);
   }
@@ -4124,7 +4200,7 @@ bf_status_t mc_mgr_ecc_correct_pmt(bf_dev_id_t dev, int ver, uint32_t address) {
   }
 
   /* Push the write list to correct ecc */
-  return mc_mgr_drv_wrl_send(sid, false);
+  return mc_mgr_drv_wrl_send_dev(sid, dev, false);
 }
 
 void mc_mgr_program_pvt_shadow(bf_dev_id_t dev, uint16_t mgid, uint8_t mask) {
@@ -4290,7 +4366,7 @@ static bf_status_t mc_mgr_pvt_msk_set(int sid,
   }
 
   if (push) {
-    bf_sts = mc_mgr_drv_wrl_send(sid, false);
+    bf_sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
     if (BF_SUCCESS != bf_sts) {
       LOG_ERROR("Failed to push mc_mgr_set-pvt-mask instruction list (%d)",
                 bf_sts);
@@ -4606,7 +4682,7 @@ bf_status_t mc_mgr_ecc_correct_lit_bm(bf_dev_id_t dev,
   }
 
   /* Push the write list to correct ecc */
-  return mc_mgr_drv_wrl_send(sid, false);
+  return mc_mgr_drv_wrl_send_dev(sid, dev, false);
 }
 
 /* Repair ECC error in LIT_NP entry.
@@ -4648,7 +4724,7 @@ bf_status_t mc_mgr_ecc_correct_lit_np(bf_dev_id_t dev,
   }
 
   /* Push the write list to correct ecc */
-  return mc_mgr_drv_wrl_send(sid, false);
+  return mc_mgr_drv_wrl_send_dev(sid, dev, false);
 }
 
 bf_status_t mc_mgr_program_tbl_ver(int sid, bf_dev_id_t dev, bool ver) {
@@ -27,6 +27,11 @@
 void mc_mgr_one_at_a_time_begin();
 bf_status_t mc_mgr_one_at_a_time_begin_try();
 void mc_mgr_one_at_a_time_end();
+void mc_mgr_dev_one_at_a_time_begin(bf_dev_id_t dev);
+bf_status_t mc_mgr_dev_one_at_a_time_begin_try(bf_dev_id_t dev);
+void mc_mgr_dev_one_at_a_time_end(bf_dev_id_t dev);
+void mc_mgr_mgid_one_at_a_time_begin(int sid, bf_dev_id_t dev, int mgid);
+void mc_mgr_mgid_one_at_a_time_end(int sid, bf_dev_id_t dev, int mgid);
 
 mc_l1_node_t *mc_mgr_lookup_l1_node(bf_dev_id_t dev,
                                     bf_mc_node_hdl_t h,
@@ -445,10 +445,10 @@ static mc_mgr_drv_buf_t *mc_mgr_drv_get_buf(int sid,
         /* Since the session is batching we need to clear the batching state
          * briefly so we can push the batch. */
         mc_mgr_ctx_in_batch_set(sid, false);
-        mc_mgr_drv_wrl_send(sid, false);
+        mc_mgr_drv_wrl_send_dev(sid, dev_id, false);
         mc_mgr_ctx_in_batch_set(sid, true);
       } else if (wl) {
-        mc_mgr_drv_wrl_send(sid, false);
+        mc_mgr_drv_wrl_send_dev(sid, dev_id, false);
       }
     }
 
@@ -708,12 +708,13 @@ static bf_status_t mc_mgr_dma_start(bf_dev_id_t dev_id, bf_subdev_id_t subdev) {
   return status;
 }
 
-bf_status_t mc_mgr_drv_wrl_send(int sid, bool is_last) {
+/* Pushes the session's write list for a single device.  Callers holding only
+ * that device's lock must use this rather than mc_mgr_drv_wrl_send so they do
+ * not touch write lists other threads may be building on other devices. */
+bf_status_t mc_mgr_drv_wrl_send_dev(int sid, bf_dev_id_t dev, bool is_last) {
   int ret = 0;
   int push_cnt[BF_MAX_SUBDEV_COUNT];
   int i;
-  bf_dev_id_t dev = 0;
-  uint64_t dev_map = 0;
   mc_mgr_drv_wr_list_t *wl = NULL;
   bf_dma_addr_t dma_addr;
   bf_subdev_id_t subdev = 0;
@@ -725,205 +726,215 @@ bf_status_t mc_mgr_drv_wrl_send(int sid, bool is_last) {
 
   if (mc_mgr_in_batch(sid)) return BF_SUCCESS;
 
-  for (dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
-    if (!mc_mgr_dev_present(dev)) continue;
-    if (mc_mgr_is_device_locked(dev)) continue;
-    if (mc_mgr_ctx_syncing(dev)) continue;
-    mc_mgr_drv_buf_pool_t *bp = mc_mgr_ctx_dma(dev);
-
-    bf_dma_dr_id_t dr_id;
-    int wl_id;
-    switch (mc_mgr_ctx_dev_family(dev)) {
-      case BF_DEV_FAMILY_TOFINO:
-        wl_id = 0;
-        dr_id = lld_dr_tx_que_write_list;
-        break;
-      case BF_DEV_FAMILY_TOFINO2:
-      case BF_DEV_FAMILY_TOFINO3:
-        wl_id = 1;
-        dr_id = lld_dr_tx_que_write_list_1;
-        break;
-      default:
-        MC_MGR_DBGCHK(0);
-        return BF_UNEXPECTED;
-    }
+  if (!mc_mgr_dev_present(dev)) return BF_SUCCESS;
+  if (mc_mgr_is_device_locked(dev)) return BF_SUCCESS;
+  if (mc_mgr_ctx_syncing(dev)) return BF_SUCCESS;
+  mc_mgr_drv_buf_pool_t *bp = mc_mgr_ctx_dma(dev);
 
-    int num_subdev = mc_mgr_ctx_num_subdevices(dev);
-    bf_subdev_id_t subdev_id = 0;
-    memset(&push_cnt[0], 0, sizeof(push_cnt));
-    for (subdev_id = 0; subdev_id < num_subdev; subdev_id++) {
-      push_cnt[subdev_id] = 0;
+  bf_dma_dr_id_t dr_id;
+  int wl_id;
+  switch (mc_mgr_ctx_dev_family(dev)) {
+    case BF_DEV_FAMILY_TOFINO:
+      wl_id = 0;
+      dr_id = lld_dr_tx_que_write_list;
+      break;
+    case BF_DEV_FAMILY_TOFINO2:
+    case BF_DEV_FAMILY_TOFINO3:
+      wl_id = 1;
+      dr_id = lld_dr_tx_que_write_list_1;
+      break;
+    default:
+      MC_MGR_DBGCHK(0);
+      return BF_UNEXPECTED;
+  }
 
-      wl = mc_mgr_ctx_wl(dev, subdev_id, sid);
-      if (wl == NULL) {
-        /* Ignore if write list of this subdevice is empty */
-        continue;
-      }
+  int num_subdev = mc_mgr_ctx_num_subdevices(dev);
+  bf_subdev_id_t subdev_id = 0;
+  memset(&push_cnt[0], 0, sizeof(push_cnt));
+  for (subdev_id = 0; subdev_id < num_subdev; subdev_id++) {
+    push_cnt[subdev_id] = 0;
+
+    wl = mc_mgr_ctx_wl(dev, subdev_id, sid);
+    if (wl == NULL) {
+      /* Ignore if write list of this subdevice is empty */
+      continue;
+    }
 
-      if (wl->count == 0) {
-        /* It is possible to have RDM addresses to free but no instructions on
-         * the write list.  For example, removing an empty ECMP group that is
-         * not
-         * associated to any MGIDs.  In this case we delete the vector nodes in
-         * the RDM but wouldn't post any writes.  To ensure RDM space is quickly
-         * reclaimed we'll process those frees now. */
-        if ((num_subdev == 1) || ((num_subdev > 1) && (subdev_id == 1))) {
-          bf_map_t *to_free = mc_mgr_ctx_rdm_free_addrs(sid, dev);
-          int num_to_free = bf_map_count(to_free);
-          bool rdm_change_needed = false;
-          for (i = 0; i < num_to_free; ++i) {
-            unsigned long key;
-            void *unused;
-            bf_map_sts_t s = bf_map_get_first_rmv(to_free, &key, &unused);
-            MC_MGR_DBGCHK(BF_MAP_OK == s);
-            uint32_t rdm_addr = key;
-            rdm_change_needed = true;
-            mc_mgr_rdm_map_free(dev, rdm_addr);
-          }
-          if (rdm_change_needed)
-            mc_mgr_start_rdm_change_all_pipes(dev, "wrl push");
+    if (wl->count == 0) {
+      /* It is possible to have RDM addresses to free but no instructions on
+       * the write list.  For example, removing an empty ECMP group that is
+       * not
+       * associated to any MGIDs.  In this case we delete the vector nodes in
+       * the RDM but wouldn't post any writes.  To ensure RDM space is quickly
+       * reclaimed we'll process those frees now. */
+      if ((num_subdev == 1) || ((num_subdev > 1) && (subdev_id == 1))) {
+        bf_map_t *to_free = mc_mgr_ctx_rdm_free_addrs(sid, dev);
+        int num_to_free = bf_map_count(to_free);
+        bool rdm_change_needed = false;
+        for (i = 0; i < num_to_free; ++i) {
+          unsigned long key;
+          void *unused;
+          bf_map_sts_t s = bf_map_get_first_rmv(to_free, &key, &unused);
+          MC_MGR_DBGCHK(BF_MAP_OK == s);
+          uint32_t rdm_addr = key;
+          rdm_change_needed = true;
+          mc_mgr_rdm_map_free(dev, rdm_addr);
         }
-        continue;
+        if (rdm_change_needed)
+          mc_mgr_start_rdm_change_all_pipes(dev, "wrl push");
       }
+      continue;
+    }
 
-      if (is_last) {
-        /* Tag all the MGID updates in this write list against the last buffer
-         * so
-         * that when they come back an RDM change can be started. */
-        mc_mgr_drv_buf_t *last_buf = wl->bufList->prev;
-        mc_mgr_ctx_tree_len_lock(dev, subdev_id);
-        for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
-          int mgid = 0;
-          while (-1 != (mgid = mc_mgr_ctx_get_rmv_len_update(
-                            sid, dev, subdev_id, pipe))) {
-            unsigned long key = (mgid << 8) | pipe;
-            bf_map_add(&last_buf->mgids_updated, key, NULL);
-          }
+    if (is_last) {
+      /* Tag all the MGID updates in this write list against the last buffer
+       * so
+       * that when they come back an RDM change can be started. */
+      mc_mgr_drv_buf_t *last_buf = wl->bufList->prev;
+      mc_mgr_ctx_tree_len_lock(dev, subdev_id);
+      for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
+        int mgid = 0;
+        while (-1 != (mgid = mc_mgr_ctx_get_rmv_len_update(
+                          sid, dev, subdev_id, pipe))) {
+          unsigned long key = (mgid << 8) | pipe;
+          bf_map_add(&last_buf->mgids_updated, key, NULL);
         }
-        mc_mgr_ctx_tree_len_unlock(dev, subdev_id);
-
-        if ((num_subdev == 1) || ((num_subdev > 1) && (subdev_id == 1))) {
-          bf_map_t *rdm_map = mc_mgr_ctx_rdm_free_addrs(sid, dev);
-          unsigned long key = 0;
-          void *data = NULL;
-          while (BF_MAP_OK == bf_map_get_first_rmv(rdm_map, &key, &data)) {
-            bf_map_add(&last_buf->freed_rdm_addrs, key, data);
-          }
+      }
+      mc_mgr_ctx_tree_len_unlock(dev, subdev_id);
+
+      if ((num_subdev == 1) || ((num_subdev > 1) && (subdev_id == 1))) {
+        bf_map_t *rdm_map = mc_mgr_ctx_rdm_free_addrs(sid, dev);
+        unsigned long key = 0;
+        void *data = NULL;
+        while (BF_MAP_OK == bf_map_get_first_rmv(rdm_map, &key, &data)) {
+          bf_map_add(&last_buf->freed_rdm_addrs, key, data);
         }
       }
+    }
 
-      /* For each DMA buffer in the write list... */
-      while (wl->bufList) {
-        mc_mgr_drv_buf_t *b = wl->bufList;
-        BF_LIST_DLL_REM(wl->bufList, b, next, prev);
-        if (b == NULL) {
-          MC_MGR_DBGCHK(0);
-          return BF_UNEXPECTED;
-        }
-        dev_map |= UINT64_C(1) << b->dev;
-        /* Attempt to push it into the DR. */
-        b->buf_pushed = 1;
-        /* Need to map the virtual to DMA address everytime a buffer is used
-         * since
-         * the mapping might be different for different instances for
-         * architectures with IOMMU.  */
-        if (bf_sys_dma_map(b->pool,
-                           b->addr,
-                           b->phys_addr,
-                           b->size,
-                           &dma_addr,
-                           BF_DMA_FROM_CPU) != 0) {
-          LOG_ERROR("Unable to map DMA buffer %p", b->addr);
-          return BF_HW_COMM_FAIL;
-        }
+    /* For each DMA buffer in the write list... */
+    while (wl->bufList) {
+      mc_mgr_drv_buf_t *b = wl->bufList;
+      BF_LIST_DLL_REM(wl->bufList, b, next, prev);
+      if (b == NULL) {
+        MC_MGR_DBGCHK(0);
+        return BF_UNEXPECTED;
+      }
+      /* Attempt to push it into the DR. */
+      b->buf_pushed = 1;
+      /* Need to map the virtual to DMA address everytime a buffer is used
+       * since
+       * the mapping might be different for different instances for
+       * architectures with IOMMU.  */
+      if (bf_sys_dma_map(b->pool,
+                         b->addr,
+                         b->phys_addr,
+                         b->size,
+                         &dma_addr,
+                         BF_DMA_FROM_CPU) != 0) {
+        LOG_ERROR("Unable to map DMA buffer %p", b->addr);
+        return BF_HW_COMM_FAIL;
+      }
 
-        MC_MGR_LOCK(&bp->mtx);
-        ++bp->in_use;
-        MC_MGR_UNLOCK(&bp->mtx);
-        ret = lld_subdev_push_wl(b->dev,
-                                 subdev_id,
-                                 wl_id,
-                                 b->wr_list_size,
-                                 b->count,
-                                 dma_addr,
-                                 b->msgId);
-        if (LLD_ERR_DR_FULL == ret) {
-          b->buf_pushed = 0;
-          /* Publish the DR pointers to the DMA engine. */
-          mc_mgr_dma_start(b->dev, subdev_id);
+      MC_MGR_LOCK(&bp->mtx);
+      ++bp->in_use;
+      MC_MGR_UNLOCK(&bp->mtx);
+      ret = lld_subdev_push_wl(b->dev,
+                               subdev_id,
+                               wl_id,
+                               b->wr_list_size,
+                               b->count,
+                               dma_addr,
+                               b->msgId);
+      if (LLD_ERR_DR_FULL == ret) {
+        b->buf_pushed = 0;
+        /* Publish the DR pointers to the DMA engine. */
+        mc_mgr_dma_start(b->dev, subdev_id);
 
 #ifdef MC_MGR_INLINE_DR_SERVICE
-          /* It is possible that the completion DR is full and if so that
-           * will stop the Tx DR from processing data.  So also service the
-           * completion DR now just incase. */
-          lld_dr_service(b->dev, subdev_id, dr_id, 5);
+        /* It is possible that the completion DR is full and if so that
+         * will stop the Tx DR from processing data.  So also service the
+         * completion DR now just incase. */
+        lld_dr_service(b->dev, subdev_id, dr_id, 5);
 #else
-          /* Wait for the DMA engine to process data. */
-          sched_yield();
+        /* Wait for the DMA engine to process data. */
+        sched_yield();
 #endif
-          /* Unmap the buffer */
-          if ((bf_sys_dma_unmap(b->pool, b->addr, b->size, BF_DMA_FROM_CPU)) !=
-              0) {
-            LOG_ERROR("Unable to unmap DMA buffer %p", b->addr);
-          }
-          /* Retry with the same buffer. */
-          BF_LIST_DLL_PP(wl->bufList, b, next, prev);
-          MC_MGR_LOCK(&bp->mtx);
-          --bp->in_use;
-          MC_MGR_UNLOCK(&bp->mtx);
-          continue;
-        } else if (LLD_OK != ret) {
-          /* Unmap the buffer */
-          if ((bf_sys_dma_unmap(b->pool, b->addr, b->size, BF_DMA_FROM_CPU)) !=
-              0) {
-            LOG_ERROR("Unable to unmap DMA buffer %p", b->addr);
-          }
-          b->buf_pushed = 0;
-          LOG_ERROR(
-              "Write List push for dev %d subdev %d fails (%d), sz 0x%x cnt %d "
-              "addr "
-              "0x%" PRIx64 " id 0x%" PRIx64,
-              dev,
-              subdev,
-              ret,
-              b->wr_list_size,
-              b->count,
-              dma_addr,
-              b->msgId);
-          MC_MGR_DBGCHK(LLD_OK == ret);
-          MC_MGR_LOCK(&bp->mtx);
-          --bp->in_use;
-          MC_MGR_UNLOCK(&bp->mtx);
-          goto done;
+        /* Unmap the buffer */
+        if ((bf_sys_dma_unmap(b->pool, b->addr, b->size, BF_DMA_FROM_CPU)) !=
+            0) {
+          LOG_ERROR("Unable to unmap DMA buffer %p", b->addr);
+        }
+        /* Retry with the same buffer. */
+        BF_LIST_DLL_PP(wl->bufList, b, next, prev);
+        MC_MGR_LOCK(&bp->mtx);
+        --bp->in_use;
+        MC_MGR_UNLOCK(&bp->mtx);
+        continue;
+      } else if (LLD_OK != ret) {
+        /* Unmap the buffer */
+        if ((bf_sys_dma_unmap(b->pool, b->addr, b->size, BF_DMA_FROM_CPU)) !=
+            0) {
+          LOG_ERROR("Unable to unmap DMA buffer %p", b->addr);
         }
-        push_cnt[subdev_id] += 1;
-      }  // end while (wl->bufList);
+        b->buf_pushed = 0;
+        LOG_ERROR(
+            "Write List push for dev %d subdev %d fails (%d), sz 0x%x cnt %d "
+            "addr "
+            "0x%" PRIx64 " id 0x%" PRIx64,
+            dev,
+            subdev,
+            ret,
+            b->wr_list_size,
+            b->count,
+            dma_addr,
+            b->msgId);
+        MC_MGR_DBGCHK(LLD_OK == ret);
+        MC_MGR_LOCK(&bp->mtx);
+        --bp->in_use;
+        MC_MGR_UNLOCK(&bp->mtx);
+        goto done;
+      }
+      push_cnt[subdev_id] += 1;
+    }  // end while (wl->bufList);
 
-      MC_MGR_DBGCHK(push_cnt[subdev_id] == wl->count);
+    MC_MGR_DBGCHK(push_cnt[subdev_id] == wl->count);
 
-    done:
-      MC_MGR_DBGCHK(NULL == wl->bufList);
-      wl->count = 0;
-      if (ret) {
-        return BF_HW_COMM_FAIL;
-      }
+  done:
+    MC_MGR_DBGCHK(NULL == wl->bufList);
+    wl->count = 0;
+    if (ret) {
+      return BF_HW_COMM_FAIL;
     }
   }
 
   /* Publish the DR pointers to the DMA engine. */
-  for (i = 0; i < MC_MGR_NUM_DEVICES; ++i) {
-    if (dev_map & (UINT64_C(1) << i)) {
-      for (subdev = 0; subdev < (int)mc_mgr_ctx_num_subdevices(i); ++subdev) {
-        if (push_cnt[subdev] > 0) {
-          mc_mgr_dma_start(i, subdev);
-        }
-      }
+  for (subdev = 0; subdev < (int)mc_mgr_ctx_num_subdevices(dev); ++subdev) {
+    if (push_cnt[subdev] > 0) {
+      mc_mgr_dma_start(dev, subdev);
     }
   }
 
   return BF_SUCCESS;
 }
 
+bf_status_t mc_mgr_drv_wrl_send(int sid, bool is_last) {
+  bf_status_t sts;
+
+  if (0 > sid || MC_MGR_NUM_SESSIONS <= sid) {
+    MC_MGR_DBGCHK(0);
+    return BF_INVALID_ARG;
+  }
+
+  if (mc_mgr_in_batch(sid)) return BF_SUCCESS;
+
+  for (bf_dev_id_t dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, is_last);
+    if (BF_SUCCESS != sts) return sts;
+  }
+  return BF_SUCCESS;
+}
+
 void mc_mgr_drv_wrl_abort(int sid) {
   if (0 > sid || MC_MGR_NUM_SESSIONS <= sid) {
     MC_MGR_DBGCHK(0);
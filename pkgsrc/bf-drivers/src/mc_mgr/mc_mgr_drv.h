@@ -85,6 +85,7 @@ int mc_mgr_drv_wrl_append_reg(int dev,
                               const char *where,
                               const int line);
 bf_status_t mc_mgr_drv_wrl_send(int sid, bool is_last);
+bf_status_t mc_mgr_drv_wrl_send_dev(int sid, bf_dev_id_t dev, bool is_last);
 void mc_mgr_drv_wrl_abort(int sid);
 int mc_mgr_drv_start_rdm_change(bf_dev_id_t dev, bf_dev_pipe_t pipe);
 int mc_mgr_drv_read_rdm_change(bf_dev_id_t dev, bf_dev_pipe_t pipe);
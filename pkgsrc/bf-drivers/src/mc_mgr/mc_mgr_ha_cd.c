@@ -685,7 +685,7 @@ static bf_status_t match_ecmp_groups(int d,
         mc_l1_node_t *sw_node_next = sw_node->ecmp_next;
         struct mc_mgr_grp_info *mgrp_info = NULL;
 
-        bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(d);
+        bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(d, sw_node->mgid);
         s = bf_map_get(grpinfo_map, sw_node->mgid, (void **)&mgrp_info);
         if (s != BF_MAP_OK || !mgrp_info) {
           LOG_WARN("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -794,7 +794,6 @@ static bf_status_t match_ecmp_associations(int d,
    * find the replayed group and walk through all the replayed associations
    * matching them to the read back associations. */
   struct mc_mgr_grp_info *mgrp_info = NULL;
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(d);
   for (s = bf_map_get_first(&st->ecmp_grps, &ecmp_grp_id, (void **)&hw_ecmp);
        s == BF_MAP_OK;
        s = bf_map_get_next(&st->ecmp_grps, &ecmp_grp_id, (void **)&hw_ecmp)) {
@@ -820,6 +819,7 @@ static bf_status_t match_ecmp_associations(int d,
         }
       }
       if (!hw_node) {
+        bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(d, sw_node->mgid);
         s = bf_map_get(grpinfo_map, sw_node->mgid, (void **)&mgrp_info);
         if (s != BF_MAP_OK || !mgrp_info) {
           LOG_WARN("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
@@ -936,7 +936,6 @@ static bf_status_t migrate_state(bf_dev_id_t dev_id,
    * ones created during the hardware sync. */
   struct mc_mgr_grp_info *mgrp_info = NULL;
   bf_map_t *mbrs_map = NULL;
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(d);
   for (s = bf_map_get_first(matched_hw_l1, &not_used, (void **)&hw_node);
        BF_MAP_OK == s;
        s = bf_map_get_next(matched_hw_l1, &not_used, (void **)&hw_node)) {
@@ -955,7 +954,9 @@ static bf_status_t migrate_state(bf_dev_id_t dev_id,
     /* sw_node here can be 1. L1 ptrs node, 2. L1 node, 3. L1 ecmp mbr node. */
     int mgid = sw_node->mgid;
     if (mgid != -1) {
-      s = bf_map_get(grpinfo_map, sw_node->mgid, (void **)&mgrp_info);
+      s = bf_map_get(mc_mgr_ctx_mgrp_info_map(d, mgid),
+                     mgid,
+                     (void **)&mgrp_info);
       if (s != BF_MAP_OK || !mgrp_info) {
         LOG_ERROR("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
                   mgid,
@@ -1139,7 +1140,8 @@ static bf_status_t add_missing_ecmp(int sid,
     for (v = 0; v < 2; ++v) {
       for (p = 0; p < (int)mc_mgr_ctx_num_max_pipes(dev); ++p) {
         uint32_t a;
-        a = mc_mgr_rdm_map_get(sid, dev, p, mc_mgr_rdm_node_type_vector, 1);
+        a = mc_mgr_rdm_map_get(
+            sid, dev, -1, p, mc_mgr_rdm_node_type_vector, 1);
         if (!a) {
           LOG_ERROR(
               "Failed to allocate RDM resources for ECMP group %#x (vec) on "
@@ -45,6 +45,7 @@
 #include "mc_mgr_drv.h"
 #include "mc_mgr_reg.h"
 #include "mc_mgr_mem.h"
+#include "mc_mgr_lane.h"
 
 /* Tof2 TODOs
  * [ ] - mc_mgr_get_tbl_ver_reg reads only a single deparser slice; decide if
@@ -179,8 +180,8 @@ struct mc_mgr_dev_ctx_t {
   /* Bit map of allocated MGIDs. */
   uint64_t mgid_map[MC_MGR_MGID_MAP_SIZE];
 
-  /* Map of mgid group nodes */
-  bf_map_t mgrpinfo_map;
+  /* Map of mgid group nodes, one per lane. */
+  bf_map_t mgrpinfo_map[MC_MGR_NUM_LANES];
 
   /* Global RID Shadow */
   uint16_t g_rid;
@@ -257,7 +258,8 @@ struct mc_mgr_dev_ctx_t {
   bf_map_t tree_len[BF_MAX_SUBDEV_COUNT];
 
   /* Holds MGIDs being updated by a session. */
-  bf_map_t trees_with_len_updated[BF_MAX_SUBDEV_COUNT][MC_MGR_NUM_PIPES];
+  bf_map_t trees_with_len_updated[MC_MGR_NUM_SESSIONS][BF_MAX_SUBDEV_COUNT]
+                                 [MC_MGR_NUM_PIPES];
 
   mc_mutex_t tree_len_mtx[BF_MAX_SUBDEV_COUNT];
 
@@ -270,6 +272,12 @@ struct mc_mgr_dev_ctx_t {
 
 struct mc_mgr_ctx {
   mc_rmutex_t mtx_top;
+  /* Per device API locks, see mc_mgr_dev_one_at_a_time_begin and
+   * mc_mgr_mgid_one_at_a_time_begin. */
+  mc_mgr_lanes_t dev_lanes[MC_MGR_NUM_DEVICES];
+  /* Per session locks, held by MGID scoped APIs so two threads sharing a
+   * session do not build its write list at the same time. */
+  mc_rmutex_t mtx_session[MC_MGR_NUM_SESSIONS];
   /* List of session states. */
   struct mc_session_ctx session_ctx[MC_MGR_NUM_SESSIONS];
   /* Pipe Manager session handle. */
@@ -339,6 +347,12 @@ extern struct mc_mgr_ctx *mc_mgr_ctx_p;
 static inline struct mc_mgr_ctx *mc_mgr_ctx() { return mc_mgr_ctx_p; }
 static inline bool mc_mgr_ready() { return !!mc_mgr_ctx(); }
 static inline mc_rmutex_t *mc_mgr_ctx_lock() { return &mc_mgr_ctx()->mtx_top; }
+static inline mc_rmutex_t *mc_mgr_ctx_session_lock(int sid) {
+  return &mc_mgr_ctx()->mtx_session[sid];
+}
+static inline mc_mgr_lanes_t *mc_mgr_ctx_dev_lanes(bf_dev_id_t dev) {
+  return &mc_mgr_ctx()->dev_lanes[dev];
+}
 static inline struct mc_mgr_dev_ctx_t *mc_mgr_ctx_dev(bf_dev_id_t dev) {
   if (0 > dev || MC_MGR_NUM_DEVICES <= dev) {
     MC_MGR_DBGCHK(0);
@@ -448,8 +462,12 @@ static inline bf_map_t *mc_mgr_ctx_lag_to_node_map(bf_dev_id_t dev,
 static inline bf_map_t *mc_mgr_ctx_db_ecmp(bf_dev_id_t dev) {
   return &mc_mgr_ctx_dev(dev)->db_ecmp;
 }
-static inline bf_map_t *mc_mgr_ctx_mgrp_info_map(bf_dev_id_t dev) {
-  return &mc_mgr_ctx_dev(dev)->mgrpinfo_map;
+static inline bf_map_t *mc_mgr_ctx_mgrp_info_map(bf_dev_id_t dev, int mgid) {
+  return &mc_mgr_ctx_dev(dev)->mgrpinfo_map[mc_mgr_mgid_lane(mgid)];
+}
+static inline bf_map_t *mc_mgr_ctx_lane_mgrp_info_map(bf_dev_id_t dev,
+                                                      int lane) {
+  return &mc_mgr_ctx_dev(dev)->mgrpinfo_map[lane];
 }
 static inline bf_id_allocator *mc_mgr_ctx_l1_id_gen(bf_dev_id_t dev) {
   return mc_mgr_ctx_dev(dev)->l1_node_id_gen;
@@ -725,26 +743,23 @@ static inline void mc_mgr_ctx_tree_len_rmv_all(bf_dev_id_t dev,
   } while (s == BF_MAP_OK);
   mc_mgr_ctx_tree_len_unlock(dev, subdev);
 }
-static inline bf_map_t *mc_mgr_ctx_trees_with_len_updated(bf_dev_id_t dev,
-                                                          bf_subdev_id_t subdev,
-                                                          int pipe) {
+static inline bf_map_t *mc_mgr_ctx_trees_with_len_updated(
+    int sid, bf_dev_id_t dev, bf_subdev_id_t subdev, int pipe) {
   if (pipe < 0 || pipe >= (int)mc_mgr_ctx_num_max_pipes(dev)) {
     MC_MGR_DBGCHK(0);
     return NULL;
   }
-  return &mc_mgr_ctx_dev(dev)->trees_with_len_updated[subdev][pipe];
+  return &mc_mgr_ctx_dev(dev)->trees_with_len_updated[sid][subdev][pipe];
 }
 static inline void mc_mgr_ctx_mark_len_update(
     int sid, bf_dev_id_t dev, bf_subdev_id_t subdev, int pipe, int mgid) {
-  (void)sid;
-  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(dev, subdev, pipe);
+  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(sid, dev, subdev, pipe);
   bf_map_add(m, mgid, NULL);
   return;
 }
 static inline void mc_mgr_ctx_clear_len_update(
     int sid, bf_dev_id_t dev, bf_subdev_id_t subdev, int pipe, int mgid) {
-  (void)sid;
-  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(dev, subdev, pipe);
+  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(sid, dev, subdev, pipe);
   bf_map_rmv(m, mgid);
   return;
 }
@@ -752,8 +767,7 @@ static inline int mc_mgr_ctx_get_rmv_len_update(int sid,
                                                 bf_dev_id_t dev,
                                                 bf_subdev_id_t subdev,
                                                 int pipe) {
-  (void)sid;
-  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(dev, subdev, pipe);
+  bf_map_t *m = mc_mgr_ctx_trees_with_len_updated(sid, dev, subdev, pipe);
   unsigned long mgid_key = 0;
   void *unused = NULL;
   bf_map_sts_t s = bf_map_get_first_rmv(m, &mgid_key, &unused);
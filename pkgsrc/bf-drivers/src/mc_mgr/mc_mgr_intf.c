@@ -309,7 +309,7 @@ bf_status_t bf_mc_mgrp_create(bf_mc_session_hdl_t shdl,
   if (!hdl) return BF_INVALID_ARG;
   *hdl = 0;
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_mgid_one_at_a_time_begin(sid, dev, grp);
 
   /* If the bit was already set in the bit map then this group has already
    * been taken. */
@@ -334,7 +334,7 @@ bf_status_t bf_mc_mgrp_create(bf_mc_session_hdl_t shdl,
           dev,
           __func__,
           __LINE__);
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_mgid_one_at_a_time_end(sid, dev, grp);
       return BF_NO_SYS_RESOURCES;
     }
     sts = mc_mgr_mgrp_create(dev, grp);
@@ -348,7 +348,7 @@ bf_status_t bf_mc_mgrp_create(bf_mc_session_hdl_t shdl,
       bf_map_init(&grp_info->node_mbrs);
 
       /* Add the group-info to the group map. */
-      bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+      bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, grp);
       bf_status_t s = bf_map_add(grpinfo_map, grp, grp_info);
       MC_MGR_DBGCHK(BF_MAP_OK == s);
 
@@ -357,7 +357,7 @@ bf_status_t bf_mc_mgrp_create(bf_mc_session_hdl_t shdl,
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_mgid_one_at_a_time_end(sid, dev, grp);
 
   LOG_TRACE(
       "Reserved grp %#x for session %#x on device %u with handle %#x (status "
@@ -369,12 +369,35 @@ bf_status_t bf_mc_mgrp_create(bf_mc_session_hdl_t shdl,
       bf_err_str(sts));
   return sts;
 }
+/* Groups associated with ECMP groups are destroyed holding the whole device
+ * since the ECMP groups are shared with MGIDs of other lanes. */
+static void mgrp_destroy_lock(int sid,
+                              bf_dev_id_t dev,
+                              bf_mc_grp_id_t grp,
+                              bool all) {
+  if (all) {
+    mc_mgr_dev_one_at_a_time_begin(dev);
+  } else {
+    mc_mgr_mgid_one_at_a_time_begin(sid, dev, grp);
+  }
+}
+static void mgrp_destroy_unlock(int sid,
+                                bf_dev_id_t dev,
+                                bf_mc_grp_id_t grp,
+                                bool all) {
+  if (all) {
+    mc_mgr_dev_one_at_a_time_end(dev);
+  } else {
+    mc_mgr_mgid_one_at_a_time_end(sid, dev, grp);
+  }
+}
 bf_status_t bf_mc_mgrp_destroy(bf_mc_session_hdl_t shdl,
                                bf_dev_id_t dev,
                                bf_mc_mgrp_hdl_t grp_hdl) {
   struct mc_mgr_grp_info *mgrp_info = NULL;
   bf_status_t sts = BF_SUCCESS;
   int sid = -1;
+  bool all = false;
 
   if (!mc_mgr_ready()) return BF_NOT_READY;
 
@@ -393,17 +416,24 @@ bf_status_t bf_mc_mgrp_destroy(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev);
+relock:
+  mgrp_destroy_lock(sid, dev, grp, all);
+
+  bf_map_t *grpinfo_map = mc_mgr_ctx_mgrp_info_map(dev, grp);
   bf_map_sts_t s = bf_map_get(grpinfo_map, grp, (void **)&mgrp_info);
   if (s != BF_MAP_OK || !mgrp_info) {
     LOG_ERROR("Failed to get mgrp obj with group %#x on dev %d map_sts:%d",
               grp,
               dev,
               s);
+    mgrp_destroy_unlock(sid, dev, grp, all);
     return BF_OBJECT_NOT_FOUND;
   }
-
-  mc_mgr_one_at_a_time_begin();
+  if (!all && mc_mgr_mgrp_ecmp_l1_count(dev, mgrp_info)) {
+    mgrp_destroy_unlock(sid, dev, grp, all);
+    all = true;
+    goto relock;
+  }
 
   /* If the bit was already clear in the bit map then this group has already
    * been freed. if not then mark the MGID as free first such that no other
@@ -422,7 +452,7 @@ bf_status_t bf_mc_mgrp_destroy(bf_mc_session_hdl_t shdl,
           shdl,
           grp,
           dev);
-      mc_mgr_one_at_a_time_end();
+      mgrp_destroy_unlock(sid, dev, grp, all);
       return sts;
     }
 
@@ -433,10 +463,10 @@ bf_status_t bf_mc_mgrp_destroy(bf_mc_session_hdl_t shdl,
     bf_map_rmv(grpinfo_map, grp);
     MC_MGR_FREE(mgrp_info);
 
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       MC_MGR_DBGCHK(0);
-      mc_mgr_one_at_a_time_end();
+      mgrp_destroy_unlock(sid, dev, grp, all);
       return sts;
     }
 
@@ -454,7 +484,7 @@ bf_status_t bf_mc_mgrp_destroy(bf_mc_session_hdl_t shdl,
     sts = BF_ALREADY_EXISTS;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mgrp_destroy_unlock(sid, dev, grp, all);
 
   LOG_TRACE(
       "Released grp %#x by session %#x on device %u with handle %#x (status "
@@ -506,18 +536,18 @@ bf_status_t bf_mc_mgrp_get_first(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   for (uint32_t i = 0; i < BF_MGID_COUNT; i++) {
     bf_mc_grp_id_t j = i & 0xFFFF;
     if (mc_mgr_get_mgid_map_bit(dev, j)) {
       *mgrp_hdl = mc_mgr_encode_mgrp_hdl(j);
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       return sts;
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_OBJECT_NOT_FOUND;
 }
@@ -538,14 +568,14 @@ bf_status_t bf_mc_mgrp_get_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   *count = 0;
   for (int i = 0; i < MC_MGR_MGID_MAP_SIZE; i++) {
     *count += __builtin_popcountll(mc_mgr_ctx_mgid_blk(dev, i));
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -566,11 +596,11 @@ bf_status_t bf_mc_lag_get_size(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_lag_get_size(dev, count);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -602,13 +632,13 @@ bf_status_t bf_mc_mgrp_get_next_i(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   uint32_t cur = 0;
   for (uint32_t j = grp + 1; j < BF_MGID_COUNT; j++) {
     bf_mc_grp_id_t k = j & 0xFFFF;
     if (cur == i) {
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       return BF_SUCCESS;
     }
     if (mc_mgr_get_mgid_map_bit(dev, k)) {
@@ -617,7 +647,7 @@ bf_status_t bf_mc_mgrp_get_next_i(bf_mc_session_hdl_t shdl,
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (cur == 0) {
     return BF_OBJECT_NOT_FOUND;
@@ -657,7 +687,7 @@ bf_status_t bf_mc_mgrp_get_first_node_mbr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -669,14 +699,14 @@ bf_status_t bf_mc_mgrp_get_first_node_mbr(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   sts = mc_mgr_mgrp_get_first_node_mbr(
       sid, dev, grp, node_hdl, node_l1_xid_valid, node_l1_xid);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -706,7 +736,7 @@ bf_status_t bf_mc_mgrp_get_node_mbr_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -718,13 +748,13 @@ bf_status_t bf_mc_mgrp_get_node_mbr_count(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   sts = mc_mgr_mgrp_get_node_mbr_count(sid, dev, grp, count);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -762,7 +792,7 @@ bf_status_t bf_mc_mgrp_get_next_i_node_mbr(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -774,7 +804,7 @@ bf_status_t bf_mc_mgrp_get_next_i_node_mbr(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -787,7 +817,7 @@ bf_status_t bf_mc_mgrp_get_next_i_node_mbr(bf_mc_session_hdl_t shdl,
                                         next_node_l1_xids_valid,
                                         next_node_l1_xids);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -819,7 +849,7 @@ bf_status_t bf_mc_mgrp_get_first_ecmp_mbr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -831,14 +861,14 @@ bf_status_t bf_mc_mgrp_get_first_ecmp_mbr(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   sts = mc_mgr_mgrp_get_first_ecmp_mbr(
       sid, dev, grp, ecmp_hdl, ecmp_l1_xid_valid, ecmp_l1_xid);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -868,7 +898,7 @@ bf_status_t bf_mc_mgrp_get_ecmp_mbr_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -880,13 +910,13 @@ bf_status_t bf_mc_mgrp_get_ecmp_mbr_count(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   sts = mc_mgr_mgrp_get_ecmp_mbr_count(sid, dev, grp, count);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -924,7 +954,7 @@ bf_status_t bf_mc_mgrp_get_next_i_ecmp_mbr(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!mc_mgr_get_mgid_map_bit(dev, grp)) {
     LOG_ERROR(
@@ -936,7 +966,7 @@ bf_status_t bf_mc_mgrp_get_next_i_ecmp_mbr(bf_mc_session_hdl_t shdl,
         grp,
         dev);
 
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -949,7 +979,7 @@ bf_status_t bf_mc_mgrp_get_next_i_ecmp_mbr(bf_mc_session_hdl_t shdl,
                                         next_ecmp_l1_xids_valid,
                                         next_ecmp_l1_xids);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -974,7 +1004,7 @@ bf_status_t bf_mc_ecmp_create(bf_mc_session_hdl_t shdl,
   }
   *ecmp_hdl = 0;
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Allocate the handle. */
   if (BF_SUCCESS != mc_mgr_encode_ecmp_hdl(dev, ecmp_hdl)) {
@@ -984,7 +1014,7 @@ bf_status_t bf_mc_ecmp_create(bf_mc_session_hdl_t shdl,
   /* Allocate an object for the group. */
   sts = mc_mgr_ecmp_alloc(sid, dev, *ecmp_hdl);
   if (sts == BF_SUCCESS) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
   }
   if (BF_SUCCESS != sts) {
@@ -995,7 +1025,7 @@ bf_status_t bf_mc_ecmp_create(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -1016,7 +1046,7 @@ static bf_status_t bf_mc_ecmp_destroy_internal(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the ECMP group. */
   mc_ecmp_grp_t *ecmp_grp = mc_mgr_lookup_ecmp(dev, ehdl, __func__, __LINE__);
@@ -1038,7 +1068,7 @@ static bf_status_t bf_mc_ecmp_destroy_internal(bf_mc_session_hdl_t shdl,
   }
   sts = mc_mgr_ecmp_free(sid, dev, ecmp_grp);
   if (sts == BF_SUCCESS) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
   }
   if (BF_SUCCESS != sts) {
@@ -1053,7 +1083,7 @@ static bf_status_t bf_mc_ecmp_destroy_internal(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 bf_status_t bf_mc_ecmp_destroy(bf_mc_session_hdl_t shdl,
@@ -1081,14 +1111,14 @@ bf_status_t bf_mc_ecmp_get_first(bf_mc_session_hdl_t shdl,
 
   bf_map_t *db = mc_mgr_ctx_db_ecmp(dev);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = NULL;
   long unsigned int key = 0;
   sts = bf_map_get_first(db, &key, (void **)&g);
   *ecmp_hdl = key;
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (sts == BF_MAP_OK) {
     sts = BF_SUCCESS;
@@ -1111,12 +1141,12 @@ bf_status_t bf_mc_ecmp_get_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_ecmp(dev);
   *count = bf_map_count(db);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -1141,7 +1171,7 @@ bf_status_t bf_mc_ecmp_get_next_i(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_ecmp(dev);
   mc_ecmp_grp_t *g = NULL;
@@ -1158,7 +1188,7 @@ bf_status_t bf_mc_ecmp_get_next_i(bf_mc_session_hdl_t shdl,
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -1183,7 +1213,7 @@ bf_status_t bf_mc_ecmp_mbr_add(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the L1 node. */
   mc_l1_node_t *l1_node =
@@ -1200,7 +1230,7 @@ bf_status_t bf_mc_ecmp_mbr_add(bf_mc_session_hdl_t shdl,
 
   sts = mc_mgr_ecmp_mbr_add(sid, dev, ecmp_grp, l1_node);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Session %#x failed to add node %#x to ECMP group %#x, %s (%d)",
@@ -1214,7 +1244,7 @@ bf_status_t bf_mc_ecmp_mbr_add(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 bf_status_t bf_mc_ecmp_mbr_rem(bf_mc_session_hdl_t shdl,
@@ -1237,7 +1267,7 @@ bf_status_t bf_mc_ecmp_mbr_rem(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the L1 node. */
   mc_l1_node_t *l1_node =
@@ -1254,11 +1284,11 @@ bf_status_t bf_mc_ecmp_mbr_rem(bf_mc_session_hdl_t shdl,
 
   sts = mc_mgr_ecmp_mbr_rem(sid, dev, ecmp_grp, l1_node);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 bf_status_t bf_mc_ecmp_mbr_mod(bf_mc_session_hdl_t shdl,
@@ -1287,7 +1317,7 @@ bf_status_t bf_mc_ecmp_mbr_mod(bf_mc_session_hdl_t shdl,
       return BF_INVALID_ARG;
     }
   }
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   /* Look up the ECMP group. */
   mc_ecmp_grp_t *ecmp_grp =
       mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
@@ -1312,10 +1342,10 @@ bf_status_t bf_mc_ecmp_mbr_mod(bf_mc_session_hdl_t shdl,
   /* Now we have all L1 valid nodes, valid ecmp_grp */
   sts = mc_mgr_ecmp_mbr_mod(sid, dev, ecmp_grp, l1_nodes, size);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -1335,24 +1365,24 @@ bf_status_t bf_mc_ecmp_get_first_mbr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   for (uint32_t i = 0; i < sizeof(g->mbrs) / sizeof(g->mbrs[0]); ++i) {
     if (g->mbrs[i]) {
       *node_hdl = g->mbrs[i]->handle;
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       return sts;
     }
   }
   *node_hdl = 0;
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_OBJECT_NOT_FOUND;
 }
@@ -1373,16 +1403,16 @@ bf_status_t bf_mc_ecmp_get_mbr_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
   *count = __builtin_popcount(g->valid_map);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -1410,11 +1440,11 @@ bf_status_t bf_mc_ecmp_get_next_i_mbr(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -1436,7 +1466,7 @@ bf_status_t bf_mc_ecmp_get_next_i_mbr(bf_mc_session_hdl_t shdl,
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (cur == 0) {
     return BF_OBJECT_NOT_FOUND;
@@ -1477,7 +1507,7 @@ bf_status_t bf_mc_ecmp_get_mbr_from_hash(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
@@ -1522,7 +1552,7 @@ bf_status_t bf_mc_ecmp_get_mbr_from_hash(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -1541,11 +1571,11 @@ bf_status_t bf_mc_ecmp_get_first_assoc(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -1553,11 +1583,11 @@ bf_status_t bf_mc_ecmp_get_first_assoc(bf_mc_session_hdl_t shdl,
     MC_MGR_DBGCHK(g->refs->mgid != -1);
     *mgrp_hdl = mc_mgr_encode_mgrp_hdl(g->refs->mgid);
   } else {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_OBJECT_NOT_FOUND;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -1577,11 +1607,11 @@ bf_status_t bf_mc_ecmp_get_assoc_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -1591,7 +1621,7 @@ bf_status_t bf_mc_ecmp_get_assoc_count(bf_mc_session_hdl_t shdl,
     (*count)++;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -1620,11 +1650,11 @@ bf_status_t bf_mc_ecmp_get_next_i_assoc(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -1645,7 +1675,7 @@ bf_status_t bf_mc_ecmp_get_next_i_assoc(bf_mc_session_hdl_t shdl,
     cur++;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (cur == 0) {
     return BF_OBJECT_NOT_FOUND;
@@ -1674,14 +1704,14 @@ bf_status_t bf_mc_node_create(bf_mc_session_hdl_t shdl,
   if (!node_hdl) return BF_INVALID_ARG;
   *node_hdl = 0;
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Update the node with the membership information after converting it from
    * logical to physical space. */
   bf_mc_port_map_t physical_port_map;
   sts = logical_port_map_to_physical(dev, port_map, &physical_port_map);
   if (sts != BF_SUCCESS) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return sts;
   }
 
@@ -1697,7 +1727,7 @@ bf_status_t bf_mc_node_create(bf_mc_session_hdl_t shdl,
   sts = mc_mgr_set_node_membership(sid, node, physical_port_map, lag_map);
   if (sts == BF_SUCCESS && mgid_associated(node)) {
     /* Push the write list to hardware. */
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (sts == BF_SUCCESS) {
       /* Program the PVT if it has changed. */
       sts = mc_mgr_update_pvt(sid, dev, node->mgid, false, __func__, __LINE__);
@@ -1710,7 +1740,7 @@ bf_status_t bf_mc_node_create(bf_mc_session_hdl_t shdl,
     sts |= mc_mgr_node_set_lags_map(node);
   }
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   LOG_TRACE(
       "L1 Create by session %#x with RID %#x allocated handle %#x (status %s)",
       shdl,
@@ -1759,13 +1789,13 @@ bf_status_t bf_mc_node_get_attr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
   mc_l1_node_t *n = NULL;
   bf_mc_node_hdl_t key = node_hdl;
   if (BF_MAP_OK != bf_map_get(db, key, (void **)&n)) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -1786,7 +1816,7 @@ bf_status_t bf_mc_node_get_attr(bf_mc_session_hdl_t shdl,
 
   *rid = n->rid;
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -1808,7 +1838,7 @@ bf_status_t bf_mc_node_destroy(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the L1 node. */
   mc_l1_node_t *l1_node =
@@ -1847,7 +1877,7 @@ bf_status_t bf_mc_node_destroy(bf_mc_session_hdl_t shdl,
   }
 
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (sts != BF_SUCCESS) {
       MC_MGR_DBGCHK(0);
       goto done;
@@ -1862,7 +1892,7 @@ bf_status_t bf_mc_node_destroy(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS != sts) {
     LOG_ERROR("Node destroy by session %#x for node %#x failed (status %s)",
@@ -1891,14 +1921,14 @@ bf_status_t bf_mc_node_get_first(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
 
   mc_l1_node_t *n = NULL;
   long unsigned int key = 0;
   sts = bf_map_get_first(db, &key, (void **)&n);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (sts == BF_MAP_OK) {
     *node_hdl = key;
@@ -1921,7 +1951,7 @@ bf_status_t bf_mc_node_get_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
   long unsigned int key;
@@ -1933,7 +1963,7 @@ bf_status_t bf_mc_node_get_count(bf_mc_session_hdl_t shdl,
     (*count)++;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -1957,7 +1987,7 @@ bf_status_t bf_mc_node_get_next_i(bf_mc_session_hdl_t shdl,
     return BF_SUCCESS;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
   mc_l1_node_t *n;
@@ -1973,7 +2003,7 @@ bf_status_t bf_mc_node_get_next_i(bf_mc_session_hdl_t shdl,
     cur++;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (cur == 0) {
     return BF_OBJECT_NOT_FOUND;
@@ -2004,13 +2034,13 @@ bf_status_t bf_mc_node_get_association(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
   mc_l1_node_t *n = NULL;
   bf_mc_node_hdl_t key = node_hdl;
   if (BF_MAP_OK != bf_map_get(db, key, (void **)&n)) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -2018,7 +2048,7 @@ bf_status_t bf_mc_node_get_association(bf_mc_session_hdl_t shdl,
     if (is_associated) {
       *is_associated = false;
     }
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_SUCCESS;
   }
 
@@ -2035,7 +2065,7 @@ bf_status_t bf_mc_node_get_association(bf_mc_session_hdl_t shdl,
     *mgrp_hdl = mc_mgr_encode_mgrp_hdl(n->mgid);
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -2056,13 +2086,13 @@ bf_status_t bf_mc_node_is_mbr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_map_t *db = mc_mgr_ctx_db_l1(dev);
   mc_l1_node_t *n = NULL;
   bf_mc_node_hdl_t key = node_hdl;
   if (BF_MAP_OK != bf_map_get(db, key, (void **)&n)) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -2070,7 +2100,7 @@ bf_status_t bf_mc_node_is_mbr(bf_mc_session_hdl_t shdl,
     if (is_ecmp_mbr) {
       *is_ecmp_mbr = false;
     }
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_SUCCESS;
   }
 
@@ -2081,7 +2111,7 @@ bf_status_t bf_mc_node_is_mbr(bf_mc_session_hdl_t shdl,
     *is_ecmp_mbr = true;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -2105,7 +2135,7 @@ bf_status_t bf_mc_node_update(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Lookup the node based on handle. */
   mc_l1_node_t *l1_node = mc_mgr_lookup_l1_node(dev, nhdl, __func__, __LINE__);
@@ -2140,7 +2170,7 @@ bf_status_t bf_mc_node_update(bf_mc_session_hdl_t shdl,
 
   if (mgid_associated(l1_node) || ecmp_associated(l1_node)) {
     /* Push the write list to hardware. */
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (sts != BF_SUCCESS) {
       LOG_ERROR(
           "Failed to update the node when updating hardware %s, %d (status %s)",
@@ -2169,7 +2199,7 @@ bf_status_t bf_mc_node_update(bf_mc_session_hdl_t shdl,
     mc_mgr_node_set_lags_map(l1_node);
   }
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -2200,7 +2230,7 @@ bf_status_t bf_mc_associate_node(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_mgid_one_at_a_time_begin(sid, dev, grp);
 
   /* Lookup the node based on handle. */
   node = mc_mgr_lookup_l1_node(dev, nhdl, __func__, __LINE__);
@@ -2222,7 +2252,7 @@ bf_status_t bf_mc_associate_node(bf_mc_session_hdl_t shdl,
         level1_exclusion_id_valid ? "valid" : "invalid");
   } else {
     /* Push the write list to hardware. */
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (sts == BF_SUCCESS) {
       /* Program the PVT if it has changed. */
       sts = mc_mgr_update_pvt(sid, dev, node->mgid, false, __func__, __LINE__);
@@ -2231,7 +2261,7 @@ bf_status_t bf_mc_associate_node(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_mgid_one_at_a_time_end(sid, dev, grp);
 
   if (level1_exclusion_id_valid) {
     LOG_TRACE(
@@ -2277,7 +2307,7 @@ bf_status_t bf_mc_dissociate_node(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_mgid_one_at_a_time_begin(sid, dev, grp);
 
   /* Lookup the node based on handle. */
   mc_l1_node_t *node = NULL;
@@ -2292,7 +2322,7 @@ bf_status_t bf_mc_dissociate_node(bf_mc_session_hdl_t shdl,
     LOG_ERROR(
         "Failed to remove node %#x from group %#x, (%d)", nhdl, ghdl, sts);
   } else {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (sts == BF_SUCCESS) {
       /* Program the PVT if it has changed. */
       sts = mc_mgr_update_pvt(sid, dev, grp, false, __func__, __LINE__);
@@ -2301,7 +2331,7 @@ bf_status_t bf_mc_dissociate_node(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_mgid_one_at_a_time_end(sid, dev, grp);
 
   LOG_TRACE(
       "L1 Dissociate by session %#x for node %#x from group %#x (status %s)",
@@ -2338,7 +2368,7 @@ bf_status_t bf_mc_associate_ecmp(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the ECMP group. */
   mc_ecmp_grp_t *ecmp = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
@@ -2346,10 +2376,10 @@ bf_status_t bf_mc_associate_ecmp(bf_mc_session_hdl_t shdl,
     sts = mc_mgr_ecmp_associate(
         sid, dev, mgid, ecmp, level1_exclusion_id, level1_exclusion_id_valid);
     if (sts == BF_SUCCESS) {
-      sts = mc_mgr_drv_wrl_send(sid, true);
+      sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
       if (BF_SUCCESS != sts) {
         MC_MGR_DBGCHK(0);
-        mc_mgr_one_at_a_time_end();
+        mc_mgr_dev_one_at_a_time_end(dev);
         return sts;
       }
       if (BF_SUCCESS == sts) {
@@ -2357,13 +2387,13 @@ bf_status_t bf_mc_associate_ecmp(bf_mc_session_hdl_t shdl,
         sts = mc_mgr_update_pvt(sid, dev, mgid, false, __func__, __LINE__);
         if (BF_SUCCESS != sts) {
           MC_MGR_DBGCHK(0);
-          mc_mgr_one_at_a_time_end();
+          mc_mgr_dev_one_at_a_time_end(dev);
           return sts;
         }
         sts = mc_mgr_update_tvt(sid, dev, mgid, false, __func__, __LINE__);
         if (BF_SUCCESS != sts) {
           MC_MGR_DBGCHK(0);
-          mc_mgr_one_at_a_time_end();
+          mc_mgr_dev_one_at_a_time_end(dev);
           return sts;
         }
       }
@@ -2401,7 +2431,7 @@ bf_status_t bf_mc_associate_ecmp(bf_mc_session_hdl_t shdl,
         sts);
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -2428,11 +2458,11 @@ bf_status_t bf_mc_ecmp_get_assoc_attr(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   mc_ecmp_grp_t *g = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
   if (!g) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
 
@@ -2447,7 +2477,7 @@ bf_status_t bf_mc_ecmp_get_assoc_attr(bf_mc_session_hdl_t shdl,
     found = true;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (!found) {
     return BF_INVALID_ARG;
@@ -2479,7 +2509,7 @@ bf_status_t bf_mc_dissociate_ecmp(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the ECMP group. */
   mc_ecmp_grp_t *ecmp = mc_mgr_lookup_ecmp(dev, ecmp_hdl, __func__, __LINE__);
@@ -2495,10 +2525,10 @@ bf_status_t bf_mc_dissociate_ecmp(bf_mc_session_hdl_t shdl,
     sts = BF_INVALID_ARG;
   }
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       MC_MGR_DBGCHK(0);
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       return sts;
     }
     if (BF_SUCCESS == sts) {
@@ -2506,19 +2536,19 @@ bf_status_t bf_mc_dissociate_ecmp(bf_mc_session_hdl_t shdl,
       sts = mc_mgr_update_pvt(sid, dev, grp, false, __func__, __LINE__);
       if (BF_SUCCESS != sts) {
         MC_MGR_DBGCHK(0);
-        mc_mgr_one_at_a_time_end();
+        mc_mgr_dev_one_at_a_time_end(dev);
         return sts;
       }
       sts = mc_mgr_update_tvt(sid, dev, grp, false, __func__, __LINE__);
       if (BF_SUCCESS != sts) {
         MC_MGR_DBGCHK(0);
-        mc_mgr_one_at_a_time_end();
+        mc_mgr_dev_one_at_a_time_end(dev);
         return sts;
       }
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -2568,7 +2598,7 @@ bf_status_t bf_mc_set_lag_membership(bf_mc_session_hdl_t shdl,
   LOG_TRACE(
       "Session %#x update LAG %#x on dev %#x to %s", shdl, lag_id, dev, lm);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_mc_port_map_t pm;
   sts = logical_port_map_to_physical(dev, port_map, &pm);
@@ -2582,14 +2612,14 @@ bf_status_t bf_mc_set_lag_membership(bf_mc_session_hdl_t shdl,
               __LINE__);
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
   } else {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       MC_MGR_DBGCHK(BF_SUCCESS == sts);
     }
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   LOG_TRACE("Session %#x update LAG complete, status %s (%d)",
             shdl,
@@ -2618,7 +2648,7 @@ bf_status_t bf_mc_get_lag_membership(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_mc_port_map_t pm;
   MC_MGR_MEMSET(&pm, 0, sizeof(bf_mc_port_map_t));
@@ -2685,7 +2715,7 @@ bf_status_t bf_mc_get_lag_membership(bf_mc_session_hdl_t shdl,
   }
   memcpy(port_map, &pm, sizeof(bf_mc_port_map_t));
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -2740,7 +2770,7 @@ bf_status_t bf_mc_get_lag_member_from_hash(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Look up the L1 node. */
   mc_l1_node_t *l1_node =
@@ -2861,7 +2891,7 @@ bf_status_t bf_mc_get_lag_member_from_hash(bf_mc_session_hdl_t shdl,
   physical_port_to_logical(dev, mbr, port);
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -2903,12 +2933,12 @@ bf_status_t bf_mc_get_remote_lag_member_count(bf_mc_session_hdl_t shdl,
     goto done;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   *left_count = mc_mgr_ctx_lit_np_l(dev, lag_id);
   *right_count = mc_mgr_ctx_lit_np_r(dev, lag_id);
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
 done:
   if (BF_SUCCESS != sts) {
@@ -2967,7 +2997,7 @@ bf_status_t bf_mc_set_remote_lag_member_count(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   sts = mc_mgr_lag_update_rmt_cnt(sid, dev, lag_id, left_count, right_count);
   if (BF_SUCCESS != sts) {
@@ -2982,11 +3012,11 @@ bf_status_t bf_mc_set_remote_lag_member_count(bf_mc_session_hdl_t shdl,
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
   }
 
-  sts = mc_mgr_drv_wrl_send(sid, true);
+  sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   if (BF_SUCCESS != sts) {
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   LOG_TRACE("Session %#x update LAG complete, status %s (%d)",
             shdl,
@@ -3027,9 +3057,9 @@ bf_status_t bf_mc_get_port_mc_fwd_state(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, port_id, &phy_port);
   int port_index = mc_dev_port_to_bit_idx(dev, phy_port);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   sts = mc_mgr_get_port_fwd_state(sid, dev, port_index, is_active);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS != sts) {
     LOG_ERROR(
         "Failed to get MC port forward state sts %s (%d) session %#x dev %d "
@@ -3076,7 +3106,7 @@ bf_status_t bf_mc_set_port_mc_fwd_state(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, port_id, &phy_port);
   int port_index = mc_dev_port_to_bit_idx(dev, phy_port);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   sts = mc_mgr_set_port_fwd_state(sid, dev, port_index, !is_active);
   if (BF_SUCCESS != sts) {
@@ -3090,7 +3120,7 @@ bf_status_t bf_mc_set_port_mc_fwd_state(bf_mc_session_hdl_t shdl,
         port_id,
         is_active ? "active" : "inactive");
   } else {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     if (BF_SUCCESS != sts) {
       LOG_ERROR("Failed to send write list to set port mask dev %d sts %s",
                 dev,
@@ -3098,7 +3128,7 @@ bf_status_t bf_mc_set_port_mc_fwd_state(bf_mc_session_hdl_t shdl,
       return sts;
     }
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   LOG_TRACE(
       "Session %#x update port fwd state (port %#x, state %d), status %s (%d)",
@@ -3123,12 +3153,12 @@ bf_status_t bf_mc_enable_port_fast_failover(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_set_port_ff_mode(sid, dev, true);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d, sts %s", __func__, dev, bf_err_str(sts));
@@ -3149,12 +3179,12 @@ bf_status_t bf_mc_disable_port_fast_failover(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_set_port_ff_mode(sid, dev, false);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d, sts %s", __func__, dev, bf_err_str(sts));
@@ -3192,9 +3222,9 @@ bf_status_t bf_mc_get_fast_failover_state(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, port_id, &phy_port);
   int port_index = mc_dev_port_to_bit_idx(dev, phy_port);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_get_port_ff_state(dev, port_index, is_active);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -3221,9 +3251,9 @@ bf_status_t bf_mc_clear_fast_failover_state(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, port_id, &phy_port);
   int port_index = mc_dev_port_to_bit_idx(dev, phy_port);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_clr_port_ff_state(dev, port_index);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -3254,17 +3284,17 @@ bf_status_t bf_mc_set_port_prune_table(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   bf_mc_port_map_t pm;
   sts = logical_port_map_to_physical(dev, pruned_ports, &pm);
   if (sts != BF_SUCCESS) goto done;
   sts = mc_mgr_update_yid_tbl(sid, dev, l2_exclusion_id, pm);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
   if (BF_SUCCESS != sts) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     LOG_ERROR("Failed to update prune table idx %#x, %s (%d)",
               l2_exclusion_id,
               bf_err_str(sts),
@@ -3273,7 +3303,7 @@ bf_status_t bf_mc_set_port_prune_table(bf_mc_session_hdl_t shdl,
   }
 
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -3307,7 +3337,7 @@ bf_status_t bf_mc_get_port_prune_table(bf_mc_session_hdl_t shdl,
   if (!pruned_ports) return BF_INVALID_ARG;
 
   BF_MC_PORT_MAP_INIT(*pruned_ports);
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   if (!from_hw) {
     bf_bitset_t *pmt = mc_mgr_ctx_pmt(dev, l2_exclusion_id);
@@ -3337,7 +3367,7 @@ bf_status_t bf_mc_get_port_prune_table(bf_mc_session_hdl_t shdl,
             dev,
             l2_exclusion_id,
             bf_err_str(sts));
-        mc_mgr_one_at_a_time_end();
+        mc_mgr_dev_one_at_a_time_end(dev);
         return sts;
       }
       for (int i = 0; i < BF_PIPE_PORT_COUNT; ++i) {
@@ -3349,7 +3379,7 @@ bf_status_t bf_mc_get_port_prune_table(bf_mc_session_hdl_t shdl,
     }
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   return sts;
 }
 
@@ -3387,12 +3417,12 @@ bf_status_t bf_mc_enable_port_protection(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_set_backup_port_mode(sid, dev, true);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d, sts %s", __func__, dev, bf_err_str(sts));
@@ -3413,12 +3443,12 @@ bf_status_t bf_mc_disable_port_protection(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts = mc_mgr_set_backup_port_mode(sid, dev, false);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d, sts %s", __func__, dev, bf_err_str(sts));
@@ -3460,10 +3490,10 @@ bf_status_t bf_mc_get_port_protection(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, protected_port, &phy_pport);
   int phy_pport_bit_index = mc_dev_port_to_bit_idx(dev, phy_pport);
   int phy_bport_bit_index = 0;
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   sts = mc_mgr_get_backup_port(
       sid, dev, phy_pport_bit_index, &phy_bport_bit_index);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   if (BF_SUCCESS == sts) {
     phy_bport = mc_bit_idx_to_dev_port(dev, phy_bport_bit_index);
@@ -3517,19 +3547,19 @@ bf_status_t bf_mc_set_port_protection(bf_mc_session_hdl_t shdl,
   logical_port_to_physical(dev, protected_port, &phy_pport);
   logical_port_to_physical(dev, backup_port, &phy_bport);
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   sts = mc_mgr_set_backup_port(sid,
                                dev,
                                mc_dev_port_to_bit_idx(dev, phy_pport),
                                mc_dev_port_to_bit_idx(dev, phy_bport));
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     MC_MGR_DBGCHK(BF_SUCCESS == sts);
 
     /* Push the batched PVT update. */
     pipe_mgr_mc_pipe_msk_update_push(mc_mgr_ctx_pipe_sess(), true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS == sts) {
     if (protected_port != backup_port) {
       LOG_TRACE("Dev %d port %d has multicast backup with port %d",
@@ -3571,16 +3601,16 @@ bf_status_t bf_mc_set_global_exclusion_rid(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   sts = mc_mgr_set_global_rid(dev, rid);
   if (BF_SUCCESS != sts) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     LOG_ERROR("Failed to update global rid, %s (%d)", bf_err_str(sts), sts);
     return sts;
   }
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return sts;
 }
@@ -3610,9 +3640,9 @@ bf_status_t bf_mc_get_copy_to_cpu(bf_dev_id_t dev,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   sts = mc_mgr_get_c2c(sid, dev, port, enable);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d get cpu port and state, sts %s",
               __func__,
@@ -3678,13 +3708,13 @@ bf_status_t bf_mc_set_copy_to_cpu(bf_dev_id_t dev,
   uint32_t c2c_pipe_mask = 1 << pipe;
   dev_target_t dev_tgt = {dev, DEV_PIPE_ALL};
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   /* For TF3, the c2c_pipe_mask moved to TM from Deparser. */
   bool batch = mc_mgr_in_batch(sid);
   if (mc_mgr_ctx_dev_family(dev) == BF_DEV_FAMILY_TOFINO3) {
     sts = mc_mgr_c2c_pipe_msk_set_reg_wrl(sid, dev, c2c_pipe_mask);
     if (BF_SUCCESS != sts) {
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       LOG_ERROR("C2C Pipe mask update failed (%d) ", sts);
       return sts;
     }
@@ -3702,10 +3732,10 @@ bf_status_t bf_mc_set_copy_to_cpu(bf_dev_id_t dev,
   if (BF_SUCCESS == sts) {
     sts = mc_mgr_set_c2c(sid, dev, enable, prog_port);
     if (BF_SUCCESS == sts) {
-      sts = mc_mgr_drv_wrl_send(sid, true);
+      sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
     }
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d en %d port %d, sts %s",
               __func__,
@@ -3724,7 +3754,7 @@ bf_status_t bf_mc_set_max_nodes_before_yield(bf_mc_session_hdl_t shdl,
   if (!mc_mgr_ready()) return BF_NOT_READY;
 
   bf_status_t sts = BF_SUCCESS;
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   /* Validate the session. */
   int sid = -1;
@@ -3745,10 +3775,10 @@ bf_status_t bf_mc_set_max_nodes_before_yield(bf_mc_session_hdl_t shdl,
 
   sts = mc_mgr_set_l1_time_slice(sid, dev, count);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
 done:
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d count %d, sts %s",
               __func__,
@@ -3782,13 +3812,13 @@ bf_status_t bf_mc_set_max_node_threshold(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
   bf_status_t sts =
       mc_mgr_set_max_nodes(sid, dev, node_count, node_port_lag_count);
   if (BF_SUCCESS == sts) {
-    sts = mc_mgr_drv_wrl_send(sid, true);
+    sts = mc_mgr_drv_wrl_send_dev(sid, dev, true);
   }
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
   if (BF_SUCCESS != sts) {
     LOG_ERROR("%s failed; dev %d count1 %d count2 %d, sts %s",
               __func__,
@@ -3806,16 +3836,16 @@ bf_status_t bf_mc_get_pipe_vector(bf_mc_session_hdl_t shdl,
                                   int *logical_pipe_vector) {
   if (!mc_mgr_ready()) return BF_NOT_READY;
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_dev_one_at_a_time_begin(dev);
 
   int sid = -1;
   if (-1 == (sid = mc_mgr_validate_session(shdl, __func__, __LINE__))) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
   /* Validate the device. */
   if (!mc_mgr_validate_dev(dev, __func__, __LINE__)) {
-    mc_mgr_one_at_a_time_end();
+    mc_mgr_dev_one_at_a_time_end(dev);
     return BF_INVALID_ARG;
   }
   /* Validate [out]* is not null */
@@ -3836,14 +3866,14 @@ bf_status_t bf_mc_get_pipe_vector(bf_mc_session_hdl_t shdl,
     bf_dev_pipe_t log_pipe = 0;
     if (LLD_OK != lld_sku_map_phy_pipe_id_to_pipe_id(dev, i, &log_pipe)) {
       *logical_pipe_vector = 0;
-      mc_mgr_one_at_a_time_end();
+      mc_mgr_dev_one_at_a_time_end(dev);
       return BF_INVALID_ARG;
     }
     log_pipe_vec |= (1u << log_pipe);
   }
   *logical_pipe_vector = log_pipe_vec;
 
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_end(dev);
 
   return BF_SUCCESS;
 }
@@ -3858,8 +3888,8 @@ bf_status_t bf_mc_get_max_node_threshold_exceeded_data(bf_mc_session_hdl_t shdl,
   (void)dev;
   (void)grp;
   (void)addr;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3874,8 +3904,8 @@ bf_status_t bf_mc_get_max_node_threshold_exdeeded_data_port_lag(
   (void)dev;
   (void)grp;
   (void)addr;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3905,8 +3935,8 @@ bf_status_t bf_mc_set_debug_filter(bf_mc_session_hdl_t shdl,
   (void)ingress_rid_m;
   (void)l1_xid_m;
   (void)l2_xid_m;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3922,8 +3952,8 @@ bf_status_t bf_mc_set_node_watch_point(bf_mc_session_hdl_t shdl,
   (void)pipe;
   (void)enable;
   (void)address;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3939,8 +3969,8 @@ bf_status_t bf_mc_get_node_watch_point_data(bf_mc_session_hdl_t shdl,
   (void)pipe;
   (void)hit;
   (void)state;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3954,8 +3984,8 @@ bf_status_t bf_mc_get_debug_counters(bf_mc_session_hdl_t shdl,
   (void)dev;
   (void)pipe;
   (void)cntrs;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3972,8 +4002,8 @@ bf_status_t bf_mc_get_copy_dest_vector(bf_mc_session_hdl_t shdl,
   (void)pipe;
   (void)ports_hi;
   (void)ports_lo;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
@@ -3987,16 +4017,15 @@ bf_status_t bf_mc_get_int_fifo_credit(bf_mc_session_hdl_t shdl,
   (void)dev;
   (void)pipe;
   (void)credit;
-  mc_mgr_one_at_a_time_begin();
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
 bf_status_t mc_rdm_change_intr_cb_int(bf_mc_session_hdl_t shdl,
                                       bf_dev_id_t dev,
                                       bf_dev_pipe_t pipe) {
-  int sid = -1;
-  if (-1 == (sid = mc_mgr_validate_session(shdl, __func__, __LINE__))) {
+  if (-1 == mc_mgr_validate_session(shdl, __func__, __LINE__)) {
     return BF_INVALID_ARG;
   }
   if (MC_MGR_INVALID_DEV(dev)) {
@@ -4013,7 +4042,7 @@ bf_status_t mc_rdm_change_intr_cb_int(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_rdm_change_done(sid, dev, pipe, true);
+  mc_mgr_rdm_change_done(dev, pipe, true);
 
   return BF_SUCCESS;
 }
@@ -4029,44 +4058,124 @@ bf_status_t bf_mc_node_garbage_collection_scheduler_mode(
   return BF_SUCCESS;
 }
 
-bf_status_t bf_mc_do_node_garbage_collection(bf_mc_session_hdl_t shdl) {
-  if (!mc_mgr_ready()) return BF_NOT_READY;
+/* Completes any finished RDM changes on one device so the RDM entries waiting
+ * on them can be reused.  Only the device lock is taken so sessions holding a
+ * lane of the device keep running; the entries of their lanes are freed when
+ * the lane is next idle.  Returns BF_IN_USE if another thread holds the device
+ * exclusively. */
+bf_status_t mc_mgr_dev_node_garbage_collection(bf_mc_session_hdl_t shdl,
+                                               bf_dev_id_t dev) {
+  int pipe;
 
-  bf_status_t sts = mc_mgr_one_at_a_time_begin_try();
+  if (!mc_mgr_dev_present(dev)) return BF_SUCCESS;
+
+  mc_mgr_lanes_t *lanes = mc_mgr_ctx_dev_lanes(dev);
+  bf_status_t sts = mc_mgr_lanes_trylock_dev(lanes);
   if (sts != BF_SUCCESS) {
     return sts;
   }
 
-  bf_dev_id_t dev;
-  int pipe;
-  for (dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
-    if (!mc_mgr_dev_present(dev)) continue;
-    if (mc_mgr_is_device_locked(dev)) continue;
-    for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
-      if (mc_mgr_ctx_rdm_pending_get(dev, pipe)) {
-        /* Change was initiated, check the HW */
-        int rc = mc_mgr_drv_read_rdm_change(dev, pipe);
-        if (!rc) {
-          /* Change has completed. */
-          mc_rdm_change_intr_cb_int(shdl, dev, pipe);
-        } else if (-1 == rc) {
-          LOG_ERROR(
-              "Dev %d, Pipe %d, RDM Change Read Error (%d)", dev, pipe, rc);
-        } else {
-          LOG_TRACE(
-              "Dev %d, Pipe %d, RDM Change not complete (%#x)", dev, pipe, rc);
-        }
+  if (mc_mgr_is_device_locked(dev)) goto done;
+  for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
+    if (mc_mgr_ctx_rdm_pending_get(dev, pipe)) {
+      /* Change was initiated, check the HW */
+      int rc = mc_mgr_drv_read_rdm_change(dev, pipe);
+      if (!rc) {
+        /* Change has completed. */
+        mc_rdm_change_intr_cb_int(shdl, dev, pipe);
+      } else if (-1 == rc) {
+        LOG_ERROR("Dev %d, Pipe %d, RDM Change Read Error (%d)", dev, pipe, rc);
       } else {
-        /* No change has been initiated by sw yet. */
+        LOG_TRACE(
+            "Dev %d, Pipe %d, RDM Change not complete (%#x)", dev, pipe, rc);
       }
+    } else {
+      /* No change has been initiated by sw yet. */
     }
   }
+  /* Pick up work left on lanes which were busy on an earlier pass. */
+  mc_mgr_rdm_collect_lanes(dev);
 
-  mc_mgr_one_at_a_time_end();
+done:
+  mc_mgr_lanes_unlock_dev(lanes);
+  return BF_SUCCESS;
+}
+
+bf_status_t bf_mc_do_node_garbage_collection(bf_mc_session_hdl_t shdl) {
+  if (!mc_mgr_ready()) return BF_NOT_READY;
+
+  /* Devices busy with an API are skipped, they will be collected on the next
+   * pass. */
+  bf_status_t sts = BF_SUCCESS;
+  for (bf_dev_id_t dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
+    if (BF_SUCCESS != mc_mgr_dev_node_garbage_collection(shdl, dev)) {
+      sts = BF_IN_USE;
+    }
+  }
+  return sts;
+}
+
+bf_status_t bf_mc_rdm_usage_get(bf_mc_session_hdl_t shdl,
+                                bf_dev_id_t dev,
+                                bf_mc_rdm_usage_t *usage) {
+  if (!mc_mgr_ready()) return BF_NOT_READY;
+
+  /* Validate the session. */
+  if (-1 == mc_mgr_validate_session(shdl, __func__, __LINE__)) {
+    return BF_INVALID_ARG;
+  }
+  /* Validate device. */
+  if (!mc_mgr_validate_dev(dev, __func__, __LINE__)) {
+    return BF_INVALID_ARG;
+  }
+  if (!usage) {
+    return BF_INVALID_ARG;
+  }
 
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_rdm_usage_get(dev, usage);
+  mc_mgr_dev_one_at_a_time_end(dev);
   return BF_SUCCESS;
 }
 
+bf_status_t bf_mc_rdm_compact(bf_mc_session_hdl_t shdl,
+                              bf_dev_id_t dev,
+                              uint32_t max_nodes,
+                              uint32_t *nodes_moved) {
+  if (!mc_mgr_ready()) return BF_NOT_READY;
+
+  /* Validate the session. */
+  int sid = -1;
+  if (-1 == (sid = mc_mgr_validate_session(shdl, __func__, __LINE__))) {
+    return BF_INVALID_ARG;
+  }
+  /* Validate device. */
+  if (!mc_mgr_validate_dev(dev, __func__, __LINE__)) {
+    return BF_INVALID_ARG;
+  }
+
+  uint32_t moved = 0;
+  bf_status_t sts = BF_SUCCESS;
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  /* Nodes are not written to hardware while the device is locked, there is
+   * nothing to compact until it is reprogrammed. */
+  if (mc_mgr_is_device_locked(dev)) {
+    sts = BF_IN_USE;
+  } else {
+    sts = mc_mgr_rdm_compact(sid, dev, max_nodes, &moved);
+  }
+  mc_mgr_dev_one_at_a_time_end(dev);
+  if (nodes_moved) *nodes_moved = moved;
+  if (BF_SUCCESS != sts) {
+    LOG_ERROR("%s failed; dev %d max %u, sts %s",
+              __func__,
+              dev,
+              max_nodes,
+              bf_err_str(sts));
+  }
+  return sts;
+}
+
 bf_status_t bf_mc_rdm_change_intr_cb(bf_mc_session_hdl_t shdl,
                                      bf_dev_id_t dev,
                                      bf_dev_pipe_t pipe) {
@@ -4085,9 +4194,9 @@ bf_status_t bf_mc_rdm_change_intr_cb(bf_mc_session_hdl_t shdl,
     return BF_INVALID_ARG;
   }
 
-  mc_mgr_one_at_a_time_begin();
+  mc_mgr_lanes_lock_dev(mc_mgr_ctx_dev_lanes(dev));
   sts = mc_rdm_change_intr_cb_int(shdl, dev, pipe);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_lanes_unlock_dev(mc_mgr_ctx_dev_lanes(dev));
 
   return sts;
 }
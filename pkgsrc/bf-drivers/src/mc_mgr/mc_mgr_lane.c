@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <errno.h>
+#include <string.h>
+#include "mc_mgr_lane.h"
+
+void mc_mgr_lanes_init(mc_mgr_lanes_t *l) {
+  MC_MGR_LOCK_INIT_R(l->dev_mtx);
+  l->owner = NULL;
+  l->owner_depth = 0;
+  for (int i = 0; i < MC_MGR_NUM_LANES; ++i) {
+    mc_mgr_lane_t *ln = &l->lane[i];
+    MC_MGR_LOCK_INIT_R(ln->mtx);
+    MC_MGR_LOCK_INIT(ln->work_mtx);
+    ln->work_head = ln->work_tail = NULL;
+    ln->work_count = 0;
+  }
+}
+
+void mc_mgr_lanes_cleanup(mc_mgr_lanes_t *l) {
+  for (int i = 0; i < MC_MGR_NUM_LANES; ++i) {
+    mc_mgr_lane_t *ln = &l->lane[i];
+    while (ln->work_head) {
+      mc_mgr_lane_work_t *w = ln->work_head;
+      ln->work_head = w->next;
+      MC_MGR_FREE(w);
+    }
+    ln->work_tail = NULL;
+    ln->work_count = 0;
+  }
+}
+
+static void lanes_owner_set(mc_mgr_lanes_t *l) {
+  if (!l->owner_depth++) {
+    __atomic_store_n(&l->owner, bf_sys_thread_self(), __ATOMIC_RELEASE);
+  }
+}
+
+void mc_mgr_lanes_lock_all(mc_mgr_lanes_t *l) {
+  MC_MGR_LOCK_R(&l->dev_mtx);
+  for (int i = 0; i < MC_MGR_NUM_LANES; ++i) {
+    MC_MGR_LOCK_R(&l->lane[i].mtx);
+  }
+  lanes_owner_set(l);
+}
+
+bf_status_t mc_mgr_lanes_trylock_all(mc_mgr_lanes_t *l) {
+  int err;
+  MC_MGR_TRYLOCK_R(&l->dev_mtx, err);
+  if (err != 0) return BF_IN_USE;
+  for (int i = 0; i < MC_MGR_NUM_LANES; ++i) {
+    MC_MGR_TRYLOCK_R(&l->lane[i].mtx, err);
+    if (err != 0) {
+      while (i--) MC_MGR_UNLOCK_R(&l->lane[i].mtx);
+      MC_MGR_UNLOCK_R(&l->dev_mtx);
+      return BF_IN_USE;
+    }
+  }
+  lanes_owner_set(l);
+  return BF_SUCCESS;
+}
+
+void mc_mgr_lanes_unlock_all(mc_mgr_lanes_t *l) {
+  if (!--l->owner_depth) {
+    __atomic_store_n(&l->owner, NULL, __ATOMIC_RELEASE);
+  }
+  for (int i = MC_MGR_NUM_LANES; i--;) {
+    MC_MGR_UNLOCK_R(&l->lane[i].mtx);
+  }
+  MC_MGR_UNLOCK_R(&l->dev_mtx);
+}
+
+bool mc_mgr_lanes_held_all(mc_mgr_lanes_t *l) {
+  return __atomic_load_n(&l->owner, __ATOMIC_ACQUIRE) == bf_sys_thread_self();
+}
+
+void mc_mgr_lanes_lock_dev(mc_mgr_lanes_t *l) { MC_MGR_LOCK_R(&l->dev_mtx); }
+
+bf_status_t mc_mgr_lanes_trylock_dev(mc_mgr_lanes_t *l) {
+  int err;
+  MC_MGR_TRYLOCK_R(&l->dev_mtx, err);
+  return err ? BF_IN_USE : BF_SUCCESS;
+}
+
+void mc_mgr_lanes_unlock_dev(mc_mgr_lanes_t *l) {
+  MC_MGR_UNLOCK_R(&l->dev_mtx);
+}
+
+void mc_mgr_lane_lock(mc_mgr_lanes_t *l, int lane) {
+  MC_MGR_LOCK_R(&l->lane[lane].mtx);
+}
+
+bf_status_t mc_mgr_lane_trylock(mc_mgr_lanes_t *l, int lane) {
+  int err;
+  MC_MGR_TRYLOCK_R(&l->lane[lane].mtx, err);
+  return err ? BF_IN_USE : BF_SUCCESS;
+}
+
+void mc_mgr_lane_unlock(mc_mgr_lanes_t *l, int lane) {
+  MC_MGR_UNLOCK_R(&l->lane[lane].mtx);
+}
+
+bool mc_mgr_lane_hand_off(mc_mgr_lanes_t *l,
+                          int lane,
+                          const mc_mgr_lane_work_t *w) {
+  mc_mgr_lane_t *ln = &l->lane[lane];
+  mc_mgr_lane_work_t *x = MC_MGR_MALLOC(sizeof *x);
+  if (!x) return false;
+  *x = *w;
+  x->next = NULL;
+
+  MC_MGR_LOCK(&ln->work_mtx);
+  if (ln->work_tail) {
+    ln->work_tail->next = x;
+  } else {
+    ln->work_head = x;
+  }
+  ln->work_tail = x;
+  __atomic_add_fetch(&ln->work_count, 1, __ATOMIC_RELEASE);
+  MC_MGR_UNLOCK(&ln->work_mtx);
+  return true;
+}
+
+bool mc_mgr_lane_has_work(mc_mgr_lanes_t *l, int lane) {
+  return __atomic_load_n(&l->lane[lane].work_count, __ATOMIC_ACQUIRE) != 0;
+}
+
+static mc_mgr_lane_work_t *lane_take(mc_mgr_lane_t *ln) {
+  MC_MGR_LOCK(&ln->work_mtx);
+  mc_mgr_lane_work_t *x = ln->work_head;
+  if (x) {
+    ln->work_head = x->next;
+    if (!ln->work_head) ln->work_tail = NULL;
+    __atomic_sub_fetch(&ln->work_count, 1, __ATOMIC_RELEASE);
+  }
+  MC_MGR_UNLOCK(&ln->work_mtx);
+  return x;
+}
+
+int mc_mgr_lane_drain(mc_mgr_lanes_t *l,
+                      int lane,
+                      mc_mgr_lane_work_fn fn,
+                      void *cookie) {
+  int count = 0;
+  mc_mgr_lane_work_t *x;
+  while ((x = lane_take(&l->lane[lane]))) {
+    fn(cookie, x);
+    MC_MGR_FREE(x);
+    ++count;
+  }
+  return count;
+}
+
+int mc_mgr_lanes_collect(mc_mgr_lanes_t *l,
+                         mc_mgr_lane_work_fn fn,
+                         void *cookie) {
+  int count = 0;
+  for (int i = 0; i < MC_MGR_NUM_LANES; ++i) {
+    if (!mc_mgr_lane_has_work(l, i)) continue;
+    if (BF_SUCCESS != mc_mgr_lane_trylock(l, i)) continue;
+    count += mc_mgr_lane_drain(l, i, fn, cookie);
+    mc_mgr_lane_unlock(l, i);
+  }
+  return count;
+}
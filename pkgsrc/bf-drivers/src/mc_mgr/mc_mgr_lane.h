@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *
+ * mc_mgr per device lanes
+ *
+ * The MGIDs of a device are split into lanes.  APIs which only touch one MGID
+ * (group create/destroy, node associate/dissociate) hold just the MGID's lane
+ * so sessions working on MGIDs of different lanes run concurrently.  Every
+ * other API holds the device exclusively: the device lock and then all lanes
+ * in increasing order.  A lane holder never waits for the device lock or
+ * another lane, it may only try them.
+ *
+ * State shared by the lanes (block allocation, block-id registers, the RDM
+ * change lists) has its own short locks.  RDM blocks are owned by a lane and
+ * the half width nodes in a block are only written by a holder of that lane,
+ * so work found by the garbage collector (entries to invalidate, MGID tails
+ * to rewrite) is handed to the owning lane's queue and run there.
+ *
+ *****************************************************************************/
+#ifndef __MC_MGR_LANE_H__
+#define __MC_MGR_LANE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <bf_types/bf_types.h>
+#include <target-sys/bf_sal/bf_sys_thread.h>
+#include <mc_mgr/mc_mgr_config.h>
+#include "mc_mgr_log.h"
+
+#define MC_MGR_NUM_LANES 4
+
+/* Lanes are picked by bits 6 and 7 of the MGID.  A 64-bit word of the MGID
+ * bitmap, a PVT/TVT row and the two Tofino PVT rows which differ only in MGID
+ * bit 15 then always fall in one lane. */
+static inline int mc_mgr_mgid_lane(int mgid) {
+  if (mgid < 0) return 0;
+  return (mgid >> 6) & (MC_MGR_NUM_LANES - 1);
+}
+
+typedef enum mc_mgr_lane_work_type_e {
+  /* Invalidate and release an RDM entry whose RDM change completed. */
+  MC_MGR_LANE_WORK_FREE,
+  /* Point an MGID's tree at the tail for a new length. */
+  MC_MGR_LANE_WORK_TAIL,
+} mc_mgr_lane_work_type_e;
+
+typedef struct mc_mgr_lane_work_t {
+  struct mc_mgr_lane_work_t *next;
+  mc_mgr_lane_work_type_e type;
+  uint32_t rdm_addr;
+  int pipe;
+  int mgid;
+  int len;
+} mc_mgr_lane_work_t;
+
+typedef struct mc_mgr_lane_t {
+  mc_rmutex_t mtx;
+  /* Work handed to the lane, run in order by whoever next holds the lane. */
+  mc_mutex_t work_mtx;
+  mc_mgr_lane_work_t *work_head;
+  mc_mgr_lane_work_t *work_tail;
+  int work_count;
+} mc_mgr_lane_t;
+
+typedef struct mc_mgr_lanes_t {
+  mc_rmutex_t dev_mtx;
+  /* Thread holding the device exclusively and its nesting depth. */
+  bf_sys_thread_t owner;
+  int owner_depth;
+  mc_mgr_lane_t lane[MC_MGR_NUM_LANES];
+} mc_mgr_lanes_t;
+
+typedef void (*mc_mgr_lane_work_fn)(void *cookie, const mc_mgr_lane_work_t *w);
+
+void mc_mgr_lanes_init(mc_mgr_lanes_t *l);
+void mc_mgr_lanes_cleanup(mc_mgr_lanes_t *l);
+
+/* Exclusive use of the device, see above. */
+void mc_mgr_lanes_lock_all(mc_mgr_lanes_t *l);
+bf_status_t mc_mgr_lanes_trylock_all(mc_mgr_lanes_t *l);
+void mc_mgr_lanes_unlock_all(mc_mgr_lanes_t *l);
+bool mc_mgr_lanes_held_all(mc_mgr_lanes_t *l);
+
+/* The device lock alone keeps exclusive holders out but lets lane holders
+ * run.  The garbage collector uses it. */
+void mc_mgr_lanes_lock_dev(mc_mgr_lanes_t *l);
+bf_status_t mc_mgr_lanes_trylock_dev(mc_mgr_lanes_t *l);
+void mc_mgr_lanes_unlock_dev(mc_mgr_lanes_t *l);
+
+void mc_mgr_lane_lock(mc_mgr_lanes_t *l, int lane);
+bf_status_t mc_mgr_lane_trylock(mc_mgr_lanes_t *l, int lane);
+void mc_mgr_lane_unlock(mc_mgr_lanes_t *l, int lane);
+
+bool mc_mgr_lane_hand_off(mc_mgr_lanes_t *l,
+                          int lane,
+                          const mc_mgr_lane_work_t *w);
+bool mc_mgr_lane_has_work(mc_mgr_lanes_t *l, int lane);
+/* Run the lane's queued work, the caller holds the lane. */
+int mc_mgr_lane_drain(mc_mgr_lanes_t *l,
+                      int lane,
+                      mc_mgr_lane_work_fn fn,
+                      void *cookie);
+/* Run the queued work of every lane which can be taken without waiting.
+ * Lanes busy with an API keep their work for the holder or the next pass. */
+int mc_mgr_lanes_collect(mc_mgr_lanes_t *l,
+                         mc_mgr_lane_work_fn fn,
+                         void *cookie);
+
+#endif /* __MC_MGR_LANE_H__ */
@@ -25,12 +25,15 @@
 #include <lld/lld_tof_addr_conversion.h>
 #include <lld/tofino_defs.h>
 #include <math.h>
+#include <sched.h>
 #include <tofino_regs/pipe_top_level.h>
 #include "mc_mgr_handle.h"
 #include "mc_mgr_int.h"
 #include "mc_mgr_bh.h"
+#include "mc_mgr_rdm_compact.h"
 
-extern bf_status_t bf_mc_do_node_garbage_collection(bf_mc_session_hdl_t shdl);
+extern bf_status_t mc_mgr_dev_node_garbage_collection(bf_mc_session_hdl_t shdl,
+                                                      bf_dev_id_t dev);
 static void encode_line(bf_dev_id_t dev, mc_mgr_rdm_line_t *line);
 void tof_mc_mgr_rdm_encode_line(mc_mgr_rdm_line_t *line);
 void tof2_mc_mgr_rdm_encode_line(mc_mgr_rdm_line_t *line);
@@ -45,6 +48,7 @@ static void mc_mgr_rdm_map_free_now(int sid,
 static void set_node_invalid(bf_dev_id_t dev,
                              mc_mgr_rdm_t *rdm_map,
                              uint32_t addr);
+static int rdm_dev_blk_size(bf_dev_id_t dev);
 
 void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
                          bf_dev_id_t dev,
@@ -83,6 +87,8 @@ void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
   /*malloc all the arrays*/
   rdm_map->free_blocks_ =
       MC_MGR_CALLOC(BF_BITSET_ARRAY_SIZE(rdm_blk_count), sizeof(uint64_t));
+  rdm_map->compact_blocks_ =
+      MC_MGR_CALLOC(BF_BITSET_ARRAY_SIZE(rdm_blk_count), sizeof(uint64_t));
   if (rdm_map->blk_id_width == TOF3_MC_MGR_RDM_BLK_ID_BITWIDTH) {
     rdm_map->blk_ids =
         MC_MGR_CALLOC(((rdm_blk_count + 7) / 8), sizeof(uint32_t));
@@ -106,6 +112,13 @@ void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
     for (j = 0; j < 2; j++) {
       rdm_map->used_blocks_[i][j] =
           MC_MGR_CALLOC(BF_BITSET_ARRAY_SIZE(rdm_blk_count), sizeof(uint64_t));
+      for (int l = 0; l < MC_MGR_NUM_LANES; ++l) {
+        rdm_map->lane_blocks_[l][i][j] = MC_MGR_CALLOC(
+            BF_BITSET_ARRAY_SIZE(rdm_blk_count), sizeof(uint64_t));
+        bf_bs_init(&rdm_map->lane_blocks[l][i][j],
+                   rdm_blk_count,
+                   rdm_map->lane_blocks_[l][i][j]);
+      }
     }
   }
   /* Actual number of lines */
@@ -115,6 +128,8 @@ void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
   /* Mark all blocks as free. */
   bf_bs_init(&rdm_map->free_blocks, rdm_blk_count, rdm_map->free_blocks_);
   bf_bs_set_all(&rdm_map->free_blocks, 1);
+  bf_bs_init(
+      &rdm_map->compact_blocks, rdm_blk_count, rdm_map->compact_blocks_);
   /* Ensure all "used_blocks" per pipe are zero. */
   for (i = 0; i < (int)num_max_pipes; ++i) {
     bf_bs_init(&rdm_map->used_blocks[i][0],
@@ -132,6 +147,7 @@ void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
     rdm_map->blocks[i].id = i;
     rdm_map->blocks[i].rdm = rdm_map;
     rdm_map->blocks[i].pipe = -1;
+    rdm_map->blocks[i].lane = -1;
     bf_bs_init(&rdm_map->blocks[i].free_entries[0],
                rdm_blk_size,
                rdm_map->blocks[i].free_entries_[0]);
@@ -149,16 +165,21 @@ void mc_mgr_rdm_map_init(mc_mgr_rdm_t **rdm_map_p,
   MC_MGR_DBGCHK(!x);
 
   MC_MGR_LOCK_INIT(rdm_map->rdm_change_list_mtx);
+  MC_MGR_LOCK_INIT(rdm_map->blk_mtx);
+  MC_MGR_LOCK_INIT(rdm_map->blk_id_mtx);
 }
 
 void mc_mgr_rdm_map_cleanup(mc_mgr_rdm_t **rdm_map) {
   int i, j, rdm_blk_count;
   rdm_blk_count = (*rdm_map)->rdm_blk_count;
   MC_MGR_LOCK_DEL((*rdm_map)->rdm_change_list_mtx);
+  MC_MGR_LOCK_DEL((*rdm_map)->blk_mtx);
+  MC_MGR_LOCK_DEL((*rdm_map)->blk_id_mtx);
   for (i = 0; i < rdm_blk_count; ++i) {
     power2_allocator_destroy((*rdm_map)->blocks[i].p2a);
   }
   MC_MGR_FREE((*rdm_map)->free_blocks_);
+  MC_MGR_FREE((*rdm_map)->compact_blocks_);
   MC_MGR_FREE((*rdm_map)->blk_ids);
   MC_MGR_FREE((*rdm_map)->blk_ids_other_die);
   MC_MGR_FREE((*rdm_map)->rdm);
@@ -171,6 +192,9 @@ void mc_mgr_rdm_map_cleanup(mc_mgr_rdm_t **rdm_map) {
   for (i = 0; i < (int)mc_mgr_ctx_num_max_pipes((*rdm_map)->dev); i++) {
     for (j = 0; j < 2; j++) {
       MC_MGR_FREE((*rdm_map)->used_blocks_[i][j]);
+      for (int l = 0; l < MC_MGR_NUM_LANES; ++l) {
+        MC_MGR_FREE((*rdm_map)->lane_blocks_[l][i][j]);
+      }
     }
   }
   MC_MGR_FREE(*rdm_map);
@@ -183,7 +207,7 @@ bf_status_t mc_mgr_rdm_reserve_tails(int sid, bf_dev_id_t dev, int pipe) {
   uint64_t ports_[BF_BITSET_ARRAY_SIZE(BF_PIPE_PORT_COUNT)] = {0};
   bf_bs_init(&ports, BF_PIPE_PORT_COUNT, ports_);
   uint32_t a = mc_mgr_rdm_map_get(
-      sid, dev, pipe, mc_mgr_rdm_node_type_lag, ti->tail_l2_size);
+      sid, dev, -1, pipe, mc_mgr_rdm_node_type_lag, ti->tail_l2_size);
   int a_width = node_width(mc_mgr_rdm_node_type_lag);
   if (!a) return BF_NO_SYS_RESOURCES;
   for (unsigned int i = 0; i < ti->tail_l2_size; ++i) {
@@ -195,7 +219,7 @@ bf_status_t mc_mgr_rdm_reserve_tails(int sid, bf_dev_id_t dev, int pipe) {
   ti->tail_l2_addr[pipe] = a;
 
   uint32_t b = mc_mgr_rdm_map_get(
-      sid, dev, pipe, mc_mgr_rdm_node_type_end, ti->num_tails);
+      sid, dev, -1, pipe, mc_mgr_rdm_node_type_end, ti->num_tails);
   int b_width = node_width(mc_mgr_rdm_node_type_end);
   if (!b) return BF_NO_SYS_RESOURCES;
   for (unsigned int i = 0; i < ti->num_tails; ++i) {
@@ -215,7 +239,14 @@ static void swap_lists(mc_mgr_rdm_block_t *blk) {
 
   bf_bitset_t *tmp = blk->waiting_free_entries;
   blk->waiting_free_entries = blk->queued_free_entries;
-  blk->queued_free_entries = tmp;
+  __atomic_store_n(&blk->queued_free_entries, tmp, __ATOMIC_SEQ_CST);
+
+  /* A producer in mc_mgr_rdm_map_free may have loaded the old queued list
+   * before the swap; let it finish so its entry is on the waiting list before
+   * the RDM change is started. */
+  while (__atomic_load_n(&blk->free_producers, __ATOMIC_SEQ_CST)) {
+    sched_yield();
+  }
 }
 static void mc_mgr_start_rdm_change(bf_dev_id_t dev,
                                     int pipe,
@@ -226,15 +257,18 @@ static void mc_mgr_start_rdm_change(bf_dev_id_t dev,
   }
 
   /* For all blocks in the pipe, swap their lists. */
+  mc_mgr_rdm_t *rdm_map = mc_mgr_ctx_rdm_map(dev);
   int blk = -1;
-  while (-1 != (blk = bf_bs_first_set(
-                    &mc_mgr_ctx_rdm_map(dev)->used_blocks[pipe][0], blk))) {
-    swap_lists(&mc_mgr_ctx_rdm_map(dev)->blocks[blk]);
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
+  while (-1 !=
+         (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][0], blk))) {
+    swap_lists(&rdm_map->blocks[blk]);
   }
-  while (-1 != (blk = bf_bs_first_set(
-                    &mc_mgr_ctx_rdm_map(dev)->used_blocks[pipe][1], blk))) {
-    swap_lists(&mc_mgr_ctx_rdm_map(dev)->blocks[blk]);
+  while (-1 !=
+         (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][1], blk))) {
+    swap_lists(&rdm_map->blocks[blk]);
   }
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
   /* Write the HW register to initiate a change. */
   mc_mgr_drv_start_rdm_change(dev, pipe);
   /* Update our state to indicate a change in in progress. */
@@ -271,18 +305,60 @@ static void blk_process_pending_list(bf_dev_id_t dev,
     mc_mgr_rdm_addr_append(addrs, addr);
   }
 }
-static bool mgid_tail_process_pending_list(int sid,
-                                           bf_dev_id_t dev,
+static void mgid_tail_process_pending_list(bf_dev_id_t dev,
                                            int pipe,
                                            mc_mgr_rdm_t *rdm_map) {
-  bool did_work = !!rdm_map->for_next_rdm_change[pipe];
+  mc_mgr_lanes_t *lanes = mc_mgr_ctx_dev_lanes(dev);
   while (rdm_map->for_next_rdm_change[pipe]) {
     struct mc_mgr_mgid_list_t *x = rdm_map->for_next_rdm_change[pipe];
     rdm_map->for_next_rdm_change[pipe] = x->next;
-    mc_mgr_set_l1_tail(sid, dev, pipe, x->mgid, x->update_length);
+    mc_mgr_lane_work_t w = {.type = MC_MGR_LANE_WORK_TAIL,
+                            .pipe = pipe,
+                            .mgid = x->mgid,
+                            .len = x->update_length};
+    bool ok = mc_mgr_lane_hand_off(lanes, mc_mgr_mgid_lane(x->mgid), &w);
+    MC_MGR_DBGCHK(ok);
     MC_MGR_FREE(x);
   }
-  return did_work;
+}
+
+/* Runs work handed to a lane by mc_mgr_rdm_change_done, the caller holds the
+ * lane. */
+struct rdm_lane_work_ctx {
+  int sid;
+  bf_dev_id_t dev;
+};
+static void rdm_lane_work(void *cookie, const mc_mgr_lane_work_t *w) {
+  struct rdm_lane_work_ctx *c = cookie;
+  switch (w->type) {
+    case MC_MGR_LANE_WORK_FREE:
+      mc_mgr_rdm_map_free_now(
+          c->sid, c->dev, mc_mgr_ctx_rdm_map(c->dev), w->rdm_addr);
+      break;
+    case MC_MGR_LANE_WORK_TAIL:
+      mc_mgr_set_l1_tail(c->sid, c->dev, w->pipe, w->mgid, w->len);
+      break;
+  }
+}
+
+/* Run the work of every lane which is not busy with an API and push the
+ * resulting writes.  The caller holds the device lock, which also serializes
+ * the users of the internal session the writes are made with. */
+bool mc_mgr_rdm_collect_lanes(bf_dev_id_t dev) {
+  int sid = 0;
+  if (!mc_mgr_decode_sess_hdl(mc_mgr_ctx_int_sess(), &sid)) {
+    MC_MGR_DBGCHK(0);
+    return false;
+  }
+  struct rdm_lane_work_ctx c = {.sid = sid, .dev = dev};
+  if (!mc_mgr_lanes_collect(mc_mgr_ctx_dev_lanes(dev), rdm_lane_work, &c)) {
+    return false;
+  }
+  bf_status_t sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
+  if (BF_SUCCESS != sts) {
+    MC_MGR_DBGCHK(BF_SUCCESS == sts);
+  }
+  return true;
 }
 void mc_mgr_enqueue_mgid_tail_update(bf_dev_id_t dev,
                                      int pipe,
@@ -302,58 +378,51 @@ void mc_mgr_enqueue_mgid_tail_update(bf_dev_id_t dev,
   rdm_map->after_next_rdm_change[pipe] = x;
   MC_MGR_UNLOCK(&rdm_map->rdm_change_list_mtx);
 }
-void mc_mgr_rdm_change_done(int sid,
-                            bf_dev_id_t dev,
-                            int pipe,
-                            bool restartable) {
+void mc_mgr_rdm_change_done(bf_dev_id_t dev, int pipe, bool restartable) {
   int i;
   int blk = -1;
   bool needs_rdm_change = false;
-  bool did_work = false;
   mc_mgr_rdm_addr_list_t *to_free = NULL;
 
-  mc_mgr_one_at_a_time_begin();
+  /* Only the device lock is taken; lanes busy with an API keep running.  The
+   * entries and tails are handed to the lane owning them and written by the
+   * lane's next holder, which is this thread for the lanes that are idle. */
+  mc_mgr_lanes_t *lanes = mc_mgr_ctx_dev_lanes(dev);
+  mc_mgr_lanes_lock_dev(lanes);
 
   mc_mgr_rdm_t *rdm_map = mc_mgr_ctx_rdm_map(dev);
 
   LOG_TRACE("Detected RDM Change Complete on %d.%d", dev, pipe);
 
   MC_MGR_LOCK(&rdm_map->rdm_change_list_mtx);
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
   /* Visit each block owned by the pipe. */
   for (i = 0; i < 2; ++i) {
     while (-1 != (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][i], blk))) {
       /* Clear out the pending list.  */
       blk_process_pending_list(dev, &rdm_map->blocks[blk], &to_free);
-
-      /* If any of the queued lists are non-empty, start another RDM
-       * Change. */
-      if (restartable && !needs_rdm_change &&
-          !bf_bs_all_0s(rdm_map->blocks[blk].queued_free_entries)) {
-        needs_rdm_change = true;
-      }
     }
   }
-  MC_MGR_UNLOCK(&rdm_map->rdm_change_list_mtx);
-
-  did_work = !!to_free;
+  /* A block with entries waiting to be freed is not released so its lane
+   * cannot change under us. */
   while (to_free) {
     uint32_t x = 0;
     mc_mgr_rdm_addr_pop(&to_free, &x);
-    mc_mgr_rdm_map_free_now(sid, dev, rdm_map, x);
+    int lane = rdm_map->blocks[x / rdm_dev_blk_size(dev)].lane;
+    mc_mgr_lane_work_t w = {.type = MC_MGR_LANE_WORK_FREE, .rdm_addr = x};
+    bool ok = mc_mgr_lane_hand_off(lanes, lane < 0 ? 0 : lane, &w);
+    MC_MGR_DBGCHK(ok);
   }
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
+  MC_MGR_UNLOCK(&rdm_map->rdm_change_list_mtx);
 
-  /* Process any pending MGID tail updates for the pipe.  Safe to work with the
-   * pending list's pointer because no other threads will modify it since the
-   * RDM change is still marked as in-progress. */
-  did_work |= mgid_tail_process_pending_list(sid, dev, pipe, rdm_map);
+  /* Queue any pending MGID tail updates for the pipe behind the frees.  Safe
+   * to work with the pending list's pointer because no other threads will
+   * modify it since the RDM change is still marked as in-progress. */
+  mgid_tail_process_pending_list(dev, pipe, rdm_map);
 
   /* Write the new RDM contents (zeroed out nodes) to HW. */
-  if (did_work) {
-    bf_status_t sts = mc_mgr_drv_wrl_send(sid, false);
-    if (BF_SUCCESS != sts) {
-      MC_MGR_DBGCHK(BF_SUCCESS == sts);
-    }
-  }
+  mc_mgr_rdm_collect_lanes(dev);
 
   MC_MGR_LOCK(&rdm_map->rdm_change_list_mtx);
   /* The pending MGID list is now empty, promote the next MGID list and if it
@@ -364,6 +433,22 @@ void mc_mgr_rdm_change_done(int sid,
     needs_rdm_change = true;
   }
 
+  /* If any of the queued lists are non-empty, start another RDM Change.  This
+   * is checked only now since entries are queued without holding the list
+   * lock; anything queued after this point will see the RDM change as no
+   * longer pending and start its own. */
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
+  for (i = 0; i < 2 && restartable && !needs_rdm_change; ++i) {
+    while (-1 != (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][i], blk))) {
+      if (!bf_bs_all_0s(rdm_map->blocks[blk].queued_free_entries)) {
+        needs_rdm_change = true;
+        break;
+      }
+    }
+    blk = -1;
+  }
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
+
   /* RDM change is now complete, update state. */
   mc_mgr_ctx_rdm_pending_clr(dev, pipe);
 
@@ -373,10 +458,10 @@ void mc_mgr_rdm_change_done(int sid,
     mc_mgr_start_rdm_change(dev, pipe, "Restart");
   }
   MC_MGR_UNLOCK(&rdm_map->rdm_change_list_mtx);
-  mc_mgr_one_at_a_time_end();
+  mc_mgr_lanes_unlock_dev(lanes);
 }
 
-void mc_mgr_wait_rdm_change(int sid, bf_dev_id_t dev, int pipe) {
+void mc_mgr_wait_rdm_change(bf_dev_id_t dev, int pipe) {
   int i;
   uint32_t is_pending = 0;
 
@@ -400,7 +485,7 @@ void mc_mgr_wait_rdm_change(int sid, bf_dev_id_t dev, int pipe) {
       if ((is_pending >> i) & 1) {
         if (!mc_mgr_drv_read_rdm_change(dev, i)) {
           is_pending &= ~(1 << i);
-          mc_mgr_rdm_change_done(sid, dev, i, false);
+          mc_mgr_rdm_change_done(dev, i, false);
         }
       }
     }
@@ -465,24 +550,10 @@ void mc_mgr_rdm_map_return(bf_dev_id_t dev, uint32_t addr) {
   /* Block zero always has one node reserved. */
   bool empty = !count || (1 == count && !blk);
   if (empty) {
-    /* Don't know which pipe the block was assigned to, just clear it in
-     * all pipes. */
-    int pipe;
-    for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
-      /* Remove from the pipe's used block list. */
-      bf_bs_set(&rdm_map->used_blocks[pipe][0], blk, 0);
-      bf_bs_set(&rdm_map->used_blocks[pipe][1], blk, 0);
-    }
-    /* Add to free block list. */
-    bf_bs_set(&rdm_map->free_blocks, blk, 1);
-    rdm_map->blocks[blk].pipe = -1;
-    if (rdm_map->blk_id_width == TOF3_MC_MGR_RDM_BLK_ID_BITWIDTH) {
-      rdm_map->blk_ids[blk / 8] &= ~(0xf << (4 * (blk & 0x7)));
-      rdm_map->blk_ids_other_die[blk / 8] &= ~(0xf << (4 * (blk & 0x7)));
-    } else {
-      rdm_map->blk_ids[blk / 16] &= ~(0x3 << (2 * (blk & 0xF)));
-      rdm_map->blk_ids_other_die[blk / 16] &= ~(0x3 << (2 * (blk & 0xF)));
-    }
+    /* Return it to the free list and drop it from its pipe and lane. */
+    MC_MGR_LOCK(&rdm_map->blk_mtx);
+    mark_block_free(rdm_map, rdm_map->blocks[blk].pipe, blk);
+    MC_MGR_UNLOCK(&rdm_map->blk_mtx);
     LOG_TRACE("Returning RDM address %#x - %#x (%d) and freeing block %d",
               addr,
               addr + size - 1,
@@ -494,8 +565,26 @@ void mc_mgr_rdm_map_return(bf_dev_id_t dev, uint32_t addr) {
   }
 }
 
+/* Out of RDM space: try to recover entries freed by completed RDM changes.
+ * Returns false if there is nothing left to try. */
+static bool rdm_map_reclaim(int sid, bf_dev_id_t dev, int lane, int n_tries) {
+  if (mc_mgr_is_device_locked(dev) || n_tries <= 0) return false;
+
+  /* Run garbage collection now (which also requires DR servicing).  It only
+   * trylocks the device, so when another thread holds it the frees handed to
+   * our lane are run here and the other thread is given time to finish. */
+  mc_mgr_drv_service_dr(dev);
+  bf_status_t sts =
+      mc_mgr_dev_node_garbage_collection(mc_mgr_ctx_int_sess(), dev);
+  struct rdm_lane_work_ctx c = {.sid = sid, .dev = dev};
+  int n = mc_mgr_lane_drain(mc_mgr_ctx_dev_lanes(dev), lane, rdm_lane_work, &c);
+  if (BF_SUCCESS != sts && !n) bf_sys_usleep(1000);
+  return true;
+}
+
 static uint32_t rdm_map_get(int sid,
                             bf_dev_id_t dev,
+                            int mgid,
                             int pipe,
                             mc_mgr_rdm_node_type_e type,
                             int count,
@@ -506,26 +595,33 @@ static uint32_t rdm_map_get(int sid,
   bool l1_l2 = !node_is_l1(type);
   bool is_tof3 =
       (rdm_map->blk_id_width == TOF3_MC_MGR_RDM_BLK_ID_BITWIDTH) ? true : false;
-  /* First check blocks owned by the pipe for a free entry. */
+  int lane = mc_mgr_mgid_lane(mgid);
+  /* First check blocks owned by the lane in the pipe for a free entry. */
   int blk = -1;
-  while (-1 !=
-         (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][l1_l2], blk))) {
+  while (-1 != (blk = bf_bs_first_set(
+                    &rdm_map->lane_blocks[lane][pipe][l1_l2], blk))) {
+    /* Skip blocks which are being compacted. */
+    if (bf_bs_get(&rdm_map->compact_blocks, blk)) continue;
     if (-1 != (addr = power2_allocator_alloc(rdm_map->blocks[blk].p2a,
                                              width * count))) {
       break;
     }
   }
   if (-1 == blk) {
-    /* No free entries in the owned blocks.  Allocate a new block. */
+    /* No free entries in the owned blocks.  Allocate a new block.  The
+     * block-id lock is held until the register write is pushed so another
+     * lane's older copy of the register cannot land after ours. */
+    MC_MGR_LOCK(&rdm_map->blk_id_mtx);
+    MC_MGR_LOCK(&rdm_map->blk_mtx);
     blk = bf_bs_first_set(&rdm_map->free_blocks, -1);
+    if (-1 != blk) mark_block_used(rdm_map, pipe, blk, l1_l2, lane);
+    MC_MGR_UNLOCK(&rdm_map->blk_mtx);
     if (-1 == blk) {
+      MC_MGR_UNLOCK(&rdm_map->blk_id_mtx);
       /* No free blocks either.  Out of RDM space (or compaction is required).
-       * Run garbage collection now (which also requires DR servicing) to try
-       * and recover nodes. */
-      if (!mc_mgr_is_device_locked(dev) && n_tries > 0) {
-        mc_mgr_drv_service_dr(dev);
-        bf_mc_do_node_garbage_collection(mc_mgr_ctx_int_sess());
-        return rdm_map_get(sid, dev, pipe, type, count, n_tries - 1);
+       * Try to recover nodes. */
+      if (rdm_map_reclaim(sid, dev, lane, n_tries)) {
+        return rdm_map_get(sid, dev, mgid, pipe, type, count, n_tries - 1);
       }
       LOG_ERROR(
           "Out of RDM resources, session %#x cannot allocate %d %s nodes on "
@@ -537,16 +633,18 @@ static uint32_t rdm_map_get(int sid,
           pipe);
       return 0;
     }
-    mark_block_used(rdm_map, pipe, blk, l1_l2);
     /* Allocate an entry from the block. */
     addr = power2_allocator_alloc(rdm_map->blocks[blk].p2a, width * count);
     /* Shouldn't fail on a new block. */
     if (-1 == addr) {
+      MC_MGR_UNLOCK(&rdm_map->blk_id_mtx);
       MC_MGR_DBGCHK(0);
       return 0;
     }
     /* Assign the block to the pipe. */
     mc_mgr_set_rdm_blk_id_grp_wrl(sid, dev, is_tof3 ? (blk / 8) : (blk / 16));
+    mc_mgr_drv_wrl_send_dev(sid, dev, false);
+    MC_MGR_UNLOCK(&rdm_map->blk_id_mtx);
   }
   int rdm_blk_size;
   if (mc_mgr_ctx_dev_family(dev) == BF_DEV_FAMILY_TOFINO) {
@@ -583,11 +681,14 @@ static uint32_t rdm_map_get(int sid,
 
 uint32_t mc_mgr_rdm_map_get(int sid,
                             bf_dev_id_t dev,
+                            int mgid,
                             int pipe,
                             mc_mgr_rdm_node_type_e type,
                             int count) {
-  int n_tries = 8;
-  return rdm_map_get(sid, dev, pipe, type, count, n_tries);
+  /* A lane holder may have to wait for another thread to collect, give it
+   * about 100ms. */
+  int n_tries = mc_mgr_lanes_held_all(mc_mgr_ctx_dev_lanes(dev)) ? 8 : 100;
+  return rdm_map_get(sid, dev, mgid, pipe, type, count, n_tries);
 }
 
 bool mc_mgr_mark_addr_used(mc_mgr_rdm_t *rdm_map,
@@ -607,11 +708,14 @@ bool mc_mgr_mark_addr_used(mc_mgr_rdm_t *rdm_map,
   } else {
     return false;
   }
-  /* If the block is free, assign it to this pipe. */
+  /* If the block is free, assign it to this pipe.  Blocks found by a hardware
+   * sync belong to lane zero. */
   if (rdm_map->blocks[blk].pipe == -1) {
     int x = power2_allocator_reserve(rdm_map->blocks[blk].p2a, blk_addr, sz);
     if (x) return false;
-    mark_block_used(rdm_map, pipe, blk, is_l2_node);
+    MC_MGR_LOCK(&rdm_map->blk_mtx);
+    mark_block_used(rdm_map, pipe, blk, is_l2_node, 0);
+    MC_MGR_UNLOCK(&rdm_map->blk_mtx);
     return true;
   }
   /* If the block is assigned to the pipe also check that the node type can
@@ -648,7 +752,9 @@ bool mc_mgr_rdm_mark_addr_free(mc_mgr_rdm_t *rdm_map,
   /* If this emptied the block mark it as free. */
   uint32_t c = power2_allocator_alloc_count(rdm_map->blocks[blk].p2a);
   if (!c || (1 == c && !blk)) {
+    MC_MGR_LOCK(&rdm_map->blk_mtx);
     mark_block_free(rdm_map, pipe, blk);
+    MC_MGR_UNLOCK(&rdm_map->blk_mtx);
   }
   return true;
 }
@@ -708,24 +814,10 @@ static void mc_mgr_rdm_map_free_now(int sid,
   /* Block zero always has one node reserved. */
   bool empty = !count || (1 == count && !blk);
   if (empty) {
-    /* Don't know which pipe the block was assigned to, just clear it in
-     * all pipes. */
-    int pipe;
-    for (pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
-      /* Remove from the pipe's used block list. */
-      bf_bs_set(&rdm_map->used_blocks[pipe][0], blk, 0);
-      bf_bs_set(&rdm_map->used_blocks[pipe][1], blk, 0);
-    }
-    /* Add to free block list. */
-    bf_bs_set(&rdm_map->free_blocks, blk, 1);
-    rdm_map->blocks[blk].pipe = -1;
-    if (rdm_map->blk_id_width == TOF3_MC_MGR_RDM_BLK_ID_BITWIDTH) {
-      rdm_map->blk_ids[blk / 8] &= ~(0xf << (4 * (blk & 0x7)));
-      rdm_map->blk_ids_other_die[blk / 8] &= ~(0xf << (4 * (blk & 0x7)));
-    } else {
-      rdm_map->blk_ids[blk / 16] &= ~(0x3 << (2 * (blk & 0xF)));
-      rdm_map->blk_ids_other_die[blk / 16] &= ~(0x3 << (2 * (blk & 0xF)));
-    }
+    /* Return it to the free list and drop it from its pipe and lane. */
+    MC_MGR_LOCK(&rdm_map->blk_mtx);
+    mark_block_free(rdm_map, rdm_map->blocks[blk].pipe, blk);
+    MC_MGR_UNLOCK(&rdm_map->blk_mtx);
     LOG_TRACE(
         "Returning dev %d RDM address %#x - %#x (%d) and freeing block %d",
         dev,
@@ -772,9 +864,16 @@ void mc_mgr_rdm_map_free(bf_dev_id_t dev, uint32_t addr) {
   }
   int blk_addr = addr - blk * rdm_blk_size;
 
-  MC_MGR_LOCK(&rdm_map->rdm_change_list_mtx);
-  bf_bs_set(rdm_map->blocks[blk].queued_free_entries, blk_addr, 1);
-  MC_MGR_UNLOCK(&rdm_map->rdm_change_list_mtx);
+  /* Mark the entry on the block's queued list without taking
+   * rdm_change_list_mtx so DMA completions and write list pushes on other
+   * threads do not contend with the RDM change processing.  See swap_lists for
+   * the other half of the handoff. */
+  mc_mgr_rdm_block_t *b = &rdm_map->blocks[blk];
+  __atomic_add_fetch(&b->free_producers, 1, __ATOMIC_SEQ_CST);
+  bf_bitset_t *q = __atomic_load_n(&b->queued_free_entries, __ATOMIC_SEQ_CST);
+  __atomic_fetch_or(
+      &q->bs[blk_addr / 64], 1ull << (blk_addr % 64), __ATOMIC_SEQ_CST);
+  __atomic_sub_fetch(&b->free_producers, 1, __ATOMIC_SEQ_CST);
 }
 
 inline static bool line_is_shareable(mc_mgr_rdm_line_t *line) {
@@ -1119,7 +1218,7 @@ bf_status_t mc_mgr_ecc_correct_rdm(bf_dev_id_t dev, uint32_t address) {
 
   /* Append to the write list. */
   sts = mc_mgr_set_rdm_wrl(sid, dev, line_no, line->data[1], line->data[0]);
-  if (BF_SUCCESS == sts) sts = mc_mgr_drv_wrl_send(sid, false);
+  if (BF_SUCCESS == sts) sts = mc_mgr_drv_wrl_send_dev(sid, dev, false);
   return sts;
 }
 
@@ -2793,3 +2892,222 @@ bool mc_mgr_rdm_sync_tails(int sid,
 failure:
   return false;
 }
+
+static int rdm_dev_blk_size(bf_dev_id_t dev) {
+  switch (mc_mgr_ctx_dev_family(dev)) {
+    case BF_DEV_FAMILY_TOFINO:
+      return TOF_MC_MGR_RDM_BLK_SIZE;
+    case BF_DEV_FAMILY_TOFINO2:
+      return TOF2_MC_MGR_RDM_BLK_SIZE;
+    case BF_DEV_FAMILY_TOFINO3:
+      return TOF3_MC_MGR_RDM_BLK_SIZE;
+    default:
+      return 0;
+  }
+}
+
+/* Number of entries in a block which have been released but are still waiting
+ * on an RDM change before they can be reused. */
+static uint32_t blk_pending_count(mc_mgr_rdm_block_t *blk) {
+  uint32_t count = 0;
+  for (int i = 0; i < 2; ++i) {
+    bf_bitset_t *bs = &blk->free_entries[i];
+    for (unsigned w = 0; w < BF_BITSET_ARRAY_SIZE(bs->width); ++w)
+      count += __builtin_popcountll(
+          __atomic_load_n(&bs->bs[w], __ATOMIC_RELAXED));
+  }
+  return count;
+}
+
+/* Longest run of unallocated entries in a block. */
+static uint32_t blk_largest_free(mc_mgr_rdm_block_t *blk, int blk_size) {
+  uint32_t largest = 0, next_free = 0;
+  int idx = power2_allocator_first_alloc(blk->p2a);
+  while (-1 != idx) {
+    uint32_t sz = power2_allocator_get_index_size(blk->p2a, idx);
+    if ((uint32_t)idx - next_free > largest) largest = idx - next_free;
+    next_free = idx + sz;
+    idx = power2_allocator_next_alloc(blk->p2a, idx);
+  }
+  if (blk_size - next_free > largest) largest = blk_size - next_free;
+  return largest;
+}
+
+void mc_mgr_rdm_usage_get(bf_dev_id_t dev, bf_mc_rdm_usage_t *usage) {
+  mc_mgr_rdm_t *rdm_map = mc_mgr_ctx_rdm_map(dev);
+  int blk_size = rdm_dev_blk_size(dev);
+  uint32_t scattered = 0;
+
+  memset(usage, 0, sizeof *usage);
+  if (!rdm_map || !blk_size) return;
+
+  usage->total_blocks = rdm_map->rdm_blk_count;
+  usage->total_entries = rdm_map->rdm_blk_count * blk_size;
+  for (uint32_t blk = 0; blk < rdm_map->rdm_blk_count; ++blk) {
+    if (bf_bs_get(&rdm_map->free_blocks, blk)) {
+      ++usage->free_blocks;
+      usage->free_entries += blk_size;
+      usage->largest_free_block = blk_size;
+      continue;
+    }
+    mc_mgr_rdm_block_t *b = &rdm_map->blocks[blk];
+    uint32_t in_use = power2_allocator_usage(b->p2a);
+    uint32_t pending = blk_pending_count(b);
+    uint32_t largest = blk_largest_free(b, blk_size);
+    usage->used_entries += in_use - pending;
+    usage->pending_entries += pending;
+    usage->free_entries += blk_size - in_use;
+    scattered += blk_size - in_use - largest;
+    if (largest > usage->largest_free_block)
+      usage->largest_free_block = largest;
+  }
+  if (usage->free_entries)
+    usage->fragmentation = (uint64_t)scattered * 100 / usage->free_entries;
+
+  /* Blocks are owned by a pipe and node level, so count what could be freed
+   * for each owner separately. */
+  for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
+    for (int l1_l2 = 0; l1_l2 < 2; ++l1_l2) {
+      uint32_t owned = 0, live = 0;
+      int blk = -1;
+      while (-1 != (blk = bf_bs_first_set(&rdm_map->used_blocks[pipe][l1_l2],
+                                           blk))) {
+        mc_mgr_rdm_block_t *b = &rdm_map->blocks[blk];
+        ++owned;
+        live += power2_allocator_usage(b->p2a) - blk_pending_count(b);
+      }
+      uint32_t needed = (live + blk_size - 1) / blk_size;
+      if (owned > needed) usage->reclaimable_blocks += owned - needed;
+    }
+  }
+}
+
+/* Choose the L2 blocks of a pipe's lane to empty, see
+ * mc_mgr_rdm_compact_select.  A node only moves within its lane's blocks so
+ * each lane is sized up on its own.  The number of live entries each chosen
+ * block holds is recorded in remaining[]. */
+static int rdm_compact_select(mc_mgr_rdm_t *rdm_map,
+                              int pipe,
+                              int lane,
+                              int blk_size,
+                              uint32_t *remaining) {
+  mc_mgr_rdm_compact_blk_t *c =
+      MC_MGR_CALLOC(rdm_map->rdm_blk_count, sizeof *c);
+  if (!c) return 0;
+
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
+  int n = 0, blk = -1;
+  while (-1 != (blk = bf_bs_first_set(
+                    &rdm_map->lane_blocks[lane][pipe][1], blk))) {
+    mc_mgr_rdm_block_t *b = &rdm_map->blocks[blk];
+    c[n].blk = blk;
+    c[n].in_use = power2_allocator_usage(b->p2a);
+    c[n].live = c[n].in_use - blk_pending_count(b);
+    c[n].compact = bf_bs_get(&rdm_map->compact_blocks, blk);
+    ++n;
+  }
+  int victims = mc_mgr_rdm_compact_select(c, n, blk_size);
+  for (int i = 0; i < n; ++i) {
+    bf_bs_set(&rdm_map->compact_blocks, c[i].blk, c[i].compact);
+    if (c[i].victim) remaining[c[i].blk] = c[i].live;
+  }
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
+  MC_MGR_FREE(c);
+  return victims;
+}
+
+/* Online RDM compaction.  L1 nodes with an L2 entry in a sparsely used block
+ * are rewritten with mc_mgr_l1_write: the new L2 chain is written elsewhere,
+ * the L1 node is pointed at it and the old entries are released through the
+ * RDM change mechanism, so traffic is never disrupted.  Chosen blocks are
+ * kept out of allocation until they drain back onto the free list, across
+ * calls.  Only L2 blocks are emptied.  An L1 entry keeps its address in the
+ * pipes the node stays in, but mc_mgr_l1_write also allocates or frees L1
+ * entries in any pipe the node has joined or left since it was last written.
+ * ECMP members are not moved.  At most max_nodes nodes (zero for no limit) are
+ * rewritten per call. */
+bf_status_t mc_mgr_rdm_compact(int sid,
+                               bf_dev_id_t dev,
+                               uint32_t max_nodes,
+                               uint32_t *nodes_moved) {
+  mc_mgr_rdm_t *rdm_map = mc_mgr_ctx_rdm_map(dev);
+  int blk_size = rdm_dev_blk_size(dev);
+  bf_status_t sts = BF_SUCCESS;
+
+  *nodes_moved = 0;
+  if (!rdm_map || !blk_size) return BF_INVALID_ARG;
+
+  uint32_t *remaining =
+      MC_MGR_CALLOC(rdm_map->rdm_blk_count, sizeof *remaining);
+  if (!remaining) return BF_NO_SYS_RESOURCES;
+
+  /* Blocks still draining from an earlier pass stay marked. */
+  int victims = 0;
+  for (int pipe = 0; pipe < (int)mc_mgr_ctx_num_max_pipes(dev); ++pipe) {
+    for (int lane = 0; lane < MC_MGR_NUM_LANES; ++lane) {
+      victims += rdm_compact_select(rdm_map, pipe, lane, blk_size, remaining);
+    }
+  }
+  if (!victims) goto done;
+
+  unsigned long not_used;
+  mc_l1_node_t *node = NULL;
+  bf_map_sts_t s;
+  for (s = bf_map_get_first(mc_mgr_ctx_db_l1(dev), &not_used, (void *)&node);
+       BF_MAP_OK == s;
+       s = bf_map_get_next(mc_mgr_ctx_db_l1(dev), &not_used, (void *)&node)) {
+    if (max_nodes && *nodes_moved >= max_nodes) break;
+    if (!node || node->dev != dev || ecmp_associated(node) ||
+        !mgid_associated(node))
+      continue;
+
+    mc_mgr_rdm_addr_list_t *addrs = NULL;
+    bool move = false;
+    for (int p = 0; p < (int)mc_mgr_ctx_num_max_pipes(dev); ++p) {
+      if (!node->hw_nodes[p].rdm_addr) continue;
+      mc_mgr_collect_l1s_l2_chain_addrs(
+          dev, node->hw_nodes[p].rdm_addr, &addrs);
+    }
+    for (mc_mgr_rdm_addr_list_t *a = addrs; a && !move; a = a->next) {
+      move = bf_bs_get(&rdm_map->compact_blocks, a->addr / blk_size);
+    }
+    if (move) {
+      sts = mc_mgr_l1_write(sid, node);
+      if (BF_SUCCESS == sts) {
+        ++*nodes_moved;
+        for (mc_mgr_rdm_addr_list_t *a = addrs; a; a = a->next) {
+          int blk = a->addr / blk_size;
+          uint32_t w = node_width(mc_mgr_rdm_type(rdm_map, a->addr));
+          remaining[blk] -= w < remaining[blk] ? w : remaining[blk];
+        }
+      }
+    }
+    while (addrs) {
+      uint32_t x = 0;
+      mc_mgr_rdm_addr_pop(&addrs, &x);
+    }
+    if (BF_SUCCESS != sts) {
+      LOG_ERROR("Dev %d RDM compaction failed to move node %#x, sts %s",
+                dev,
+                node->handle,
+                bf_err_str(sts));
+      break;
+    }
+  }
+
+  /* Blocks still holding nodes will not drain, allow allocations from them
+   * again. */
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
+  for (uint32_t blk = 0; blk < rdm_map->rdm_blk_count; ++blk) {
+    if (remaining[blk]) bf_bs_set(&rdm_map->compact_blocks, blk, 0);
+  }
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
+  LOG_TRACE("Dev %d RDM compaction moved %u nodes out of %d blocks",
+            dev,
+            *nodes_moved,
+            victims);
+
+done:
+  MC_MGR_FREE(remaining);
+  return sts;
+}
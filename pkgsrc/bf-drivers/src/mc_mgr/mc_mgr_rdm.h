@@ -24,7 +24,9 @@
 #include <target-utils/bitset/bitset.h>
 #include <target-utils/power2_allocator/power2_allocator.h>
 #include <mc_mgr/mc_mgr_config.h>
+#include <mc_mgr/mc_mgr_types.h>
 #include <lld/lld_sku.h>
+#include "mc_mgr_lane.h"
 
 /* BLK_SIZE is describing the number of 40b nodes in one RDM block */
 #define TOF_MC_MGR_RDM_BLK_ID_BITWIDTH 2
@@ -69,9 +71,17 @@ struct mc_mgr_rdm_block_t {
    * start of an RDM change.  Points to the other free_entries bf_bitset_t
    * structure above. */
   bf_bitset_t *queued_free_entries;
+  /* Number of threads currently setting a bit in queued_free_entries.  Frees
+   * are marked without holding rdm_change_list_mtx, so the list swap at the
+   * start of an RDM change waits for this to drain before handing the list to
+   * the hardware. */
+  int free_producers;
 
   /* Which pipe this block is assigned to, -1 when free. */
   int pipe;
+  /* Which lane allocates from this block, -1 when free.  Lines of the block
+   * are only written by a holder of that lane. */
+  int lane;
 };
 
 /* RDM Nodes. */
@@ -236,7 +246,21 @@ struct mc_mgr_rdm_t {
   /* Per pipe, use separate blocks for L1 and L2 nodes. */
   bf_bitset_t used_blocks[MC_MGR_NUM_PIPES][2];
   uint64_t *used_blocks_[MC_MGR_NUM_PIPES][2];
+  /* The used blocks split by owning lane.  Only changed and read by holders
+   * of the lane. */
+  bf_bitset_t lane_blocks[MC_MGR_NUM_LANES][MC_MGR_NUM_PIPES][2];
+  uint64_t *lane_blocks_[MC_MGR_NUM_LANES][MC_MGR_NUM_PIPES][2];
+  /* Protects free_blocks, used_blocks, blk_ids and the pipe of each block
+   * which are shared by all lanes.  Taken after rdm_change_list_mtx. */
+  mc_mutex_t blk_mtx;
+  /* Held from updating blk_ids until the register write is pushed so the
+   * block-id registers are written in the order the shadow changed. */
+  mc_mutex_t blk_id_mtx;
   mc_mgr_rdm_block_t *blocks;
+  /* Blocks being emptied by mc_mgr_rdm_compact.  New nodes are not placed in
+   * them; a block leaves the set once it is returned to free_blocks. */
+  bf_bitset_t compact_blocks;
+  uint64_t *compact_blocks_;
   /* Shadows pre_rdm_blk_id registers. */
   uint32_t *blk_ids;
   uint32_t *blk_ids_other_die;
@@ -387,10 +411,12 @@ static inline int rdm_addr_to_line(bf_dev_id_t dev, int addr) {
   (void)dev;
   return addr >> 1;
 }
+/* Called with blk_mtx held by a holder of the lane. */
 static inline void mark_block_used(mc_mgr_rdm_t *rdm_map,
                                    int pipe,
                                    int blk,
-                                   bool is_l2_node) {
+                                   bool is_l2_node,
+                                   int lane) {
   if (pipe < 0 || pipe >= (int)mc_mgr_rdm_num_max_pipes(rdm_map->dev)) {
     MC_MGR_DBGCHK(0);
     return;
@@ -401,7 +427,9 @@ static inline void mark_block_used(mc_mgr_rdm_t *rdm_map,
   bf_bs_set(&rdm_map->free_blocks, blk, 0);
   /* Add to the pipe's used block list. */
   bf_bs_set(&rdm_map->used_blocks[pipe][is_l2_node], blk, 1);
+  bf_bs_set(&rdm_map->lane_blocks[lane][pipe][is_l2_node], blk, 1);
   rdm_map->blocks[blk].pipe = pipe;
+  rdm_map->blocks[blk].lane = lane;
   /* Update the shadow of block to pipe mapping registers. */
   unsigned int p = pipe;
   unsigned int p_other_die = p ^ 0x4;
@@ -430,8 +458,15 @@ static inline void mark_block_free(mc_mgr_rdm_t *rdm_map, int pipe, int blk) {
   /* Remove from used block list. */
   bf_bs_set(&rdm_map->used_blocks[pipe][0], blk, 0);
   bf_bs_set(&rdm_map->used_blocks[pipe][1], blk, 0);
+  int lane = rdm_map->blocks[blk].lane;
+  if (lane >= 0) {
+    bf_bs_set(&rdm_map->lane_blocks[lane][pipe][0], blk, 0);
+    bf_bs_set(&rdm_map->lane_blocks[lane][pipe][1], blk, 0);
+  }
+  rdm_map->blocks[blk].lane = -1;
   /* Add to the free block list. */
   bf_bs_set(&rdm_map->free_blocks, blk, 1);
+  bf_bs_set(&rdm_map->compact_blocks, blk, 0);
   rdm_map->blocks[blk].pipe = -1;
   if (rdm_map->blk_id_width == TOF3_MC_MGR_RDM_BLK_ID_BITWIDTH) {
     rdm_map->blk_ids[blk / 8] &= ~(0xf << (4 * (blk & 0x7)));
@@ -653,8 +688,14 @@ void mc_mgr_rdm_write_port18(int sid,
                              bf_bitset_t *ports);
 void mc_mgr_rdm_write_lag(
     int sid, bf_dev_id_t dev, uint32_t addr, uint8_t lag_id, uint32_t next_l2);
-uint32_t mc_mgr_rdm_map_get(
-    int sid, bf_dev_id_t dev, int pipe, mc_mgr_rdm_node_type_e type, int count);
+/* Allocates count nodes for MGID mgid (-1 for nodes not owned by an MGID such
+ * as ECMP groups) from the blocks of the MGID's lane. */
+uint32_t mc_mgr_rdm_map_get(int sid,
+                            bf_dev_id_t dev,
+                            int mgid,
+                            int pipe,
+                            mc_mgr_rdm_node_type_e type,
+                            int count);
 bool mc_mgr_mark_addr_used(mc_mgr_rdm_t *rdm_map,
                            bf_dev_id_t dev,
                            int addr,
@@ -669,15 +710,18 @@ void mc_mgr_rdm_map_return(bf_dev_id_t dev, uint32_t addr);
 void mc_mgr_rdm_map_free(bf_dev_id_t dev, uint32_t addr);
 void mc_mgr_rdm_map_enqueue_free(int sid, bf_dev_id_t dev, uint32_t addr);
 void mc_mgr_start_rdm_change_all_pipes(bf_dev_id_t dev, const char *who);
-void mc_mgr_rdm_change_done(int sid,
-                            bf_dev_id_t dev,
-                            int pipe,
-                            bool restartable);
-void mc_mgr_wait_rdm_change(int sid, bf_dev_id_t dev, int pipe);
+void mc_mgr_rdm_change_done(bf_dev_id_t dev, int pipe, bool restartable);
+void mc_mgr_wait_rdm_change(bf_dev_id_t dev, int pipe);
+bool mc_mgr_rdm_collect_lanes(bf_dev_id_t dev);
 void mc_mgr_enqueue_mgid_tail_update(bf_dev_id_t dev,
                                      int pipe,
                                      int mgid,
                                      int length);
 bf_status_t mc_mgr_rdm_reserve_tails(int sid, bf_dev_id_t dev, int pipe);
 uint32_t mc_mgr_rdm_get_l2_lagid(bf_dev_id_t dev, uint32_t addr);
+void mc_mgr_rdm_usage_get(bf_dev_id_t dev, bf_mc_rdm_usage_t *usage);
+bf_status_t mc_mgr_rdm_compact(int sid,
+                               bf_dev_id_t dev,
+                               uint32_t max_nodes,
+                               uint32_t *nodes_moved);
 #endif
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#include <stdlib.h>
+#include "mc_mgr_rdm_compact.h"
+
+/* Blocks only waiting for their frees go last, the candidates are ordered
+ * sparsest first. */
+static int rdm_compact_blk_cmp(const void *a, const void *b) {
+  const mc_mgr_rdm_compact_blk_t *x = a, *y = b;
+  bool x_drained = x->compact && !x->live;
+  bool y_drained = y->compact && !y->live;
+  if (x_drained != y_drained) return x_drained ? 1 : -1;
+  if (x->live != y->live) return x->live < y->live ? -1 : 1;
+  return x->blk - y->blk;
+}
+
+int mc_mgr_rdm_compact_select(mc_mgr_rdm_compact_blk_t *c,
+                              int n,
+                              int blk_size) {
+  qsort(c, n, sizeof *c, rdm_compact_blk_cmp);
+
+  int cand = 0;
+  uint64_t capacity = 0;
+  for (int i = 0; i < n; ++i) {
+    c[i].victim = false;
+    if (c[i].compact && !c[i].live) continue;
+    c[i].compact = false;
+    capacity += blk_size - c[i].in_use;
+    ++cand;
+  }
+
+  int victims = 0;
+  uint64_t to_move = 0;
+  for (int i = 0; i < cand - 1; ++i) {
+    uint64_t cap = capacity - (blk_size - c[i].in_use);
+    if (4 * (to_move + c[i].live) > 3 * cap) break;
+    capacity = cap;
+    to_move += c[i].live;
+    c[i].compact = true;
+    c[i].victim = true;
+    ++victims;
+  }
+  return victims;
+}
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *
+ * Block selection for online RDM compaction
+ *
+ * Picks the L2 blocks mc_mgr_rdm_compact empties.  Kept apart from the RDM
+ * map so the policy can be exercised on its own.
+ *
+ *****************************************************************************/
+#ifndef __MC_MGR_RDM_COMPACT_H__
+#define __MC_MGR_RDM_COMPACT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct mc_mgr_rdm_compact_blk_t {
+  int blk;
+  /* Entries allocated in the block, including those waiting to be freed. */
+  uint32_t in_use;
+  /* Entries still holding nodes. */
+  uint32_t live;
+  /* Kept out of allocation while it drains.  Passed in as left by the
+   * previous call, set on return to what the block should be marked as. */
+  bool compact;
+  /* Chosen to be emptied by this call. */
+  bool victim;
+} mc_mgr_rdm_compact_blk_t;
+
+/* Chooses the blocks to empty out of the n blocks in c, which a node may be
+ * moved between (the L2 blocks of one pipe and lane).  Blocks marked by an
+ * earlier call which hold no live entries are only waiting for their pending
+ * frees and stay marked; marked blocks which still hold live entries are
+ * unmarked and considered again.  The sparsest blocks are picked for as long
+ * as their live entries fit in three quarters of the free space left in the
+ * remaining blocks; the margin allows for the alignment the power2 allocator
+ * imposes on multi-entry nodes.  c is reordered.  Returns the number of
+ * victims. */
+int mc_mgr_rdm_compact_select(mc_mgr_rdm_compact_blk_t *c, int n, int blk_size);
+
+#endif /* __MC_MGR_RDM_COMPACT_H__ */
@@ -383,11 +383,19 @@ bf_status_t mc_mgr_set_rdm_blk_id_grp_wrl(int sid, bf_dev_id_t dev, int grp) {
     return BF_INVALID_ARG;
   }
 
+  /* Other lanes may be assigning blocks of the same group, take a copy of
+   * the shadow under the block lock. */
+  mc_mgr_rdm_t *rdm_map = mc_mgr_ctx_rdm_map(dev);
+  MC_MGR_LOCK(&rdm_map->blk_mtx);
+  uint64_t lo_this_die = rdm_map->blk_ids[grp];
+  uint64_t lo_other_die = rdm_map->blk_ids_other_die[grp];
+  MC_MGR_UNLOCK(&rdm_map->blk_mtx);
+
   uint64_t hi = 0;
-  uint64_t lo = mc_mgr_ctx_rdm_map(dev)->blk_ids[grp];
+  uint64_t lo = lo_this_die;
 #if defined(EMU_2DIE_USING_SW_2DEV)
   if (dev == 1) {
-    lo = mc_mgr_ctx_rdm_map(dev)->blk_ids_other_die[grp];
+    lo = lo_other_die;
   }
 #endif
   uint32_t daddr = 0;
@@ -430,7 +438,7 @@ bf_status_t mc_mgr_set_rdm_blk_id_grp_wrl(int sid, bf_dev_id_t dev, int grp) {
     return BF_NO_SYS_RESOURCES;
   }
   if (mc_mgr_ctx_num_subdevices(dev) > 1) {
-    lo = mc_mgr_ctx_rdm_map(dev)->blk_ids_other_die[grp];
+    lo = lo_other_die;
     if (mc_mgr_drv_wrl_append(
             dev, 1, sid, 16, addr << 4, hi, lo, __func__, __LINE__)) {
       LOG_ERROR("Failed to add BlkId update to WRL on dev %d", dev);
@@ -30,6 +30,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <getopt.h>
+#include <inttypes.h>
+#include <time.h>
 
 #include <target-utils/uCli/ucli.h>
 #include <target-utils/uCli/ucli_argparse.h>
@@ -2132,6 +2134,117 @@ MC_MGR_CLI_CMD_DECLARE(rdm_alloc_dump) {
   return UCLI_STATUS_OK;
 }
 
+MC_MGR_CLI_CMD_DECLARE(rdm_usage) {
+  MC_MGR_CLI_PROLOGUE(
+      "rdm-usage", "Show RDM usage and fragmentation.", "-d <device>");
+
+  bool got_dev = false;
+  bf_dev_id_t dev = 0;
+  int x;
+
+  if (!mc_mgr_ready()) {
+    aim_printf(&uc->pvs, "Multicast Manager not present or not ready\n");
+    return UCLI_STATUS_OK;
+  }
+
+  while (-1 != (x = getopt(argc, argv, "d:"))) {
+    switch (x) {
+      case 'd':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        dev = strtoull(optarg, NULL, 0);
+        got_dev = true;
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  if (!got_dev || MC_MGR_INVALID_DEV(dev)) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+
+  if (!mc_mgr_dev_present(dev)) {
+    aim_printf(&uc->pvs, "Device %d not present\n", dev);
+    return UCLI_STATUS_OK;
+  }
+
+  bf_mc_rdm_usage_t u;
+  mc_mgr_dev_one_at_a_time_begin(dev);
+  mc_mgr_rdm_usage_get(dev, &u);
+  mc_mgr_dev_one_at_a_time_end(dev);
+
+  aim_printf(&uc->pvs, "Entries: %u total\n", u.total_entries);
+  aim_printf(&uc->pvs, "  Used              : %u\n", u.used_entries);
+  aim_printf(&uc->pvs, "  Pending free      : %u\n", u.pending_entries);
+  aim_printf(&uc->pvs, "  Free              : %u\n", u.free_entries);
+  aim_printf(&uc->pvs, "  Largest free block: %u\n", u.largest_free_block);
+  aim_printf(&uc->pvs, "  Fragmentation     : %u%%\n", u.fragmentation);
+  aim_printf(&uc->pvs, "Blocks: %u total\n", u.total_blocks);
+  aim_printf(&uc->pvs, "  Free              : %u\n", u.free_blocks);
+  aim_printf(&uc->pvs, "  Reclaimable       : %u\n", u.reclaimable_blocks);
+  return UCLI_STATUS_OK;
+}
+
+MC_MGR_CLI_CMD_DECLARE(rdm_compact) {
+  MC_MGR_CLI_PROLOGUE("rdm-compact",
+                      "Move nodes out of sparsely used RDM blocks.",
+                      "-s <session handle> -d <device> [-n <max nodes>]");
+
+  bf_mc_session_hdl_t shdl = 0;
+  bool got_sh = false;
+  bool got_dev = false;
+  bf_dev_id_t dev = 0;
+  uint32_t max_nodes = 0;
+  int x;
+
+  if (!mc_mgr_ready()) {
+    aim_printf(&uc->pvs, "Multicast Manager not present or not ready\n");
+    return UCLI_STATUS_OK;
+  }
+
+  while (-1 != (x = getopt(argc, argv, "s:d:n:"))) {
+    if (!optarg) {
+      aim_printf(&uc->pvs, "%s", usage);
+      return UCLI_STATUS_OK;
+    }
+    switch (x) {
+      case 's':
+        shdl = strtoull(optarg, NULL, 0);
+        got_sh = true;
+        break;
+      case 'd':
+        dev = strtoull(optarg, NULL, 0);
+        got_dev = true;
+        break;
+      case 'n':
+        max_nodes = strtoull(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  if (!got_sh || !got_dev) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+
+  uint32_t moved = 0;
+  bf_status_t sts = bf_mc_rdm_compact(shdl, dev, max_nodes, &moved);
+  aim_printf(&uc->pvs,
+             "RDM compaction on dev %d moved %u nodes, status %s\n",
+             dev,
+             moved,
+             bf_err_str(sts));
+  return UCLI_STATUS_OK;
+}
+
 MC_MGR_CLI_CMD_DECLARE(mgrp_show) {
   extern char *optarg;
   extern int optind;
@@ -5554,6 +5667,188 @@ MC_MGR_CLI_CMD_DECLARE(l1_read) {
   return UCLI_STATUS_OK;
 }
 
+struct mc_mgr_bench_thread {
+  bf_sys_thread_t thread;
+  bf_dev_id_t dev;
+  int first_mgid;
+  int count;
+  bf_status_t sts;
+  uint64_t ops;
+};
+
+/* Worker for the "bench" command.  Each thread uses its own session and a
+ * disjoint range of MGIDs.  Threads on different devices program in
+ * parallel.  On one device the group and association calls hold only the
+ * MGID's lane so threads whose MGIDs fall in different lanes overlap, while
+ * node create and destroy take the whole device.  Only the operations which
+ * succeeded are counted. */
+static void *mc_mgr_bench_worker(void *arg) {
+  struct mc_mgr_bench_thread *t = arg;
+  bf_mc_session_hdl_t shdl;
+  bf_mc_port_map_t ports;
+  bf_mc_lag_map_t lags;
+  BF_MC_PORT_MAP_INIT(ports);
+  BF_MC_LAG_MAP_INIT(lags);
+  int i, done = 0;
+
+  bf_mc_mgrp_hdl_t *mgrps = MC_MGR_CALLOC(t->count, sizeof *mgrps);
+  bf_mc_node_hdl_t *nodes = MC_MGR_CALLOC(t->count, sizeof *nodes);
+  if (!mgrps || !nodes) {
+    t->sts = BF_NO_SYS_RESOURCES;
+    goto free_hdls;
+  }
+
+  t->sts = bf_mc_create_session(&shdl);
+  if (BF_SUCCESS != t->sts) goto free_hdls;
+
+  for (i = 0; i < t->count && BF_SUCCESS == t->sts; ++i) {
+    t->sts = bf_mc_mgrp_create(shdl, t->dev, t->first_mgid + i, &mgrps[i]);
+    if (BF_SUCCESS != t->sts) break;
+    t->sts = bf_mc_node_create(shdl, t->dev, i, ports, lags, &nodes[i]);
+    if (BF_SUCCESS != t->sts) {
+      bf_mc_mgrp_destroy(shdl, t->dev, mgrps[i]);
+      break;
+    }
+    t->sts = bf_mc_associate_node(shdl, t->dev, mgrps[i], nodes[i], false, 0);
+    if (BF_SUCCESS != t->sts) {
+      bf_mc_node_destroy(shdl, t->dev, nodes[i]);
+      bf_mc_mgrp_destroy(shdl, t->dev, mgrps[i]);
+      break;
+    }
+    ++done;
+    t->ops += 3;
+  }
+  bf_mc_complete_operations(shdl);
+
+  for (i = 0; i < done; ++i) {
+    bf_mc_dissociate_node(shdl, t->dev, mgrps[i], nodes[i]);
+    bf_mc_node_destroy(shdl, t->dev, nodes[i]);
+    bf_mc_mgrp_destroy(shdl, t->dev, mgrps[i]);
+    t->ops += 3;
+  }
+  bf_mc_complete_operations(shdl);
+  bf_mc_destroy_session(shdl);
+
+free_hdls:
+  if (mgrps) MC_MGR_FREE(mgrps);
+  if (nodes) MC_MGR_FREE(nodes);
+  return NULL;
+}
+
+MC_MGR_CLI_CMD_DECLARE(bench) {
+  MC_MGR_CLI_PROLOGUE("bench",
+                      "Program multicast groups from several threads and "
+                      "report the rate.",
+                      "-t <threads> -n <groups per thread> [-g <first MGID>] "
+                      "[-d <device> | -a]");
+
+  int threads = 0, count = 0, first_mgid = 0;
+  bf_dev_id_t dev = -1;
+  bool all_devs = false;
+  int x;
+
+  if (!mc_mgr_ready()) {
+    aim_printf(&uc->pvs, "Multicast Manager not present or not ready\n");
+    return UCLI_STATUS_OK;
+  }
+
+  while (-1 != (x = getopt(argc, argv, "t:n:g:d:a"))) {
+    if (x == 'a') {
+      all_devs = true;
+      continue;
+    }
+    if (!optarg) {
+      aim_printf(&uc->pvs, "%s", usage);
+      return UCLI_STATUS_OK;
+    }
+    switch (x) {
+      case 't':
+        threads = strtoul(optarg, NULL, 0);
+        break;
+      case 'n':
+        count = strtoul(optarg, NULL, 0);
+        break;
+      case 'g':
+        first_mgid = strtoul(optarg, NULL, 0);
+        break;
+      case 'd':
+        dev = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  if (0 >= threads || 0 >= count || 0 > first_mgid ||
+      (long)first_mgid + (long)threads * count > BF_MGID_COUNT) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+  if (-1 != dev && (MC_MGR_INVALID_DEV(dev) || !mc_mgr_dev_present(dev))) {
+    aim_printf(&uc->pvs, "Device %d not present\n", dev);
+    return UCLI_STATUS_OK;
+  }
+
+  /* By default all threads program the first present device, which measures
+   * the contention within one device.  With -a the threads are spread over
+   * all present devices instead. */
+  bf_dev_id_t devs[MC_MGR_NUM_DEVICES];
+  int dev_cnt = 0;
+  if (-1 != dev) {
+    devs[dev_cnt++] = dev;
+  } else {
+    for (dev = 0; dev < MC_MGR_NUM_DEVICES; ++dev) {
+      if (!mc_mgr_dev_present(dev)) continue;
+      devs[dev_cnt++] = dev;
+      if (!all_devs) break;
+    }
+  }
+  if (!dev_cnt) {
+    aim_printf(&uc->pvs, "No devices present\n");
+    return UCLI_STATUS_OK;
+  }
+
+  struct mc_mgr_bench_thread *t = MC_MGR_CALLOC(threads, sizeof *t);
+  if (!t) return UCLI_STATUS_OK;
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (x = 0; x < threads; ++x) {
+    t[x].dev = devs[x % dev_cnt];
+    t[x].first_mgid = first_mgid + x * count;
+    t[x].count = count;
+    bf_sys_thread_create(&t[x].thread, mc_mgr_bench_worker, &t[x], 0);
+  }
+  uint64_t ops = 0;
+  for (x = 0; x < threads; ++x) {
+    bf_sys_thread_join(t[x].thread, NULL);
+    ops += t[x].ops;
+    if (BF_SUCCESS != t[x].sts) {
+      aim_printf(&uc->pvs,
+                 "Thread %d on dev %d failed: %s\n",
+                 x,
+                 t[x].dev,
+                 bf_err_str(t[x].sts));
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  MC_MGR_FREE(t);
+
+  double secs =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  aim_printf(&uc->pvs,
+             "%d threads on %d device(s), up to %d per device: %" PRIu64
+             " operations in %.3f seconds, %.0f ops/sec\n",
+             threads,
+             dev_cnt,
+             (threads + dev_cnt - 1) / dev_cnt,
+             ops,
+             secs,
+             secs > 0 ? ops / secs : 0);
+  return UCLI_STATUS_OK;
+}
+
 /* <auto.ucli.handlers.start> */
 static ucli_command_handler_f mc_mgr_ucli_ucli_handlers__[] = {
     MC_MGR_CLI_CMD_HNDLR(init),
@@ -5579,6 +5874,8 @@ static ucli_command_handler_f mc_mgr_ucli_ucli_handlers__[] = {
     MC_MGR_CLI_CMD_HNDLR(ecmp_list_all_handles),
     MC_MGR_CLI_CMD_HNDLR(rdm_read),
     MC_MGR_CLI_CMD_HNDLR(rdm_alloc_dump),
+    MC_MGR_CLI_CMD_HNDLR(rdm_usage),
+    MC_MGR_CLI_CMD_HNDLR(rdm_compact),
     MC_MGR_CLI_CMD_HNDLR(set_in_prog),
     MC_MGR_CLI_CMD_HNDLR(clr_in_prog),
     MC_MGR_CLI_CMD_HNDLR(mgrp_show),
@@ -5618,6 +5915,7 @@ static ucli_command_handler_f mc_mgr_ucli_ucli_handlers__[] = {
     MC_MGR_CLI_CMD_HNDLR(max_nodes),
     MC_MGR_CLI_CMD_HNDLR(max_l1_rd),
     MC_MGR_CLI_CMD_HNDLR(max_l2_rd),
+    MC_MGR_CLI_CMD_HNDLR(bench),
     NULL};
 /* <auto.ucli.handlers.end> */
 
@@ -5638,9 +5936,11 @@ ucli_node_t *mc_mgr_ucli_node_create(void) {
 }
 
 static ucli_command_handler_f bf_drv_show_tech_ucli_mc_handlers__[] = {
-    mc_mgr_ucli_ucli__rdm_alloc_dump__, mc_mgr_ucli_ucli__mgrp_show__};
+    mc_mgr_ucli_ucli__rdm_alloc_dump__,
+    mc_mgr_ucli_ucli__rdm_usage__,
+    mc_mgr_ucli_ucli__mgrp_show__};
 
-char *mc_cmd[] = {"rdm-alloc-dump", "mgrp-show"};
+char *mc_cmd[] = {"rdm-alloc-dump", "rdm-usage", "mgrp-show"};
 
 ucli_status_t bf_drv_show_tech_ucli_mc__(ucli_context_t *uc) {
   unsigned hdl_iter = 0;
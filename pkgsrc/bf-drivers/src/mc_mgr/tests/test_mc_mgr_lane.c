@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*
+ * Concurrency test of the mc_mgr device lanes.  Several session threads work
+ * on random MGIDs holding only the MGID's lane while a collector thread hands
+ * frees and tail updates to the lanes and an exclusive thread takes the whole
+ * device.  Checks that no two threads are ever inside one lane, that every
+ * handed off free runs exactly once on a thread holding its lane and that the
+ * tail updates of each MGID run in the order they were handed off.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../mc_mgr_lane.h"
+
+#define TEST_SESSIONS 6
+#define TEST_SESSION_OPS 4000
+#define TEST_COLLECT_ROUNDS 400
+#define TEST_FREES_PER_ROUND 16
+#define TEST_TAILS_PER_ROUND 8
+#define TEST_EXCL_OPS 300
+#define TEST_MGIDS 1024
+#define TEST_FREES (TEST_COLLECT_ROUNDS * TEST_FREES_PER_ROUND)
+
+static mc_mgr_lanes_t lanes;
+
+/* Thread inside each lane, zero when none.  Written only by a lane holder. */
+static pthread_t lane_holder[MC_MGR_NUM_LANES];
+static bool lane_held[MC_MGR_NUM_LANES];
+/* Unprotected read-modify-write counters, only exact if the lanes exclude. */
+static int lane_counter[MC_MGR_NUM_LANES];
+static int lane_counter_expect[MC_MGR_NUM_LANES];
+
+static int free_seen[TEST_FREES];
+static int tail_next[TEST_MGIDS];
+static int tail_handed[TEST_MGIDS];
+static int drained_by_session;
+
+static void lane_enter(int lane) {
+  assert(!lane_held[lane] || pthread_equal(lane_holder[lane], pthread_self()));
+  lane_holder[lane] = pthread_self();
+  lane_held[lane] = true;
+}
+
+static void lane_exit(int lane) {
+  assert(lane_held[lane] && pthread_equal(lane_holder[lane], pthread_self()));
+  lane_held[lane] = false;
+}
+
+static void lane_bump(int lane) {
+  int x = lane_counter[lane];
+  sched_yield();
+  lane_counter[lane] = x + 1;
+  ++lane_counter_expect[lane];
+}
+
+static void work_fn(void *cookie, const mc_mgr_lane_work_t *w) {
+  (void)cookie;
+  int lane;
+  if (MC_MGR_LANE_WORK_FREE == w->type) {
+    lane = w->rdm_addr % MC_MGR_NUM_LANES;
+    assert(w->rdm_addr < TEST_FREES);
+    assert(!free_seen[w->rdm_addr]);
+    free_seen[w->rdm_addr] = 1;
+  } else {
+    lane = mc_mgr_mgid_lane(w->mgid);
+    assert(w->mgid >= 0 && w->mgid < TEST_MGIDS);
+    /* Tails of one MGID come back in the order they were handed off. */
+    assert(w->len == tail_next[w->mgid]);
+    ++tail_next[w->mgid];
+  }
+  /* Either the lane is idle and the collector holds it or the thread holding
+   * it is draining. */
+  bool mine = lane_held[lane];
+  if (mine) {
+    assert(pthread_equal(lane_holder[lane], pthread_self()));
+  } else {
+    lane_enter(lane);
+  }
+  lane_bump(lane);
+  if (!mine) lane_exit(lane);
+}
+
+static void *session_thread(void *arg) {
+  unsigned int seed = (unsigned int)(uintptr_t)arg;
+  for (int i = 0; i < TEST_SESSION_OPS; ++i) {
+    int mgid = rand_r(&seed) % TEST_MGIDS;
+    int lane = mc_mgr_mgid_lane(mgid);
+    mc_mgr_lane_lock(&lanes, lane);
+    lane_enter(lane);
+    assert(!mc_mgr_lanes_held_all(&lanes));
+    lane_bump(lane);
+    /* Out of space, run what the collector left on our lane. */
+    if (!(rand_r(&seed) % 8)) {
+      int n = mc_mgr_lane_drain(&lanes, lane, work_fn, NULL);
+      __atomic_add_fetch(&drained_by_session, n, __ATOMIC_RELAXED);
+    }
+    lane_exit(lane);
+    mc_mgr_lane_unlock(&lanes, lane);
+  }
+  return NULL;
+}
+
+static void *collector_thread(void *arg) {
+  unsigned int seed = (unsigned int)(uintptr_t)arg;
+  uint32_t next_free = 0;
+  for (int r = 0; r < TEST_COLLECT_ROUNDS; ++r) {
+    if (r & 1) {
+      mc_mgr_lanes_lock_dev(&lanes);
+    } else {
+      while (BF_SUCCESS != mc_mgr_lanes_trylock_dev(&lanes)) sched_yield();
+    }
+    assert(!mc_mgr_lanes_held_all(&lanes));
+    for (int i = 0; i < TEST_FREES_PER_ROUND; ++i) {
+      mc_mgr_lane_work_t w = {.type = MC_MGR_LANE_WORK_FREE,
+                              .rdm_addr = next_free++};
+      bool ok = mc_mgr_lane_hand_off(
+          &lanes, w.rdm_addr % MC_MGR_NUM_LANES, &w);
+      assert(ok);
+    }
+    for (int i = 0; i < TEST_TAILS_PER_ROUND; ++i) {
+      int mgid = rand_r(&seed) % TEST_MGIDS;
+      mc_mgr_lane_work_t w = {.type = MC_MGR_LANE_WORK_TAIL,
+                              .pipe = 0,
+                              .mgid = mgid,
+                              .len = tail_handed[mgid]++};
+      bool ok = mc_mgr_lane_hand_off(&lanes, mc_mgr_mgid_lane(mgid), &w);
+      assert(ok);
+    }
+    mc_mgr_lanes_collect(&lanes, work_fn, NULL);
+    mc_mgr_lanes_unlock_dev(&lanes);
+  }
+  return NULL;
+}
+
+static void *exclusive_thread(void *arg) {
+  (void)arg;
+  for (int i = 0; i < TEST_EXCL_OPS; ++i) {
+    if (i & 1) {
+      mc_mgr_lanes_lock_all(&lanes);
+    } else {
+      while (BF_SUCCESS != mc_mgr_lanes_trylock_all(&lanes)) sched_yield();
+    }
+    assert(mc_mgr_lanes_held_all(&lanes));
+    /* Nested use, as when garbage collection runs under an exclusive API. */
+    mc_mgr_lanes_lock_all(&lanes);
+    assert(BF_SUCCESS == mc_mgr_lanes_trylock_dev(&lanes));
+    mc_mgr_lanes_unlock_dev(&lanes);
+    mc_mgr_lanes_unlock_all(&lanes);
+    assert(mc_mgr_lanes_held_all(&lanes));
+    for (int l = 0; l < MC_MGR_NUM_LANES; ++l) lane_enter(l);
+    for (int l = 0; l < MC_MGR_NUM_LANES; ++l) lane_bump(l);
+    for (int l = 0; l < MC_MGR_NUM_LANES; ++l) lane_exit(l);
+    mc_mgr_lanes_unlock_all(&lanes);
+    assert(!mc_mgr_lanes_held_all(&lanes));
+  }
+  return NULL;
+}
+
+static void test_lane_of_mgid(void) {
+  /* An MGID bitmap word, a PVT/TVT row and the Tofino PVT row pair are all in
+   * one lane. */
+  for (int mgid = 0; mgid < 0x10000; ++mgid) {
+    int lane = mc_mgr_mgid_lane(mgid);
+    assert(lane >= 0 && lane < MC_MGR_NUM_LANES);
+    assert(lane == mc_mgr_mgid_lane(mgid & ~63));
+    assert(lane == mc_mgr_mgid_lane(mgid ^ 0x8000));
+  }
+  assert(0 == mc_mgr_mgid_lane(-1));
+}
+
+static void test_concurrent(void) {
+  pthread_t sessions[TEST_SESSIONS], collector, excl;
+  mc_mgr_lanes_init(&lanes);
+
+  for (int i = 0; i < TEST_SESSIONS; ++i) {
+    int rc = pthread_create(
+        &sessions[i], NULL, session_thread, (void *)(uintptr_t)(i + 1));
+    assert(!rc);
+  }
+  int rc = pthread_create(&collector, NULL, collector_thread, (void *)99);
+  assert(!rc);
+  rc = pthread_create(&excl, NULL, exclusive_thread, NULL);
+  assert(!rc);
+
+  for (int i = 0; i < TEST_SESSIONS; ++i) pthread_join(sessions[i], NULL);
+  pthread_join(collector, NULL);
+  pthread_join(excl, NULL);
+
+  /* Anything left on a lane that was busy is picked up by the next pass. */
+  mc_mgr_lanes_lock_dev(&lanes);
+  mc_mgr_lanes_collect(&lanes, work_fn, NULL);
+  mc_mgr_lanes_unlock_dev(&lanes);
+
+  for (int l = 0; l < MC_MGR_NUM_LANES; ++l) {
+    assert(!mc_mgr_lane_has_work(&lanes, l));
+    assert(lane_counter[l] == lane_counter_expect[l]);
+  }
+  for (int i = 0; i < TEST_FREES; ++i) assert(1 == free_seen[i]);
+  for (int m = 0; m < TEST_MGIDS; ++m) assert(tail_next[m] == tail_handed[m]);
+  mc_mgr_lanes_cleanup(&lanes);
+  printf("  %d of %d work items run by a session holding the lane\n",
+         drained_by_session,
+         TEST_FREES + TEST_COLLECT_ROUNDS * TEST_TAILS_PER_ROUND);
+}
+
+int main(void) {
+  test_lane_of_mgid();
+  test_concurrent();
+  printf("mc_mgr lane tests passed\n");
+  return 0;
+}
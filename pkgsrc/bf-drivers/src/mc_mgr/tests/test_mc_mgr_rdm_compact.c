@@ -0,0 +1,262 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+
+/*
+ * Test of the RDM compaction block selection.  Models the L2 blocks of one
+ * pipe and lane the way mc_mgr_rdm_compact drives them: each call selects
+ * victims, moves their nodes elsewhere leaving the old entries pending until
+ * the RDM change completes, and unmarks victims it could not empty.  Checks
+ * that drained blocks stay marked across calls, that partly drained blocks are
+ * unmarked and picked again, and that repeated calls shrink the block count.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../mc_mgr_rdm_compact.h"
+
+#define TEST_BLK_SIZE 32
+#define TEST_BLKS 64
+
+typedef struct test_blk_t {
+  bool used;
+  uint32_t live;
+  uint32_t pending;
+  bool compact;
+} test_blk_t;
+
+static test_blk_t blks[TEST_BLKS];
+/* Blocks picked by an earlier call and how often one was picked again after
+ * being unmarked. */
+static bool ever_victim[TEST_BLKS];
+static int remarks;
+
+static void reset(const uint32_t *live, int n) {
+  memset(blks, 0, sizeof blks);
+  memset(ever_victim, 0, sizeof ever_victim);
+  remarks = 0;
+  for (int i = 0; i < n; ++i) {
+    blks[i].used = true;
+    blks[i].live = live[i];
+  }
+}
+
+static uint32_t in_use(int b) { return blks[b].live + blks[b].pending; }
+
+static int used_count(void) {
+  int n = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) n += blks[b].used;
+  return n;
+}
+
+static uint32_t live_total(void) {
+  uint32_t n = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) n += blks[b].live;
+  return n;
+}
+
+/* Where the allocator places a moved entry: the first used block which is not
+ * being compacted and has room, otherwise a new block. */
+static int alloc_blk(void) {
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    if (blks[b].used && !blks[b].compact && in_use(b) < TEST_BLK_SIZE) return b;
+  }
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    if (!blks[b].used) {
+      blks[b].used = true;
+      return b;
+    }
+  }
+  assert(0);
+  return -1;
+}
+
+/* The RDM changes completed, blocks left empty go back to the free list which
+ * also clears their compaction mark. */
+static void frees_done(void) {
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    blks[b].pending = 0;
+    if (blks[b].used && !blks[b].live) {
+      blks[b].used = false;
+      blks[b].compact = false;
+    }
+  }
+}
+
+/* One compaction call moving at most max_moves entries, zero for no limit.
+ * Returns the number of victims. */
+static int compact(uint32_t max_moves, uint32_t *moved) {
+  mc_mgr_rdm_compact_blk_t c[TEST_BLKS];
+  int n = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    if (!blks[b].used) continue;
+    c[n].blk = b;
+    c[n].in_use = in_use(b);
+    c[n].live = blks[b].live;
+    c[n].compact = blks[b].compact;
+    ++n;
+  }
+  int victims = mc_mgr_rdm_compact_select(c, n, TEST_BLK_SIZE);
+
+  bool victim[TEST_BLKS] = {false};
+  uint64_t to_move = 0, room = 0;
+  int counted = 0;
+  for (int i = 0; i < n; ++i) {
+    int b = c[i].blk;
+    /* A drained block stays marked and is never picked again. */
+    if (blks[b].compact && !blks[b].live) {
+      assert(c[i].compact && !c[i].victim);
+    }
+    assert(!c[i].victim || c[i].compact);
+    if (c[i].victim && ever_victim[b] && !blks[b].compact) ++remarks;
+    if (c[i].victim) ever_victim[b] = true;
+    blks[b].compact = c[i].compact;
+    victim[b] = c[i].victim;
+    counted += c[i].victim;
+    if (c[i].victim) {
+      to_move += blks[b].live;
+    } else if (!c[i].compact) {
+      room += TEST_BLK_SIZE - in_use(b);
+    }
+  }
+  assert(counted == victims);
+  /* What is chosen fits in three quarters of the room left. */
+  assert(4 * to_move <= 3 * room);
+
+  *moved = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    while (victim[b] && blks[b].live) {
+      if (max_moves && *moved >= max_moves) break;
+      int to = alloc_blk();
+      assert(!blks[to].compact && to != b);
+      ++blks[to].live;
+      --blks[b].live;
+      ++blks[b].pending;
+      ++*moved;
+    }
+  }
+  /* Victims still holding nodes will not drain, unmark them. */
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    if (victim[b] && blks[b].live) blks[b].compact = false;
+  }
+  return victims;
+}
+
+static void test_trivial(void) {
+  mc_mgr_rdm_compact_blk_t c[2] = {{.blk = 0, .in_use = 3, .live = 3}};
+  assert(0 == mc_mgr_rdm_compact_select(c, 0, TEST_BLK_SIZE));
+  /* A single block has nowhere to move its nodes. */
+  assert(0 == mc_mgr_rdm_compact_select(c, 1, TEST_BLK_SIZE));
+  assert(!c[0].compact && !c[0].victim);
+  /* Two full blocks have no room. */
+  c[0] = (mc_mgr_rdm_compact_blk_t){.blk = 0, .in_use = 32, .live = 32};
+  c[1] = (mc_mgr_rdm_compact_blk_t){.blk = 1, .in_use = 32, .live = 32};
+  assert(0 == mc_mgr_rdm_compact_select(c, 2, TEST_BLK_SIZE));
+}
+
+static void test_sparsest_first(void) {
+  mc_mgr_rdm_compact_blk_t c[4] = {
+      {.blk = 0, .in_use = 20, .live = 20},
+      {.blk = 1, .in_use = 6, .live = 2},
+      {.blk = 2, .in_use = 3, .live = 3},
+      {.blk = 3, .in_use = 10, .live = 10},
+  };
+  assert(2 == mc_mgr_rdm_compact_select(c, 4, TEST_BLK_SIZE));
+  for (int i = 0; i < 4; ++i) {
+    bool want = c[i].blk == 1 || c[i].blk == 2;
+    assert(c[i].victim == want && c[i].compact == want);
+  }
+}
+
+/* Drain in one call, the frees are still pending on the next call. */
+static void test_drain_across_calls(void) {
+  static const uint32_t live[] = {2, 30, 1, 3, 28, 4, 25, 2};
+  uint32_t moved, total;
+  reset(live, 8);
+  total = live_total();
+
+  int victims = compact(0, &moved);
+  assert(victims > 0 && moved > 0);
+  assert(live_total() == total);
+  int marked = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) {
+    if (blks[b].compact) {
+      assert(!blks[b].live && blks[b].pending);
+      ++marked;
+    }
+  }
+  assert(marked == victims);
+
+  /* The RDM change has not completed, drained blocks stay marked and only
+   * the others are looked at. */
+  compact(0, &moved);
+  int still = 0;
+  for (int b = 0; b < TEST_BLKS; ++b) still += blks[b].compact;
+  assert(still >= marked);
+
+  frees_done();
+  for (int b = 0; b < TEST_BLKS; ++b) assert(!blks[b].compact);
+  assert(live_total() == total);
+  assert(used_count() < 8);
+}
+
+/* A move budget leaves victims partly drained, they are unmarked and picked
+ * again on later calls until the blocks pack down. */
+static void test_remark_with_budget(void) {
+  uint32_t live[24];
+  for (int i = 0; i < 24; ++i) live[i] = 1 + (i * 7) % 11;
+  reset(live, 24);
+  uint32_t total = live_total(), moved;
+  int start = used_count();
+
+  for (int call = 0; call < 200; ++call) {
+    compact(4, &moved);
+    for (int b = 0; b < TEST_BLKS; ++b) {
+      /* Only drained blocks are left marked at the end of a call. */
+      if (blks[b].compact) assert(!blks[b].live);
+    }
+    assert(live_total() == total);
+    if (call % 3 == 2) frees_done();
+    if (!moved) break;
+  }
+  frees_done();
+  assert(remarks > 0);
+  /* Packed to within one block of the minimum, the margin keeps the last
+   * block from being filled completely. */
+  int needed = (total + TEST_BLK_SIZE - 1) / TEST_BLK_SIZE;
+  assert(used_count() <= needed + 1);
+  printf("  %d blocks packed into %d, %u entries, %d re-marks\n",
+         start,
+         used_count(),
+         total,
+         remarks);
+}
+
+int main(void) {
+  test_trivial();
+  test_sparsest_first();
+  test_drain_across_calls();
+  test_remark_with_budget();
+  printf("mc_mgr rdm compaction tests passed\n");
+  return 0;
+}
@@ -0,0 +1,599 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <errno.h>
+#include <time.h>
+
+#include <target-utils/uCli/ucli.h>
+#include <target-utils/hashtbl/bf_hashtbl.h>
+#include <target-utils/map/map.h>
+#include <target-utils/id/id.h>
+#include <target-sys/bf_sal/bf_sys_timer.h>
+#include <bfutils/bf_utils.h>
+#include <dvm/bf_drv_intf.h>
+
+#include "perf_util.h"
+#include "perf_ucli.h"
+#include "perf_sw.h"
+
+typedef struct perf_sw_htbl_obj_t {
+  uint64_t key;
+  bf_hashtbl_node_t node;
+} perf_sw_htbl_obj_t;
+
+static int perf_sw_htbl_cmp(const void *key, const void *node) {
+  const perf_sw_htbl_obj_t *obj = bf_hashtbl_get_cmp_data(node);
+  return memcmp(key, &obj->key, sizeof obj->key);
+}
+
+/**
+ * @brief Run performance test that will insert, look up and remove entries in
+ * a bf_hashtbl using each node mode and the bulk lookup, and report the cost
+ * per operation.
+ *
+ * @param uc ucli context pointer
+ * @param entries Number of entries in the table
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_hashtbl(ucli_context_t *uc, int entries) {
+  enum hdr_t { MODE, INSERT, SEARCH, SEARCH_BULK, REMOVE, HTBL_RESULTS };
+  char *result_hdr[] = {"Mode", "Insert", "Search", "Bulk search", "Remove"};
+  char *unit_hdr[] = {"[-]", "[ns/op]", "[ns/op]", "[ns/op]", "[ns/op]"};
+  char *mode_name[] = {"alloc", "slab", "intrusive"};
+  bf_hashtbl_mode_t modes[] = {
+      BF_HASHTBL_MODE_ALLOC, BF_HASHTBL_MODE_SLAB, BF_HASHTBL_MODE_INTRUSIVE};
+#define HTBL_MODES (int)(sizeof(modes) / sizeof(modes[0]))
+  double results[HTBL_MODES][HTBL_RESULTS];
+  ucli_status_t status = UCLI_STATUS_OK;
+
+  banner(uc, "HASH TABLE");
+  if (entries <= 0) {
+    aim_printf(&uc->pvs, "Number of entries must be positive\n");
+    return UCLI_STATUS_E_PARAM;
+  }
+
+  perf_sw_htbl_obj_t *objs = bf_sys_calloc(entries, sizeof *objs);
+  void **keys = bf_sys_calloc(entries, sizeof *keys);
+  void **found = bf_sys_calloc(entries, sizeof *found);
+  if (!objs || !keys || !found) {
+    aim_printf(&uc->pvs, "%s:%d: Out of memory\n", __func__, __LINE__);
+    status = UCLI_STATUS_E_ERROR;
+    goto done;
+  }
+
+  /* Look the keys up in a random order so that every lookup misses the
+   * cache the way a large table does. */
+  for (int i = 0; i < entries; i++) {
+    objs[i].key = (uint64_t)i * 0x9E3779B97F4A7C15ull;
+    keys[i] = &objs[i].key;
+  }
+  for (int i = entries - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    void *k = keys[i];
+    keys[i] = keys[j];
+    keys[j] = k;
+  }
+
+  for (int m = 0; m < HTBL_MODES; m++) {
+    bf_hashtable_t htbl;
+    struct timespec start, stop;
+    double op_per_s;
+    int hits = 0;
+
+    memset(&htbl, 0, sizeof htbl);
+    if (bf_hashtbl_init_mode(&htbl,
+                             perf_sw_htbl_cmp,
+                             NULL,
+                             sizeof(uint64_t),
+                             sizeof(perf_sw_htbl_obj_t),
+                             0x5eed,
+                             modes[m]) != BF_HASHTBL_OK) {
+      aim_printf(&uc->pvs, "Cannot create %s table\n", mode_name[m]);
+      status = UCLI_STATUS_E_ERROR;
+      goto done;
+    }
+    results[m][MODE] = m;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < entries; i++) {
+      if (modes[m] == BF_HASHTBL_MODE_INTRUSIVE) {
+        bf_hashtbl_insert_node(&htbl, &objs[i].node, &objs[i], &objs[i].key);
+      } else {
+        bf_hashtbl_insert(&htbl, &objs[i], &objs[i].key);
+      }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[m][INSERT]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < entries; i++) {
+      if (bf_hashtbl_search(&htbl, keys[i])) hits++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[m][SEARCH]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    hits += bf_hashtbl_search_bulk(&htbl, keys, entries, found);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[m][SEARCH_BULK]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < entries; i++) {
+      if (modes[m] == BF_HASHTBL_MODE_INTRUSIVE) {
+        bf_hashtbl_remove_node(&htbl, &objs[i].node);
+      } else {
+        bf_hashtbl_get_remove(&htbl, &objs[i].key);
+      }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[m][REMOVE]);
+
+    bf_hashtbl_delete(&htbl);
+    if (hits != 2 * entries) {
+      aim_printf(&uc->pvs,
+                 "%s table lost entries, %d of %d found\n",
+                 mode_name[m],
+                 hits,
+                 2 * entries);
+      status = UCLI_STATUS_E_ERROR;
+      goto done;
+    }
+  }
+
+  aim_printf(&uc->pvs, "Entries: %d\n", entries);
+  for (int i = 0; i < HTBL_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", result_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < HTBL_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", unit_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int m = 0; m < HTBL_MODES; m++) {
+    aim_printf(&uc->pvs,
+               "%15s %15.2f %15.2f %15.2f %15.2f\n",
+               mode_name[m],
+               results[m][INSERT],
+               results[m][SEARCH],
+               results[m][SEARCH_BULK],
+               results[m][REMOVE]);
+  }
+  save_results_file(uc,
+                    "perf_sw_hashtbl.csv",
+                    HTBL_RESULTS,
+                    HTBL_MODES,
+                    result_hdr,
+                    unit_hdr,
+                    results);
+
+done:
+  if (objs) bf_sys_free(objs);
+  if (keys) bf_sys_free(keys);
+  if (found) bf_sys_free(found);
+  return status;
+}
+
+/**
+ * @brief Run performance test that will populate, look up and walk a bf_map
+ * one key at a time and with the bulk API, and report the cost per entry.
+ *
+ * @param uc ucli context pointer
+ * @param entries Number of entries in the map
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_map(ucli_context_t *uc, int entries) {
+  enum hdr_t { API, ADD, GET, WALK, MAP_RESULTS };
+  enum api_t { API_SINGLE, API_BULK, MAP_APIS };
+  char *result_hdr[] = {"API", "Add", "Get", "Walk"};
+  char *unit_hdr[] = {"[-]", "[ns/op]", "[ns/op]", "[ns/op]"};
+  char *api_name[] = {"single", "bulk"};
+  double results[MAP_APIS][MAP_RESULTS];
+  ucli_status_t status = UCLI_STATUS_OK;
+  /* Pairs returned per bf_map_get_range call. */
+  const int batch = 256;
+
+  banner(uc, "MAP");
+  if (entries <= 0) {
+    aim_printf(&uc->pvs, "Number of entries must be positive\n");
+    return UCLI_STATUS_E_PARAM;
+  }
+
+  /* Every other key is present so that half of the lookups miss, as they do
+   * when replaying a sparse set of entry handles. */
+  unsigned long *keys = bf_sys_calloc(2 * entries, sizeof *keys);
+  void **data = bf_sys_calloc(2 * entries, sizeof *data);
+  bf_map_pair_t *pairs = bf_sys_calloc(batch, sizeof *pairs);
+  if (!keys || !data || !pairs) {
+    aim_printf(&uc->pvs, "%s:%d: Out of memory\n", __func__, __LINE__);
+    status = UCLI_STATUS_E_ERROR;
+    goto done;
+  }
+  for (int i = 0; i < 2 * entries; i++) {
+    keys[i] = i;
+    data[i] = (void *)(uintptr_t)(i + 1);
+  }
+
+  for (int a = 0; a < MAP_APIS; a++) {
+    bf_map_t map;
+    struct timespec start, stop;
+    double op_per_s;
+    unsigned long key;
+    void *val;
+    int hits = 0, walked = 0;
+
+    bf_map_init(&map);
+    results[a][API] = a;
+
+    /* Populate with the odd keys; use the upper half of the key array as
+     * scratch for the sorted run. */
+    unsigned long *odd = keys + entries;
+    void **odd_data = data + entries;
+    for (int i = 0; i < entries; i++) {
+      odd[i] = 2 * i + 1;
+      odd_data[i] = (void *)(uintptr_t)(2 * i + 2);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (a == API_SINGLE) {
+      for (int i = 0; i < entries; i++) bf_map_add(&map, odd[i], odd_data[i]);
+    } else {
+      bf_map_add_sorted(&map, odd, odd_data, entries);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[a][ADD]);
+
+    for (int i = 0; i < 2 * entries; i++) keys[i] = i;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (a == API_SINGLE) {
+      for (int i = 0; i < 2 * entries; i++) {
+        if (bf_map_get(&map, keys[i], &data[i]) == BF_MAP_OK) hits++;
+      }
+    } else {
+      hits = bf_map_get_many(&map, keys, 2 * entries, data);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, 2 * entries, &op_per_s, &results[a][GET]);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (a == API_SINGLE) {
+      for (bf_map_sts_t ms = bf_map_get_first(&map, &key, &val);
+           ms == BF_MAP_OK;
+           ms = bf_map_get_next(&map, &key, &val)) {
+        walked++;
+      }
+    } else {
+      bool done = false;
+      key = 0;
+      while (!done) {
+        int n = bf_map_get_range(&map, &key, -1UL, pairs, batch, &done);
+        if (n < 0) break;
+        walked += n;
+      }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    ts_to_ops(start, stop, entries, &op_per_s, &results[a][WALK]);
+
+    bf_map_destroy(&map);
+    if (hits != entries || walked != entries) {
+      aim_printf(&uc->pvs,
+                 "%s map lost entries, %d found and %d walked of %d\n",
+                 api_name[a],
+                 hits,
+                 walked,
+                 entries);
+      status = UCLI_STATUS_E_ERROR;
+      goto done;
+    }
+  }
+
+  aim_printf(&uc->pvs, "Entries: %d\n", entries);
+  for (int i = 0; i < MAP_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", result_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < MAP_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", unit_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int a = 0; a < MAP_APIS; a++) {
+    aim_printf(&uc->pvs,
+               "%15s %15.2f %15.2f %15.2f\n",
+               api_name[a],
+               results[a][ADD],
+               results[a][GET],
+               results[a][WALK]);
+  }
+  save_results_file(uc,
+                    "perf_sw_map.csv",
+                    MAP_RESULTS,
+                    MAP_APIS,
+                    result_hdr,
+                    unit_hdr,
+                    results);
+
+done:
+  if (keys) bf_sys_free(keys);
+  if (data) bf_sys_free(data);
+  if (pairs) bf_sys_free(pairs);
+  return status;
+}
+
+typedef struct perf_sw_id_thread_t {
+  bf_id_allocator_mt *allocator;
+  int ids;
+  int allocated;
+} perf_sw_id_thread_t;
+
+static void *perf_sw_id_thread(void *arg) {
+  perf_sw_id_thread_t *t = arg;
+  for (int i = 0; i < t->ids; i++) {
+    if (bf_id_allocator_mt_allocate(t->allocator) >= 0) t->allocated++;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Run performance test that will fill a bf_id_allocator, free a random
+ * 1% of the ids and measure allocation at 99% fill, then fill the concurrent
+ * allocator from several threads, and report the cost per id.
+ *
+ * @param uc ucli context pointer
+ * @param ids Number of ids in the allocator
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_id(ucli_context_t *uc, int ids) {
+  enum hdr_t { FILL, ALLOC_99, CONTIG_99, WALK, MT_FILL, ID_RESULTS };
+  char *result_hdr[] = {
+      "Fill", "Alloc at 99%", "Alloc 4 at 99%", "Walk", "MT fill"};
+  char *unit_hdr[] = {"[ns/op]", "[ns/op]", "[ns/op]", "[ns/op]", "[ns/op]"};
+  double results[1][ID_RESULTS];
+  perf_sw_id_thread_t thr[PERF_SW_ID_THREADS];
+  bf_sys_thread_t tid[PERF_SW_ID_THREADS];
+  bf_id_allocator *allocator = NULL;
+  bf_id_allocator_mt *allocator_mt = NULL;
+  struct timespec start, stop;
+  double op_per_s;
+  int holes, cnt, id;
+
+  banner(uc, "ID ALLOCATOR");
+  if (ids < 100) {
+    aim_printf(&uc->pvs, "Number of ids must be at least 100\n");
+    return UCLI_STATUS_E_PARAM;
+  }
+  holes = ids / 100;
+
+  allocator = bf_id_allocator_new(ids, false);
+  if (!allocator) goto oom;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < ids; i++) bf_id_allocator_allocate(allocator);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, ids, &op_per_s, &results[0][FILL]);
+
+  /* Punch random single id holes and allocate them again, every allocation
+   * has to find a free id in a 99% full allocator. */
+  for (cnt = 0; cnt < holes;) {
+    id = 1 + rand() % ids;
+    if (!bf_id_allocator_is_set(allocator, id)) continue;
+    bf_id_allocator_release(allocator, id);
+    cnt++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < holes; i++) bf_id_allocator_allocate(allocator);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, holes, &op_per_s, &results[0][ALLOC_99]);
+
+  /* Same again with aligned holes of four ids, the single id holes left
+   * behind by the release make a first fit search skip over them. */
+  for (cnt = 0; cnt < holes / 4;) {
+    id = 1 + (rand() % (ids / 4)) * 4;
+    if (!bf_id_allocator_is_set(allocator, id)) continue;
+    for (int i = 0; i < 4; i++) bf_id_allocator_release(allocator, id + i);
+    bf_id_allocator_release(allocator, 1 + rand() % ids);
+    cnt++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < holes / 4; i++) {
+    bf_id_allocator_allocate_contiguous(allocator, 4);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, holes / 4, &op_per_s, &results[0][CONTIG_99]);
+
+  cnt = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (id = bf_id_allocator_get_first(allocator); id != -1;
+       id = bf_id_allocator_get_next(allocator, id)) {
+    cnt++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, cnt, &op_per_s, &results[0][WALK]);
+
+  /* Fill the concurrent allocator to 99% from several threads. */
+  allocator_mt = bf_id_allocator_mt_new(ids, false);
+  if (!allocator_mt) goto oom;
+  cnt = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int t = 0; t < PERF_SW_ID_THREADS; t++) {
+    thr[t].allocator = allocator_mt;
+    thr[t].ids = (ids - holes) / PERF_SW_ID_THREADS;
+    thr[t].allocated = 0;
+    bf_sys_thread_create(&tid[t], perf_sw_id_thread, &thr[t], 0);
+  }
+  for (int t = 0; t < PERF_SW_ID_THREADS; t++) {
+    bf_sys_thread_join(tid[t], NULL);
+    cnt += thr[t].allocated;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, cnt, &op_per_s, &results[0][MT_FILL]);
+
+  aim_printf(&uc->pvs, "Ids: %d, threads: %d\n", ids, PERF_SW_ID_THREADS);
+  for (int i = 0; i < ID_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", result_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < ID_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15s ", unit_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < ID_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%15.2f ", results[0][i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  save_results_file(
+      uc, "perf_sw_id.csv", ID_RESULTS, 1, result_hdr, unit_hdr, results);
+
+  bf_id_allocator_destroy(allocator);
+  bf_id_allocator_mt_destroy(allocator_mt);
+  return UCLI_STATUS_OK;
+
+oom:
+  aim_printf(&uc->pvs, "%s:%d: Out of memory\n", __func__, __LINE__);
+  if (allocator) bf_id_allocator_destroy(allocator);
+  return UCLI_STATUS_E_ERROR;
+}
+
+typedef struct perf_sw_timer_obj_t {
+  bf_sys_timer_t timer;
+  uint32_t fired;
+} perf_sw_timer_obj_t;
+
+static void perf_sw_timer_cb(bf_sys_timer_t *timer, void *data) {
+  perf_sw_timer_obj_t *obj = data;
+  obj->fired++;
+  (void)timer;
+}
+
+/**
+ * @brief Run performance test that will start a number of concurrent periodic
+ * bf_sys timers, let them run and report the cost of starting, expiring,
+ * stopping and deleting a timer.
+ *
+ * @param uc ucli context pointer
+ * @param timers Number of timers
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_timer(ucli_context_t *uc, int timers) {
+  enum hdr_t { CREATE, START, FIRED, EXPIRY, STOP, DELETE, TIMER_RESULTS };
+  char *result_hdr[] = {
+      "Create", "Start", "Fired", "Expiry CPU", "Stop", "Delete"};
+  char *unit_hdr[] = {
+      "[ns/op]", "[ns/op]", "[%]", "[ns/op]", "[ns/op]", "[ns/op]"};
+  double results[1][TIMER_RESULTS];
+  struct timespec start, stop, cpu_start, cpu_stop;
+  double op_per_s;
+  uint64_t fired = 0, expected;
+  int created = 0;
+  ucli_status_t status = UCLI_STATUS_OK;
+
+  banner(uc, "TIMER");
+  if (timers <= 0) {
+    aim_printf(&uc->pvs, "Number of timers must be positive\n");
+    return UCLI_STATUS_E_PARAM;
+  }
+
+  perf_sw_timer_obj_t *objs = bf_sys_calloc(timers, sizeof *objs);
+  if (!objs) {
+    aim_printf(&uc->pvs, "%s:%d: Out of memory\n", __func__, __LINE__);
+    return UCLI_STATUS_E_ERROR;
+  }
+
+  /* Spread the first expiry over one period so that every tick has a similar
+   * number of timers to run. */
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (created = 0; created < timers; created++) {
+    if (bf_sys_timer_create(&objs[created].timer,
+                            created % PERF_SW_TIMER_PERIOD_MS,
+                            PERF_SW_TIMER_PERIOD_MS,
+                            perf_sw_timer_cb,
+                            &objs[created]) != BF_SYS_TIMER_OK) {
+      aim_printf(&uc->pvs, "Failed to create timer %d\n", created);
+      status = UCLI_STATUS_E_ERROR;
+      goto done;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, timers, &op_per_s, &results[0][CREATE]);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < timers; i++) {
+    if (bf_sys_timer_start(&objs[i].timer) != BF_SYS_TIMER_OK) {
+      aim_printf(&uc->pvs, "Failed to start timer %d\n", i);
+      status = UCLI_STATUS_E_ERROR;
+      goto done;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, timers, &op_per_s, &results[0][START]);
+
+  /* The timers expire on the timer thread, use the CPU time of the process
+   * while this thread sleeps as the cost of running them. */
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+  bf_sys_usleep(PERF_SW_TIMER_RUN_MS * 1000);
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_stop);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < timers; i++) bf_sys_timer_stop(&objs[i].timer);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, timers, &op_per_s, &results[0][STOP]);
+
+  for (int i = 0; i < timers; i++) fired += objs[i].fired;
+  expected = (uint64_t)timers * PERF_SW_TIMER_RUN_MS / PERF_SW_TIMER_PERIOD_MS;
+  results[0][FIRED] = 100.0 * fired / expected;
+  results[0][EXPIRY] = fired ? ((cpu_stop.tv_sec - cpu_start.tv_sec) * 1e9 +
+                                (cpu_stop.tv_nsec - cpu_start.tv_nsec)) /
+                                   fired
+                             : 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < timers; i++) bf_sys_timer_del(&objs[i].timer);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  ts_to_ops(start, stop, timers, &op_per_s, &results[0][DELETE]);
+  created = 0;
+
+  aim_printf(&uc->pvs,
+             "Timers: %d, period: %d ms, run: %d ms\n",
+             timers,
+             PERF_SW_TIMER_PERIOD_MS,
+             PERF_SW_TIMER_RUN_MS);
+  for (int i = 0; i < TIMER_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%12s ", result_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < TIMER_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%12s ", unit_hdr[i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  for (int i = 0; i < TIMER_RESULTS; i++) {
+    aim_printf(&uc->pvs, "%12.2f ", results[0][i]);
+  }
+  aim_printf(&uc->pvs, "\n");
+  save_results_file(uc,
+                    "perf_sw_timer.csv",
+                    TIMER_RESULTS,
+                    1,
+                    result_hdr,
+                    unit_hdr,
+                    results);
+
+done:
+  for (int i = 0; i < created; i++) bf_sys_timer_del(&objs[i].timer);
+  bf_sys_free(objs);
+  return status;
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*!
+ * @file perf_sw.h
+ * @date
+ *
+ * Performance tests of the software data structures used by the drivers.
+ */
+
+#ifndef _PERF_SW_H
+#define _PERF_SW_H
+
+/* Default number of entries for the hash table test. */
+#define PERF_SW_HASHTBL_ENTRIES 1000000
+/* Default number of entries for the map test. */
+#define PERF_SW_MAP_ENTRIES 1000000
+/* Default number of ids and threads for the id allocator test. */
+#define PERF_SW_ID_ENTRIES (1024 * 1024)
+#define PERF_SW_ID_THREADS 4
+/* Default number of timers, their period and the run time of the timer
+ * test. */
+#define PERF_SW_TIMER_ENTRIES 100000
+#define PERF_SW_TIMER_PERIOD_MS 100
+#define PERF_SW_TIMER_RUN_MS 2000
+
+/**
+ * @brief Run performance test that will insert, look up and remove entries in
+ * a bf_hashtbl using each node mode and the bulk lookup, and report the cost
+ * per operation.
+ *
+ * @param uc ucli context pointer
+ * @param entries Number of entries in the table
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_hashtbl(ucli_context_t *uc, int entries);
+
+/**
+ * @brief Run performance test that will populate, look up and walk a bf_map
+ * one key at a time and with the bulk API, and report the cost per entry.
+ *
+ * @param uc ucli context pointer
+ * @param entries Number of entries in the map
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_map(ucli_context_t *uc, int entries);
+
+/**
+ * @brief Run performance test that will fill a bf_id_allocator, free a random
+ * 1% of the ids and measure allocation at 99% fill, then fill the concurrent
+ * allocator from several threads, and report the cost per id.
+ *
+ * @param uc ucli context pointer
+ * @param ids Number of ids in the allocator
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_id(ucli_context_t *uc, int ids);
+
+/**
+ * @brief Run performance test that will start a number of concurrent periodic
+ * bf_sys timers, let them run and report the cost of starting, expiring,
+ * stopping and deleting a timer.
+ *
+ * @param uc ucli context pointer
+ * @param timers Number of timers
+ * @return ucli_status_t
+ */
+ucli_status_t run_sw_timer(ucli_context_t *uc, int timers);
+
+#endif
@@ -43,6 +43,7 @@
 #include "perf_mem.h"
 #include <perf/perf_int_intf.h>
 #include "perf_int.h"
+#include "perf_sw.h"
 #include "perf_ucli.h"
 
 /**
@@ -359,6 +360,86 @@ static ucli_status_t perf_ucli__sram_dma__(ucli_context_t *uc) {
   return UCLI_STATUS_OK;
 }
 
+/**
+ * @brief Handler for hash table perf testing command
+ *
+ * @param uc ucli context pointer
+ * @return ucli_status_t
+ */
+static ucli_status_t perf_ucli__sw_hashtbl__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(
+      uc, "sw_hashtbl", -1, "test hash table operations [<entries>]");
+  int entries = PERF_SW_HASHTBL_ENTRIES;
+  char *endptr;
+
+  if (uc->pargs->count > 0) {
+    const char *str = uc->pargs->args[0];
+    errno = 0;
+    entries = strtol(str, &endptr, 10);
+    if (errno != 0 || endptr == str) {
+      aim_printf(&uc->pvs, "Incorrect entries parameter format\n");
+      return UCLI_STATUS_E_PARAM;
+    }
+  }
+
+  return run_sw_hashtbl(uc, entries);
+}
+
+static ucli_status_t perf_ucli__sw_map__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(uc, "sw_map", -1, "test map bulk operations [<entries>]");
+  int entries = PERF_SW_MAP_ENTRIES;
+  char *endptr;
+
+  if (uc->pargs->count > 0) {
+    const char *str = uc->pargs->args[0];
+    errno = 0;
+    entries = strtol(str, &endptr, 10);
+    if (errno != 0 || endptr == str) {
+      aim_printf(&uc->pvs, "Incorrect entries parameter format\n");
+      return UCLI_STATUS_E_PARAM;
+    }
+  }
+
+  return run_sw_map(uc, entries);
+}
+
+static ucli_status_t perf_ucli__sw_id__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(uc, "sw_id", -1, "test id allocator at 99% fill [<ids>]");
+  int ids = PERF_SW_ID_ENTRIES;
+  char *endptr;
+
+  if (uc->pargs->count > 0) {
+    const char *str = uc->pargs->args[0];
+    errno = 0;
+    ids = strtol(str, &endptr, 10);
+    if (errno != 0 || endptr == str) {
+      aim_printf(&uc->pvs, "Incorrect ids parameter format\n");
+      return UCLI_STATUS_E_PARAM;
+    }
+  }
+
+  return run_sw_id(uc, ids);
+}
+
+static ucli_status_t perf_ucli__sw_timer__(ucli_context_t *uc) {
+  UCLI_COMMAND_INFO(
+      uc, "sw_timer", -1, "test concurrent periodic timers [<timers>]");
+  int timers = PERF_SW_TIMER_ENTRIES;
+  char *endptr;
+
+  if (uc->pargs->count > 0) {
+    const char *str = uc->pargs->args[0];
+    errno = 0;
+    timers = strtol(str, &endptr, 10);
+    if (errno != 0 || endptr == str) {
+      aim_printf(&uc->pvs, "Incorrect timers parameter format\n");
+      return UCLI_STATUS_E_PARAM;
+    }
+  }
+
+  return run_sw_timer(uc, timers);
+}
+
 /**
  * @brief Array of handlers to ucli functions
  *
@@ -371,6 +452,10 @@ static ucli_command_handler_f perf_ucli_ucli_handlers__[] = {
     perf_ucli__interrupts__,
     perf_ucli__registers_direct__,
     perf_ucli__registers_indirect__,
+    perf_ucli__sw_hashtbl__,
+    perf_ucli__sw_map__,
+    perf_ucli__sw_id__,
+    perf_ucli__sw_timer__,
     NULL};
 
 /**
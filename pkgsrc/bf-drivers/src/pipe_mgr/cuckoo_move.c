@@ -28,28 +28,13 @@
 /* Standard includes */
 #include <stdbool.h>
 #include <math.h>
-
-#define JUDYERROR(CallerFile, CallerLine, JudyFunc, JudyErrno, JudyErrID) \
-  {                                                                       \
-    if ((JudyErrno) != JU_ERRNO_NOMEM) /* ! a malloc() failure */         \
-    {                                                                     \
-      (void)fprintf(stderr,                                               \
-                    "File '%s', line %d: %s(), "                          \
-                    "JU_ERRNO_* == %d, ID == %d\n",                       \
-                    CallerFile,                                           \
-                    CallerLine,                                           \
-                    JudyFunc,                                             \
-                    JudyErrno,                                            \
-                    JudyErrID);                                           \
-    }                                                                     \
-  }
+#include <time.h>
 
 /* Module header files */
 
 #include <pipe_mgr/pipe_mgr_config.h>
 #include <pipe_mgr/pipe_mgr_porting.h>
 #include <pipe_mgr/pipe_mgr_intf.h>
-#include <target-utils/third-party/judy-1.0.5/src/Judy.h>
 /* Local header files */
 #include "pipe_mgr_log.h"
 #include "pipe_mgr_exm_hash.h"
@@ -106,6 +91,7 @@ void cuckoo_move_graph_cleanup(cuckoo_move_graph_t *cuckoo_graph) {
   PIPE_MGR_FREE(cuckoo_graph->bfs_queue.nodes);
   PIPE_MGR_FREE(cuckoo_graph->cache_bfs_queue.nodes);
   PIPE_MGR_FREE(cuckoo_graph->move_list);
+  if (cuckoo_graph->visited) PIPE_MGR_FREE(cuckoo_graph->visited);
   if (cuckoo_graph->dirtied_ent_idx_htbl) {
     while ((map_sts = bf_map_get_first_rmv(&cuckoo_graph->dirtied_ent_idx_htbl,
                                            &key,
@@ -799,15 +785,82 @@ void cuckoo_move_graph_txn_abort(cuckoo_move_graph_t *cuckoo_move_graph) {
   return;
 }
 
+static inline uint64_t cuckoo_search_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/* Starts a new search generation, every entry becomes unvisited. */
+static void cuckoo_search_visit_reset(cuckoo_move_graph_t *cuckoo_graph) {
+  if (++cuckoo_graph->visit_epoch == 0) {
+    /* The epoch wrapped, stale marks could alias it so clear them all. */
+    PIPE_MGR_MEMSET(cuckoo_graph->visited,
+                    0,
+                    cuckoo_graph->num_nodes * sizeof(uint16_t));
+    cuckoo_graph->visit_epoch = 1;
+  }
+}
+
+/* Marks an entry visited, returns true if it already was. */
+static inline bool cuckoo_search_visit(cuckoo_move_graph_t *cuckoo_graph,
+                                       pipe_mat_ent_idx_t edge) {
+  if (cuckoo_graph->visited[edge] == cuckoo_graph->visit_epoch) return true;
+  cuckoo_graph->visited[edge] = cuckoo_graph->visit_epoch;
+  return false;
+}
+
+static void cuckoo_search_stats_update(cuckoo_move_graph_t *cuckoo_graph,
+                                       uint32_t nodes,
+                                       uint64_t ns) {
+  cuckoo_search_stats_t *stats = &cuckoo_graph->search_stats;
+  int bucket = nodes ? 32 - __builtin_clz(nodes) : 0;
+
+  if (bucket >= CUCKOO_SEARCH_HIST_CNT) bucket = CUCKOO_SEARCH_HIST_CNT - 1;
+  stats->searches++;
+  stats->nodes_total += nodes;
+  if (nodes > stats->nodes_max) stats->nodes_max = nodes;
+  stats->ns_total += ns;
+  if (ns > stats->ns_max) stats->ns_max = ns;
+  stats->nodes_hist[bucket]++;
+}
+
+void cuckoo_move_graph_search_budget_set(cuckoo_move_graph_t *cuckoo_graph,
+                                         uint32_t max_nodes,
+                                         uint32_t budget_us) {
+  if (cuckoo_graph == NULL) {
+    return;
+  }
+  cuckoo_graph->search_max_nodes = max_nodes;
+  cuckoo_graph->search_budget_ns =
+      budget_us > UINT32_MAX / 1000 ? UINT32_MAX : budget_us * 1000;
+}
+
+void cuckoo_move_graph_search_stats_clear(cuckoo_move_graph_t *cuckoo_graph) {
+  if (cuckoo_graph == NULL) {
+    return;
+  }
+  PIPE_MGR_MEMSET(
+      &cuckoo_graph->search_stats, 0, sizeof(cuckoo_graph->search_stats));
+}
+
+/* Breadth first search for the shortest chain of moves ending in a free
+ * entry.  Entries are tested for being free as they are queued rather than
+ * when they are expanded, so the search stops as soon as the last level that
+ * is needed has been generated instead of after queueing the level below it.
+ * The search gives up once it has queued search_max_nodes entries or, if a
+ * time budget is set, spent search_budget_ns, keeping the worst case insert
+ * latency bounded close to capacity.
+ */
 pipe_status_t cuckoo_move_bfs(cuckoo_move_graph_t *cuckoo_graph,
                               cuckoo_move_list_t **move_list,
                               pipe_mgr_exm_edge_container_t *edge_container) {
-  Pvoid_t visited_PJ1Array = NULL;
   bool path_found = false;
+  bool budget_hit = false;
   uint32_t i, j = 0;
   uint32_t curr_depth = 0;
-  // Word_t   Rc_word         = 0;
-  int Rc_int = 0;
+  uint32_t max_nodes;
+  uint64_t start_ns = 0, deadline_ns = 0;
   cuckoo_bfs_queue_node_t *elem = NULL;
   cuckoo_bfs_queue_t *queue = &cuckoo_graph->bfs_queue;
   cuckoo_bfs_queue_t *cache_queue = &cuckoo_graph->cache_bfs_queue;
@@ -828,63 +881,51 @@ pipe_status_t cuckoo_move_bfs(cuckoo_move_graph_t *cuckoo_graph,
       cuckoo_graph->move_list->src_entry = PIPE_MAT_ENT_INVALID_ENTRY_INDEX;
       cuckoo_graph->move_list->dst_entry = edge_container->entries[i];
       *move_list = cuckoo_graph->move_list;
+      cuckoo_search_stats_update(cuckoo_graph, 0, 0);
       return PIPE_SUCCESS;
     }
   }
 
+  start_ns = cuckoo_search_now_ns();
+  if (cuckoo_graph->search_budget_ns) {
+    deadline_ns = start_ns + cuckoo_graph->search_budget_ns;
+  }
+  max_nodes = queue->len;
+  if (cuckoo_graph->search_max_nodes &&
+      cuckoo_graph->search_max_nodes < max_nodes) {
+    max_nodes = cuckoo_graph->search_max_nodes;
+  }
+
+  cuckoo_search_visit_reset(cuckoo_graph);
   for (i = 0; i < edge_container->num_entries; i++) {
     QUEUE_ELEM(queue, edge_container->entries[i], 0, -1, -1);
-
-    J1S(Rc_int, visited_PJ1Array, edge_container->entries[i]);
+    cuckoo_search_visit(cuckoo_graph, edge_container->entries[i]);
   }
 
-  while (QUEUE_NOT_EMPTY(queue)) {
-    DEQUEUE_ELEM(queue, elem);
-    QUEUE_EMPTY(cache_queue);
-
-    while (elem) {
-      curr_edge = elem->edge_idx;
-
-      curr_depth = elem->depth;
-
-      if (cuckoo_graph_edge_is_occupied(cuckoo_graph, curr_edge) == false) {
-        /* Found the empty node */
-        /* Build the path from the root node */
-
-        cuckoo_construct_bfs_path(
-            cuckoo_graph, move_list, queue, curr_edge, (queue->head) - 1);
-        path_found = true;
-        break;
-      }
-
-      if (QUEUE_FULL(cache_queue)) {
-        break;
-      } else {
-        QUEUE_ELEM(cache_queue, curr_edge, 0, -1, QUEUE_HEAD(queue) - 1);
-      }
-
-      if (QUEUE_NOT_EMPTY(queue)) {
-        DEQUEUE_ELEM(queue, elem);
-      } else {
-        elem = NULL;
-      }
-    }
-
-    if (path_found == true) {
-      break;
-    }
-
+  /* Expand the search one level at a time, the current level is moved to the
+   * cache queue and its children are added to the queue. */
+  while (QUEUE_NOT_EMPTY(queue) && !path_found && !budget_hit) {
     if (curr_depth + 1 > CUCKOO_MAX_NUM_MOVES) {
-      path_found = false;
       break;
     }
 
-    DEQUEUE_ELEM(cache_queue, elem)
+    QUEUE_EMPTY(cache_queue);
+    while (QUEUE_NOT_EMPTY(queue)) {
+      DEQUEUE_ELEM(queue, elem);
+      QUEUE_ELEM(cache_queue, elem->edge_idx, 0, -1, QUEUE_HEAD(queue) - 1);
+    }
 
-    while (elem) {
+    while (QUEUE_NOT_EMPTY(cache_queue) && !path_found && !budget_hit) {
+      DEQUEUE_ELEM(cache_queue, elem);
       curr_edge = elem->edge_idx;
 
-      for (i = 0; i < cuckoo_graph->num_entries_in_a_node; i++) {
+      if (deadline_ns && (cache_queue->head & 63) == 0 &&
+          cuckoo_search_now_ns() > deadline_ns) {
+        budget_hit = true;
+        break;
+      }
+
+      for (i = 0; i < cuckoo_graph->num_entries_in_a_node && !path_found; i++) {
         curr_node =
             cuckoo_move_graph_get_node_data(cuckoo_graph, curr_edge + i);
         if (!curr_node) {
@@ -900,43 +941,41 @@ pipe_status_t cuckoo_move_bfs(cuckoo_move_graph_t *cuckoo_graph,
             continue;
           }
 
-          J1T(Rc_int, visited_PJ1Array, this_edge);
-
-          if (Rc_int == 1) {
+          if (cuckoo_search_visit(cuckoo_graph, this_edge)) {
             continue;
-          } else if (Rc_int == 0) {
-            J1S(Rc_int, visited_PJ1Array, this_edge);
           }
 
-          /* If the queue is full, we want to try and find an empty node in the
-             already queued nodes. This gives better results compared to the
-             approach where we terminate the search on a queue full.
-          */
-          if (QUEUE_FULL(queue)) {
+          if (queue->tail >= max_nodes) {
+            budget_hit = true;
+            break;
+          }
+          QUEUE_ELEM(queue,
+                     this_edge,
+                     curr_depth + 1,
+                     curr_edge + i,
+                     elem->parent_pos);
+
+          if (cuckoo_graph_edge_is_occupied(cuckoo_graph, this_edge) ==
+              false) {
+            /* Found the empty node */
+            /* Build the path from the root node */
+            cuckoo_construct_bfs_path(
+                cuckoo_graph, move_list, queue, this_edge, queue->tail - 1);
+            path_found = true;
             break;
-          } else {
-            QUEUE_ELEM(queue,
-                       curr_node->fwd_edges[j],
-                       curr_depth + 1,
-                       curr_edge + i,
-                       elem->parent_pos);
           }
         }
-      }
-      if (QUEUE_NOT_EMPTY(cache_queue)) {
-        DEQUEUE_ELEM(cache_queue, elem);
-      } else {
-        elem = NULL;
+        if (budget_hit) break;
       }
     }
+    curr_depth++;
   }
 
-  if (visited_PJ1Array) {
-    Word_t bytes_freed;
-    J1FA(bytes_freed, visited_PJ1Array);
-    (void)bytes_freed;
-  }
+  cuckoo_search_stats_update(
+      cuckoo_graph, queue->tail, cuckoo_search_now_ns() - start_ns);
   if (path_found != true) {
+    cuckoo_graph->search_stats.no_space++;
+    if (budget_hit) cuckoo_graph->search_stats.budget_exhausted++;
     return PIPE_NO_SPACE;
   }
   return PIPE_SUCCESS;
@@ -54,7 +54,11 @@ extern "C" {
  * of the pipe_mgr which is built at boot-up time.
  */
 #define CUCKOO_STASH_CAPACITY 8
+/* Upper bound on the BFS queue; a graph never queues more entries than it
+ * has, so smaller tables get shorter queues. */
 #define PIPE_MGR_BFS_QUEUE_LEN 50000
+/* Number of log2 buckets in the nodes-visited histogram of the move search */
+#define CUCKOO_SEARCH_HIST_CNT 17
 
 #define QUEUE_ELEM(                                                 \
     __queue__, __edge_idx__, __depth__, __parent__, __parent_pos__) \
@@ -78,7 +82,7 @@ extern "C" {
 #define QUEUE_GET(__queue__, __pos__, __elem__) \
   __elem__ = &__queue__->nodes[__pos__];
 
-#define QUEUE_FULL(__queue__) (__queue__->tail >= PIPE_MGR_BFS_QUEUE_LEN)
+#define QUEUE_FULL(__queue__) (__queue__->tail >= __queue__->len)
 
 typedef struct cuckoo_bfs_queue_node_ {
   uint32_t depth;
@@ -91,6 +95,7 @@ typedef struct cuckoo_bfs_queue_node_ {
 typedef struct cuckoo_bfs_queue_ {
   uint32_t head;
   uint32_t tail;
+  uint32_t len; /*!< Number of elements allocated in nodes */
   cuckoo_bfs_queue_node_t *nodes;
 
 } cuckoo_bfs_queue_t;
@@ -131,6 +136,19 @@ typedef struct cuckoo_move_graph_edge_ {
 
 } cuckoo_move_graph_edge_t;
 
+/* Statistics of the move search run for each new entry */
+typedef struct cuckoo_search_stats_ {
+  uint64_t searches;         /*!< Number of searches run */
+  uint64_t no_space;         /*!< Searches which found no free entry */
+  uint64_t budget_exhausted; /*!< Searches cut short by the search budget */
+  uint64_t nodes_total;      /*!< Entries visited over all searches */
+  uint32_t nodes_max;        /*!< Most entries visited by a single search */
+  uint64_t ns_total;         /*!< Time spent in searches needing a move */
+  uint64_t ns_max;           /*!< Longest search needing a move */
+  /*!< Searches by entries visited, bucket i counts [2^(i-1), 2^i) */
+  uint32_t nodes_hist[CUCKOO_SEARCH_HIST_CNT];
+} cuckoo_search_stats_t;
+
 typedef struct cukoo_move_graph {
   uint32_t num_nodes; /*!< Number of nodes in the graph */
   cuckoo_move_graph_node_t
@@ -146,6 +164,15 @@ typedef struct cukoo_move_graph {
   cuckoo_bfs_queue_t cache_bfs_queue;
   cuckoo_move_list_t *move_list;
   bf_map_t dirtied_ent_idx_htbl;
+
+  /* Visited marks of the move search, an entry is visited when its mark
+   * equals the epoch of the current search.  Reused across searches so that
+   * starting a search costs nothing but an epoch increment. */
+  uint16_t *visited;
+  uint16_t visit_epoch;
+  uint32_t search_max_nodes; /*!< Entries a search may visit, 0 for queue len */
+  uint32_t search_budget_ns; /*!< Time a search may take, 0 for no limit */
+  cuckoo_search_stats_t search_stats;
 } cuckoo_move_graph_t;
 
 /* cuckoo_program_new_entry : Handles a request to program a
@@ -211,6 +238,16 @@ pipe_status_t cuckoo_compute_move_list(
 
 void cuckoo_move_graph_cleanup(cuckoo_move_graph_t *cuckoo_graph);
 
+/* cuckoo_move_graph_search_budget_set : Limit the number of entries visited
+ * and the time spent by the move search for a new entry.  A search which
+ * hits either limit fails with PIPE_NO_SPACE.  Zero removes the limit.
+ */
+void cuckoo_move_graph_search_budget_set(cuckoo_move_graph_t *cuckoo_graph,
+                                         uint32_t max_nodes,
+                                         uint32_t budget_us);
+
+void cuckoo_move_graph_search_stats_clear(cuckoo_move_graph_t *cuckoo_graph);
+
 void cuckoo_move_graph_node_cleanup(
     cuckoo_move_graph_node_t *cuckoo_graph_node);
 
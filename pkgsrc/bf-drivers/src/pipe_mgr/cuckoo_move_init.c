@@ -93,10 +93,24 @@ pipe_status_t cuckoo_move_graph_init(uint32_t num_entries,
 
   // num_elems_in_bfs = num_entries_per_wide_word*num_hash_ways;
 
+  /* Each entry is queued at most once per search, after the candidates of
+   * the new entry which may repeat. */
+  uint32_t queue_len = num_entries + num_hash_ways * num_entries_per_wide_word;
+  if (queue_len > PIPE_MGR_BFS_QUEUE_LEN) queue_len = PIPE_MGR_BFS_QUEUE_LEN;
+  cuckoo_move_graph->bfs_queue.len = queue_len;
   cuckoo_move_graph->bfs_queue.nodes =
-      PIPE_MGR_CALLOC(PIPE_MGR_BFS_QUEUE_LEN, sizeof(cuckoo_bfs_queue_node_t));
+      PIPE_MGR_CALLOC(queue_len, sizeof(cuckoo_bfs_queue_node_t));
+  cuckoo_move_graph->cache_bfs_queue.len = queue_len;
   cuckoo_move_graph->cache_bfs_queue.nodes =
-      PIPE_MGR_CALLOC(PIPE_MGR_BFS_QUEUE_LEN, sizeof(cuckoo_bfs_queue_node_t));
+      PIPE_MGR_CALLOC(queue_len, sizeof(cuckoo_bfs_queue_node_t));
+  cuckoo_move_graph->visited = PIPE_MGR_CALLOC(num_entries, sizeof(uint16_t));
+  if (cuckoo_move_graph->bfs_queue.nodes == NULL ||
+      cuckoo_move_graph->cache_bfs_queue.nodes == NULL ||
+      cuckoo_move_graph->visited == NULL) {
+    LOG_ERROR(
+        "%s: Could not allocate memory for the cuckoo move search", __func__);
+    return PIPE_NO_SYS_RESOURCES;
+  }
 
   cuckoo_move_graph->move_list =
       PIPE_MGR_CALLOC(CUCKOO_MAX_NUM_MOVES + 1, sizeof(cuckoo_move_list_t));
@@ -25,6 +25,8 @@
 
 /* Local header files */
 #include "pipe_mgr_alpm.h"
+#include "pipe_mgr_alpm_bulk.h"
+#include "pipe_mgr_test_rand.h"
 #include "pipe_mgr_tcam.h"
 #include "pipe_mgr_tcam_hw.h"
 #include "pipe_mgr_tcam_ha.h"
@@ -37,6 +39,7 @@
 
 /* Global header files */
 #include <math.h>
+#include <time.h>
 #include <netinet/in.h>
 static alpm_mgr_ctx_t alpm_ctx;
 static alpm_mgr_ctx_t *alpm_ctx_p;
@@ -241,6 +244,28 @@ static void backup_node(alpm_pipe_tbl_t *pipe_tbl, trie_node_t *node) {
   pipe_tbl->backup_node_list = backup;
 }
 
+/*
+ * Usage: backup_node_count(pipe_tbl, node)
+ * ----------------------------------------
+ * Saves only the count of the given node. Used on the ancestors walked by
+ * count updates, where copying the whole node with its entry and covering
+ * prefix data would be wasted. A node already fully backed up is skipped.
+ */
+static void backup_node_count(alpm_pipe_tbl_t *pipe_tbl, trie_node_t *node) {
+  if (!ALPM_SESS_IS_TXN(pipe_tbl) || !node || node->backed_up ||
+      node->count_backed_up) {
+    return;
+  }
+  node->count_backed_up = true;
+
+  backup_count_t *backup = PIPE_MGR_MALLOC(sizeof(backup_count_t));
+  backup->node = node;
+  backup->count = node->count;
+
+  backup->next = pipe_tbl->backup_count_list;
+  pipe_tbl->backup_count_list = backup;
+}
+
 static void backup_ptn(alpm_pipe_tbl_t *pipe_tbl, partition_info_t *p_info) {
   if (!ALPM_SESS_IS_TXN(pipe_tbl) || !p_info || p_info->backed_up) {
     return;
@@ -1746,12 +1771,12 @@ static void update_counts(alpm_pipe_tbl_t *pipe_tbl,
   trie_node_t *curr = node;
 
   while (!curr->subtree) {
-    backup_node(pipe_tbl, curr);
+    backup_node_count(pipe_tbl, curr);
     curr->count += (is_add) ? 1 : -1;
     curr = curr->parent;
   }
 
-  backup_node(pipe_tbl, curr);
+  backup_node_count(pipe_tbl, curr);
   curr->count += (is_add) ? 1 : -1;
 }
 
@@ -2095,10 +2120,10 @@ static trie_subtree_t *cut_trie(alpm_pipe_tbl_t *pipe_tbl,
   /* Update the counts */
   for (parent = curr->parent; parent != subtree->node;
        parent = parent->parent) {
-    backup_node(pipe_tbl, parent);
+    backup_node_count(pipe_tbl, parent);
     parent->count -= curr->count;
   }
-  backup_node(pipe_tbl, parent);
+  backup_node_count(pipe_tbl, parent);
   parent->count -= curr->count;
 
   /* Creates the new subtree and adds its covering prefix if needed */
@@ -4730,6 +4755,682 @@ pipe_status_t pipe_mgr_alpm_entry_place_with_hdl(
   return sts;
 }
 
+/******************************************************
+ *                 ALPM Bulk Load Fns                 *
+ ******************************************************/
+
+/*
+ * Usage: alpm_bulk_build(pipe_tbl, num_entries, ..., nodes, &num_built)
+ * ---------------------------------------------------------------------
+ * Adds the given entries to the trie without creating any subtree or
+ * touching partitions and hardware. The node holding each entry is returned
+ * in nodes, and the number of entries added in num_built.
+ */
+static pipe_status_t alpm_bulk_build(alpm_pipe_tbl_t *pipe_tbl,
+                                     uint32_t num_entries,
+                                     pipe_tbl_match_spec_t **match_spec,
+                                     pipe_act_fn_hdl_t *act_fn_hdl,
+                                     pipe_action_spec_t **act_spec,
+                                     uint32_t *ttl,
+                                     trie_node_t **nodes,
+                                     uint32_t *num_built) {
+  alpm_tbl_info_t *tbl_info = pipe_tbl->alpm_tbl_info;
+  alpm_entry_t *entry;
+  trie_node_t *node;
+  uint32_t i;
+
+  *num_built = 0;
+  for (i = 0; i < num_entries; i++) {
+    node = find_node(pipe_tbl, match_spec[i], false, NULL, NULL, NULL);
+    if (!node) {
+      LOG_ERROR("%s:%d Invalid match spec for ALPM table 0x%x entry add",
+                __func__,
+                __LINE__,
+                tbl_info->alpm_tbl_hdl);
+      return PIPE_INVALID_ARG;
+    }
+    if (node->entry) {
+      return PIPE_ALREADY_EXISTS;
+    }
+
+    entry = (alpm_entry_t *)PIPE_MGR_CALLOC(1, sizeof(alpm_entry_t));
+    if (!entry) {
+      LOG_ERROR("%s:%d %s(0x%x) Entry malloc failed",
+                __func__,
+                __LINE__,
+                tbl_info->name,
+                tbl_info->alpm_tbl_hdl);
+      return PIPE_NO_SYS_RESOURCES;
+    }
+    entry->act_fn_hdl = act_fn_hdl[i];
+    entry->ttl = ttl ? ttl[i] : 0;
+    entry->match_spec = pipe_mgr_tbl_copy_match_spec(NULL, match_spec[i]);
+    entry->act_spec = pipe_mgr_tbl_copy_action_spec(NULL, act_spec[i]);
+    if (!entry->match_spec || !entry->act_spec) {
+      free_entry(entry);
+      return PIPE_NO_SYS_RESOURCES;
+    }
+    entry->match_spec->partition_index = 0;
+    entry->alpm_entry_hdl = pipe_mgr_alpm_allocate_handle(pipe_tbl);
+    if (entry->alpm_entry_hdl == PIPE_ALPM_INVALID_ENT_HDL) {
+      free_entry(entry);
+      return PIPE_NO_SPACE;
+    }
+
+    node->entry = entry;
+    nodes[i] = node;
+    (*num_built)++;
+  }
+
+  return PIPE_SUCCESS;
+}
+
+static void alpm_bulk_clear_counts(trie_node_t *node) {
+  if (!node) {
+    return;
+  }
+  node->count = 0;
+  alpm_bulk_clear_counts(node->left_child);
+  alpm_bulk_clear_counts(node->right_child);
+}
+
+/*
+ * Usage: alpm_bulk_unbuild(pipe_tbl, nodes, num_built)
+ * ----------------------------------------------------
+ * Takes back the entries added by alpm_bulk_build and resets the counts set
+ * by the carving. Only valid while the table held no other entry.
+ */
+static void alpm_bulk_unbuild(alpm_pipe_tbl_t *pipe_tbl,
+                              trie_node_t **nodes,
+                              uint32_t num_built) {
+  uint32_t i;
+
+  for (i = 0; i < num_built; i++) {
+    bf_id_allocator_release(
+        pipe_tbl->ent_hdl_allocator,
+        PIPE_GET_HDL_VAL(nodes[i]->entry->alpm_entry_hdl));
+    free_entry(nodes[i]->entry);
+    nodes[i]->entry = NULL;
+  }
+  alpm_bulk_clear_counts(pipe_tbl->root);
+}
+
+static int alpm_bulk_subtree_depth_cmp(const void *a, const void *b) {
+  const alpm_bulk_subtree_t *s1 = a;
+  const alpm_bulk_subtree_t *s2 = b;
+
+  if (s1->node->depth != s2->node->depth) {
+    return s1->node->depth > s2->node->depth ? -1 : 1;
+  }
+  return 0;
+}
+
+static int alpm_bulk_entry_cmp(const void *a, const void *b) {
+  const trie_node_t *n1 = *(trie_node_t *const *)a;
+  const trie_node_t *n2 = *(trie_node_t *const *)b;
+
+  if (n1->entry->match_spec->priority != n2->entry->match_spec->priority) {
+    return n1->entry->match_spec->priority < n2->entry->match_spec->priority
+               ? -1
+               : 1;
+  }
+  return 0;
+}
+
+/*
+ * Usage: alpm_bulk_pack(pipe_tbl, subtrees, num_subtrees, &num_bins)
+ * ------------------------------------------------------------------
+ * Assigns the subtrees to free partitions without changing any partition
+ * state. The bin of a subtree is the position of its partition on the free
+ * list.
+ */
+static pipe_status_t alpm_bulk_pack(alpm_pipe_tbl_t *pipe_tbl,
+                                    alpm_bulk_subtree_t *subtrees,
+                                    uint32_t num_subtrees,
+                                    uint32_t *num_bins_p) {
+  alpm_tbl_info_t *tbl_info = pipe_tbl->alpm_tbl_info;
+  partition_info_t *p_info;
+  uint32_t *bin_depth = NULL;
+  uint32_t num_free = 0, b = 0;
+  pipe_status_t sts;
+
+  for (p_info = pipe_tbl->ptn_free_list; p_info; p_info = p_info->next) {
+    num_free++;
+  }
+  if (num_free == 0) {
+    return PIPE_NO_SPACE;
+  }
+  bin_depth = PIPE_MGR_MALLOC(num_free * sizeof(uint32_t));
+  if (!bin_depth) {
+    return PIPE_NO_SYS_RESOURCES;
+  }
+  for (p_info = pipe_tbl->ptn_free_list; p_info; p_info = p_info->next) {
+    bin_depth[b++] = get_partition_depth(tbl_info, p_info);
+  }
+
+  sts = pipe_mgr_alpm_bulk_pack(bin_depth,
+                                num_free,
+                                tbl_info->max_subtrees_per_partition,
+                                subtrees,
+                                num_subtrees,
+                                num_bins_p);
+  if (sts == PIPE_NO_SPACE) {
+    LOG_ERROR("%s:%d %s(0x%x) Not enough partitions for %d subtrees",
+              __func__,
+              __LINE__,
+              tbl_info->name,
+              tbl_info->alpm_tbl_hdl,
+              num_subtrees);
+  }
+  PIPE_MGR_FREE(bin_depth);
+  return sts;
+}
+
+/*
+ * Usage: alpm_bulk_attach(pipe_tbl, subtrees, num_subtrees, num_bins)
+ * -------------------------------------------------------------------
+ * Takes the packed partitions off the free list and creates the subtree
+ * roots in them, along with their covering prefixes.
+ */
+static pipe_status_t alpm_bulk_attach(alpm_pipe_tbl_t *pipe_tbl,
+                                      alpm_bulk_subtree_t *subtrees,
+                                      uint32_t num_subtrees,
+                                      uint32_t num_bins) {
+  partition_info_t **bins;
+  partition_info_t *p_info;
+  uint32_t i;
+
+  bins = PIPE_MGR_MALLOC(num_bins * sizeof(partition_info_t *));
+  if (!bins) {
+    return PIPE_NO_SYS_RESOURCES;
+  }
+  for (i = 0; i < num_bins; i++) {
+    bins[i] = create_partition_info(pipe_tbl, NULL);
+  }
+  for (i = 0; i < num_subtrees; i++) {
+    p_info = bins[subtrees[i].bin];
+    create_subtree(pipe_tbl, subtrees[i].node, p_info);
+    p_info->subtree_nodes[p_info->num_subtrees] = subtrees[i].node;
+    p_info->num_subtrees++;
+  }
+  PIPE_MGR_FREE(bins);
+
+  return PIPE_SUCCESS;
+}
+
+/*
+ * Usage: alpm_bulk_collect(node, entry_nodes, &num_entries)
+ * ---------------------------------------------------------
+ * Collects the nodes with entries in the subtree rooted at the given node.
+ */
+static void alpm_bulk_collect(trie_node_t *node,
+                              trie_node_t **entry_nodes,
+                              uint32_t *num_entries) {
+  if (node->entry) {
+    entry_nodes[(*num_entries)++] = node;
+  }
+  if (node->left_child && !node->left_child->subtree &&
+      node->left_child->count) {
+    alpm_bulk_collect(node->left_child, entry_nodes, num_entries);
+  }
+  if (node->right_child && !node->right_child->subtree &&
+      node->right_child->count) {
+    alpm_bulk_collect(node->right_child, entry_nodes, num_entries);
+  }
+}
+
+/*
+ * Usage: alpm_bulk_program(pipe_tbl, subtrees, num_subtrees, head, tail)
+ * ----------------------------------------------------------------------
+ * Programs the entries of every subtree into its partition, most specific
+ * prefix first so the partitions fill without moves. The preclassifier
+ * entries then go in deepest subtree first for the same reason.
+ */
+static pipe_status_t alpm_bulk_program(alpm_pipe_tbl_t *pipe_tbl,
+                                       alpm_bulk_subtree_t *subtrees,
+                                       uint32_t num_subtrees,
+                                       pipe_mgr_move_list_t **move_head_p,
+                                       pipe_mgr_move_list_t **move_tail_p) {
+  pipe_status_t sts = PIPE_SUCCESS;
+  bf_map_sts_t msts;
+  alpm_tbl_info_t *tbl_info = pipe_tbl->alpm_tbl_info;
+  trie_subtree_t *subtree;
+  partition_info_t *p_info;
+  alpm_entry_t *entry;
+  trie_node_t **entry_nodes;
+  pipe_mgr_move_list_t *move_list;
+  uint32_t num_entries, i, j;
+
+  entry_nodes =
+      PIPE_MGR_MALLOC(tbl_info->partition_depth * sizeof(trie_node_t *));
+  if (!entry_nodes) {
+    return PIPE_NO_SYS_RESOURCES;
+  }
+
+  for (i = 0; i < num_subtrees; i++) {
+    subtree = subtrees[i].node->subtree;
+    p_info = subtree->partition;
+
+    num_entries = 0;
+    alpm_bulk_collect(subtree->node, entry_nodes, &num_entries);
+    PIPE_MGR_DBGCHK(num_entries == subtree->node->count);
+    qsort(entry_nodes, num_entries, sizeof(trie_node_t *), alpm_bulk_entry_cmp);
+
+    for (j = 0; j < num_entries; j++) {
+      entry = entry_nodes[j]->entry;
+      entry->match_spec->partition_index = p_info->ptn_index;
+      entry->match_spec->version_bits = 0;
+      move_list = NULL;
+      sts = pipe_mgr_alpm_atcam_entry_place(
+          tbl_info, pipe_tbl, entry, subtree, false, &move_list);
+      set_move_list(move_head_p, move_tail_p, move_list);
+      if (sts != PIPE_SUCCESS) {
+        LOG_ERROR("%s:%d %s(%d - 0x%x) Error adding alpm entry sts %d",
+                  __func__,
+                  __LINE__,
+                  tbl_info->name,
+                  pipe_tbl->dev_tgt.device_id,
+                  tbl_info->alpm_tbl_hdl,
+                  sts);
+        goto done;
+      }
+      p_info->size++;
+      build_alpm_move_list_hdr(pipe_tbl,
+                               PIPE_MAT_UPDATE_ADD,
+                               tbl_info->atcam_tbl_hdl,
+                               move_list,
+                               entry->sram_entry_hdl,
+                               entry->alpm_entry_hdl,
+                               false);
+      msts = bf_map_add(&pipe_tbl->alpm_entry_hdl_map,
+                        entry->alpm_entry_hdl,
+                        (void *)entry_nodes[j]);
+      if (msts != BF_MAP_OK) {
+        LOG_ERROR("%s:%d %s(%d - 0x%x) Error adding alpm entry to map sts %d",
+                  __func__,
+                  __LINE__,
+                  tbl_info->name,
+                  pipe_tbl->dev_tgt.device_id,
+                  tbl_info->alpm_tbl_hdl,
+                  msts);
+        sts = PIPE_NO_SYS_RESOURCES;
+        goto done;
+      }
+    }
+  }
+
+  /* Covering prefixes and preclassifier entries */
+  qsort(subtrees,
+        num_subtrees,
+        sizeof(alpm_bulk_subtree_t),
+        alpm_bulk_subtree_depth_cmp);
+  for (i = 0; i < num_subtrees; i++) {
+    sts = setup_root(
+        pipe_tbl, subtrees[i].node->subtree, move_head_p, move_tail_p);
+    if (sts != PIPE_SUCCESS) {
+      LOG_ERROR("%s:%d Failed to setup the preclassifier for alpm tbl 0x%x",
+                __func__,
+                __LINE__,
+                tbl_info->alpm_tbl_hdl);
+      goto done;
+    }
+  }
+
+done:
+  PIPE_MGR_FREE(entry_nodes);
+  return sts;
+}
+
+/*
+ * Usage: alpm_bulk_detach(pipe_tbl, subtrees, num_subtrees, nodes, num_built)
+ * ---------------------------------------------------------------------------
+ * Takes back alpm_bulk_attach and whatever alpm_bulk_program placed before
+ * failing: the entries, covering prefixes and preclassifier entries are
+ * deleted, the subtree roots dropped and the partitions returned to the free
+ * list. The operations are only in the move list of the load, which the
+ * caller frees without processing. Only valid while the table held no other
+ * entry.
+ */
+static void alpm_bulk_detach(alpm_pipe_tbl_t *pipe_tbl,
+                             alpm_bulk_subtree_t *subtrees,
+                             uint32_t num_subtrees,
+                             trie_node_t **nodes,
+                             uint32_t num_built) {
+  alpm_tbl_info_t *tbl_info = pipe_tbl->alpm_tbl_info;
+  pipe_mgr_move_list_t *move_list;
+  partition_info_t *p_info;
+  trie_subtree_t *subtree;
+  alpm_entry_t *entry;
+  uint32_t i, id;
+
+  for (i = 0; i < num_built; i++) {
+    entry = nodes[i]->entry;
+    bf_map_rmv(&pipe_tbl->alpm_entry_hdl_map, entry->alpm_entry_hdl);
+    if (entry->sram_entry_hdl) {
+      move_list = NULL;
+      pipe_mgr_tcam_entry_del(tbl_info->dev_id,
+                              tbl_info->atcam_tbl_hdl,
+                              entry->sram_entry_hdl,
+                              pipe_tbl->sess_flags,
+                              &move_list);
+      free_move_list_and_data(&move_list, true);
+      entry->sram_entry_hdl = 0;
+    }
+  }
+
+  for (i = 0; i < num_subtrees; i++) {
+    subtree = subtrees[i].node->subtree;
+    if (!subtree) {
+      continue;
+    }
+    if (subtree->cov_pfx_entry && subtree->cov_pfx_entry->sram_entry_hdl) {
+      move_list = NULL;
+      pipe_mgr_tcam_entry_del(tbl_info->dev_id,
+                              tbl_info->atcam_tbl_hdl,
+                              subtree->cov_pfx_entry->sram_entry_hdl,
+                              pipe_tbl->sess_flags,
+                              &move_list);
+      free_move_list_and_data(&move_list, true);
+    }
+    if (subtree->tcam_entry_hdl) {
+      move_list = NULL;
+      pipe_mgr_tcam_entry_del(tbl_info->dev_id,
+                              tbl_info->preclass_tbl_hdl,
+                              subtree->tcam_entry_hdl,
+                              pipe_tbl->sess_flags,
+                              &move_list);
+      free_move_list_and_data(&move_list, true);
+    }
+    if (subtree->cov_pfx) {
+      remove_subtree_from_cp_list(pipe_tbl, subtree->cov_pfx, subtree);
+    }
+    remove_subtree(pipe_tbl, subtree);
+    subtrees[i].node->subtree = NULL;
+    free_subtree(subtree);
+  }
+
+  /* Every partition in use was taken by the load */
+  while ((p_info = pipe_tbl->ptn_in_use_list)) {
+    if (p_info->subtree_id_allocator) {
+      for (id = 0; id < tbl_info->max_subtrees_per_partition; id++) {
+        bf_id_allocator_release(p_info->subtree_id_allocator, id);
+      }
+    }
+    p_info->size = 0;
+    remove_partition_info(pipe_tbl, p_info);
+  }
+}
+
+/*
+ * Usage: alpm_bulk_carve_trie(pipe_tbl, subtrees, &num_subtrees, &num_bins)
+ * -------------------------------------------------------------------------
+ * Carves the whole trie into subtrees and packs them into partitions. Every
+ * subtree leaves one slot of the partition depth free, so any of them fits
+ * partition 0.
+ */
+static pipe_status_t alpm_bulk_carve_trie(alpm_pipe_tbl_t *pipe_tbl,
+                                          alpm_bulk_subtree_t *subtrees,
+                                          uint32_t *num_subtrees,
+                                          uint32_t *num_bins) {
+  alpm_tbl_info_t *tbl_info = pipe_tbl->alpm_tbl_info;
+  trie_node_t *root = pipe_tbl->root;
+
+  *num_subtrees = 0;
+  if (pipe_mgr_alpm_bulk_carve(root,
+                               false,
+                               tbl_info->partition_depth - 1,
+                               subtrees,
+                               num_subtrees)) {
+    subtrees[*num_subtrees].node = root;
+    subtrees[*num_subtrees].size = root->count;
+    (*num_subtrees)++;
+  }
+
+  return alpm_bulk_pack(pipe_tbl, subtrees, *num_subtrees, num_bins);
+}
+
+/*
+ * Usage: alpm_bulk_load(tbl_info, pipe_tbl, ...)
+ * ----------------------------------------------
+ * Loads a batch of entries into an empty table. The trie is built offline,
+ * carved and packed, and all space is checked before any partition or
+ * hardware state changes. A batch that does not fit, or fails while being
+ * programmed, leaves the table empty with nothing in the move list.
+ */
+static pipe_status_t alpm_bulk_load(alpm_tbl_info_t *tbl_info,
+                                    alpm_pipe_tbl_t *pipe_tbl,
+                                    uint32_t num_entries,
+                                    pipe_tbl_match_spec_t **match_spec,
+                                    pipe_act_fn_hdl_t *act_fn_hdl,
+                                    pipe_action_spec_t **act_spec,
+                                    uint32_t *ttl,
+                                    pipe_mat_ent_hdl_t *ent_hdl_p,
+                                    pipe_mgr_move_list_t **move_head_p) {
+  pipe_status_t sts = PIPE_SUCCESS;
+  dev_target_t dev_tgt = {.device_id = tbl_info->dev_id,
+                          .dev_pipe_id = pipe_tbl->pipe_id};
+  pipe_mgr_move_list_t *tail = NULL, *load_tail = NULL;
+  alpm_bulk_subtree_t *subtrees = NULL;
+  trie_node_t **nodes = NULL;
+  uint32_t num_built = 0, num_subtrees = 0, num_bins = 0;
+  uint32_t preclass_count = 0;
+  uint32_t i;
+
+  nodes = PIPE_MGR_MALLOC(num_entries * sizeof(trie_node_t *));
+  subtrees = PIPE_MGR_MALLOC(num_entries * sizeof(alpm_bulk_subtree_t));
+  if (!nodes || !subtrees) {
+    sts = PIPE_NO_SYS_RESOURCES;
+    goto done;
+  }
+
+  sts = alpm_bulk_build(pipe_tbl,
+                        num_entries,
+                        match_spec,
+                        act_fn_hdl,
+                        act_spec,
+                        ttl,
+                        nodes,
+                        &num_built);
+  if (sts != PIPE_SUCCESS) {
+    goto undo;
+  }
+  sts = alpm_bulk_carve_trie(pipe_tbl, subtrees, &num_subtrees, &num_bins);
+  if (sts != PIPE_SUCCESS) {
+    goto undo;
+  }
+
+  sts = pipe_mgr_tcam_get_placed_entry_count(
+      dev_tgt, tbl_info->preclass_tbl_hdl, &preclass_count);
+  if (sts != PIPE_SUCCESS) {
+    goto undo;
+  }
+  if (preclass_count + num_subtrees >
+      tbl_info->num_partitions * tbl_info->max_subtrees_per_partition - 2) {
+    LOG_ERROR("%s:%d %s(0x%x) Preclassifier cannot hold %d subtrees",
+              __func__,
+              __LINE__,
+              tbl_info->name,
+              tbl_info->alpm_tbl_hdl,
+              num_subtrees);
+    sts = PIPE_NO_SPACE;
+    goto undo;
+  }
+
+  sts = alpm_bulk_attach(pipe_tbl, subtrees, num_subtrees, num_bins);
+  if (sts != PIPE_SUCCESS) {
+    goto undo;
+  }
+  for (tail = *move_head_p; tail && tail->next; tail = tail->next)
+    ;
+  load_tail = tail;
+  sts = alpm_bulk_program(pipe_tbl, subtrees, num_subtrees, move_head_p, &tail);
+  if (sts != PIPE_SUCCESS) {
+    goto detach;
+  }
+
+  for (i = 0; i < num_entries; i++) {
+    ent_hdl_p[i] = nodes[i]->entry->alpm_entry_hdl;
+  }
+  LOG_TRACE("%s: %s(0x%x) loaded %d entries as %d subtrees in %d partitions",
+            __func__,
+            tbl_info->name,
+            tbl_info->alpm_tbl_hdl,
+            num_entries,
+            num_subtrees,
+            num_bins);
+  goto done;
+
+detach:
+  alpm_bulk_detach(pipe_tbl, subtrees, num_subtrees, nodes, num_built);
+  free_move_list_and_data(load_tail ? &load_tail->next : move_head_p, true);
+undo:
+  alpm_bulk_unbuild(pipe_tbl, nodes, num_built);
+done:
+  if (sts != PIPE_SUCCESS) {
+    clean_alpm_move_list_hdr(pipe_tbl);
+  }
+  if (nodes) {
+    PIPE_MGR_FREE(nodes);
+  }
+  if (subtrees) {
+    PIPE_MGR_FREE(subtrees);
+  }
+  return sts;
+}
+
+/*
+ * Usage: pipe_mgr_alpm_entry_place_batch(...)
+ * -------------------------------------------
+ * API to add a batch of entries to the ALPM table. An empty table outside
+ * of a transaction is bulk loaded; otherwise every entry goes through the
+ * regular add.
+ */
+pipe_status_t pipe_mgr_alpm_entry_place_batch(
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_spec,
+    pipe_act_fn_hdl_t *act_fn_hdl,
+    pipe_action_spec_t **act_spec,
+    uint32_t *ttl,
+    uint32_t pipe_api_flags,
+    pipe_mat_ent_hdl_t *ent_hdl_p,
+    pipe_mgr_move_list_t **move_head_p) {
+  pipe_status_t sts = PIPE_SUCCESS;
+  alpm_tbl_info_t *tbl_info = NULL;
+  alpm_pipe_tbl_t *pipe_tbl = NULL;
+  pipe_mgr_move_list_t *move_list, *tail = NULL;
+  bool bulk;
+  uint32_t i;
+
+  if (!num_entries || !match_spec || !act_fn_hdl || !act_spec || !ent_hdl_p ||
+      !move_head_p) {
+    LOG_ERROR("%s:%d Null pointer arguments passed", __func__, __LINE__);
+    return PIPE_INVALID_ARG;
+  }
+
+  tbl_info = pipe_mgr_alpm_tbl_info_get(dev_tgt.device_id, mat_tbl_hdl);
+  if (tbl_info == NULL) {
+    LOG_ERROR("%s:%d ALPM table with handle 0x%x not found",
+              __func__,
+              __LINE__,
+              mat_tbl_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+
+  if ((tbl_info->is_symmetric) && (dev_tgt.dev_pipe_id != BF_DEV_PIPE_ALL)) {
+    LOG_ERROR(
+        "%s:%d Invalid request to install an asymmetric entry"
+        " in a symmetric table %d device %d",
+        __func__,
+        __LINE__,
+        mat_tbl_hdl,
+        dev_tgt.device_id);
+    return PIPE_INVALID_ARG;
+  }
+  if ((!tbl_info->is_symmetric) && (dev_tgt.dev_pipe_id == BF_DEV_PIPE_ALL)) {
+    LOG_ERROR(
+        "%s:%d Invalid request to install a symmetric entry"
+        " in an asymmetric table %d device %d",
+        __func__,
+        __LINE__,
+        mat_tbl_hdl,
+        dev_tgt.device_id);
+    return PIPE_INVALID_ARG;
+  }
+
+  pipe_tbl =
+      get_pipe_tbl_instance(tbl_info, dev_tgt.dev_pipe_id, __func__, __LINE__);
+  if (!pipe_tbl) return PIPE_OBJ_NOT_FOUND;
+
+  /*
+   * Bulk loading assumes nothing is in the trie yet, so nothing needs a
+   * backup, a covering prefix update or a move. Scale optimized tables and
+   * very small partitions place subtrees by their own rules and always go
+   * through the regular add.
+   */
+  bulk = !(pipe_api_flags & (PIPE_MGR_TBL_API_TXN | PIPE_MGR_TBL_API_ATOM)) &&
+         !pipe_mgr_hitless_warm_init_in_progress(dev_tgt.device_id) &&
+         !ALPM_IS_SCALE_OPT_ENB(tbl_info) && tbl_info->partition_depth >= 3 &&
+         pipe_tbl->partitions_in_use == 0 &&
+         bf_map_count(&pipe_tbl->alpm_entry_hdl_map) == 0;
+
+  if (!bulk) {
+    /* Entries are added one at a time, a failure keeps the entries before it
+     * and drops the partial operations of the failed one, as a single add
+     * would.  Only the entries that were added get a handle.
+     */
+    for (tail = *move_head_p; tail && tail->next; tail = tail->next)
+      ;
+    for (i = 0; i < num_entries; i++) ent_hdl_p[i] = 0;
+    for (i = 0; i < num_entries; i++) {
+      move_list = NULL;
+      sts = pipe_mgr_alpm_entry_place(dev_tgt,
+                                      mat_tbl_hdl,
+                                      match_spec[i],
+                                      act_fn_hdl[i],
+                                      act_spec[i],
+                                      ttl ? ttl[i] : 0,
+                                      pipe_api_flags,
+                                      &ent_hdl_p[i],
+                                      &move_list);
+      if (sts != PIPE_SUCCESS) {
+        if (move_list) free_move_list_and_data(&move_list, true);
+        ent_hdl_p[i] = 0;
+        break;
+      }
+      set_move_list(move_head_p, &tail, move_list);
+    }
+    return sts;
+  }
+
+  pipe_tbl->dev_tgt = dev_tgt;
+  pipe_tbl->sess_flags = pipe_api_flags;
+
+  /* Fetch preclassifier info if necessary */
+  if (!pipe_tbl->match_spec_template) {
+    sts = pipe_mgr_set_alpm_tbl_match_act_info(
+        tbl_info, pipe_tbl, match_spec[0], act_spec[0]);
+    if (sts != PIPE_SUCCESS) {
+      LOG_ERROR("%s:%d Error getting ALPM table 0x%x preclassifier info",
+                __func__,
+                __LINE__,
+                tbl_info->alpm_tbl_hdl);
+      return sts;
+    }
+  }
+
+  return alpm_bulk_load(tbl_info,
+                        pipe_tbl,
+                        num_entries,
+                        match_spec,
+                        act_fn_hdl,
+                        act_spec,
+                        ttl,
+                        ent_hdl_p,
+                        move_head_p);
+}
+
 /*
  * Usage: update_covering_prefixes_delete(pipe_tbl, deleted_node, head, tail)
  * --------------------------------------------------------------------------
@@ -6898,6 +7599,28 @@ static void restore_node_backup_state(alpm_pipe_tbl_t *pipe_tbl) {
   pipe_tbl->backup_node_list = NULL;
 }
 
+/*
+ * Usage: restore_count_backup_state(pipe_tbl)
+ * -------------------------------------------
+ * Restores the backup node counts for the given pipe table. Must run after
+ * the full node backups are restored, since a node may have had its count
+ * saved before it was fully backed up.
+ */
+static void restore_count_backup_state(alpm_pipe_tbl_t *pipe_tbl) {
+  backup_count_t *curr, *next;
+
+  curr = pipe_tbl->backup_count_list;
+  while (curr) {
+    curr->node->count = curr->count;
+    curr->node->count_backed_up = false;
+
+    next = curr->next;
+    PIPE_MGR_FREE(curr);
+    curr = next;
+  }
+  pipe_tbl->backup_count_list = NULL;
+}
+
 /*
  * Usage: restore_ptn_backup_state(pipe_tbl)
  * -----------------------------------------
@@ -6967,6 +7690,7 @@ pipe_status_t pipe_mgr_alpm_abort(bf_dev_id_t dev_id,
 
     reset_entry_handles(pipe_tbl);
     restore_node_backup_state(pipe_tbl);
+    restore_count_backup_state(pipe_tbl);
     restore_ptn_backup_state(pipe_tbl);
 
     if (pipe_tbl->backup_partitions_in_use >= 0) {
@@ -7023,6 +7747,26 @@ static void discard_node_backup_state(alpm_pipe_tbl_t *pipe_tbl) {
   pipe_tbl->backup_node_list = NULL;
 }
 
+/*
+ * Usage: discard_count_backup_state(pipe_tbl)
+ * -------------------------------------------
+ * Discards the backup node counts for the given pipe table. Must run before
+ * the full node backups are discarded, which may free inactive nodes.
+ */
+static void discard_count_backup_state(alpm_pipe_tbl_t *pipe_tbl) {
+  backup_count_t *curr, *next;
+
+  curr = pipe_tbl->backup_count_list;
+  while (curr) {
+    curr->node->count_backed_up = false;
+
+    next = curr->next;
+    PIPE_MGR_FREE(curr);
+    curr = next;
+  }
+  pipe_tbl->backup_count_list = NULL;
+}
+
 /*
  * Usage: discard_ptn_backup_state(pipe_tbl)
  * -----------------------------------------
@@ -7073,6 +7817,7 @@ pipe_status_t pipe_mgr_alpm_commit_int(alpm_tbl_info_t *tbl_info,
     pipe_tbl = get_pipe_tbl_by_pipe_id(tbl_info, pipe);
     if (!pipe_tbl) continue;
 
+    discard_count_backup_state(pipe_tbl);
     discard_node_backup_state(pipe_tbl);
     discard_ptn_backup_state(pipe_tbl);
 
@@ -7150,6 +7895,255 @@ pipe_status_t pipe_mgr_alpm_atom_cleanup(bf_dev_id_t dev_id,
   return sts;
 }
 
+/* Prefix length mix of the synthetic routes, weights in percent. Roughly
+ * the shape of the public IPv4 and IPv6 BGP tables.
+ */
+typedef struct alpm_bench_pfx_s {
+  uint8_t len;
+  uint8_t weight;
+} alpm_bench_pfx_t;
+
+static const alpm_bench_pfx_t alpm_bench_v4_pfx[] = {{8, 1},
+                                                     {16, 2},
+                                                     {18, 2},
+                                                     {19, 4},
+                                                     {20, 5},
+                                                     {21, 5},
+                                                     {22, 11},
+                                                     {23, 9},
+                                                     {24, 60},
+                                                     {32, 1}};
+static const alpm_bench_pfx_t alpm_bench_v6_pfx[] = {{24, 1},
+                                                     {29, 4},
+                                                     {32, 12},
+                                                     {36, 5},
+                                                     {40, 7},
+                                                     {44, 8},
+                                                     {46, 4},
+                                                     {47, 3},
+                                                     {48, 50},
+                                                     {56, 3},
+                                                     {64, 3}};
+
+static int alpm_bench_mspec_cmp(const void *a, const void *b) {
+  const pipe_tbl_match_spec_t *ms1 = *(pipe_tbl_match_spec_t *const *)a;
+  const pipe_tbl_match_spec_t *ms2 = *(pipe_tbl_match_spec_t *const *)b;
+
+  if (ms1->priority != ms2->priority) {
+    return ms1->priority < ms2->priority ? -1 : 1;
+  }
+  return PIPE_MGR_MEMCMP(
+      ms1->match_value_bits, ms2->match_value_bits, ms1->num_match_bytes);
+}
+
+static uint64_t alpm_bench_ns(struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) * 1000000000ull + now.tv_nsec -
+         start->tv_nsec;
+}
+
+pipe_status_t pipe_mgr_alpm_bulk_bench(uint32_t num_routes,
+                                       bool ipv6,
+                                       uint32_t partition_depth,
+                                       uint32_t max_subtrees_per_partition,
+                                       uint32_t seed,
+                                       pipe_mgr_alpm_bench_result_t *res) {
+  pipe_status_t sts = PIPE_SUCCESS;
+  const alpm_bench_pfx_t *pfx = ipv6 ? alpm_bench_v6_pfx : alpm_bench_v4_pfx;
+  uint32_t num_pfx = ipv6 ? sizeof(alpm_bench_v6_pfx) / sizeof(*pfx)
+                          : sizeof(alpm_bench_v4_pfx) / sizeof(*pfx);
+  uint32_t key_width = ipv6 ? 128 : 32;
+  uint32_t num_bytes = key_width / 8;
+  uint32_t slice_offset = 0, slice_width = key_width;
+  alpm_field_info_t field_info = {0};
+  alpm_tbl_info_t *tbl_info = NULL;
+  alpm_pipe_tbl_t *pipe_tbl = NULL;
+  pipe_tbl_match_spec_t *ms_arr = NULL, **ms = NULL, *tmp;
+  pipe_act_fn_hdl_t *act_fn_hdl = NULL;
+  pipe_action_spec_t act_spec = {0}, **as = NULL;
+  uint8_t *bits = NULL;
+  trie_node_t **nodes = NULL, *curr;
+  alpm_bulk_subtree_t *subtrees = NULL;
+  pipe_bitmap_t pipe_bmp;
+  struct timespec start;
+  uint32_t state = seed ? seed : 1;
+  uint32_t num_built = 0, num_bins = 0;
+  uint32_t i, j, r, len;
+
+  if (!res || !num_routes || partition_depth < 3 ||
+      !max_subtrees_per_partition) {
+    return PIPE_INVALID_ARG;
+  }
+  PIPE_MGR_MEMSET(res, 0, sizeof(*res));
+
+  field_info.bit_width = key_width;
+  field_info.num_slices = 1;
+  field_info.slice_offset = &slice_offset;
+  field_info.slice_width = &slice_width;
+
+  tbl_info = PIPE_MGR_CALLOC(1, sizeof(alpm_tbl_info_t));
+  ms_arr = PIPE_MGR_CALLOC(num_routes, sizeof(pipe_tbl_match_spec_t));
+  ms = PIPE_MGR_CALLOC(num_routes, sizeof(pipe_tbl_match_spec_t *));
+  as = PIPE_MGR_CALLOC(num_routes, sizeof(pipe_action_spec_t *));
+  act_fn_hdl = PIPE_MGR_CALLOC(num_routes, sizeof(pipe_act_fn_hdl_t));
+  bits = PIPE_MGR_CALLOC(num_routes, 2 * num_bytes);
+  nodes = PIPE_MGR_CALLOC(num_routes, sizeof(trie_node_t *));
+  subtrees = PIPE_MGR_CALLOC(num_routes, sizeof(alpm_bulk_subtree_t));
+  if (!tbl_info || !ms_arr || !ms || !as || !act_fn_hdl || !bits || !nodes ||
+      !subtrees) {
+    sts = PIPE_NO_SYS_RESOURCES;
+    goto done;
+  }
+
+  /* An in-memory table with a single LPM field, one partition per route at
+   * most so the packing never runs out.
+   */
+  tbl_info->name = (char *)"alpm_bulk_bench";
+  tbl_info->size = num_routes;
+  tbl_info->is_symmetric = true;
+  tbl_info->num_partitions = num_routes;
+  tbl_info->partition_depth = partition_depth;
+  tbl_info->max_subtrees_per_partition = max_subtrees_per_partition;
+  tbl_info->num_fields = 1;
+  tbl_info->field_info = &field_info;
+  tbl_info->trie_depth = key_width;
+  tbl_info->lpm_field_key_width = key_width;
+
+  /* Random routes, without duplicates, in random order */
+  for (i = 0; i < num_routes; i++) {
+    r = pipe_mgr_test_rand(&state) % 100;
+    for (j = 0; j < num_pfx - 1 && r >= pfx[j].weight; j++) {
+      r -= pfx[j].weight;
+    }
+    len = pfx[j].len;
+
+    tmp = &ms_arr[i];
+    tmp->num_valid_match_bits = key_width;
+    tmp->num_match_bytes = num_bytes;
+    tmp->priority = key_width - len;
+    tmp->match_value_bits = bits + i * 2 * num_bytes;
+    tmp->match_mask_bits = tmp->match_value_bits + num_bytes;
+    for (j = 0; j < num_bytes; j++) {
+      if (len >= (j + 1) * 8) {
+        tmp->match_mask_bits[j] = 0xff;
+      } else if (len > j * 8) {
+        tmp->match_mask_bits[j] = 0xff << (8 - (len - j * 8));
+      }
+      tmp->match_value_bits[j] =
+          pipe_mgr_test_rand(&state) & tmp->match_mask_bits[j];
+    }
+    ms[i] = tmp;
+    as[i] = &act_spec;
+  }
+  qsort(ms, num_routes, sizeof(pipe_tbl_match_spec_t *), alpm_bench_mspec_cmp);
+  for (i = 1, j = 1; i < num_routes; i++) {
+    if (alpm_bench_mspec_cmp(&ms[j - 1], &ms[i])) {
+      ms[j++] = ms[i];
+    }
+  }
+  res->num_routes = num_routes = j;
+  for (i = num_routes - 1; i > 0; i--) {
+    j = pipe_mgr_test_rand(&state) % (i + 1);
+    tmp = ms[i];
+    ms[i] = ms[j];
+    ms[j] = tmp;
+  }
+
+  PIPE_BITMAP_INIT(&pipe_bmp, PIPE_BMP_SIZE);
+  pipe_tbl = pipe_mgr_alpm_pipe_tbl_create(
+      tbl_info, NULL, BF_DEV_PIPE_ALL, &pipe_bmp);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  sts = alpm_bulk_build(
+      pipe_tbl, num_routes, ms, act_fn_hdl, as, NULL, nodes, &num_built);
+  res->build_ns = alpm_bench_ns(&start);
+  if (sts != PIPE_SUCCESS) {
+    goto done;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  sts = alpm_bulk_carve_trie(
+      pipe_tbl, subtrees, &res->num_subtrees, &res->num_partitions);
+  res->carve_ns = alpm_bench_ns(&start);
+  if (sts != PIPE_SUCCESS) {
+    goto done;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  sts = alpm_bulk_attach(
+      pipe_tbl, subtrees, res->num_subtrees, res->num_partitions);
+  res->attach_ns = alpm_bench_ns(&start);
+  if (sts != PIPE_SUCCESS) {
+    goto done;
+  }
+  for (i = 0; i < res->num_subtrees; i++) {
+    res->num_entries_placed += subtrees[i].size;
+  }
+  num_bins = res->num_partitions;
+
+  /* One route per transaction: back up every node a count update walks,
+   * then commit.
+   */
+  pipe_tbl->sess_flags = PIPE_MGR_TBL_API_TXN;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < num_routes; i++) {
+    for (curr = nodes[i]; curr; curr = curr->parent) {
+      backup_node(pipe_tbl, curr);
+      if (curr->subtree) break;
+    }
+    discard_node_backup_state(pipe_tbl);
+  }
+  res->full_backup_ns = alpm_bench_ns(&start);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < num_routes; i++) {
+    for (curr = nodes[i]; curr; curr = curr->parent) {
+      backup_node_count(pipe_tbl, curr);
+      if (curr->subtree) break;
+    }
+    discard_count_backup_state(pipe_tbl);
+  }
+  res->count_backup_ns = alpm_bench_ns(&start);
+  pipe_tbl->sess_flags = 0;
+
+  LOG_TRACE("%s: %d routes, %d subtrees in %d partitions",
+            __func__,
+            num_routes,
+            res->num_subtrees,
+            num_bins);
+
+done:
+  if (pipe_tbl) {
+    pipe_mgr_alpm_pipe_tbl_destroy(pipe_tbl);
+  }
+  if (tbl_info) {
+    PIPE_MGR_FREE(tbl_info);
+  }
+  if (ms_arr) {
+    PIPE_MGR_FREE(ms_arr);
+  }
+  if (ms) {
+    PIPE_MGR_FREE(ms);
+  }
+  if (as) {
+    PIPE_MGR_FREE(as);
+  }
+  if (act_fn_hdl) {
+    PIPE_MGR_FREE(act_fn_hdl);
+  }
+  if (bits) {
+    PIPE_MGR_FREE(bits);
+  }
+  if (nodes) {
+    PIPE_MGR_FREE(nodes);
+  }
+  if (subtrees) {
+    PIPE_MGR_FREE(subtrees);
+  }
+  return sts;
+}
+
 /*
  * Usage: pipe_mgr_alpm_print_match_spec(...)
  * ------------------------------------------
@@ -91,6 +91,7 @@ typedef struct trie_node_s {
   struct trie_node_s **cov_pfx_subtree_nodes;
 
   bool backed_up;
+  bool count_backed_up;
 } trie_node_t;
 
 struct partition_info_s;
@@ -134,6 +135,13 @@ typedef struct backup_node_s {
   struct backup_node_s *next;
 } backup_node_t;
 
+/* ALPM node count backup, for nodes where only the count changes */
+typedef struct backup_count_s {
+  trie_node_t *node;
+  uint32_t count;
+  struct backup_count_s *next;
+} backup_count_t;
+
 /* ALPM partition data backup */
 typedef struct backup_ptn_s {
   partition_info_t *backup;
@@ -183,6 +191,7 @@ typedef struct alpm_pipe_tbl_s {
   bf_id_allocator *ent_hdl_allocator;
   bf_map_t alpm_entry_hdl_map;
   backup_node_t *backup_node_list;
+  backup_count_t *backup_count_list;
   backup_ptn_t *backup_ptn_list;
   partition_info_t *backup_ptn_in_use_list;
   partition_info_t *backup_ptn_free_list;
@@ -322,6 +331,28 @@ pipe_status_t pipe_mgr_alpm_entry_place(dev_target_t dev_tgt,
                                         pipe_mat_ent_hdl_t *ent_hdl_p,
                                         pipe_mgr_move_list_t **move_head_p);
 
+/*
+ * Usage: pipe_mgr_alpm_entry_place_batch(...)
+ * -------------------------------------------
+ * Adds a batch of entries to the alpm table. When the table is empty and
+ * no transaction is open, the trie is built offline, cut into subtrees in
+ * one pass, packed into partitions and programmed in priority order.
+ * Otherwise the entries are added one at a time. The move lists of all
+ * entries are returned chained in move_head_p. On a failure ent_hdl_p[i] is
+ * non-zero for the entries that were added and are in the move list.
+ */
+pipe_status_t pipe_mgr_alpm_entry_place_batch(
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_spec,
+    pipe_act_fn_hdl_t *act_fn_hdl,
+    pipe_action_spec_t **act_spec,
+    uint32_t *ttl,
+    uint32_t pipe_api_flags,
+    pipe_mat_ent_hdl_t *ent_hdl_p,
+    pipe_mgr_move_list_t **move_head_p);
+
 pipe_status_t pipe_mgr_alpm_entry_place_with_hdl(
     dev_target_t dev_tgt,
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
@@ -642,6 +673,34 @@ typedef pipe_status_t (*alpm_restore_callback_fn)(
 pipe_status_t pipe_mgr_alpm_get_inactive_node_delete(bool *enable);
 pipe_status_t pipe_mgr_alpm_set_inactive_node_delete(bool enable);
 
+/* Results of pipe_mgr_alpm_bulk_bench */
+typedef struct pipe_mgr_alpm_bench_result_s {
+  uint32_t num_routes;
+  uint32_t num_subtrees;
+  uint32_t num_partitions;
+  uint32_t num_entries_placed;
+  uint64_t build_ns;
+  uint64_t carve_ns;
+  uint64_t attach_ns;
+  uint64_t full_backup_ns;
+  uint64_t count_backup_ns;
+} pipe_mgr_alpm_bench_result_t;
+
+/*
+ * Usage: pipe_mgr_alpm_bulk_bench(...)
+ * ------------------------------------
+ * Bulk loads synthetic IPv4 or IPv6 routes into a table that lives only in
+ * memory and times the trie build, the subtree carving and packing, and the
+ * per route transaction backups with full node copies and with count only
+ * backups. No hardware is touched.
+ */
+pipe_status_t pipe_mgr_alpm_bulk_bench(uint32_t num_routes,
+                                       bool ipv6,
+                                       uint32_t partition_depth,
+                                       uint32_t max_subtrees_per_partition,
+                                       uint32_t seed,
+                                       pipe_mgr_alpm_bench_result_t *res);
+
 void build_alpm_full_mspec(alpm_tbl_info_t *tbl_info,
                            pipe_tbl_match_spec_t *entry_mspec,
                            pipe_tbl_match_spec_t *atcam_mspec,
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*!
+ * @file pipe_mgr_alpm_bulk.c
+ * @date
+ *
+ * Carving and packing of the ALPM bulk load.
+ *
+ * Both steps only look at the shape of the trie and at the partition depths,
+ * nothing here changes partition or hardware state.
+ */
+
+/* Standard header includes */
+#include <stdlib.h>
+
+/* Module header includes */
+#include <pipe_mgr/pipe_mgr_porting.h>
+
+/* Local header includes */
+#include "pipe_mgr_alpm_bulk.h"
+
+uint32_t pipe_mgr_alpm_bulk_carve(trie_node_t *node,
+                                  bool covered,
+                                  uint32_t cap,
+                                  alpm_bulk_subtree_t *subtrees,
+                                  uint32_t *num_subtrees) {
+  trie_node_t *child[2];
+  uint32_t child_count[2];
+  uint32_t count, cp, i;
+  bool child_covered;
+
+  if (!node) {
+    return 0;
+  }
+
+  child_covered = covered || node->entry;
+  child[0] = node->left_child;
+  child[1] = node->right_child;
+  for (i = 0; i < 2; i++) {
+    child_count[i] = pipe_mgr_alpm_bulk_carve(
+        child[i], child_covered, cap, subtrees, num_subtrees);
+  }
+
+  count = (node->entry ? 1 : 0) + child_count[0] + child_count[1];
+  cp = (!node->entry && covered) ? 1 : 0;
+  while (count + cp > cap) {
+    i = (child_count[0] >= child_count[1]) ? 0 : 1;
+    subtrees[*num_subtrees].node = child[i];
+    subtrees[*num_subtrees].size =
+        child_count[i] + ((!child[i]->entry && child_covered) ? 1 : 0);
+    (*num_subtrees)++;
+    count -= child_count[i];
+    child_count[i] = 0;
+  }
+
+  node->count = count;
+  return count;
+}
+
+static int alpm_bulk_subtree_size_cmp(const void *a, const void *b) {
+  const alpm_bulk_subtree_t *s1 = a;
+  const alpm_bulk_subtree_t *s2 = b;
+
+  if (s1->size != s2->size) {
+    return s1->size > s2->size ? -1 : 1;
+  }
+  if (s1->node->depth != s2->node->depth) {
+    return s1->node->depth > s2->node->depth ? -1 : 1;
+  }
+  return 0;
+}
+
+pipe_status_t pipe_mgr_alpm_bulk_pack(const uint32_t *bin_depth,
+                                      uint32_t num_free,
+                                      uint32_t max_subtrees,
+                                      alpm_bulk_subtree_t *subtrees,
+                                      uint32_t num_subtrees,
+                                      uint32_t *num_bins_p) {
+  uint32_t *space_left = NULL;
+  uint32_t *subtree_cnt = NULL;
+  uint32_t num_bins = 0, first_open = 0;
+  uint32_t i, b;
+  pipe_status_t sts = PIPE_SUCCESS;
+
+  if (num_free == 0) {
+    return PIPE_NO_SPACE;
+  }
+  space_left = PIPE_MGR_MALLOC(num_free * sizeof(uint32_t));
+  subtree_cnt = PIPE_MGR_CALLOC(num_free, sizeof(uint32_t));
+  if (!space_left || !subtree_cnt) {
+    sts = PIPE_NO_SYS_RESOURCES;
+    goto done;
+  }
+  for (b = 0; b < num_free; b++) {
+    space_left[b] = bin_depth[b];
+  }
+
+  qsort(subtrees,
+        num_subtrees,
+        sizeof(alpm_bulk_subtree_t),
+        alpm_bulk_subtree_size_cmp);
+  for (i = 0; i < num_subtrees; i++) {
+    for (b = first_open; b < num_bins; b++) {
+      if (subtree_cnt[b] < max_subtrees && space_left[b] >= subtrees[i].size) {
+        break;
+      }
+    }
+    if (b == num_bins) {
+      if (num_bins == num_free || space_left[b] < subtrees[i].size) {
+        sts = PIPE_NO_SPACE;
+        goto done;
+      }
+      num_bins++;
+    }
+    subtrees[i].bin = b;
+    space_left[b] -= subtrees[i].size;
+    subtree_cnt[b]++;
+
+    while (first_open < num_bins && (subtree_cnt[first_open] == max_subtrees ||
+                                     space_left[first_open] == 0)) {
+      first_open++;
+    }
+  }
+  *num_bins_p = num_bins;
+
+done:
+  if (space_left) {
+    PIPE_MGR_FREE(space_left);
+  }
+  if (subtree_cnt) {
+    PIPE_MGR_FREE(subtree_cnt);
+  }
+  return sts;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#ifndef PIPE_MGR_ALPM_BULK_H_INCLUDED
+#define PIPE_MGR_ALPM_BULK_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+#include "pipe_mgr_alpm.h"
+
+/* A subtree root chosen by the bulk load, with the partition it goes to */
+typedef struct alpm_bulk_subtree_s {
+  trie_node_t *node;
+  uint32_t size;
+  uint32_t bin;
+} alpm_bulk_subtree_t;
+
+/*
+ * Usage: pipe_mgr_alpm_bulk_carve(node, covered, cap, subtrees, &num)
+ * -------------------------------------------------------------------
+ * Cuts the trie below the given node into subtrees of at most cap slots in
+ * a single post-order walk. A node keeps its own entry and the entries of
+ * the children that were not cut. While those, plus a covering prefix slot
+ * when the node has no entry but an ancestor has, do not fit, the child
+ * holding the most entries becomes a subtree root. Cutting the heaviest
+ * children first gives the fewest subtrees for a bottom-up walk. Sets the
+ * count of every node and returns the count of the given node.
+ */
+uint32_t pipe_mgr_alpm_bulk_carve(trie_node_t *node,
+                                  bool covered,
+                                  uint32_t cap,
+                                  alpm_bulk_subtree_t *subtrees,
+                                  uint32_t *num_subtrees);
+
+/*
+ * Usage: pipe_mgr_alpm_bulk_pack(bin_depth, num_free, max, subtrees, ...)
+ * -----------------------------------------------------------------------
+ * Assigns the subtrees to num_free partitions of the given depths, holding
+ * at most max_subtrees each, first fit in decreasing size order. The bin of
+ * a subtree is the index of its partition in bin_depth and the bins used
+ * are returned in num_bins_p. Leaves the subtrees sorted by decreasing size.
+ */
+pipe_status_t pipe_mgr_alpm_bulk_pack(const uint32_t *bin_depth,
+                                      uint32_t num_free,
+                                      uint32_t max_subtrees,
+                                      alpm_bulk_subtree_t *subtrees,
+                                      uint32_t num_subtrees,
+                                      uint32_t *num_bins_p);
+
+#endif  // PIPE_MGR_ALPM_BULK_H_INCLUDED
@@ -29,6 +29,7 @@
 /* Module header files */
 #include <sys/types.h>
 #include <sched.h>
+#include <time.h>
 #include <dvm/bf_drv_intf.h>
 #include <lld/bf_dma_if.h>
 #include <lld/lld_reg_if.h>
@@ -568,53 +569,33 @@ void pipe_mgr_drv_service_drs(bf_dev_id_t dev_id) {
  * A few utility functions.                                                   *
  *                                                                            *
  *****************************************************************************/
-static void ilist_pending_dec(bf_dev_id_t dev,
+static void ilist_credit_take(bf_dev_id_t dev,
                               bf_subdev_id_t subdev,
                               uint8_t dr) {
-  PIPE_MGR_LOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  --pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][subdev][dr];
-  PIPE_MGR_UNLOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  PIPE_MGR_DBGCHK(pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][subdev][dr] >= 0);
+  pipe_mgr_drv_ilist_credit_t *c =
+      &pipe_mgr_drv_ctx()->ilist_credit[dev][subdev][dr];
+  /* Only the push taking the last credit marks the device as overdrawn. */
+  if (__sync_sub_and_fetch(&c->avail, 1) == -1) {
+    __sync_add_and_fetch(&pipe_mgr_drv_ctx()->ilist_credit_overdrawn[dev], 1);
+  }
 }
-static void ilist_pending_inc(bf_dev_id_t dev,
-                              bf_subdev_id_t subdev,
-                              uint8_t dr) {
-  PIPE_MGR_LOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  ++pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][subdev][dr];
-  PIPE_MGR_UNLOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  PIPE_MGR_DBGCHK(pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][subdev][dr] > 0);
+static void ilist_credit_return(bf_dev_id_t dev,
+                                bf_subdev_id_t subdev,
+                                uint8_t dr) {
+  pipe_mgr_drv_ilist_credit_t *c =
+      &pipe_mgr_drv_ctx()->ilist_credit[dev][subdev][dr];
+  int avail = __sync_add_and_fetch(&c->avail, 1);
+  PIPE_MGR_DBGCHK(avail <= c->size);
+  if (avail == 0) {
+    __sync_sub_and_fetch(&pipe_mgr_drv_ctx()->ilist_credit_overdrawn[dev], 1);
+  }
 }
-static bool ilist_pending_full(bf_dev_id_t dev) {
-  /* Return true if any of the ilist Tx counts are greater than the size of
-   * the response DR.  This means that more data was transmitted than will
-   * fit in the response DR, so the response DR will flow control the Tx DR
-   * and data will be stuck waiting in the Tx DR until the response DR is
-   * serviced. */
-  bool x = false;
-  PIPE_MGR_LOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  x = pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][0][0] >
-          pipe_mgr_drv_ctx()->ilist_dr_size[dev][0][0] ||
-      pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][0][1] >
-          pipe_mgr_drv_ctx()->ilist_dr_size[dev][0][1] ||
-      pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][0][2] >
-          pipe_mgr_drv_ctx()->ilist_dr_size[dev][0][2] ||
-      pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][0][3] >
-          pipe_mgr_drv_ctx()->ilist_dr_size[dev][0][3];
-
-  uint32_t num_subdevices = pipe_mgr_get_num_active_subdevices(dev);
-  if (num_subdevices > 1) {
-    x = x ||
-        pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][1][0] >
-            pipe_mgr_drv_ctx()->ilist_dr_size[dev][1][0] ||
-        pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][1][1] >
-            pipe_mgr_drv_ctx()->ilist_dr_size[dev][1][1] ||
-        pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][1][2] >
-            pipe_mgr_drv_ctx()->ilist_dr_size[dev][1][2] ||
-        pipe_mgr_drv_ctx()->ilist_pending_cnt[dev][1][3] >
-            pipe_mgr_drv_ctx()->ilist_dr_size[dev][1][3];
-  }
-  PIPE_MGR_UNLOCK(&pipe_mgr_drv_ctx()->drv_ctx_mtx);
-  return x;
+static bool ilist_credit_exhausted(bf_dev_id_t dev) {
+  /* Return true if any of the device's ilist DRs has had more buffers pushed
+   * than its response DR can hold.  Data will then be stuck waiting in the Tx
+   * DR until the response DR is serviced. */
+  return __atomic_load_n(&pipe_mgr_drv_ctx()->ilist_credit_overdrawn[dev],
+                         __ATOMIC_ACQUIRE) > 0;
 }
 static uint64_t pipe_mgr_drv_next_msgId(pipe_mgr_drv_ses_state_t *st,
                                         uint8_t dev_id,
@@ -673,6 +654,58 @@ pipe_mgr_drv_ses_state_t *pipe_mgr_drv_get_ses_state(pipe_sess_hdl_t *sess_hdl,
   return &pipe_mgr_drv_ctx()->sesStates[*sess_hdl];
 }
 
+/* Returns a timestamp for the DMA buffer lifecycle trace or zero if tracing
+ * is disabled. */
+static inline uint64_t buf_trace_now(void) {
+  if (!pipe_mgr_drv_ctx()->buf_trace_en) return 0;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void buf_trace_add(struct pipe_mgr_drv_buf_trace_t *t,
+                          int dr,
+                          enum pipe_mgr_drv_trace_stage stage,
+                          uint64_t start,
+                          uint64_t end) {
+  uint64_t ns = end > start ? end - start : 0;
+  uint64_t us = ns / 1000;
+  int bkt = us ? 64 - __builtin_clzll(us) - 1 : 0;
+  if (bkt >= PIPE_MGR_DRV_TRACE_BKT_CNT) bkt = PIPE_MGR_DRV_TRACE_BKT_CNT - 1;
+  ++t->hist[dr][stage][bkt];
+  t->sum_ns[dr][stage] += ns;
+  if (ns > t->max_ns[dr][stage]) t->max_ns[dr][stage] = ns;
+}
+
+/* Account a buffer completed by a DR in the session's lifecycle histograms.
+ * Must be called with the session's mtx_ses held. */
+static void buf_trace_cmplt(pipe_mgr_drv_ses_state_t *st,
+                            int dr,
+                            pipe_mgr_drv_buf_t *b) {
+  /* Buffers allocated before tracing was enabled are not accounted. */
+  if (!b->ts_alloc || !b->ts_fill || !b->ts_push) return;
+  uint64_t now = buf_trace_now();
+  if (!now) return;
+  struct pipe_mgr_drv_buf_trace_t *t = &st->bufTrace;
+  ++t->cnt[dr];
+  buf_trace_add(t, dr, PIPE_MGR_DRV_TRACE_FILL, b->ts_alloc, b->ts_fill);
+  buf_trace_add(t, dr, PIPE_MGR_DRV_TRACE_QUEUE, b->ts_fill, b->ts_push);
+  buf_trace_add(t, dr, PIPE_MGR_DRV_TRACE_DMA, b->ts_push, now);
+}
+
+void pipe_mgr_drv_buf_trace_set(bool enable) {
+  pipe_mgr_drv_ctx()->buf_trace_en = enable;
+}
+
+void pipe_mgr_drv_buf_trace_clear(void) {
+  for (unsigned i = 0; i < PIPE_MGR_MAX_SESSIONS; ++i) {
+    pipe_mgr_drv_ses_state_t *st = &pipe_mgr_drv_ctx()->sesStates[i];
+    PIPE_MGR_LOCK(&st->mtx_ses);
+    PIPE_MGR_MEMSET(&st->bufTrace, 0, sizeof st->bufTrace);
+    PIPE_MGR_UNLOCK(&st->mtx_ses);
+  }
+}
+
 void pipe_mgr_drv_buf_check(bool allFree) {
   (void)allFree;
 
@@ -686,13 +719,16 @@ void pipe_mgr_drv_buf_check(bool allFree) {
 static void printOneBuf(pipe_mgr_drv_buf_t *b, unsigned idx) {
   LOG_TRACE(
       "%3u: Buffer %p Addr %p Sz 0x%-4x Used 0x%-4x "
-      "Dev %u MsgId 0x%-16" PRIx64 " PshMsk %x PipeMsk %x [%p %p]",
+      "Dev %u Type %u Sid %u MsgId 0x%-16" PRIx64
+      " PshMsk %x PipeMsk %x [%p %p]",
       idx,
       (void *)b,
       b->addr,
       b->size,
       b->used,
       b->devId,
+      b->type,
+      b->sid,
       b->msgId,
       b->buf_pushed,
       b->pipeMask,
@@ -703,6 +739,7 @@ static void printOneBufPool(pipe_mgr_drv_buf_pool_t *p) {
   LOG_TRACE("Buffer Pool: %p", (void *)p);
   enum pipe_mgr_drv_buf_type type;
   for (type = PIPE_MGR_DRV_BUF_FIRST; type < PIPE_MGR_DRV_BUF_CNT; ++type) {
+    bf_sys_dma_pool_stats_t stats;
     LOG_TRACE("  %s: Handle %p BufSz %#x BufCnt %#x",
               PIPE_MGR_DRV_BUF_IL == type
                   ? "IL "
@@ -720,6 +757,17 @@ static void printOneBufPool(pipe_mgr_drv_buf_pool_t *p) {
               p->pool[type],
               p->buf_sz[type],
               p->buf_cnt[type]);
+    if (p->pool[type] && !bf_sys_dma_pool_stats_get(p->pool[type], &stats)) {
+      LOG_TRACE("  Free %u Cached %u CacheDepth %u Hits %" PRIu64
+                " Refills %" PRIu64 " Drains %" PRIu64 " Steals %" PRIu64,
+                stats.free_bufs,
+                stats.cached_bufs,
+                stats.cache_depth,
+                stats.cache_hits,
+                stats.cache_refills,
+                stats.cache_drains,
+                stats.cache_steals);
+    }
     LOG_TRACE("  Used List:");
     unsigned int i = 0;
     for (i = 0; i < p->buf_cnt[type]; ++i) {
@@ -737,6 +785,11 @@ void pipe_mgr_drv_dump_state(void) {
     for (subdev_id = 0; subdev_id < (int)num_subdevices; subdev_id++) {
       LOG_TRACE("Device %u, subdevice: %u", dev, subdev_id);
       printOneBufPool(&pipe_mgr_drv_ctx()->gBufPool[dev][subdev_id]);
+      for (i = 0; i < PIPE_MGR_DRV_ILIST_DR_CNT; ++i) {
+        pipe_mgr_drv_ilist_credit_t *c =
+            &pipe_mgr_drv_ctx()->ilist_credit[dev][subdev_id][i];
+        LOG_TRACE("  IList DR %u: Credits %d of %d", i, c->avail, c->size);
+      }
     }
   }
   for (i = 0; i < PIPE_MGR_MAX_SESSIONS; ++i) {
@@ -1117,7 +1170,7 @@ pipe_status_t pipe_mgr_drv_get_dr_size(bf_dev_id_t dev_id) {
   bf_subdev_id_t subdev_id = 0;
   uint32_t num_subdevices = pipe_mgr_get_num_active_subdevices(dev_id);
   for (subdev_id = 0; subdev_id < (int)num_subdevices; subdev_id++) {
-    for (i = 0; i < 4; ++i) {
+    for (i = 0; i < PIPE_MGR_DRV_ILIST_DR_CNT; ++i) {
       int x = lld_subdev_dr_depth_get(
           dev_id, subdev_id, lld_dr_cmp_pipe_inst_list_0 + i);
       if (0 > x) {
@@ -1130,10 +1183,11 @@ pipe_status_t pipe_mgr_drv_get_dr_size(bf_dev_id_t dev_id) {
             x);
         return PIPE_INVALID_ARG;
       }
-      pipe_mgr_drv_ctx()->ilist_dr_size[dev_id][subdev_id][i] = x;
-      pipe_mgr_drv_ctx()->ilist_pending_cnt[dev_id][subdev_id][i] = 0;
+      pipe_mgr_drv_ctx()->ilist_credit[dev_id][subdev_id][i].size = x;
+      pipe_mgr_drv_ctx()->ilist_credit[dev_id][subdev_id][i].avail = x;
     }
   }
+  pipe_mgr_drv_ctx()->ilist_credit_overdrawn[dev_id] = 0;
 
   return PIPE_SUCCESS;
 }
@@ -1381,12 +1435,10 @@ pipe_status_t pipe_mgr_drv_device_cleanup(bf_dev_id_t dev_id) {
               sts);
   }
 
-  PIPE_MGR_MEMSET(&pipe_mgr_drv_ctx()->ilist_dr_size[dev_id],
+  PIPE_MGR_MEMSET(&pipe_mgr_drv_ctx()->ilist_credit[dev_id],
                   0,
-                  sizeof pipe_mgr_drv_ctx()->ilist_dr_size[dev_id]);
-  PIPE_MGR_MEMSET(&pipe_mgr_drv_ctx()->ilist_pending_cnt[dev_id],
-                  0,
-                  sizeof pipe_mgr_drv_ctx()->ilist_pending_cnt[dev_id]);
+                  sizeof pipe_mgr_drv_ctx()->ilist_credit[dev_id]);
+  pipe_mgr_drv_ctx()->ilist_credit_overdrawn[dev_id] = 0;
 
   pipe_mgr_drv_ctx()->valid[dev_id] = false;
 
@@ -1413,6 +1465,18 @@ static pipe_status_t pipe_mgr_drv_buf_pool_init(bf_dev_id_t dev,
       PIPE_MGR_CALLOC(bi->dma_buf_cnt, sizeof(pipe_mgr_drv_buf_t));
   if (!bp->used[PIPE_MGR_DRV_BUF_IL]) goto cleanup;
 
+  /* Each ilist or block write buffer is allocated and freed once per table
+   * update, give every thread a private cache of them so that sessions
+   * programming in parallel do not serialize on the pool's free stack.  The
+   * block read/write buffers normally share this pool. */
+  if (bp->pool[PIPE_MGR_DRV_BUF_IL] &&
+      bp->buf_cnt[PIPE_MGR_DRV_BUF_IL] >= PIPE_MGR_DRV_BUF_CACHE_MIN_CNT) {
+    if (bf_sys_dma_pool_cache_set(bp->pool[PIPE_MGR_DRV_BUF_IL],
+                                  PIPE_MGR_DRV_BUF_CACHE_DEPTH)) {
+      LOG_WARN("Dev %d: Failed to enable ilist DMA buffer cache", dev);
+    }
+  }
+
   bi = &dma_info->dma_buff_info[BF_DMA_PIPE_BLOCK_READ];
   bp->pool[PIPE_MGR_DRV_BUF_BRD] = bi->dma_buf_pool_handle;
   bp->buf_sz[PIPE_MGR_DRV_BUF_BRD] = bi->dma_buf_size;
@@ -1561,7 +1625,12 @@ pipe_mgr_drv_buf_t *pipe_mgr_drv_buf_alloc_subdev(
         b->subdev = subdev_id;
         b->pipeMask = 0;
         b->buf_pushed = 0;
+        b->type = type;
+        b->sid = sid;
         b->msgId = 0;
+        b->ts_alloc = buf_trace_now();
+        b->ts_fill = 0;
+        b->ts_push = 0;
         b->next = NULL;
         b->prev = NULL;
         pipe_mgr_drv_buf_t *first_buf = &bp->used[type][0];
@@ -1610,22 +1679,18 @@ void pipe_mgr_drv_buf_free(pipe_mgr_drv_buf_t *buf) {
     return;
   }
 
+  /* The buffer carries the type of the pool it came from, just verify that
+   * it really is part of that pool's array. */
+  enum pipe_mgr_drv_buf_type type = buf->type;
+  if (type >= PIPE_MGR_DRV_BUF_CNT) {
+    PIPE_MGR_DBGCHK(type < PIPE_MGR_DRV_BUF_CNT);
+    return;
+  }
   pipe_mgr_drv_buf_pool_t *bp =
       &pipe_mgr_drv_ctx()->gBufPool[buf->devId][buf->subdev];
-  /* Find the buffer in the buffer pool. */
-  enum pipe_mgr_drv_buf_type type;
-  int idx = -1;
-  for (type = PIPE_MGR_DRV_BUF_FIRST; type < PIPE_MGR_DRV_BUF_CNT; ++type) {
-    if (!bp->buf_cnt[type]) continue;
-    pipe_mgr_drv_buf_t *first = &bp->used[type][0];
-    pipe_mgr_drv_buf_t *last = &bp->used[type][bp->buf_cnt[type] - 1];
-    if (first <= buf && buf <= last) {
-      idx = buf - first;
-      break;
-    }
-  }
-  if (-1 == idx) {
-    PIPE_MGR_DBGCHK(-1 != idx);
+  if (!bp->buf_cnt[type] || buf < &bp->used[type][0] ||
+      buf > &bp->used[type][bp->buf_cnt[type] - 1]) {
+    PIPE_MGR_DBGCHK(0);
     return;
   }
 
@@ -1637,6 +1702,7 @@ void pipe_mgr_drv_buf_free(pipe_mgr_drv_buf_t *buf) {
   buf->buf_pushed = 0;
   buf->devId = ~0;
   buf->msgId = ~UINT64_C(0);
+  buf->ts_alloc = buf->ts_fill = buf->ts_push = 0;
   buf->next = buf->prev = NULL;
 
   bf_sys_dma_free(bp->pool[type], vaddr);
@@ -2002,6 +2068,7 @@ pipe_status_t pipe_mgr_push_wr_blks_to_dr(pipe_sess_hdl_t *sess,
       return PIPE_COMM_FAIL;
     }
     op->buf->buf_pushed = true;
+    if (op->buf->ts_alloc) op->buf->ts_push = buf_trace_now();
   }
   PIPE_MGR_UNLOCK(&st->mtx_ses);
 
@@ -2047,6 +2114,7 @@ static pipe_status_t blk_wr_int(pipe_sess_hdl_t *sess,
   buf->pipeMask = phy_pipe_mask;
 
   buf->used = !single_data ? entry_sz * entryCount : entry_sz;
+  if (buf->ts_alloc) buf->ts_fill = buf_trace_now();
 
   pipe_mgr_drv_ses_state_t *st =
       pipe_mgr_drv_get_ses_state(sess, __func__, __LINE__);
@@ -2142,6 +2210,7 @@ static pipe_status_t blk_wr_int(pipe_sess_hdl_t *sess,
       return PIPE_COMM_FAIL;
     }
     buf->buf_pushed = true;
+    if (buf->ts_alloc) buf->ts_push = buf_trace_now();
   }
 
   PIPE_MGR_DLL_AP(st->wrBlk, wrBlk, next, prev);
@@ -2541,6 +2610,11 @@ static pipe_status_t ilist_append_buf(pipe_mgr_drv_ses_state_t *st,
    * list has not been pushed yet.  This means that there is no possibility
    * of another thread taking buffers off the list because that only happens
    * in the completion callback. */
+  if (b->ts_alloc && il->bufs[dev_id][subdev]) {
+    /* The previous buffer is full, it now waits for the list to be pushed. */
+    pipe_mgr_drv_buf_t *tail = il->bufs[dev_id][subdev]->prev;
+    if (!tail->ts_fill) tail->ts_fill = buf_trace_now();
+  }
   PIPE_MGR_DLL_AP(il->bufs[dev_id][subdev], b, next, prev);
   ++il->bufCnt;
   b->pipeMask = phy_pipe_mask;
@@ -3218,7 +3292,7 @@ pipe_status_t pipe_mgr_drv_ilist_rd_push(pipe_sess_hdl_t *sess,
             if (ret) {
               break;
             } else {
-              ilist_pending_inc(il->dev_id, subdev_id, which_dr);
+              ilist_credit_take(il->dev_id, subdev_id, which_dr);
               b->buf_pushed |= (1 << which_dr);
             }
           } else {
@@ -3239,7 +3313,7 @@ pipe_status_t pipe_mgr_drv_ilist_rd_push(pipe_sess_hdl_t *sess,
               PIPE_MGR_LOCK(&st->mtx_ses);
             }
             if (!ret) {
-              ilist_pending_inc(il->dev_id, subdev_id, which_dr);
+              ilist_credit_take(il->dev_id, subdev_id, which_dr);
               b->buf_pushed |= (1 << which_dr);
             }
           }
@@ -3295,7 +3369,7 @@ pipe_status_t pipe_mgr_drv_ilist_rd_push(pipe_sess_hdl_t *sess,
   for (i = 0; i < PIPE_MGR_NUM_DEVICES; ++i) {
     rmt_dev_info_t *d_info = pipe_mgr_get_dev_info(i);
     if (!d_info) continue;
-    while (ilist_pending_full(i)) service_ilist_drs(i);
+    while (ilist_credit_exhausted(i)) service_ilist_drs(i);
   }
 
   return PIPE_SUCCESS;
@@ -3329,12 +3403,16 @@ static inline bf_dev_pipe_t phy_pipe_to_first_log_pipe(rmt_dev_info_t *dev_info,
   return first_log_pipe;
 }
 
-static inline pipe_status_t ilist_push(pipe_mgr_drv_ses_state_t *st,
-                                       rmt_dev_info_t *dev_info,
-                                       bf_subdev_id_t subdev_id,
-                                       pipe_mgr_drv_buf_t *b) {
+/* Log the instruction list if requested and map it for DMA.  On success the
+ * buffer's DMA address is returned in dma_addr. */
+static inline pipe_status_t ilist_prepare(rmt_dev_info_t *dev_info,
+                                          bf_subdev_id_t subdev_id,
+                                          pipe_mgr_drv_buf_t *b,
+                                          bf_dma_addr_t *dma_addr) {
   bf_dev_id_t dev_id = dev_info->dev_id;
 
+  if (b->ts_alloc && !b->ts_fill) b->ts_fill = buf_trace_now();
+
   /* Decode and log the instruction list if needed. */
   if (pipe_mgr_log_ilist(dev_id)) {
     /* Get the first logical pipe this iList is targeting, it will be used to
@@ -3376,17 +3454,27 @@ static inline pipe_status_t ilist_push(pipe_mgr_drv_ses_state_t *st,
   }
 
   /* Map the virtual address of the buffer to the DMA address */
-  bf_dma_addr_t dma_addr;
   if (bf_sys_dma_map(b->pool,
                      b->addr,
                      b->phys_addr,
                      b->size,
-                     &dma_addr,
+                     dma_addr,
                      BF_DMA_FROM_CPU) != 0) {
     LOG_ERROR(
         "Unable to map DMA buffer %p at %s:%d", b->addr, __func__, __LINE__);
     return PIPE_COMM_FAIL;
   }
+  return PIPE_SUCCESS;
+}
+
+static inline pipe_status_t ilist_push(pipe_mgr_drv_ses_state_t *st,
+                                       rmt_dev_info_t *dev_info,
+                                       bf_subdev_id_t subdev_id,
+                                       pipe_mgr_drv_buf_t *b) {
+  bf_dev_id_t dev_id = dev_info->dev_id;
+  bf_dma_addr_t dma_addr;
+  pipe_status_t sts = ilist_prepare(dev_info, subdev_id, b, &dma_addr);
+  if (sts != PIPE_SUCCESS) return sts;
 
   /* Tofino does not support multicast instruction lists. */
   bool use_mcast = dev_info->dev_family != BF_DEV_FAMILY_TOFINO;
@@ -3422,8 +3510,9 @@ static inline pipe_status_t ilist_push(pipe_mgr_drv_ses_state_t *st,
       if (ret) {
         goto push_error;
       }
-      ilist_pending_inc(dev_id, subdev_id, which_dr);
+      ilist_credit_take(dev_id, subdev_id, which_dr);
       b->buf_pushed |= (1 << which_dr);
+      if (b->ts_alloc && !b->ts_push) b->ts_push = buf_trace_now();
     }
   } else {
     for (int phy_pipe = 0; phy_pipe < 4; phy_pipe++) {
@@ -3453,9 +3542,10 @@ static inline pipe_status_t ilist_push(pipe_mgr_drv_ses_state_t *st,
         goto push_error;
       }
 
-      ilist_pending_inc(dev_id, subdev_id, phy_pipe);
+      ilist_credit_take(dev_id, subdev_id, phy_pipe);
 
       b->buf_pushed |= (1 << phy_pipe);
+      if (b->ts_alloc && !b->ts_push) b->ts_push = buf_trace_now();
     }
   }
   return PIPE_SUCCESS;
@@ -3482,6 +3572,89 @@ push_error:
   return PIPE_COMM_FAIL;
 }
 
+/* Maximum number of instruction list buffers handed to LLD in one batched
+ * descriptor push. */
+#define PIPE_MGR_DRV_ILIST_PUSH_BATCH 32
+
+/* Push a batch of already prepared (see ilist_prepare) multicast instruction
+ * list buffers to the first ilist DR of a Tofino2+ device.  The descriptors
+ * are written to the DR with a single lock and tail update per push; if the
+ * DR fills, it is drained the same way ilist_push does before retrying with
+ * the remaining buffers. */
+static pipe_status_t ilist_push_mcast_batch(pipe_mgr_drv_ses_state_t *st,
+                                            rmt_dev_info_t *dev_info,
+                                            bf_subdev_id_t subdev_id,
+                                            pipe_mgr_drv_buf_t **bufs,
+                                            bf_dma_addr_t *dma_addrs,
+                                            int n) {
+  bf_dev_id_t dev_id = dev_info->dev_id;
+  int list_len[PIPE_MGR_DRV_ILIST_PUSH_BATCH];
+  uint32_t mcast_vector[PIPE_MGR_DRV_ILIST_PUSH_BATCH];
+  uint64_t msg_id[PIPE_MGR_DRV_ILIST_PUSH_BATCH];
+  const int which_dr = 0;
+  int done = 0, ret = 0, i;
+
+  for (i = 0; i < n; ++i) {
+    list_len[i] = bufs[i]->used;
+    mcast_vector[i] = bufs[i]->pipeMask;
+    msg_id[i] = bufs[i]->msgId;
+  }
+
+  while (done < n) {
+    ret = lld_subdev_push_ilist_mcast_n(dev_id,
+                                        subdev_id,
+                                        which_dr,
+                                        n - done,
+                                        dma_addrs + done,
+                                        list_len + done,
+                                        false,
+                                        mcast_vector + done,
+                                        msg_id + done);
+    if (ret == LLD_ERR_DR_FULL) {
+      push_ilist_drs(dev_info);
+      PIPE_MGR_UNLOCK(&st->mtx_ses);
+      service_ilist_drs(dev_id);
+      PIPE_MGR_LOCK(&st->mtx_ses);
+      continue;
+    }
+    if (ret <= 0) break;
+    for (i = done; i < done + ret; ++i) {
+      pipe_mgr_drv_buf_t *b = bufs[i];
+      ilist_credit_take(dev_id, subdev_id, which_dr);
+      b->buf_pushed |= (1 << which_dr);
+      if (b->ts_alloc && !b->ts_push) b->ts_push = buf_trace_now();
+    }
+    done += ret;
+  }
+  if (done == n) return PIPE_SUCCESS;
+
+  pipe_mgr_drv_buf_t *b = bufs[done];
+  LOG_ERROR(
+      "%s Push ilist fails %d dev %d subdev %d, msk %x fifo %d "
+      "src 0x%" PRIx64 " size %d id 0x%" PRIx64 ", %d of %d buffers pushed",
+      __func__,
+      ret,
+      dev_id,
+      subdev_id,
+      b->pipeMask,
+      which_dr,
+      dma_addrs[done],
+      b->used,
+      b->msgId,
+      done,
+      n);
+  for (i = done; i < n; ++i) {
+    b = bufs[i];
+    if (bf_sys_dma_unmap(b->pool, b->addr, b->size, BF_DMA_FROM_CPU) != 0) {
+      LOG_ERROR("Unable to unmap DMA buffer %p at %s:%d",
+                b->addr,
+                __func__,
+                __LINE__);
+    }
+  }
+  return PIPE_COMM_FAIL;
+}
+
 /*
  * Push an Instruction List to hardware.
  *
@@ -3512,15 +3685,39 @@ static pipe_status_t pipe_mgr_drv_ilist_push_int(pipe_mgr_drv_ses_state_t *st,
     rmt_dev_info_t *dev_info = pipe_mgr_get_dev_info(i);
     if (!dev_info) continue;
 
+    /* Tofino pushes each buffer to one DR per pipe, later chips multicast
+     * one descriptor per buffer so those descriptors can be pushed in
+     * batches. */
+    bool use_batch = dev_info->dev_family != BF_DEV_FAMILY_TOFINO;
     num_subdevices = pipe_mgr_get_num_active_subdevices(i);
     for (subdev_id = 0; subdev_id < (int)num_subdevices; subdev_id++) {
+      pipe_mgr_drv_buf_t *batch[PIPE_MGR_DRV_ILIST_PUSH_BATCH];
+      bf_dma_addr_t batch_addr[PIPE_MGR_DRV_ILIST_PUSH_BATCH];
+      int batch_cnt = 0;
       pipe_mgr_drv_buf_t *b;
       for (b = il->bufs[i][subdev_id]; b; b = b->next) {
         if (!b->buf_pushed) {
           b->msgId = pipe_mgr_drv_next_msgId(st, i, i_list_msgid_type);
         }
 
-        pipe_status_t sts = ilist_push(st, dev_info, subdev_id, b);
+        pipe_status_t sts;
+        if (use_batch) {
+          sts = ilist_prepare(dev_info, subdev_id, b, &batch_addr[batch_cnt]);
+          if (sts == PIPE_SUCCESS && b->pipeMask) {
+            batch[batch_cnt++] = b;
+          }
+          /* Flush when the batch is full, or before bailing out so the
+           * buffers already prepared are not left mapped but unpushed. */
+          if (batch_cnt == PIPE_MGR_DRV_ILIST_PUSH_BATCH ||
+              (sts != PIPE_SUCCESS && batch_cnt)) {
+            pipe_status_t push_sts = ilist_push_mcast_batch(
+                st, dev_info, subdev_id, batch, batch_addr, batch_cnt);
+            batch_cnt = 0;
+            if (sts == PIPE_SUCCESS) sts = push_sts;
+          }
+        } else {
+          sts = ilist_push(st, dev_info, subdev_id, b);
+        }
         if (sts != PIPE_SUCCESS) {
           PIPE_MGR_UNLOCK(&st->mtx_ses);
           return sts;
@@ -3528,6 +3725,14 @@ static pipe_status_t pipe_mgr_drv_ilist_push_int(pipe_mgr_drv_ses_state_t *st,
 
         ++st->cntrs.iListPushBuf;
       }
+      if (batch_cnt) {
+        pipe_status_t sts = ilist_push_mcast_batch(
+            st, dev_info, subdev_id, batch, batch_addr, batch_cnt);
+        if (sts != PIPE_SUCCESS) {
+          PIPE_MGR_UNLOCK(&st->mtx_ses);
+          return sts;
+        }
+      }
       /* If any buffers were pushed to the device start the DMA. */
       if (il->bufs[i][subdev_id]) {
         push_ilist_drs(dev_info);
@@ -3548,7 +3753,7 @@ static pipe_status_t pipe_mgr_drv_ilist_push_int(pipe_mgr_drv_ses_state_t *st,
   for (i = 0; i < PIPE_MGR_NUM_DEVICES; ++i) {
     rmt_dev_info_t *d_info = pipe_mgr_get_dev_info(i);
     if (!d_info) continue;
-    while (ilist_pending_full(i)) service_ilist_drs(i);
+    while (ilist_credit_exhausted(i)) service_ilist_drs(i);
   }
 
   // LOG_TRACE("Exiting %s", __func__);
@@ -4295,6 +4500,9 @@ static void wr_blk_cmplt(pipe_mgr_drv_ses_state_t *st,
       PIPE_MGR_UNLOCK(&st->mtx_ses);
       return;
     }
+    if (op->buf->ts_alloc) {
+      buf_trace_cmplt(st, PIPE_MGR_DRV_TRACE_DR_WB, op->buf);
+    }
     /* No extra work to do on a write block completion, free the DMA buffer
      * and the state saved in the sesion. */
     // LOG_TRACE("---FREEING MEMORY for DEV %d, msgId %ld ----- \n",
@@ -4511,10 +4719,12 @@ static void i_list_cmplt(pipe_mgr_drv_ses_state_t *st,
   rmt_dev_info_t *dev_info = pipe_mgr_get_dev_info(dev_id);
   bool use_mcast = dev_info && dev_info->dev_family != BF_DEV_FAMILY_TOFINO;
 
+  if (b->ts_alloc) buf_trace_cmplt(st, fifo, b);
+
   if (use_mcast) {
     PIPE_MGR_DBGCHK(b->buf_pushed & (1 << fifo));
 
-    ilist_pending_dec(dev_id, subdev_id, fifo);
+    ilist_credit_return(dev_id, subdev_id, fifo);
 
     ++st->cntrs.iListRsp[subdev_id][fifo];
     /* There is only one completion event for all pipes so set the pipe mask
@@ -4523,7 +4733,7 @@ static void i_list_cmplt(pipe_mgr_drv_ses_state_t *st,
   } else {
     PIPE_MGR_DBGCHK(b->buf_pushed & (1 << fifo));
 
-    ilist_pending_dec(dev_id, subdev_id, fifo);
+    ilist_credit_return(dev_id, subdev_id, fifo);
 
     ++st->cntrs.iListRsp[subdev_id][fifo];
     /* Clear the bit in the pipeMask corresponding to the FIFO on which the
@@ -4646,7 +4856,7 @@ static void i_list_rd_cmplt(pipe_mgr_drv_ses_state_t *st,
 
   PIPE_MGR_DBGCHK(b->buf_pushed & (1 << fifo));
 
-  ilist_pending_dec(dev_id, subdev_id, fifo);
+  ilist_credit_return(dev_id, subdev_id, fifo);
 
   --il->bufCnt;
   /* Calculate the returned data size with a few assumptions.  All reads are 4B
@@ -4798,7 +5008,7 @@ pipe_status_t pipe_mgr_drv_reconfig_ilist_push(pipe_sess_hdl_t *sess,
   for (i = 0; i < PIPE_MGR_NUM_DEVICES; ++i) {
     rmt_dev_info_t *d_info = pipe_mgr_get_dev_info(i);
     if (!d_info) continue;
-    while (ilist_pending_full(i)) service_ilist_drs(i);
+    while (ilist_credit_exhausted(i)) service_ilist_drs(i);
   }
 
   PIPE_MGR_UNLOCK(&st->mtx_ses);
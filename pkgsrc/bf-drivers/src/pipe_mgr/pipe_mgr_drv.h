@@ -48,6 +48,12 @@ extern void dru_hdl_pcie_fifo(void);
 #define PIPE_MGR_DRV_ILIST_ENTRY_MIN_SZ (32 / 8)
 #define PIPE_MGR_DRV_ILIST_ENTRY_MAX_SZ ((32 * 5) / 8)
 
+/* Depth of the per-thread caches on the ilist DMA buffer pool and the
+ * minimum pool size for which they are enabled; small pools are left uncached
+ * so buffers are not stranded in idle threads' caches. */
+#define PIPE_MGR_DRV_BUF_CACHE_DEPTH 16
+#define PIPE_MGR_DRV_BUF_CACHE_MIN_CNT 256
+
 /* Number of request FIFOs that Pipeline Manager uses. */
 #define PIPE_MGR_DRV_FIFO_IDX_CNT 10
 
@@ -226,6 +232,31 @@ struct pipe_mgr_drv_ses_cntr_t {
   uint32_t bufAllocGlbWait;
 };
 
+/* DMA buffer lifecycle trace.  When enabled each instruction list and write
+ * block buffer is time stamped as it moves through the driver and, once the DR
+ * completes it, the time spent in each stage is added to a per-session log2
+ * histogram (bucket N counts durations in [2^N, 2^(N+1)) microseconds).
+ *   FILL  - allocation until the driver stops adding data to the buffer.
+ *   QUEUE - last write until the buffer is accepted by the DR.
+ *   DMA   - push until the completion is serviced. */
+#define PIPE_MGR_DRV_TRACE_DR_WB 4 /* Instruction list DRs are 0-3 */
+#define PIPE_MGR_DRV_TRACE_DR_CNT 5
+#define PIPE_MGR_DRV_TRACE_BKT_CNT 24
+enum pipe_mgr_drv_trace_stage {
+  PIPE_MGR_DRV_TRACE_FILL = 0,
+  PIPE_MGR_DRV_TRACE_QUEUE,
+  PIPE_MGR_DRV_TRACE_DMA,
+  PIPE_MGR_DRV_TRACE_STAGE_CNT
+};
+
+struct pipe_mgr_drv_buf_trace_t {
+  uint32_t cnt[PIPE_MGR_DRV_TRACE_DR_CNT];
+  uint64_t sum_ns[PIPE_MGR_DRV_TRACE_DR_CNT][PIPE_MGR_DRV_TRACE_STAGE_CNT];
+  uint64_t max_ns[PIPE_MGR_DRV_TRACE_DR_CNT][PIPE_MGR_DRV_TRACE_STAGE_CNT];
+  uint32_t hist[PIPE_MGR_DRV_TRACE_DR_CNT][PIPE_MGR_DRV_TRACE_STAGE_CNT]
+               [PIPE_MGR_DRV_TRACE_BKT_CNT];
+};
+
 /* Snapshot of shadow physical memory data before txn start */
 typedef struct pipe_mgr_pre_txn_mem_state_t pipe_mgr_pre_txn_mem_state_t;
 struct pipe_mgr_pre_txn_mem_state_t {
@@ -271,6 +302,8 @@ typedef struct pipe_mgr_drv_ses_state_t {
   pipe_mgr_drv_list_op_t *iListReconfig[PIPE_MGR_NUM_DEVICES];
   /* Debug counters. */
   struct pipe_mgr_drv_ses_cntr_t cntrs;
+  /* DMA buffer lifecycle histograms, protected by mtx_ses. */
+  struct pipe_mgr_drv_buf_trace_t bufTrace;
 
   /* A mutex to protect this session state if multiple threads are working
    * on it.  For example, inserting a new instruction list while a completion
@@ -278,19 +311,35 @@ typedef struct pipe_mgr_drv_ses_state_t {
   pipe_mgr_mutex_t mtx_ses;
 } pipe_mgr_drv_ses_state_t;
 
+#define PIPE_MGR_DRV_ILIST_DR_CNT 4
+
+/* Flow control for an instruction list completion DR.  Every buffer pushed to
+ * an ilist DR takes one credit and its completion returns it.  A DR starts
+ * with as many credits as its completion DR has entries; once they are gone
+ * the completion DR will flow control the Tx DR and pushes must stop until
+ * completions are serviced.  The counters are updated atomically and each
+ * lives on its own cache line so that sessions pushing to different DRs
+ * never contend. */
+typedef struct pipe_mgr_drv_ilist_credit_t {
+  int size;  /* Number of entries in the completion DR. */
+  int avail; /* Credits left, negative once overdrawn. */
+} __attribute__((aligned(64))) pipe_mgr_drv_ilist_credit_t;
+
 struct pipe_mgr_drv_ctx_t {
   pipe_mgr_drv_buf_pool_t gBufPool[PIPE_MGR_NUM_DEVICES][BF_MAX_SUBDEV_COUNT];
   pipe_mgr_drv_ses_state_t sesStates[PIPE_MGR_MAX_SESSIONS];
   pipe_mgr_drv_learn_cfg_t learn_cfg[PIPE_MGR_NUM_DEVICES][BF_MAX_SUBDEV_COUNT];
   pipe_mgr_drv_lrt_cfg_t lrt_cfg[PIPE_MGR_NUM_DEVICES][BF_MAX_SUBDEV_COUNT];
   bool valid[PIPE_MGR_NUM_DEVICES];
+  /* Set to time stamp DMA buffers, see pipe_mgr_drv_buf_trace_t. */
+  bool buf_trace_en;
   pipe_mgr_mutex_t drv_ctx_mtx;
-  int ilist_dr_size[PIPE_MGR_NUM_DEVICES][BF_MAX_SUBDEV_COUNT]
-                   [4];  // One per ilistCmpltion DR
-  int ilist_pending_cnt[PIPE_MGR_NUM_DEVICES][BF_MAX_SUBDEV_COUNT][4];  // One
-                                                                        // per
-                                                                        // ilist
-                                                                        // DR
+  /* Completion DR credits, one per ilist DR per subdevice. */
+  pipe_mgr_drv_ilist_credit_t ilist_credit[PIPE_MGR_NUM_DEVICES]
+                                          [BF_MAX_SUBDEV_COUNT]
+                                          [PIPE_MGR_DRV_ILIST_DR_CNT];
+  /* Number of a device's ilist DRs which have run out of credits. */
+  int ilist_credit_overdrawn[PIPE_MGR_NUM_DEVICES];
 };
 
 struct pipe_mgr_drv_ctx_t *pipe_mgr_drv_ctx();
@@ -307,6 +356,9 @@ pipe_mgr_drv_ses_state_t *pipe_mgr_drv_get_ses_state(pipe_sess_hdl_t *sess_hdl,
 
 pipe_sess_hdl_t pipe_mgr_get_int_sess_hdl(void);
 
+void pipe_mgr_drv_buf_trace_set(bool enable);
+void pipe_mgr_drv_buf_trace_clear(void);
+
 uint32_t pipe_mgr_drv_ilist_locked_size_remaining(pipe_sess_hdl_t sess,
                                                   bf_dev_id_t dev_id);
 
@@ -52,7 +52,14 @@ struct pipe_mgr_drv_buf_t {
   uint8_t subdev;     /*!< Which subdevice the buffer is associated with. */
   uint8_t pipeMask;   /*!< Which pipeline(s) the buffer is targeting. */
   uint8_t buf_pushed; /*!< Which pipeline(s) the buffer has been pushed */
+  uint8_t type;       /*!< Which pool type the buffer was allocated from. */
+  uint8_t sid;        /*!< Which session allocated the buffer. */
   uint64_t msgId;     /*!< Which message the buffer is associated with. */
+  /* Lifecycle timestamps in nanoseconds, only set while DMA buffer tracing is
+   * enabled, zero otherwise. */
+  uint64_t ts_alloc; /*!< When the buffer was allocated. */
+  uint64_t ts_fill;  /*!< When the driver stopped adding data to it. */
+  uint64_t ts_push;  /*!< When it was first handed to a DR. */
   pipe_mgr_drv_buf_t *next; /*!< Next buffer in this list (free/used). */
   pipe_mgr_drv_buf_t *prev; /*!< Next buffer in this list (free/used). */
 };
@@ -10071,9 +10071,8 @@ pipe_status_t pipe_mgr_entry_format_fld_lst_hdl_to_profile(
   return PIPE_OBJ_NOT_FOUND;
 }
 
-uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
-                                     profile_id_t prof_id,
-                                     uint8_t lq_data[48]) {
+uint8_t pipe_mgr_get_digest_cfg_type_width(rmt_dev_info_t *dev_info,
+                                           profile_id_t prof_id) {
   // digest_type field defines width of cfg type field in digest.
   // It must be checked because depending on PHV allocation cfg_type field
   // can end up in differently sized PHVs.
@@ -10133,6 +10132,11 @@ uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
     }
     phv_recs++;
   }
+  return width;
+}
+
+static inline uint8_t digest_cfg_type_from_width(uint8_t width,
+                                                 uint8_t lq_data[48]) {
   // Digest data is 48 byte long, cfg_type is always last so count from the end.
   // cfg_type is max 3 bit wide, so regardless of PHV width value itself will
   // always fit.
@@ -10153,6 +10157,13 @@ uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
   return cfg_type;
 }
 
+uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
+                                     profile_id_t prof_id,
+                                     uint8_t lq_data[48]) {
+  return digest_cfg_type_from_width(
+      pipe_mgr_get_digest_cfg_type_width(dev_info, prof_id), lq_data);
+}
+
 /* Decode a learn quanta (48 bytes of data in lq_data) into a learn digest
  * entry for the application.  Fields will be extracted from the lq_data,
  * padded to a byte boundary and written, in order, to the lrn_digest_entry
@@ -10172,26 +10183,11 @@ uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
  * is 20 bits, rounded up to a byte boundary is 24 bits but we pad it to 32 bits
  * instead.
  */
-pipe_status_t pipe_mgr_entry_format_lrn_decode(rmt_dev_info_t *dev_info,
-                                               profile_id_t prof_id,
-                                               uint8_t pipe,
-                                               uint8_t learn_cfg_type,
-                                               uint8_t lq_data[48],
-                                               void *lrn_digest_entry,
-                                               uint32_t index,
-                                               bool network_order) {
-  uint16_t byte_off, bit_off, phv_off, bit_width, byte_width, shift;
-  uint32_t i = 0, j = 0;
+static pipemgr_tbl_pkg_lq_t *lrn_cfg_type_lq_get(bf_dev_id_t devid,
+                                                 profile_id_t prof_id,
+                                                 uint8_t learn_cfg_type) {
   uint32_t bj_hash;
   pipemgr_tbl_pkg_lut_t *lut_ptr;
-  pipemgr_tbl_pkg_lq_field_t *field_ptr;
-  uint8_t *lrn_digest_mem_ptr = (uint8_t *)lrn_digest_entry;
-  bf_dev_id_t devid = dev_info->dev_id;
-
-  if (dev_info->fake_rmt_cfg) {
-    p4_fake_lrn_decode(pipe, learn_cfg_type, lq_data, lrn_digest_entry, index);
-    return PIPE_SUCCESS;
-  }
 
   bj_hash = bob_jenkin_hash_one_at_a_time(
       PIPE_MGR_TBL_PKG_CTX(devid, prof_id).lq_lut_depth,
@@ -10210,9 +10206,22 @@ pipe_status_t pipe_mgr_entry_format_lrn_decode(rmt_dev_info_t *dev_info,
         "0x%x",
         __func__,
         learn_cfg_type);
-    return 0;
+    return NULL;
   }
-  pipemgr_tbl_pkg_lq_t *lq_ptr = lut_ptr->u.lq_ptr;
+  return lut_ptr->u.lq_ptr;
+}
+
+static pipe_status_t lrn_decode_one(rmt_dev_info_t *dev_info,
+                                    profile_id_t prof_id,
+                                    pipemgr_tbl_pkg_lq_t *lq_ptr,
+                                    uint8_t lq_data[48],
+                                    void *lrn_digest_entry,
+                                    uint32_t index,
+                                    bool network_order) {
+  uint16_t byte_off, bit_off, phv_off, bit_width, byte_width, shift;
+  uint32_t i = 0, j = 0;
+  pipemgr_tbl_pkg_lq_field_t *field_ptr;
+  uint8_t *lrn_digest_mem_ptr = (uint8_t *)lrn_digest_entry;
 
   field_ptr = lq_ptr->fields;
   /* lrn_cfg_type_sz is the size of one digest entry struct.  Use it along with
@@ -10323,6 +10332,103 @@ pipe_status_t pipe_mgr_entry_format_lrn_decode(rmt_dev_info_t *dev_info,
   return PIPE_SUCCESS;
 }
 
+pipe_status_t pipe_mgr_entry_format_lrn_decode(rmt_dev_info_t *dev_info,
+                                               profile_id_t prof_id,
+                                               uint8_t pipe,
+                                               uint8_t learn_cfg_type,
+                                               uint8_t lq_data[48],
+                                               void *lrn_digest_entry,
+                                               uint32_t index,
+                                               bool network_order) {
+  pipemgr_tbl_pkg_lq_t *lq_ptr;
+
+  if (dev_info->fake_rmt_cfg) {
+    p4_fake_lrn_decode(pipe, learn_cfg_type, lq_data, lrn_digest_entry, index);
+    return PIPE_SUCCESS;
+  }
+
+  lq_ptr = lrn_cfg_type_lq_get(dev_info->dev_id, prof_id, learn_cfg_type);
+  if (!lq_ptr) return 0;
+
+  return lrn_decode_one(dev_info,
+                        prof_id,
+                        lq_ptr,
+                        lq_data,
+                        lrn_digest_entry,
+                        index,
+                        network_order);
+}
+
+/* Decode a whole learn buffer.  The per quanta decode looks up the digest type
+ * container and the field layout of the quanta's type for every quanta, here
+ * they are looked up once per batch.  Quanta are appended to
+ * lrn_digest_entries[type] at cur_usage[type] which is advanced.  num_decoded
+ * returns the number of quanta consumed, also when an error stops the batch.
+ */
+pipe_status_t pipe_mgr_entry_format_lrn_decode_batch(
+    rmt_dev_info_t *dev_info,
+    profile_id_t prof_id,
+    uint8_t pipe,
+    uint8_t *lq_data,
+    uint32_t num_lq,
+    void **lrn_digest_entries,
+    uint32_t *cur_usage,
+    uint32_t max_lq,
+    bool network_order,
+    uint32_t *num_decoded) {
+  pipemgr_tbl_pkg_lq_t *lq_ptrs[PIPE_MGR_NUM_LEARN_TYPES] = {NULL};
+  bool lq_looked_up[PIPE_MGR_NUM_LEARN_TYPES] = {false};
+  pipe_status_t rc = PIPE_SUCCESS;
+  uint8_t width = pipe_mgr_get_digest_cfg_type_width(dev_info, prof_id);
+  uint32_t i;
+
+  for (i = 0; i < num_lq; i++, lq_data += LEARN_QUANTA_SIZE) {
+    uint8_t type = digest_cfg_type_from_width(width, lq_data);
+    if (type >= PIPE_MGR_NUM_LEARN_TYPES) {
+      LOG_ERROR("%s:%d Invalid learn_cfg_type %d for dev %d pipe %d",
+                __func__,
+                __LINE__,
+                type,
+                dev_info->dev_id,
+                pipe);
+      PIPE_MGR_DBGCHK(0);
+      rc = PIPE_UNEXPECTED;
+      break;
+    }
+    if (cur_usage[type] >= max_lq) {
+      PIPE_MGR_DBGCHK(cur_usage[type] < max_lq);
+      rc = PIPE_NO_SYS_RESOURCES;
+      break;
+    }
+
+    if (dev_info->fake_rmt_cfg) {
+      p4_fake_lrn_decode(
+          pipe, type, lq_data, lrn_digest_entries[type], cur_usage[type]);
+    } else {
+      if (!lq_looked_up[type]) {
+        lq_ptrs[type] = lrn_cfg_type_lq_get(dev_info->dev_id, prof_id, type);
+        lq_looked_up[type] = true;
+      }
+      /* Same as the per quanta decode, a type without a layout leaves its
+       * digest entry untouched. */
+      if (lq_ptrs[type]) {
+        rc = lrn_decode_one(dev_info,
+                            prof_id,
+                            lq_ptrs[type],
+                            lq_data,
+                            lrn_digest_entries[type],
+                            cur_usage[type],
+                            network_order);
+        if (rc != PIPE_SUCCESS) break;
+      }
+    }
+    cur_usage[type]++;
+  }
+
+  *num_decoded = i;
+  return rc;
+}
+
 bool pipe_mgr_entry_format_is_lrn_type_valid(bf_dev_id_t devid,
                                              profile_id_t prof_id,
                                              int lq_type) {
@@ -26,6 +26,7 @@
  */
 
 /* Standard header includes */
+#include <time.h>
 
 /* Module header includes */
 #include <target-utils/uCli/ucli.h>
@@ -37,6 +38,9 @@
 #include "pipe_mgr_exm_tbl_mgr_int.h"
 #include "pipe_mgr_exm_tbl_init.h"
 #include "pipe_mgr_exm_tbl_dump.h"
+#include "pipe_mgr_exm_hash.h"
+#include "pipe_mgr_hash_compute_json.h"
+#include "pipe_mgr_table_packing.h"
 
 void pipe_mgr_exm_dump_tbl_info(ucli_context_t *uc,
                                 uint8_t device_id,
@@ -1194,6 +1198,7 @@ void pipe_mgr_exm_entry_move_stats_clear(ucli_context_t *uc,
       for (k = 0; k < CUCKOO_MAX_NUM_MOVES + 1; k++) {
         exm_tbl_data->entry_stats.stage_stats[stage].moves[k] = 0;
       }
+      cuckoo_move_graph_search_stats_clear(stage_info->cuckoo_move_graph);
     }
     exm_tbl_data->entry_stats.total_failed = 0;
   }
@@ -1201,6 +1206,71 @@ void pipe_mgr_exm_entry_move_stats_clear(ucli_context_t *uc,
   return;
 }
 
+static void pipe_mgr_exm_cuckoo_search_stats_dump(
+    ucli_context_t *uc, cuckoo_move_graph_t *cuckoo_graph) {
+  cuckoo_search_stats_t *stats;
+  uint32_t k;
+
+  if (!cuckoo_graph) return;
+  stats = &cuckoo_graph->search_stats;
+  aim_printf(&uc->pvs,
+             " Move search: %" PRIu64 " searches, %" PRIu64
+             " no space, %" PRIu64 " over budget\n",
+             stats->searches,
+             stats->no_space,
+             stats->budget_exhausted);
+  aim_printf(&uc->pvs,
+             " Entries visited: avg %" PRIu64 " max %u, time: avg %" PRIu64
+             "ns max %" PRIu64 "ns\n",
+             stats->searches ? stats->nodes_total / stats->searches : 0,
+             stats->nodes_max,
+             stats->searches ? stats->ns_total / stats->searches : 0,
+             stats->ns_max);
+  aim_printf(&uc->pvs,
+             " Budget: %u entries, %uus (0 is unlimited)\n",
+             cuckoo_graph->search_max_nodes,
+             cuckoo_graph->search_budget_ns / 1000);
+  aim_printf(&uc->pvs, " Visited  \t Searches \n");
+  for (k = 0; k < CUCKOO_SEARCH_HIST_CNT; k++) {
+    if (!stats->nodes_hist[k]) continue;
+    aim_printf(&uc->pvs,
+               " %s%u \t \t %u\n",
+               k == CUCKOO_SEARCH_HIST_CNT - 1 ? ">=" : "<",
+               k == CUCKOO_SEARCH_HIST_CNT - 1 ? 1u << (k - 1) : 1u << k,
+               stats->nodes_hist[k]);
+  }
+}
+
+void pipe_mgr_exm_cuckoo_search_budget_set(ucli_context_t *uc,
+                                           bf_dev_id_t dev_id,
+                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                           uint32_t max_nodes,
+                                           uint32_t budget_us) {
+  pipe_mgr_exm_tbl_t *exm_tbl = NULL;
+  pipe_mgr_exm_tbl_data_t *exm_tbl_data = NULL;
+  uint32_t i, j;
+  exm_tbl = pipe_mgr_exm_tbl_get(dev_id, mat_tbl_hdl);
+  if (exm_tbl == NULL) {
+    if (uc) aim_printf(&uc->pvs, "No information found for table\n");
+    return;
+  }
+  if (pipe_mgr_mat_tbl_is_hash_action(dev_id, mat_tbl_hdl)) {
+    if (uc) aim_printf(&uc->pvs, "Hash Action table does not support!\n");
+    return;
+  }
+  for (i = 0; i < exm_tbl->num_tbls; ++i) {
+    exm_tbl_data = &exm_tbl->exm_tbl_data[i];
+    for (j = 0; j < exm_tbl_data->num_stages; j++) {
+      cuckoo_move_graph_search_budget_set(
+          pipe_mgr_exm_get_or_create_cuckoo_move_graph(
+              &exm_tbl_data->exm_stage_info[j]),
+          max_nodes,
+          budget_us);
+    }
+  }
+  if (uc) aim_printf(&uc->pvs, "Move search budget set\n");
+}
+
 void pipe_mgr_exm_entry_move_stats_dump(ucli_context_t *uc,
                                         bf_dev_id_t dev_id,
                                         pipe_mat_tbl_hdl_t mat_tbl_hdl) {
@@ -1235,6 +1305,7 @@ void pipe_mgr_exm_entry_move_stats_dump(ucli_context_t *uc,
                  " Num failed attempts in stage %d : %d \n",
                  stage,
                  exm_tbl_data->entry_stats.failed[stage]);
+      pipe_mgr_exm_cuckoo_search_stats_dump(uc, stage_info->cuckoo_move_graph);
     }
     aim_printf(&uc->pvs,
                "Total failed entry adds on pipe %d: %d \n",
@@ -1243,3 +1314,138 @@ void pipe_mgr_exm_entry_move_stats_dump(ucli_context_t *uc,
   }
   return;
 }
+
+static uint64_t pipe_mgr_exm_hash_check_ns(struct timespec *start) {
+  struct timespec stop;
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  return (stop.tv_sec - start->tv_sec) * 1000000000ull + stop.tv_nsec -
+         start->tv_nsec;
+}
+
+/* Hashes count random keys for every stage of the table with
+ * bf_hash_mat_entry_radix_hash_compute, used when adding entries, and with the
+ * bit by bit bf_hash_mat_entry_hash2_compute, reports any difference and the
+ * time per key of both.
+ */
+void pipe_mgr_exm_hash_check(ucli_context_t *uc,
+                             bf_dev_id_t dev_id,
+                             pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                             uint32_t count) {
+  pipe_mgr_exm_tbl_t *exm_tbl = NULL;
+  pipe_mgr_exm_tbl_data_t *exm_tbl_data = NULL;
+  pipe_tbl_match_spec_t *specs = NULL;
+  pipe_exm_hash_t *radix = NULL, *bitwise = NULL;
+  uint8_t *values = NULL, *mask = NULL;
+  uint32_t bytes, i, j, w, p, mismatch = 0;
+  struct timespec start;
+  uint64_t radix_ns, bitwise_ns;
+
+  exm_tbl = pipe_mgr_exm_tbl_get(dev_id, mat_tbl_hdl);
+  if (exm_tbl == NULL) {
+    aim_printf(&uc->pvs, "No information found for table\n");
+    return;
+  }
+  if (!count) return;
+  bytes = exm_tbl->num_match_spec_bytes;
+  exm_tbl_data = &exm_tbl->exm_tbl_data[0];
+
+  specs = PIPE_MGR_CALLOC(count, sizeof *specs);
+  values = PIPE_MGR_CALLOC((size_t)count * bytes + 1, sizeof *values);
+  mask = PIPE_MGR_MALLOC(bytes + 1);
+  radix = PIPE_MGR_CALLOC((size_t)count * BF_MAX_52B_HASHES, sizeof *radix);
+  bitwise =
+      PIPE_MGR_CALLOC((size_t)count * BF_MAX_52B_HASHES, sizeof *bitwise);
+  if (!specs || !values || !mask || !radix || !bitwise) {
+    aim_printf(&uc->pvs, "Out of memory\n");
+    goto done;
+  }
+  PIPE_MGR_MEMSET(mask, 0xff, bytes + 1);
+  for (i = 0; i < count; i++) {
+    for (j = 0; j < bytes; j++) values[i * bytes + j] = rand();
+    specs[i].match_value_bits = &values[i * bytes];
+    specs[i].match_mask_bits = mask;
+    specs[i].num_match_bytes = bytes;
+    specs[i].num_valid_match_bits = exm_tbl->num_match_spec_bits;
+  }
+
+  aim_printf(&uc->pvs,
+             "%u keys of %u bytes, per key time radix / bitwise:\n",
+             count,
+             bytes);
+  for (j = 0; j < exm_tbl_data->num_stages; j++) {
+    dev_stage_t stage_id = exm_tbl_data->exm_stage_info[j].stage_id;
+    for (p = 0; p < 2; p++) {
+      bool proxy = p == 1;
+      if (proxy && !exm_tbl->proxy_hash) continue;
+      if (!proxy && exm_tbl->hash_action) continue;
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for (i = 0; i < count; i++) {
+        if (bf_hash_mat_entry_radix_hash_compute(
+                dev_id,
+                exm_tbl->profile_id,
+                stage_id,
+                mat_tbl_hdl,
+                &specs[i],
+                proxy,
+                &radix[i * BF_MAX_52B_HASHES]) != PIPE_SUCCESS) {
+          aim_printf(&uc->pvs, "Stage %d: hash compute failed\n", stage_id);
+          goto done;
+        }
+      }
+      radix_ns = pipe_mgr_exm_hash_check_ns(&start);
+
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for (i = 0; i < count; i++) {
+        if (bf_hash_mat_entry_hash2_compute(
+                dev_id,
+                exm_tbl->profile_id,
+                stage_id,
+                mat_tbl_hdl,
+                &specs[i],
+                proxy,
+                &bitwise[i * BF_MAX_52B_HASHES]) != PIPE_SUCCESS) {
+          aim_printf(&uc->pvs, "Stage %d: hash compute failed\n", stage_id);
+          goto done;
+        }
+      }
+      bitwise_ns = pipe_mgr_exm_hash_check_ns(&start);
+
+      for (i = 0; i < count; i++) {
+        for (w = 0; w < BF_MAX_52B_HASHES; w++) {
+          uint32_t k = i * BF_MAX_52B_HASHES + w;
+          if (radix[k].hash_value != bitwise[k].hash_value ||
+              radix[k].num_bits != bitwise[k].num_bits) {
+            if (mismatch++ < 8) {
+              aim_printf(&uc->pvs,
+                         "Stage %d key %u hash %u: 0x%" PRIx64
+                         " bitwise 0x%" PRIx64 "\n",
+                         stage_id,
+                         i,
+                         w,
+                         radix[k].hash_value,
+                         bitwise[k].hash_value);
+            }
+          }
+        }
+      }
+      aim_printf(&uc->pvs,
+                 "Stage %d %s: %" PRIu64 "ns / %" PRIu64 "ns\n",
+                 stage_id,
+                 proxy ? "proxy hash" : "hash",
+                 radix_ns / count,
+                 bitwise_ns / count);
+    }
+  }
+  aim_printf(&uc->pvs,
+             "%s, %u mismatches\n",
+             mismatch ? "FAILED" : "PASSED",
+             mismatch);
+
+done:
+  if (specs) PIPE_MGR_FREE(specs);
+  if (values) PIPE_MGR_FREE(values);
+  if (mask) PIPE_MGR_FREE(mask);
+  if (radix) PIPE_MGR_FREE(radix);
+  if (bitwise) PIPE_MGR_FREE(bitwise);
+}
@@ -68,3 +68,12 @@ void pipe_mgr_exm_entry_move_stats_dump(ucli_context_t *uc,
 void pipe_mgr_exm_entry_move_stats_clear(ucli_context_t *uc,
                                          bf_dev_id_t dev_id,
                                          pipe_mat_tbl_hdl_t mat_tbl_hdl);
+void pipe_mgr_exm_hash_check(ucli_context_t *uc,
+                             bf_dev_id_t dev_id,
+                             pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                             uint32_t count);
+void pipe_mgr_exm_cuckoo_search_budget_set(ucli_context_t *uc,
+                                           bf_dev_id_t dev_id,
+                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                           uint32_t max_nodes,
+                                           uint32_t budget_us);
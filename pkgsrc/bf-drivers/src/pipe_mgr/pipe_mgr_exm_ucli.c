@@ -385,14 +385,18 @@ PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(entry_count) {
 PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(entry_move_stats) {
   PIPE_MGR_CLI_PROLOGUE("entry_move_stats",
                         "Dump exact match table entry move statistics info",
-                        "-d <dev_id> -h <tbl_hdl> [-c] <clear stats>");
+                        "-d <dev_id> -h <tbl_hdl> [-c] <clear stats> "
+                        "[-n <max entries visited per move search>] "
+                        "[-u <max usec per move search>]");
   extern char *optarg;
   int c;
   bf_dev_id_t device_id = 0;
   pipe_mat_tbl_hdl_t exm_tbl_hdl = 0;
   bool clear = false;
+  bool set_budget = false;
+  uint32_t max_nodes = 0, budget_us = 0;
 
-  while ((c = getopt(argc, argv, "d:h:c")) != -1) {
+  while ((c = getopt(argc, argv, "d:h:cn:u:")) != -1) {
     switch (c) {
       case 'd':
         device_id = strtoul(optarg, NULL, 0);
@@ -403,6 +407,14 @@ PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(entry_move_stats) {
       case 'c':
         clear = true;
         break;
+      case 'n':
+        max_nodes = strtoul(optarg, NULL, 0);
+        set_budget = true;
+        break;
+      case 'u':
+        budget_us = strtoul(optarg, NULL, 0);
+        set_budget = true;
+        break;
       default:
         aim_printf(&uc->pvs, "%s", usage);
         return UCLI_STATUS_OK;
@@ -417,7 +429,10 @@ PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(entry_move_stats) {
     aim_printf(&uc->pvs, "tbl_info : Invalid table handle 0x%x\n", exm_tbl_hdl);
     return UCLI_STATUS_OK;
   }
-  if (clear) {
+  if (set_budget) {
+    pipe_mgr_exm_cuckoo_search_budget_set(
+        uc, device_id, exm_tbl_hdl, max_nodes, budget_us);
+  } else if (clear) {
     pipe_mgr_exm_entry_move_stats_clear(uc, device_id, exm_tbl_hdl);
   } else {
     pipe_mgr_exm_entry_move_stats_dump(uc, device_id, exm_tbl_hdl);
@@ -425,6 +440,47 @@ PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(entry_move_stats) {
   return UCLI_STATUS_OK;
 }
 
+PIPE_MGR_EXM_TBL_CLI_CMD_DECLARE(hash_check) {
+  PIPE_MGR_CLI_PROLOGUE(
+      "hash_check",
+      "Check and time the entry add hash against the bit by bit one",
+      "-d <dev_id> -h <tbl_hdl> [-n <number of random keys>]");
+  extern char *optarg;
+  int c;
+  bf_dev_id_t device_id = 0;
+  pipe_mat_tbl_hdl_t exm_tbl_hdl = 0;
+  uint32_t count = 10000;
+
+  while ((c = getopt(argc, argv, "d:h:n:")) != -1) {
+    switch (c) {
+      case 'd':
+        device_id = strtoul(optarg, NULL, 0);
+        break;
+      case 'h':
+        exm_tbl_hdl = strtoul(optarg, NULL, 0);
+        break;
+      case 'n':
+        count = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  if (device_id < 0 || device_id >= PIPE_MGR_NUM_DEVICES) {
+    aim_printf(&uc->pvs, "hash_check : Invalid device_id %d\n", device_id);
+    return UCLI_STATUS_OK;
+  }
+  if (exm_tbl_hdl == 0 || exm_tbl_hdl == 0xFFFFFFFF) {
+    aim_printf(
+        &uc->pvs, "hash_check : Invalid table handle 0x%x\n", exm_tbl_hdl);
+    return UCLI_STATUS_OK;
+  }
+  pipe_mgr_exm_hash_check(uc, device_id, exm_tbl_hdl, count);
+  return UCLI_STATUS_OK;
+}
+
 static ucli_command_handler_f pipe_mgr_exm_tbl_ucli_ucli_handlers__[] = {
     PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(tbl_info),
     PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(hash_info),
@@ -432,6 +488,7 @@ static ucli_command_handler_f pipe_mgr_exm_tbl_ucli_ucli_handlers__[] = {
     PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(entry_phy_info),
     PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(entry_count),
     PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(entry_move_stats),
+    PIPE_MGR_EXM_TBL_CLI_CMD_HNDLR(hash_check),
     NULL};
 
 static ucli_module_t pipe_mgr_exm_tbl_ucli_module__ = {
@@ -372,6 +372,40 @@ pipe_status_t bf_hash_mat_entry_hash2_compute(bf_dev_id_t devid,
   return (PIPE_SUCCESS);
 }
 
+/* Hashes one key against one 52-bit hash of a table with the radix tables of
+ * field_ptr.  The default radix of 4 gets an unrolled path doing two table
+ * lookups per key byte. */
+static inline uint64_t bf_hash_radix_kernel(const bf_hash_field_t *field_ptr,
+                                            const uint8_t *value,
+                                            const uint8_t *mask) {
+  const uint64_t *comb = field_ptr->hash_combinations;
+  uint64_t hash_value = field_ptr->hash_seed;
+  int num_bytes = field_ptr->key_length / 8;
+  int i;
+
+  if (field_ptr->radix_value == 4) {
+    for (i = 0; i < num_bytes; i++, comb += 32) {
+      uint8_t key = value[i] & mask[i];
+      hash_value ^= comb[key & 0xf] ^ comb[16 + (key >> 4)];
+    }
+    return hash_value;
+  }
+
+  uint8_t radix_val = field_ptr->radix_value;
+  uint32_t num_combs_per_fragment = (1 << radix_val);
+  uint8_t radix_mask = (1 << radix_val) - 1;
+  uint8_t fragments_per_byte = 8 / radix_val;
+  for (i = 0; i < num_bytes; i++) {
+    uint8_t key = value[i] & mask[i];
+    for (int j = 0; j < fragments_per_byte; j++) {
+      hash_value ^= comb[key & radix_mask];
+      key >>= radix_val;
+      comb += num_combs_per_fragment;
+    }
+  }
+  return hash_value;
+}
+
 // Hash Computation function for radix based hash algorithm
 pipe_status_t bf_hash_mat_entry_radix_hash_compute(
     bf_dev_id_t devid,
@@ -382,7 +416,6 @@ pipe_status_t bf_hash_mat_entry_radix_hash_compute(
     bool proxy_hash,
     pipe_exm_hash_t *hash_bits) {
   uint32_t bj_hash;
-  uint64_t hash_value;
   bf_hash_field_t *field_ptr;
   bf_hash_tbl_lut *lut_ptr;
 
@@ -406,29 +439,9 @@ pipe_status_t bf_hash_mat_entry_radix_hash_compute(
   for (int w = 0; w < lut_ptr->wide_hash_len; w++) {
     field_ptr = bf_hash_comp_get_hash_field(lut_ptr, devid, prof_id, w);
     if (field_ptr) {
-      hash_value = field_ptr->hash_seed;
-      uint8_t radix_val = field_ptr->radix_value;
-      uint32_t num_combs_per_fragment = (1 << radix_val);
-      uint8_t radix_mask = (1 << radix_val) - 1;
-      uint8_t fragments_per_byte = 8 / radix_val;
-      uint32_t table_offset = 0;
-      uint32_t table_depth_per_byte =
-          fragments_per_byte * num_combs_per_fragment;
-      for (int i = 0; i < field_ptr->key_length / 8; i++) {
-        table_offset = i * table_depth_per_byte;
-        for (int j = 0; j < fragments_per_byte; j++) {
-          // Read the key bits of this fragment
-          uint8_t shifted_radix_mask = radix_mask << (j * radix_val);
-          uint8_t key = match_spec->match_value_bits[i] &
-                        match_spec->match_mask_bits[i] & shifted_radix_mask;
-          key = key >> (j * radix_val);
-          // Compute the index of the hash combinations table
-          uint32_t array_idx = table_offset + j * num_combs_per_fragment + key;
-          hash_value ^= field_ptr->hash_combinations[array_idx];
-        }
-      }
       hash_bits[w].num_bits = BF_RMT_HASH_WIDTH;
-      hash_bits[w].hash_value = hash_value;
+      hash_bits[w].hash_value = bf_hash_radix_kernel(
+          field_ptr, match_spec->match_value_bits, match_spec->match_mask_bits);
     }
 
     else {
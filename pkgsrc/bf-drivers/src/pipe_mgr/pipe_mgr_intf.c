@@ -2914,51 +2914,20 @@ done:
   return ret;
 }
 
-pipe_status_t pipe_mgr_mat_ent_add(
-    pipe_sess_hdl_t sess_hdl,
+/* Checks done on a match entry before it is handed to the table manager for
+ * placement, including whether the key is already in the table.
+ */
+static pipe_status_t pipe_mgr_mat_ent_add_validate(
     dev_target_t dev_tgt,
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_mat_tbl_info_t *mat_tbl_info,
+    enum pipe_mgr_table_owner_t owner,
     pipe_tbl_match_spec_t *match_spec,
     pipe_act_fn_hdl_t act_fn_hdl,
     pipe_action_spec_t *act_spec,
-    uint32_t ttl, /*< TTL value in msecs, 0 for disable */
-    uint32_t pipe_api_flags,
-    pipe_mat_ent_hdl_t *ent_hdl_p) {
-  pipe_status_t ret = ml_api_prologue_v2(sess_hdl, dev_tgt, mat_tbl_hdl);
-  if (PIPE_SUCCESS != ret) return ret;
-
-  pipe_mgr_move_list_t *move_list = NULL;
-  /* Determine table owner. */
-  enum pipe_mgr_table_owner_t owner;
-  owner = pipe_mgr_sm_tbl_owner(dev_tgt.device_id, mat_tbl_hdl);
-
-  pipe_mat_tbl_info_t *mat_tbl_info =
-      pipe_mgr_get_tbl_info(dev_tgt.device_id, mat_tbl_hdl, __func__, __LINE__);
-  if (mat_tbl_info == NULL) {
-    LOG_ERROR(
-        "Error in finding the table info for tbl 0x%x"
-        " device id %d",
-        mat_tbl_hdl,
-        dev_tgt.device_id);
-    ret = PIPE_OBJ_NOT_FOUND;
-    goto done;
-  }
-  if (mat_tbl_info->keyless_info) {
-    LOG_ERROR(
-        "%s:%d Entry add api is not supported for keyless table 0x%x. Use the "
-        "set_default api instead",
-        __func__,
-        __LINE__,
-        mat_tbl_hdl);
-    ret = PIPE_NOT_SUPPORTED;
-    goto done;
-  }
+    uint32_t ttl) {
+  pipe_status_t ret = PIPE_SUCCESS;
 
-  ret = pipe_mgr_verify_pipe_id(
-      dev_tgt, mat_tbl_info, false /* light_pipe_validation */);
-  if (ret != PIPE_SUCCESS) {
-    goto done;
-  }
   if ((mat_tbl_info->match_type == LONGEST_PREFIX_MATCH ||
        mat_tbl_info->match_type == ALPM_MATCH) &&
       match_spec->priority > match_spec->num_valid_match_bits) {
@@ -2967,8 +2936,7 @@ pipe_status_t pipe_mgr_mat_ent_add(
         " for table 0x%x device id %d",
         mat_tbl_hdl,
         dev_tgt.device_id);
-    ret = PIPE_INVALID_ARG;
-    goto done;
+    return PIPE_INVALID_ARG;
   }
   if (IS_ACTION_SPEC_SEL_GRP(act_spec) && act_fn_hdl == 0) {
     /* The action of a selector group is defined by the group members. An
@@ -2980,8 +2948,7 @@ pipe_status_t pipe_mgr_mat_ent_add(
         act_spec->sel_grp_hdl,
         mat_tbl_hdl,
         dev_tgt.device_id);
-    ret = PIPE_INVALID_ARG;
-    goto done;
+    return PIPE_INVALID_ARG;
   }
   /* Perform a sanity check if a ttl is given */
   if (ttl) {
@@ -2995,7 +2962,7 @@ pipe_status_t pipe_mgr_mat_ent_add(
           __LINE__,
           mat_tbl_hdl,
           dev_tgt.device_id);
-      goto done;
+      return ret;
     }
     /* Skip the idletime disable check for virtual devices, as it may be only
      * enabled on the physical device
@@ -3019,15 +2986,11 @@ pipe_status_t pipe_mgr_mat_ent_add(
             params.mode == POLL_MODE ? "poll-mode can only use TTL of 0 or"
                                      : "TTL must be at least",
             params.mode == POLL_MODE ? 1 : params.u.notify.ttl_query_interval);
-        ret = PIPE_INVALID_ARG;
-        goto done;
+        return PIPE_INVALID_ARG;
       }
     }
   }
 
-  /* Prepare flags for the table managers */
-  uint32_t flags = pipe_mgr_sess_in_txn(sess_hdl) ? PIPE_MGR_TBL_API_TXN : 0;
-  flags |= pipe_mgr_sess_in_atomic_txn(sess_hdl) ? PIPE_MGR_TBL_API_ATOM : 0;
   bool exists = false;
   pipe_mat_ent_hdl_t ent_hdl;
   /* Check if the key(match_spec) already exists in the table */
@@ -3036,8 +2999,7 @@ pipe_status_t pipe_mgr_mat_ent_add(
   if (pipe_mgr_match_spec_exists(match_spec) &&
       (PIPE_MGR_TBL_OWNER_PHASE0 != owner)) {
     if (pipe_mgr_check_table_global_key_mask(mat_tbl_info, match_spec)) {
-      ret = PIPE_INVALID_ARG;
-      goto done;
+      return PIPE_INVALID_ARG;
     }
     ret = pipe_mgr_mat_tbl_key_exists(
         mat_tbl_info, match_spec, dev_tgt.dev_pipe_id, &exists, &ent_hdl);
@@ -3048,7 +3010,7 @@ pipe_status_t pipe_mgr_mat_ent_add(
           mat_tbl_hdl,
           dev_tgt.device_id,
           pipe_str_err(ret));
-      goto done;
+      return ret;
     }
   }
 
@@ -3074,9 +3036,71 @@ pipe_status_t pipe_mgr_mat_ent_add(
           dev_tgt.device_id, mat_tbl_hdl, match_spec, buf, sizeof(buf));
       LOG_TRACE("Duplicate match spec for tbl 0x%x :\n%s", mat_tbl_hdl, buf);
     }
-    ret = PIPE_ALREADY_EXISTS;
+    return PIPE_ALREADY_EXISTS;
+  }
+  return PIPE_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_mat_ent_add(
+    pipe_sess_hdl_t sess_hdl,
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_tbl_match_spec_t *match_spec,
+    pipe_act_fn_hdl_t act_fn_hdl,
+    pipe_action_spec_t *act_spec,
+    uint32_t ttl, /*< TTL value in msecs, 0 for disable */
+    uint32_t pipe_api_flags,
+    pipe_mat_ent_hdl_t *ent_hdl_p) {
+  pipe_status_t ret = ml_api_prologue_v2(sess_hdl, dev_tgt, mat_tbl_hdl);
+  if (PIPE_SUCCESS != ret) return ret;
+
+  pipe_mgr_move_list_t *move_list = NULL;
+  /* Determine table owner. */
+  enum pipe_mgr_table_owner_t owner;
+  owner = pipe_mgr_sm_tbl_owner(dev_tgt.device_id, mat_tbl_hdl);
+
+  pipe_mat_tbl_info_t *mat_tbl_info =
+      pipe_mgr_get_tbl_info(dev_tgt.device_id, mat_tbl_hdl, __func__, __LINE__);
+  if (mat_tbl_info == NULL) {
+    LOG_ERROR(
+        "Error in finding the table info for tbl 0x%x"
+        " device id %d",
+        mat_tbl_hdl,
+        dev_tgt.device_id);
+    ret = PIPE_OBJ_NOT_FOUND;
     goto done;
   }
+  if (mat_tbl_info->keyless_info) {
+    LOG_ERROR(
+        "%s:%d Entry add api is not supported for keyless table 0x%x. Use the "
+        "set_default api instead",
+        __func__,
+        __LINE__,
+        mat_tbl_hdl);
+    ret = PIPE_NOT_SUPPORTED;
+    goto done;
+  }
+
+  ret = pipe_mgr_verify_pipe_id(
+      dev_tgt, mat_tbl_info, false /* light_pipe_validation */);
+  if (ret != PIPE_SUCCESS) {
+    goto done;
+  }
+  ret = pipe_mgr_mat_ent_add_validate(dev_tgt,
+                                      mat_tbl_hdl,
+                                      mat_tbl_info,
+                                      owner,
+                                      match_spec,
+                                      act_fn_hdl,
+                                      act_spec,
+                                      ttl);
+  if (ret != PIPE_SUCCESS) {
+    goto done;
+  }
+
+  /* Prepare flags for the table managers */
+  uint32_t flags = pipe_mgr_sess_in_txn(sess_hdl) ? PIPE_MGR_TBL_API_TXN : 0;
+  flags |= pipe_mgr_sess_in_atomic_txn(sess_hdl) ? PIPE_MGR_TBL_API_ATOM : 0;
   if (PIPE_MGR_TBL_OWNER_EXM == owner) {
     ret = pipe_mgr_exm_ent_place(dev_tgt,
                                  mat_tbl_hdl,
@@ -3154,6 +3178,246 @@ done:
   return ret;
 }
 
+static int pipe_mgr_match_spec_ptr_cmp(const void *a, const void *b) {
+  const pipe_tbl_match_spec_t *ms1 = *(pipe_tbl_match_spec_t *const *)a;
+  const pipe_tbl_match_spec_t *ms2 = *(pipe_tbl_match_spec_t *const *)b;
+  int ret;
+
+  if (ms1->partition_index != ms2->partition_index) {
+    return ms1->partition_index < ms2->partition_index ? -1 : 1;
+  }
+  if (ms1->priority != ms2->priority) {
+    return ms1->priority < ms2->priority ? -1 : 1;
+  }
+  if (ms1->num_match_bytes != ms2->num_match_bytes) {
+    return ms1->num_match_bytes < ms2->num_match_bytes ? -1 : 1;
+  }
+  ret = PIPE_MGR_MEMCMP(
+      ms1->match_value_bits, ms2->match_value_bits, ms1->num_match_bytes);
+  if (ret) return ret;
+  return PIPE_MGR_MEMCMP(
+      ms1->match_mask_bits, ms2->match_mask_bits, ms1->num_match_bytes);
+}
+
+/* The key table only catches entries already added, so also look for the
+ * same key twice in the batch.
+ */
+static pipe_status_t pipe_mgr_mat_ent_batch_check_dups(
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_info_t *mat_tbl_info,
+    enum pipe_mgr_table_owner_t owner,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_spec) {
+  pipe_tbl_match_spec_t **sorted = NULL;
+  pipe_status_t ret = PIPE_SUCCESS;
+  uint32_t i;
+
+  if (!mat_tbl_info->duplicate_entry_check || num_entries < 2) {
+    return PIPE_SUCCESS;
+  }
+  sorted = PIPE_MGR_MALLOC(sizeof(pipe_tbl_match_spec_t *) * num_entries);
+  if (!sorted) {
+    LOG_ERROR("%s:%d Malloc failure", __func__, __LINE__);
+    return PIPE_NO_SYS_RESOURCES;
+  }
+  PIPE_MGR_MEMCPY(
+      sorted, match_spec, sizeof(pipe_tbl_match_spec_t *) * num_entries);
+  qsort(sorted,
+        num_entries,
+        sizeof(pipe_tbl_match_spec_t *),
+        pipe_mgr_match_spec_ptr_cmp);
+  for (i = 1; i < num_entries; i++) {
+    if (!pipe_mgr_match_spec_ptr_cmp(&sorted[i - 1], &sorted[i])) {
+      char buf[1000];
+      if (PIPE_MGR_TBL_OWNER_ALPM == owner) {
+        pipe_mgr_alpm_print_match_spec(dev_tgt.device_id,
+                                       mat_tbl_info->handle,
+                                       sorted[i],
+                                       buf,
+                                       sizeof(buf));
+      } else {
+        pipe_mgr_tcam_print_match_spec(dev_tgt.device_id,
+                                       mat_tbl_info->handle,
+                                       sorted[i],
+                                       buf,
+                                       sizeof(buf));
+      }
+      LOG_TRACE("Duplicate match spec in batch for tbl 0x%x :\n%s",
+                mat_tbl_info->handle,
+                buf);
+      ret = PIPE_ALREADY_EXISTS;
+      break;
+    }
+  }
+  PIPE_MGR_FREE(sorted);
+  return ret;
+}
+
+pipe_status_t pipe_mgr_mat_ent_add_batch(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                         uint32_t num_entries,
+                                         pipe_tbl_match_spec_t **match_spec,
+                                         pipe_act_fn_hdl_t *act_fn_hdl,
+                                         pipe_action_spec_t **act_spec,
+                                         uint32_t *ttl,
+                                         uint32_t pipe_api_flags,
+                                         pipe_mat_ent_hdl_t *ent_hdl_p,
+                                         uint32_t *num_added) {
+  pipe_status_t fin_ret;
+  uint32_t i, added = 0;
+
+  if (!num_entries || !match_spec || !act_fn_hdl || !act_spec || !ent_hdl_p) {
+    return PIPE_INVALID_ARG;
+  }
+  if (num_added) *num_added = 0;
+  for (i = 0; i < num_entries; i++) ent_hdl_p[i] = 0;
+
+  pipe_status_t ret = ml_api_prologue_v2(sess_hdl, dev_tgt, mat_tbl_hdl);
+  if (PIPE_SUCCESS != ret) return ret;
+
+  pipe_mgr_move_list_t *move_list = NULL;
+  /* Determine table owner. */
+  enum pipe_mgr_table_owner_t owner;
+  owner = pipe_mgr_sm_tbl_owner(dev_tgt.device_id, mat_tbl_hdl);
+
+  pipe_mat_tbl_info_t *mat_tbl_info =
+      pipe_mgr_get_tbl_info(dev_tgt.device_id, mat_tbl_hdl, __func__, __LINE__);
+  if (mat_tbl_info == NULL) {
+    LOG_ERROR(
+        "Error in finding the table info for tbl 0x%x"
+        " device id %d",
+        mat_tbl_hdl,
+        dev_tgt.device_id);
+    ret = PIPE_OBJ_NOT_FOUND;
+    goto done;
+  }
+  if ((PIPE_MGR_TBL_OWNER_TRN != owner && PIPE_MGR_TBL_OWNER_ALPM != owner) ||
+      mat_tbl_info->keyless_info) {
+    LOG_ERROR(
+        "%s:%d Batch entry add api is only supported for ternary and ALPM "
+        "tables, table 0x%x device id %d",
+        __func__,
+        __LINE__,
+        mat_tbl_hdl,
+        dev_tgt.device_id);
+    ret = PIPE_NOT_SUPPORTED;
+    goto done;
+  }
+
+  ret = pipe_mgr_verify_pipe_id(
+      dev_tgt, mat_tbl_info, false /* light_pipe_validation */);
+  if (ret != PIPE_SUCCESS) {
+    goto done;
+  }
+  for (i = 0; i < num_entries; i++) {
+    if (!match_spec[i] || !act_spec[i]) {
+      ret = PIPE_INVALID_ARG;
+      goto done;
+    }
+    ret = pipe_mgr_mat_ent_add_validate(dev_tgt,
+                                        mat_tbl_hdl,
+                                        mat_tbl_info,
+                                        owner,
+                                        match_spec[i],
+                                        act_fn_hdl[i],
+                                        act_spec[i],
+                                        ttl ? ttl[i] : 0);
+    if (ret != PIPE_SUCCESS) {
+      goto done;
+    }
+  }
+  ret = pipe_mgr_mat_ent_batch_check_dups(
+      dev_tgt, mat_tbl_info, owner, num_entries, match_spec);
+  if (ret != PIPE_SUCCESS) {
+    goto done;
+  }
+
+  /* Prepare flags for the table managers */
+  uint32_t flags = pipe_mgr_sess_in_txn(sess_hdl) ? PIPE_MGR_TBL_API_TXN : 0;
+  flags |= pipe_mgr_sess_in_atomic_txn(sess_hdl) ? PIPE_MGR_TBL_API_ATOM : 0;
+
+  if (PIPE_MGR_TBL_OWNER_ALPM == owner) {
+    ret = pipe_mgr_alpm_entry_place_batch(dev_tgt,
+                                          mat_tbl_hdl,
+                                          num_entries,
+                                          match_spec,
+                                          act_fn_hdl,
+                                          act_spec,
+                                          ttl,
+                                          flags,
+                                          ent_hdl_p,
+                                          &move_list);
+  } else {
+    ret = pipe_mgr_tcam_entry_place_batch(dev_tgt,
+                                          mat_tbl_hdl,
+                                          num_entries,
+                                          match_spec,
+                                          act_fn_hdl,
+                                          act_spec,
+                                          ttl,
+                                          flags,
+                                          ent_hdl_p,
+                                          &move_list);
+  }
+  /* A failure part way leaves the entries placed before it installed, they
+   * still need their keys and their operations processed.  Inside a
+   * transaction the whole batch is aborted instead.
+   */
+  for (i = 0; i < num_entries; i++) {
+    pipe_status_t key_ret;
+    if (!ent_hdl_p[i]) continue;
+    added++;
+    if (!pipe_mgr_match_spec_exists(match_spec[i])) continue;
+    key_ret = pipe_mgr_mat_tbl_key_insert(dev_tgt.device_id,
+                                          mat_tbl_info,
+                                          match_spec[i],
+                                          ent_hdl_p[i],
+                                          dev_tgt.dev_pipe_id,
+                                          pipe_mgr_sess_in_txn(sess_hdl));
+    if (key_ret != PIPE_SUCCESS) {
+      LOG_ERROR(
+          "%s:%d Error in inserting key for tbl 0x%x, device id %d"
+          " into key-based hash table",
+          __func__,
+          __LINE__,
+          mat_tbl_hdl,
+          dev_tgt.device_id);
+      if (ret == PIPE_SUCCESS) ret = key_ret;
+    }
+  }
+  if (ret != PIPE_SUCCESS && (added || move_list) &&
+      !pipe_mgr_sess_in_txn(sess_hdl)) {
+    LOG_ERROR(
+        "%s:%d Batch add to tbl 0x%x device id %d failed with %s after "
+        "adding %d of %d entries",
+        __func__,
+        __LINE__,
+        mat_tbl_hdl,
+        dev_tgt.device_id,
+        pipe_str_err(ret),
+        added,
+        num_entries);
+    fin_ret = ml_api_fin(sess_hdl,
+                         PIPE_SUCCESS,
+                         pipe_api_flags,
+                         dev_tgt.device_id,
+                         mat_tbl_hdl,
+                         move_list);
+    if (num_added) *num_added = added;
+    return fin_ret != PIPE_SUCCESS ? fin_ret : ret;
+  }
+done:
+  fin_ret = ml_api_fin(
+      sess_hdl, ret, pipe_api_flags, dev_tgt.device_id, mat_tbl_hdl, move_list);
+  if (fin_ret != PIPE_SUCCESS) {
+    for (i = 0; i < num_entries; i++) ent_hdl_p[i] = 0;
+    added = 0;
+  }
+  if (num_added) *num_added = added;
+  return fin_ret;
+}
+
 static bool compare_action_data(dev_target_t dev_tgt,
                                 pipe_mat_tbl_info_t *mat_tbl_info,
                                 pipe_action_spec_t *act_spec1,
@@ -5851,6 +6115,52 @@ pipe_status_t pipe_mgr_sel_grp_mbrs_set(pipe_sess_hdl_t sess_hdl,
   return ret;
 }
 
+/*!
+ * API function to apply a batch of member operations to a group
+ */
+pipe_status_t pipe_mgr_sel_grp_mbrs_update(pipe_sess_hdl_t sess_hdl,
+                                           bf_dev_id_t device_id,
+                                           pipe_sel_tbl_hdl_t sel_tbl_hdl,
+                                           pipe_sel_grp_hdl_t sel_grp_hdl,
+                                           uint32_t num_ops,
+                                           pipe_mgr_sel_mbr_op_e *ops,
+                                           pipe_adt_ent_hdl_t *mbrs,
+                                           uint32_t pipe_api_flags) {
+  dev_target_t dev_tgt;
+
+  if (num_ops && (!ops || !mbrs)) return PIPE_INVALID_ARG;
+
+  dev_tgt.device_id = device_id;
+  dev_tgt.dev_pipe_id = num_ops ? PIPE_GET_HDL_PIPE(mbrs[0]) : 0;
+
+  pipe_status_t ret = ml_api_prologue_v2(sess_hdl, dev_tgt, sel_tbl_hdl);
+  if (PIPE_SUCCESS != ret) return ret;
+
+  /* Prepare flags for the table manager. */
+  uint32_t flags = pipe_mgr_sess_in_txn(sess_hdl) ? PIPE_MGR_TBL_API_TXN : 0;
+  flags |= pipe_mgr_sess_in_atomic_txn(sess_hdl) ? PIPE_MGR_TBL_API_ATOM : 0;
+
+  /* Issue the placement function. */
+  pipe_mgr_sel_move_list_t *move_list = NULL;
+  ret = rmt_sel_grp_mbrs_update(sess_hdl,
+                                device_id,
+                                sel_tbl_hdl,
+                                sel_grp_hdl,
+                                num_ops,
+                                ops,
+                                mbrs,
+                                flags,
+                                &move_list);
+
+  ret = ml_api_fin(sess_hdl,
+                   ret,
+                   pipe_api_flags,
+                   device_id,
+                   sel_tbl_hdl,
+                   (pipe_mgr_move_list_t *)move_list);
+  return ret;
+}
+
 /*!
  * API function to get membership of a group
  */
@@ -7681,6 +7991,12 @@ pipe_status_t pipe_mgr_tbl_set_property(pipe_sess_hdl_t sess_hdl,
       rc = pipe_mgr_tbl_set_duplicate_entry_check(
           sess_hdl, dev_id, tbl_hdl, duplicate_check_enable);
       break;
+    case PIPE_MGR_TERN_TABLE_GAP_POLICY:
+      /* For the fixed policy args carries the number of free entries to
+       * leave after each priority band. */
+      rc = pipe_mgr_tbl_set_gap_policy(
+          sess_hdl, dev_id, tbl_hdl, value.gap_policy, args.value);
+      break;
     case PIPE_MGR_IDLETIME_REPEATED_NOTIFICATION:
       if (value.value == PIPE_MGR_IDLETIME_REPEATED_NOTIFICATION_ENABLE) {
         repeated_notify = true;
@@ -7708,6 +8024,9 @@ pipe_status_t pipe_mgr_tbl_get_property(pipe_sess_hdl_t sess_hdl,
   bool duplicate_check_enable = false;
   bool symmetric = false;
   uint32_t scope_value = 0;
+  pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy =
+      PIPE_MGR_TERN_GAP_POLICY_NONE;
+  uint32_t gap_size = 0;
 
   LOG_TRACE("%s: Invoked for sess %d, dev %d, tbl %#x, property %d",
             __func__,
@@ -7751,6 +8070,12 @@ pipe_status_t pipe_mgr_tbl_get_property(pipe_sess_hdl_t sess_hdl,
       }
       args->value = 0;
       break;
+    case PIPE_MGR_TERN_TABLE_GAP_POLICY:
+      rc = pipe_mgr_tbl_get_gap_policy(
+          sess_hdl, dev_id, tbl_hdl, &gap_policy, &gap_size);
+      value->gap_policy = gap_policy;
+      args->value = gap_size;
+      break;
     case PIPE_MGR_IDLETIME_REPEATED_NOTIFICATION:
       rc = pipe_mgr_tbl_get_repeated_notify(
           sess_hdl, dev_id, tbl_hdl, &repeated_notify);
@@ -8170,7 +8495,7 @@ pipe_status_t pipe_mgr_get_n_next_entries(
     if (PIPE_SUCCESS != ret) break;
   }
   *num_returned = i;
-  if (last_ent_hdl) *last_ent_hdl = next_entry_hdls[i - 1];
+  if (last_ent_hdl && i) *last_ent_hdl = next_entry_hdls[i - 1];
 
 done:
   if (next_entry_hdls) PIPE_MGR_FREE(next_entry_hdls);
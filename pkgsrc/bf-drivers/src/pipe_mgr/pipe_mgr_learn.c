@@ -43,7 +43,40 @@
 #include "pipe_mgr_int.h"
 #include "pipe_mgr_learn.h"
 
-static uint64_t learn_digest_count = 0;
+static pipe_mgr_drv_lrn_msg_pool_t *lrn_msg_pool_alloc(uint32_t num_msgs) {
+  pipe_mgr_drv_lrn_msg_pool_t *pool = PIPE_MGR_CALLOC(
+      1, sizeof *pool + num_msgs * sizeof(pipe_mgr_drv_lrn_msg_t));
+  if (!pool) return NULL;
+  pool->num_msgs = num_msgs;
+  for (uint32_t i = 0; i < num_msgs; i++) pool->msgs[i].pool = pool;
+  return pool;
+}
+
+/* Called with the learn_mtx held */
+static void lrn_msg_pool_cleanup(pipe_mgr_drv_lrn_msg_pool_t *pool) {
+  if (!pool) return;
+  if (pool->outstanding) {
+    pool->orphaned = true;
+  } else {
+    PIPE_MGR_FREE(pool);
+  }
+}
+
+/* Return an acked message to its pool, called with the learn_mtx held */
+static void lrn_msg_pool_put(pipe_mgr_drv_lrn_msg_t *m) {
+  pipe_mgr_drv_lrn_msg_pool_t *pool = m->pool;
+  m->outstanding = false;
+  m->msg.entries = NULL;
+  --pool->outstanding;
+  if (pool->orphaned && !pool->outstanding) PIPE_MGR_FREE(pool);
+}
+
+static inline uint64_t learn_elapsed_ns(const struct timespec *start) {
+  struct timespec stop;
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  return (stop.tv_sec - start->tv_sec) * 1000000000ull + stop.tv_nsec -
+         start->tv_nsec;
+}
 
 static inline void prepare_learn_enable_disable(rmt_dev_info_t *dev_info,
                                                 uint8_t phy_pipe_id,
@@ -798,6 +831,8 @@ pipe_status_t pipe_mgr_drv_learn_buf_init(pipe_sess_hdl_t h,
     learn_cfg->network_order = false;
     learn_cfg->intr_learn = false;
     learn_cfg->lrn_dr_tmo_usecs = PIPE_MGR_DEFAULT_LEARN_TIMEOUT;
+    PIPE_MGR_MEMSET(&learn_cfg->stats, 0, sizeof learn_cfg->stats);
+    clock_gettime(CLOCK_MONOTONIC, &learn_cfg->stats.reset_ts);
 
     learn_cfg->bufs = (pipe_mgr_drv_buf_t **)PIPE_MGR_CALLOC(
         learn_cfg->num_bufs, sizeof(pipe_mgr_drv_buf_t *));
@@ -839,7 +874,8 @@ pipe_status_t pipe_mgr_drv_learn_buf_init(pipe_sess_hdl_t h,
           learn_client->num_msgs = num_pipes * PIPE_MGR_LEARN_FILTERS_PER_PIPE;
           learn_client->msgs = (pipe_flow_lrn_msg_t **)PIPE_MGR_CALLOC(
               learn_client->num_msgs, sizeof(pipe_flow_lrn_msg_t *));
-          if (learn_client->msgs == NULL) {
+          learn_client->msg_pool = lrn_msg_pool_alloc(learn_client->num_msgs);
+          if (learn_client->msgs == NULL || learn_client->msg_pool == NULL) {
             LOG_ERROR("%s:%d Malloc failed", __func__, __LINE__);
             ret = PIPE_NO_SYS_RESOURCES;
             goto cleanup;
@@ -1035,6 +1071,12 @@ pipe_status_t pipe_mgr_drv_learn_buf_cleanup(bf_dev_id_t dev_id) {
           PIPE_MGR_FREE(learn_client->msgs);
           learn_client->msgs = NULL;
         }
+        /* Messages still with the client keep their pool alive until they
+         * are acked. */
+        PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+        lrn_msg_pool_cleanup(learn_client->msg_pool);
+        PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
+        learn_client->msg_pool = NULL;
         learn_client->num_msgs = 0;
         learn_client->inuse = false;
       }
@@ -1211,14 +1253,22 @@ static pipe_status_t pipe_mgr_drv_learn_send_to_client(
     pipe_fld_lst_hdl_t fld_lst_hdl =
         pipe_mgr_entry_format_get_handle_of_lrn_cfg_type(dev_id, prof_id, i);
 
-    pipe_flow_lrn_msg_t *lrn_msg =
-        PIPE_MGR_CALLOC(1, sizeof(pipe_flow_lrn_msg_t));
-    if (lrn_msg == NULL) {
+    /* Each pipe and filter has its own message in the pool and a filter is
+     * not drained again before all of its messages are acked, so the slot is
+     * always free here. */
+    uint32_t msg_idx = pipe_id * PIPE_MGR_LEARN_FILTERS_PER_PIPE + filter_idx;
+    pipe_mgr_drv_lrn_msg_t *m = &learn_client->msg_pool->msgs[msg_idx];
+    PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+    if (m->outstanding) {
+      PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
       PIPE_MGR_DBGCHK(0);
       return PIPE_NO_SYS_RESOURCES;
     }
+    m->outstanding = true;
+    learn_client->msg_pool->outstanding++;
+    PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
 
-    uint32_t msg_idx = pipe_id * PIPE_MGR_LEARN_FILTERS_PER_PIPE + filter_idx;
+    pipe_flow_lrn_msg_t *lrn_msg = &m->msg;
     learn_client->msgs[msg_idx] = lrn_msg;
     /* Populate the message */
     lrn_msg->dev_tgt.device_id = dev_id;
@@ -1227,7 +1277,8 @@ static pipe_status_t pipe_mgr_drv_learn_send_to_client(
     lrn_msg->entries = lrn_buf->lrn_digest_entries[i];
     lrn_msg->flow_lrn_fld_lst_hdl = fld_lst_hdl;
 
-    learn_digest_count += lrn_msg->num_entries;
+    learn_cfg->stats.digests += lrn_msg->num_entries;
+    learn_cfg->stats.msgs++;
 
     /* If nobody has registered for this type then ack it now. */
     if (!learn_client->inuse) {
@@ -1511,11 +1562,31 @@ void pipe_mgr_drv_learn_cb(bf_dev_id_t logical_device,
       error = ret;
       goto cleanup;
     }
-  }
-
-  for (; (learn_entry + PIPE_MGR_LEARNQ_SIZE) <= (addr + size);
-       learn_entry += PIPE_MGR_LEARNQ_SIZE) {
-    ret = parse_new_lq(learn_entry, dev_info, prof_id, max_lq, pipe, lrn_buf);
+    learn_cfg->stats.quanta++;
+  }
+
+  /* Decode all complete quanta of the buffer in one batch */
+  uint32_t num_lq = 0;
+  if (learn_entry + PIPE_MGR_LEARNQ_SIZE <= addr + size)
+    num_lq = ((addr + size) - learn_entry) / PIPE_MGR_LEARNQ_SIZE;
+  if (num_lq) {
+    uint32_t num_decoded = 0;
+    struct timespec decode_start;
+    clock_gettime(CLOCK_MONOTONIC, &decode_start);
+    ret = pipe_mgr_entry_format_lrn_decode_batch(dev_info,
+                                                 prof_id,
+                                                 pipe,
+                                                 learn_entry,
+                                                 num_lq,
+                                                 lrn_buf->lrn_digest_entries,
+                                                 lrn_buf->cur_usage,
+                                                 max_lq,
+                                                 learn_cfg->network_order,
+                                                 &num_decoded);
+    learn_cfg->stats.decode_ns += learn_elapsed_ns(&decode_start);
+    learn_cfg->stats.quanta += num_decoded;
+    lrn_buf->count += num_decoded;
+    learn_entry += num_lq * PIPE_MGR_LEARNQ_SIZE;
     if (ret != PIPE_SUCCESS) {
       LOG_ERROR(
           "%s:%d Error parsing new learn quanta dev %d "
@@ -1561,7 +1632,9 @@ void pipe_mgr_drv_learn_cb(bf_dev_id_t logical_device,
   }
 
 cleanup:
+  learn_cfg->stats.dma_bufs++;
   if (error != PIPE_SUCCESS) {
+    learn_cfg->stats.errors++;
     lrn_buf->c_trailing_bytes = 0;
     lrn_buf->count = 0;
   }
@@ -1654,6 +1727,21 @@ pipe_status_t pipe_mgr_lrn_notify_ack(pipe_sess_hdl_t sess_hdl,
     return PIPE_INVALID_ARG;
   }
 
+  /* Messages always come from a pool, a message which is not outstanding has
+   * already been acked and may be in use for the next filter drain. */
+  pipe_mgr_drv_lrn_msg_t *m = (pipe_mgr_drv_lrn_msg_t *)flow_lrn_msg;
+  PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+  bool outstanding = m->outstanding;
+  PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
+  if (!outstanding) {
+    LOG_ERROR("%s:%d Duplicate ack received on dev %d pipe %d",
+              __func__,
+              __LINE__,
+              dev_id,
+              pipe_id);
+    return PIPE_INVALID_ARG;
+  }
+
   rmt_dev_info_t *dev_info = pipe_mgr_get_dev_info(dev_id);
   profile_id_t prof_id = 0;
   if (pipe_mgr_pipe_to_profile(
@@ -1775,7 +1863,10 @@ pipe_status_t pipe_mgr_lrn_notify_ack(pipe_sess_hdl_t sess_hdl,
   }
 
 done:
-  PIPE_MGR_FREE(flow_lrn_msg);
+  PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+  learn_cfg->stats.acks++;
+  lrn_msg_pool_put(m);
+  PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
   return ret;
 }
 
@@ -2049,17 +2140,164 @@ pipe_status_t pipe_mgr_lrn_set_network_order_digest(bf_dev_id_t dev_id,
 
 // Return total count of learn DRs processed
 uint64_t pipe_mgr_flow_lrn_dr_count(bf_dev_id_t dev_id) {
-  UNUSED(dev_id);
-  return learn_digest_count;
+  if (dev_id < 0 || dev_id >= PIPE_MGR_NUM_DEVICES) return 0;
+  return pipe_mgr_drv_ctx()->learn_cfg[dev_id][0].stats.digests;
 }
 
-// Reset count of learn DRs processed
+// Reset count of learn DRs processed along with the other learn counters
 pipe_status_t pipe_mgr_flow_lrn_dr_count_reset(bf_dev_id_t dev_id) {
-  UNUSED(dev_id);
-  learn_digest_count = 0;
+  if (dev_id < 0 || dev_id >= PIPE_MGR_NUM_DEVICES) return PIPE_INVALID_ARG;
+  pipe_mgr_drv_learn_cfg_t *learn_cfg =
+      &pipe_mgr_drv_ctx()->learn_cfg[dev_id][0];
+  PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+  PIPE_MGR_MEMSET(&learn_cfg->stats, 0, sizeof learn_cfg->stats);
+  clock_gettime(CLOCK_MONOTONIC, &learn_cfg->stats.reset_ts);
+  PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
+  return PIPE_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_stats_get(bf_dev_id_t dev_id,
+                                          pipe_mgr_drv_learn_stats_t *stats) {
+  if (dev_id < 0 || dev_id >= PIPE_MGR_NUM_DEVICES || !stats)
+    return PIPE_INVALID_ARG;
+  pipe_mgr_drv_learn_cfg_t *learn_cfg =
+      &pipe_mgr_drv_ctx()->learn_cfg[dev_id][0];
+  PIPE_MGR_LOCK(&learn_cfg->learn_mtx);
+  *stats = learn_cfg->stats;
+  PIPE_MGR_UNLOCK(&learn_cfg->learn_mtx);
   return PIPE_SUCCESS;
 }
 
+static void lrn_bench_cfg_type_set(uint8_t width, uint8_t *lq, uint8_t type) {
+  switch (width) {
+    case 8:
+      lq[47] = type;
+      break;
+    case 16:
+      lq[46] = type;
+      lq[47] = 0;
+      break;
+    case 32:
+      lq[44] = type;
+      lq[45] = lq[46] = lq[47] = 0;
+      break;
+    default:
+      break;
+  }
+}
+
+void pipe_mgr_flow_lrn_decode_bench(ucli_context_t *uc,
+                                    bf_dev_id_t dev_id,
+                                    bf_dev_pipe_t pipe,
+                                    uint32_t count) {
+  void *single[PIPE_MGR_NUM_LEARN_TYPES] = {NULL};
+  void *batch[PIPE_MGR_NUM_LEARN_TYPES] = {NULL};
+  uint32_t single_usage[PIPE_MGR_NUM_LEARN_TYPES] = {0};
+  uint32_t batch_usage[PIPE_MGR_NUM_LEARN_TYPES] = {0};
+  size_t type_sz[PIPE_MGR_NUM_LEARN_TYPES] = {0};
+  uint8_t types[PIPE_MGR_NUM_LEARN_TYPES];
+  uint32_t num_types = 0, num_decoded = 0, mismatch = 0, i;
+  uint8_t *lq = NULL;
+  struct timespec start;
+  uint64_t single_ns, batch_ns;
+  profile_id_t prof_id = 0;
+
+  rmt_dev_info_t *dev_info = pipe_mgr_get_dev_info(dev_id);
+  if (!dev_info || !count) return;
+  if (pipe_mgr_pipe_to_profile(dev_info, pipe, &prof_id, __func__, __LINE__) !=
+      PIPE_SUCCESS) {
+    aim_printf(&uc->pvs, "Invalid pipe %d\n", pipe);
+    return;
+  }
+  bool network_order = pipe_mgr_drv_ctx()->learn_cfg[dev_id][0].network_order;
+
+  for (i = 0; i < PIPE_MGR_NUM_LEARN_TYPES; i++) {
+    if (!pipe_mgr_entry_format_is_lrn_type_valid(dev_id, prof_id, i)) continue;
+    type_sz[i] = pipe_mgr_entry_format_lrn_cfg_type_sz(dev_id, prof_id, i);
+    if (!type_sz[i]) continue;
+    types[num_types++] = i;
+    single[i] = PIPE_MGR_CALLOC(count, type_sz[i]);
+    batch[i] = PIPE_MGR_CALLOC(count, type_sz[i]);
+    if (!single[i] || !batch[i]) {
+      aim_printf(&uc->pvs, "Out of memory\n");
+      goto done;
+    }
+  }
+  uint8_t width = pipe_mgr_get_digest_cfg_type_width(dev_info, prof_id);
+  if (!num_types || (!width && !dev_info->fake_rmt_cfg)) {
+    aim_printf(&uc->pvs, "No learn digests in the profile of pipe %d\n", pipe);
+    goto done;
+  }
+
+  /* Random quanta, spread round robin over the learn types */
+  lq = PIPE_MGR_MALLOC((size_t)count * PIPE_MGR_LEARNQ_SIZE);
+  if (!lq) {
+    aim_printf(&uc->pvs, "Out of memory\n");
+    goto done;
+  }
+  for (i = 0; i < count * PIPE_MGR_LEARNQ_SIZE; i++) lq[i] = rand();
+  for (i = 0; i < count; i++) {
+    lrn_bench_cfg_type_set(
+        width, &lq[i * PIPE_MGR_LEARNQ_SIZE], types[i % num_types]);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < count; i++) {
+    uint8_t *q = &lq[i * PIPE_MGR_LEARNQ_SIZE];
+    uint8_t type = pipe_mgr_get_digest_cfg_type(dev_info, prof_id, q);
+    if (type >= PIPE_MGR_NUM_LEARN_TYPES) break;
+    pipe_mgr_entry_format_lrn_decode(dev_info,
+                                     prof_id,
+                                     pipe,
+                                     type,
+                                     q,
+                                     single[type],
+                                     single_usage[type]++,
+                                     network_order);
+  }
+  single_ns = learn_elapsed_ns(&start);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  pipe_mgr_entry_format_lrn_decode_batch(dev_info,
+                                         prof_id,
+                                         pipe,
+                                         lq,
+                                         count,
+                                         batch,
+                                         batch_usage,
+                                         count,
+                                         network_order,
+                                         &num_decoded);
+  batch_ns = learn_elapsed_ns(&start);
+
+  for (i = 0; i < num_types; i++) {
+    uint8_t t = types[i];
+    if (single_usage[t] != batch_usage[t] ||
+        PIPE_MGR_MEMCMP(single[t], batch[t], single_usage[t] * type_sz[t])) {
+      aim_printf(&uc->pvs, "Learn type %d: decoded digests differ\n", t);
+      mismatch++;
+    }
+  }
+  if (num_decoded != count) mismatch++;
+
+  aim_printf(&uc->pvs,
+             "%u quanta of %u learn types, per quanta single %" PRIu64
+             "ns / batch %" PRIu64 "ns, batch rate %" PRIu64 " quanta/s\n",
+             count,
+             num_types,
+             single_ns / count,
+             batch_ns / count,
+             batch_ns ? count * 1000000000ull / batch_ns : 0);
+  aim_printf(&uc->pvs, "%s\n", mismatch ? "FAILED" : "PASSED");
+
+done:
+  if (lq) PIPE_MGR_FREE(lq);
+  for (i = 0; i < PIPE_MGR_NUM_LEARN_TYPES; i++) {
+    if (single[i]) PIPE_MGR_FREE(single[i]);
+    if (batch[i]) PIPE_MGR_FREE(batch[i]);
+  }
+}
+
 // Enable or disable learn DR interrupt processing
 pipe_status_t pipe_mgr_flow_lrn_int_enable(bf_dev_id_t dev_id, bool en) {
   uint32_t reg = 0, msk = 0, en0 = 0;
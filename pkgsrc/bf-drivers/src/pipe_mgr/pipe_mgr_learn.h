@@ -43,6 +43,28 @@
 #define TOFINO2_CBC_CBUS_INT_STAT_LQ_RX_DR_EMPTY 0x80000
 #define TOFINO3_CBC_CBUS_INT_STAT_LQ_RX_DR_EMPTY 0x80000
 
+struct pipe_mgr_drv_lrn_msg_pool_s;
+
+/* A learn message handed to the client.  The client only sees msg, pool lets
+ * the ack find its way back to the pool the message was taken from. */
+typedef struct pipe_mgr_drv_lrn_msg_s {
+  pipe_flow_lrn_msg_t msg;  // Must be first
+  struct pipe_mgr_drv_lrn_msg_pool_s *pool;
+  bool outstanding;
+} pipe_mgr_drv_lrn_msg_t;
+
+/* Learn messages are preallocated, one per pipe and learn filter just like the
+ * msgs array of the client, and reused once the client acks them instead of
+ * being allocated for every filter drain.  If the learn buffers are cleaned up
+ * while messages are still with the client the pool is orphaned and freed by
+ * the last ack.  Protected by the learn_mtx of the device. */
+typedef struct pipe_mgr_drv_lrn_msg_pool_s {
+  uint32_t num_msgs;
+  uint32_t outstanding;
+  bool orphaned;
+  pipe_mgr_drv_lrn_msg_t msgs[];
+} pipe_mgr_drv_lrn_msg_pool_t;
+
 typedef struct pipe_mgr_drv_learn_client_s_ {
   bool inuse;
   pipe_fld_lst_hdl_t fld_lst_hdl;
@@ -50,6 +72,7 @@ typedef struct pipe_mgr_drv_learn_client_s_ {
   void *callback_fn_cookie;
   uint32_t num_msgs;
   pipe_flow_lrn_msg_t **msgs;  // Array of size num_msgs
+  pipe_mgr_drv_lrn_msg_pool_t *msg_pool;  // num_msgs messages
 
 } pipe_mgr_drv_learn_client_t;
 
@@ -136,6 +159,23 @@ typedef struct bf_learn_filter_trace_t {
   void *ptr;
 } bf_learn_filter_trace_t;
 
+/* Learn throughput counters, kept per device */
+typedef struct pipe_mgr_drv_learn_stats_s {
+  /* Learn DMA buffers received */
+  uint64_t dma_bufs;
+  /* Learn quanta decoded and the time spent decoding them */
+  uint64_t quanta;
+  uint64_t decode_ns;
+  /* Digests and messages passed to clients and messages acked */
+  uint64_t digests;
+  uint64_t msgs;
+  uint64_t acks;
+  /* DMA buffers which could not be processed */
+  uint64_t errors;
+  /* When the counters were last reset */
+  struct timespec reset_ts;
+} pipe_mgr_drv_learn_stats_t;
+
 /* Learn config pipeline profile based */
 typedef struct pipe_mgr_drv_learn_profile_s_ {
   profile_id_t prof_id;
@@ -194,6 +234,8 @@ typedef struct pipe_mgr_drv_learn_cfg_s_ {
 #define PIPE_MGR_LEARN_TRACE_SIZE 32
 #define PIPE_MGR_LEARN_TRACE_MASK 0x1F
 
+  pipe_mgr_drv_learn_stats_t stats;
+
 } pipe_mgr_drv_learn_cfg_t;
 
 pipe_status_t pipe_mgr_lrn_notification_register(
@@ -236,6 +278,17 @@ uint64_t pipe_mgr_flow_lrn_dr_count(bf_dev_id_t dev_id);
 /* Reset count of learn DRs processed */
 pipe_status_t pipe_mgr_flow_lrn_dr_count_reset(bf_dev_id_t dev_id);
 
+/* Get a copy of the learn throughput counters */
+pipe_status_t pipe_mgr_flow_lrn_stats_get(bf_dev_id_t dev_id,
+                                          pipe_mgr_drv_learn_stats_t *stats);
+
+/* Decode count synthetic learn quanta of the pipe's profile per quanta and in
+ * a batch, compare the results and print the time taken by both */
+void pipe_mgr_flow_lrn_decode_bench(ucli_context_t *uc,
+                                    bf_dev_id_t dev_id,
+                                    bf_dev_pipe_t pipe,
+                                    uint32_t count);
+
 /* Enable or disable learn DR interrupt processing */
 pipe_status_t pipe_mgr_flow_lrn_int_enable(bf_dev_id_t dev_id, bool en);
 
@@ -26,6 +26,7 @@
 /* Standard includes */
 #include <getopt.h>
 #include <limits.h>
+#include <time.h>
 
 /* Module includes */
 #include <dvm/bf_drv_intf.h>
@@ -160,11 +161,111 @@ PIPE_MGR_LEARN_CLI_CMD_DECLARE(lrn_cnt) {
   return UCLI_STATUS_OK;
 }
 
+PIPE_MGR_LEARN_CLI_CMD_DECLARE(lrn_stats) {
+  PIPE_MGR_CLI_PROLOGUE(
+      "lrn_stats", "Print the learn throughput counters", "-d <dev_id>");
+
+  bool got_dev = false;
+
+  bf_dev_id_t dev_id = 0;
+  pipe_mgr_drv_learn_stats_t stats;
+
+  int x;
+  while (-1 != (x = getopt(argc, argv, "d:"))) {
+    switch (x) {
+      case 'd':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        dev_id = strtoul(optarg, NULL, 0);
+        got_dev = true;
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+  if (!got_dev || pipe_mgr_flow_lrn_stats_get(dev_id, &stats)) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint64_t ms = (now.tv_sec - stats.reset_ts.tv_sec) * 1000ull +
+                (now.tv_nsec - stats.reset_ts.tv_nsec) / 1000000;
+  if (!ms) ms = 1;
+
+  aim_printf(&uc->pvs, "Since reset   : %" PRIu64 " ms\n", ms);
+  aim_printf(&uc->pvs, "DMA buffers   : %" PRIu64 "\n", stats.dma_bufs);
+  aim_printf(&uc->pvs, "Errors        : %" PRIu64 "\n", stats.errors);
+  aim_printf(&uc->pvs,
+             "Quanta        : %" PRIu64 " (%" PRIu64 "/s)\n",
+             stats.quanta,
+             stats.quanta * 1000 / ms);
+  aim_printf(&uc->pvs,
+             "Decode time   : %" PRIu64 " ns/quanta\n",
+             stats.quanta ? stats.decode_ns / stats.quanta : 0);
+  aim_printf(&uc->pvs,
+             "Digests       : %" PRIu64 " (%" PRIu64 "/s)\n",
+             stats.digests,
+             stats.digests * 1000 / ms);
+  aim_printf(&uc->pvs,
+             "Messages      : %" PRIu64 " sent, %" PRIu64 " acked\n",
+             stats.msgs,
+             stats.acks);
+
+  return UCLI_STATUS_OK;
+}
+
+PIPE_MGR_LEARN_CLI_CMD_DECLARE(lrn_bench) {
+  PIPE_MGR_CLI_PROLOGUE(
+      "lrn_bench",
+      "Decode synthetic learn quanta per quanta and in a batch",
+      "-d <dev_id> -p <pipe> [-n <number of quanta>]");
+
+  bool got_dev = false;
+
+  bf_dev_id_t dev_id = 0;
+  bf_dev_pipe_t pipe = 0;
+  uint32_t count = 100000;
+
+  int x;
+  while (-1 != (x = getopt(argc, argv, "d:p:n:"))) {
+    switch (x) {
+      case 'd':
+        dev_id = strtoul(optarg, NULL, 0);
+        got_dev = true;
+        break;
+      case 'p':
+        pipe = strtoul(optarg, NULL, 0);
+        break;
+      case 'n':
+        count = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+  if (!got_dev || dev_id < 0 || dev_id >= PIPE_MGR_NUM_DEVICES) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+
+  pipe_mgr_flow_lrn_decode_bench(uc, dev_id, pipe, count);
+
+  return UCLI_STATUS_OK;
+}
+
 /* <auto.ucli.handlers.start> */
 static ucli_command_handler_f pipe_mgr_learn_ucli_ucli_handlers__[] = {
     PIPE_MGR_LEARN_CLI_CMD_HNDLR(lrn_cnt),
     PIPE_MGR_LEARN_CLI_CMD_HNDLR(lrn_cnt_reset),
     PIPE_MGR_LEARN_CLI_CMD_HNDLR(lrn_int_ena),
+    PIPE_MGR_LEARN_CLI_CMD_HNDLR(lrn_stats),
+    PIPE_MGR_LEARN_CLI_CMD_HNDLR(lrn_bench),
     NULL};
 
 /* <auto.ucli.handlers.end> */
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*!
+ * @file pipe_mgr_sel_mbr_ops.c
+ * @date
+ *
+ * Folding of a batch of selector member operations into a membership.
+ *
+ * Only the membership arrays are changed, the result is programmed by the
+ * caller as a single update of the group.
+ */
+
+/* Standard header includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Module header includes */
+#include <pipe_mgr/pipe_mgr_porting.h>
+
+/* Local header includes */
+#include "pipe_mgr_sel_mbr_ops.h"
+
+pipe_status_t pipe_mgr_sel_mbr_ops_apply(uint32_t num_ops,
+                                         const pipe_mgr_sel_mbr_op_e *ops,
+                                         const pipe_adt_ent_hdl_t *op_mbrs,
+                                         pipe_adt_ent_hdl_t *mbrs,
+                                         bool *enable,
+                                         uint32_t *num_mbrs_p,
+                                         uint32_t *err_idx_p) {
+  uint32_t num_mbrs = *num_mbrs_p;
+  pipe_status_t rc = PIPE_SUCCESS;
+  uint32_t i, j;
+
+  for (i = 0; i < num_ops; i++) {
+    bool found = false;
+    switch (ops[i]) {
+      case PIPE_MGR_SEL_MBR_OP_ADD:
+      case PIPE_MGR_SEL_MBR_OP_ADD_DISABLED:
+        mbrs[num_mbrs] = op_mbrs[i];
+        enable[num_mbrs] = ops[i] == PIPE_MGR_SEL_MBR_OP_ADD;
+        num_mbrs++;
+        found = true;
+        break;
+      case PIPE_MGR_SEL_MBR_OP_DEL:
+        /* Remove the last instance so earlier positions are preserved. */
+        for (j = num_mbrs; j > 0; j--) {
+          if (mbrs[j - 1] != op_mbrs[i]) continue;
+          memmove(&mbrs[j - 1],
+                  &mbrs[j],
+                  (num_mbrs - j) * sizeof(pipe_adt_ent_hdl_t));
+          memmove(&enable[j - 1], &enable[j], (num_mbrs - j) * sizeof(bool));
+          num_mbrs--;
+          found = true;
+          break;
+        }
+        break;
+      case PIPE_MGR_SEL_MBR_OP_ENABLE:
+      case PIPE_MGR_SEL_MBR_OP_DISABLE:
+        for (j = 0; j < num_mbrs; j++) {
+          if (mbrs[j] != op_mbrs[i]) continue;
+          enable[j] = ops[i] == PIPE_MGR_SEL_MBR_OP_ENABLE;
+          found = true;
+        }
+        break;
+      default:
+        rc = PIPE_INVALID_ARG;
+        break;
+    }
+    if (rc == PIPE_SUCCESS && !found) rc = PIPE_OBJ_NOT_FOUND;
+    if (rc != PIPE_SUCCESS) {
+      *err_idx_p = i;
+      break;
+    }
+  }
+
+  *num_mbrs_p = num_mbrs;
+  return rc;
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#ifndef PIPE_MGR_SEL_MBR_OPS_H_INCLUDED
+#define PIPE_MGR_SEL_MBR_OPS_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+
+/*
+ * Usage: pipe_mgr_sel_mbr_ops_apply(num_ops, ops, op_mbrs, mbrs, enable, ...)
+ * ---------------------------------------------------------------------------
+ * Applies a list of member operations in order to a membership of num_mbrs_p
+ * members. An add appends one instance of the member, a delete removes its
+ * last instance and enable/disable act on every instance. The arrays must
+ * have room for one more member per add. Returns PIPE_INVALID_ARG for an
+ * unknown operation and PIPE_OBJ_NOT_FOUND for a member not in the group, with
+ * the index of that operation in err_idx_p; the membership is then partially
+ * updated.
+ */
+pipe_status_t pipe_mgr_sel_mbr_ops_apply(uint32_t num_ops,
+                                         const pipe_mgr_sel_mbr_op_e *ops,
+                                         const pipe_adt_ent_hdl_t *op_mbrs,
+                                         pipe_adt_ent_hdl_t *mbrs,
+                                         bool *enable,
+                                         uint32_t *num_mbrs_p,
+                                         uint32_t *err_idx_p);
+
+#endif  // PIPE_MGR_SEL_MBR_OPS_H_INCLUDED
@@ -25,6 +25,7 @@
  *****************************************************************************/
 /* Standard includes */
 #include <getopt.h>
+#include <inttypes.h>
 #include <limits.h>
 
 /* Module includes */
@@ -362,6 +363,10 @@ pipe_status_t pipe_mgr_sel_tbl_dump_one(ucli_context_t *uc,
         aim_printf(&uc->pvs, "%d ", q);
       }
       aim_printf(&uc->pvs, "\n");
+      aim_printf(&uc->pvs,
+                 "    Word updates : %" PRIu64 "  Word writes : %" PRIu64 "\n",
+                 sel_tbl->llp.word_updates,
+                 sel_tbl->llp.word_writes);
     }
   }
   return PIPE_SUCCESS;
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*!
+ * @file pipe_mgr_sel_word_log.c
+ * @date
+ *
+ * Log of the selector words changed by a move list.
+ *
+ * The hardware writes of the words are deferred to the end of the list, so
+ * a word touched by several nodes is written once.  The log keeps what the
+ * hardware holds so unchanged words are not written at all, and what each
+ * word held before the node being processed so a failed node leaves no trace
+ * in the writes.
+ */
+
+/* Standard header includes */
+#include <stdlib.h>
+
+/* Module header includes */
+#include <pipe_mgr/pipe_mgr_porting.h>
+
+/* Local header includes */
+#include "pipe_mgr_sel_word_log.h"
+
+sel_llp_pending_word_t *pipe_mgr_sel_word_log_get(sel_llp_word_log_t *log,
+                                                  uint32_t idx,
+                                                  uint8_t stage_idx,
+                                                  uint32_t word_idx) {
+  sel_llp_pending_word_t *word;
+
+  if (idx >= log->num_words) return NULL;
+  word = &log->words[idx];
+  if (word->stage_idx != stage_idx || word->word_idx != word_idx) return NULL;
+  return word;
+}
+
+pipe_status_t pipe_mgr_sel_word_log_add(sel_llp_word_log_t *log,
+                                        uint8_t stage_idx,
+                                        uint32_t word_idx,
+                                        const uint8_t *data,
+                                        uint32_t data_bytes,
+                                        uint32_t *idx_p) {
+  sel_llp_pending_word_t *word;
+
+  if (data_bytes > SEL_LLP_WORD_DATA_BYTES) {
+    data_bytes = SEL_LLP_WORD_DATA_BYTES;
+  }
+
+  word = pipe_mgr_sel_word_log_get(log, *idx_p, stage_idx, word_idx);
+  if (word) {
+    if (*idx_p < log->node_first && word->node_seq != log->node_seq) {
+      PIPE_MGR_MEMCPY(word->node_data, data, data_bytes);
+      word->node_seq = log->node_seq;
+    }
+    return PIPE_SUCCESS;
+  }
+
+  if (log->num_words == log->max_words) {
+    uint32_t max = log->max_words ? log->max_words * 2 : 64;
+    word = PIPE_MGR_REALLOC(log->words, max * sizeof(sel_llp_pending_word_t));
+    if (!word) return PIPE_NO_SYS_RESOURCES;
+    log->words = word;
+    log->max_words = max;
+  }
+
+  *idx_p = log->num_words++;
+  word = &log->words[*idx_p];
+  PIPE_MGR_MEMSET(word, 0, sizeof(sel_llp_pending_word_t));
+  word->stage_idx = stage_idx;
+  word->word_idx = word_idx;
+  PIPE_MGR_MEMCPY(word->hw_data, data, data_bytes);
+  word->node_seq = log->node_seq;
+  return PIPE_SUCCESS;
+}
+
+void pipe_mgr_sel_word_log_node_start(sel_llp_word_log_t *log) {
+  log->node_seq++;
+  log->node_first = log->num_words;
+}
+
+void pipe_mgr_sel_word_log_node_abort(sel_llp_word_log_t *log) {
+  uint32_t i;
+
+  log->num_words = log->node_first;
+  /* A word the node wrote early may have had that write rolled back, so
+   * hw_data is not trusted for the words it changed. */
+  for (i = 0; i < log->num_words; i++) {
+    if (log->words[i].node_seq == log->node_seq) log->words[i].rewrite = true;
+  }
+}
+
+void pipe_mgr_sel_word_log_written(sel_llp_pending_word_t *word,
+                                   const uint8_t *data,
+                                   uint32_t data_bytes) {
+  if (data_bytes > SEL_LLP_WORD_DATA_BYTES) {
+    data_bytes = SEL_LLP_WORD_DATA_BYTES;
+  }
+  PIPE_MGR_MEMCPY(word->hw_data, data, data_bytes);
+}
+
+uint8_t *pipe_mgr_sel_word_log_flush_data(sel_llp_pending_word_t *word,
+                                          uint8_t *data,
+                                          uint32_t data_bytes) {
+  if (data_bytes > SEL_LLP_WORD_DATA_BYTES) {
+    data_bytes = SEL_LLP_WORD_DATA_BYTES;
+  }
+  if (word->rewrite) return word->node_data;
+  if (!PIPE_MGR_MEMCMP(data, word->hw_data, data_bytes)) return NULL;
+  return data;
+}
+
+void pipe_mgr_sel_word_log_reset(sel_llp_word_log_t *log) {
+  log->num_words = 0;
+  log->node_first = 0;
+}
+
+void pipe_mgr_sel_word_log_destroy(sel_llp_word_log_t *log) {
+  if (log->words) PIPE_MGR_FREE(log->words);
+  PIPE_MGR_MEMSET(log, 0, sizeof(sel_llp_word_log_t));
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#ifndef PIPE_MGR_SEL_WORD_LOG_H_INCLUDED
+#define PIPE_MGR_SEL_WORD_LOG_H_INCLUDED
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+
+/* Largest selector RAM word in bytes, the PVL usage is in the last byte. */
+#define SEL_LLP_WORD_DATA_BYTES 16
+
+/* A selector word whose hardware write is deferred until the end of the move
+ * list being processed. */
+typedef struct sel_llp_pending_word_s {
+  uint8_t stage_idx;
+  uint32_t word_idx;
+  // Word contents as last written to the hardware
+  uint8_t hw_data[SEL_LLP_WORD_DATA_BYTES];
+  // Word contents before the move list node node_seq changed it, only kept
+  // for words already logged by an earlier node
+  uint8_t node_data[SEL_LLP_WORD_DATA_BYTES];
+  uint32_t node_seq;
+  // Set when a failed node changed the word, node_data is then written
+  // whatever hw_data holds
+  bool rewrite;
+} sel_llp_pending_word_t;
+
+/* The selector words changed by the move list being processed. */
+typedef struct sel_llp_word_log_s {
+  sel_llp_pending_word_t *words;
+  uint32_t num_words;
+  uint32_t max_words;
+  // Move list node being processed and the first word it logged
+  uint32_t node_seq;
+  uint32_t node_first;
+} sel_llp_word_log_t;
+
+/*
+ * Usage: pipe_mgr_sel_word_log_get(log, idx, stage_idx, word_idx)
+ * ---------------------------------------------------------------
+ * Returns the logged word at idx if it is the given word, NULL otherwise.
+ */
+sel_llp_pending_word_t *pipe_mgr_sel_word_log_get(sel_llp_word_log_t *log,
+                                                  uint32_t idx,
+                                                  uint8_t stage_idx,
+                                                  uint32_t word_idx);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_add(log, stage_idx, word_idx, data, ...)
+ * ---------------------------------------------------------------------
+ * Logs a word about to be changed by the current node, data holds its current
+ * contents. A word not logged yet is added with data as its hardware contents
+ * and its index is returned in idx_p. A word logged by an earlier node keeps
+ * data as its contents before the current node.
+ */
+pipe_status_t pipe_mgr_sel_word_log_add(sel_llp_word_log_t *log,
+                                        uint8_t stage_idx,
+                                        uint32_t word_idx,
+                                        const uint8_t *data,
+                                        uint32_t data_bytes,
+                                        uint32_t *idx_p);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_node_start(log)
+ * --------------------------------------------
+ * Starts logging the words of the next move list node.
+ */
+void pipe_mgr_sel_word_log_node_start(sel_llp_word_log_t *log);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_node_abort(log)
+ * --------------------------------------------
+ * Undoes the changes of a failed node. The words it logged first are dropped,
+ * the words logged by earlier nodes go back to their contents before it.
+ */
+void pipe_mgr_sel_word_log_node_abort(sel_llp_word_log_t *log);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_written(word, data, data_bytes)
+ * ------------------------------------------------------------
+ * Records that data was written to the hardware for a logged word.
+ */
+void pipe_mgr_sel_word_log_written(sel_llp_pending_word_t *word,
+                                   const uint8_t *data,
+                                   uint32_t data_bytes);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_flush_data(word, data, data_bytes)
+ * ---------------------------------------------------------------
+ * Returns the contents to write for a logged word whose current contents are
+ * data, or NULL when the hardware already holds them.
+ */
+uint8_t *pipe_mgr_sel_word_log_flush_data(sel_llp_pending_word_t *word,
+                                          uint8_t *data,
+                                          uint32_t data_bytes);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_reset(log)
+ * ---------------------------------------
+ * Empties the log once its words are written.
+ */
+void pipe_mgr_sel_word_log_reset(sel_llp_word_log_t *log);
+
+/*
+ * Usage: pipe_mgr_sel_word_log_destroy(log)
+ * -----------------------------------------
+ * Frees the memory of the log.
+ */
+void pipe_mgr_sel_word_log_destroy(sel_llp_word_log_t *log);
+
+#endif  // PIPE_MGR_SEL_WORD_LOG_H_INCLUDED
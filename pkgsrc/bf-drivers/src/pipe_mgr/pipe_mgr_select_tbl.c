@@ -38,6 +38,7 @@
 /* Local header files */
 #include "pipe_mgr_int.h"
 #include "pipe_mgr_select_tbl.h"
+#include "pipe_mgr_sel_mbr_ops.h"
 #include "pipe_mgr_db.h"
 #include "pipe_mgr_select_tbl_transaction.h"
 #include "pipe_mgr_select_ha.h"
@@ -979,6 +980,7 @@ static void pipe_mgr_sel_tbl_destroy(sel_tbl_t *sel_tbl_p,
     pipe_mgr_sel_tbl_stage_info_destroy(sel_tbl->sel_tbl_stage_info,
                                         sel_tbl->num_stages);
     bf_map_destroy(&sel_tbl->grp_id_map);
+    pipe_mgr_sel_word_log_destroy(&sel_tbl->llp.word_log);
   }
 
   /* Clean up HA state */
@@ -1793,10 +1795,24 @@ static pipe_status_t pipe_mgr_sel_grp_post_instruction(
   return PIPE_SUCCESS;
 }
 
-static pipe_status_t pipe_mgr_sel_grp_update_hw(
+static pipe_status_t pipe_mgr_sel_grp_set_word_usage(
+    sel_tbl_info_t *sel_tbl_info, sel_llp_word_data_t *word_data) {
+  if (SEL_TBL_IS_FAIR(sel_tbl_info)) {
+    SET_PVL_USAGE(word_data, word_data->no_bits_set);
+  } else if (SEL_TBL_IS_RESILIENT(sel_tbl_info)) {
+    SET_PVL_USAGE(word_data, word_data->highest_mbr_idx + 1);
+  } else {
+    PIPE_MGR_DBGCHK(0);
+    return PIPE_UNEXPECTED;
+  }
+  return PIPE_SUCCESS;
+}
+
+static pipe_status_t pipe_mgr_sel_grp_write_word(
     sel_tbl_t *sel_tbl,
     sel_tbl_stage_info_t *stage_info,
     uint32_t word_idx,
+    uint8_t *data,
     bool shadow_only) {
   pipe_status_t rc = PIPE_SUCCESS;
   uint32_t pv_subword = 0, pv_line = 0, pv_block = 0;
@@ -1808,27 +1824,16 @@ static pipe_status_t pipe_mgr_sel_grp_update_hw(
                                 &pv_block,
                                 TOF_SRAM_UNIT_DEPTH);
 
-  if (SEL_TBL_IS_FAIR(sel_tbl->sel_tbl_info)) {
-    SET_PVL_USAGE(&stage_info->llp.llp_word[word_idx],
-                  stage_info->llp.llp_word[word_idx].no_bits_set);
-  } else if (SEL_TBL_IS_RESILIENT(sel_tbl->sel_tbl_info)) {
-    SET_PVL_USAGE(&stage_info->llp.llp_word[word_idx],
-                  stage_info->llp.llp_word[word_idx].highest_mbr_idx + 1);
-  } else {
-    PIPE_MGR_DBGCHK(0);
-    return PIPE_UNEXPECTED;
-  }
   uint32_t data_sz_bytes = 0;
   data_sz_bytes = ((stage_info->ram_word_width - 1) >> 3) + 1;
-  rc =
-      pipe_mgr_sel_grp_post_instruction(sel_tbl,
-                                        stage_info->stage_id,
-                                        &stage_info->pv_hw,
-                                        pv_block,
-                                        pv_line,
-                                        stage_info->llp.llp_word[word_idx].data,
-                                        data_sz_bytes,
-                                        shadow_only);
+  rc = pipe_mgr_sel_grp_post_instruction(sel_tbl,
+                                         stage_info->stage_id,
+                                         &stage_info->pv_hw,
+                                         pv_block,
+                                         pv_line,
+                                         data,
+                                         data_sz_bytes,
+                                         shadow_only);
   if (rc != PIPE_SUCCESS) {
     LOG_ERROR("%s:%d Instruction add failed 0x%x", __func__, __LINE__, rc);
     return rc;
@@ -1837,6 +1842,134 @@ static pipe_status_t pipe_mgr_sel_grp_update_hw(
   return PIPE_SUCCESS;
 }
 
+static pipe_status_t pipe_mgr_sel_grp_update_hw(
+    sel_tbl_t *sel_tbl,
+    sel_tbl_stage_info_t *stage_info,
+    uint32_t word_idx,
+    bool shadow_only) {
+  pipe_status_t rc;
+
+  rc = pipe_mgr_sel_grp_set_word_usage(sel_tbl->sel_tbl_info,
+                                       &stage_info->llp.llp_word[word_idx]);
+  if (rc != PIPE_SUCCESS) {
+    return rc;
+  }
+  return pipe_mgr_sel_grp_write_word(sel_tbl,
+                                     stage_info,
+                                     word_idx,
+                                     stage_info->llp.llp_word[word_idx].data,
+                                     shadow_only);
+}
+
+static uint32_t pipe_mgr_sel_llp_word_bytes(sel_tbl_stage_info_t *stage_info) {
+  return ((stage_info->ram_word_width - 1) >> 3) + 1;
+}
+
+static sel_llp_pending_word_t *pipe_mgr_sel_llp_pending_word_get(
+    sel_tbl_t *sel_tbl, sel_tbl_stage_info_t *stage_info, uint32_t word_idx) {
+  return pipe_mgr_sel_word_log_get(
+      &sel_tbl->llp.word_log,
+      stage_info->llp.llp_word[word_idx].pending_idx,
+      stage_info->stage_idx,
+      word_idx);
+}
+
+/*
+ * Marks a selector word as about to change.  The hardware write is deferred to
+ * pipe_mgr_sel_llp_flush_words() so a word touched by several operations of
+ * the same move list is written once, and not at all if it ends up unchanged.
+ * Must be called before the word data is modified.
+ */
+static pipe_status_t pipe_mgr_sel_llp_word_defer(
+    sel_tbl_t *sel_tbl, sel_tbl_stage_info_t *stage_info, uint32_t word_idx) {
+  sel_llp_word_data_t *word_data = &stage_info->llp.llp_word[word_idx];
+  pipe_status_t rc;
+
+  sel_tbl->llp.word_updates++;
+  /* The usage is part of the contents kept in the log. */
+  rc = pipe_mgr_sel_grp_set_word_usage(sel_tbl->sel_tbl_info, word_data);
+  if (rc != PIPE_SUCCESS) return rc;
+  rc = pipe_mgr_sel_word_log_add(&sel_tbl->llp.word_log,
+                                 stage_info->stage_idx,
+                                 word_idx,
+                                 word_data->data,
+                                 pipe_mgr_sel_llp_word_bytes(stage_info),
+                                 &word_data->pending_idx);
+  if (rc != PIPE_SUCCESS) {
+    LOG_ERROR("%s:%d Malloc failed", __func__, __LINE__);
+  }
+  return rc;
+}
+
+/* Writes a deferred word now, it stays pending for later changes. */
+static pipe_status_t pipe_mgr_sel_llp_word_write_now(
+    sel_tbl_t *sel_tbl,
+    sel_tbl_stage_info_t *stage_info,
+    sel_llp_pending_word_t *pending) {
+  sel_llp_word_data_t *word_data = &stage_info->llp.llp_word[pending->word_idx];
+  pipe_status_t rc;
+
+  rc = pipe_mgr_sel_grp_update_hw(
+      sel_tbl, stage_info, pending->word_idx, false);
+  if (rc != PIPE_SUCCESS) {
+    return rc;
+  }
+  sel_tbl->llp.word_writes++;
+  pipe_mgr_sel_word_log_written(
+      pending, word_data->data, pipe_mgr_sel_llp_word_bytes(stage_info));
+  return PIPE_SUCCESS;
+}
+
+/*
+ * Issues one hardware write for each word deferred by the move list just
+ * processed, skipping words whose final contents match what the hardware
+ * already holds.  The words of a failed node were already dropped or set
+ * back by pipe_mgr_sel_word_log_node_abort().
+ */
+static pipe_status_t pipe_mgr_sel_llp_flush_words(
+    sel_tbl_info_t *sel_tbl_info) {
+  pipe_status_t rc = PIPE_SUCCESS, sts;
+  uint32_t i, j;
+
+  for (i = 0; i < sel_tbl_info->no_sel_tbls; i++) {
+    sel_tbl_t *sel_tbl = &sel_tbl_info->sel_tbl[i];
+    sel_llp_word_log_t *log = &sel_tbl->llp.word_log;
+    for (j = 0; j < log->num_words; j++) {
+      sel_llp_pending_word_t *pending = &log->words[j];
+      sel_tbl_stage_info_t *stage_info =
+          &sel_tbl->sel_tbl_stage_info[pending->stage_idx];
+      sel_llp_word_data_t *word_data =
+          &stage_info->llp.llp_word[pending->word_idx];
+      uint8_t *data;
+
+      sts = pipe_mgr_sel_grp_set_word_usage(sel_tbl_info, word_data);
+      if (sts == PIPE_SUCCESS) {
+        data = pipe_mgr_sel_word_log_flush_data(
+            pending, word_data->data, pipe_mgr_sel_llp_word_bytes(stage_info));
+        if (!data) continue;
+        sts = pipe_mgr_sel_grp_write_word(
+            sel_tbl, stage_info, pending->word_idx, data, false);
+      }
+      if (sts != PIPE_SUCCESS) {
+        LOG_ERROR("%s:%d %s(0x%x-%d) Error writing stage %d word %d rc 0x%x",
+                  __func__,
+                  __LINE__,
+                  sel_tbl_info->name,
+                  sel_tbl_info->tbl_hdl,
+                  sel_tbl_info->dev_id,
+                  stage_info->stage_id,
+                  pending->word_idx,
+                  sts);
+        if (rc == PIPE_SUCCESS) rc = sts;
+        continue;
+      }
+      sel_tbl->llp.word_writes++;
+    }
+    pipe_mgr_sel_word_log_reset(log);
+  }
+  return rc;
+}
+
 pipe_status_t pipe_mgr_sel_grp_word_data_allocate(sel_hlp_word_data_t *sel_word,
                                                   uint32_t word_width,
                                                   uint32_t ram_word_width) {
@@ -7511,6 +7644,154 @@ pipe_status_t rmt_sel_grp_mbrs_get(bf_dev_id_t device_id,
   return PIPE_SUCCESS;
 }
 
+/*
+ * Applies a batch of member operations on top of the current membership and
+ * programs the result through rmt_sel_grp_mbrs_set.  Operations that cancel
+ * each other out never reach the move list, and the remaining changes are
+ * computed as a single diff against the group so each selector word is only
+ * rewritten once.
+ */
+pipe_status_t rmt_sel_grp_mbrs_update(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t device_id,
+    pipe_sel_tbl_hdl_t sel_tbl_hdl,
+    pipe_sel_grp_hdl_t sel_grp_hdl,
+    uint32_t num_ops,
+    pipe_mgr_sel_mbr_op_e *ops,
+    pipe_adt_ent_hdl_t *mbrs,
+    uint32_t pipe_api_flags,
+    struct pipe_mgr_sel_move_list_t **move_list) {
+  sel_tbl_info_t *sel_tbl_info = NULL;
+  sel_grp_info_t *sel_grp_info = NULL;
+  pipe_adt_ent_hdl_t *new_mbrs = NULL;
+  bool *new_enable = NULL;
+  uint32_t num_mbrs = 0, max_mbrs, i;
+  pipe_status_t rc = PIPE_SUCCESS;
+  bf_dev_pipe_t pipe_id;
+  sel_tbl_t *sel_tbl;
+
+  sel_tbl_info = pipe_mgr_sel_tbl_info_get(device_id, sel_tbl_hdl, false);
+  if (sel_tbl_info == NULL) {
+    LOG_ERROR("%s:%d sel table not found for handle 0x%x",
+              __func__,
+              __LINE__,
+              sel_tbl_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+
+  if (SEL_TBL_IS_SYMMETRIC(sel_tbl_info))
+    pipe_id = BF_DEV_PIPE_ALL;
+  else
+    pipe_id = PIPE_GET_HDL_PIPE(sel_grp_hdl);
+
+  sel_tbl = get_sel_tbl_by_pipe_id(sel_tbl_info, pipe_id);
+  if (!sel_tbl) {
+    LOG_ERROR(
+        "%s:%d - %s (%d - 0x%x) "
+        "Selector table for pipe 0x%x (grp_hdl %x) not found",
+        __func__,
+        __LINE__,
+        sel_tbl_info->name,
+        sel_tbl_info->dev_id,
+        sel_tbl_info->tbl_hdl,
+        pipe_id,
+        sel_grp_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+
+  sel_grp_info = pipe_mgr_sel_grp_get(sel_tbl, sel_grp_hdl);
+  if (sel_grp_info == NULL) {
+    LOG_ERROR("%s:%d %s(0x%x-%d) Selector group 0x%x not found",
+              __func__,
+              __LINE__,
+              sel_tbl_info->name,
+              sel_tbl_info->tbl_hdl,
+              sel_tbl_info->dev_id,
+              sel_grp_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+
+  max_mbrs = sel_grp_info->mbr_count;
+  for (i = 0; i < num_ops; i++) {
+    if (ops[i] == PIPE_MGR_SEL_MBR_OP_ADD ||
+        ops[i] == PIPE_MGR_SEL_MBR_OP_ADD_DISABLED)
+      max_mbrs++;
+  }
+  if (max_mbrs) {
+    new_mbrs = PIPE_MGR_CALLOC(max_mbrs, sizeof(pipe_adt_ent_hdl_t));
+    new_enable = PIPE_MGR_CALLOC(max_mbrs, sizeof(bool));
+    if (!new_mbrs || !new_enable) {
+      LOG_ERROR("%s:%d Malloc failed", __func__, __LINE__);
+      rc = PIPE_NO_SYS_RESOURCES;
+      goto cleanup;
+    }
+  }
+
+  if (sel_grp_info->mbr_count) {
+    rc = rmt_sel_grp_mbrs_get(device_id,
+                              sel_tbl_hdl,
+                              sel_grp_hdl,
+                              sel_grp_info->mbr_count,
+                              new_mbrs,
+                              new_enable,
+                              &num_mbrs);
+    if (rc != PIPE_SUCCESS) {
+      LOG_ERROR("%s:%d %s(0x%x-%d) Error getting members of group 0x%x rc 0x%x",
+                __func__,
+                __LINE__,
+                sel_tbl_info->name,
+                sel_tbl_info->tbl_hdl,
+                sel_tbl_info->dev_id,
+                sel_grp_hdl,
+                rc);
+      goto cleanup;
+    }
+  }
+
+  rc = pipe_mgr_sel_mbr_ops_apply(
+      num_ops, ops, mbrs, new_mbrs, new_enable, &num_mbrs, &i);
+  if (rc == PIPE_INVALID_ARG) {
+    LOG_ERROR("%s:%d %s(0x%x-%d) Invalid member op %d at index %d",
+              __func__,
+              __LINE__,
+              sel_tbl_info->name,
+              sel_tbl_info->tbl_hdl,
+              sel_tbl_info->dev_id,
+              ops[i],
+              i);
+    goto cleanup;
+  } else if (rc != PIPE_SUCCESS) {
+    LOG_ERROR(
+        "%s:%d %s(0x%x-%d) Member 0x%x of op %d at index %d not found in "
+        "group 0x%x",
+        __func__,
+        __LINE__,
+        sel_tbl_info->name,
+        sel_tbl_info->tbl_hdl,
+        sel_tbl_info->dev_id,
+        mbrs[i],
+        ops[i],
+        i,
+        sel_grp_hdl);
+    goto cleanup;
+  }
+
+  rc = rmt_sel_grp_mbrs_set(sess_hdl,
+                            device_id,
+                            sel_tbl_hdl,
+                            sel_grp_hdl,
+                            num_mbrs,
+                            new_mbrs,
+                            new_enable,
+                            pipe_api_flags,
+                            move_list);
+
+cleanup:
+  if (new_mbrs) PIPE_MGR_FREE(new_mbrs);
+  if (new_enable) PIPE_MGR_FREE(new_enable);
+  return rc;
+}
+
 /* API function to disable a group member of a selection table */
 pipe_status_t rmt_sel_grp_mbr_disable(
     pipe_sess_hdl_t sess_hdl,
@@ -9776,9 +10057,36 @@ static pipe_status_t pipe_mgr_sel_process_placement_op(
     bool new_mbr_val;
     bool adjust_total;
     bool fallback_update = false;
+    bool deferred = false;
     rmt_virt_addr_t fallback_adt_ent_addr = 0;
 
     pipe_status_t rc = PIPE_SUCCESS;
+    switch (move_node->op) {
+      case PIPE_SEL_UPDATE_ADD:
+      case PIPE_SEL_UPDATE_DEL:
+      case PIPE_SEL_UPDATE_ACTIVATE:
+      case PIPE_SEL_UPDATE_DEACTIVATE:
+        /* Word writes for tables without a stateful table are coalesced and
+         * issued once the whole move list has been processed. */
+        if (move_node->replace_mbr_hdl || sel_tbl_info->stful_tbl_hdl) break;
+        deferred = pipe_mgr_sel_llp_word_defer(sel_tbl, stage_info, word_idx) ==
+                   PIPE_SUCCESS;
+        break;
+      default:
+        break;
+    }
+    if (deferred && move_node->op == PIPE_SEL_UPDATE_ADD && disabled_mbr) {
+      /* The slot may still be active in hardware from a member removed
+       * earlier in this move list; clear it before the new member's action
+       * data is installed so no traffic reaches a disabled member. */
+      sel_llp_pending_word_t *pending =
+          pipe_mgr_sel_llp_pending_word_get(sel_tbl, stage_info, word_idx);
+      if ((pending->hw_data[mbr_idx >> 3] >> (mbr_idx & 0x7)) & 0x1) {
+        rc = pipe_mgr_sel_llp_word_write_now(sel_tbl, stage_info, pending);
+        if (rc != PIPE_SUCCESS) return rc;
+      }
+    }
+
     switch (move_node->op) {
       case PIPE_SEL_UPDATE_GROUP_CREATE:
         sel_tbl->llp.num_grps++;
@@ -9895,6 +10203,8 @@ static pipe_status_t pipe_mgr_sel_process_placement_op(
                                  adjust_total);
       if (PIPE_SUCCESS != rc) return rc;
       rc = pipe_mgr_sel_grp_update_hw(sel_tbl, stage_info, word_idx, true);
+    } else if (deferred) {
+      /* Written by pipe_mgr_sel_llp_flush_words(). */
     } else {
       // Update the HW
       rc = pipe_mgr_sel_grp_update_hw(sel_tbl, stage_info, word_idx, false);
@@ -9938,19 +10248,34 @@ pipe_status_t pipe_sel_process_move_list(
   PIPE_MGR_DBGCHK(*processed == 0);
 
   struct pipe_mgr_sel_move_list_t *move_node;
+  bool in_batch = pipe_mgr_sess_in_batch(sess_hdl);
+  pipe_status_t flush_rc;
 
   for (move_node = move_list; move_node; move_node = move_node->next) {
+    sel_tbl_t *sel_tbl = get_sel_tbl_by_pipe_id(sel_tbl_info, move_node->pipe);
+    if (sel_tbl) pipe_mgr_sel_word_log_node_start(&sel_tbl->llp.word_log);
     rc = pipe_mgr_sel_process_placement_op(sess_hdl, sel_tbl_info, move_node);
     if (rc != PIPE_SUCCESS) {
-      return rc;
+      /* A batch drops the instructions of the failed node, the words
+       * already completed by earlier nodes must still be written.  The
+       * words the failed node changed are written as they were before it. */
+      if (in_batch) pipe_mgr_drv_ilist_rollback(sess_hdl);
+      if (sel_tbl) pipe_mgr_sel_word_log_node_abort(&sel_tbl->llp.word_log);
+      break;
     }
     (*processed)++;
-    if (pipe_mgr_sess_in_batch(sess_hdl)) {
+    if (in_batch) {
       pipe_mgr_drv_ilist_chkpt(sess_hdl);
     }
   }
 
-  return PIPE_SUCCESS;
+  /* Every selector word touched by the move list is written exactly once. */
+  flush_rc = pipe_mgr_sel_llp_flush_words(sel_tbl_info);
+  if (in_batch) {
+    pipe_mgr_drv_ilist_chkpt(sess_hdl);
+  }
+  if (rc != PIPE_SUCCESS) return rc;
+  return flush_rc;
 }
 
 pipe_status_t pipe_sel_get_first_group_member(
@@ -66,6 +66,7 @@
 /* Local includes */
 #include "pipe_mgr_int.h"
 #include "pipe_mgr_act_tbl.h"
+#include "pipe_mgr_sel_word_log.h"
 
 #define SEL_GROUP_ACTIVATE_ALL_STAGES
 
@@ -194,6 +195,9 @@ typedef struct sel_llp_word_data_s {
   uint8_t *data;
   // Array of size ram_word_width/8
   int32_t highest_mbr_idx;
+  // Slot in the table's word log, only valid while the word's hardware
+  // write is deferred
+  uint32_t pending_idx;
 } sel_llp_word_data_t;
 
 typedef struct sel_grp_stage_info_s {
@@ -303,6 +307,13 @@ typedef struct sel_tbl_s {
     pipe_adt_ent_hdl_t fallback_adt_ent_hdl;
     /* State required for HA at LLP */
     void *ha_llp_info;
+    /* Words changed by the move list being processed, written once at the
+     * end of the list. */
+    sel_llp_word_log_t word_log;
+    /* Word updates made by move list operations and the hardware word
+     * writes actually issued for them. */
+    uint64_t word_updates;
+    uint64_t word_writes;
   } llp;
 } sel_tbl_t;
 
@@ -461,6 +472,20 @@ pipe_status_t rmt_sel_grp_mbrs_set(pipe_sess_hdl_t sess_hdl,
                                    uint32_t pipe_api_flags,
                                    struct pipe_mgr_sel_move_list_t **move_list);
 
+/*!
+ * API function to apply a batch of member operations to a group
+ */
+pipe_status_t rmt_sel_grp_mbrs_update(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t device_id,
+    pipe_sel_tbl_hdl_t sel_tbl_hdl,
+    pipe_sel_grp_hdl_t sel_grp_hdl,
+    uint32_t num_ops,
+    pipe_mgr_sel_mbr_op_e *ops,
+    pipe_adt_ent_hdl_t *mbrs,
+    uint32_t pipe_api_flags,
+    struct pipe_mgr_sel_move_list_t **move_list);
+
 /*!
  * API function to get membership of a group
  */
@@ -565,6 +565,18 @@ pipe_status_t pipe_mgr_entry_format_lrn_decode(rmt_dev_info_t *dev_info,
                                                uint32_t index,
                                                bool network_order);
 
+pipe_status_t pipe_mgr_entry_format_lrn_decode_batch(
+    rmt_dev_info_t *dev_info,
+    profile_id_t prof_id,
+    uint8_t pipe,
+    uint8_t *lq_data,
+    uint32_t num_lq,
+    void **lrn_digest_entries,
+    uint32_t *cur_usage,
+    uint32_t max_lq,
+    bool network_order,
+    uint32_t *num_decoded);
+
 bool pipe_mgr_entry_format_is_lrn_type_valid(bf_dev_id_t devid,
                                              profile_id_t prof_id,
                                              int lq_type);
@@ -709,4 +721,6 @@ pipe_status_t pipe_mgr_entry_format_construct_match_key_mask_spec(
 uint8_t pipe_mgr_get_digest_cfg_type(rmt_dev_info_t *dev_info,
                                      profile_id_t prof_id,
                                      uint8_t lq_data[48]);
+uint8_t pipe_mgr_get_digest_cfg_type_width(rmt_dev_info_t *dev_info,
+                                           profile_id_t prof_id);
 #endif
@@ -1250,6 +1250,76 @@ pipe_status_t pipe_mgr_tbl_get_repeated_notify(pipe_sess_hdl_t sess_hdl,
       pipe_mgr_idle_tbl_get_repeated_notify(dev_id, tbl_hdl, repeated_notify));
 }
 
+static pipe_status_t pipe_mgr_tbl_set_gap_policy_wrapper(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size) {
+  if (pipe_mgr_sm_tbl_owner(dev_id, tbl_hdl) != PIPE_MGR_TBL_OWNER_TRN) {
+    LOG_ERROR("%s:%d Gap policy is only supported on ternary tables, dev %d "
+              "tbl 0x%x",
+              __func__,
+              __LINE__,
+              dev_id,
+              tbl_hdl);
+    return PIPE_NOT_SUPPORTED;
+  }
+  return pipe_mgr_tcam_tbl_set_gap_policy(
+      dev_id, tbl_hdl, gap_policy, gap_size);
+}
+
+static pipe_status_t pipe_mgr_tbl_get_gap_policy_wrapper(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t *gap_policy,
+    uint32_t *gap_size) {
+  if (pipe_mgr_sm_tbl_owner(dev_id, tbl_hdl) != PIPE_MGR_TBL_OWNER_TRN) {
+    return PIPE_NOT_SUPPORTED;
+  }
+  return pipe_mgr_tcam_tbl_get_gap_policy(
+      dev_id, tbl_hdl, gap_policy, gap_size);
+}
+
+pipe_status_t pipe_mgr_tbl_set_gap_policy(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size) {
+  /* Locking mat tbl locks all the associated tables */
+  pipe_hdl_type_t tbl_type = PIPE_GET_HDL_TYPE(tbl_hdl);
+  if (tbl_type != PIPE_HDL_TYPE_MAT_TBL) {
+    PIPE_MGR_DBGCHK(0);
+    return PIPE_INVALID_ARG;
+  }
+
+  RMT_API(sess_hdl,
+          0,
+          pipe_mgr_verify_tbl_access(sess_hdl, dev_id, tbl_hdl, true),
+          pipe_mgr_tbl_set_gap_policy_wrapper(
+              dev_id, tbl_hdl, gap_policy, gap_size));
+}
+
+pipe_status_t pipe_mgr_tbl_get_gap_policy(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t *gap_policy,
+    uint32_t *gap_size) {
+  /* Locking mat tbl locks all the associated tables */
+  pipe_hdl_type_t tbl_type = PIPE_GET_HDL_TYPE(tbl_hdl);
+  if (tbl_type != PIPE_HDL_TYPE_MAT_TBL) {
+    PIPE_MGR_DBGCHK(0);
+    return PIPE_INVALID_ARG;
+  }
+
+  RMT_API(sess_hdl,
+          0,
+          pipe_mgr_verify_tbl_access(sess_hdl, dev_id, tbl_hdl, true),
+          pipe_mgr_tbl_get_gap_policy_wrapper(
+              dev_id, tbl_hdl, gap_policy, gap_size));
+}
+
 pipe_status_t pipe_mgr_tbl_set_placement_mode(pipe_sess_hdl_t sess_hdl,
                                               bf_dev_id_t dev_id,
                                               pipe_mat_tbl_hdl_t tbl_hdl,
@@ -2472,12 +2542,15 @@ static pipe_status_t pipe_mgr_mat_tbl_key_insert_internal(
         cmp_fn = pipe_mgr_mat_tern_key_cmp_fn;
       }
     }
-    htbl_sts = bf_hashtbl_init(mat_tbl_info->key_htbl[pipe_idx],
-                               cmp_fn,
-                               pipe_mgr_free_key_htbl_node,
-                               key_sz,
-                               sizeof(pipe_mgr_mat_key_htbl_node_t),
-                               0x98733423);
+    /* Entries churn through this table on every add/delete, take the nodes
+     * from slabs rather than the heap. */
+    htbl_sts = bf_hashtbl_init_mode(mat_tbl_info->key_htbl[pipe_idx],
+                                    cmp_fn,
+                                    pipe_mgr_free_key_htbl_node,
+                                    key_sz,
+                                    sizeof(pipe_mgr_mat_key_htbl_node_t),
+                                    0x98733423,
+                                    BF_HASHTBL_MODE_SLAB);
 
     if (htbl_sts != BF_HASHTBL_OK) {
       LOG_ERROR(
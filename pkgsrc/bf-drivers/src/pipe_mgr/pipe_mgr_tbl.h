@@ -141,6 +141,20 @@ pipe_status_t pipe_mgr_tbl_get_repeated_notify(pipe_sess_hdl_t sess_hdl,
                                                pipe_mat_tbl_hdl_t tbl_hdl,
                                                bool *repeated_notify);
 
+pipe_status_t pipe_mgr_tbl_set_gap_policy(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size);
+
+pipe_status_t pipe_mgr_tbl_get_gap_policy(
+    pipe_sess_hdl_t sess_hdl,
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t *gap_policy,
+    uint32_t *gap_size);
+
 pipe_status_t pipe_mgr_tbl_set_duplicate_entry_check(
     pipe_sess_hdl_t sess_hdl,
     bf_dev_id_t dev_id,
@@ -32,6 +32,7 @@
 /* Local header files */
 #include "pipe_mgr_int.h"
 #include "pipe_mgr_tcam.h"
+#include "pipe_mgr_tcam_batch_plan.h"
 #include "pipe_mgr_tcam_transaction.h"
 #include "pipe_mgr_tcam_hw.h"
 #include "pipe_mgr_tcam_ha.h"
@@ -869,6 +870,7 @@ static tcam_tbl_t *pipe_mgr_tcam_tbl_alloc(tcam_pipe_tbl_t *tcam_pipe_tbl,
     tcam_tbl->ptn_index = i;
     tcam_tbl->total_entries = total_entries_per_ptn;
 
+    tcam_tbl->hlp.batch_index = PIPE_MGR_TCAM_INVALID_IDX;
     tcam_tbl->hlp.max_tcam_group = 1;
     tcam_tbl->hlp.group_info = (tcam_group_info_t **)PIPE_MGR_CALLOC(
         tcam_tbl->hlp.max_tcam_group, sizeof(tcam_group_info_t *));
@@ -1608,6 +1610,8 @@ static pipe_status_t pipe_mgr_tcam_tbl_create_internal(
   */
   tcam_tbl_info->tbl_size_in_p4 = mat_tbl_info->size;
   tcam_tbl_info->tbl_size_max = mat_tbl_info->size;
+  tcam_tbl_info->gap_policy = PIPE_MGR_TERN_GAP_POLICY_SPREAD;
+  tcam_tbl_info->gap_size = PIPE_MGR_TCAM_ENTRY_BUFFER_SPACE;
   LOG_TRACE("%s: Table %s, Pipe bitmap count %d ",
             __func__,
             tcam_tbl_info->name,
@@ -3082,6 +3086,7 @@ static pipe_status_t pipe_mgr_tcam_set_tcam_index_for_move(
 
   pipe_mgr_tcam_entry_backup_one(get_tcam_pipe_tbl(tcam_tbl),
                                  tcam_entry->entry_hdl);
+  tcam_tbl_info->move_stats.moves++;
 
   TCAM_HLP_GET_RANGE_TAIL_INDEX(tcam_entry, tail_index);
 
@@ -4185,7 +4190,12 @@ static pipe_status_t pipe_mgr_tcam_find_free_slot(
   uint32_t free_count = 0;
   uint32_t i = 0;
 
-  if (!tcam_tbl_info->restore_ent_node) {
+  if (tcam_tbl->hlp.batch_index != PIPE_MGR_TCAM_INVALID_IDX) {
+    /* The batch placement has already made room for this entry */
+    PIPE_MGR_DBGCHK(no_blocks == 1);
+    free[0] = tcam_tbl->hlp.batch_index;
+    free_count = 1;
+  } else if (!tcam_tbl_info->restore_ent_node) {
     /* If discrete indices are needed, then just search for required
      * number of discrete indices. And move entries within the group.
      *
@@ -4538,6 +4548,7 @@ pipe_status_t pipe_mgr_tcam_entry_add_internal(
   uint32_t priority = 0;
   uint32_t group = 0;
   bool group_created = false;
+  uint64_t moves = tcam_tbl_info->move_stats.moves;
 
   /*
    * Follow the below steps:
@@ -4603,6 +4614,15 @@ pipe_status_t pipe_mgr_tcam_entry_add_internal(
 
   total_entry_add_cnt++;
 
+  moves = tcam_tbl_info->move_stats.moves - moves;
+  tcam_tbl_info->move_stats.adds++;
+  if (moves) {
+    tcam_tbl_info->move_stats.adds_with_moves++;
+    if (moves > tcam_tbl_info->move_stats.largest_move) {
+      tcam_tbl_info->move_stats.largest_move = moves;
+    }
+  }
+
   tcam_tbl->hlp.total_usage++;
 
   pipe_mgr_tcam_entry_htbl_add_delete(tcam_tbl, ent_hdl, head_tcam_entry, true);
@@ -4927,6 +4947,502 @@ cleanup:
   return rc;
 }
 
+/* Batch placement
+ *
+ * A batch of new entries is placed in three steps.  First a target layout is
+ * computed for the existing and the new entries of a partition together, see
+ * pipe_mgr_tcam_batch_plan().  In that layout the entries are in priority
+ * order and every existing entry which can keep its index does so.  Entries
+ * of the same priority may be in any order, so an existing entry only needs
+ * to move when the entries of higher priority no longer fit above it, or the
+ * ones of lower priority below it.  Next the displaced entries are moved
+ * straight to their new index, each at most once.  Finally the new entries
+ * are added at the free indices the layout reserved for them.
+ */
+typedef struct tcam_batch_ent_s {
+  uint32_t ptn_index;
+  uint32_t priority; /* Group and priority, as in the match spec */
+  uint32_t idx;      /* Position of the entry in the batch */
+} tcam_batch_ent_t;
+
+static int tcam_batch_ent_cmp(const void *a, const void *b) {
+  const tcam_batch_ent_t *e1 = a, *e2 = b;
+
+  if (e1->ptn_index != e2->ptn_index) {
+    return e1->ptn_index < e2->ptn_index ? -1 : 1;
+  }
+  if (e1->priority != e2->priority) {
+    return e1->priority < e2->priority ? -1 : 1;
+  }
+  if (e1->idx != e2->idx) {
+    return e1->idx < e2->idx ? -1 : 1;
+  }
+  return 0;
+}
+
+/* Collect the existing entries of the partition for the batch plan.  Returns
+ * false if the entries cannot be planned together, i.e. when they do not all
+ * belong to the given group.
+ */
+static bool pipe_mgr_tcam_batch_plan_init(tcam_tbl_t *tcam_tbl,
+                                          uint32_t group,
+                                          uint32_t num_new,
+                                          tcam_batch_plan_t *plan) {
+  uint32_t total = tcam_tbl->total_entries;
+  uint32_t i;
+
+  plan->rank_to_index = PIPE_MGR_MALLOC(sizeof(uint32_t) * total);
+  plan->old_rank = PIPE_MGR_MALLOC(sizeof(uint32_t) * total);
+  plan->old_prio = PIPE_MGR_MALLOC(sizeof(uint32_t) * total);
+  plan->old_dst = PIPE_MGR_MALLOC(sizeof(uint32_t) * total);
+  plan->new_prio = PIPE_MGR_MALLOC(sizeof(uint32_t) * num_new);
+  plan->new_dst = PIPE_MGR_MALLOC(sizeof(uint32_t) * num_new);
+  if (!plan->rank_to_index || !plan->old_rank || !plan->old_prio ||
+      !plan->old_dst || !plan->new_prio || !plan->new_dst) {
+    return false;
+  }
+
+  for (i = 0; i < total; i++) {
+    tcam_hlp_entry_t *tcam_entry = tcam_tbl->hlp.tcam_entries[i];
+    if (tcam_entry && tcam_entry->is_default) continue;
+    if (tcam_entry) {
+      if (tcam_entry->group != group ||
+          (plan->num_old &&
+           plan->old_prio[plan->num_old - 1] > tcam_entry->priority)) {
+        return false;
+      }
+      plan->old_rank[plan->num_old] = plan->num_ranks;
+      plan->old_prio[plan->num_old] = tcam_entry->priority;
+      plan->num_old++;
+    }
+    plan->rank_to_index[plan->num_ranks++] = i;
+  }
+  plan->num_new = num_new;
+  return true;
+}
+
+static pipe_status_t pipe_mgr_tcam_batch_move(tcam_tbl_t *tcam_tbl,
+                                              tcam_batch_plan_t *plan,
+                                              uint32_t old,
+                                              pipe_mgr_move_list_t **tail_p) {
+  tcam_tbl_info_t *tcam_tbl_info = get_tcam_tbl_info(tcam_tbl);
+  uint32_t src_index = plan->rank_to_index[plan->old_rank[old]];
+  uint32_t dest_index = plan->rank_to_index[plan->old_dst[old]];
+  pipe_status_t rc = PIPE_SUCCESS;
+
+  rc = pipe_mgr_tcam_set_tcam_index_for_move(
+      tcam_tbl, dest_index, src_index, tail_p);
+  if (rc != PIPE_SUCCESS) {
+    LOG_ERROR(
+        "%s:%d - %s (%d - 0x%x) "
+        "Error moving tcam entry from %d to %d rc 0x%x",
+        __func__,
+        __LINE__,
+        tcam_tbl_info->name,
+        tcam_tbl_info->dev_id,
+        tcam_tbl_info->tbl_hdl,
+        src_index,
+        dest_index,
+        rc);
+    return rc;
+  }
+  tcam_tbl_info->move_stats.batch_moves++;
+  return PIPE_SUCCESS;
+}
+
+static pipe_status_t pipe_mgr_tcam_place_batch_ptn(
+    tcam_tbl_t *tcam_tbl,
+    tcam_batch_ent_t *batch,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_specs,
+    pipe_act_fn_hdl_t *act_fn_hdls,
+    pipe_action_spec_t **act_specs,
+    uint32_t *ttls,
+    pipe_mat_ent_hdl_t *ent_hdls,
+    pipe_mgr_move_list_t **move_tail_p) {
+  tcam_tbl_info_t *tcam_tbl_info = get_tcam_tbl_info(tcam_tbl);
+  tcam_pipe_tbl_t *tcam_pipe_tbl = get_tcam_pipe_tbl(tcam_tbl);
+  pipe_status_t rc = PIPE_SUCCESS;
+  tcam_batch_plan_t plan;
+  uint32_t group = 0, priority = 0;
+  uint32_t i;
+  bool planned;
+
+  PIPE_MGR_MEMSET(&plan, 0, sizeof(plan));
+
+  /* Range entries expand to a variable number of indices and entries of
+   * different groups are not ordered against each other, such batches are
+   * placed one entry at a time in priority order.
+   */
+  planned = !TCAM_TBL_USES_RANGE(tcam_tbl_info) &&
+            !tcam_tbl_info->restore_ent_node &&
+            ((batch[0].priority >> TCAM_GROUP_ID_SHIFT) ==
+             (batch[num_entries - 1].priority >> TCAM_GROUP_ID_SHIFT));
+  if (planned) {
+    group = batch[0].priority >> TCAM_GROUP_ID_SHIFT;
+    planned =
+        pipe_mgr_tcam_batch_plan_init(tcam_tbl, group, num_entries, &plan);
+  }
+  if (planned) {
+    for (i = 0; i < num_entries; i++) {
+      get_group_and_priority(match_specs[batch[i].idx], &group, &priority);
+      plan.new_prio[i] = priority;
+    }
+    rc = pipe_mgr_tcam_batch_plan(
+        &plan, tcam_tbl_info->gap_policy, tcam_tbl_info->gap_size);
+    if (rc != PIPE_SUCCESS) {
+      LOG_ERROR(
+          "%s:%d - %s (%d - 0x%x) "
+          "Error planning the placement of %d entries in partition %d "
+          "rc 0x%x",
+          __func__,
+          __LINE__,
+          tcam_tbl_info->name,
+          tcam_tbl_info->dev_id,
+          tcam_tbl_info->tbl_hdl,
+          num_entries,
+          tcam_tbl->ptn_index,
+          rc);
+      goto done;
+    }
+
+    /* Entries moving up go in ascending and entries moving down in descending
+     * order of their index.  Each one then lands on a free index without
+     * passing an entry of a different priority.
+     */
+    for (i = 0; i < plan.num_old && rc == PIPE_SUCCESS; i++) {
+      if (plan.old_dst[i] < plan.old_rank[i]) {
+        rc = pipe_mgr_tcam_batch_move(tcam_tbl, &plan, i, move_tail_p);
+      }
+    }
+    for (i = plan.num_old; i-- > 0 && rc == PIPE_SUCCESS;) {
+      if (plan.old_dst[i] > plan.old_rank[i]) {
+        rc = pipe_mgr_tcam_batch_move(tcam_tbl, &plan, i, move_tail_p);
+      }
+    }
+    if (rc != PIPE_SUCCESS) {
+      goto done;
+    }
+  }
+
+  for (i = 0; i < num_entries; i++) {
+    uint32_t idx = batch[i].idx;
+    pipe_mat_ent_hdl_t ent_hdl =
+        pipe_mgr_tcam_entry_hdl_allocate(tcam_pipe_tbl);
+    if (ent_hdl == PIPE_TCAM_INVALID_ENT_HDL) {
+      rc = PIPE_NO_SPACE;
+      break;
+    }
+
+    if (planned) {
+      tcam_tbl->hlp.batch_index = plan.rank_to_index[plan.new_dst[i]];
+    }
+    rc = pipe_mgr_tcam_entry_add_internal(tcam_tbl,
+                                          match_specs[idx],
+                                          act_fn_hdls[idx],
+                                          act_specs[idx],
+                                          ttls ? ttls[idx] : 0,
+                                          ent_hdl,
+                                          move_tail_p,
+                                          false);
+    tcam_tbl->hlp.batch_index = PIPE_MGR_TCAM_INVALID_IDX;
+    if (rc != PIPE_SUCCESS) {
+      LOG_ERROR(
+          "%s:%d - %s (%d - 0x%x) "
+          "Error adding entry %d of the batch rc 0x%x",
+          __func__,
+          __LINE__,
+          tcam_tbl_info->name,
+          tcam_tbl_info->dev_id,
+          tcam_tbl_info->tbl_hdl,
+          idx,
+          rc);
+      pipe_mgr_tcam_entry_hdl_release(tcam_pipe_tbl, ent_hdl);
+      break;
+    }
+    ent_hdls[idx] = ent_hdl;
+    tcam_tbl_info->move_stats.batch_adds++;
+  }
+
+done:
+  pipe_mgr_tcam_batch_plan_free(&plan);
+  return rc;
+}
+
+pipe_status_t pipe_mgr_tcam_entry_place_batch(
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_specs,
+    pipe_act_fn_hdl_t *act_fn_hdls,
+    pipe_action_spec_t **act_specs,
+    uint32_t *ttls,
+    uint32_t pipe_api_flags,
+    pipe_mat_ent_hdl_t *ent_hdls,
+    pipe_mgr_move_list_t **move_head_p) {
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+  tcam_pipe_tbl_t *tcam_pipe_tbl = NULL;
+  tcam_batch_ent_t *batch = NULL;
+  pipe_status_t rc = PIPE_SUCCESS;
+  uint32_t i, first, last;
+
+  tcam_tbl_info =
+      pipe_mgr_tcam_tbl_info_get(dev_tgt.device_id, mat_tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    LOG_ERROR("%s:%d Tcam table with handle 0x%x not found",
+              __func__,
+              __LINE__,
+              mat_tbl_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+  tcam_pipe_tbl =
+      get_tcam_pipe_tbl_by_pipe_id(tcam_tbl_info, dev_tgt.dev_pipe_id);
+  if (tcam_pipe_tbl == NULL) {
+    LOG_ERROR(
+        "%s:%d %s(0x%x-%d) "
+        "TCAM table for pipe %d not found",
+        __func__,
+        __LINE__,
+        tcam_tbl_info->name,
+        mat_tbl_hdl,
+        dev_tgt.device_id,
+        dev_tgt.dev_pipe_id);
+    return PIPE_INVALID_ARG;
+  }
+
+  struct pipe_mgr_move_list_t move_head;
+  move_head.next = NULL;
+  struct pipe_mgr_move_list_t *move_tail = &move_head;
+
+  for (i = 0; i < num_entries; i++) {
+    if (!match_specs[i] || !act_specs[i]) {
+      LOG_ERROR("%s:%d No match or action spec passed for entry %d",
+                __func__,
+                __LINE__,
+                i);
+      return PIPE_INVALID_ARG;
+    }
+    ent_hdls[i] = 0;
+  }
+
+  if (pipe_mgr_hitless_warm_init_in_progress(dev_tgt.device_id)) {
+    /* The entries are matched against the state read back from hardware,
+     * there is no placement to plan.
+     */
+    for (i = 0; i < num_entries && rc == PIPE_SUCCESS; i++) {
+      pipe_mgr_move_list_t *move_list = NULL;
+      rc = pipe_mgr_tcam_entry_place(dev_tgt,
+                                     mat_tbl_hdl,
+                                     match_specs[i],
+                                     act_fn_hdls[i],
+                                     act_specs[i],
+                                     ttls ? ttls[i] : 0,
+                                     pipe_api_flags,
+                                     &ent_hdls[i],
+                                     move_head_p ? &move_list : NULL);
+      move_tail->next = move_list;
+      while (move_tail->next) move_tail = move_tail->next;
+    }
+    if (move_head_p) {
+      *move_head_p = move_head.next;
+    }
+    return rc;
+  }
+
+  batch = PIPE_MGR_MALLOC(sizeof(tcam_batch_ent_t) * num_entries);
+  if (batch == NULL) {
+    LOG_ERROR("%s:%d Malloc failed", __func__, __LINE__);
+    return PIPE_NO_SYS_RESOURCES;
+  }
+  for (i = 0; i < num_entries; i++) {
+    batch[i].ptn_index = match_specs[i]->partition_index;
+    batch[i].priority = match_specs[i]->priority;
+    batch[i].idx = i;
+  }
+  qsort(batch, num_entries, sizeof(tcam_batch_ent_t), tcam_batch_ent_cmp);
+
+  /* Make sure the whole batch fits before changing any of the partitions */
+  for (first = 0; first < num_entries; first = last) {
+    tcam_tbl_t *tcam_tbl = get_tcam_tbl(tcam_pipe_tbl, batch[first].ptn_index);
+    if (tcam_tbl == NULL) {
+      LOG_ERROR(
+          "%s:%d %s(0x%x-%d) "
+          "Partition %d does not exist in tcam table (max partitions - %d)",
+          __func__,
+          __LINE__,
+          tcam_tbl_info->name,
+          tcam_tbl_info->tbl_hdl,
+          tcam_tbl_info->dev_id,
+          batch[first].ptn_index,
+          tcam_pipe_tbl->no_ptns);
+      rc = PIPE_INVALID_ARG;
+      goto done;
+    }
+    for (last = first; last < num_entries &&
+                       batch[last].ptn_index == batch[first].ptn_index;
+         last++) {
+      rc = pipe_mgr_tcam_verify_resources(tcam_tbl,
+                                          act_specs[batch[last].idx]);
+      if (rc != PIPE_SUCCESS) {
+        goto done;
+      }
+    }
+    if (!pipe_mgr_tcam_check_free_space(
+            tcam_tbl_info, tcam_tbl, last - first)) {
+      LOG_ERROR(
+          "Dev %d pipe %d TCAM table %s 0x%x no space for %d entries, "
+          "current usage %d max entries %d",
+          tcam_tbl_info->dev_id,
+          dev_tgt.dev_pipe_id,
+          tcam_tbl_info->name,
+          tcam_tbl_info->tbl_hdl,
+          last - first,
+          tcam_tbl->hlp.total_usage,
+          tcam_tbl->total_entries);
+      rc = PIPE_NO_SPACE;
+      goto done;
+    }
+  }
+
+  LOG_TRACE("%s Request to install %d TCAM entries tbl 0x%x dev %d pipe %x",
+            tcam_tbl_info->name,
+            num_entries,
+            mat_tbl_hdl,
+            dev_tgt.device_id,
+            dev_tgt.dev_pipe_id);
+
+  /* Set-up the session parameters */
+  tcam_pipe_tbl->sess_flags = pipe_api_flags;
+  tcam_tbl_info->move_stats.batches++;
+
+  for (first = 0; first < num_entries; first = last) {
+    tcam_tbl_t *tcam_tbl = get_tcam_tbl(tcam_pipe_tbl, batch[first].ptn_index);
+    for (last = first; last < num_entries &&
+                       batch[last].ptn_index == batch[first].ptn_index;
+         last++)
+      ;
+    rc = pipe_mgr_tcam_place_batch_ptn(tcam_tbl,
+                                       &batch[first],
+                                       last - first,
+                                       match_specs,
+                                       act_fn_hdls,
+                                       act_specs,
+                                       ttls,
+                                       ent_hdls,
+                                       move_head_p ? &move_tail : NULL);
+    if (rc != PIPE_SUCCESS) {
+      LOG_ERROR(
+          "%s:%d TCAM batch add failed for dev %d tbl_hdl %d "
+          "pipe %d partition %d rc 0x%x",
+          __func__,
+          __LINE__,
+          dev_tgt.device_id,
+          mat_tbl_hdl,
+          tcam_pipe_tbl->pipe_id,
+          batch[first].ptn_index,
+          rc);
+      break;
+    }
+  }
+
+  /* The move list is handed back even on a failure so that the operations
+   * already done can be cleaned up.
+   */
+  if (move_head_p) {
+    *move_head_p = move_head.next;
+  }
+
+done:
+  PIPE_MGR_FREE(batch);
+  return rc;
+}
+
+static pipe_status_t pipe_mgr_tcam_gap_policy_check(
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy) {
+  switch (gap_policy) {
+    case PIPE_MGR_TERN_GAP_POLICY_NONE:
+    case PIPE_MGR_TERN_GAP_POLICY_FIXED:
+    case PIPE_MGR_TERN_GAP_POLICY_SPREAD:
+      return PIPE_SUCCESS;
+  }
+  return PIPE_INVALID_ARG;
+}
+
+pipe_status_t pipe_mgr_tcam_tbl_set_gap_policy(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size) {
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+
+  tcam_tbl_info = pipe_mgr_tcam_tbl_info_get(dev_id, mat_tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    LOG_ERROR("%s:%d Tcam table with handle 0x%x not found",
+              __func__,
+              __LINE__,
+              mat_tbl_hdl);
+    return PIPE_OBJ_NOT_FOUND;
+  }
+  if (pipe_mgr_tcam_gap_policy_check(gap_policy) != PIPE_SUCCESS) {
+    LOG_ERROR("%s:%d %s(0x%x-%d) Invalid gap policy %d",
+              __func__,
+              __LINE__,
+              tcam_tbl_info->name,
+              mat_tbl_hdl,
+              dev_id,
+              gap_policy);
+    return PIPE_INVALID_ARG;
+  }
+
+  tcam_tbl_info->gap_policy = gap_policy;
+  if (gap_policy == PIPE_MGR_TERN_GAP_POLICY_FIXED) {
+    tcam_tbl_info->gap_size = gap_size;
+  }
+  return PIPE_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_tcam_tbl_get_gap_policy(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t *gap_policy,
+    uint32_t *gap_size) {
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+
+  tcam_tbl_info = pipe_mgr_tcam_tbl_info_get(dev_id, mat_tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    return PIPE_OBJ_NOT_FOUND;
+  }
+  *gap_policy = tcam_tbl_info->gap_policy;
+  *gap_size = tcam_tbl_info->gap_size;
+  return PIPE_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_tcam_move_stats_get(bf_dev_id_t dev_id,
+                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                           tcam_move_stats_t *stats) {
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+
+  tcam_tbl_info = pipe_mgr_tcam_tbl_info_get(dev_id, mat_tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    return PIPE_OBJ_NOT_FOUND;
+  }
+  *stats = tcam_tbl_info->move_stats;
+  return PIPE_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_tcam_move_stats_clear(bf_dev_id_t dev_id,
+                                             pipe_mat_tbl_hdl_t mat_tbl_hdl) {
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+
+  tcam_tbl_info = pipe_mgr_tcam_tbl_info_get(dev_id, mat_tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    return PIPE_OBJ_NOT_FOUND;
+  }
+  PIPE_MGR_MEMSET(
+      &tcam_tbl_info->move_stats, 0, sizeof(tcam_tbl_info->move_stats));
+  return PIPE_SUCCESS;
+}
+
 /** \brief pipe_mgr_tcam_entry_del_internal
  *        Internal function to delete an entry
  *
@@ -303,6 +303,16 @@ static inline const char *tcam_default_ent_type_str(tcam_default_ent_type_e e) {
   return "Unknown";
 }
 
+typedef struct tcam_move_stats_s {
+  uint64_t adds;             /* Entries placed */
+  uint64_t adds_with_moves;  /* Entries which needed other entries moved */
+  uint64_t moves;            /* Entry moves, including the batch ones */
+  uint64_t largest_move;     /* Most moves needed by a single add */
+  uint64_t batches;          /* Batch placements */
+  uint64_t batch_adds;       /* Entries placed by batch placements */
+  uint64_t batch_moves;      /* Entry moves done by batch placements */
+} tcam_move_stats_t;
+
 struct tcam_tbl_info_s;
 struct tcam_pipe_tbl_s;
 
@@ -332,6 +342,11 @@ typedef struct tcam_tbl_s {
      */
     tcam_hlp_entry_t *entry_add_list; /* List of all the new entry adds */
     tcam_hlp_entry_t *entry_del_list; /* List of all the new entry deletes */
+
+    /* Free index picked by the batch placement for the entry being added,
+     * PIPE_MGR_TCAM_INVALID_IDX when the entry is placed on its own.
+     */
+    uint32_t batch_index;
   } hlp;
 
   struct {
@@ -446,6 +461,13 @@ typedef struct tcam_tbl_info_s {
   uint32_t num_actions;
   pipe_act_fn_info_t *act_fn_hdl_info;
 
+  /* Gap left between priority bands by batch placement, gap_size is only
+   * used by the fixed policy.
+   */
+  pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy;
+  uint32_t gap_size;
+  tcam_move_stats_t move_stats;
+
   /* Global table lock */
   pipe_mgr_mutex_t tbl_lock;
 } tcam_tbl_info_t;
@@ -530,6 +552,51 @@ pipe_status_t pipe_mgr_tcam_entry_place_with_hdl(
     pipe_mat_ent_hdl_t ent_hdl_p,
     pipe_mgr_move_list_t **head_p);
 
+/** \brief pipe_mgr_tcam_entry_place_batch
+ *        Adds a batch of entries to a tcam tbl
+ *
+ * The placement of all the entries is planned together: every existing
+ * entry which can keep its index does so, the others are moved at most once
+ * and the new entries are placed leaving free space between the priority
+ * bands as per the gap policy of the table.
+ *
+ * \param dev_tgt Device target
+ * \param mat_tbl_hdl Table hdl of the match tbl
+ * \param num_entries Number of entries in the batch
+ * \param ent_hdls Returns the handle of each entry of the batch
+ * \return pipe_status_t The status of the operation
+ */
+pipe_status_t pipe_mgr_tcam_entry_place_batch(
+    dev_target_t dev_tgt,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    uint32_t num_entries,
+    pipe_tbl_match_spec_t **match_specs,
+    pipe_act_fn_hdl_t *act_fn_hdls,
+    pipe_action_spec_t **act_specs,
+    uint32_t *ttls,
+    uint32_t pipe_api_flags,
+    pipe_mat_ent_hdl_t *ent_hdls,
+    pipe_mgr_move_list_t **head_p);
+
+pipe_status_t pipe_mgr_tcam_tbl_set_gap_policy(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size);
+
+pipe_status_t pipe_mgr_tcam_tbl_get_gap_policy(
+    bf_dev_id_t dev_id,
+    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t *gap_policy,
+    uint32_t *gap_size);
+
+pipe_status_t pipe_mgr_tcam_move_stats_get(bf_dev_id_t dev_id,
+                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
+                                           tcam_move_stats_t *stats);
+
+pipe_status_t pipe_mgr_tcam_move_stats_clear(bf_dev_id_t dev_id,
+                                             pipe_mat_tbl_hdl_t mat_tbl_hdl);
+
 /** \brief pipe_mgr_tcam_entry_del
  *        Delets an entry from a tcam tbl
  *
@@ -0,0 +1,398 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*!
+ * @file pipe_mgr_tcam_batch_plan.c
+ * @date
+ *
+ * Placement planner for batches of TCAM entries.
+ *
+ * The layout is computed on ranks, the indices of the partition which can
+ * hold a user entry, i.e. all but the one of a reserved default entry.  Each
+ * entry is also given an item position, its position in the priority order of
+ * all the entries.  An existing entry at rank r can stay as item i only if the
+ * slack r - i is between zero and the number of spare ranks, and the slack
+ * does not decrease from one kept entry to the next.
+ */
+
+/* Standard header includes */
+#include <stdlib.h>
+
+/* Module header includes */
+#include <pipe_mgr/pipe_mgr_porting.h>
+
+/* Local header includes */
+#include "pipe_mgr_tcam_batch_plan.h"
+
+#define TCAM_BATCH_NONE 0xFFFFFFFF
+
+static uint32_t tcam_batch_item_prio(tcam_batch_plan_t *plan, uint32_t owner) {
+  if (owner < plan->num_old) {
+    return plan->old_prio[owner];
+  }
+  return plan->new_prio[owner - plan->num_old];
+}
+
+/* Returns true if a priority band starts after the given item.  The ends of
+ * the partition count as band boundaries too.
+ */
+static bool tcam_batch_band_ends(tcam_batch_plan_t *plan,
+                                 uint32_t *item_owner,
+                                 int64_t item) {
+  int64_t num_items = plan->num_old + plan->num_new;
+
+  if (item < 0 || item + 1 >= num_items) {
+    return true;
+  }
+  return tcam_batch_item_prio(plan, item_owner[item]) !=
+         tcam_batch_item_prio(plan, item_owner[item + 1]);
+}
+
+/* Assign ranks to the items between two kept entries.  a and b are the items
+ * of the kept entries, -1 and the number of items at the ends of the
+ * partition, and a_rank and b_rank their ranks.
+ */
+static void pipe_mgr_tcam_batch_fill_gap(
+    tcam_batch_plan_t *plan,
+    uint32_t *item_owner,
+    uint32_t *item_rank,
+    int64_t a,
+    int64_t a_rank,
+    int64_t b,
+    int64_t b_rank,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size) {
+  uint32_t count = b - a - 1;
+  uint32_t spare = (b_rank - a_rank - 1) - count;
+  uint32_t bands = 0, share = 0, extra = 0;
+  int64_t rank = a_rank + 1;
+  uint32_t i;
+
+  if (!count) {
+    return;
+  }
+
+  if (gap_policy == PIPE_MGR_TERN_GAP_POLICY_SPREAD) {
+    for (i = 0; i <= count; i++) {
+      if (tcam_batch_band_ends(plan, item_owner, a + i)) {
+        bands++;
+      }
+    }
+    if (bands) {
+      share = spare / bands;
+      extra = spare % bands;
+    }
+  }
+
+  for (i = 0; i < count; i++) {
+    uint32_t gap = 0;
+    if (tcam_batch_band_ends(plan, item_owner, a + i)) {
+      switch (gap_policy) {
+        case PIPE_MGR_TERN_GAP_POLICY_FIXED:
+          gap = gap_size < spare ? gap_size : spare;
+          break;
+        case PIPE_MGR_TERN_GAP_POLICY_SPREAD:
+          gap = share;
+          if (extra) {
+            gap++;
+            extra--;
+          }
+          break;
+        case PIPE_MGR_TERN_GAP_POLICY_NONE:
+        default:
+          break;
+      }
+    }
+    spare -= gap;
+    rank += gap;
+    item_rank[a + 1 + i] = rank++;
+  }
+}
+
+/* Limit on the number of (item, slack) pairs the exact search looks at, per
+ * rank of the partition.
+ */
+#define PIPE_MGR_TCAM_BATCH_POINTS_PER_RANK 8
+
+typedef struct tcam_batch_point_s {
+  uint32_t item;
+  uint32_t slack;
+  uint32_t old;
+  uint32_t pred;
+} tcam_batch_point_t;
+
+static int tcam_batch_point_cmp(const void *a, const void *b) {
+  const tcam_batch_point_t *p1 = a, *p2 = b;
+
+  if (p1->item != p2->item) {
+    return p1->item < p2->item ? -1 : 1;
+  }
+  if (p1->slack != p2->slack) {
+    return p1->slack > p2->slack ? -1 : 1;
+  }
+  return 0;
+}
+
+/* Find the largest set of existing entries which can stay in place.  Every
+ * item an entry may take gives a point (item, slack) and the entries kept
+ * form a chain of points with increasing items and non-decreasing slacks,
+ * i.e. a longest non-decreasing subsequence of the slacks once the points are
+ * sorted by item.  lo and hi bound the items of each entry on entry, on
+ * return lo holds the item of each kept entry and -1 for the others.  Returns
+ * false without changing anything if there are too many points to look at.
+ */
+static bool pipe_mgr_tcam_batch_keep_exact(tcam_batch_plan_t *plan,
+                                           int64_t *lo,
+                                           int64_t *hi,
+                                           uint32_t *item_owner,
+                                           uint32_t *item_rank) {
+  uint64_t max_points =
+      (uint64_t)plan->num_ranks * PIPE_MGR_TCAM_BATCH_POINTS_PER_RANK;
+  uint64_t num_points = 0;
+  tcam_batch_point_t *points = NULL;
+  uint32_t *tails = NULL;
+  uint32_t len = 0, p, j;
+  int64_t i;
+
+  for (j = 0; j < plan->num_old; j++) {
+    if (lo[j] <= hi[j]) num_points += hi[j] - lo[j] + 1;
+  }
+  if (num_points > max_points) {
+    return false;
+  }
+  if (!num_points) {
+    for (j = 0; j < plan->num_old; j++) {
+      lo[j] = -1;
+    }
+    return true;
+  }
+  points = PIPE_MGR_MALLOC(sizeof(tcam_batch_point_t) * num_points);
+  tails = PIPE_MGR_MALLOC(sizeof(uint32_t) * num_points);
+  if (!points || !tails) {
+    if (points) PIPE_MGR_FREE(points);
+    if (tails) PIPE_MGR_FREE(tails);
+    return false;
+  }
+
+  for (j = 0, p = 0; j < plan->num_old; j++) {
+    for (i = lo[j]; i <= hi[j]; i++, p++) {
+      points[p].item = i;
+      points[p].slack = plan->old_rank[j] - i;
+      points[p].old = j;
+    }
+    lo[j] = -1;
+  }
+  /* Points of the same item are taken in descending order of slack so that
+   * no two of them end up in the same chain.
+   */
+  qsort(points, num_points, sizeof(tcam_batch_point_t), tcam_batch_point_cmp);
+
+  for (p = 0; p < num_points; p++) {
+    uint32_t first = 0, last = len;
+    while (first < last) {
+      uint32_t mid = first + (last - first) / 2;
+      if (points[tails[mid]].slack > points[p].slack) {
+        last = mid;
+      } else {
+        first = mid + 1;
+      }
+    }
+    points[p].pred = first ? tails[first - 1] : TCAM_BATCH_NONE;
+    tails[first] = p;
+    if (first == len) len++;
+  }
+
+  for (p = len ? tails[len - 1] : TCAM_BATCH_NONE;
+       p != TCAM_BATCH_NONE;
+       p = points[p].pred) {
+    lo[points[p].old] = points[p].item;
+    item_owner[points[p].item] = points[p].old;
+    item_rank[points[p].item] = plan->old_rank[points[p].old];
+  }
+
+  PIPE_MGR_FREE(points);
+  PIPE_MGR_FREE(tails);
+  return true;
+}
+
+/* Used when the exact search is too costly.  Walks the existing entries in
+ * index order and keeps each one for which some item still gives a slack no
+ * smaller than the one of the previous kept entry.  The items reachable by a
+ * chain of kept entries form a range, so only its ends need to be tracked.
+ */
+static void pipe_mgr_tcam_batch_keep_greedy(tcam_batch_plan_t *plan,
+                                            int64_t *lo,
+                                            int64_t *hi,
+                                            uint32_t *item_owner,
+                                            uint32_t *item_rank) {
+  int64_t prev_lo = -1, prev_hi = -1, prev_rank = -1;
+  int64_t next = plan->num_old + plan->num_new;
+  uint32_t j;
+
+  for (j = 0; j < plan->num_old; j++) {
+    int64_t rank = plan->old_rank[j];
+    int64_t l = lo[j], h = hi[j];
+
+    if (l < prev_lo + 1) l = prev_lo + 1;
+    if (h > prev_hi + rank - prev_rank) h = prev_hi + rank - prev_rank;
+    if (l > h) {
+      lo[j] = -1;
+      continue;
+    }
+    lo[j] = prev_lo = l;
+    hi[j] = prev_hi = h;
+    prev_rank = rank;
+  }
+
+  /* Pick the item of each kept entry, walking back from the last one */
+  for (j = plan->num_old; j-- > 0;) {
+    if (lo[j] < 0) continue;
+    next = hi[j] < next - 1 ? hi[j] : next - 1;
+    PIPE_MGR_DBGCHK(next >= lo[j]);
+    lo[j] = next;
+    item_owner[next] = j;
+    item_rank[next] = plan->old_rank[j];
+  }
+}
+
+pipe_status_t pipe_mgr_tcam_batch_plan(
+    tcam_batch_plan_t *plan,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size) {
+  uint32_t num_old = plan->num_old, num_new = plan->num_new;
+  uint32_t num_items = num_old + num_new;
+  int64_t spare = (int64_t)plan->num_ranks - num_items;
+  int64_t *lo = NULL, *hi = NULL;
+  uint32_t *item_owner = NULL, *item_rank = NULL;
+  pipe_status_t rc = PIPE_SUCCESS;
+  uint32_t i, j, n;
+
+  if (spare < 0) {
+    return PIPE_NO_SPACE;
+  }
+  if (!num_items) {
+    return PIPE_SUCCESS;
+  }
+
+  lo = PIPE_MGR_MALLOC(sizeof(int64_t) * (num_old + 1));
+  hi = PIPE_MGR_MALLOC(sizeof(int64_t) * (num_old + 1));
+  item_owner = PIPE_MGR_MALLOC(sizeof(uint32_t) * num_items);
+  item_rank = PIPE_MGR_MALLOC(sizeof(uint32_t) * num_items);
+  if (!lo || !hi || !item_owner || !item_rank) {
+    rc = PIPE_NO_SYS_RESOURCES;
+    goto done;
+  }
+
+  /* An existing entry can be any item of its priority band */
+  for (j = 0, n = 0; j < num_old;) {
+    uint32_t prio = plan->old_prio[j];
+    uint32_t first = j, last = j, n_last;
+
+    while (last < num_old && plan->old_prio[last] == prio) last++;
+    while (n < num_new && plan->new_prio[n] < prio) n++;
+    n_last = n;
+    while (n_last < num_new && plan->new_prio[n_last] == prio) n_last++;
+    for (; j < last; j++) {
+      lo[j] = first + n;
+      hi[j] = last + n_last - 1;
+    }
+  }
+
+  /* Narrow each band range down to the items giving a slack within bounds */
+  for (j = 0; j < num_old; j++) {
+    int64_t rank = plan->old_rank[j];
+    if (lo[j] < rank - spare) lo[j] = rank - spare;
+    if (hi[j] > rank) hi[j] = rank;
+  }
+  for (i = 0; i < num_items; i++) {
+    item_owner[i] = TCAM_BATCH_NONE;
+  }
+  if (!pipe_mgr_tcam_batch_keep_exact(plan, lo, hi, item_owner, item_rank)) {
+    pipe_mgr_tcam_batch_keep_greedy(plan, lo, hi, item_owner, item_rank);
+  }
+
+  /* The remaining items of each band go to the displaced entries of the band,
+   * in index order, and then to the new entries.
+   */
+  for (i = 0, j = 0, n = 0; j < num_old || n < num_new;) {
+    uint32_t prio;
+
+    if (n >= num_new ||
+        (j < num_old && plan->old_prio[j] <= plan->new_prio[n])) {
+      prio = plan->old_prio[j];
+    } else {
+      prio = plan->new_prio[n];
+    }
+    for (; j < num_old && plan->old_prio[j] == prio; j++) {
+      if (lo[j] >= 0) continue;
+      while (item_owner[i] != TCAM_BATCH_NONE) i++;
+      item_owner[i] = j;
+    }
+    for (; n < num_new && plan->new_prio[n] == prio; n++) {
+      while (item_owner[i] != TCAM_BATCH_NONE) i++;
+      item_owner[i] = num_old + n;
+    }
+  }
+
+  /* Lay out the items between each pair of kept entries */
+  int64_t a = -1, a_rank = -1;
+  for (i = 0; i <= num_items; i++) {
+    uint32_t owner = i < num_items ? item_owner[i] : TCAM_BATCH_NONE;
+    int64_t b_rank;
+
+    if (i < num_items && (owner >= num_old || lo[owner] < 0)) continue;
+    b_rank = i < num_items ? plan->old_rank[owner] : plan->num_ranks;
+    pipe_mgr_tcam_batch_fill_gap(plan,
+                                 item_owner,
+                                 item_rank,
+                                 a,
+                                 a_rank,
+                                 i,
+                                 b_rank,
+                                 gap_policy,
+                                 gap_size);
+    a = i;
+    a_rank = b_rank;
+  }
+
+  for (i = 0; i < num_items; i++) {
+    if (item_owner[i] < num_old) {
+      plan->old_dst[item_owner[i]] = item_rank[i];
+    } else {
+      plan->new_dst[item_owner[i] - num_old] = item_rank[i];
+    }
+  }
+
+done:
+  if (lo) PIPE_MGR_FREE(lo);
+  if (hi) PIPE_MGR_FREE(hi);
+  if (item_owner) PIPE_MGR_FREE(item_owner);
+  if (item_rank) PIPE_MGR_FREE(item_rank);
+  return rc;
+}
+
+void pipe_mgr_tcam_batch_plan_free(tcam_batch_plan_t *plan) {
+  if (plan->rank_to_index) PIPE_MGR_FREE(plan->rank_to_index);
+  if (plan->old_rank) PIPE_MGR_FREE(plan->old_rank);
+  if (plan->old_prio) PIPE_MGR_FREE(plan->old_prio);
+  if (plan->old_dst) PIPE_MGR_FREE(plan->old_dst);
+  if (plan->new_prio) PIPE_MGR_FREE(plan->new_prio);
+  if (plan->new_dst) PIPE_MGR_FREE(plan->new_dst);
+}
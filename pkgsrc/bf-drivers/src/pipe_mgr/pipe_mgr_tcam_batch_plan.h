@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#ifndef PIPE_MGR_TCAM_BATCH_PLAN_H_INCLUDED
+#define PIPE_MGR_TCAM_BATCH_PLAN_H_INCLUDED
+
+#include <stdint.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+
+/* Layout of a TCAM partition for the placement of a batch of new entries.
+ * The caller fills in the ranks and priorities of the existing entries and
+ * the priorities of the new ones, pipe_mgr_tcam_batch_plan() fills in the
+ * planned rank of each of them.
+ */
+typedef struct tcam_batch_plan_s {
+  uint32_t num_ranks;
+  uint32_t *rank_to_index;
+  uint32_t num_old;
+  uint32_t *old_rank; /* Ranks of the existing entries, ascending */
+  uint32_t *old_prio;
+  uint32_t *old_dst; /* Planned ranks of the existing entries */
+  uint32_t num_new;
+  uint32_t *new_prio; /* Priorities of the new entries, ascending */
+  uint32_t *new_dst;  /* Planned ranks of the new entries */
+} tcam_batch_plan_t;
+
+
+/** \brief pipe_mgr_tcam_batch_plan
+ *        Plan the placement of a batch of entries in a TCAM partition
+ *
+ * Every existing entry which can keep its rank does so, the largest such set
+ * is searched for unless that is too costly.  The remaining ranks are handed
+ * out in priority order, leaving the free ranks between the priority bands as
+ * per the gap policy.
+ *
+ * \param plan The partition, old_dst and new_dst are filled in
+ * \param gap_policy Gap policy of the table
+ * \param gap_size Number of free ranks after a band for the fixed policy
+ * \return pipe_status_t PIPE_NO_SPACE if the entries do not fit
+ */
+pipe_status_t pipe_mgr_tcam_batch_plan(
+    tcam_batch_plan_t *plan,
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy,
+    uint32_t gap_size);
+
+/* Free the arrays of a plan */
+void pipe_mgr_tcam_batch_plan_free(tcam_batch_plan_t *plan);
+
+#endif  // PIPE_MGR_TCAM_BATCH_PLAN_H_INCLUDED
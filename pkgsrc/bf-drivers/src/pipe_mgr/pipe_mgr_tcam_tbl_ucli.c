@@ -973,11 +973,122 @@ PIPE_MGR_TCAM_TBL_CLI_CMD_DECLARE(entry_count) {
   return UCLI_STATUS_OK;
 }
 
+static const char *pipe_mgr_tcam_gap_policy_str(
+    pipe_mgr_tbl_prop_tern_gap_policy_value_t gap_policy) {
+  switch (gap_policy) {
+    case PIPE_MGR_TERN_GAP_POLICY_NONE:
+      return "none";
+    case PIPE_MGR_TERN_GAP_POLICY_FIXED:
+      return "fixed";
+    case PIPE_MGR_TERN_GAP_POLICY_SPREAD:
+      return "spread";
+  }
+  return "unknown";
+}
+
+PIPE_MGR_TCAM_TBL_CLI_CMD_DECLARE(move_stats) {
+  PIPE_MGR_CLI_PROLOGUE("move_stats",
+                        "Print or clear the tcam entry move statistics",
+                        "-d <dev_id> -h <tbl_handle> [-c]");
+
+  bool got_dev = false;
+  bool got_tbl_hdl = false;
+  bool clear = false;
+
+  bf_dev_id_t dev_id = 0;
+  pipe_mat_tbl_hdl_t tbl_hdl = 0;
+
+  int x;
+  while (-1 != (x = getopt(argc, argv, "d:h:c"))) {
+    switch (x) {
+      case 'd':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        dev_id = strtoul(optarg, NULL, 0);
+        got_dev = true;
+        break;
+      case 'h':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        tbl_hdl = strtoul(optarg, NULL, 0);
+        got_tbl_hdl = true;
+        break;
+      case 'c':
+        clear = true;
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+  if (!got_dev || dev_id < 0 || dev_id >= PIPE_MGR_NUM_DEVICES ||
+      !got_tbl_hdl) {
+    aim_printf(&uc->pvs, "%s", usage);
+    return UCLI_STATUS_OK;
+  }
+
+  tcam_tbl_info_t *tcam_tbl_info = NULL;
+  tcam_tbl_info = pipe_mgr_tcam_tbl_info_get(dev_id, tbl_hdl, false);
+  if (tcam_tbl_info == NULL) {
+    aim_printf(&uc->pvs, "tcam table not found for handle 0x%x\n", tbl_hdl);
+    return UCLI_STATUS_OK;
+  }
+
+  if (clear) {
+    pipe_mgr_tcam_move_stats_clear(dev_id, tbl_hdl);
+    return UCLI_STATUS_OK;
+  }
+
+  tcam_move_stats_t stats;
+  if (pipe_mgr_tcam_move_stats_get(dev_id, tbl_hdl, &stats) != PIPE_SUCCESS) {
+    return UCLI_STATUS_OK;
+  }
+  aim_printf(&uc->pvs,
+             "tcam tbl %s 0x%x gap policy %s, gap size %u\n",
+             tcam_tbl_info->name,
+             tbl_hdl,
+             pipe_mgr_tcam_gap_policy_str(tcam_tbl_info->gap_policy),
+             tcam_tbl_info->gap_size);
+  aim_printf(&uc->pvs,
+             "  Entries added           : %" PRIu64 "\n",
+             stats.adds);
+  aim_printf(&uc->pvs,
+             "  Adds needing moves      : %" PRIu64 "\n",
+             stats.adds_with_moves);
+  aim_printf(&uc->pvs,
+             "  Entry moves             : %" PRIu64 "\n",
+             stats.moves);
+  aim_printf(&uc->pvs,
+             "  Most moves for one add  : %" PRIu64 "\n",
+             stats.largest_move);
+  aim_printf(&uc->pvs,
+             "  Batches                 : %" PRIu64 "\n",
+             stats.batches);
+  aim_printf(&uc->pvs,
+             "  Entries added in batches: %" PRIu64 "\n",
+             stats.batch_adds);
+  aim_printf(&uc->pvs,
+             "  Moves done by batches   : %" PRIu64 "\n",
+             stats.batch_moves);
+  if (stats.adds) {
+    aim_printf(&uc->pvs,
+               "  Moves per entry added   : %.3f\n",
+               (double)stats.moves / stats.adds);
+  }
+
+  return UCLI_STATUS_OK;
+}
+
 /* <auto.ucli.handlers.start> */
 static ucli_command_handler_f pipe_mgr_tcam_tbl_ucli_ucli_handlers__[] = {
     PIPE_MGR_TCAM_TBL_CLI_CMD_HNDLR(tbl_info),
     PIPE_MGR_TCAM_TBL_CLI_CMD_HNDLR(ent_info),
     PIPE_MGR_TCAM_TBL_CLI_CMD_HNDLR(entry_count),
+    PIPE_MGR_TCAM_TBL_CLI_CMD_HNDLR(move_stats),
     NULL};
 
 /* <auto.ucli.handlers.end> */
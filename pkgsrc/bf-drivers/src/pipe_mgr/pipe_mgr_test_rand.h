@@ -0,0 +1,40 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+#ifndef PIPE_MGR_TEST_RAND_H_INCLUDED
+#define PIPE_MGR_TEST_RAND_H_INCLUDED
+
+#include <stdint.h>
+
+/* Xorshift generator for the unit tests and benchmarks.  Sequences are
+ * reproducible from the seed and do not depend on the C library or disturb
+ * rand() state.  The state must not be zero.
+ */
+static inline uint32_t pipe_mgr_test_rand(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+#endif  // PIPE_MGR_TEST_RAND_H_INCLUDED
@@ -1355,6 +1355,172 @@ PIPE_MGR_CLI_CMD_DECLARE(drv_state) {
   return UCLI_STATUS_OK;
 }
 
+PIPE_MGR_CLI_CMD_DECLARE(drv_buf_stats) {
+  PIPE_MGR_CLI_PROLOGUE("drv-buf-stats",
+                        " Show the DMA buffer pool and cache counters",
+                        "-d <dev>");
+
+  bf_dev_id_t dev_id = 0;
+  int c;
+  while ((c = getopt(argc, argv, "d:")) != -1) {
+    switch (c) {
+      case 'd':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        dev_id = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  rmt_dev_info_t *dev_info = pipe_mgr_get_dev_info(dev_id);
+  if (!dev_info) {
+    aim_printf(&uc->pvs, "Device %d not found\n", dev_id);
+    return UCLI_STATUS_OK;
+  }
+
+  static const char *type_str[PIPE_MGR_DRV_BUF_CNT] = {
+      [PIPE_MGR_DRV_BUF_IL] = "IL",
+      [PIPE_MGR_DRV_BUF_LRN] = "LRN",
+      [PIPE_MGR_DRV_BUF_LRT] = "LRT",
+      [PIPE_MGR_DRV_BUF_IDL] = "IDL",
+      [PIPE_MGR_DRV_BUF_BRD] = "BRD",
+      [PIPE_MGR_DRV_BUF_BWR] = "BWR"};
+  aim_printf(&uc->pvs,
+             "%-6s %-4s %-8s %-8s %-8s %-5s %-12s %-10s %-10s %-10s\n",
+             "Subdev",
+             "Type",
+             "Total",
+             "Free",
+             "Cached",
+             "Depth",
+             "Hits",
+             "Refills",
+             "Drains",
+             "Steals");
+  uint32_t num_subdevices = pipe_mgr_get_num_active_subdevices(dev_id);
+  for (uint32_t subdev = 0; subdev < num_subdevices; subdev++) {
+    pipe_mgr_drv_buf_pool_t *bp =
+        &pipe_mgr_drv_ctx()->gBufPool[dev_id][subdev];
+    enum pipe_mgr_drv_buf_type type;
+    for (type = PIPE_MGR_DRV_BUF_FIRST; type < PIPE_MGR_DRV_BUF_CNT; ++type) {
+      bf_sys_dma_pool_stats_t stats;
+      if (!bp->pool[type]) continue;
+      if (bf_sys_dma_pool_stats_get(bp->pool[type], &stats)) continue;
+      aim_printf(&uc->pvs,
+                 "%-6u %-4s %-8u %-8u %-8u %-5u %-12" PRIu64 " %-10" PRIu64
+                 " %-10" PRIu64 " %-10" PRIu64 "\n",
+                 subdev,
+                 type_str[type] ? type_str[type] : "???",
+                 stats.buf_cnt,
+                 stats.free_bufs,
+                 stats.cached_bufs,
+                 stats.cache_depth,
+                 stats.cache_hits,
+                 stats.cache_refills,
+                 stats.cache_drains,
+                 stats.cache_steals);
+    }
+  }
+  return UCLI_STATUS_OK;
+}
+
+PIPE_MGR_CLI_CMD_DECLARE(drv_buf_trace) {
+  PIPE_MGR_CLI_PROLOGUE(
+      "drv-buf-trace",
+      " Enable, clear or show the DMA buffer lifecycle histograms",
+      "[-e <0/1 to stop/start>] [-c] [-s <session>] [-v]");
+
+  int enable = 0;
+  bool got_enable = false;
+  bool clear = false;
+  int sid = -1;
+  bool verbose = false;
+
+  int c;
+  while ((c = getopt(argc, argv, "e:cs:v")) != -1) {
+    switch (c) {
+      case 'e':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        enable = !!strtoul(optarg, NULL, 0);
+        got_enable = true;
+        break;
+      case 'c':
+        clear = true;
+        break;
+      case 's':
+        if (!optarg) {
+          aim_printf(&uc->pvs, "%s", usage);
+          return UCLI_STATUS_OK;
+        }
+        sid = strtoul(optarg, NULL, 0);
+        break;
+      case 'v':
+        verbose = true;
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+
+  if (got_enable || clear) {
+    if (clear) pipe_mgr_drv_buf_trace_clear();
+    if (got_enable) pipe_mgr_drv_buf_trace_set(enable);
+    return UCLI_STATUS_OK;
+  }
+
+  static const char *dr_str[PIPE_MGR_DRV_TRACE_DR_CNT] = {
+      "IL0", "IL1", "IL2", "IL3", "WB"};
+  static const char *stage_str[PIPE_MGR_DRV_TRACE_STAGE_CNT] = {
+      "Fill", "Queue", "DMA"};
+  aim_printf(&uc->pvs,
+             "Buffer tracing is %s\n",
+             pipe_mgr_drv_ctx()->buf_trace_en ? "enabled" : "disabled");
+  aim_printf(&uc->pvs,
+             "%-4s %-3s %-10s %-5s %-12s %-12s\n",
+             "Sess",
+             "DR",
+             "Buffers",
+             "Stage",
+             "Avg(us)",
+             "Max(us)");
+  for (int i = 0; i < PIPE_MGR_MAX_SESSIONS; ++i) {
+    if (sid >= 0 && sid != i) continue;
+    struct pipe_mgr_drv_buf_trace_t *t =
+        &pipe_mgr_drv_ctx()->sesStates[i].bufTrace;
+    for (int dr = 0; dr < PIPE_MGR_DRV_TRACE_DR_CNT; ++dr) {
+      if (!t->cnt[dr]) continue;
+      for (int stage = 0; stage < PIPE_MGR_DRV_TRACE_STAGE_CNT; ++stage) {
+        aim_printf(&uc->pvs,
+                   "%-4d %-3s %-10u %-5s %-12" PRIu64 " %-12" PRIu64 "\n",
+                   i,
+                   dr_str[dr],
+                   t->cnt[dr],
+                   stage_str[stage],
+                   t->sum_ns[dr][stage] / t->cnt[dr] / 1000,
+                   t->max_ns[dr][stage] / 1000);
+        if (!verbose) continue;
+        for (int b = 0; b < PIPE_MGR_DRV_TRACE_BKT_CNT; ++b) {
+          if (!t->hist[dr][stage][b]) continue;
+          aim_printf(&uc->pvs,
+                     "       %10u us: %u\n",
+                     b ? 1u << b : 0,
+                     t->hist[dr][stage][b]);
+        }
+      }
+    }
+  }
+  return UCLI_STATUS_OK;
+}
+
 PIPE_MGR_CLI_CMD_DECLARE(log_ilist) {
   PIPE_MGR_CLI_PROLOGUE("log-ilist",
                         " Start/stop logging of ilist contents",
@@ -7863,6 +8029,99 @@ PIPE_MGR_CLI_CMD_DECLARE(alpm_inactive_node_delete_get) {
   return UCLI_STATUS_OK;
 }
 
+PIPE_MGR_CLI_CMD_DECLARE(alpm_bulk_bench) {
+  UCLI_COMMAND_INFO(uc,
+                    "alpm_bulk_bench",
+                    -1,
+                    "  Time an in memory ALPM bulk load of synthetic routes"
+                    " Usage: alpm_bulk_bench [-n <num routes>] [-6] "
+                    "[-p <partition depth>] [-m <max subtrees per partition>] "
+                    "[-s <seed>]");
+  int c;
+  bool ipv6 = false;
+  uint32_t num_routes = 0, partition_depth = 16, max_subtrees = 4, seed = 1;
+  static char usage[] =
+      "Usage: alpm_bulk_bench [-n <num routes>] [-6] [-p <partition depth>] "
+      "[-m <max subtrees per partition>] [-s <seed>]\n";
+  int argc;
+  char *const *argv;
+  int arg_start = 0;
+  size_t i;
+  pipe_mgr_alpm_bench_result_t res;
+  pipe_status_t status = PIPE_SUCCESS;
+
+  for (i = 0; i < sizeof(uc->pargs[0].args__) / sizeof(uc->pargs[0].args__[0]);
+       ++i) {
+    if (!strncmp(uc->pargs[0].args__[i],
+                 "alpm_bulk_bench",
+                 strlen("alpm_bulk_bench"))) {
+      arg_start = i;
+      break;
+    }
+  }
+  optind = 0; /* reset optind value */
+  argc = (uc->pargs->count + 1);
+  argv = (char *const *)&(uc->pargs->args__[arg_start]);
+
+  while ((c = getopt(argc, argv, "n:6p:m:s:")) != -1) {
+    switch (c) {
+      case 'n':
+        num_routes = strtoul(optarg, NULL, 0);
+        break;
+      case '6':
+        ipv6 = true;
+        break;
+      case 'p':
+        partition_depth = strtoul(optarg, NULL, 0);
+        break;
+      case 'm':
+        max_subtrees = strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        aim_printf(&uc->pvs, "%s", usage);
+        return UCLI_STATUS_OK;
+    }
+  }
+  if (!num_routes) {
+    num_routes = ipv6 ? 200000 : 1000000;
+  }
+
+  status = pipe_mgr_alpm_bulk_bench(
+      num_routes, ipv6, partition_depth, max_subtrees, seed, &res);
+  if (status != PIPE_SUCCESS) {
+    aim_printf(&uc->pvs,
+               "ALPM bulk bench failed: %s\n",
+               pipe_str_err(status));
+    return UCLI_STATUS_OK;
+  }
+  aim_printf(&uc->pvs,
+             "%s routes %u, subtrees %u, partitions %u, entries placed %u\n",
+             ipv6 ? "IPv6" : "IPv4",
+             res.num_routes,
+             res.num_subtrees,
+             res.num_partitions,
+             res.num_entries_placed);
+  aim_printf(&uc->pvs,
+             "  Trie build       : %" PRIu64 " usec\n",
+             res.build_ns / 1000);
+  aim_printf(&uc->pvs,
+             "  Carve and pack   : %" PRIu64 " usec\n",
+             res.carve_ns / 1000);
+  aim_printf(&uc->pvs,
+             "  Attach           : %" PRIu64 " usec\n",
+             res.attach_ns / 1000);
+  aim_printf(&uc->pvs,
+             "  Txn node backup  : %" PRIu64 " usec\n",
+             res.full_backup_ns / 1000);
+  aim_printf(&uc->pvs,
+             "  Txn count backup : %" PRIu64 " usec\n",
+             res.count_backup_ns / 1000);
+  return UCLI_STATUS_OK;
+}
+
 /**
  * Selector table sequence order UCLI
  */
@@ -11815,6 +12074,8 @@ PIPE_MGR_CLI_CMD_DECLARE(hash_seed_dump) {
 static ucli_command_handler_f pipe_mgr_ucli_ucli_handlers__[] = {
     PIPE_MGR_CLI_CMD_HNDLR(log_ilist),
     PIPE_MGR_CLI_CMD_HNDLR(drv_state),
+    PIPE_MGR_CLI_CMD_HNDLR(drv_buf_stats),
+    PIPE_MGR_CLI_CMD_HNDLR(drv_buf_trace),
     PIPE_MGR_CLI_CMD_HNDLR(decode_ilist),
     PIPE_MGR_CLI_CMD_HNDLR(dev),
     PIPE_MGR_CLI_CMD_HNDLR(pipe),
@@ -11882,6 +12143,7 @@ static ucli_command_handler_f pipe_mgr_ucli_ucli_handlers__[] = {
     PIPE_MGR_CLI_CMD_HNDLR(pps_reset),
     PIPE_MGR_CLI_CMD_HNDLR(alpm_inactive_node_delete_get),
     PIPE_MGR_CLI_CMD_HNDLR(alpm_inactive_node_delete_set),
+    PIPE_MGR_CLI_CMD_HNDLR(alpm_bulk_bench),
     PIPE_MGR_CLI_CMD_HNDLR(selector_tbl_sequence_get),
     PIPE_MGR_CLI_CMD_HNDLR(selector_tbl_sequence_set),
     PIPE_MGR_CLI_CMD_HNDLR(overspeed_25g_set),
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*
+ * Tests of the carving and packing steps of the ALPM bulk load.  Tries are
+ * built by hand from random prefixes; the carve is checked to split them into
+ * subtrees that fit and hold every entry exactly once, and the packing is
+ * checked against a plain first fit decreasing.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../pipe_mgr_alpm_bulk.h"
+#include "../pipe_mgr_test_rand.h"
+
+#define TEST_MAX_NODES 4096
+
+static uint32_t test_rand_state = 0x9E3779B9;
+
+static uint32_t test_rand(uint32_t n) {
+  return pipe_mgr_test_rand(&test_rand_state) % n;
+}
+
+static trie_node_t test_nodes[TEST_MAX_NODES];
+static uint32_t test_num_nodes;
+static alpm_entry_t test_entry;
+
+static trie_node_t *test_node_new(trie_node_t *parent) {
+  trie_node_t *node;
+
+  assert(test_num_nodes < TEST_MAX_NODES);
+  node = &test_nodes[test_num_nodes++];
+  memset(node, 0, sizeof(*node));
+  node->parent = parent;
+  node->depth = parent ? parent->depth + 1 : 0;
+  return node;
+}
+
+/* Adds the prefix of the given length, returns false if it already exists */
+static bool test_trie_add(trie_node_t *root, uint32_t value, uint32_t len) {
+  trie_node_t *node = root;
+  uint32_t i;
+
+  for (i = 0; i < len; i++) {
+    trie_node_t **child = ((value >> i) & 1) ? &node->right_child
+                                             : &node->left_child;
+    if (!*child) *child = test_node_new(node);
+    node = *child;
+  }
+  if (node->entry) return false;
+  node->entry = &test_entry;
+  return true;
+}
+
+static bool test_is_root(trie_node_t *node,
+                         alpm_bulk_subtree_t *subtrees,
+                         uint32_t num_subtrees) {
+  uint32_t i;
+  for (i = 0; i < num_subtrees; i++) {
+    if (subtrees[i].node == node) return true;
+  }
+  return false;
+}
+
+/* Counts the entries kept by the subtree at node, checking the counts */
+static uint32_t test_walk(trie_node_t *node,
+                          alpm_bulk_subtree_t *subtrees,
+                          uint32_t num_subtrees) {
+  uint32_t count = node->entry ? 1 : 0;
+  trie_node_t *child[2] = {node->left_child, node->right_child};
+  uint32_t i;
+
+  for (i = 0; i < 2; i++) {
+    if (!child[i] || test_is_root(child[i], subtrees, num_subtrees)) continue;
+    count += test_walk(child[i], subtrees, num_subtrees);
+  }
+  assert(node->count == count);
+  return count;
+}
+
+static bool test_covered(trie_node_t *node) {
+  for (node = node->parent; node; node = node->parent) {
+    if (node->entry) return true;
+  }
+  return false;
+}
+
+/* Carves the trie the way the bulk load does and checks the subtrees */
+static uint32_t test_carve(trie_node_t *root,
+                           uint32_t num_entries,
+                           uint32_t cap,
+                           alpm_bulk_subtree_t *subtrees) {
+  uint32_t num_subtrees = 0, total = 0, i, count;
+
+  if (pipe_mgr_alpm_bulk_carve(root, false, cap, subtrees, &num_subtrees)) {
+    subtrees[num_subtrees].node = root;
+    subtrees[num_subtrees].size = root->count;
+    num_subtrees++;
+  }
+  for (i = 0; i < num_subtrees; i++) {
+    count = test_walk(subtrees[i].node, subtrees, num_subtrees);
+    assert(count > 0);
+    assert(subtrees[i].size ==
+           count + ((!subtrees[i].node->entry &&
+                     test_covered(subtrees[i].node))
+                        ? 1
+                        : 0));
+    assert(subtrees[i].size <= cap);
+    total += count;
+  }
+  assert(total == num_entries);
+  assert(num_subtrees >= (num_entries + cap - 1) / cap);
+  return num_subtrees;
+}
+
+static void test_carve_fixed(void) {
+  alpm_bulk_subtree_t subtrees[16];
+  trie_node_t *root;
+  uint32_t value, len, n = 0;
+
+  /* A full trie of 15 entries splits at the two children of the root */
+  test_num_nodes = 0;
+  root = test_node_new(NULL);
+  for (len = 0; len < 4; len++) {
+    for (value = 0; value < (1u << len); value++) {
+      assert(test_trie_add(root, value, len));
+      n++;
+    }
+  }
+  assert(test_carve(root, n, 7, subtrees) == 3);
+  assert(subtrees[0].node == root->left_child && subtrees[0].size == 7);
+  assert(subtrees[1].node == root->right_child && subtrees[1].size == 7);
+  assert(subtrees[2].node == root && subtrees[2].size == 1);
+
+  /* A node without an entry below one with an entry needs a covering prefix
+   * slot, which makes its subtree too large for two slots */
+  test_num_nodes = 0;
+  root = test_node_new(NULL);
+  assert(test_trie_add(root, 0, 0));
+  assert(test_trie_add(root, 0, 2));
+  assert(test_trie_add(root, 2, 2));
+  assert(test_carve(root, 3, 2, subtrees) == 2);
+  assert(subtrees[0].node == root->left_child->left_child);
+  assert(subtrees[0].size == 1);
+  assert(subtrees[1].node == root && subtrees[1].size == 2);
+  assert(root->left_child->count == 1);
+}
+
+static void test_carve_random(uint32_t iterations) {
+  alpm_bulk_subtree_t *subtrees;
+  trie_node_t *root;
+  uint32_t it, i, num_entries, max_len, cap;
+
+  subtrees = malloc(TEST_MAX_NODES * sizeof(alpm_bulk_subtree_t));
+  assert(subtrees);
+  for (it = 0; it < iterations; it++) {
+    test_num_nodes = 0;
+    root = test_node_new(NULL);
+    max_len = 1 + test_rand(12);
+    num_entries = 0;
+    for (i = test_rand(200); i > 0; i--) {
+      if (test_trie_add(
+              root, test_rand(1u << max_len), test_rand(max_len + 1))) {
+        num_entries++;
+      }
+    }
+    /* the bulk load carves with the partition depth less one */
+    cap = 2 + test_rand(20);
+    test_carve(root, num_entries, cap, subtrees);
+  }
+  free(subtrees);
+}
+
+static void test_pack_fixed(void) {
+  static const uint32_t sizes[6] = {3, 5, 1, 4, 3, 2};
+  static const uint32_t depth[4] = {8, 8, 8, 8};
+  static const uint32_t bins[6] = {0, 1, 0, 1, 2, 1};
+  alpm_bulk_subtree_t subtrees[6];
+  trie_node_t node = {0};
+  uint32_t i, num_bins = 0;
+
+  for (i = 0; i < 6; i++) {
+    subtrees[i].node = &node;
+    subtrees[i].size = sizes[i];
+  }
+  assert(pipe_mgr_alpm_bulk_pack(depth, 4, 4, subtrees, 6, &num_bins) ==
+         PIPE_SUCCESS);
+  assert(num_bins == 3);
+  for (i = 0; i < 6; i++) {
+    assert(subtrees[i].bin == bins[i]);
+  }
+
+  /* Two subtrees at most per partition */
+  for (i = 0; i < 5; i++) {
+    subtrees[i].size = 1;
+  }
+  assert(pipe_mgr_alpm_bulk_pack(depth, 4, 2, subtrees, 5, &num_bins) ==
+         PIPE_SUCCESS);
+  assert(num_bins == 3);
+
+  /* Not enough partitions */
+  for (i = 0; i < 5; i++) {
+    subtrees[i].size = 7;
+  }
+  assert(pipe_mgr_alpm_bulk_pack(depth, 4, 4, subtrees, 5, &num_bins) ==
+         PIPE_NO_SPACE);
+  assert(pipe_mgr_alpm_bulk_pack(depth, 0, 4, subtrees, 0, &num_bins) ==
+         PIPE_NO_SPACE);
+}
+
+static void test_pack_random(uint32_t iterations) {
+  alpm_bulk_subtree_t subtrees[64];
+  uint32_t depth[32], left[32], cnt[32];
+  trie_node_t nodes[64];
+  uint32_t it, i, b, num, num_free, max, ptn_depth, num_bins, used;
+  pipe_status_t sts;
+
+  for (it = 0; it < iterations; it++) {
+    num = test_rand(64);
+    num_free = 1 + test_rand(32);
+    max = 1 + test_rand(4);
+    ptn_depth = 2 + test_rand(16);
+    for (b = 0; b < num_free; b++) depth[b] = ptn_depth;
+    for (i = 0; i < num; i++) {
+      memset(&nodes[i], 0, sizeof(nodes[i]));
+      nodes[i].depth = test_rand(32);
+      subtrees[i].node = &nodes[i];
+      subtrees[i].size = 1 + test_rand(ptn_depth);
+    }
+    num_bins = 0;
+    sts = pipe_mgr_alpm_bulk_pack(
+        depth, num_free, max, subtrees, num, &num_bins);
+
+    /* Reference first fit over the sorted subtrees */
+    for (i = 1; i < num; i++) {
+      assert(subtrees[i - 1].size >= subtrees[i].size);
+    }
+    memset(cnt, 0, sizeof(cnt));
+    for (b = 0; b < num_free; b++) left[b] = depth[b];
+    used = 0;
+    for (i = 0; i < num; i++) {
+      for (b = 0; b < num_free; b++) {
+        if (cnt[b] < max && left[b] >= subtrees[i].size) break;
+      }
+      if (b == num_free) break;
+      if (sts == PIPE_SUCCESS) assert(subtrees[i].bin == b);
+      left[b] -= subtrees[i].size;
+      cnt[b]++;
+      if (b + 1 > used) used = b + 1;
+    }
+    if (i < num) {
+      assert(sts == PIPE_NO_SPACE);
+    } else {
+      assert(sts == PIPE_SUCCESS);
+      assert(num_bins == used);
+    }
+  }
+}
+
+int main() {
+  test_carve_fixed();
+  test_carve_random(2000);
+  test_pack_fixed();
+  test_pack_random(20000);
+  printf("alpm bulk tests passed\n");
+  return 0;
+}
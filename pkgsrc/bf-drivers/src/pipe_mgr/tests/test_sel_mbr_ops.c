@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*
+ * Tests of the folding of selector member operations done by
+ * pipe_mgr_sel_grp_mbrs_update before the group is programmed.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../pipe_mgr_sel_mbr_ops.h"
+
+#define TEST_MAX_MBRS 16
+
+static pipe_adt_ent_hdl_t test_mbrs[TEST_MAX_MBRS];
+static bool test_enable[TEST_MAX_MBRS];
+static uint32_t test_num_mbrs;
+
+static pipe_status_t test_apply(uint32_t num_ops,
+                                const pipe_mgr_sel_mbr_op_e *ops,
+                                const pipe_adt_ent_hdl_t *op_mbrs,
+                                uint32_t *err_idx) {
+  return pipe_mgr_sel_mbr_ops_apply(
+      num_ops, ops, op_mbrs, test_mbrs, test_enable, &test_num_mbrs, err_idx);
+}
+
+static void test_check(uint32_t num_mbrs,
+                       const pipe_adt_ent_hdl_t *mbrs,
+                       const bool *enable) {
+  uint32_t i;
+
+  assert(test_num_mbrs == num_mbrs);
+  for (i = 0; i < num_mbrs; i++) {
+    assert(test_mbrs[i] == mbrs[i]);
+    assert(test_enable[i] == enable[i]);
+  }
+}
+
+static void test_set(uint32_t num_mbrs,
+                     const pipe_adt_ent_hdl_t *mbrs,
+                     const bool *enable) {
+  memcpy(test_mbrs, mbrs, num_mbrs * sizeof(pipe_adt_ent_hdl_t));
+  memcpy(test_enable, enable, num_mbrs * sizeof(bool));
+  test_num_mbrs = num_mbrs;
+}
+
+static void test_add_del(void) {
+  const pipe_adt_ent_hdl_t init_mbrs[] = {1, 2, 3, 2};
+  const bool init_enable[] = {true, true, false, false};
+  uint32_t err_idx = ~0u;
+
+  /* Adds append, a delete takes out the last instance only. */
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_ADD,
+                                         PIPE_MGR_SEL_MBR_OP_ADD_DISABLED,
+                                         PIPE_MGR_SEL_MBR_OP_DEL};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {4, 5, 2};
+    const pipe_adt_ent_hdl_t mbrs[] = {1, 2, 3, 4, 5};
+    const bool enable[] = {true, true, false, true, false};
+
+    test_set(4, init_mbrs, init_enable);
+    assert(test_apply(3, ops, op_mbrs, &err_idx) == PIPE_SUCCESS);
+    test_check(5, mbrs, enable);
+  }
+
+  /* Operations which cancel out leave the membership as it was. */
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_ADD,
+                                         PIPE_MGR_SEL_MBR_OP_DISABLE,
+                                         PIPE_MGR_SEL_MBR_OP_ENABLE,
+                                         PIPE_MGR_SEL_MBR_OP_DEL};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {7, 1, 1, 7};
+
+    test_set(4, init_mbrs, init_enable);
+    assert(test_apply(4, ops, op_mbrs, &err_idx) == PIPE_SUCCESS);
+    test_check(4, init_mbrs, init_enable);
+  }
+
+  /* Enable and disable act on every instance. */
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_ENABLE,
+                                         PIPE_MGR_SEL_MBR_OP_DISABLE};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {2, 1};
+    const bool enable[] = {false, true, false, true};
+
+    test_set(4, init_mbrs, init_enable);
+    assert(test_apply(2, ops, op_mbrs, &err_idx) == PIPE_SUCCESS);
+    test_check(4, init_mbrs, enable);
+  }
+
+  /* Deleting every instance empties the group. */
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_DEL,
+                                         PIPE_MGR_SEL_MBR_OP_DEL,
+                                         PIPE_MGR_SEL_MBR_OP_DEL,
+                                         PIPE_MGR_SEL_MBR_OP_DEL};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {2, 3, 1, 2};
+
+    test_set(4, init_mbrs, init_enable);
+    assert(test_apply(4, ops, op_mbrs, &err_idx) == PIPE_SUCCESS);
+    test_check(0, NULL, NULL);
+  }
+}
+
+static void test_errors(void) {
+  const pipe_adt_ent_hdl_t init_mbrs[] = {1, 2};
+  const bool init_enable[] = {true, true};
+  uint32_t err_idx = ~0u;
+
+  /* A member deleted earlier in the list is no longer there. */
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_DEL,
+                                         PIPE_MGR_SEL_MBR_OP_ENABLE};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {2, 2};
+
+    test_set(2, init_mbrs, init_enable);
+    assert(test_apply(2, ops, op_mbrs, &err_idx) == PIPE_OBJ_NOT_FOUND);
+    assert(err_idx == 1);
+  }
+
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_DEL};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {9};
+
+    test_set(2, init_mbrs, init_enable);
+    assert(test_apply(1, ops, op_mbrs, &err_idx) == PIPE_OBJ_NOT_FOUND);
+    assert(err_idx == 0);
+  }
+
+  {
+    const pipe_mgr_sel_mbr_op_e ops[] = {PIPE_MGR_SEL_MBR_OP_ADD,
+                                         (pipe_mgr_sel_mbr_op_e)42};
+    const pipe_adt_ent_hdl_t op_mbrs[] = {3, 3};
+
+    test_set(2, init_mbrs, init_enable);
+    assert(test_apply(2, ops, op_mbrs, &err_idx) == PIPE_INVALID_ARG);
+    assert(err_idx == 1);
+  }
+}
+
+int main() {
+  test_add_del();
+  test_errors();
+  printf("sel mbr ops tests passed\n");
+  return 0;
+}
@@ -0,0 +1,239 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+/*
+ * Tests of the selector word log.  Move lists of random word changes are run
+ * with some nodes writing a word early and some lists failing part way, and
+ * the modelled hardware is checked to hold exactly the changes of the nodes
+ * that completed after the flush.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../pipe_mgr_sel_word_log.h"
+#include "../pipe_mgr_test_rand.h"
+
+#define TEST_STAGES 2
+#define TEST_WORDS 16
+#define TEST_BYTES SEL_LLP_WORD_DATA_BYTES
+#define TEST_MAX_NODE_WRITES TEST_STAGES
+
+static uint32_t test_rand_state = 0x9E3779B9;
+
+static uint32_t test_rand(uint32_t n) {
+  return pipe_mgr_test_rand(&test_rand_state) % n;
+}
+
+static sel_llp_word_log_t test_log;
+/* Word contents in software, in hardware and after the last completed node */
+static uint8_t test_sw[TEST_STAGES][TEST_WORDS][TEST_BYTES];
+static uint8_t test_hw[TEST_STAGES][TEST_WORDS][TEST_BYTES];
+static uint8_t test_ref[TEST_STAGES][TEST_WORDS][TEST_BYTES];
+static uint32_t test_idx[TEST_STAGES][TEST_WORDS];
+
+/* Instructions posted by the node being processed */
+static struct {
+  uint8_t stage;
+  uint32_t word;
+  uint8_t data[TEST_BYTES];
+} test_node_writes[TEST_MAX_NODE_WRITES];
+static uint32_t test_num_node_writes;
+
+static void test_touch(uint8_t stage, uint32_t word) {
+  sel_llp_pending_word_t *pending;
+  pipe_status_t sts;
+
+  sts = pipe_mgr_sel_word_log_add(&test_log,
+                                  stage,
+                                  word,
+                                  test_sw[stage][word],
+                                  TEST_BYTES,
+                                  &test_idx[stage][word]);
+  assert(sts == PIPE_SUCCESS);
+  pending = pipe_mgr_sel_word_log_get(
+      &test_log, test_idx[stage][word], stage, word);
+  assert(pending);
+}
+
+static void test_write_now(uint8_t stage, uint32_t word) {
+  sel_llp_pending_word_t *pending = pipe_mgr_sel_word_log_get(
+      &test_log, test_idx[stage][word], stage, word);
+
+  assert(pending);
+  assert(test_num_node_writes < TEST_MAX_NODE_WRITES);
+  test_node_writes[test_num_node_writes].stage = stage;
+  test_node_writes[test_num_node_writes].word = word;
+  memcpy(test_node_writes[test_num_node_writes].data,
+         test_sw[stage][word],
+         TEST_BYTES);
+  test_num_node_writes++;
+  pipe_mgr_sel_word_log_written(pending, test_sw[stage][word], TEST_BYTES);
+}
+
+static void test_node_end(bool failed, bool batch) {
+  uint32_t i;
+
+  /* A batch rolls back the instructions of a failed node. */
+  if (!failed || !batch) {
+    for (i = 0; i < test_num_node_writes; i++) {
+      memcpy(test_hw[test_node_writes[i].stage][test_node_writes[i].word],
+             test_node_writes[i].data,
+             TEST_BYTES);
+    }
+  }
+  test_num_node_writes = 0;
+  if (failed) {
+    pipe_mgr_sel_word_log_node_abort(&test_log);
+  } else {
+    memcpy(test_ref, test_sw, sizeof(test_sw));
+  }
+}
+
+/* Returns the number of words written. */
+static uint32_t test_flush(void) {
+  uint32_t i, writes = 0;
+
+  for (i = 0; i < test_log.num_words; i++) {
+    sel_llp_pending_word_t *pending = &test_log.words[i];
+    uint8_t *sw = test_sw[pending->stage_idx][pending->word_idx];
+    uint8_t *hw = test_hw[pending->stage_idx][pending->word_idx];
+    uint8_t *data;
+
+    data = pipe_mgr_sel_word_log_flush_data(pending, sw, TEST_BYTES);
+    if (!data) {
+      assert(!memcmp(sw, hw, TEST_BYTES));
+      continue;
+    }
+    if (!pending->rewrite) assert(memcmp(data, hw, TEST_BYTES));
+    memcpy(hw, data, TEST_BYTES);
+    writes++;
+  }
+  pipe_mgr_sel_word_log_reset(&test_log);
+  return writes;
+}
+
+static void test_check_hw(void) {
+  assert(!memcmp(test_hw, test_ref, sizeof(test_hw)));
+}
+
+static void test_reset(void) {
+  memset(test_sw, 0, sizeof(test_sw));
+  memset(test_hw, 0, sizeof(test_hw));
+  memset(test_ref, 0, sizeof(test_ref));
+  memset(test_idx, 0, sizeof(test_idx));
+  pipe_mgr_sel_word_log_reset(&test_log);
+}
+
+static void test_fixed(void) {
+  test_reset();
+
+  /* A word changed back by a later node is not written at all. */
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(0, 3);
+  test_sw[0][3][0] = 0x5;
+  test_node_end(false, true);
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(0, 3);
+  test_sw[0][3][0] = 0;
+  test_node_end(false, true);
+  assert(test_flush() == 0);
+  test_check_hw();
+
+  /* A word changed by several nodes is written once. */
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(1, 2);
+  test_sw[1][2][1] = 0x1;
+  test_touch(0, 2);
+  test_sw[0][2][1] = 0x1;
+  test_node_end(false, true);
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(1, 2);
+  test_sw[1][2][1] |= 0x2;
+  test_node_end(false, true);
+  assert(test_flush() == 2);
+  test_check_hw();
+
+  /* A failed node drops the word it touched first and sets back the word
+   * an earlier node changed, its early write being rolled back. */
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(1, 2);
+  test_sw[1][2][1] |= 0x4;
+  test_node_end(false, true);
+  pipe_mgr_sel_word_log_node_start(&test_log);
+  test_touch(1, 2);
+  test_write_now(1, 2);
+  test_sw[1][2][1] |= 0x8;
+  test_touch(0, 7);
+  test_sw[0][7][0] = 0xFF;
+  test_node_end(true, true);
+  assert(test_flush() == 1);
+  test_check_hw();
+  assert(test_hw[1][2][1] == 0x7);
+  assert(test_hw[0][7][0] == 0);
+
+  pipe_mgr_sel_word_log_destroy(&test_log);
+}
+
+static void test_random(uint32_t num_lists) {
+  uint32_t l;
+
+  test_reset();
+  for (l = 0; l < num_lists; l++) {
+    uint32_t num_nodes = 1 + test_rand(8);
+    uint32_t fail_at = test_rand(3) ? num_nodes : test_rand(num_nodes);
+    bool batch = test_rand(2);
+    uint8_t stage;
+    uint32_t n;
+
+    for (n = 0; n < num_nodes && n <= fail_at; n++) {
+      pipe_mgr_sel_word_log_node_start(&test_log);
+      /* Like a move list node, one word per stage and an early write only
+       * before the word is changed. */
+      for (stage = 0; stage < TEST_STAGES; stage++) {
+        uint32_t word = test_rand(TEST_WORDS);
+        uint32_t bit = test_rand(4);
+
+        if (!test_rand(3)) continue;
+        test_touch(stage, word);
+        if (!test_rand(4)) test_write_now(stage, word);
+        /* Few bits so changes often cancel out. */
+        test_sw[stage][word][bit >> 1] ^= 1 << (bit & 1);
+      }
+      test_node_end(n == fail_at, batch);
+    }
+    test_flush();
+    test_check_hw();
+    /* The software state of a failed node is not undone by the log. */
+    memcpy(test_sw, test_ref, sizeof(test_sw));
+  }
+  pipe_mgr_sel_word_log_destroy(&test_log);
+}
+
+int main() {
+  test_fixed();
+  test_random(20000);
+  printf("sel word log tests passed\n");
+  return 0;
+}
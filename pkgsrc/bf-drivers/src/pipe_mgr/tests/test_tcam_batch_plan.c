@@ -0,0 +1,288 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*
+ * Tests of the TCAM batch placement planner.  The planner only works on
+ * ranks and priorities so partitions are made up in memory; every plan is
+ * checked for a valid priority order, for the move sequence the table manager
+ * derives from it, and on small partitions against a brute force search for
+ * the largest number of existing entries that can stay in place.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../pipe_mgr_tcam_batch_plan.h"
+#include "../pipe_mgr_test_rand.h"
+
+#define TEST_MAX_RANKS 12
+#define TEST_NONE 0xFFFFFFFF
+
+static uint32_t test_rand_state = 0x2545F491;
+
+static uint32_t test_rand(uint32_t n) {
+  return pipe_mgr_test_rand(&test_rand_state) % n;
+}
+
+static uint32_t rank_to_index[TEST_MAX_RANKS];
+static uint32_t old_rank[TEST_MAX_RANKS], old_prio[TEST_MAX_RANKS];
+static uint32_t old_dst[TEST_MAX_RANKS];
+static uint32_t new_prio[TEST_MAX_RANKS], new_dst[TEST_MAX_RANKS];
+
+static void test_plan_setup(tcam_batch_plan_t *plan,
+                            uint32_t num_ranks,
+                            uint32_t num_old,
+                            const uint32_t *o_rank,
+                            const uint32_t *o_prio,
+                            uint32_t num_new,
+                            const uint32_t *n_prio) {
+  uint32_t i;
+
+  memset(plan, 0, sizeof(*plan));
+  plan->num_ranks = num_ranks;
+  plan->rank_to_index = rank_to_index;
+  plan->num_old = num_old;
+  plan->old_rank = old_rank;
+  plan->old_prio = old_prio;
+  plan->old_dst = old_dst;
+  plan->num_new = num_new;
+  plan->new_prio = new_prio;
+  plan->new_dst = new_dst;
+  for (i = 0; i < num_ranks; i++) rank_to_index[i] = i;
+  for (i = 0; i < num_old; i++) {
+    old_rank[i] = o_rank[i];
+    old_prio[i] = o_prio[i];
+    old_dst[i] = TEST_NONE;
+  }
+  for (i = 0; i < num_new; i++) {
+    new_prio[i] = n_prio[i];
+    new_dst[i] = TEST_NONE;
+  }
+}
+
+/* Check the layout and replay the moves the way the table manager does:
+ * entries moving up in ascending, entries moving down in descending order of
+ * their rank, then the adds.  Each has to land on a free rank and a move may
+ * only pass entries of its own priority.  Returns the number of existing
+ * entries kept in place.
+ */
+static uint32_t test_plan_check(tcam_batch_plan_t *plan) {
+  uint32_t owner[TEST_MAX_RANKS];
+  uint32_t prio_at[TEST_MAX_RANKS];
+  uint32_t last_prio = 0, kept = 0;
+  uint32_t i, r, lo, hi;
+  int64_t j;
+
+  for (r = 0; r < plan->num_ranks; r++) owner[r] = TEST_NONE;
+  for (i = 0; i < plan->num_old; i++) {
+    assert(plan->old_dst[i] < plan->num_ranks);
+    assert(owner[plan->old_dst[i]] == TEST_NONE);
+    owner[plan->old_dst[i]] = i;
+    if (plan->old_dst[i] == plan->old_rank[i]) kept++;
+  }
+  for (i = 0; i < plan->num_new; i++) {
+    assert(plan->new_dst[i] < plan->num_ranks);
+    assert(owner[plan->new_dst[i]] == TEST_NONE);
+    owner[plan->new_dst[i]] = plan->num_old + i;
+  }
+  /* priority order over the final layout */
+  for (r = 0; r < plan->num_ranks; r++) {
+    uint32_t p;
+    if (owner[r] == TEST_NONE) continue;
+    p = owner[r] < plan->num_old ? plan->old_prio[owner[r]]
+                                 : plan->new_prio[owner[r] - plan->num_old];
+    assert(p >= last_prio);
+    last_prio = p;
+  }
+
+  for (r = 0; r < plan->num_ranks; r++) prio_at[r] = TEST_NONE;
+  for (i = 0; i < plan->num_old; i++) {
+    prio_at[plan->old_rank[i]] = plan->old_prio[i];
+  }
+  for (j = 0; j < 2 * (int64_t)plan->num_old; j++) {
+    bool up = j < plan->num_old;
+    i = up ? j : 2 * plan->num_old - 1 - j;
+    if (up ? plan->old_dst[i] >= plan->old_rank[i]
+           : plan->old_dst[i] <= plan->old_rank[i]) {
+      continue;
+    }
+    assert(prio_at[plan->old_dst[i]] == TEST_NONE);
+    lo = up ? plan->old_dst[i] : plan->old_rank[i];
+    hi = up ? plan->old_rank[i] : plan->old_dst[i];
+    for (r = lo + 1; r < hi; r++) {
+      assert(prio_at[r] == TEST_NONE || prio_at[r] == plan->old_prio[i]);
+    }
+    prio_at[plan->old_rank[i]] = TEST_NONE;
+    prio_at[plan->old_dst[i]] = plan->old_prio[i];
+  }
+  for (i = 0; i < plan->num_new; i++) {
+    assert(prio_at[plan->new_dst[i]] == TEST_NONE);
+    prio_at[plan->new_dst[i]] = plan->new_prio[i];
+  }
+  return kept;
+}
+
+/* Largest number of existing entries that any valid layout keeps in place.
+ * Every choice of ranks for the items in priority order is tried; within a
+ * band the entries may be in any order, so an existing entry stays if its
+ * rank is one of the ranks of its band.
+ */
+static uint32_t test_best_kept(tcam_batch_plan_t *plan) {
+  uint32_t num_items = plan->num_old + plan->num_new;
+  uint32_t prio[2 * TEST_MAX_RANKS];
+  uint32_t best = 0, set, i, j, n, k;
+
+  /* priorities of the items in order */
+  for (i = 0, j = 0, n = 0; i < num_items; i++) {
+    if (n >= plan->num_new ||
+        (j < plan->num_old && plan->old_prio[j] <= plan->new_prio[n])) {
+      prio[i] = plan->old_prio[j++];
+    } else {
+      prio[i] = plan->new_prio[n++];
+    }
+  }
+  for (set = 0; set < (1u << plan->num_ranks); set++) {
+    uint32_t ranks[TEST_MAX_RANKS], kept = 0;
+    if ((uint32_t)__builtin_popcount(set) != num_items) continue;
+    for (i = 0, k = 0; i < plan->num_ranks; i++) {
+      if (set & (1u << i)) ranks[k++] = i;
+    }
+    for (j = 0; j < plan->num_old; j++) {
+      for (i = 0; i < num_items; i++) {
+        if (ranks[i] == plan->old_rank[j] && prio[i] == plan->old_prio[j]) {
+          kept++;
+          break;
+        }
+      }
+    }
+    if (kept > best) best = kept;
+  }
+  return best;
+}
+
+static void test_gap_policies(void) {
+  static const uint32_t prio[6] = {1, 1, 2, 2, 3, 3};
+  static const uint32_t none[6] = {0, 1, 2, 3, 4, 5};
+  static const uint32_t fixed[6] = {1, 2, 4, 5, 7, 8};
+  static const uint32_t spread[6] = {2, 3, 6, 7, 9, 10};
+  tcam_batch_plan_t plan;
+
+  test_plan_setup(&plan, 12, 0, NULL, NULL, 6, prio);
+  assert(pipe_mgr_tcam_batch_plan(&plan, PIPE_MGR_TERN_GAP_POLICY_NONE, 0) ==
+         PIPE_SUCCESS);
+  assert(!memcmp(plan.new_dst, none, sizeof(none)));
+
+  test_plan_setup(&plan, 12, 0, NULL, NULL, 6, prio);
+  assert(pipe_mgr_tcam_batch_plan(&plan, PIPE_MGR_TERN_GAP_POLICY_FIXED, 1) ==
+         PIPE_SUCCESS);
+  assert(!memcmp(plan.new_dst, fixed, sizeof(fixed)));
+
+  test_plan_setup(&plan, 12, 0, NULL, NULL, 6, prio);
+  assert(pipe_mgr_tcam_batch_plan(
+             &plan, PIPE_MGR_TERN_GAP_POLICY_SPREAD, 0) == PIPE_SUCCESS);
+  assert(!memcmp(plan.new_dst, spread, sizeof(spread)));
+}
+
+static void test_keep_in_place(void) {
+  static const uint32_t o_rank[2] = {0, 4};
+  static const uint32_t o_prio[2] = {1, 3};
+  static const uint32_t n_prio[3] = {2, 2, 2};
+  static const uint32_t full_rank[4] = {0, 1, 2, 3};
+  static const uint32_t full_prio[4] = {5, 5, 5, 5};
+  static const uint32_t first_prio[4] = {1, 1, 1, 1};
+  tcam_batch_plan_t plan;
+  uint32_t i;
+
+  /* the new band fits between the existing ones, nothing moves */
+  test_plan_setup(&plan, 8, 2, o_rank, o_prio, 3, n_prio);
+  assert(pipe_mgr_tcam_batch_plan(&plan, PIPE_MGR_TERN_GAP_POLICY_NONE, 0) ==
+         PIPE_SUCCESS);
+  assert(test_plan_check(&plan) == 2);
+  for (i = 0; i < 3; i++) {
+    assert(plan.new_dst[i] > 0 && plan.new_dst[i] < 4);
+  }
+
+  /* higher priority entries for a full partition, all existing ones go down
+   * by exactly the number of new entries */
+  test_plan_setup(&plan, 8, 4, full_rank, full_prio, 4, first_prio);
+  assert(pipe_mgr_tcam_batch_plan(
+             &plan, PIPE_MGR_TERN_GAP_POLICY_SPREAD, 0) == PIPE_SUCCESS);
+  assert(test_plan_check(&plan) == 0);
+  for (i = 0; i < 4; i++) {
+    assert(plan.old_dst[i] == i + 4);
+    assert(plan.new_dst[i] == i);
+  }
+
+  /* one entry too many */
+  test_plan_setup(&plan, 8, 4, full_rank, full_prio, 5, first_prio);
+  assert(pipe_mgr_tcam_batch_plan(&plan, PIPE_MGR_TERN_GAP_POLICY_NONE, 0) ==
+         PIPE_NO_SPACE);
+}
+
+static void test_random(uint32_t iterations) {
+  static const pipe_mgr_tbl_prop_tern_gap_policy_value_t policies[3] = {
+      PIPE_MGR_TERN_GAP_POLICY_NONE,
+      PIPE_MGR_TERN_GAP_POLICY_FIXED,
+      PIPE_MGR_TERN_GAP_POLICY_SPREAD};
+  uint32_t o_rank[TEST_MAX_RANKS], o_prio[TEST_MAX_RANKS];
+  uint32_t n_prio[TEST_MAX_RANKS];
+  tcam_batch_plan_t plan;
+  uint32_t it, i, num_ranks, num_old, num_new, num_prios, kept;
+
+  for (it = 0; it < iterations; it++) {
+    num_ranks = 1 + test_rand(TEST_MAX_RANKS);
+    num_prios = 1 + test_rand(4);
+    num_old = 0;
+    for (i = 0; i < num_ranks; i++) {
+      if (test_rand(2)) o_rank[num_old++] = i;
+    }
+    for (i = 0; i < num_old; i++) o_prio[i] = test_rand(num_prios);
+    num_new = test_rand(num_ranks - num_old + 1);
+    for (i = 0; i < num_new; i++) n_prio[i] = test_rand(num_prios);
+    /* existing entries are in priority order, new ones sorted */
+    for (i = 1; i < num_old; i++) {
+      if (o_prio[i] < o_prio[i - 1]) o_prio[i] = o_prio[i - 1];
+    }
+    for (i = 1; i < num_new; i++) {
+      if (n_prio[i] < n_prio[i - 1]) n_prio[i] = n_prio[i - 1];
+    }
+
+    test_plan_setup(&plan, num_ranks, num_old, o_rank, o_prio, num_new, n_prio);
+    assert(pipe_mgr_tcam_batch_plan(&plan, policies[it % 3], test_rand(3)) ==
+           PIPE_SUCCESS);
+    kept = test_plan_check(&plan);
+    /* the exact search is used whenever it is cheap enough, which it always
+     * is with this few choices per entry */
+    if ((uint64_t)num_old * (num_ranks - num_old - num_new + 1) <=
+        8 * (uint64_t)num_ranks) {
+      assert(kept == test_best_kept(&plan));
+    }
+  }
+}
+
+int main() {
+  test_gap_policies();
+  test_keep_in_place();
+  test_random(20000);
+  printf("tcam batch plan tests passed\n");
+  return 0;
+}
@@ -83,13 +83,58 @@ bool bf_pkt_is_inited(bf_dev_id_t dev_id) {
 
 static void pkt_mgr_tbus_setup(bf_dev_id_t dev_id, bf_subdev_id_t subdev_id);
 
+/* Number of free buffers handed to the FM DR per batched descriptor push. */
+#define PKT_MGR_FM_PUSH_BATCH 64
+
+static int pkt_mgr_push_rx_buff_batch(bf_dev_id_t dev_id,
+                                      bf_subdev_id_t subdev_id,
+                                      int rx_ring,
+                                      void *dma_pool,
+                                      unsigned int size,
+                                      bf_pkt_buf_info_t **bufs,
+                                      bf_dma_addr_t *dma_addrs,
+                                      int n) {
+  int ret, i;
+
+  ret = lld_subdev_push_fm_n(
+      dev_id, subdev_id, lld_dr_fm_pkt_0 + rx_ring, n, dma_addrs, size);
+  if (ret == n) return 0;
+
+  /* The FM DR is sized for all of its buffers so a partial push is an error
+   * as well; unmap whatever did not make it onto the DR. */
+  i = ret < 0 ? 0 : ret;
+  LOG_ERROR(
+      "Load pkt FM error %d dev %d subdev %d rx_ring %d addr 0x%" PRIx64
+      " (%p) size %d\n",
+      ret,
+      dev_id,
+      subdev_id,
+      rx_ring,
+      dma_addrs[i],
+      bufs[i]->vaddr,
+      size);
+  for (; i < n; i++) {
+    if (bf_sys_dma_unmap((bf_sys_dma_pool_handle_t)dma_pool,
+                         bufs[i]->vaddr,
+                         size,
+                         BF_DMA_TO_CPU) != 0) {
+      LOG_ERROR("Unable to unmap DMA buffer %p at %s:%d",
+                bufs[i]->vaddr,
+                __func__,
+                __LINE__);
+    }
+  }
+  return -1;
+}
+
 static int pkt_mgr_setup_rx_buff(bf_dev_id_t dev_id,
                                  bf_subdev_id_t subdev_id,
                                  bf_dma_info_t *dma_info) {
   unsigned int i, size;
   void *dma_pool;
-  bf_dma_addr_t dma_addr;
-  int ret = 0;
+  bf_pkt_buf_info_t *batch[PKT_MGR_FM_PUSH_BATCH];
+  bf_dma_addr_t batch_addr[PKT_MGR_FM_PUSH_BATCH];
+  int batch_cnt;
 
   for (i = 0; i < BF_PKT_RX_RING_MAX; i++) {
     dma_pool = pkt_drv_info[dev_id][subdev_id]->rx_pkt_ctx[i].dma_pool;
@@ -102,6 +147,7 @@ static int pkt_mgr_setup_rx_buff(bf_dev_id_t dev_id,
     }
     size = bf_dma_get_buf_size(dma_info, BF_DMA_CPU_PKT_RECEIVE_0 + i);
 
+    batch_cnt = 0;
     bf_pkt_buf_info_t *b = pkt_drv_info[dev_id][subdev_id]->rx_bufs[i].bufs;
     for (; b; b = b->next) {
       /* Map the virtual address of the buffer to the DMA addres before it is
@@ -110,37 +156,37 @@ static int pkt_mgr_setup_rx_buff(bf_dev_id_t dev_id,
                          b->vaddr,
                          b->phy_addr,
                          size,
-                         &dma_addr,
+                         &batch_addr[batch_cnt],
                          BF_DMA_TO_CPU) != 0) {
         LOG_ERROR("Unable to map DMA buffer %p at %s:%d",
                   b->vaddr,
                   __func__,
                   __LINE__);
+        if (batch_cnt) {
+          pkt_mgr_push_rx_buff_batch(dev_id,
+                                     subdev_id,
+                                     i,
+                                     dma_pool,
+                                     size,
+                                     batch,
+                                     batch_addr,
+                                     batch_cnt);
+        }
         goto free_and_exit;
       }
-      ret = lld_subdev_push_fm(
-          dev_id, subdev_id, lld_dr_fm_pkt_0 + i, dma_addr, size);
-      if (ret != LLD_OK) {
-        if (bf_sys_dma_unmap((bf_sys_dma_pool_handle_t)dma_pool,
-                             b->vaddr,
-                             size,
-                             BF_DMA_TO_CPU) != 0) {
-          LOG_ERROR("Unable to unmap DMA buffer %p at %s:%d",
-                    b->vaddr,
-                    __func__,
-                    __LINE__);
+      batch[batch_cnt++] = b;
+      if (batch_cnt == PKT_MGR_FM_PUSH_BATCH || !b->next) {
+        if (pkt_mgr_push_rx_buff_batch(dev_id,
+                                       subdev_id,
+                                       i,
+                                       dma_pool,
+                                       size,
+                                       batch,
+                                       batch_addr,
+                                       batch_cnt)) {
+          goto free_and_exit;
         }
-        LOG_ERROR(
-            "Load pkt FM error %d dev %d subdev %d rx_ring %d addr 0x%" PRIx64
-            " (%p) size %d\n",
-            ret,
-            dev_id,
-            subdev_id,
-            i,
-            dma_addr,
-            b->vaddr,
-            size);
-        goto free_and_exit;
+        batch_cnt = 0;
       }
     }
     if (lld_dr_start(dev_id, subdev_id, lld_dr_fm_pkt_0 + i) != LLD_OK) {
@@ -632,6 +678,8 @@ static bf_status_t pkt_mgr_remove_device(bf_dev_id_t dev_id) {
     return BF_INVALID_ARG;
   }
 
+  pkt_mgr_shm_cleanup(dev_id);
+
   for (i = 0; i < PKT_MGR_NUM_SUBDEVICES; i++) {
     if (!pkt_drv_info[dev_id][i]) {
       continue;
@@ -657,6 +705,7 @@ static bf_status_t pkt_mgr_remove_device(bf_dev_id_t dev_id) {
         pkt_mgr_teardown_rx_buff(dev_id, i);
       }
     }
+    pkt_mgr_rx_pkt_cache_drain(dev_id, i);
     for (j = 0; j < BF_PKT_RX_RING_MAX; j++) {
       bf_sys_mutex_del(&(pkt_drv_info[dev_id][i]->rx_pkt_ctx[j].ring_mtx));
     }
@@ -994,8 +1043,11 @@ bf_status_t bf_dma_service_pkt(bf_dev_id_t dev_id) {
     }
     for (i = 0; i < BF_PKT_RX_RING_MAX; i++) {
       lld_dr_service(dev_id, subdev_id, lld_dr_rx_pkt_0 + i, 100);
+      /* a partial burst is not held back past the end of the service pass */
+      pkt_mgr_rx_burst_flush(dev_id, subdev_id, i);
     }
   }
+  pkt_mgr_shm_service(dev_id);
   return BF_SUCCESS;
 }
 
@@ -1227,6 +1279,7 @@ bf_status_t bf_pkt_init(void) {
   if (pkt_mgr_init_pkt_queue(BF_PKT_CNT) != PKT_SUCCESS) {
     return BF_NO_SYS_RESOURCES;
   }
+  pkt_mgr_shm_init();
 
   sts = bf_drv_register("pkt-mgr", &bf_drv_hdl);
   bf_sys_assert(sts == BF_SUCCESS);
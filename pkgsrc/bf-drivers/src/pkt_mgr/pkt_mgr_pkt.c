@@ -102,6 +102,24 @@ void pkt_mgr_uninit_pkt_queue(void) {
   bf_pkt_q_gate = 0;
 }
 
+static void pkt_mgr_pkt_attach_buf(bf_pkt *pkt,
+                                   bf_dev_id_t id,
+                                   bf_subdev_id_t subdev_id,
+                                   size_t size,
+                                   bf_dma_type_t dr,
+                                   uint8_t *buf,
+                                   bf_phys_addr_t phys_addr,
+                                   bf_sys_dma_pool_handle_t hndl) {
+  bf_pkt_set_pkt_data(pkt, buf);
+  bf_pkt_set_pkt_dma_pool_handle(pkt, hndl);
+  bf_pkt_set_phys_pkt_data(pkt, phys_addr);
+  bf_pkt_set_pkt_size(pkt, size);
+  bf_pkt_set_pkt_dev(pkt, id);
+  bf_pkt_set_pkt_subdev(pkt, subdev_id);
+  bf_pkt_set_pkt_dr(pkt, dr);
+  bf_pkt_set_nextseg(pkt, NULL);
+}
+
 int bf_pkt_alloc_ext_buf(bf_dev_id_t id,
                          bf_subdev_id_t subdev_id,
                          bf_pkt **pkt,
@@ -134,14 +152,8 @@ int bf_pkt_alloc_ext_buf(bf_dev_id_t id,
       bf_pkt_free_ext_buf(id, subdev_id, *pkt);
       return -1;
     }
-    bf_pkt_set_pkt_data(*pkt, buf);
-    bf_pkt_set_pkt_dma_pool_handle(*pkt, hndl);
-    bf_pkt_set_phys_pkt_data(*pkt, phys_addr);
-    bf_pkt_set_pkt_size(*pkt, size);
-    bf_pkt_set_pkt_dev(*pkt, id);
-    bf_pkt_set_pkt_subdev(*pkt, subdev_id);
-    bf_pkt_set_pkt_dr(*pkt, dr);
-    bf_pkt_set_nextseg(*pkt, NULL);
+    pkt_mgr_pkt_attach_buf(
+        *pkt, id, subdev_id, size, dr, buf, phys_addr, hndl);
   }
   return err;
 }
@@ -172,6 +184,143 @@ int bf_pkt_free_ext_buf(bf_dev_id_t id, bf_subdev_id_t subdev_id, bf_pkt *pkt) {
   return err;
 }
 
+int pkt_mgr_pkt_get_n(bf_dev_id_t id,
+                      bf_subdev_id_t subdev_id,
+                      bf_pkt **pkts,
+                      int n) {
+  int cnt, i;
+
+  if (id >= PKT_MGR_NUM_DEVICES || subdev_id >= PKT_MGR_NUM_SUBDEVICES ||
+      n < 0) {
+    return -1;
+  }
+
+  do {
+  } while (__sync_bool_compare_and_swap(&bf_pkt_q_gate, 0, 1) == 0);
+
+  cnt = bf_queue_max - bf_queue_head;
+  if (cnt > n) {
+    cnt = n;
+  }
+  for (i = 0; i < cnt; i++) {
+    pkts[i] = bf_pkt_queue[bf_queue_head++];
+  }
+  pkt_drv_info[id][subdev_id]->alloc_stat.pkt_alloc_ok += cnt;
+  if (cnt < n) {
+    pkt_drv_info[id][subdev_id]->alloc_stat.pkt_alloc_err++;
+  }
+
+  __sync_bool_compare_and_swap(&bf_pkt_q_gate, 1, 0);
+  return cnt;
+}
+
+int pkt_mgr_pkt_put_n(bf_dev_id_t id,
+                      bf_subdev_id_t subdev_id,
+                      bf_pkt **pkts,
+                      int n) {
+  int err = 0;
+  int i;
+
+  if (id >= PKT_MGR_NUM_DEVICES || subdev_id >= PKT_MGR_NUM_SUBDEVICES ||
+      n < 0) {
+    return -1;
+  }
+
+  for (i = 0; i < n; i++) {
+    bf_pkt_set_pkt_data(pkts[i], NULL);
+    bf_pkt_set_pkt_size(pkts[i], 0);
+  }
+
+  do {
+  } while (__sync_bool_compare_and_swap(&bf_pkt_q_gate, 0, 1) == 0);
+
+  if (bf_queue_head < n || bf_queue_head > bf_queue_max) {
+    pkt_drv_info[id][subdev_id]->alloc_stat.pkt_free_err++;
+    err = -1;
+  } else {
+    pkt_drv_info[id][subdev_id]->alloc_stat.pkt_free_ok += n;
+    for (i = 0; i < n; i++) {
+      bf_queue_head--;
+      bf_pkt_queue[bf_queue_head] = pkts[i];
+    }
+  }
+
+  __sync_bool_compare_and_swap(&bf_pkt_q_gate, 1, 0);
+  return err;
+}
+
+int pkt_mgr_rx_pkt_alloc(bf_dev_id_t id,
+                         bf_subdev_id_t subdev_id,
+                         int cos,
+                         bf_pkt **pkt,
+                         size_t size,
+                         uint8_t *buf,
+                         bf_sys_dma_pool_handle_t hndl) {
+  pkt_drv_info_t *drv_info;
+  bf_phys_addr_t phys_addr;
+  int cnt;
+
+  if (id >= PKT_MGR_NUM_DEVICES || subdev_id >= PKT_MGR_NUM_SUBDEVICES ||
+      cos < 0 || cos >= BF_PKT_RX_RING_MAX) {
+    return -1;
+  }
+  drv_info = pkt_drv_info[id][subdev_id];
+
+  /* The cache is only touched from the service context of its own ring, so
+   * only refilling it has to go through the pool gate. */
+  if (drv_info->rx_pkt_cache_cnt[cos] == 0) {
+    cnt = pkt_mgr_pkt_get_n(
+        id, subdev_id, drv_info->rx_pkt_cache[cos], PKT_MGR_RX_PKT_CACHE_SZ);
+    if (cnt <= 0) {
+      return -1;
+    }
+    drv_info->rx_pkt_cache_cnt[cos] = cnt;
+  }
+  if (bf_sys_dma_get_phy_addr_from_pool(hndl, buf, &phys_addr)) {
+    return -1;
+  }
+  *pkt = drv_info->rx_pkt_cache[cos][--drv_info->rx_pkt_cache_cnt[cos]];
+  pkt_mgr_pkt_attach_buf(*pkt,
+                         id,
+                         subdev_id,
+                         size,
+                         BF_DMA_CPU_PKT_RECEIVE_0 + cos,
+                         buf,
+                         phys_addr,
+                         hndl);
+  return 0;
+}
+
+void pkt_mgr_rx_pkt_cache_drain(bf_dev_id_t id, bf_subdev_id_t subdev_id) {
+  pkt_drv_info_t *drv_info;
+  int i;
+
+  if (id >= PKT_MGR_NUM_DEVICES || subdev_id >= PKT_MGR_NUM_SUBDEVICES) {
+    return;
+  }
+  drv_info = pkt_drv_info[id][subdev_id];
+  if (!drv_info) {
+    return;
+  }
+  for (i = 0; i < BF_PKT_RX_RING_MAX; i++) {
+    if (drv_info->rx_pkt_cache_cnt[i] == 0) {
+      continue;
+    }
+    if (pkt_mgr_pkt_put_n(id,
+                          subdev_id,
+                          drv_info->rx_pkt_cache[i],
+                          drv_info->rx_pkt_cache_cnt[i]) != 0) {
+      LOG_ERROR("%s:%d error returning cached pkts of dev %d subdev %d ring %d",
+                __func__,
+                __LINE__,
+                id,
+                subdev_id,
+                i);
+    }
+    drv_info->rx_pkt_cache_cnt[i] = 0;
+  }
+}
+
 int bf_pkt_alloc(bf_dev_id_t id, bf_pkt **pkt, size_t size, bf_dma_type_t dr) {
   void *dma_pool;
   void *vaddr;
@@ -381,6 +530,171 @@ int bf_pkt_free(bf_dev_id_t id, bf_pkt *pkt) {
   return err;
 }
 
+/* Number of RX buffers returned to a free memory DR per batched push */
+#define PKT_MGR_FREE_BURST_CHUNK 64
+
+/* RX buffers of one ring waiting to be pushed back to its free memory DR */
+typedef struct pkt_mgr_fm_batch_s {
+  bf_dev_id_t id;
+  bf_subdev_id_t subdev_id;
+  bf_dma_type_t dr;
+  void *dma_pool;
+  size_t buf_size;
+  int n;
+  uint8_t *bufs[PKT_MGR_FREE_BURST_CHUNK];
+  bf_dma_addr_t addrs[PKT_MGR_FREE_BURST_CHUNK];
+} pkt_mgr_fm_batch_t;
+
+static int pkt_mgr_fm_batch_push(pkt_mgr_fm_batch_t *fm) {
+  int fm_dr = lld_dr_fm_pkt_0 + fm->dr - BF_DMA_CPU_PKT_RECEIVE_0;
+  int pushed = 0;
+  int push_cnt = 0;
+  int ret = LLD_OK;
+  int i;
+
+  while (pushed < fm->n) {
+    ret = lld_subdev_push_fm_n(fm->id,
+                               fm->subdev_id,
+                               fm_dr,
+                               fm->n - pushed,
+                               &fm->addrs[pushed],
+                               fm->buf_size);
+    if (ret > 0) {
+      pushed += ret;
+    } else if (ret != LLD_ERR_DR_FULL || ++push_cnt >= 1000) {
+      break;
+    }
+  }
+  if (pushed < fm->n) {
+    LOG_ERROR(
+        "Return pkt FM error %d dev %d subdev %d rx_ring %d, %d of %d buffers "
+        "not returned\n",
+        ret,
+        fm->id,
+        fm->subdev_id,
+        fm->dr - BF_DMA_CPU_PKT_RECEIVE_0,
+        fm->n - pushed,
+        fm->n);
+    for (i = pushed; i < fm->n; i++) {
+      if (bf_sys_dma_unmap(
+              fm->dma_pool, fm->bufs[i], fm->buf_size, BF_DMA_TO_CPU) != 0) {
+        LOG_ERROR("Unable to unmap DMA buffer %p at %s:%d",
+                  fm->bufs[i],
+                  __func__,
+                  __LINE__);
+      }
+    }
+  }
+  ret = pushed < fm->n ? -1 : 0;
+  fm->n = 0;
+  return ret;
+}
+
+int bf_pkt_free_burst(bf_dev_id_t id, bf_pkt **pkts, int n_pkts) {
+  pkt_mgr_fm_batch_t fm;
+  bf_pkt *descs[PKT_MGR_FREE_BURST_CHUNK];
+  bf_subdev_id_t desc_subdev = 0;
+  int n_descs = 0;
+  uint32_t fm_used[PKT_MGR_NUM_SUBDEVICES] = {0};
+  bf_subdev_id_t subdev_id;
+  bf_dma_type_t dr;
+  bf_dma_addr_t dma_addr;
+  bf_pkt *pkt, *next;
+  void *dma_pool;
+  int err = 0;
+  int i;
+
+  if (id >= PKT_MGR_NUM_DEVICES || !pkts || n_pkts < 0) {
+    return -1;
+  }
+  fm.n = 0;
+
+  for (i = 0; i < n_pkts; i++) {
+    pkt = pkts[i];
+    if (!pkt) {
+      err = -1;
+      continue;
+    }
+    dr = bf_pkt_get_pkt_dr(pkt);
+    subdev_id = bf_pkt_get_pkt_subdev(pkt);
+    if (dr < BF_DMA_CPU_PKT_RECEIVE_0 || dr > BF_DMA_CPU_PKT_RECEIVE_7 ||
+        subdev_id >= PKT_MGR_NUM_SUBDEVICES) {
+      /* TX packets own their buffers, take the regular path */
+      if (bf_pkt_free(id, pkt) != 0) {
+        err = -1;
+      }
+      continue;
+    }
+    dma_pool =
+        bf_dma_get_buf_pool_hndl(pkt_mgr_get_dma_info(id, subdev_id), dr);
+    if (!dma_pool) {
+      LOG_ERROR("bad dma pool for chip %d subdev %d dr %d", id, subdev_id, dr);
+      err = -1;
+      continue;
+    }
+    if (fm.n && (fm.subdev_id != subdev_id || fm.dr != dr)) {
+      err |= pkt_mgr_fm_batch_push(&fm);
+    }
+    if (fm.n == 0) {
+      fm.id = id;
+      fm.subdev_id = subdev_id;
+      fm.dr = dr;
+      fm.dma_pool = dma_pool;
+      fm.buf_size =
+          bf_dma_get_buf_size(pkt_mgr_get_dma_info(id, subdev_id), dr);
+    }
+    for (; pkt; pkt = next) {
+      next = bf_pkt_get_nextseg(pkt);
+      /* Map the buffer again before it is pushed back into the free memory
+         DR */
+      if (bf_sys_dma_map(dma_pool,
+                         bf_pkt_get_pkt_data(pkt),
+                         bf_pkt_get_phys_pkt_data(pkt),
+                         fm.buf_size,
+                         &dma_addr,
+                         BF_DMA_TO_CPU) != 0) {
+        LOG_ERROR("Unable to map DMA buffer %p at %s:%d",
+                  bf_pkt_get_pkt_data(pkt),
+                  __func__,
+                  __LINE__);
+        err = -1;
+      } else {
+        fm.bufs[fm.n] = bf_pkt_get_pkt_data(pkt);
+        fm.addrs[fm.n++] = dma_addr;
+        fm_used[subdev_id] |= 1u << (dr - BF_DMA_CPU_PKT_RECEIVE_0);
+        if (fm.n == PKT_MGR_FREE_BURST_CHUNK) {
+          err |= pkt_mgr_fm_batch_push(&fm);
+        }
+      }
+      if (n_descs == PKT_MGR_FREE_BURST_CHUNK ||
+          (n_descs && desc_subdev != subdev_id)) {
+        err |= pkt_mgr_pkt_put_n(id, desc_subdev, descs, n_descs);
+        n_descs = 0;
+      }
+      desc_subdev = subdev_id;
+      descs[n_descs++] = pkt;
+    }
+  }
+  if (fm.n) {
+    err |= pkt_mgr_fm_batch_push(&fm);
+  }
+  if (n_descs) {
+    err |= pkt_mgr_pkt_put_n(id, desc_subdev, descs, n_descs);
+  }
+  for (subdev_id = 0; subdev_id < PKT_MGR_NUM_SUBDEVICES; subdev_id++) {
+    for (i = 0; i < BF_PKT_RX_RING_MAX; i++) {
+      if (!(fm_used[subdev_id] & (1u << i))) {
+        continue;
+      }
+      if (lld_dr_start(id, subdev_id, lld_dr_fm_pkt_0 + i) != LLD_OK) {
+        LOG_ERROR("error rx_ring %d lld_dr_start\n", i);
+        err = -1;
+      }
+    }
+  }
+  return err;
+}
+
 int pkt_mgr_free_dev_pkts(bf_dev_id_t id) {
   int i = 0;
   bf_dma_type_t dr;
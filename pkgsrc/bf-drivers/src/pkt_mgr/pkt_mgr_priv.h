@@ -31,6 +31,7 @@
 extern "C" {
 #endif
 
+#include <time.h>
 #include <lld/lld_err.h>
 #include <lld/lld_sku.h>
 
@@ -89,6 +90,14 @@ typedef struct bf_pkt_mgr_rx_stat_s {
   uint64_t pkt_free_err;
   uint64_t pkt_assembly_err;
   uint64_t pkt_no_hndl_err;
+  uint64_t pkt_bytes;
+  uint64_t burst_cnt;   /* callbacks delivering more than one packet */
+  uint64_t cb_cnt;      /* callback invocations */
+  uint64_t cb_ns_total; /* time spent in the registered callback */
+  uint64_t cb_ns_max;
+  uint64_t pps;          /* packets per second over the last window */
+  uint64_t win_start_ns; /* start of the current rate window */
+  uint64_t win_pkts;     /* packets seen in the current rate window */
 } bf_pkt_mgr_rx_stat_t;
 
 /* TX packet stats */
@@ -100,10 +109,51 @@ typedef struct bf_pkt_mgr_tx_stat_s {
   uint64_t pkt_compl_type_err;
   uint64_t pkt_compl_assembly_err;
   uint64_t pkt_no_hndl_err;
+  uint64_t push_cnt;      /* bf_pkt_tx/bf_pkt_tx_burst calls */
+  uint64_t push_ns_total; /* time spent pushing onto the TX DR */
+  uint64_t push_ns_max;
+  uint64_t pps;          /* packets per second over the last window */
+  uint64_t win_start_ns; /* start of the current rate window */
+  uint64_t win_pkts;     /* packets seen in the current rate window */
 } bf_pkt_mgr_tx_stat_t;
 
+/* Length of the window over which the per-ring pps counters are computed */
+#define PKT_MGR_RATE_WINDOW_NS 1000000000ULL
+
+static inline uint64_t pkt_mgr_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Account n packets against a rate window, publishing the packet rate of the
+ * window once it has run for PKT_MGR_RATE_WINDOW_NS. */
+static inline void pkt_mgr_rate_update(uint64_t now,
+                                       uint64_t n,
+                                       uint64_t *win_start_ns,
+                                       uint64_t *win_pkts,
+                                       uint64_t *pps) {
+  uint64_t elapsed;
+
+  *win_pkts += n;
+  if (*win_start_ns == 0) {
+    *win_start_ns = now;
+    return;
+  }
+  elapsed = now - *win_start_ns;
+  if (elapsed >= PKT_MGR_RATE_WINDOW_NS) {
+    *pps = *win_pkts * 1000000000ULL / elapsed;
+    *win_start_ns = now;
+    *win_pkts = 0;
+  }
+}
+
 #define PKT_MGR_OP_SUBDEV 0 /* operational sub device index for TOFINO3 */
 
+/* Number of bf_pkt descriptors an RX ring takes from the global packet pool
+ * in one go, so the RX path does not contend on the pool per packet. */
+#define PKT_MGR_RX_PKT_CACHE_SZ 32
+
 /*!
  * structure for pkt driver's rx ring
  */
@@ -134,6 +184,16 @@ typedef struct {
   bool en_cpu_pkt; /* flag to mark cpu pkt path as up or down */
   bf_pkt_rx_callback rx_cb_fn[BF_PKT_RX_RING_MAX];
   void *rx_cookie[BF_PKT_RX_RING_MAX];
+  /* burst delivery, used instead of rx_cb_fn when registered */
+  bf_pkt_rx_burst_callback rx_burst_cb_fn[BF_PKT_RX_RING_MAX];
+  int rx_burst_max[BF_PKT_RX_RING_MAX];
+  int rx_burst_cnt[BF_PKT_RX_RING_MAX];
+  bf_pkt *rx_burst[BF_PKT_RX_RING_MAX][BF_PKT_RX_BURST_MAX];
+  /* burst handler calls in progress, they run without the ring_mtx */
+  int rx_burst_busy[BF_PKT_RX_RING_MAX];
+  /* descriptors pre-allocated for the RX path of each ring */
+  int rx_pkt_cache_cnt[BF_PKT_RX_RING_MAX];
+  bf_pkt *rx_pkt_cache[BF_PKT_RX_RING_MAX][PKT_MGR_RX_PKT_CACHE_SZ];
   bf_pkt_tx_done_notif_cb tx_nt_fn[BF_PKT_TX_RING_MAX];
   void *tx_cookie[BF_PKT_TX_RING_MAX];
   bf_pkt_ctx_t rx_pkt_ctx[BF_PKT_RX_RING_MAX];
@@ -293,6 +353,160 @@ int bf_pkt_alloc_ext_buf(bf_dev_id_t id,
  */
 int bf_pkt_free_ext_buf(bf_dev_id_t id, bf_subdev_id_t subdev_id, bf_pkt *pkt);
 
+/**
+ * take up to n free packets from the packet pool in one go
+ *
+ * @param id
+ *   chip id
+ *  @param subdev_id
+ *   subdevice id within the chip
+ * @param pkts
+ *   array receiving the packets
+ * @param n
+ *   number of packets wanted
+ * @return
+ *   number of packets taken, -1 on bad parameters
+ */
+int pkt_mgr_pkt_get_n(bf_dev_id_t id,
+                      bf_subdev_id_t subdev_id,
+                      bf_pkt **pkts,
+                      int n);
+
+/**
+ * return n packets without buffers to the packet pool in one go
+ *
+ * @param id
+ *   chip id
+ *  @param subdev_id
+ *   subdevice id within the chip
+ * @param pkts
+ *   packets to return
+ * @param n
+ *   number of packets
+ * @return
+ *   0 on success, -1 on failure
+ */
+int pkt_mgr_pkt_put_n(bf_dev_id_t id,
+                      bf_subdev_id_t subdev_id,
+                      bf_pkt **pkts,
+                      int n);
+
+/**
+ * attach an RX buffer to a packet taken from the ring's descriptor cache
+ *
+ * @param id
+ *   chip id
+ *  @param subdev_id
+ *   subdevice id within the chip
+ * @param cos
+ *   rx ring index within the subdevice
+ * @param pkt
+ *   bf packet pointer
+ * @param size
+ *   received data size
+ * @param buf
+ *   buffer to be attached to the packet
+ * @param hndl
+ *   handle of the dma memory pool
+ * @return
+ *   0 on success, -1 on failure
+ */
+int pkt_mgr_rx_pkt_alloc(bf_dev_id_t id,
+                         bf_subdev_id_t subdev_id,
+                         int cos,
+                         bf_pkt **pkt,
+                         size_t size,
+                         uint8_t *buf,
+                         bf_sys_dma_pool_handle_t hndl);
+
+/**
+ * return the descriptors cached by the RX rings to the packet pool
+ *
+ * @param id
+ *   chip id
+ *  @param subdev_id
+ *   subdevice id within the chip
+ * @return
+ *   none
+ */
+void pkt_mgr_rx_pkt_cache_drain(bf_dev_id_t id, bf_subdev_id_t subdev_id);
+
+/**
+ * deliver the packets accumulated for a burst RX callback
+ *
+ * @param chip
+ *   chip id
+ *  @param subdev_id
+ *   subdevice id within the chip
+ * @param cos
+ *   rx ring index within the subdevice
+ * @return
+ *   none
+ */
+void pkt_mgr_rx_burst_flush(bf_dev_id_t chip,
+                            bf_subdev_id_t subdev_id,
+                            int cos);
+
+/* Counters of a shared memory export */
+typedef struct pkt_mgr_shm_stat_s {
+  uint64_t rx_pkts;     /* packets published on the rx ring */
+  uint64_t rx_no_frame; /* packets dropped, no frame on the fill ring */
+  uint64_t rx_too_long; /* packets dropped, larger than a frame */
+  uint64_t tx_pkts;     /* frames pushed onto the TX DR */
+  uint64_t tx_compl;    /* frames completed back on the comp ring */
+  uint64_t tx_no_buf;   /* service passes stalled on TX buffers */
+  uint64_t bad_desc;    /* malformed descriptors from the application */
+  uint64_t tx_inflight; /* frames currently owned by the TX DR */
+} pkt_mgr_shm_stat_t;
+
+/**
+ * move frames posted on the tx ring of a shared memory export onto the TX
+ * DR and publish collected TX completions
+ *
+ * @param dev_id
+ *   chip id
+ * @return
+ *   none
+ */
+void pkt_mgr_shm_service(bf_dev_id_t dev_id);
+
+/**
+ * initialize the shared memory export state of all devices
+ *
+ * @return
+ *   none
+ */
+void pkt_mgr_shm_init(void);
+
+/**
+ * drop the shared memory export of a device that is being removed
+ *
+ * @param dev_id
+ *   chip id
+ * @return
+ *   none
+ */
+void pkt_mgr_shm_cleanup(bf_dev_id_t dev_id);
+
+/**
+ * get the counters of the shared memory export of a device
+ *
+ * @param dev_id
+ *   chip id
+ * @param path
+ *   returns the path of the export
+ * @param path_len
+ *   size of the path buffer
+ * @param stat
+ *   returns the counters
+ * @return
+ *   Status of the call
+ */
+bf_status_t pkt_mgr_shm_stat_get(bf_dev_id_t dev_id,
+                                 char *path,
+                                 size_t path_len,
+                                 pkt_mgr_shm_stat_t *stat);
+
 #ifdef __cplusplus
 }
 #endif /* C++ */
@@ -0,0 +1,549 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*!
+ * @file pkt_mgr_shm.c
+ * @date
+ *
+ * Export of an RX/TX ring pair to other processes through shared memory.
+ *
+ * RX packets of the exported ring are delivered by a burst callback which
+ * copies them into frames taken from the fill ring and publishes them on the
+ * rx ring once per burst. Frames posted on the tx ring are picked up from
+ * bf_dma_service_pkt, copied into DMA buffers and sent as one TX burst; their
+ * completions are collected and published on the comp ring once per service
+ * pass. The DMA buffer pools live in hugepages private to this process, so
+ * each direction takes a single copy between a DMA buffer and a frame;
+ * nothing is copied on the application side or through the kernel.
+ */
+
+/* Module header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <bf_types/bf_types.h>
+#include <dvm/bf_drv_intf.h>
+#include <target-sys/bf_sal/bf_sys_intf.h>
+#include <lld/bf_dma_if.h>
+#include <pkt_mgr/bf_pkt.h>
+#include <pkt_mgr/bf_pkt_shm.h>
+#include <pkt_mgr/pkt_mgr_intf.h>
+#include "pkt_mgr_priv.h"
+#include "pkt_mgr_log.h"
+
+/* Number of tx ring descriptors turned into one TX burst */
+#define PKT_MGR_SHM_TX_BATCH 32
+
+typedef struct pkt_mgr_shm_s {
+  bf_dev_id_t dev_id;
+  bf_pkt_rx_ring_t rx_ring;
+  bf_pkt_tx_ring_t tx_ring;
+  char path[128];
+  bf_pkt_shm_hdr_t *hdr;
+  size_t size;
+  /* private copies of the layout, the shared header is not trusted */
+  uint32_t n_frames;
+  uint32_t frame_size;
+  uint32_t mask;
+  bf_pkt_shm_desc_t *rx_desc;
+  bf_pkt_shm_desc_t *fill_desc;
+  bf_pkt_shm_desc_t *tx_desc;
+  bf_pkt_shm_desc_t *comp_desc;
+  uint8_t *frames;
+  /* packet holding the data of each frame while it is being transmitted */
+  bf_pkt **tx_inflight;
+  uint32_t n_inflight;
+  /* completions written to the comp ring but not yet published */
+  uint32_t comp_pending;
+  pkt_mgr_shm_stat_t stat;
+} pkt_mgr_shm_t;
+
+static pkt_mgr_shm_t *pkt_mgr_shm[PKT_MGR_NUM_DEVICES];
+/* Serializes the DMA service context (RX burst callback, TX completions and
+ * the tx ring service) against export and unexport of a device. An export is
+ * only ever used with its device lock held and after checking it is still
+ * the one installed in pkt_mgr_shm, so it can be freed once it has been
+ * unlinked under the lock. */
+static bf_sys_mutex_t pkt_mgr_shm_mtx[PKT_MGR_NUM_DEVICES];
+
+static uint32_t pkt_mgr_shm_align(uint64_t v, uint64_t a) {
+  return (uint32_t)((v + a - 1) & ~(a - 1));
+}
+
+static bf_status_t pkt_mgr_shm_rx(bf_dev_id_t dev_id,
+                                  bf_pkt **pkts,
+                                  int n_pkts,
+                                  void *cookie,
+                                  bf_pkt_rx_ring_t rx_ring) {
+  pkt_mgr_shm_t *shm;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *desc;
+  uint32_t n_fill, n_rx, fill_used = 0, rx_used = 0;
+  uint32_t frame, len, seg_len;
+  uint8_t *data;
+  bf_pkt *seg;
+  int i;
+
+  (void)rx_ring;
+
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  if (shm != cookie) {
+    /* the export is being torn down */
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    if (bf_pkt_free_burst(dev_id, pkts, n_pkts) != 0) {
+      LOG_ERROR(
+          "%s:%d Error while trying to free the pkts", __func__, __LINE__);
+    }
+    return BF_SUCCESS;
+  }
+  hdr = shm->hdr;
+
+  n_fill = bf_pkt_shm_cons_peek(&hdr->fill, hdr->fill.size);
+  n_rx = bf_pkt_shm_prod_reserve(&hdr->rx, n_pkts);
+  for (i = 0; i < n_pkts; i++) {
+    len = 0;
+    for (seg = pkts[i]; seg; seg = bf_pkt_get_nextseg(seg)) {
+      len += bf_pkt_get_pkt_size(seg);
+    }
+    if (len > shm->frame_size) {
+      shm->stat.rx_too_long++;
+      continue;
+    }
+    /* skip over fill entries naming frames that do not exist */
+    frame = shm->n_frames;
+    while (rx_used < n_rx && fill_used < n_fill && frame >= shm->n_frames) {
+      desc = &shm->fill_desc[(hdr->fill.cons + fill_used++) & shm->mask];
+      frame = __atomic_load_n(&desc->frame, __ATOMIC_RELAXED);
+      if (frame >= shm->n_frames) {
+        shm->stat.bad_desc++;
+      }
+    }
+    if (frame >= shm->n_frames) {
+      shm->stat.rx_no_frame++;
+      continue;
+    }
+    data = shm->frames + (uint64_t)frame * shm->frame_size;
+    for (seg = pkts[i]; seg; seg = bf_pkt_get_nextseg(seg)) {
+      seg_len = bf_pkt_get_pkt_size(seg);
+      memcpy(data, bf_pkt_get_pkt_data(seg), seg_len);
+      data += seg_len;
+    }
+    desc = &shm->rx_desc[(hdr->rx.prod + rx_used++) & shm->mask];
+    desc->frame = frame;
+    desc->len = len;
+    desc->flags = 0;
+    shm->stat.rx_pkts++;
+  }
+  /* one index update per ring for the whole burst */
+  if (fill_used) {
+    bf_pkt_shm_cons_release(&hdr->fill, fill_used);
+  }
+  if (rx_used) {
+    bf_pkt_shm_prod_submit(&hdr->rx, rx_used);
+  }
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+  if (bf_pkt_free_burst(dev_id, pkts, n_pkts) != 0) {
+    LOG_ERROR("%s:%d Error while trying to free the pkts", __func__, __LINE__);
+  }
+  return BF_SUCCESS;
+}
+
+static bf_status_t pkt_mgr_shm_tx_done(bf_dev_id_t dev_id,
+                                       bf_pkt_tx_ring_t tx_ring,
+                                       uint64_t tx_cookie,
+                                       uint32_t status) {
+  pkt_mgr_shm_t *shm;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *desc;
+  uint32_t frame = (uint32_t)tx_cookie;
+  bf_pkt *pkt;
+
+  (void)tx_ring;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return BF_INVALID_ARG;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  if (!shm || frame >= shm->n_frames || !shm->tx_inflight[frame]) {
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    LOG_ERROR(
+        "%s: stale tx completion dev %d frame %u", __func__, dev_id, frame);
+    return BF_INVALID_ARG;
+  }
+  hdr = shm->hdr;
+  pkt = shm->tx_inflight[frame];
+  shm->tx_inflight[frame] = NULL;
+  shm->n_inflight--;
+  if (bf_pkt_free(dev_id, pkt) != 0) {
+    LOG_ERROR("%s:%d Error while trying to free the pkt", __func__, __LINE__);
+  }
+
+  /* the comp ring has room for every frame so this never overflows */
+  desc = &shm->comp_desc[(hdr->comp.prod + shm->comp_pending) & shm->mask];
+  desc->frame = frame;
+  desc->len = 0;
+  desc->flags = status ? BF_PKT_SHM_F_ERR : 0;
+  shm->comp_pending++;
+  shm->stat.tx_compl++;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+  return BF_SUCCESS;
+}
+
+/* Hand a frame straight back to the application without sending it */
+static void pkt_mgr_shm_tx_reject(pkt_mgr_shm_t *shm, uint32_t frame) {
+  bf_pkt_shm_hdr_t *hdr = shm->hdr;
+  bf_pkt_shm_desc_t *desc;
+
+  desc = &shm->comp_desc[(hdr->comp.prod + shm->comp_pending) & shm->mask];
+  desc->frame = frame;
+  desc->len = 0;
+  desc->flags = BF_PKT_SHM_F_ERR;
+  shm->comp_pending++;
+}
+
+void pkt_mgr_shm_service(bf_dev_id_t dev_id) {
+  pkt_mgr_shm_t *shm;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *desc;
+  bf_pkt *pkts[PKT_MGR_SHM_TX_BATCH];
+  void *cookies[PKT_MGR_SHM_TX_BATCH];
+  uint32_t n, i, consumed, frame, len;
+  int n_pkts = 0, n_sent = 0, k;
+  bf_pkt *pkt;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  if (!shm) {
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    return;
+  }
+  hdr = shm->hdr;
+
+  n = bf_pkt_shm_cons_peek(&hdr->tx, PKT_MGR_SHM_TX_BATCH);
+  for (i = 0; i < n; i++) {
+    desc = &shm->tx_desc[(hdr->tx.cons + i) & shm->mask];
+    /* The application can rewrite the descriptor at any time, take one
+     * snapshot of it and only ever use that. */
+    frame = __atomic_load_n(&desc->frame, __ATOMIC_RELAXED);
+    len = __atomic_load_n(&desc->len, __ATOMIC_RELAXED);
+    if (frame >= shm->n_frames) {
+      /* nothing to hand back for a frame that does not exist */
+      shm->stat.bad_desc++;
+      continue;
+    }
+    if (shm->tx_inflight[frame]) {
+      /* the frame is already owned by an earlier descriptor */
+      shm->stat.bad_desc++;
+      continue;
+    }
+    if (len == 0 || len > shm->frame_size) {
+      shm->stat.bad_desc++;
+      pkt_mgr_shm_tx_reject(shm, frame);
+      continue;
+    }
+    if (bf_pkt_alloc(dev_id,
+                     &pkt,
+                     len,
+                     BF_DMA_CPU_PKT_TRANSMIT_0 + shm->tx_ring) != 0) {
+      /* out of TX buffers, retry from this descriptor on the next pass */
+      shm->stat.tx_no_buf++;
+      break;
+    }
+    if (bf_pkt_data_copy(
+            pkt, shm->frames + (uint64_t)frame * shm->frame_size, len) != 0) {
+      bf_pkt_free(dev_id, pkt);
+      shm->stat.bad_desc++;
+      pkt_mgr_shm_tx_reject(shm, frame);
+      continue;
+    }
+    shm->tx_inflight[frame] = pkt;
+    shm->n_inflight++;
+    pkts[n_pkts] = pkt;
+    cookies[n_pkts] = (void *)(uintptr_t)frame;
+    n_pkts++;
+  }
+  consumed = i;
+
+  if (n_pkts) {
+    bf_pkt_tx_burst(dev_id, pkts, cookies, n_pkts, shm->tx_ring, &n_sent);
+    shm->stat.tx_pkts += n_sent;
+    /* frames that did not make it onto the DR go back as failed */
+    for (k = n_sent; k < n_pkts; k++) {
+      shm->tx_inflight[(uint32_t)(uintptr_t)cookies[k]] = NULL;
+      shm->n_inflight--;
+      bf_pkt_free(dev_id, pkts[k]);
+      pkt_mgr_shm_tx_reject(shm, (uint32_t)(uintptr_t)cookies[k]);
+    }
+  }
+  if (consumed) {
+    bf_pkt_shm_cons_release(&hdr->tx, consumed);
+  }
+  if (shm->comp_pending) {
+    bf_pkt_shm_prod_submit(&hdr->comp, shm->comp_pending);
+    shm->comp_pending = 0;
+  }
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+}
+
+/* Detach the export of a device from the service context. Once this returns
+ * the service context no longer touches it and it can be freed. */
+static void pkt_mgr_shm_unlink(bf_dev_id_t dev_id) {
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  pkt_mgr_shm[dev_id] = NULL;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+}
+
+static void pkt_mgr_shm_free(pkt_mgr_shm_t *shm) {
+  if (shm->hdr) {
+    munmap(shm->hdr, shm->size);
+  }
+  unlink(shm->path);
+  if (shm->tx_inflight) {
+    bf_sys_free(shm->tx_inflight);
+  }
+  bf_sys_free(shm);
+}
+
+bf_status_t bf_pkt_shm_export(bf_dev_id_t dev_id,
+                              bf_pkt_rx_ring_t rx_ring,
+                              bf_pkt_tx_ring_t tx_ring,
+                              uint32_t n_frames,
+                              uint32_t frame_size,
+                              const char *path) {
+  pkt_mgr_shm_t *shm;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *desc;
+  uint32_t off, ring_bytes, i;
+  uint64_t size;
+  bf_status_t sts;
+  void *p;
+  int fd;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return BF_INVALID_ARG;
+  }
+  if (n_frames < 2 || (n_frames & (n_frames - 1)) ||
+      frame_size < BF_PKT_SHM_CACHE_LINE || frame_size > BF_PKT_MAX_SIZE) {
+    return BF_INVALID_ARG;
+  }
+  if (!bf_pkt_is_inited(dev_id)) {
+    return BF_NOT_READY;
+  }
+  if (__atomic_load_n(&pkt_mgr_shm[dev_id], __ATOMIC_RELAXED)) {
+    return BF_ALREADY_EXISTS;
+  }
+
+  shm = bf_sys_calloc(1, sizeof(*shm));
+  if (!shm) {
+    return BF_NO_SYS_RESOURCES;
+  }
+  shm->dev_id = dev_id;
+  shm->rx_ring = rx_ring;
+  shm->tx_ring = tx_ring;
+  if (path) {
+    snprintf(shm->path, sizeof(shm->path), "%s", path);
+  } else {
+    snprintf(shm->path, sizeof(shm->path), BF_PKT_SHM_PATH_FMT, dev_id);
+  }
+  shm->tx_inflight = bf_sys_calloc(n_frames, sizeof(bf_pkt *));
+  if (!shm->tx_inflight) {
+    bf_sys_free(shm);
+    return BF_NO_SYS_RESOURCES;
+  }
+
+  /* header, the four descriptor arrays, then page aligned frames */
+  frame_size = pkt_mgr_shm_align(frame_size, BF_PKT_SHM_CACHE_LINE);
+  ring_bytes = pkt_mgr_shm_align((uint64_t)n_frames * sizeof(*desc),
+                                 BF_PKT_SHM_CACHE_LINE);
+  off = pkt_mgr_shm_align(sizeof(*hdr), BF_PKT_SHM_CACHE_LINE);
+  size = pkt_mgr_shm_align((uint64_t)off + 4 * (uint64_t)ring_bytes, 4096);
+  size += (uint64_t)n_frames * frame_size;
+
+  fd = open(shm->path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    LOG_ERROR("%s: unable to create %s: %s",
+              __func__,
+              shm->path,
+              strerror(errno));
+    sts = BF_NO_SYS_RESOURCES;
+    goto free_and_exit;
+  }
+  if (ftruncate(fd, size) != 0) {
+    LOG_ERROR(
+        "%s: unable to size %s: %s", __func__, shm->path, strerror(errno));
+    close(fd);
+    sts = BF_NO_SYS_RESOURCES;
+    goto free_and_exit;
+  }
+  p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    LOG_ERROR(
+        "%s: unable to map %s: %s", __func__, shm->path, strerror(errno));
+    sts = BF_NO_SYS_RESOURCES;
+    goto free_and_exit;
+  }
+  hdr = p;
+  shm->hdr = hdr;
+  shm->size = size;
+
+  hdr->n_frames = n_frames;
+  hdr->frame_size = frame_size;
+  hdr->region_size = size;
+  hdr->rx.size = hdr->fill.size = hdr->tx.size = hdr->comp.size = n_frames;
+  hdr->rx.desc_off = off;
+  hdr->fill.desc_off = off + ring_bytes;
+  hdr->tx.desc_off = off + 2 * ring_bytes;
+  hdr->comp.desc_off = off + 3 * ring_bytes;
+  hdr->frames_off = pkt_mgr_shm_align((uint64_t)off + 4 * ring_bytes, 4096);
+  shm->n_frames = n_frames;
+  shm->frame_size = frame_size;
+  shm->mask = n_frames - 1;
+  shm->rx_desc = (bf_pkt_shm_desc_t *)((uint8_t *)hdr + hdr->rx.desc_off);
+  shm->fill_desc = (bf_pkt_shm_desc_t *)((uint8_t *)hdr + hdr->fill.desc_off);
+  shm->tx_desc = (bf_pkt_shm_desc_t *)((uint8_t *)hdr + hdr->tx.desc_off);
+  shm->comp_desc = (bf_pkt_shm_desc_t *)((uint8_t *)hdr + hdr->comp.desc_off);
+  shm->frames = (uint8_t *)hdr + hdr->frames_off;
+
+  /* post the first half of the frames for RX */
+  for (i = 0; i < n_frames / 2; i++) {
+    desc = bf_pkt_shm_desc(hdr, &hdr->fill, i);
+    desc->frame = i;
+    desc->len = 0;
+    desc->flags = 0;
+  }
+  hdr->fill.prod = n_frames / 2;
+  hdr->version = BF_PKT_SHM_VERSION;
+  /* the magic goes last so an early attach does not see a partial header */
+  __atomic_store_n(&hdr->magic, BF_PKT_SHM_MAGIC, __ATOMIC_RELEASE);
+
+  sts = bf_pkt_tx_done_notif_register(dev_id, pkt_mgr_shm_tx_done, tx_ring);
+  if (sts != BF_SUCCESS) {
+    goto free_and_exit;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  pkt_mgr_shm[dev_id] = shm;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+  sts = bf_pkt_rx_register_burst(
+      dev_id, pkt_mgr_shm_rx, rx_ring, BF_PKT_RX_BURST_MAX, shm);
+  if (sts != BF_SUCCESS) {
+    pkt_mgr_shm_unlink(dev_id);
+    bf_pkt_tx_done_notif_deregister(dev_id, tx_ring);
+    goto free_and_exit;
+  }
+  LOG_TRACE("dev %d rx_ring %d tx_ring %d exported at %s",
+            dev_id,
+            rx_ring,
+            tx_ring,
+            shm->path);
+  return BF_SUCCESS;
+
+free_and_exit:
+  pkt_mgr_shm_free(shm);
+  return sts;
+}
+
+bf_status_t bf_pkt_shm_unexport(bf_dev_id_t dev_id) {
+  pkt_mgr_shm_t *shm;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return BF_INVALID_ARG;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  if (!shm) {
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    return BF_OBJECT_NOT_FOUND;
+  }
+  /* the DMA buffers of frames in flight are still owned by the device */
+  if (shm->n_inflight) {
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    return BF_IN_USE;
+  }
+  pkt_mgr_shm[dev_id] = NULL;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+
+  /* a callback already on its way in finds the export gone and backs off */
+  bf_pkt_rx_deregister(dev_id, shm->rx_ring);
+  bf_pkt_tx_done_notif_deregister(dev_id, shm->tx_ring);
+  pkt_mgr_shm_free(shm);
+  return BF_SUCCESS;
+}
+
+void pkt_mgr_shm_cleanup(bf_dev_id_t dev_id) {
+  pkt_mgr_shm_t *shm;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  pkt_mgr_shm[dev_id] = NULL;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+  if (!shm) {
+    return;
+  }
+  /* in flight packets are released along with all other packets of the
+   * device, only the export itself goes away here */
+  pkt_mgr_shm_free(shm);
+}
+
+void pkt_mgr_shm_init(void) {
+  int i;
+
+  for (i = 0; i < PKT_MGR_NUM_DEVICES; i++) {
+    bf_sys_mutex_init(&pkt_mgr_shm_mtx[i]);
+  }
+}
+
+bf_status_t pkt_mgr_shm_stat_get(bf_dev_id_t dev_id,
+                                 char *path,
+                                 size_t path_len,
+                                 pkt_mgr_shm_stat_t *stat) {
+  pkt_mgr_shm_t *shm;
+
+  if (dev_id < 0 || dev_id >= PKT_MGR_NUM_DEVICES) {
+    return BF_INVALID_ARG;
+  }
+  bf_sys_mutex_lock(&pkt_mgr_shm_mtx[dev_id]);
+  shm = pkt_mgr_shm[dev_id];
+  if (!shm) {
+    bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+    return BF_OBJECT_NOT_FOUND;
+  }
+  snprintf(path, path_len, "%s", shm->path);
+  *stat = shm->stat;
+  stat->tx_inflight = shm->n_inflight;
+  bf_sys_mutex_unlock(&pkt_mgr_shm_mtx[dev_id]);
+  return BF_SUCCESS;
+}
@@ -29,6 +29,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include <bf_types/bf_types.h>
@@ -149,7 +150,8 @@ bf_status_t bf_pkt_rx_register(bf_dev_id_t dev_id,
   if (!pkt_drv_info[dev_id][subdev_id]) {
     return BF_NOT_READY;
   }
-  if (pkt_drv_info[dev_id][subdev_id]->rx_cb_fn[rx_ring]) {
+  if (pkt_drv_info[dev_id][subdev_id]->rx_cb_fn[rx_ring] ||
+      pkt_drv_info[dev_id][subdev_id]->rx_burst_cb_fn[rx_ring]) {
     return BF_ALREADY_EXISTS;
   } else {
     pkt_drv_info[dev_id][subdev_id]->rx_cb_fn[rx_ring] = cb;
@@ -158,9 +160,72 @@ bf_status_t bf_pkt_rx_register(bf_dev_id_t dev_id,
   }
 }
 
+bf_status_t bf_pkt_rx_register_burst(bf_dev_id_t dev_id,
+                                     bf_pkt_rx_burst_callback cb,
+                                     bf_pkt_rx_ring_t rx_ring,
+                                     int max_burst,
+                                     void *rx_cookie) {
+  bf_subdev_id_t subdev_id = 0;
+  bf_dev_family_t dev_family = 0;
+  pkt_drv_info_t *rx_drv_info;
+
+  if ((dev_id >= PKT_MGR_NUM_DEVICES) || (dev_id < 0)) {
+    return BF_INVALID_ARG;
+  }
+  if (!cb || max_burst < 1 || max_burst > BF_PKT_RX_BURST_MAX) {
+    return BF_INVALID_ARG;
+  }
+
+  dev_family = pkt_drv_info[dev_id][0]->dev_family;
+
+  if (dev_family == BF_DEV_FAMILY_TOFINO3) {
+    if (rx_ring >= BF_PKT_RX_RING_EXT_MAX) {
+      return BF_INVALID_ARG;
+    }
+    if (rx_ring >= BF_PKT_RX_RING_MAX) {
+      if (bf_pcipkt_subdev1_is_en()) {
+        subdev_id = 1;
+        rx_ring -= BF_PKT_RX_RING_MAX;  // rebase to 0-7
+      } else {
+        return BF_INVALID_ARG;
+      }
+    }
+  } else if (rx_ring >= BF_PKT_RX_RING_MAX) {
+    return BF_INVALID_ARG;
+  }
+  rx_drv_info = pkt_drv_info[dev_id][subdev_id];
+  if (!rx_drv_info) {
+    return BF_NOT_READY;
+  }
+  if (rx_drv_info->rx_cb_fn[rx_ring] || rx_drv_info->rx_burst_cb_fn[rx_ring]) {
+    return BF_ALREADY_EXISTS;
+  }
+  bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+  rx_drv_info->rx_burst_max[rx_ring] = max_burst;
+  rx_drv_info->rx_burst_cnt[rx_ring] = 0;
+  rx_drv_info->rx_cookie[rx_ring] = rx_cookie;
+  rx_drv_info->rx_burst_cb_fn[rx_ring] = cb;
+  bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+  return BF_SUCCESS;
+}
+
+static int pkt_mgr_rx_burst_take_locked(pkt_drv_info_t *rx_drv_info,
+                                        int cos,
+                                        bf_pkt **pkts,
+                                        bf_pkt_rx_burst_callback *cb,
+                                        void **cookie);
+static void pkt_mgr_rx_burst_run(bf_dev_id_t chip,
+                                 pkt_drv_info_t *rx_drv_info,
+                                 int cos,
+                                 bf_pkt **pkts,
+                                 int n,
+                                 bf_pkt_rx_burst_callback cb,
+                                 void *cookie);
+
 bf_status_t bf_pkt_rx_deregister(bf_dev_id_t dev_id, bf_pkt_rx_ring_t rx_ring) {
   bf_subdev_id_t subdev_id = 0;
   bf_dev_family_t dev_family = 0;
+  pkt_drv_info_t *rx_drv_info;
 
   if ((dev_id >= PKT_MGR_NUM_DEVICES) || (dev_id < 0)) {
     return BF_INVALID_ARG;
@@ -182,6 +247,34 @@ bf_status_t bf_pkt_rx_deregister(bf_dev_id_t dev_id, bf_pkt_rx_ring_t rx_ring) {
   if (!pkt_drv_info[dev_id][subdev_id]) {
     return BF_NOT_READY;
   }
+  rx_drv_info = pkt_drv_info[dev_id][subdev_id];
+  bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+  /* let a handler call still running on the DMA service context return, none
+   * may be running once the handler is deregistered */
+  while (rx_drv_info->rx_burst_cb_fn[rx_ring] &&
+         rx_drv_info->rx_burst_busy[rx_ring]) {
+    bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+    bf_sys_usleep(100);
+    bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+  }
+  if (rx_drv_info->rx_burst_cb_fn[rx_ring]) {
+    bf_pkt *pkts[BF_PKT_RX_BURST_MAX];
+    bf_pkt_rx_burst_callback cb;
+    void *cookie;
+    int n;
+
+    /* hand over whatever is still pending before the handler goes away, the
+     * ring lock keeps the DMA service context from adding to the burst */
+    n = pkt_mgr_rx_burst_take_locked(rx_drv_info, rx_ring, pkts, &cb, &cookie);
+    rx_drv_info->rx_burst_cb_fn[rx_ring] = NULL;
+    rx_drv_info->rx_cookie[rx_ring] = NULL;
+    bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
+    if (n) {
+      pkt_mgr_rx_burst_run(dev_id, rx_drv_info, rx_ring, pkts, n, cb, cookie);
+    }
+    return BF_SUCCESS;
+  }
+  bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[rx_ring].ring_mtx);
   if (!pkt_drv_info[dev_id][subdev_id]->rx_cb_fn[rx_ring]) {
     return BF_INVALID_ARG;
   } else {
@@ -191,6 +284,150 @@ bf_status_t bf_pkt_rx_deregister(bf_dev_id_t dev_id, bf_pkt_rx_ring_t rx_ring) {
   }
 }
 
+static void pkt_mgr_rx_cb_stat_update(bf_pkt_mgr_rx_stat_t *rx_stat,
+                                      uint64_t start,
+                                      uint64_t end,
+                                      int n_pkts) {
+  uint64_t dt = end - start;
+
+  rx_stat->cb_cnt++;
+  rx_stat->cb_ns_total += dt;
+  if (dt > rx_stat->cb_ns_max) {
+    rx_stat->cb_ns_max = dt;
+  }
+  if (n_pkts > 1) {
+    rx_stat->burst_cnt++;
+  }
+  pkt_mgr_rate_update(end,
+                      n_pkts,
+                      &rx_stat->win_start_ns,
+                      &rx_stat->win_pkts,
+                      &rx_stat->pps);
+}
+
+/* Move the pending burst of a ring to pkts along with the handler to call,
+ * the caller holds the ring_mtx of the ring.  Returns the number of packets
+ * taken; when non-zero the caller must pass them to pkt_mgr_rx_burst_run
+ * after dropping the lock */
+static int pkt_mgr_rx_burst_take_locked(pkt_drv_info_t *rx_drv_info,
+                                        int cos,
+                                        bf_pkt **pkts,
+                                        bf_pkt_rx_burst_callback *cb,
+                                        void **cookie) {
+  int n;
+
+  n = rx_drv_info->rx_burst_cnt[cos];
+  if (n == 0) {
+    return 0;
+  }
+  rx_drv_info->rx_burst_cnt[cos] = 0;
+  memcpy(pkts, rx_drv_info->rx_burst[cos], n * sizeof(bf_pkt *));
+  *cb = rx_drv_info->rx_burst_cb_fn[cos];
+  *cookie = rx_drv_info->rx_cookie[cos];
+  rx_drv_info->rx_burst_busy[cos]++;
+  return n;
+}
+
+/* Hand a burst taken by pkt_mgr_rx_burst_take_locked to its handler.  Called
+ * without the ring_mtx so the handler may block or transmit without holding
+ * up the ring */
+static void pkt_mgr_rx_burst_run(bf_dev_id_t chip,
+                                 pkt_drv_info_t *rx_drv_info,
+                                 int cos,
+                                 bf_pkt **pkts,
+                                 int n,
+                                 bf_pkt_rx_burst_callback cb,
+                                 void *cookie) {
+  bf_pkt_rx_ring_t rx_ring;
+  uint64_t start = 0, end = 0;
+
+  rx_ring = rx_drv_info->subdev_id > 0 ? cos + BF_PKT_RX_RING_MAX : cos;
+  if (cb) {
+    start = pkt_mgr_now_ns();
+    cb(chip, pkts, n, cookie, rx_ring);
+    end = pkt_mgr_now_ns();
+  } else if (bf_pkt_free_burst(chip, pkts, n) != 0) {
+    LOG_ERROR("%s:%d Error while trying to free the pkts", __func__, __LINE__);
+  }
+
+  bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+  if (cb) {
+    pkt_mgr_rx_cb_stat_update(&rx_drv_info->rx_stat[cos], start, end, n);
+  } else {
+    rx_drv_info->rx_stat[cos].pkt_no_hndl_err += n;
+  }
+  rx_drv_info->rx_burst_busy[cos]--;
+  bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+}
+
+void pkt_mgr_rx_burst_flush(bf_dev_id_t chip,
+                            bf_subdev_id_t subdev_id,
+                            int cos) {
+  pkt_drv_info_t *rx_drv_info;
+  bf_pkt *pkts[BF_PKT_RX_BURST_MAX];
+  bf_pkt_rx_burst_callback cb;
+  void *cookie;
+  int n;
+
+  if (chip >= PKT_MGR_NUM_DEVICES || subdev_id >= PKT_MGR_NUM_SUBDEVICES) {
+    return;
+  }
+  rx_drv_info = pkt_drv_info[chip][subdev_id];
+  if (!rx_drv_info || cos < 0 || cos >= BF_PKT_RX_RING_MAX) {
+    return;
+  }
+  /* cheap check, a burst is only ever started by the calling context */
+  if (rx_drv_info->rx_burst_cnt[cos] == 0) {
+    return;
+  }
+  bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+  n = pkt_mgr_rx_burst_take_locked(rx_drv_info, cos, pkts, &cb, &cookie);
+  bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+  if (n) {
+    pkt_mgr_rx_burst_run(chip, rx_drv_info, cos, pkts, n, cb, cookie);
+  }
+}
+
+/* Hand a fully assembled packet to the handler registered for the ring.
+ * Returns -1 if there is none and the packet is still owned by the caller. */
+static int pkt_mgr_rx_deliver(bf_dev_id_t chip,
+                              pkt_drv_info_t *rx_drv_info,
+                              int cos,
+                              bf_pkt_rx_ring_t rx_ring,
+                              bf_pkt *pkt) {
+  uint64_t start;
+
+  if (rx_drv_info->rx_burst_cb_fn[cos]) {
+    bf_pkt *pkts[BF_PKT_RX_BURST_MAX];
+    bf_pkt_rx_burst_callback cb;
+    void *cookie;
+    int n = 0;
+
+    bf_sys_mutex_lock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+    /* recheck, the handler may have been deregistered meanwhile */
+    if (rx_drv_info->rx_burst_cb_fn[cos]) {
+      rx_drv_info->rx_burst[cos][rx_drv_info->rx_burst_cnt[cos]++] = pkt;
+      if (rx_drv_info->rx_burst_cnt[cos] >= rx_drv_info->rx_burst_max[cos]) {
+        n = pkt_mgr_rx_burst_take_locked(rx_drv_info, cos, pkts, &cb, &cookie);
+      }
+      bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+      if (n) {
+        pkt_mgr_rx_burst_run(chip, rx_drv_info, cos, pkts, n, cb, cookie);
+      }
+      return 0;
+    }
+    bf_sys_mutex_unlock(&rx_drv_info->rx_pkt_ctx[cos].ring_mtx);
+  }
+  if (!rx_drv_info->rx_cb_fn[cos]) {
+    return -1;
+  }
+  start = pkt_mgr_now_ns();
+  rx_drv_info->rx_cb_fn[cos](chip, pkt, rx_drv_info->rx_cookie[cos], rx_ring);
+  pkt_mgr_rx_cb_stat_update(
+      &rx_drv_info->rx_stat[cos], start, pkt_mgr_now_ns(), 1);
+  return 0;
+}
+
 /**
  *
  * Callback functions to be registered with the LLD Client Library for the
@@ -260,17 +497,13 @@ void pkt_mgr_rx_pkt_cb(bf_dev_id_t chip,
     LOG_ERROR("Invalid virtual address at %s:%d", __func__, __LINE__);
     return;
   }
-  if (bf_pkt_alloc_ext_buf(chip,
-                           subdev_id,
-                           &pkt,
-                           data_sz,
-                           cos + BF_DMA_CPU_PKT_RECEIVE_0,
-                           address,
-                           hndl) != 0) {
+  if (pkt_mgr_rx_pkt_alloc(
+          chip, subdev_id, cos, &pkt, data_sz, address, hndl) != 0) {
     rx_drv_info->rx_stat[cos].pkt_alloc_err++;
     LOG_ERROR("%s error allocating a packet", __func__);
     return;
   }
+  rx_drv_info->rx_stat[cos].pkt_bytes += data_sz;
   switch (rx_drv_info->rx_pkt_ctx[cos].pkt_state) {
     case BF_PKT_INIT:
       rx_drv_info->rx_pkt_ctx[cos].pkt_first = pkt;
@@ -292,12 +525,11 @@ void pkt_mgr_rx_pkt_cb(bf_dev_id_t chip,
         rx_drv_info->rx_pkt_ctx[cos].pkt_last = pkt;
       } else {
         // this is the end packet. Callback the hndlr
-        if (rx_drv_info->rx_cb_fn[cos]) {
-          rx_drv_info->rx_cb_fn[cos](chip,
-                                     rx_drv_info->rx_pkt_ctx[cos].pkt_first,
-                                     rx_drv_info->rx_cookie[cos],
-                                     rx_ring);
-        } else {
+        if (pkt_mgr_rx_deliver(chip,
+                               rx_drv_info,
+                               cos,
+                               rx_ring,
+                               rx_drv_info->rx_pkt_ctx[cos].pkt_first) != 0) {
           rx_drv_info->rx_stat[cos].pkt_no_hndl_err++;
           goto err_and_exit;
         }
@@ -324,12 +556,11 @@ void pkt_mgr_rx_pkt_cb(bf_dev_id_t chip,
         rx_drv_info->rx_pkt_ctx[cos].pkt_last = pkt;
       } else {
         // this is the end packet. Callback the hndlr
-        if (rx_drv_info->rx_cb_fn[cos]) {
-          rx_drv_info->rx_cb_fn[cos](chip,
-                                     rx_drv_info->rx_pkt_ctx[cos].pkt_first,
-                                     rx_drv_info->rx_cookie[cos],
-                                     rx_ring);
-        } else {
+        if (pkt_mgr_rx_deliver(chip,
+                               rx_drv_info,
+                               cos,
+                               rx_ring,
+                               rx_drv_info->rx_pkt_ctx[cos].pkt_first) != 0) {
           rx_drv_info->rx_stat[cos].pkt_no_hndl_err++;
           goto err_and_exit;
         }
@@ -356,60 +587,42 @@ err_and_exit:
   return;
 }
 
-bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
-                      bf_pkt *pkt,
-                      bf_pkt_tx_ring_t tx_ring,
-                      void *tx_cookie) {
-  int s, e;
-  bf_dma_addr_t dma_addr;
-  bf_sys_dma_pool_handle_t hndl;
-  uint32_t size;
-  int ret = 0;
-  pkt_drv_info_t *tx_drv_info;
-  bf_subdev_id_t subdev_id = 0;
+/* Validate a TX request and resolve the subdevice and ring it maps to */
+static bf_status_t pkt_mgr_tx_ring_get(bf_dev_id_t dev_id,
+                                       bf_pkt_tx_ring_t *tx_ring,
+                                       bf_subdev_id_t *subdev_id) {
   bf_dev_family_t dev_family = 0;
 
   if ((dev_id >= PKT_MGR_NUM_DEVICES) || (dev_id < 0)) {
     return BF_INVALID_ARG;
   }
 
+  *subdev_id = 0;
   dev_family = pkt_drv_info[dev_id][0]->dev_family;
 
   if (dev_family == BF_DEV_FAMILY_TOFINO3) {
-    if (tx_ring >= BF_PKT_TX_RING_EXT_MAX) {
+    if (*tx_ring >= BF_PKT_TX_RING_EXT_MAX) {
       return BF_INVALID_ARG;
     }
-    if (tx_ring >= BF_PKT_TX_RING_MAX) {
-      subdev_id = 1;
-      tx_ring -= BF_PKT_TX_RING_MAX;  // rebase to 0-3
+    if (*tx_ring >= BF_PKT_TX_RING_MAX) {
+      *subdev_id = 1;
+      *tx_ring -= BF_PKT_TX_RING_MAX;  // rebase to 0-3
     }
-  } else if (tx_ring >= BF_PKT_TX_RING_MAX) {
+  } else if (*tx_ring >= BF_PKT_TX_RING_MAX) {
     return BF_INVALID_ARG;
   }
 
-  tx_drv_info = pkt_drv_info[dev_id][subdev_id];
-
-  if (!pkt) {
-    tx_drv_info->tx_stat[tx_ring].pkt_param_err++;
-    LOG_ERROR("%s bad values chip %d tx-ring %d pkt %p",
-              __func__,
-              dev_id,
-              tx_ring,
-              (void *)pkt);
-    return BF_INVALID_ARG;
-  }
-
-  if (!pkt_mgr_is_cpu_pkt_en(dev_id, subdev_id)) {
+  if (!pkt_mgr_is_cpu_pkt_en(dev_id, *subdev_id)) {
     LOG_ERROR(
         "cpu pkt path is disabled for ASIC-%d subdev %d, not transmitting tx "
         "pkt..\n",
         dev_id,
-        subdev_id);
+        *subdev_id);
     return BF_DEVICE_LOCKED;
   }
 
-  if (!tx_drv_info->tx_nt_fn[tx_ring]) {
-    tx_drv_info->tx_stat[tx_ring].pkt_no_hndl_err++;
+  if (!pkt_drv_info[dev_id][*subdev_id]->tx_nt_fn[*tx_ring]) {
+    pkt_drv_info[dev_id][*subdev_id]->tx_stat[*tx_ring].pkt_no_hndl_err++;
     /* do not transmit if completion function not registered to avoid packet
      * memory leaks.
      */
@@ -417,13 +630,16 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
         "no tx completion handler for ASIC-%d subdev %d, not transmitting tx "
         "pkt..\n",
         dev_id,
-        subdev_id);
+        *subdev_id);
     return BF_INVALID_ARG;
   }
+  return BF_SUCCESS;
+}
 
-  /* tbus is configured to insert 4 bytes of CRC
-   * pad the packet to the minimum pci pkt size of the device if needed.
-   */
+/* tbus is configured to insert 4 bytes of CRC
+ * pad the packet to the minimum pci pkt size of the device if needed.
+ */
+static void pkt_mgr_tx_pad(pkt_drv_info_t *tx_drv_info, bf_pkt *pkt) {
   if (bf_pkt_get_pkt_size(pkt) < tx_drv_info->pci_min_pkt_size &&
       !bf_pkt_get_bypass_padding(pkt)) {
     size_t pci_min_pkt_size = tx_drv_info->pci_min_pkt_size;
@@ -431,15 +647,20 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
     memset(bf_pkt_get_pkt_data(pkt) + bf_pkt_get_pkt_size(pkt), 0, pad_size);
     bf_pkt_set_pkt_size(pkt, pci_min_pkt_size);
   }
+}
 
-  tx_drv_info->tx_cookie[tx_ring] = tx_cookie;
-  if (bf_sys_mutex_lock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
-    LOG_ERROR("Not able to take mutex lock ASIC-%d subdev %d, tx_ring %d",
-              dev_id,
-              subdev_id,
-              tx_ring);
-    return BF_UNEXPECTED;
-  }
+/* Push all segments of a packet onto the TX DR, ring mutex must be held */
+static bf_status_t pkt_mgr_tx_push_pkt(bf_dev_id_t dev_id,
+                                       bf_subdev_id_t subdev_id,
+                                       pkt_drv_info_t *tx_drv_info,
+                                       bf_pkt_tx_ring_t tx_ring,
+                                       bf_pkt *pkt,
+                                       void *tx_cookie) {
+  int s, e;
+  bf_dma_addr_t dma_addr;
+  bf_sys_dma_pool_handle_t hndl;
+  uint32_t size;
+  int ret = 0;
 
   s = 1;
   e = 0;
@@ -463,12 +684,6 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
                 bf_pkt_get_pkt_data(pkt),
                 __func__,
                 __LINE__);
-      if (bf_sys_mutex_unlock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
-        LOG_ERROR("Not able to unlock mutex ASIC %d subdev %d, tx_ring %d",
-                  dev_id,
-                  subdev_id,
-                  tx_ring);
-      }
       return BF_HW_COMM_FAIL;
     }
     ret = lld_subdev_push_tx_packet(dev_id,
@@ -502,18 +717,52 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
           size,
           dma_addr,
           (uint64_t)(uintptr_t)tx_cookie);
-      if (bf_sys_mutex_unlock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
-        LOG_ERROR("Not able to unlock mutex ASIC-%d subdev %d, tx_ring %d",
-                  dev_id,
-                  subdev_id,
-                  tx_ring);
-      }
       return BF_HW_COMM_FAIL;
     }
     tx_drv_info->tx_stat[tx_ring].pkt_ok++;
     s = 0;
     pkt = bf_pkt_get_nextseg(pkt);
   }
+  return BF_SUCCESS;
+}
+
+/* Push n_pkts packets and start the DR once for all of them */
+static bf_status_t pkt_mgr_tx_pkts(bf_dev_id_t dev_id,
+                                   bf_subdev_id_t subdev_id,
+                                   bf_pkt_tx_ring_t tx_ring,
+                                   bf_pkt **pkts,
+                                   void **tx_cookies,
+                                   int n_pkts,
+                                   int *n_sent) {
+  pkt_drv_info_t *tx_drv_info = pkt_drv_info[dev_id][subdev_id];
+  bf_pkt_mgr_tx_stat_t *tx_stat = &tx_drv_info->tx_stat[tx_ring];
+  bf_status_t sts = BF_SUCCESS;
+  uint64_t start, end;
+  int i;
+
+  *n_sent = 0;
+  for (i = 0; i < n_pkts; i++) {
+    pkt_mgr_tx_pad(tx_drv_info, pkts[i]);
+  }
+
+  start = pkt_mgr_now_ns();
+  if (bf_sys_mutex_lock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
+    LOG_ERROR("Not able to take mutex lock ASIC-%d subdev %d, tx_ring %d",
+              dev_id,
+              subdev_id,
+              tx_ring);
+    return BF_UNEXPECTED;
+  }
+
+  for (i = 0; i < n_pkts; i++) {
+    tx_drv_info->tx_cookie[tx_ring] = tx_cookies[i];
+    sts = pkt_mgr_tx_push_pkt(
+        dev_id, subdev_id, tx_drv_info, tx_ring, pkts[i], tx_cookies[i]);
+    if (sts != BF_SUCCESS) {
+      break;
+    }
+  }
+  /* start the DR even after a failure so the packets already pushed go out */
   if (lld_dr_start(dev_id, subdev_id, lld_dr_tx_pkt_0 + tx_ring) != LLD_OK) {
     // TBD need to take care of freeing pkts here
     LOG_ERROR("%s:%d error pkt tx dma start chip %d subdev %d tx_ring %d",
@@ -522,13 +771,9 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
               dev_id,
               subdev_id,
               tx_ring);
-    if (bf_sys_mutex_unlock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
-      LOG_ERROR("Not able to unlock mutex ASIC-%d subdev %d, tx_ring %d",
-                dev_id,
-                subdev_id,
-                tx_ring);
-    }
-    return BF_HW_COMM_FAIL;
+    sts = BF_HW_COMM_FAIL;
+  } else {
+    *n_sent = i;
   }
   if (bf_sys_mutex_unlock(&(tx_drv_info->tx_pkt_ctx[tx_ring].ring_mtx))) {
     LOG_ERROR("Not able to unlock mutex ASIC-%d subdev %d, tx_ring %d",
@@ -536,7 +781,92 @@ bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
               subdev_id,
               tx_ring);
   }
-  return BF_SUCCESS;
+
+  end = pkt_mgr_now_ns();
+  tx_stat->push_cnt++;
+  tx_stat->push_ns_total += end - start;
+  if (end - start > tx_stat->push_ns_max) {
+    tx_stat->push_ns_max = end - start;
+  }
+  pkt_mgr_rate_update(
+      end, *n_sent, &tx_stat->win_start_ns, &tx_stat->win_pkts, &tx_stat->pps);
+  return sts;
+}
+
+bf_status_t bf_pkt_tx(bf_dev_id_t dev_id,
+                      bf_pkt *pkt,
+                      bf_pkt_tx_ring_t tx_ring,
+                      void *tx_cookie) {
+  bf_subdev_id_t subdev_id = 0;
+  bf_status_t sts;
+  int n_sent;
+
+  sts = pkt_mgr_tx_ring_get(dev_id, &tx_ring, &subdev_id);
+  if (sts != BF_SUCCESS) {
+    return sts;
+  }
+
+  if (!pkt) {
+    pkt_drv_info[dev_id][subdev_id]->tx_stat[tx_ring].pkt_param_err++;
+    LOG_ERROR("%s bad values chip %d tx-ring %d pkt %p",
+              __func__,
+              dev_id,
+              tx_ring,
+              (void *)pkt);
+    return BF_INVALID_ARG;
+  }
+
+  return pkt_mgr_tx_pkts(
+      dev_id, subdev_id, tx_ring, &pkt, &tx_cookie, 1, &n_sent);
+}
+
+bf_status_t bf_pkt_tx_burst(bf_dev_id_t dev_id,
+                            bf_pkt **pkts,
+                            void **tx_cookies,
+                            int n_pkts,
+                            bf_pkt_tx_ring_t tx_ring,
+                            int *n_sent) {
+  bf_subdev_id_t subdev_id = 0;
+  bf_status_t sts;
+  int i;
+
+  if (!n_sent) {
+    return BF_INVALID_ARG;
+  }
+  *n_sent = 0;
+
+  sts = pkt_mgr_tx_ring_get(dev_id, &tx_ring, &subdev_id);
+  if (sts != BF_SUCCESS) {
+    return sts;
+  }
+
+  if (!pkts || !tx_cookies || n_pkts < 0) {
+    pkt_drv_info[dev_id][subdev_id]->tx_stat[tx_ring].pkt_param_err++;
+    LOG_ERROR("%s bad values chip %d tx-ring %d n_pkts %d",
+              __func__,
+              dev_id,
+              tx_ring,
+              n_pkts);
+    return BF_INVALID_ARG;
+  }
+  for (i = 0; i < n_pkts; i++) {
+    if (!pkts[i]) {
+      pkt_drv_info[dev_id][subdev_id]->tx_stat[tx_ring].pkt_param_err++;
+      LOG_ERROR("%s bad values chip %d tx-ring %d pkt[%d] %p",
+                __func__,
+                dev_id,
+                tx_ring,
+                i,
+                (void *)pkts[i]);
+      return BF_INVALID_ARG;
+    }
+  }
+  if (n_pkts == 0) {
+    return BF_SUCCESS;
+  }
+
+  return pkt_mgr_tx_pkts(
+      dev_id, subdev_id, tx_ring, pkts, tx_cookies, n_pkts, n_sent);
 }
 
 void pkt_mgr_tx_completion_cb(bf_dev_id_t chip,
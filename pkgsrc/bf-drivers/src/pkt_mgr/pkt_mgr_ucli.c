@@ -28,6 +28,7 @@
 #include <lld/bf_dma_if.h>
 #include <pkt_mgr/bf_pkt.h>
 #include <pkt_mgr/pkt_mgr_intf.h>
+#include <pkt_mgr/bf_pkt_shm.h>
 #include "pkt_mgr_priv.h"
 #include <target-utils/uCli/ucli.h>
 #include <target-utils/uCli/ucli_argparse.h>
@@ -468,6 +469,24 @@ static ucli_status_t pkt_mgr_ucli_ucli__bf_pkt_stat__(ucli_context_t *uc) {
     aim_printf(&uc->pvs,
                "pkt_no_hndl_err:\t%" PRIu64 "\n",
                drv_info->rx_stat[i].pkt_no_hndl_err);
+    aim_printf(&uc->pvs,
+               "pkt_bytes:\t\t%" PRIu64 "\n",
+               drv_info->rx_stat[i].pkt_bytes);
+    aim_printf(
+        &uc->pvs, "pps:\t\t\t%" PRIu64 "\n", drv_info->rx_stat[i].pps);
+    aim_printf(
+        &uc->pvs, "cb_cnt:\t\t\t%" PRIu64 "\n", drv_info->rx_stat[i].cb_cnt);
+    aim_printf(&uc->pvs,
+               "burst_cnt:\t\t%" PRIu64 "\n",
+               drv_info->rx_stat[i].burst_cnt);
+    aim_printf(&uc->pvs,
+               "cb_ns_avg:\t\t%" PRIu64 "\n",
+               drv_info->rx_stat[i].cb_cnt ? drv_info->rx_stat[i].cb_ns_total /
+                                                 drv_info->rx_stat[i].cb_cnt
+                                           : 0);
+    aim_printf(&uc->pvs,
+               "cb_ns_max:\t\t%" PRIu64 "\n",
+               drv_info->rx_stat[i].cb_ns_max);
   }
   aim_printf(&uc->pvs, "packet Tx counters\n");
   for (i = 0; i < 4; i++) {
@@ -491,7 +510,154 @@ static ucli_status_t pkt_mgr_ucli_ucli__bf_pkt_stat__(ucli_context_t *uc) {
     aim_printf(&uc->pvs,
                "pkt_no_hndl_err:\t%" PRIu64 "\n",
                drv_info->tx_stat[i].pkt_no_hndl_err);
+    aim_printf(
+        &uc->pvs, "pps:\t\t\t%" PRIu64 "\n", drv_info->tx_stat[i].pps);
+    aim_printf(&uc->pvs,
+               "push_cnt:\t\t%" PRIu64 "\n",
+               drv_info->tx_stat[i].push_cnt);
+    aim_printf(&uc->pvs,
+               "push_ns_avg:\t\t%" PRIu64 "\n",
+               drv_info->tx_stat[i].push_cnt
+                   ? drv_info->tx_stat[i].push_ns_total /
+                         drv_info->tx_stat[i].push_cnt
+                   : 0);
+    aim_printf(&uc->pvs,
+               "push_ns_max:\t\t%" PRIu64 "\n",
+               drv_info->tx_stat[i].push_ns_max);
+  }
+  return 0;
+}
+
+static ucli_status_t pkt_mgr_ucli_ucli__shm_export__(ucli_context_t *uc) {
+  bf_dev_id_t dev = 0;
+  int rx_ring, tx_ring;
+  uint32_t n_frames, frame_size;
+  bf_status_t sts;
+
+  UCLI_COMMAND_INFO(
+      uc,
+      "shm_export",
+      5,
+      "shm_export <dev_id> <rx_ring> <tx_ring> <n_frames> <frame_size>");
+  dev = atoi(uc->pargs->args[0]);
+  rx_ring = strtoul(uc->pargs->args[1], NULL, 10);
+  tx_ring = strtoul(uc->pargs->args[2], NULL, 10);
+  n_frames = strtoul(uc->pargs->args[3], NULL, 10);
+  frame_size = strtoul(uc->pargs->args[4], NULL, 10);
+  sts = bf_pkt_shm_export(dev, rx_ring, tx_ring, n_frames, frame_size, NULL);
+  if (sts != BF_SUCCESS) {
+    aim_printf(&uc->pvs, "export failed: %s\n", bf_err_str(sts));
+  }
+  return 0;
+}
+
+static ucli_status_t pkt_mgr_ucli_ucli__shm_unexport__(ucli_context_t *uc) {
+  bf_dev_id_t dev = 0;
+  bf_status_t sts;
+
+  UCLI_COMMAND_INFO(uc, "shm_unexport", 1, "shm_unexport <dev_id>");
+  dev = atoi(uc->pargs->args[0]);
+  sts = bf_pkt_shm_unexport(dev);
+  if (sts != BF_SUCCESS) {
+    aim_printf(&uc->pvs, "unexport failed: %s\n", bf_err_str(sts));
+  }
+  return 0;
+}
+
+static ucli_status_t pkt_mgr_ucli_ucli__shm_stats__(ucli_context_t *uc) {
+  bf_dev_id_t dev = 0;
+  pkt_mgr_shm_stat_t stat;
+  char path[128];
+
+  UCLI_COMMAND_INFO(uc, "shm_stats", 1, "shm_stats <dev_id>");
+  dev = atoi(uc->pargs->args[0]);
+  if (pkt_mgr_shm_stat_get(dev, path, sizeof(path), &stat) != BF_SUCCESS) {
+    aim_printf(&uc->pvs, "No export on dev %d\n", dev);
+    return 0;
+  }
+  aim_printf(&uc->pvs, "export:\t\t\t%s\n", path);
+  aim_printf(&uc->pvs, "rx_pkts:\t\t%" PRIu64 "\n", stat.rx_pkts);
+  aim_printf(&uc->pvs, "rx_no_frame:\t\t%" PRIu64 "\n", stat.rx_no_frame);
+  aim_printf(&uc->pvs, "rx_too_long:\t\t%" PRIu64 "\n", stat.rx_too_long);
+  aim_printf(&uc->pvs, "tx_pkts:\t\t%" PRIu64 "\n", stat.tx_pkts);
+  aim_printf(&uc->pvs, "tx_compl:\t\t%" PRIu64 "\n", stat.tx_compl);
+  aim_printf(&uc->pvs, "tx_no_buf:\t\t%" PRIu64 "\n", stat.tx_no_buf);
+  aim_printf(&uc->pvs, "tx_inflight:\t\t%" PRIu64 "\n", stat.tx_inflight);
+  aim_printf(&uc->pvs, "bad_desc:\t\t%" PRIu64 "\n", stat.bad_desc);
+  return 0;
+}
+
+/* Act as the application side of an export: every frame received on the rx
+ * ring is posted unchanged on the tx ring and every completed frame is handed
+ * back to the fill ring, moving only descriptors. */
+static ucli_status_t pkt_mgr_ucli_ucli__shm_loopback__(ucli_context_t *uc) {
+  bf_dev_id_t dev = 0;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *src, *dst;
+  char path[128];
+  uint64_t count, looped = 0, start, now, timeout_ns;
+  uint32_t n, i;
+
+  UCLI_COMMAND_INFO(uc,
+                    "shm_loopback",
+                    3,
+                    "shm_loopback <dev_id> <pkt_count> <timeout_ms>");
+  dev = atoi(uc->pargs->args[0]);
+  count = strtoull(uc->pargs->args[1], NULL, 10);
+  timeout_ns = strtoull(uc->pargs->args[2], NULL, 10) * 1000000ULL;
+
+  snprintf(path, sizeof(path), BF_PKT_SHM_PATH_FMT, dev);
+  if (bf_pkt_shm_attach(path, &hdr) != 0) {
+    aim_printf(&uc->pvs, "Unable to attach to %s\n", path);
+    return 0;
+  }
+
+  start = pkt_mgr_now_ns();
+  now = start;
+  while (looped < count && now - start < timeout_ns) {
+    /* received frames go straight back out */
+    n = count - looped < 64 ? count - looped : 64;
+    n = bf_pkt_shm_cons_peek(&hdr->rx, n);
+    n = bf_pkt_shm_prod_reserve(&hdr->tx, n);
+    for (i = 0; i < n; i++) {
+      src = bf_pkt_shm_desc(hdr, &hdr->rx, hdr->rx.cons + i);
+      dst = bf_pkt_shm_desc(hdr, &hdr->tx, hdr->tx.prod + i);
+      *dst = *src;
+    }
+    if (n) {
+      bf_pkt_shm_cons_release(&hdr->rx, n);
+      bf_pkt_shm_prod_submit(&hdr->tx, n);
+      looped += n;
+    }
+    /* transmitted frames are recycled for RX */
+    n = bf_pkt_shm_cons_peek(&hdr->comp, 64);
+    n = bf_pkt_shm_prod_reserve(&hdr->fill, n);
+    for (i = 0; i < n; i++) {
+      src = bf_pkt_shm_desc(hdr, &hdr->comp, hdr->comp.cons + i);
+      dst = bf_pkt_shm_desc(hdr, &hdr->fill, hdr->fill.prod + i);
+      dst->frame = src->frame;
+      dst->len = 0;
+      dst->flags = 0;
+    }
+    if (n) {
+      bf_pkt_shm_cons_release(&hdr->comp, n);
+      bf_pkt_shm_prod_submit(&hdr->fill, n);
+    } else {
+      bf_sys_usleep(10);
+    }
+    now = pkt_mgr_now_ns();
+  }
+  bf_pkt_shm_detach(hdr);
+
+  aim_printf(&uc->pvs,
+             "looped %" PRIu64 " pkts in %" PRIu64 " us",
+             looped,
+             (now - start) / 1000);
+  if (now > start && looped) {
+    aim_printf(
+        &uc->pvs, ", %" PRIu64 " pps", looped * 1000000000ULL / (now - start));
   }
+  aim_printf(&uc->pvs, "\n");
   return 0;
 }
 
@@ -505,6 +671,10 @@ static ucli_command_handler_f pkt_mgr_ucli_ucli_handlers__[] = {
     pkt_mgr_ucli_ucli__bf_pkt_tx_cleanup__,
     pkt_mgr_ucli_ucli__bf_pkt_tx__,
     pkt_mgr_ucli_ucli__bf_pkt_int_en__,
+    pkt_mgr_ucli_ucli__shm_export__,
+    pkt_mgr_ucli_ucli__shm_unexport__,
+    pkt_mgr_ucli_ucli__shm_stats__,
+    pkt_mgr_ucli_ucli__shm_loopback__,
     NULL};
 
 static ucli_module_t pkt_mgr_ucli_module__ = {
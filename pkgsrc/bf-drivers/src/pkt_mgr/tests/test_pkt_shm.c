@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+/*
+ * Tests of the shared memory ring protocol of pkt_mgr/bf_pkt_shm.h. The
+ * region is laid out the way bf_pkt_shm_export() does it and driven from
+ * two threads through the inline helpers only, exactly as an application
+ * and the packet manager do.
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pkt_mgr/bf_pkt_shm.h>
+
+#define TEST_N_FRAMES 64
+#define TEST_FRAME_SIZE 256
+#define TEST_N_PKTS 1000000
+
+static char test_path[64];
+
+static uint32_t test_align(uint64_t v, uint64_t a) {
+  return (uint32_t)((v + a - 1) & ~(a - 1));
+}
+
+/* Lay out an export the way the packet manager does and map it */
+static bf_pkt_shm_hdr_t *test_region_create(uint32_t n_frames,
+                                            uint32_t frame_size) {
+  bf_pkt_shm_hdr_t *hdr;
+  uint32_t off, ring_bytes;
+  uint64_t size;
+  void *p;
+  int fd;
+
+  ring_bytes = test_align((uint64_t)n_frames * sizeof(bf_pkt_shm_desc_t),
+                          BF_PKT_SHM_CACHE_LINE);
+  off = test_align(sizeof(*hdr), BF_PKT_SHM_CACHE_LINE);
+  size = test_align((uint64_t)off + 4 * (uint64_t)ring_bytes, 4096);
+  size += (uint64_t)n_frames * frame_size;
+
+  fd = open(test_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  assert(fd >= 0);
+  assert(ftruncate(fd, size) == 0);
+  p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  assert(p != MAP_FAILED);
+  hdr = p;
+  hdr->n_frames = n_frames;
+  hdr->frame_size = frame_size;
+  hdr->region_size = size;
+  hdr->rx.size = hdr->fill.size = hdr->tx.size = hdr->comp.size = n_frames;
+  hdr->rx.desc_off = off;
+  hdr->fill.desc_off = off + ring_bytes;
+  hdr->tx.desc_off = off + 2 * ring_bytes;
+  hdr->comp.desc_off = off + 3 * ring_bytes;
+  hdr->frames_off = test_align((uint64_t)off + 4 * ring_bytes, 4096);
+  hdr->version = BF_PKT_SHM_VERSION;
+  __atomic_store_n(&hdr->magic, BF_PKT_SHM_MAGIC, __ATOMIC_RELEASE);
+  return hdr;
+}
+
+static void test_region_destroy(bf_pkt_shm_hdr_t *hdr) {
+  munmap(hdr, hdr->region_size);
+  unlink(test_path);
+}
+
+/* attach only accepts a complete region of the expected version */
+static void test_attach(void) {
+  bf_pkt_shm_hdr_t *hdr, *app;
+
+  hdr = test_region_create(TEST_N_FRAMES, TEST_FRAME_SIZE);
+  assert(bf_pkt_shm_attach(test_path, &app) == 0);
+  assert(app->n_frames == TEST_N_FRAMES);
+  assert(bf_pkt_shm_frame(app, 1) - bf_pkt_shm_frame(app, 0) ==
+         TEST_FRAME_SIZE);
+  bf_pkt_shm_detach(app);
+
+  hdr->version = BF_PKT_SHM_VERSION + 1;
+  assert(bf_pkt_shm_attach(test_path, &app) != 0);
+  hdr->version = BF_PKT_SHM_VERSION;
+
+  hdr->region_size += 4096;
+  assert(bf_pkt_shm_attach(test_path, &app) != 0);
+  hdr->region_size -= 4096;
+
+  hdr->magic = 0;
+  assert(bf_pkt_shm_attach(test_path, &app) != 0);
+
+  test_region_destroy(hdr);
+  assert(bf_pkt_shm_attach(test_path, &app) != 0);
+}
+
+/* empty and full conditions, also across the wrap of the free running
+ * indices */
+static void test_ring_limits(uint32_t start) {
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_ring_t *ring;
+  bf_pkt_shm_desc_t *desc;
+  uint32_t i, n;
+
+  hdr = test_region_create(TEST_N_FRAMES, TEST_FRAME_SIZE);
+  ring = &hdr->tx;
+  ring->prod = ring->cons = start;
+
+  assert(bf_pkt_shm_cons_peek(ring, TEST_N_FRAMES) == 0);
+  assert(bf_pkt_shm_prod_reserve(ring, 2 * TEST_N_FRAMES) == TEST_N_FRAMES);
+
+  /* fill the ring in uneven batches */
+  for (i = 0; i < TEST_N_FRAMES;) {
+    n = bf_pkt_shm_prod_reserve(ring, 5);
+    assert(n == (TEST_N_FRAMES - i < 5 ? TEST_N_FRAMES - i : 5));
+    for (uint32_t j = 0; j < n; j++) {
+      desc = bf_pkt_shm_desc(hdr, ring, ring->prod + j);
+      desc->frame = i + j;
+      desc->len = (uint16_t)(i + j + 1);
+    }
+    /* nothing is visible until the submit */
+    assert(bf_pkt_shm_cons_peek(ring, TEST_N_FRAMES) == i);
+    bf_pkt_shm_prod_submit(ring, n);
+    i += n;
+  }
+  assert(bf_pkt_shm_prod_reserve(ring, 1) == 0);
+  assert(bf_pkt_shm_cons_peek(ring, 2 * TEST_N_FRAMES) == TEST_N_FRAMES);
+  assert(bf_pkt_shm_cons_peek(ring, 3) == 3);
+
+  /* drain it again in a different batch size */
+  for (i = 0; i < TEST_N_FRAMES;) {
+    n = bf_pkt_shm_cons_peek(ring, 7);
+    for (uint32_t j = 0; j < n; j++) {
+      desc = bf_pkt_shm_desc(hdr, ring, ring->cons + j);
+      assert(desc->frame == i + j);
+      assert(desc->len == i + j + 1);
+    }
+    /* space comes back only with the release */
+    assert(bf_pkt_shm_prod_reserve(ring, TEST_N_FRAMES) == i);
+    bf_pkt_shm_cons_release(ring, n);
+    i += n;
+  }
+  assert(bf_pkt_shm_cons_peek(ring, 1) == 0);
+  assert(ring->prod == start + TEST_N_FRAMES);
+  assert(ring->cons == ring->prod);
+  test_region_destroy(hdr);
+}
+
+/* Two sides passing frames around: the producer fills a frame taken from
+ * the free ring with a pattern and posts it, the consumer checks the pattern
+ * and returns the frame. Every frame content and every descriptor has to be
+ * visible by the time the index update is. */
+struct test_side {
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_ring_t *in;
+  bf_pkt_shm_ring_t *out;
+  uint64_t count;
+};
+
+static void *test_producer(void *arg) {
+  struct test_side *s = arg;
+  bf_pkt_shm_desc_t *in, *out;
+  uint64_t seq = 0;
+  uint32_t n, m, i, w;
+  uint8_t *data;
+
+  while (seq < s->count) {
+    n = bf_pkt_shm_cons_peek(s->in, 1 + seq % 13);
+    m = bf_pkt_shm_prod_reserve(s->out, n);
+    for (i = 0; i < m && seq < s->count; i++, seq++) {
+      in = bf_pkt_shm_desc(s->hdr, s->in, s->in->cons + i);
+      out = bf_pkt_shm_desc(s->hdr, s->out, s->out->prod + i);
+      data = bf_pkt_shm_frame(s->hdr, in->frame);
+      for (w = 0; w < TEST_FRAME_SIZE / sizeof(uint64_t); w++) {
+        ((uint64_t *)data)[w] = seq + w;
+      }
+      out->frame = in->frame;
+      out->len = (uint16_t)(seq & 0xffff);
+      out->flags = 0;
+    }
+    if (i) {
+      bf_pkt_shm_cons_release(s->in, i);
+      bf_pkt_shm_prod_submit(s->out, i);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void *test_consumer(void *arg) {
+  struct test_side *s = arg;
+  bf_pkt_shm_desc_t *in, *out;
+  uint64_t seq = 0;
+  uint32_t n, m, i, w;
+  uint8_t *data;
+
+  while (seq < s->count) {
+    n = bf_pkt_shm_cons_peek(s->in, 1 + seq % 11);
+    m = bf_pkt_shm_prod_reserve(s->out, n);
+    for (i = 0; i < m; i++, seq++) {
+      in = bf_pkt_shm_desc(s->hdr, s->in, s->in->cons + i);
+      assert(in->frame < TEST_N_FRAMES);
+      assert(in->len == (uint16_t)(seq & 0xffff));
+      data = bf_pkt_shm_frame(s->hdr, in->frame);
+      for (w = 0; w < TEST_FRAME_SIZE / sizeof(uint64_t); w++) {
+        assert(((uint64_t *)data)[w] == seq + w);
+      }
+      out = bf_pkt_shm_desc(s->hdr, s->out, s->out->prod + i);
+      out->frame = in->frame;
+      out->len = 0;
+      out->flags = 0;
+    }
+    if (m) {
+      bf_pkt_shm_cons_release(s->in, m);
+      bf_pkt_shm_prod_submit(s->out, m);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void test_ring_threads(uint32_t start) {
+  struct test_side prod, cons;
+  bf_pkt_shm_hdr_t *hdr;
+  bf_pkt_shm_desc_t *desc;
+  pthread_t t_prod, t_cons;
+  uint32_t i;
+
+  hdr = test_region_create(TEST_N_FRAMES, TEST_FRAME_SIZE);
+  hdr->tx.prod = hdr->tx.cons = start;
+  hdr->comp.prod = hdr->comp.cons = start;
+  /* every frame starts out free on the comp ring */
+  for (i = 0; i < TEST_N_FRAMES; i++) {
+    desc = bf_pkt_shm_desc(hdr, &hdr->comp, start + i);
+    desc->frame = i;
+  }
+  hdr->comp.prod += TEST_N_FRAMES;
+
+  prod.hdr = cons.hdr = hdr;
+  prod.in = cons.out = &hdr->comp;
+  prod.out = cons.in = &hdr->tx;
+  prod.count = cons.count = TEST_N_PKTS;
+  assert(pthread_create(&t_prod, NULL, test_producer, &prod) == 0);
+  assert(pthread_create(&t_cons, NULL, test_consumer, &cons) == 0);
+  pthread_join(t_prod, NULL);
+  pthread_join(t_cons, NULL);
+
+  /* all frames are back on the free ring */
+  assert(bf_pkt_shm_cons_peek(&hdr->tx, TEST_N_FRAMES) == 0);
+  assert(bf_pkt_shm_cons_peek(&hdr->comp, 2 * TEST_N_FRAMES) ==
+         TEST_N_FRAMES);
+  test_region_destroy(hdr);
+}
+
+int main() {
+  snprintf(test_path, sizeof(test_path), "/tmp/test_pkt_shm.%d", (int)getpid());
+  test_attach();
+  test_ring_limits(0);
+  test_ring_limits(UINT32_MAX - TEST_N_FRAMES / 2);
+  test_ring_threads(0);
+  test_ring_threads(UINT32_MAX - 1000);
+  printf("pkt_mgr shm ring tests passed\n");
+  return 0;
+}
@@ -609,7 +609,10 @@ switch_status_t after_vrf_create(const switch_object_id_t object_id,
 
   switch_lpm_trie_t *trie = NULL;
   if (SWITCH_CONTEXT.ipv4_tries[object_id.data] == NULL) {
-    status |= switch_lpm_trie_create(sizeof(switch_ip4_t), true, &trie);
+    status |= switch_lpm_trie_engine_create(sizeof(switch_ip4_t),
+                                            true,
+                                            SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP,
+                                            &trie);
     SWITCH_CONTEXT.ipv4_tries[object_id.data] = trie;
   }
 
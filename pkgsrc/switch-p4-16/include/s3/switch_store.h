@@ -75,6 +75,7 @@ switch_status_t object_info_init(const char *const object_info_path,
                                  const char *const warm_init_file,
                                  bool override_log_level = true);
 switch_status_t object_info_dump(const char *dump_file);
+switch_status_t object_info_dump_text(const char *dump_file);
 switch_status_t object_info_clean();
 switch_status_t object_replay(bool warm_init);
 
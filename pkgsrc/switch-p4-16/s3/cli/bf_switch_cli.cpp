@@ -4336,15 +4336,22 @@ int bf_switch_cli_show_tech_support_internal(void *clish_context) {
 }
 
 /*
- * cli: state save <destination file path>
+ * cli: state save <destination file path> [text]
  */
 int bf_switch_cli_state_save_internal(void *clish_context) {
+  clish_pargv_t *pargv = clish_context__get_pargv(clish_context);
   const char *filepath = NULL;
   bf_switch_cli_status_t cli_status =
       bf_switch_cli_clish_get_pname_value(clish_context, "filepath", filepath);
 
   if (cli_status == BF_SWITCH_CLI_STATUS_SUCCESS_E) {
-    if (switch_store::object_info_dump(filepath) != SWITCH_STATUS_SUCCESS)
+    switch_status_t status;
+    if (clish_pargv_find_arg(pargv, "text")) {
+      status = switch_store::object_info_dump_text(filepath);
+    } else {
+      status = switch_store::object_info_dump(filepath);
+    }
+    if (status != SWITCH_STATUS_SUCCESS)
       cli_status = BF_SWITCH_CLI_STATUS_FAILURE_E;
   }
 
@@ -18,9 +18,14 @@
  ******************************************************************************/
 
 
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <store.h>
 
+#include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <vector>
 #include <string>
@@ -36,6 +41,10 @@ namespace db {
 
 using ::smi::logging::switch_log;
 
+/* The store itself lives for the whole process, object_attr_hash is only set
+ * once db_load has run so get_db() keeps returning nullptr before that
+ */
+db_store store;
 db_store *object_attr_hash = nullptr;
 const db_store *get_db() { return object_attr_hash; }
 std::vector<switch_object_id_t> ordered_create_list;
@@ -43,16 +52,50 @@ const std::vector<switch_object_id_t> &get_creation_list() {
   return ordered_create_list;
 }
 
-/* Mutex to protect the primary db_store. There is no global lock held anywhere
- * else and this is the only mutex which will provide concurrency
+/* Nesting depth of switch_store_lock() in this thread. The outermost call
+ * takes every shard exclusive, so while it is held the per call shard locks
+ * below are skipped. This keeps the recursive semantics of the old single
+ * store mutex for callers that read and write objects under the store lock.
  */
-std::recursive_mutex db_mtx;
+thread_local int store_lock_depth = 0;
+
+/* Holds one shard for the duration of a store call, shared for readers */
+class shard_guard {
+ public:
+  shard_guard(db_shard &shard, bool exclusive)
+      : shard_(shard), exclusive_(exclusive), owned_(store_lock_depth == 0) {
+    if (!owned_) return;
+    if (exclusive_)
+      shard_.mtx.lock();
+    else
+      shard_.mtx.lock_shared();
+  }
+  ~shard_guard() {
+    if (!owned_) return;
+    if (exclusive_)
+      shard_.mtx.unlock();
+    else
+      shard_.mtx.unlock_shared();
+  }
+  shard_guard(const shard_guard &) = delete;
+  shard_guard &operator=(const shard_guard &) = delete;
+
+ private:
+  db_shard &shard_;
+  const bool exclusive_;
+  const bool owned_;
+};
 
 class topoSort {
   std::unordered_map<switch_object_id_t, bool> vertices;
   std::unordered_map<switch_object_id_t, std::set<switch_object_id_t>> edges;
+  std::vector<switch_object_id_t> &ordered_list;
 
  public:
+  explicit topoSort(
+      std::vector<switch_object_id_t> &order = ordered_create_list)
+      : ordered_list(order) {}
+
   void addEdge(const switch_object_id_t vertex, const switch_object_id_t edge) {
     edges[vertex].insert(edge);
     vertices[vertex] = false;
@@ -90,12 +133,12 @@ class topoSort {
     }
 
     // Push current vertex to stack which stores result
-    ordered_create_list.push_back(v);
+    ordered_list.push_back(v);
   }
 
   // The function to do Topological Sort. It uses recursive topologicalSort()
   void goSort() {
-    ordered_create_list.clear();
+    ordered_list.clear();
     // Call the recursive helper function to store Topological
     // Sort starting from all vertices one by one
     for (auto it = edges.begin(); it != edges.end(); it++) {
@@ -116,9 +159,8 @@ class topoSort {
  */
 void write_one_object(std::ofstream &out,
                       switch_object_id_t object,
+                      attribute_map &attr_map,
                       ModelInfo *model_info) {
-  if (object_attr_hash->find(object) == object_attr_hash->end()) return;
-
   switch_object_type_t object_type = switch_store::object_type_query(object);
   const ObjectInfo *object_info = model_info->get_object_info(object_type);
   if (object_info == NULL) {
@@ -134,12 +176,12 @@ void write_one_object(std::ofstream &out,
   }
   std::string object_name = object_info->get_object_name_fqn();
 
-  (*object_attr_hash)[object].first++;
+  attr_map.first++;
   std::stringstream this_object_out;
   this_object_out << object_name << ":";
   this_object_out << object;
 
-  for (auto &ita : (*object_attr_hash)[object].second) {
+  for (auto &ita : attr_map.second) {
     if (ita.attr_id == SPECIAL_OBJECT_STATUS_ATTR_ID) continue;
     value_key_t key = {.attr_id = ita.attr_id, .extra = ita.extra};
     const AttributeMetadata *attr_md =
@@ -240,7 +282,7 @@ void write_one_object_one_attr(std::ofstream &out,
   }
   std::string object_name = object_info->get_object_name_fqn();
 
-  (*object_attr_hash)[object].first++;
+  store.shard(object).objects[object].first++;
   std::stringstream this_object_out;
   this_object_out << object_name << ":";
   this_object_out << object;
@@ -396,16 +438,22 @@ switch_status_t db_print(bool stats_cache_only) {
  * Read each object from DB and store to file
  */
 switch_status_t db_clear() {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  object_attr_hash->clear();
+  switch_store_lock();
+  for (size_t i = 0; i < DB_STORE_SHARDS; i++) {
+    db_shard &shard = store.shard_at(i);
+    shard.objects.clear();
+    // object_lock waiters return once their object is gone
+    if (shard.lock_waiters) shard.lock_cv.notify_all();
+  }
+  switch_store_unlock();
   return SWITCH_STATUS_SUCCESS;
 }
 
 /*
- * Read each object from DB and store to file
+ * Read each object from DB and store to file in the text format.
+ * Only used as a human readable debug export, warm boot uses db_dump
  */
-switch_status_t db_dump(const char *const dump_file) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
+switch_status_t db_dump_text(const char *const dump_file) {
   uint64_t num_records = 0;
 
   ModelInfo *model_info = NULL;
@@ -420,11 +468,14 @@ switch_status_t db_dump(const char *const dump_file) {
   std::ofstream out;
   out.open(out_file.c_str(), std::ofstream::trunc);
   if (out) {
-    for (auto it = object_attr_hash->begin(); it != object_attr_hash->end();
-         it++) {
-      write_one_object(out, it->first, model_info);
-      num_records++;
+    switch_store_lock();
+    for (size_t i = 0; i < DB_STORE_SHARDS; i++) {
+      for (auto &object : store.shard_at(i).objects) {
+        write_one_object(out, object.first, object.second, model_info);
+        num_records++;
+      }
     }
+    switch_store_unlock();
   }
   out.close();
   switch_log(SWITCH_API_LEVEL_WARN,
@@ -582,34 +633,15 @@ void set_list_value(switch_attribute_value_t &value_in,
 }
 
 /*
- * Read each object from file and store to DB
- * Parse the object_id first and reserve it in oid_store
- * Then start adding each attribute to store
+ * Parse the text format written by db_dump_text
  */
-switch_status_t db_load(bool warm_init, const char *const warm_init_file) {
+switch_status_t db_load_text(const std::string &in_file,
+                             ModelInfo *model_info) {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
-  ModelInfo *model_info = NULL;
   uint64_t num_records = 0;
   topoSort topo;
   switch_object_id_t empty = {};
 
-  object_attr_hash = new db_store();
-
-  // nothing to load if not warm_init_mode
-  if (!warm_init) return status;
-  switch_log(
-      SWITCH_API_LEVEL_WARN, SWITCH_OT_NONE, "db_read: Warm boot initiated");
-
-  model_info = switch_store::switch_model_info_get();
-  if (model_info == nullptr) {
-    return SWITCH_STATUS_FAILURE;
-  }
-
-  std::string in_file = warm_init_file;
-  switch_log(SWITCH_API_LEVEL_WARN,
-             SWITCH_OT_NONE,
-             "db_read: Data reading from persistent storage at {}",
-             in_file.c_str());
   std::ifstream infile;
   infile.open(in_file.c_str());
   std::string line;
@@ -751,8 +783,524 @@ switch_status_t db_load(bool warm_init, const char *const warm_init_file) {
   return status;
 }
 
+/*
+ * Binary warm boot snapshot
+ *
+ * Written by db_dump at warm shutdown and mapped read only by db_load, nothing
+ * in it is tokenized:
+ *
+ *   snapshot_header_t
+ *   objects - a snapshot_object_t per object followed by its attributes as
+ *             fixed size snapshot_attr_t records
+ *   order   - uint32_t object index per object, in creation order
+ *   strings - uint32_t offset per string followed by the NUL terminated
+ *             strings, string 0 is always ""
+ *
+ * Like the text format, object types, attributes and enum values are stored by
+ * FQN so ids which change across the reboot are remapped. Each name is looked
+ * up once per snapshot though, not once per record, and the creation order is
+ * computed at dump time so the load doesn't topo sort.
+ */
+#define DB_SNAPSHOT_MAGIC 0x42533353 /* "S3SB" */
+#define DB_SNAPSHOT_VERSION 1
+
+typedef struct snapshot_header_s {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t file_size;
+  uint32_t object_count;
+  uint32_t attr_count;
+  uint32_t order_count;
+  uint32_t string_count;
+  uint64_t objects_off;
+  uint64_t order_off;
+  uint64_t strings_off;
+} snapshot_header_t;
+
+typedef struct snapshot_object_s {
+  uint64_t oid;        /* object id before the reboot */
+  uint32_t type_name;  /* object type FQN */
+  uint32_t attr_count; /* snapshot_attr_t records following this one */
+} snapshot_object_t;
+
+typedef struct snapshot_attr_s {
+  uint32_t attr_name; /* attribute FQN */
+  uint32_t ref_name;  /* enum FQN, or object type FQN of an object id value */
+  uint16_t extra;
+  uint8_t type;      /* switch_attr_type_t of data */
+  uint8_t list_type; /* element type of a list head */
+  uint32_t reserved;
+  uint64_t data[3]; /* raw value, a list head keeps its count in data[0] */
+} snapshot_attr_t;
+
+/* the raw value is the union at the start of switch_attribute_value_t */
+#define DB_SNAPSHOT_VALUE_SIZE offsetof(switch_attribute_value_t, type)
+static_assert(DB_SNAPSHOT_VALUE_SIZE <= sizeof(snapshot_attr_t::data),
+              "snapshot_attr_t too small for switch_attribute_value_t");
+
+/*
+ * Write the whole DB as a binary snapshot, see above for the layout
+ */
+switch_status_t db_dump(const char *const dump_file) {
+  snapshot_header_t hdr = {};
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> string_ids;
+  std::vector<snapshot_attr_t> attrs;
+  std::unordered_map<switch_object_id_t, uint32_t> object_index;
+  std::vector<switch_object_id_t> order;
+  topoSort topo(order);
+  switch_object_id_t empty = {};
+
+  ModelInfo *model_info = switch_store::switch_model_info_get();
+  if (model_info == nullptr) {
+    switch_log(SWITCH_API_LEVEL_ERROR,
+               SWITCH_OT_NONE,
+               "db_write: Warm reboot failed, Failed to get model info");
+    return SWITCH_STATUS_FAILURE;
+  }
+
+  auto string_id = [&strings, &string_ids](const std::string &name) {
+    auto it = string_ids.find(name);
+    if (it != string_ids.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(name);
+    string_ids.emplace(name, id);
+    return id;
+  };
+  string_id("");
+
+  std::string out_file = dump_file;
+  std::ofstream out;
+  out.open(out_file.c_str(), std::ofstream::binary | std::ofstream::trunc);
+  if (!out) {
+    switch_log(SWITCH_API_LEVEL_ERROR,
+               SWITCH_OT_NONE,
+               "db_write: Failed to open {}",
+               out_file.c_str());
+    return SWITCH_STATUS_FAILURE;
+  }
+  // header is rewritten once all offsets are known
+  out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+  hdr.objects_off = sizeof(hdr);
+
+  switch_store_lock();
+  for (size_t i = 0; i < DB_STORE_SHARDS; i++) {
+    for (auto &object : store.shard_at(i).objects) {
+      const switch_object_id_t oid = object.first;
+      switch_object_type_t object_type = switch_store::object_type_query(oid);
+      const ObjectInfo *object_info = model_info->get_object_info(object_type);
+      if (object_info == NULL) {
+        switch_log(SWITCH_API_LEVEL_ERROR,
+                   SWITCH_OT_NONE,
+                   "{}.{}: Invalid object: {} type: {}. Skipping this object "
+                   "for db save",
+                   __func__,
+                   __LINE__,
+                   oid,
+                   object_type);
+        continue;
+      }
+      bool is_device = object_info->get_object_name().compare("device") == 0;
+      topo.addEdge(oid, empty);
+
+      attrs.clear();
+      for (const auto &ita : object.second.second) {
+        if (ita.attr_id == SPECIAL_OBJECT_STATUS_ATTR_ID) continue;
+        const AttributeMetadata *attr_md =
+            object_info->get_attr_metadata(ita.attr_id);
+        if (attr_md == NULL) {
+          switch_log(SWITCH_API_LEVEL_ERROR,
+                     SWITCH_OT_NONE,
+                     "{}.{}: Failed to query attribute metadata for object:{} "
+                     "type:{} attr:{}. Skipping this attribute for db save",
+                     __func__,
+                     __LINE__,
+                     oid,
+                     object_type,
+                     ita.attr_id);
+          continue;
+        }
+        const switch_attribute_value_t &value = ita.get_value();
+        snapshot_attr_t rec = {};
+        rec.attr_name = string_id(attr_md->get_attr_name_fqn());
+        rec.extra = ita.extra;
+        rec.type = static_cast<uint8_t>(value.type);
+        if (value.type == SWITCH_TYPE_LIST) {
+          rec.list_type = static_cast<uint8_t>(value.list.list_type);
+          rec.data[0] = value.list.count;
+        } else {
+          memcpy(rec.data, &value, DB_SNAPSHOT_VALUE_SIZE);
+        }
+        if (value.type == SWITCH_TYPE_ENUM) {
+          auto value_md = attr_md->get_value_metadata();
+          for (const auto &enum_md : value_md->get_enum_metadata()) {
+            if (enum_md.enum_value == value.enumdata.enumdata) {
+              rec.ref_name = string_id(enum_md.enum_name_fqn);
+              break;
+            }
+          }
+        } else if (value.type == SWITCH_TYPE_OBJECT_ID) {
+          const ObjectInfo *ref_info = model_info->get_object_info(
+              switch_store::object_type_query(value.oid));
+          rec.ref_name = string_id(ref_info ? ref_info->get_object_name_fqn()
+                                            : "SWITCH_OBJECT_TYPE_NONE");
+          // same creation dependencies db_load_text derives
+          switch_attr_flags_t flags = attr_md->get_flags();
+          if (!is_device && attr_md->type == SWITCH_TYPE_OBJECT_ID &&
+              !flags.is_internal && !flags.is_read_only) {
+            topo.addEdge(oid, value.oid);
+          }
+        }
+        attrs.push_back(rec);
+      }
+
+      snapshot_object_t obj = {};
+      obj.oid = oid.data;
+      obj.type_name = string_id(object_info->get_object_name_fqn());
+      obj.attr_count = static_cast<uint32_t>(attrs.size());
+      out.write(reinterpret_cast<const char *>(&obj), sizeof(obj));
+      out.write(reinterpret_cast<const char *>(attrs.data()),
+                attrs.size() * sizeof(snapshot_attr_t));
+      object_index[oid] = hdr.object_count++;
+      hdr.attr_count += obj.attr_count;
+    }
+  }
+  switch_store_unlock();
+
+  topo.goSort();
+  hdr.order_off = static_cast<uint64_t>(out.tellp());
+  for (const auto &oid : order) {
+    auto it = object_index.find(oid);
+    if (it == object_index.end()) continue;
+    out.write(reinterpret_cast<const char *>(&it->second), sizeof(uint32_t));
+    hdr.order_count++;
+  }
+
+  hdr.strings_off = static_cast<uint64_t>(out.tellp());
+  hdr.string_count = static_cast<uint32_t>(strings.size());
+  uint32_t string_off = hdr.string_count * sizeof(uint32_t);
+  for (const auto &name : strings) {
+    out.write(reinterpret_cast<const char *>(&string_off), sizeof(string_off));
+    string_off += static_cast<uint32_t>(name.size() + 1);
+  }
+  for (const auto &name : strings) out.write(name.c_str(), name.size() + 1);
+
+  hdr.magic = DB_SNAPSHOT_MAGIC;
+  hdr.version = DB_SNAPSHOT_VERSION;
+  hdr.file_size = static_cast<uint64_t>(out.tellp());
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+  out.close();
+  if (!out) {
+    switch_log(SWITCH_API_LEVEL_ERROR,
+               SWITCH_OT_NONE,
+               "db_write: Failed to write {}",
+               out_file.c_str());
+    return SWITCH_STATUS_FAILURE;
+  }
+
+  switch_log(SWITCH_API_LEVEL_WARN,
+             SWITCH_OT_NONE,
+             "db_write: Snapshot flushed to persistent storage at {}",
+             out_file.c_str());
+  switch_log(SWITCH_API_LEVEL_WARN,
+             SWITCH_OT_NONE,
+             "db_write: Total records written to persistent storage {}",
+             hdr.object_count);
+
+  return SWITCH_STATUS_SUCCESS;
+}
+
+/*
+ * Checks the layout of a mapped snapshot, the records are accessed in place
+ * so every section has to be within the file before db_load_snapshot_image
+ * touches it
+ */
+bool snapshot_valid(const uint8_t *base, size_t size) {
+  if (size < sizeof(snapshot_header_t)) return false;
+  const snapshot_header_t *hdr =
+      reinterpret_cast<const snapshot_header_t *>(base);
+  if (hdr->magic != DB_SNAPSHOT_MAGIC) return false;
+  if (hdr->version != DB_SNAPSHOT_VERSION) return false;
+  if (hdr->file_size != size) return false;
+  if (hdr->objects_off != sizeof(snapshot_header_t)) return false;
+  if (hdr->order_off < hdr->objects_off) return false;
+  if (hdr->order_off + hdr->order_count * sizeof(uint32_t) !=
+      hdr->strings_off) {
+    return false;
+  }
+  if (hdr->string_count == 0) return false;
+  if (hdr->strings_off + hdr->string_count * sizeof(uint32_t) >= size) {
+    return false;
+  }
+  // all strings are NUL terminated when the last byte is
+  if (base[size - 1] != '\0') return false;
+  const uint32_t *string_offs =
+      reinterpret_cast<const uint32_t *>(base + hdr->strings_off);
+  for (uint32_t i = 0; i < hdr->string_count; i++) {
+    if (hdr->strings_off + string_offs[i] >= size) return false;
+  }
+  return true;
+}
+
+switch_status_t db_load_snapshot_image(const uint8_t *base,
+                                       ModelInfo *model_info) {
+  switch_status_t status = SWITCH_STATUS_SUCCESS;
+  uint64_t num_records = 0;
+  const snapshot_header_t *hdr =
+      reinterpret_cast<const snapshot_header_t *>(base);
+  const uint32_t *string_offs =
+      reinterpret_cast<const uint32_t *>(base + hdr->strings_off);
+  const char *strings = reinterpret_cast<const char *>(string_offs);
+
+  // names are resolved on first use, -1 is not looked up yet
+  std::vector<int64_t> name_ids(hdr->string_count, -1);
+  auto name_to_id = [&](uint32_t name) -> uint64_t {
+    if (name >= hdr->string_count) return 0;
+    if (name_ids[name] < 0) {
+      name_ids[name] = static_cast<int64_t>(
+          model_info->get_id_from_name(strings + string_offs[name]));
+    }
+    return static_cast<uint64_t>(name_ids[name]);
+  };
+  std::unordered_map<uint32_t, uint64_t> enum_values;
+  auto enum_to_value = [&](uint32_t name, const AttributeMetadata *attr_md) {
+    auto it = enum_values.find(name);
+    if (it != enum_values.end()) return it->second;
+    uint64_t enum_value = 0;
+    if (name < hdr->string_count) {
+      const char *enum_name = strings + string_offs[name];
+      auto value_md = attr_md->get_value_metadata();
+      for (const auto &enum_md : value_md->get_enum_metadata()) {
+        if (enum_md.enum_name_fqn.compare(enum_name) == 0) {
+          enum_value = enum_md.enum_value;
+          break;
+        }
+      }
+    }
+    enum_values.emplace(name, enum_value);
+    return enum_value;
+  };
+
+  // new object id of every snapshot object, {} if it was skipped
+  std::vector<switch_object_id_t> objects(hdr->object_count);
+  const uint8_t *cursor = base + hdr->objects_off;
+  const uint8_t *objects_end = base + hdr->order_off;
+  for (uint32_t i = 0; i < hdr->object_count; i++) {
+    if (cursor + sizeof(snapshot_object_t) > objects_end) {
+      status = SWITCH_STATUS_FAILURE;
+      break;
+    }
+    const snapshot_object_t *obj =
+        reinterpret_cast<const snapshot_object_t *>(cursor);
+    const snapshot_attr_t *recs =
+        reinterpret_cast<const snapshot_attr_t *>(cursor + sizeof(*obj));
+    cursor += sizeof(*obj) + obj->attr_count * sizeof(snapshot_attr_t);
+    if (cursor > objects_end) {
+      status = SWITCH_STATUS_FAILURE;
+      break;
+    }
+
+    // see db_load_text for the oid remapping
+    switch_object_type_t object_type =
+        static_cast<switch_object_type_t>(name_to_id(obj->type_name));
+    switch_object_id_t old_oid = {.data = obj->oid};
+    switch_object_id_t object = get_new_oid(old_oid, object_type);
+    const ObjectInfo *object_info = model_info->get_object_info(object_type);
+    if (object_info == NULL) {
+      switch_log(SWITCH_API_LEVEL_ERROR,
+                 SWITCH_OT_NONE,
+                 "{}.{}: Invalid object: {} type: {}",
+                 __func__,
+                 __LINE__,
+                 object,
+                 object_type);
+      continue;
+    }
+
+    attribute_map *db_ptr = object_create(object, object_info);
+    status = switch_store::oid_create(object_type, object, true);
+    if (status != SWITCH_STATUS_SUCCESS) {
+      switch_log(SWITCH_API_LEVEL_ERROR,
+                 object_type,
+                 "{}.{}: OID reserve fail for object: {} type: {}",
+                 __func__,
+                 __LINE__,
+                 object,
+                 object_type);
+      continue;
+    }
+    objects[i] = object;
+
+    for (uint32_t j = 0; j < obj->attr_count; j++) {
+      const snapshot_attr_t &rec = recs[j];
+      switch_attr_id_t attr_id =
+          static_cast<switch_attr_id_t>(name_to_id(rec.attr_name));
+      const AttributeMetadata *attr_md =
+          object_info->get_attr_metadata(attr_id);
+      if (attr_md == nullptr) {
+        switch_log(SWITCH_API_LEVEL_ERROR,
+                   object_type,
+                   "{}.{}: Invalid attribute ID: {} object: {} type: {}",
+                   __func__,
+                   __LINE__,
+                   attr_id,
+                   object,
+                   object_type);
+        continue;
+      }
+      switch_attribute_value_t value_in = {};
+      value_in.type = attr_md->type;
+      bool list_head = false;
+      if (attr_md->type == SWITCH_TYPE_LIST) {
+        const ValueMetadata *value_md = attr_md->get_value_metadata();
+        if (rec.extra == 0) {
+          list_head = true;
+          value_in.list.list_type = value_md->type;
+        } else {
+          value_in.type = value_md->type;
+        }
+      }
+      if (rec.type != value_in.type) {
+        switch_log(SWITCH_API_LEVEL_ERROR,
+                   object_type,
+                   "{}.{}: Type mismatch for attr: {} object: {} saved type: "
+                   "{} expected type: {}",
+                   __func__,
+                   __LINE__,
+                   attr_id,
+                   object,
+                   rec.type,
+                   value_in.type);
+        continue;
+      }
+
+      // if this is bf_rt_status, reset to 0
+      switch_attr_flags_t flags = attr_md->get_flags();
+      if (flags.is_status) {
+        // keep the zero value
+      } else if (list_head) {
+        value_in.list.count = rec.data[0];
+      } else {
+        memcpy(&value_in, rec.data, DB_SNAPSHOT_VALUE_SIZE);
+        if (value_in.type == SWITCH_TYPE_ENUM) {
+          value_in.enumdata.enumdata = enum_to_value(rec.ref_name, attr_md);
+        } else if (value_in.type == SWITCH_TYPE_OBJECT_ID) {
+          value_in.oid = get_new_oid(
+              value_in.oid,
+              static_cast<switch_object_type_t>(name_to_id(rec.ref_name)));
+        }
+      }
+
+      // list members are not preallocated by object_create
+      status = value_create(object, db_ptr, attr_id, rec.extra, value_in);
+      if (status != SWITCH_STATUS_SUCCESS)
+        status = value_set(object, attr_id, rec.extra, value_in);
+      if (status != SWITCH_STATUS_SUCCESS) {
+        switch_log(SWITCH_API_LEVEL_ERROR,
+                   object_type,
+                   "{}.{}: value_set fail for attr: {} object: {} "
+                   "type: {}",
+                   __func__,
+                   __LINE__,
+                   value_in,
+                   object,
+                   object_type);
+        continue;
+      }
+    }
+    num_records++;
+  }
+
+  const uint32_t *order =
+      reinterpret_cast<const uint32_t *>(base + hdr->order_off);
+  ordered_create_list.clear();
+  ordered_create_list.reserve(hdr->order_count);
+  for (uint32_t i = 0; i < hdr->order_count; i++) {
+    if (order[i] < hdr->object_count && objects[order[i]].data != 0)
+      ordered_create_list.push_back(objects[order[i]]);
+  }
+
+  switch_log(SWITCH_API_LEVEL_WARN,
+             SWITCH_OT_NONE,
+             "db_read: Total records read from persistent storage {}",
+             num_records);
+
+  return status;
+}
+
+switch_status_t db_load_snapshot(const std::string &in_file,
+                                 ModelInfo *model_info) {
+  struct stat st = {};
+  int fd = open(in_file.c_str(), O_RDONLY);
+  if (fd < 0) return SWITCH_STATUS_FAILURE;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return SWITCH_STATUS_FAILURE;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) return SWITCH_STATUS_FAILURE;
+  madvise(map, size, MADV_SEQUENTIAL);
+
+  switch_status_t status = SWITCH_STATUS_FAILURE;
+  const uint8_t *base = static_cast<const uint8_t *>(map);
+  if (snapshot_valid(base, size)) {
+    status = db_load_snapshot_image(base, model_info);
+  } else {
+    switch_log(SWITCH_API_LEVEL_ERROR,
+               SWITCH_OT_NONE,
+               "db_read: Invalid or truncated snapshot {}",
+               in_file.c_str());
+  }
+  munmap(map, size);
+  return status;
+}
+
+bool is_snapshot_file(const std::string &in_file) {
+  uint32_t magic = 0;
+  std::ifstream infile;
+  infile.open(in_file.c_str(), std::ifstream::binary);
+  infile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  return infile && magic == DB_SNAPSHOT_MAGIC;
+}
+
+/*
+ * Read each object from file and store to DB
+ * Parse the object_id first and reserve it in oid_store
+ * Then start adding each attribute to store
+ * Both the binary snapshot written by db_dump and the text format are accepted
+ */
+switch_status_t db_load(bool warm_init, const char *const warm_init_file) {
+  ModelInfo *model_info = NULL;
+
+  db_clear();
+  object_attr_hash = &store;
+
+  // nothing to load if not warm_init_mode
+  if (!warm_init) return SWITCH_STATUS_SUCCESS;
+  switch_log(
+      SWITCH_API_LEVEL_WARN, SWITCH_OT_NONE, "db_read: Warm boot initiated");
+
+  model_info = switch_store::switch_model_info_get();
+  if (model_info == nullptr) {
+    return SWITCH_STATUS_FAILURE;
+  }
+
+  std::string in_file = warm_init_file;
+  switch_log(SWITCH_API_LEVEL_WARN,
+             SWITCH_OT_NONE,
+             "db_read: Data reading from persistent storage at {}",
+             in_file.c_str());
+  if (is_snapshot_file(in_file)) return db_load_snapshot(in_file, model_info);
+  return db_load_text(in_file, model_info);
+}
+
 bool object_exists(const switch_object_id_t object_id) {
-  return (object_attr_hash->find(object_id) != object_attr_hash->end());
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, false);
+  return (shard.objects.find(object_id) != shard.objects.end());
 }
 
 switch_status_t object_delete(const switch_object_id_t object_id) {
@@ -760,19 +1308,17 @@ switch_status_t object_delete(const switch_object_id_t object_id) {
 
   // SWITCH_LOG_DEBUG("store: removing object %lx", object_id.data);
 
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  size_t erased = object_attr_hash->erase(object_id);
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  size_t erased = shard.objects.erase(object_id);
   CHECK_RET(erased != 1, SWITCH_STATUS_FAILURE);
+  // object_lock waiters return once their object is gone
+  if (shard.lock_waiters) shard.lock_cv.notify_all();
   return SWITCH_STATUS_SUCCESS;
 }
 
 attribute_map *object_create(const switch_object_id_t object_id,
                              const ObjectInfo *object_info) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-
-  // this creates an entry and returns the reference
-  attribute_map *attr_map = &(*object_attr_hash)[object_id];
-
   // reserve attr_count number of entries and assign to map
   // 1 extra for lock special attr
   const auto &attr_md_list = object_info->get_attribute_list();
@@ -791,6 +1337,11 @@ attribute_map *object_create(const switch_object_id_t object_id,
     object_attrs.emplace_back(
         attr_md.attr_id, static_cast<uint64_t>(0), value_in);
   }
+
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  // this creates an entry and returns the reference
+  attribute_map *attr_map = &shard.objects[object_id];
   attr_map->second = std::move(object_attrs);
 
   return attr_map;
@@ -799,15 +1350,14 @@ attribute_map *object_create(const switch_object_id_t object_id,
 switch_status_t object_create_with_attrs(
     const switch_object_id_t object_id,
     std::vector<value_wrapper> &object_attrs) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-
-  // this creates an entry and returns the reference
-  attribute_map *attr_map = &(*object_attr_hash)[object_id];
-
   switch_attribute_value_t value_in = {};
   object_attrs.emplace_back(
       SPECIAL_OBJECT_STATUS_ATTR_ID, static_cast<uint64_t>(0), value_in);
 
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  // this creates an entry and returns the reference
+  attribute_map *attr_map = &shard.objects[object_id];
   attr_map->second = std::move(object_attrs);
 
   return SWITCH_STATUS_SUCCESS;
@@ -824,11 +1374,12 @@ inline attribute_wrapper::iterator find_value_wrapper(
                                (object.extra == extra);
                       });
 }
-switch_status_t value_create(attribute_map *attr_map,
+switch_status_t value_create(const switch_object_id_t object_id,
+                             attribute_map *attr_map,
                              const switch_attr_id_t attr_id,
                              const uint64_t extra,
                              const switch_attribute_value_t &value_in) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
+  shard_guard guard(store.shard(object_id), true);
   auto ret = find_value_wrapper(attr_map, attr_id, extra);
   if (ret != attr_map->second.end())
     ret->set_value(value_in);
@@ -840,10 +1391,11 @@ switch_status_t value_create(attribute_map *attr_map,
 switch_status_t value_delete(const switch_object_id_t object_id,
                              const switch_attr_id_t attr_id,
                              const uint64_t extra) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  auto it = object_attr_hash->find(object_id);
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  auto it = shard.objects.find(object_id);
 
-  if (it == object_attr_hash->end()) {
+  if (it == shard.objects.end()) {
     switch_log(SWITCH_API_LEVEL_ERROR,
                switch_store::object_type_query(object_id),
                SMI_DELETE_OPERATION,
@@ -861,10 +1413,11 @@ switch_status_t value_set(const switch_object_id_t object_id,
                           const switch_attr_id_t attr_id,
                           const uint64_t extra,
                           const switch_attribute_value_t &value_in) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  auto it = object_attr_hash->find(object_id);
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  auto it = shard.objects.find(object_id);
 
-  if (it == object_attr_hash->end()) {
+  if (it == shard.objects.end()) {
     switch_log(SWITCH_API_LEVEL_ERROR,
                switch_store::object_type_query(object_id),
                SMI_DELETE_OPERATION,
@@ -885,10 +1438,11 @@ switch_status_t value_get(const switch_object_id_t object_id,
                           const switch_attr_id_t attr_id,
                           const uint64_t extra,
                           switch_attribute_value_t &value_out) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  auto it = object_attr_hash->find(object_id);
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, false);
+  auto it = shard.objects.find(object_id);
 
-  if (it == object_attr_hash->end()) {
+  if (it == shard.objects.end()) {
     switch_log(SWITCH_API_LEVEL_ERROR,
                switch_store::object_type_query(object_id),
                SMI_GET_OPERATION,
@@ -910,10 +1464,11 @@ switch_status_t value_get(const switch_object_id_t object_id,
 switch_status_t value_get_all(
     const switch_object_id_t object_id,
     std::vector<std::reference_wrapper<const switch_attribute_t>> &value_out) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  auto it = object_attr_hash->find(object_id);
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, false);
+  auto it = shard.objects.find(object_id);
 
-  if (it == object_attr_hash->end()) {
+  if (it == shard.objects.end()) {
     switch_log(SWITCH_API_LEVEL_ERROR,
                switch_store::object_type_query(object_id),
                SMI_GET_OPERATION,
@@ -931,46 +1486,69 @@ switch_status_t value_get_all(
   return SWITCH_STATUS_SUCCESS;
 }
 
-void switch_store_lock(void) { db_mtx.lock(); }
+/*
+ * Takes every shard exclusive, in index order so concurrent callers can't
+ * deadlock. Nested calls from the owning thread only bump the depth.
+ */
+void switch_store_lock(void) {
+  if (store_lock_depth++ != 0) return;
+  for (size_t i = 0; i < DB_STORE_SHARDS; i++) store.shard_at(i).mtx.lock();
+}
 
-void switch_store_unlock(void) { db_mtx.unlock(); }
+void switch_store_unlock(void) {
+  if (store_lock_depth == 0 || --store_lock_depth != 0) return;
+  for (size_t i = DB_STORE_SHARDS; i > 0; i--)
+    store.shard_at(i - 1).mtx.unlock();
+}
 
+/*
+ * Per object recursive lock kept in the special status attribute, value.u64 is
+ * the recursion count and lock_tid the owner. A thread finding the object
+ * locked by someone else sleeps on the shard condition variable instead of
+ * polling, object_unlock and object_delete wake it up.
+ * Returns -1 with the object locked, 0 if the object doesn't exist.
+ */
 int object_lock(const switch_object_id_t object_id) {
   pthread_t tid = pthread_self();
-  bool locked = false;
-  while (!locked) {
-    db_mtx.lock();
-    auto it = object_attr_hash->find(object_id);
-    if (it != object_attr_hash->end()) {
-      auto ret = find_value_wrapper(
-          &it->second,
-          static_cast<switch_attr_id_t>(SPECIAL_OBJECT_STATUS_ATTR_ID),
-          static_cast<uint64_t>(0));
-      if (ret != it->second.second.end()) {
-        switch_attribute_value_t &value = ret->get_value_mutable();
-        if (value.u64 != 0 && !pthread_equal(tid, ret->lock_tid)) {
-          db_mtx.unlock();
-          usleep(100);
-          continue;
-        } else {
-          ret->lock_tid = tid;
-          ++value.u64;
-          locked = true;
-        }
-      }
-    } else {
-      db_mtx.unlock();
-      return 0;
+  db_shard &shard = store.shard(object_id);
+  // under switch_store_lock the shard is already ours, the wait below still
+  // drops it so the owner of the object lock can get in and release it
+  std::unique_lock<std::shared_mutex> guard =
+      store_lock_depth ? std::unique_lock<std::shared_mutex>(shard.mtx,
+                                                             std::adopt_lock)
+                       : std::unique_lock<std::shared_mutex>(shard.mtx);
+  int rc = -1;
+  while (true) {
+    auto it = shard.objects.find(object_id);
+    if (it == shard.objects.end()) {
+      rc = 0;
+      break;
+    }
+    auto ret = find_value_wrapper(
+        &it->second,
+        static_cast<switch_attr_id_t>(SPECIAL_OBJECT_STATUS_ATTR_ID),
+        static_cast<uint64_t>(0));
+    if (ret == it->second.second.end()) break;
+    switch_attribute_value_t &value = ret->get_value_mutable();
+    if (value.u64 != 0 && !pthread_equal(tid, ret->lock_tid)) {
+      shard.lock_waiters++;
+      shard.lock_cv.wait(guard);
+      shard.lock_waiters--;
+      continue;
     }
-    db_mtx.unlock();
+    ret->lock_tid = tid;
+    ++value.u64;
+    break;
   }
-  return -1;
+  if (store_lock_depth) guard.release();
+  return rc;
 }
 
 void object_unlock(const switch_object_id_t object_id) {
-  std::lock_guard<std::recursive_mutex> guard(db_mtx);
-  auto it = object_attr_hash->find(object_id);
-  if (it != object_attr_hash->end()) {
+  db_shard &shard = store.shard(object_id);
+  shard_guard guard(shard, true);
+  auto it = shard.objects.find(object_id);
+  if (it != shard.objects.end()) {
     auto ret = find_value_wrapper(
         &it->second,
         static_cast<switch_attr_id_t>(SPECIAL_OBJECT_STATUS_ATTR_ID),
@@ -979,7 +1557,8 @@ void object_unlock(const switch_object_id_t object_id) {
       pthread_t tid = pthread_self();
       switch_attribute_value_t &value = ret->get_value_mutable();
       if (value.u64 != 0 && pthread_equal(tid, ret->lock_tid)) {
-        --value.u64;
+        if (--value.u64 == 0 && shard.lock_waiters)
+          shard.lock_cv.notify_all();
       }
     }
   }
@@ -21,7 +21,10 @@
 #ifndef S3_STORE_H__
 #define S3_STORE_H__
 
-#include <mutex>  // NOLINT(build/c++11)
+#include <mutex>               // NOLINT(build/c++11)
+#include <shared_mutex>        // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <array>
 #include <unordered_map>
 #include <map>
 #include <unordered_set>
@@ -32,6 +35,7 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 
 #include "bf_switch/bf_switch_types.h"
 #include "s3/attribute_util.h"
@@ -69,11 +73,13 @@ class secondaryIndex {
                              secondaryIndexKeyHasher>
       secIndex;
   std::vector<secIndex> si;
-  std::mutex mtx;
-  typedef std::lock_guard<std::mutex> LOCK_GUARD;
+  /* one lock per object type, lookups of different types never contend */
+  std::vector<std::shared_mutex> mtx;
+  typedef std::unique_lock<std::shared_mutex> WRITE_GUARD;
+  typedef std::shared_lock<std::shared_mutex> READ_GUARD;
 
  public:
-  secondaryIndex(size_t object_count) {
+  secondaryIndex(size_t object_count) : mtx(object_count) {
     si = std::vector<secIndex>(object_count);
     for (auto &secondary_index : si) {
       secondary_index.reserve(512);
@@ -81,31 +87,32 @@ class secondaryIndex {
   }
 
   void clear() {
-    LOCK_GUARD guard(mtx);
+    for (auto &type_mtx : mtx) type_mtx.lock();
     si.clear();
+    for (auto &type_mtx : mtx) type_mtx.unlock();
     return;
   }
 
   inline std::pair<secIndex::iterator, bool> insert(
       const std::vector<attr_w> &key, switch_object_id_t oid) {
-    LOCK_GUARD guard(mtx);
+    WRITE_GUARD guard(mtx[oid.data >> OBJECT_ID_WIDTH]);
     return si[oid.data >> OBJECT_ID_WIDTH].emplace(
         std::piecewise_construct, std::make_tuple(key), std::make_tuple(oid));
   }
 
   inline size_t erase(switch_object_type_t ot, const std::vector<attr_w> &key) {
-    LOCK_GUARD guard(mtx);
+    WRITE_GUARD guard(mtx[ot]);
     return si[ot].erase(key);
   }
 
   inline secIndex::iterator find(switch_object_type_t ot,
                                  const std::vector<attr_w> &key) {
-    LOCK_GUARD guard(mtx);
+    READ_GUARD guard(mtx[ot]);
     return si[ot].find(key);
   }
 
   inline secIndex::iterator end(switch_object_type_t ot) {
-    LOCK_GUARD guard(mtx);
+    READ_GUARD guard(mtx[ot]);
     return si[ot].end();
   }
 };
@@ -134,15 +141,19 @@ class objectGraph {
       objRefs;
   typedef std::unordered_map<uint64_t, objRefs> graph;
   std::vector<graph> refs;
-  std::mutex mtx;
-  typedef std::lock_guard<std::mutex> LOCK_GUARD;
+  /* one lock per type of the referenced object */
+  std::vector<std::shared_mutex> mtx;
+  typedef std::unique_lock<std::shared_mutex> WRITE_GUARD;
+  typedef std::shared_lock<std::shared_mutex> READ_GUARD;
 
  public:
-  objectGraph(size_t object_count) { refs = std::vector<graph>(object_count); }
+  objectGraph(size_t object_count) : mtx(object_count) {
+    refs = std::vector<graph>(object_count);
+  }
 
   const std::vector<object_and_attribute_t> &getRefs(
       const switch_object_id_t &dst, const switch_object_type_t src_type) {
-    LOCK_GUARD guard(mtx);
+    READ_GUARD guard(mtx[dst.data >> OBJECT_ID_WIDTH]);
     graph &ref = refs[dst.data >> OBJECT_ID_WIDTH];
     auto it = ref.find(dst.data);
     if (it != ref.end()) {
@@ -155,8 +166,9 @@ class objectGraph {
   }
 
   void clear() {
-    LOCK_GUARD guard(mtx);
+    for (auto &type_mtx : mtx) type_mtx.lock();
     refs.clear();
+    for (auto &type_mtx : mtx) type_mtx.unlock();
     return;
   }
 
@@ -164,7 +176,7 @@ class objectGraph {
               switch_object_type_t src_type,
               const switch_object_id_t &src,
               switch_attr_id_t src_attr_id) {
-    LOCK_GUARD guard(mtx);
+    WRITE_GUARD guard(mtx[dst.data >> OBJECT_ID_WIDTH]);
 
     refs[dst.data >> OBJECT_ID_WIDTH][dst.data][src_type].emplace_back(
         src, src_attr_id);
@@ -175,7 +187,7 @@ class objectGraph {
   size_t erase(const switch_object_id_t &dst,
                const switch_object_type_t src_type,
                const switch_object_id_t &src) {
-    LOCK_GUARD guard(mtx);
+    WRITE_GUARD guard(mtx[dst.data >> OBJECT_ID_WIDTH]);
 
     auto &ref = refs[dst.data >> OBJECT_ID_WIDTH][dst.data][src_type];
     size_t num = 1;
@@ -196,7 +208,7 @@ class objectGraph {
                const switch_object_type_t src_type,
                const switch_object_id_t &src,
                const switch_attr_id_t src_attr_id) {
-    LOCK_GUARD guard(mtx);
+    WRITE_GUARD guard(mtx[dst.data >> OBJECT_ID_WIDTH]);
 
     auto &ref = refs[dst.data >> OBJECT_ID_WIDTH][dst.data][src_type];
     size_t num = 1;
@@ -212,11 +224,11 @@ class objectGraph {
   }
 
   const graph::iterator find(const switch_object_id_t &oid) {
-    LOCK_GUARD guard(mtx);
+    READ_GUARD guard(mtx[oid.data >> OBJECT_ID_WIDTH]);
     return refs[oid.data >> OBJECT_ID_WIDTH].find(oid.data);
   }
   const graph::iterator end(const switch_object_id_t &oid) {
-    LOCK_GUARD guard(mtx);
+    READ_GUARD guard(mtx[oid.data >> OBJECT_ID_WIDTH]);
     return refs[oid.data >> OBJECT_ID_WIDTH].end();
   }
 };
@@ -287,7 +299,96 @@ struct KeyHasher {
  */
 typedef std::vector<value_wrapper> attribute_wrapper;
 typedef std::pair<uint64_t, attribute_wrapper> attribute_map;
-typedef std::unordered_map<switch_object_id_t, attribute_map> db_store;
+
+#define DB_STORE_SHARD_BITS 6
+#define DB_STORE_SHARDS (1 << DB_STORE_SHARD_BITS)
+
+/*
+ * One shard of the primary store. value_get/value_get_all and object_exists
+ * hold mtx shared, everything modifying the map or a value holds it exclusive.
+ * Threads waiting for an object lock owned by another thread sleep on
+ * lock_cv until object_unlock or object_delete wakes them up.
+ */
+struct db_shard {
+  std::shared_mutex mtx;
+  std::condition_variable_any lock_cv;
+  uint32_t lock_waiters = 0;
+  std::unordered_map<switch_object_id_t, attribute_map> objects;
+};
+
+/*
+ * The primary store, objects are spread over DB_STORE_SHARDS shards by a hash
+ * of the object id so API calls on unrelated objects don't serialize on one
+ * lock. Iterating the store is not synchronized, callers walk it only while
+ * no other thread modifies it (warm init, db_dump).
+ */
+class db_store {
+ public:
+  typedef std::unordered_map<switch_object_id_t, attribute_map> shard_map;
+
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef shard_map::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const shard_map::value_type *pointer;
+    typedef const shard_map::value_type &reference;
+
+    const_iterator(const db_store *store, size_t shard)
+        : store_(store), shard_(shard) {
+      seek();
+    }
+    const shard_map::value_type &operator*() const { return *it_; }
+    const shard_map::value_type *operator->() const { return &*it_; }
+    const_iterator &operator++() {
+      if (++it_ == store_->shards_[shard_].objects.end()) {
+        shard_++;
+        seek();
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    bool operator==(const const_iterator &other) const {
+      return shard_ == other.shard_ &&
+             (shard_ == DB_STORE_SHARDS || it_ == other.it_);
+    }
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    /* move to the first object at or after the current shard */
+    void seek() {
+      for (; shard_ < DB_STORE_SHARDS; shard_++) {
+        it_ = store_->shards_[shard_].objects.begin();
+        if (it_ != store_->shards_[shard_].objects.end()) return;
+      }
+    }
+    const db_store *store_;
+    size_t shard_;
+    shard_map::const_iterator it_;
+  };
+
+  /* fibonacci hash, mixes both the object type and the id bits of the oid */
+  static inline size_t shard_index(const switch_object_id_t object_id) {
+    return static_cast<size_t>((object_id.data * 0x9E3779B97F4A7C15ULL) >>
+                               (64 - DB_STORE_SHARD_BITS));
+  }
+  inline db_shard &shard(const switch_object_id_t object_id) {
+    return shards_[shard_index(object_id)];
+  }
+  inline db_shard &shard_at(size_t index) { return shards_[index]; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, DB_STORE_SHARDS); }
+
+ private:
+  std::array<db_shard, DB_STORE_SHARDS> shards_;
+};
 
 const db_store *get_db();
 switch_status_t db_load(bool warm_init, const char *const warm_init_file);
@@ -296,6 +397,7 @@ switch_status_t db_clear();
 switch_status_t db_print(bool stats_cache_only);
 #endif
 switch_status_t db_dump(const char *const dump_file);
+switch_status_t db_dump_text(const char *const dump_file);
 const std::vector<switch_object_id_t> &get_creation_list();
 
 void switch_store_lock(void);
@@ -323,7 +425,8 @@ switch_status_t object_create_with_attrs(
     std::vector<value_wrapper> &object_attrs);
 switch_status_t object_delete(const switch_object_id_t object_id);
 
-switch_status_t value_create(attribute_map *attr_map,
+switch_status_t value_create(const switch_object_id_t object_id,
+                             attribute_map *attr_map,
                              const switch_attr_id_t attr_id,
                              const uint64_t extra,
                              const switch_attribute_value_t &value_in);
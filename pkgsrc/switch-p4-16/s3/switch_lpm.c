@@ -38,21 +38,400 @@ static inline switch_status_t switch_trie_node_allocate(
   return status;
 }
 
+static inline bool switch_tbm_bit_test(const uint64_t *bitmap, unsigned bit) {
+  return (bitmap[bit >> 6] >> (bit & 63)) & 1;
+}
+
+static inline void switch_tbm_bit_set(uint64_t *bitmap, unsigned bit) {
+  bitmap[bit >> 6] |= 1ULL << (bit & 63);
+}
+
+static inline void switch_tbm_bit_clear(uint64_t *bitmap, unsigned bit) {
+  bitmap[bit >> 6] &= ~(1ULL << (bit & 63));
+}
+
+/* Number of bits set below bit, i.e. the slot in the compressed array */
+static inline unsigned switch_tbm_rank(const uint64_t *bitmap, unsigned bit) {
+  unsigned rank = 0;
+  unsigned i;
+
+  for (i = 0; i < (bit >> 6); i++) {
+    rank += (unsigned)__builtin_popcountll(bitmap[i]);
+  }
+  if (bit & 63) {
+    rank += (unsigned)__builtin_popcountll(bitmap[i] &
+                                           ((1ULL << (bit & 63)) - 1));
+  }
+  return rank;
+}
+
+static inline unsigned switch_tbm_internal_bit(unsigned prefix_length,
+                                               byte_t byte) {
+  return prefix_length
+             ? (1U << prefix_length) - 1 + (byte >> (8 - prefix_length))
+             : 0;
+}
+
+/*
+ * Make room for one more element. Single inserts grow to the exact size so
+ * the trie stays compact, bulk loads double and get compacted at the end.
+ */
+static switch_status_t switch_tbm_array_grow(void **array,
+                                             uint16_t *cap,
+                                             uint16_t num,
+                                             uint16_t limit,
+                                             size_t elem_size,
+                                             bool bulk) {
+  uint16_t new_cap = num + 1;
+  void *new_array = NULL;
+
+  if (*cap > num) return SWITCH_STATUS_SUCCESS;
+
+  if (bulk) {
+    new_cap = *cap ? *cap * 2 : 2;
+    if (new_cap > limit) new_cap = limit;
+  }
+
+  new_array = realloc(*array, new_cap * elem_size);
+  if (!new_array) return SWITCH_STATUS_NO_MEMORY;
+
+  *array = new_array;
+  *cap = new_cap;
+  return SWITCH_STATUS_SUCCESS;
+}
+
+static void switch_tbm_array_fit(void **array,
+                                 uint16_t *cap,
+                                 uint16_t num,
+                                 size_t elem_size) {
+  void *new_array = NULL;
+
+  if (*cap == num) return;
+
+  if (num == 0) {
+    free(*array);
+    *array = NULL;
+    *cap = 0;
+    return;
+  }
+
+  /* shrinking in place is fine if realloc can not move the block */
+  new_array = realloc(*array, num * elem_size);
+  if (!new_array) return;
+
+  *array = new_array;
+  *cap = num;
+}
+
+static void switch_tbm_node_free(switch_tbm_node_t *node) {
+  uint16_t i;
+
+  for (i = 0; i < node->child_num; i++) {
+    switch_tbm_node_free(&node->children[i]);
+  }
+  free(node->children);
+  free(node->results);
+}
+
+static void switch_tbm_node_compact(switch_tbm_node_t *node) {
+  uint16_t i;
+
+  for (i = 0; i < node->child_num; i++) {
+    switch_tbm_node_compact(&node->children[i]);
+  }
+  switch_tbm_array_fit((void **)&node->children,
+                       &node->child_cap,
+                       node->child_num,
+                       sizeof(switch_tbm_node_t));
+  switch_tbm_array_fit((void **)&node->results,
+                       &node->result_cap,
+                       node->result_num,
+                       sizeof(value_t));
+}
+
+static size_t switch_tbm_node_memory(const switch_tbm_node_t *node) {
+  size_t bytes = node->child_cap * sizeof(switch_tbm_node_t) +
+                 node->result_cap * sizeof(value_t);
+  uint16_t i;
+
+  for (i = 0; i < node->child_num; i++) {
+    bytes += switch_tbm_node_memory(&node->children[i]);
+  }
+  return bytes;
+}
+
+static switch_tbm_node_t *switch_tbm_child_get(const switch_tbm_node_t *node,
+                                               byte_t byte) {
+  if (!switch_tbm_bit_test(node->external, byte)) return NULL;
+  return &node->children[switch_tbm_rank(node->external, byte)];
+}
+
+static switch_status_t switch_tbm_child_add(switch_tbm_node_t *node,
+                                            byte_t byte,
+                                            bool bulk,
+                                            switch_tbm_node_t **child) {
+  unsigned slot = switch_tbm_rank(node->external, byte);
+  switch_status_t status = SWITCH_STATUS_SUCCESS;
+
+  status = switch_tbm_array_grow((void **)&node->children,
+                                 &node->child_cap,
+                                 node->child_num,
+                                 SWITCH_TBM_EXTERNAL_BITS,
+                                 sizeof(switch_tbm_node_t),
+                                 bulk);
+  if (status != SWITCH_STATUS_SUCCESS) return status;
+
+  memmove(&node->children[slot + 1],
+          &node->children[slot],
+          (node->child_num - slot) * sizeof(switch_tbm_node_t));
+  memset(&node->children[slot], 0x0, sizeof(switch_tbm_node_t));
+  switch_tbm_bit_set(node->external, byte);
+  node->child_num++;
+
+  *child = &node->children[slot];
+  return status;
+}
+
+static void switch_tbm_child_remove(switch_tbm_node_t *node,
+                                    byte_t byte,
+                                    bool shrink) {
+  unsigned slot = switch_tbm_rank(node->external, byte);
+
+  switch_tbm_node_free(&node->children[slot]);
+  memmove(&node->children[slot],
+          &node->children[slot + 1],
+          (node->child_num - slot - 1) * sizeof(switch_tbm_node_t));
+  switch_tbm_bit_clear(node->external, byte);
+  node->child_num--;
+
+  if (shrink) {
+    switch_tbm_array_fit((void **)&node->children,
+                         &node->child_cap,
+                         node->child_num,
+                         sizeof(switch_tbm_node_t));
+  }
+}
+
+/*
+ * Walk down to the node holding the prefix, creating missing nodes when
+ * create is set. path records the nodes and bytes taken for delete.
+ */
+static switch_tbm_node_t *switch_tbm_prefix_node_get(
+    const switch_lpm_trie_t *trie,
+    const uint8_t **prefix,
+    size_t *prefix_length,
+    bool create,
+    bool bulk,
+    switch_tbm_node_t **path,
+    byte_t *path_bytes,
+    size_t *depth) {
+  switch_tbm_node_t *node = trie->tbm_root;
+  switch_tbm_node_t *child = NULL;
+  byte_t byte;
+
+  if (depth) *depth = 0;
+
+  while (*prefix_length > 8) {
+    byte = (byte_t)**prefix;
+    child = switch_tbm_child_get(node, byte);
+    if (!child) {
+      if (!create) return NULL;
+      if (switch_tbm_child_add(node, byte, bulk, &child) !=
+          SWITCH_STATUS_SUCCESS) {
+        return NULL;
+      }
+    }
+
+    if (path) {
+      path[*depth] = node;
+      path_bytes[*depth] = byte;
+      (*depth)++;
+    }
+
+    (*prefix)++;
+    *prefix_length -= 8;
+    node = child;
+  }
+
+  return node;
+}
+
+static switch_status_t switch_tbm_insert(switch_lpm_trie_t *trie,
+                                         const uint8_t *prefix,
+                                         size_t prefix_length,
+                                         const value_t value,
+                                         bool bulk) {
+  switch_tbm_node_t *node = NULL;
+  unsigned bit, slot;
+  switch_status_t status = SWITCH_STATUS_SUCCESS;
+
+  if (prefix_length > trie->key_width_bytes * 8) {
+    return SWITCH_STATUS_INVALID_PARAMETER;
+  }
+
+  node = switch_tbm_prefix_node_get(
+      trie, &prefix, &prefix_length, true, bulk, NULL, NULL, NULL);
+  if (!node) return SWITCH_STATUS_NO_MEMORY;
+
+  bit = switch_tbm_internal_bit((unsigned)prefix_length,
+                                prefix_length ? (byte_t)*prefix : 0);
+  slot = switch_tbm_rank(node->internal, bit);
+  if (switch_tbm_bit_test(node->internal, bit)) {
+    node->results[slot] = value;
+    return status;
+  }
+
+  status = switch_tbm_array_grow((void **)&node->results,
+                                 &node->result_cap,
+                                 node->result_num,
+                                 SWITCH_TBM_INTERNAL_BITS,
+                                 sizeof(value_t),
+                                 bulk);
+  if (status != SWITCH_STATUS_SUCCESS) return status;
+
+  memmove(&node->results[slot + 1],
+          &node->results[slot],
+          (node->result_num - slot) * sizeof(value_t));
+  node->results[slot] = value;
+  switch_tbm_bit_set(node->internal, bit);
+  node->result_num++;
+
+  trie->num_entries++;
+  return status;
+}
+
+static bool switch_tbm_has_prefix(const switch_lpm_trie_t *trie,
+                                  const uint8_t *prefix,
+                                  size_t prefix_length) {
+  const switch_tbm_node_t *node = NULL;
+
+  if (prefix_length > trie->key_width_bytes * 8) return false;
+
+  node = switch_tbm_prefix_node_get(
+      trie, &prefix, &prefix_length, false, false, NULL, NULL, NULL);
+  if (!node) return false;
+
+  return switch_tbm_bit_test(
+      node->internal,
+      switch_tbm_internal_bit((unsigned)prefix_length,
+                              prefix_length ? (byte_t)*prefix : 0));
+}
+
+/*
+ * One node per key byte, the longest match inside a node is found by probing
+ * the 8 candidate bits from the longest length down. Only the node and bit of
+ * the best match are remembered, the popcount is paid once at the end.
+ */
+static switch_status_t switch_tbm_lookup(const switch_lpm_trie_t *trie,
+                                         const uint8_t *key,
+                                         value_t *pvalue) {
+  const switch_tbm_node_t *node = trie->tbm_root;
+  const switch_tbm_node_t *best_node = NULL;
+  unsigned best_bit = 0;
+  size_t key_width = trie->key_width_bytes;
+  byte_t byte;
+  unsigned len, bit;
+
+  if (switch_tbm_bit_test(node->internal, 0)) best_node = node;
+
+  while (key_width > 0) {
+    byte = (byte_t)*key;
+    for (len = 8; len > 0; len--) {
+      bit = (1U << len) - 1 + (byte >> (8 - len));
+      if (switch_tbm_bit_test(node->internal, bit)) {
+        best_node = node;
+        best_bit = bit;
+        break;
+      }
+    }
+
+    if (!switch_tbm_bit_test(node->external, byte)) break;
+    node = &node->children[switch_tbm_rank(node->external, byte)];
+    key++;
+    key_width--;
+  }
+
+  if (!best_node) return SWITCH_STATUS_ITEM_NOT_FOUND;
+
+  *pvalue = best_node->results[switch_tbm_rank(best_node->internal, best_bit)];
+  return SWITCH_STATUS_SUCCESS;
+}
+
+static switch_status_t switch_tbm_delete(switch_lpm_trie_t *trie,
+                                         const uint8_t *prefix,
+                                         size_t prefix_length) {
+  switch_tbm_node_t *path[64];
+  byte_t path_bytes[64];
+  size_t depth = 0;
+  switch_tbm_node_t *node = NULL;
+  unsigned bit, slot;
+
+  if (prefix_length > trie->key_width_bytes * 8) return SWITCH_STATUS_FAILURE;
+
+  node = switch_tbm_prefix_node_get(
+      trie, &prefix, &prefix_length, false, false, path, path_bytes, &depth);
+  if (!node) return SWITCH_STATUS_FAILURE;
+
+  bit = switch_tbm_internal_bit((unsigned)prefix_length,
+                                prefix_length ? (byte_t)*prefix : 0);
+  if (!switch_tbm_bit_test(node->internal, bit)) return SWITCH_STATUS_FAILURE;
+
+  slot = switch_tbm_rank(node->internal, bit);
+  memmove(&node->results[slot],
+          &node->results[slot + 1],
+          (node->result_num - slot - 1) * sizeof(value_t));
+  switch_tbm_bit_clear(node->internal, bit);
+  node->result_num--;
+
+  if (trie->release_memory) {
+    switch_tbm_array_fit((void **)&node->results,
+                         &node->result_cap,
+                         node->result_num,
+                         sizeof(value_t));
+    while (depth > 0 && node->result_num == 0 && node->child_num == 0) {
+      depth--;
+      node = path[depth];
+      switch_tbm_child_remove(node, path_bytes[depth], true);
+    }
+  }
+
+  trie->num_entries--;
+  return SWITCH_STATUS_SUCCESS;
+}
+
 switch_status_t switch_lpm_trie_create(size_t key_width_bytes,
                                        bool auto_shrink,
                                        switch_lpm_trie_t **trie) {
+  return switch_lpm_trie_engine_create(
+      key_width_bytes, auto_shrink, SWITCH_LPM_TRIE_ENGINE_JUDY, trie);
+}
+
+switch_status_t switch_lpm_trie_engine_create(size_t key_width_bytes,
+                                              bool auto_shrink,
+                                              switch_lpm_trie_engine_t engine,
+                                              switch_lpm_trie_t **trie) {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
   assert(key_width_bytes <= 64);
 
-  *trie = malloc(sizeof(switch_lpm_trie_t));
+  *trie = calloc(1, sizeof(switch_lpm_trie_t));
   if (!(*trie)) {
     status = SWITCH_STATUS_NO_MEMORY;
     return status;
   }
 
-  status = switch_trie_node_allocate(&(*trie)->root);
-  assert(status == SWITCH_STATUS_SUCCESS);
+  if (engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    (*trie)->tbm_root = calloc(1, sizeof(switch_tbm_node_t));
+    if (!(*trie)->tbm_root) {
+      free(*trie);
+      *trie = NULL;
+      return SWITCH_STATUS_NO_MEMORY;
+    }
+  } else {
+    status = switch_trie_node_allocate(&(*trie)->root);
+    assert(status == SWITCH_STATUS_SUCCESS);
+  }
 
+  (*trie)->engine = engine;
   (*trie)->key_width_bytes = key_width_bytes;
   (*trie)->release_memory = auto_shrink;
   (*trie)->num_entries = 0;
@@ -69,6 +448,35 @@ size_t switch_lpm_trie_size(switch_lpm_trie_t *trie) {
   return trie->num_entries;
 }
 
+static size_t switch_trie_node_memory(const switch_trie_node_t *node) {
+  Word_t index = 0;
+  Word_t *pnode = NULL;
+  Word_t bytes;
+  size_t total = sizeof(switch_trie_node_t);
+
+  JLMU(bytes, node->PJLarray_branches);
+  total += bytes;
+  JLMU(bytes, node->PJLarray_prefixes);
+  total += bytes;
+
+  JLF(pnode, node->PJLarray_branches, index);
+  while (pnode != NULL) {
+    total += switch_trie_node_memory((switch_trie_node_t *)*pnode);
+    JLN(pnode, node->PJLarray_branches, index);
+  }
+  return total;
+}
+
+size_t switch_lpm_trie_memory_usage(const switch_lpm_trie_t *trie) {
+  if (!trie) return 0;
+
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    return sizeof(switch_lpm_trie_t) + sizeof(switch_tbm_node_t) +
+           switch_tbm_node_memory(trie->tbm_root);
+  }
+  return sizeof(switch_lpm_trie_t) + switch_trie_node_memory(trie->root);
+}
+
 switch_status_t switch_trie_node_destroy(switch_trie_node_t *node) {
   Word_t index = 0;
   Word_t *pnode = NULL;
@@ -93,6 +501,13 @@ switch_status_t switch_trie_node_destroy(switch_trie_node_t *node) {
 switch_status_t switch_lpm_trie_destroy(switch_lpm_trie_t *trie) {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
 
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    switch_tbm_node_free(trie->tbm_root);
+    free(trie->tbm_root);
+    free(trie);
+    return status;
+  }
+
   status = switch_trie_node_destroy(trie->root);
   assert(status == SWITCH_STATUS_SUCCESS);
 
@@ -164,6 +579,10 @@ switch_status_t switch_lpm_trie_insert(switch_lpm_trie_t *trie,
   uint16_t prefix_key = 0;
   switch_status_t status = SWITCH_STATUS_SUCCESS;
 
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    return switch_tbm_insert(trie, prefix, prefix_length, value, false);
+  }
+
   while (prefix_length >= 8) {
     byte = (byte_t)*prefix;
     switch_trie_node_t *node = switch_trie_next_node_get(current_node, byte);
@@ -197,6 +616,35 @@ switch_status_t switch_lpm_trie_insert(switch_lpm_trie_t *trie,
   return status;
 }
 
+switch_status_t switch_lpm_trie_bulk_insert(
+    switch_lpm_trie_t *trie,
+    const switch_lpm_trie_entry_t *entries,
+    size_t count) {
+  switch_status_t status = SWITCH_STATUS_SUCCESS;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+      status = switch_tbm_insert(trie,
+                                 entries[i].prefix,
+                                 entries[i].prefix_length,
+                                 entries[i].value,
+                                 true);
+    } else {
+      status = switch_lpm_trie_insert(trie,
+                                      entries[i].prefix,
+                                      entries[i].prefix_length,
+                                      entries[i].value);
+    }
+    if (status != SWITCH_STATUS_SUCCESS) break;
+  }
+
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    switch_tbm_node_compact(trie->tbm_root);
+  }
+  return status;
+}
+
 bool switch_lpm_trie_has_prefix(const switch_lpm_trie_t *trie,
                                 const uint8_t *prefix,
                                 size_t prefix_length) {
@@ -204,6 +652,10 @@ bool switch_lpm_trie_has_prefix(const switch_lpm_trie_t *trie,
   byte_t byte = 0;
   uint16_t prefix_key = 0;
 
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    return switch_tbm_has_prefix(trie, prefix, prefix_length);
+  }
+
   while (prefix_length >= 8) {
     byte = (byte_t)*prefix;
     switch_trie_node_t *node = switch_trie_next_node_get(current_node, byte);
@@ -232,6 +684,10 @@ switch_status_t switch_lpm_trie_lookup(const switch_lpm_trie_t *trie,
   unsigned i;
   switch_status_t status = SWITCH_STATUS_ITEM_NOT_FOUND;
 
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    return switch_tbm_lookup(trie, key, pvalue);
+  }
+
   while (current_node) {
     pdata = switch_trie_prefix_ptr_get(current_node, 0);
     if (pdata) {
@@ -270,6 +726,10 @@ switch_status_t switch_lpm_trie_delete(switch_lpm_trie_t *trie,
   uint16_t prefix_key = 0;
   value_t *pdata = NULL;
 
+  if (trie->engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    return switch_tbm_delete(trie, prefix, prefix_length);
+  }
+
   while (prefix_length >= 8) {
     byte = (byte_t)*prefix;
     switch_trie_node_t *node = switch_trie_next_node_get(current_node, byte);
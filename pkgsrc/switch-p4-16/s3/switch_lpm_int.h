@@ -42,19 +42,65 @@ typedef struct switch_trie_node_s {
   byte_t child_id;
 } switch_trie_node_t;
 
+/*
+ * Tree bitmap node, one key byte per level.
+ * internal holds the prefixes of length 0..8 ending in this node, bit
+ * (1 << len) - 1 + (byte >> (8 - len)). Length 0 is only used by the root,
+ * deeper nodes store that prefix as length 8 in their parent.
+ * external has one bit per next byte value with a child below it.
+ * children and results are compressed, the slot of an entry is the number
+ * of bits set below its own bit in the matching bitmap.
+ */
+#define SWITCH_TBM_INTERNAL_BITS 511
+#define SWITCH_TBM_INTERNAL_WORDS 8
+#define SWITCH_TBM_EXTERNAL_BITS 256
+#define SWITCH_TBM_EXTERNAL_WORDS 4
+
+typedef struct switch_tbm_node_s {
+  uint64_t internal[SWITCH_TBM_INTERNAL_WORDS];
+  uint64_t external[SWITCH_TBM_EXTERNAL_WORDS];
+  struct switch_tbm_node_s *children;
+  value_t *results;
+  uint16_t child_num;
+  uint16_t child_cap;
+  uint16_t result_num;
+  uint16_t result_cap;
+} switch_tbm_node_t;
+
+typedef enum switch_lpm_trie_engine_e {
+  SWITCH_LPM_TRIE_ENGINE_JUDY,
+  SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP,
+} switch_lpm_trie_engine_t;
+
 typedef struct switch_lpm_trie_s {
+  switch_lpm_trie_engine_t engine;
   switch_trie_node_t *root;
+  switch_tbm_node_t *tbm_root;
   size_t key_width_bytes;
   bool release_memory;
   unsigned int num_entries;
 } switch_lpm_trie_t;
 
+typedef struct switch_lpm_trie_entry_s {
+  const uint8_t *prefix;
+  size_t prefix_length;
+  value_t value;
+} switch_lpm_trie_entry_t;
+
 switch_status_t switch_lpm_trie_create(size_t key_width_bytes,
                                        bool auto_shrink,
                                        switch_lpm_trie_t **trie);
 
+switch_status_t switch_lpm_trie_engine_create(size_t key_width_bytes,
+                                              bool auto_shrink,
+                                              switch_lpm_trie_engine_t engine,
+                                              switch_lpm_trie_t **trie);
+
 size_t switch_lpm_trie_size(switch_lpm_trie_t *trie);
 
+/* Bytes allocated for the trie, including the trie itself */
+size_t switch_lpm_trie_memory_usage(const switch_lpm_trie_t *trie);
+
 switch_status_t switch_lpm_trie_destroy(switch_lpm_trie_t *trie);
 
 switch_status_t switch_lpm_trie_insert(switch_lpm_trie_t *trie,
@@ -62,6 +108,16 @@ switch_status_t switch_lpm_trie_insert(switch_lpm_trie_t *trie,
                                        size_t prefix_length,
                                        const value_t value);
 
+/*
+ * Insert count entries, stops at the first failure. The tree bitmap engine
+ * grows node arrays geometrically during the load and compacts them once at
+ * the end instead of reallocating on every insert.
+ */
+switch_status_t switch_lpm_trie_bulk_insert(
+    switch_lpm_trie_t *trie,
+    const switch_lpm_trie_entry_t *entries,
+    size_t count);
+
 bool switch_lpm_trie_has_prefix(const switch_lpm_trie_t *trie,
                                 const uint8_t *prefix,
                                 size_t prefix_length);
@@ -191,7 +191,7 @@ switch_status_t object_info_init(const char *const object_info_path,
 }
 
 /*
- * Dump state to file
+ * Dump state to file as a binary snapshot for warm init
  */
 switch_status_t object_info_dump(const char *dump_file) {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
@@ -225,6 +225,21 @@ switch_status_t object_info_dump(const char *dump_file) {
   return SWITCH_STATUS_SUCCESS;
 }
 
+/*
+ * Dump state to file in the human readable text format, for debugging only.
+ * Warm init also accepts it but object_info_dump is much faster to restore
+ */
+switch_status_t object_info_dump_text(const char *dump_file) {
+  if (!dump_file) {
+    switch_log(SWITCH_API_LEVEL_ERROR,
+               SWITCH_OT_NONE,
+               "{}: dump_file is NULL",
+               __func__);
+    return SWITCH_STATUS_INVALID_PARAMETER;
+  }
+  return db::db_dump_text(dump_file);
+}
+
 switch_status_t object_info_clean() {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
 
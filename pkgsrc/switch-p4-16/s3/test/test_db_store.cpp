@@ -20,6 +20,8 @@
 #include <cassert>
 #include <iostream>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 #include "time.h"
 #include "../store.h"
@@ -47,6 +49,71 @@ void test_store(const std::vector<switch_object_id_t> &oids,
   std::cout << "Time: " << duration.count() << std::endl;
 }
 
+/*
+ * Mixed value_get/value_set load, every 8th op is a set. Each thread walks
+ * its own stride of the oids so the threads touch different objects like
+ * route, neighbor and fdb API threads would.
+ */
+void test_store_concurrent(const std::vector<switch_object_id_t> &oids,
+                           uint32_t num_threads) {
+  const uint64_t ops_per_thread = oids.size() / num_threads;
+  std::vector<std::thread> threads;
+  auto start = high_resolution_clock::now();
+  for (uint32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&oids, t, num_threads, ops_per_thread]() {
+      switch_attribute_value_t value = {};
+      value.type = SWITCH_TYPE_OBJECT_ID;
+      for (uint64_t i = 0; i < ops_per_thread; i++) {
+        const switch_object_id_t &oid = oids[i * num_threads + t];
+        switch_status_t status;
+        if (i % 8 == 0) {
+          value.oid = oid;
+          status = db::value_set(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 0, value);
+        } else {
+          status = db::value_get(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 0, value);
+        }
+        assert(status == SWITCH_STATUS_SUCCESS);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  auto end = high_resolution_clock::now();
+  auto duration = duration_cast<microseconds>(end - start);
+  std::cout << "Threads: " << num_threads
+            << " Ops: " << ops_per_thread * num_threads
+            << " Time: " << duration.count() << std::endl;
+}
+
+/*
+ * Threads increment a counter attribute of one object under object_lock, any
+ * lost update means two threads held the lock at the same time.
+ */
+void test_object_lock_concurrent(const switch_object_id_t oid,
+                                 uint32_t num_threads) {
+  const uint64_t incr_per_thread = 10000;
+  switch_attribute_value_t value = {};
+  value.type = SWITCH_TYPE_UINT64;
+  db::value_set(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 1, value);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([oid, incr_per_thread]() {
+      for (uint64_t i = 0; i < incr_per_thread; i++) {
+        switch_attribute_value_t counter = {};
+        assert(db::object_lock(oid) == -1);
+        db::value_get(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 1, counter);
+        counter.u64++;
+        db::value_set(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 1, counter);
+        db::object_unlock(oid);
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  db::value_get(oid, SWITCH_ROUTE_ATTR_NEXTHOP, 1, value);
+  assert(value.u64 == incr_per_thread * num_threads);
+}
+
 int main(void) {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
   const char *const test_model_name = TESTDATADIR "/test/replay.json";
@@ -78,6 +145,11 @@ int main(void) {
   ProfilerStop();
 #endif
 
+  for (uint32_t num_threads : {1, 2, 4, 8}) {
+    test_store_concurrent(oids, num_threads);
+  }
+  test_object_lock_concurrent(oids[0], 4);
+
   printf("\n\nAll tests passed!\n");
   return 0;
 }
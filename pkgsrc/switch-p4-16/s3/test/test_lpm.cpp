@@ -0,0 +1,323 @@
+/*******************************************************************************
+ *  Copyright (C) 2024 Intel Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions
+ *  and limitations under the License.
+ *
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bf_switch/bf_switch_types.h"
+#include "../log.h"
+#include "../switch_lpm_int.h"
+
+using namespace std;
+using namespace std::chrono;
+
+static const switch_lpm_trie_engine_t engines[] = {
+    SWITCH_LPM_TRIE_ENGINE_JUDY, SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP};
+
+static const char *engine_name(switch_lpm_trie_engine_t engine) {
+  return engine == SWITCH_LPM_TRIE_ENGINE_JUDY ? "judy" : "tree bitmap";
+}
+
+struct route {
+  uint8_t prefix[16];
+  size_t len;
+  value_t value;
+};
+
+static void mask_prefix(route &r, size_t width) {
+  for (size_t i = 0; i < width; i++) {
+    if (i * 8 >= r.len) {
+      r.prefix[i] = 0;
+    } else if (i * 8 + 8 > r.len) {
+      r.prefix[i] &= static_cast<uint8_t>(0xFF << (8 - (r.len - i * 8)));
+    }
+  }
+}
+
+static bool prefix_match(const route &r, const uint8_t *key) {
+  for (size_t i = 0; i * 8 < r.len; i++) {
+    size_t bits = r.len - i * 8 < 8 ? r.len - i * 8 : 8;
+    uint8_t mask = static_cast<uint8_t>(0xFF << (8 - bits));
+    if ((key[i] & mask) != r.prefix[i]) return false;
+  }
+  return true;
+}
+
+// Internet like length mix, mostly /24 for v4 and /48 for v6. v6 routes sit
+// under a pool of allocated /32s in 2000::/3 like real tables do.
+static vector<route> make_routes(size_t count, size_t width, uint32_t seed) {
+  std::mt19937 mt(seed);
+  vector<route> routes(count);
+  vector<uint32_t> blocks(count / 8 + 1);
+  for (auto &block : blocks) block = 0x20000000 | (mt() & 0x0FFFFFFF);
+  for (size_t i = 0; i < count; i++) {
+    route &r = routes[i];
+    for (size_t b = 0; b < width; b++) r.prefix[b] = mt() & 0xFF;
+    if (width == 16) {
+      uint32_t block = blocks[mt() % blocks.size()];
+      for (size_t b = 0; b < 4; b++) r.prefix[b] = (block >> (24 - b * 8));
+    }
+    uint32_t roll = mt() % 100;
+    if (width == 4) {
+      r.len = roll < 60 ? 24 : roll < 95 ? 16 + mt() % 8 : 8 + mt() % 25;
+    } else {
+      r.len = roll < 50 ? 48 : roll < 90 ? 32 + mt() % 17 : 16 + mt() % 113;
+    }
+    r.value = i + 1;
+    mask_prefix(r, width);
+  }
+  return routes;
+}
+
+void test_basic(switch_lpm_trie_engine_t engine) {
+  switch_lpm_trie_t *trie = NULL;
+  value_t value = 0;
+  uint8_t p[4] = {10, 0, 0, 0};
+  uint8_t k[4] = {10, 1, 2, 3};
+
+  assert(switch_lpm_trie_engine_create(4, true, engine, &trie) ==
+         SWITCH_STATUS_SUCCESS);
+  assert(switch_lpm_trie_lookup(trie, k, &value) ==
+         SWITCH_STATUS_ITEM_NOT_FOUND);
+
+  // default route, /8, /16, /23, /24 and /32
+  assert(switch_lpm_trie_insert(trie, p, 0, 100) == SWITCH_STATUS_SUCCESS);
+  assert(switch_lpm_trie_insert(trie, p, 8, 108) == SWITCH_STATUS_SUCCESS);
+  p[1] = 1;
+  assert(switch_lpm_trie_insert(trie, p, 16, 116) == SWITCH_STATUS_SUCCESS);
+  p[2] = 2;
+  assert(switch_lpm_trie_insert(trie, p, 23, 123) == SWITCH_STATUS_SUCCESS);
+  assert(switch_lpm_trie_insert(trie, p, 24, 124) == SWITCH_STATUS_SUCCESS);
+  p[3] = 3;
+  assert(switch_lpm_trie_insert(trie, p, 32, 132) == SWITCH_STATUS_SUCCESS);
+  assert(switch_lpm_trie_size(trie) == 6);
+
+  assert(switch_lpm_trie_has_prefix(trie, p, 32));
+  assert(switch_lpm_trie_has_prefix(trie, p, 23));
+  assert(!switch_lpm_trie_has_prefix(trie, p, 22));
+
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 132);
+  k[3] = 4;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 124);
+  k[2] = 3;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 123);
+  k[2] = 4;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 116);
+  k[1] = 2;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 108);
+  k[0] = 11;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 100);
+
+  // delete the /24, the /23 takes over
+  p[3] = 0;
+  assert(switch_lpm_trie_delete(trie, p, 24) == SWITCH_STATUS_SUCCESS);
+  assert(switch_lpm_trie_delete(trie, p, 24) == SWITCH_STATUS_FAILURE);
+  k[0] = 10;
+  k[1] = 1;
+  k[2] = 2;
+  assert(switch_lpm_trie_lookup(trie, k, &value) == SWITCH_STATUS_SUCCESS);
+  assert(value == 123);
+  assert(switch_lpm_trie_delete(trie, p, 0) == SWITCH_STATUS_SUCCESS);
+  k[0] = 11;
+  assert(switch_lpm_trie_lookup(trie, k, &value) ==
+         SWITCH_STATUS_ITEM_NOT_FOUND);
+  assert(switch_lpm_trie_size(trie) == 4);
+
+  assert(switch_lpm_trie_destroy(trie) == SWITCH_STATUS_SUCCESS);
+}
+
+// Both engines must agree with a linear longest prefix match
+void test_random(size_t width) {
+  const size_t num_routes = 5000;
+  vector<route> routes = make_routes(num_routes, width, 7);
+  switch_lpm_trie_t *tries[2] = {};
+  std::mt19937 mt(11);
+
+  for (int e = 0; e < 2; e++) {
+    assert(switch_lpm_trie_engine_create(width, true, engines[e], &tries[e]) ==
+           SWITCH_STATUS_SUCCESS);
+  }
+  // later duplicates replace the value, the reference keeps the last one
+  for (auto &r : routes) {
+    for (int e = 0; e < 2; e++) {
+      assert(switch_lpm_trie_insert(tries[e], r.prefix, r.len, r.value) ==
+             SWITCH_STATUS_SUCCESS);
+    }
+  }
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < 2000; i++) {
+      uint8_t key[16];
+      // half the keys are inside a route, the others random
+      if (i & 1) {
+        memcpy(key, routes[mt() % num_routes].prefix, width);
+        key[width - 1] ^= mt() & 0xFF;
+      } else {
+        for (size_t b = 0; b < width; b++) key[b] = mt() & 0xFF;
+      }
+
+      const route *best = NULL;
+      for (auto &r : routes) {
+        if (r.value == 0 || !prefix_match(r, key)) continue;
+        if (!best || r.len >= best->len) best = &r;
+      }
+      for (int e = 0; e < 2; e++) {
+        value_t value = 0;
+        switch_status_t status = switch_lpm_trie_lookup(tries[e], key, &value);
+        if (!best) {
+          assert(status == SWITCH_STATUS_ITEM_NOT_FOUND);
+        } else {
+          assert(status == SWITCH_STATUS_SUCCESS);
+          assert(value == best->value);
+        }
+      }
+    }
+
+    // drop every other route and check again
+    for (size_t i = 0; pass == 0 && i < num_routes; i += 2) {
+      route &r = routes[i];
+      if (!switch_lpm_trie_has_prefix(tries[1], r.prefix, r.len)) continue;
+      for (int e = 0; e < 2; e++) {
+        assert(switch_lpm_trie_delete(tries[e], r.prefix, r.len) ==
+               SWITCH_STATUS_SUCCESS);
+      }
+      for (auto &o : routes) {
+        if (o.len == r.len && !memcmp(o.prefix, r.prefix, width)) o.value = 0;
+      }
+    }
+  }
+
+  for (int e = 0; e < 2; e++) switch_lpm_trie_destroy(tries[e]);
+}
+
+void test_bulk_insert(switch_lpm_trie_engine_t engine) {
+  vector<route> routes = make_routes(20000, 4, 3);
+  vector<switch_lpm_trie_entry_t> entries;
+  switch_lpm_trie_t *bulk = NULL, *single = NULL;
+
+  for (auto &r : routes) entries.push_back({r.prefix, r.len, r.value});
+  switch_lpm_trie_engine_create(4, true, engine, &bulk);
+  switch_lpm_trie_engine_create(4, true, engine, &single);
+  assert(switch_lpm_trie_bulk_insert(bulk, entries.data(), entries.size()) ==
+         SWITCH_STATUS_SUCCESS);
+  for (auto &r : routes) {
+    switch_lpm_trie_insert(single, r.prefix, r.len, r.value);
+  }
+  assert(switch_lpm_trie_size(bulk) == switch_lpm_trie_size(single));
+  assert(switch_lpm_trie_memory_usage(bulk) ==
+         switch_lpm_trie_memory_usage(single));
+
+  for (auto &r : routes) {
+    value_t v1 = 0, v2 = 0;
+    assert(switch_lpm_trie_lookup(bulk, r.prefix, &v1) ==
+           SWITCH_STATUS_SUCCESS);
+    assert(switch_lpm_trie_lookup(single, r.prefix, &v2) ==
+           SWITCH_STATUS_SUCCESS);
+    assert(v1 == v2);
+  }
+
+  // a failed entry stops the load
+  uint8_t bad[4] = {};
+  switch_lpm_trie_entry_t entry = {bad, 33, 1};
+  if (engine == SWITCH_LPM_TRIE_ENGINE_TREE_BITMAP) {
+    assert(switch_lpm_trie_bulk_insert(bulk, &entry, 1) !=
+           SWITCH_STATUS_SUCCESS);
+  }
+
+  switch_lpm_trie_destroy(bulk);
+  switch_lpm_trie_destroy(single);
+}
+
+void perf_test(size_t width, size_t num_routes) {
+  vector<route> routes = make_routes(num_routes, width, 1);
+  vector<switch_lpm_trie_entry_t> entries;
+  vector<uint8_t> keys(num_routes * width);
+  std::mt19937 mt(5);
+
+  for (auto &r : routes) entries.push_back({r.prefix, r.len, r.value});
+  for (size_t i = 0; i < num_routes; i++) {
+    memcpy(&keys[i * width], routes[mt() % num_routes].prefix, width);
+    keys[i * width + width - 1] ^= mt() & 0xFF;
+  }
+
+  std::cout << "\n**** IPv" << (width == 4 ? 4 : 6) << " table, " << num_routes
+            << " prefixes ****" << std::endl;
+  for (auto engine : engines) {
+    switch_lpm_trie_t *trie = NULL;
+    value_t value = 0, sum = 0;
+
+    switch_lpm_trie_engine_create(width, true, engine, &trie);
+    auto start = steady_clock::now();
+    for (auto &r : routes) {
+      switch_lpm_trie_insert(trie, r.prefix, r.len, r.value);
+    }
+    auto insert = duration_cast<milliseconds>(steady_clock::now() - start);
+    size_t bytes = switch_lpm_trie_memory_usage(trie);
+    size_t prefixes = switch_lpm_trie_size(trie);
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < num_routes; i++) {
+      if (switch_lpm_trie_lookup(trie, &keys[i * width], &value) ==
+          SWITCH_STATUS_SUCCESS) {
+        sum += value;
+      }
+    }
+    auto lookup = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    start = steady_clock::now();
+    for (auto &r : routes) switch_lpm_trie_delete(trie, r.prefix, r.len);
+    auto del = duration_cast<milliseconds>(steady_clock::now() - start);
+    switch_lpm_trie_destroy(trie);
+
+    switch_lpm_trie_engine_create(width, true, engine, &trie);
+    start = steady_clock::now();
+    switch_lpm_trie_bulk_insert(trie, entries.data(), entries.size());
+    auto bulk = duration_cast<milliseconds>(steady_clock::now() - start);
+    switch_lpm_trie_destroy(trie);
+
+    std::cout << engine_name(engine) << ": insert " << insert.count()
+              << " ms, bulk insert " << bulk.count() << " ms, lookup "
+              << lookup.count() << " ms, delete " << del.count() << " ms, "
+              << bytes / 1024 << " KB, " << bytes / prefixes
+              << " bytes/prefix (checksum " << sum << ")" << std::endl;
+  }
+}
+
+int main() {
+  for (auto engine : engines) {
+    test_basic(engine);
+    test_bulk_insert(engine);
+  }
+  test_random(4);
+  test_random(16);
+
+  perf_test(4, 1000000);
+  perf_test(16, 200000);
+  return 0;
+}
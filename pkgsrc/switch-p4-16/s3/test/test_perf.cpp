@@ -31,6 +31,7 @@
 #include "gen-model/replay.h"
 #include "bf_switch/bf_switch_types.h"
 #include "../id_gen.h"
+#include "../store.h"
 #include "s3/attribute.h"
 #include "s3/attribute_util.h"
 #include "s3/switch_store.h"
@@ -429,6 +430,106 @@ void test_ids_perf() {
             << " Rate: " << total.rate_ << " Seconds: " << total.ms_ / 1000000
             << std::endl;
 }
+size_t store_object_count() {
+  const db::db_store *store = db::get_db();
+  return std::distance(store->begin(), store->end());
+}
+
+struct stored_value {
+  uint64_t oid;
+  switch_attr_id_t attr_id;
+  uint16_t extra;
+  switch_attribute_value_t value;
+
+  bool operator<(const stored_value &other) const {
+    if (oid != other.oid) return oid < other.oid;
+    if (attr_id != other.attr_id) return attr_id < other.attr_id;
+    return extra < other.extra;
+  }
+};
+
+/* every value in the store, sorted by object, attribute and list index */
+std::vector<stored_value> store_values() {
+  const db::db_store *store = db::get_db();
+  std::vector<stored_value> values;
+  for (const auto &object : *store) {
+    for (const auto &val : object.second.second) {
+      values.push_back(
+          {object.first.data, val.attr_id, val.extra, val.get_value()});
+    }
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+/* a list head only carries the element count, the elements are stored under
+ * their own list index. The object status attribute is untyped and keeps its
+ * state in u64, which operator== does not compare */
+bool store_value_equal(const switch_attribute_value_t &lhs,
+                       const switch_attribute_value_t &rhs) {
+  if (lhs.type != rhs.type) return false;
+  if (lhs.type == SWITCH_TYPE_LIST) {
+    return lhs.list.count == rhs.list.count;
+  }
+  if (lhs.type == SWITCH_TYPE_NONE) {
+    return lhs.u64 == rhs.u64;
+  }
+  return lhs == rhs;
+}
+
+/* check the store holds exactly the values captured before */
+void store_values_check(const std::vector<stored_value> &expected) {
+  const db::db_store *store = db::get_db();
+  size_t num_values = 0;
+  for (const auto &object : *store) {
+    for (const auto &val : object.second.second) {
+      stored_value key = {object.first.data, val.attr_id, val.extra, {}};
+      auto it = std::lower_bound(expected.begin(), expected.end(), key);
+      assert(it != expected.end() && !(key < *it));
+      assert(store_value_equal(it->value, val.get_value()));
+      num_values++;
+    }
+  }
+  assert(num_values == expected.size());
+}
+
+/*
+ * Warm init restore of the whole store, from the binary snapshot written by
+ * object_info_dump and from the text debug export, every attribute value
+ * must come back unchanged
+ */
+void test_warm_boot_perf() {
+  const char *const test_model_name = TESTDATADIR "/test/replay.json";
+  const char *const snapshot_file = "/tmp/db_perf.bin";
+  const char *const text_file = "/tmp/db_perf.txt";
+  struct timespec start = {0}, end = {0};
+  switch_status_t status;
+  size_t num_objects = store_object_count();
+  const std::vector<stored_value> values = store_values();
+
+  std::cout << "\n**** Testing warm boot restore of " << num_objects
+            << " objects ****" << std::endl;
+  status = switch_store::object_info_dump(snapshot_file);
+  assert(status == SWITCH_STATUS_SUCCESS);
+  status = switch_store::object_info_dump_text(text_file);
+  assert(status == SWITCH_STATUS_SUCCESS);
+
+  for (const auto file : {snapshot_file, text_file}) {
+    switch_store::object_info_clean();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    status = switch_store::object_info_init(test_model_name, true, file);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert(status == SWITCH_STATUS_SUCCESS);
+    compute_rate(start,
+                 end,
+                 num_objects,
+                 file == snapshot_file ? "snapshot restore" : "text restore");
+    assert(store_object_count() == num_objects);
+    assert(db::get_creation_list().size() == num_objects);
+    store_values_check(values);
+  }
+}
+
 void setup() {
   switch_status_t status = SWITCH_STATUS_SUCCESS;
   const char *const test_model_name = TESTDATADIR "/test/replay.json";
@@ -476,6 +577,7 @@ int main(void) {
   test_ids_perf();
 
   test_mac_scale();
+  test_warm_boot_perf();
   printf("\n\nAll tests passed!\n");
   return 0;
 }
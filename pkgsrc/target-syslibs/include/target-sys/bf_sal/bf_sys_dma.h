@@ -54,6 +54,9 @@ typedef int (*bf_dma_bus_unmap)(int dev_id, uint32_t subdev_id, void *dma_addr,
 
 #define BF_SYS_DMA_POOL_MAX 21
 
+/* upper bound on the number of buffers a per-thread pool cache can hold */
+#define BF_SYS_DMA_POOL_CACHE_DEPTH_MAX 64
+
 /**
  * dma pool id type abstraction
  */
@@ -68,6 +71,20 @@ typedef enum {
   BF_DMA_BI_DIRECTIONAL
 } bf_sys_dma_dir_t;
 
+/**
+ * dma pool buffer cache statistics
+ */
+typedef struct bf_sys_dma_pool_stats_s {
+  uint64_t cache_hits;    /* allocations served from a per-thread cache */
+  uint64_t cache_refills; /* bulk moves from the free stack into a cache */
+  uint64_t cache_drains;  /* bulk moves from a cache back to the free stack */
+  uint64_t cache_steals;  /* allocations served from another thread's cache */
+  uint32_t cache_depth;   /* max buffers per cache, 0 if caching is off */
+  uint32_t cached_bufs;   /* buffers currently parked in caches */
+  uint32_t free_bufs;     /* buffers currently on the pool's free stack */
+  uint32_t buf_cnt;       /* total number of buffers in the pool */
+} bf_sys_dma_pool_stats_t;
+
 /* register the static dma bus map functions
  */
 void bf_sys_dma_map_fn_register(bf_dma_bus_map fn1, bf_dma_bus_unmap fn2);
@@ -171,6 +188,30 @@ int bf_sys_dma_buffer_index(bf_sys_dma_pool_handle_t hndl, void *v_addr);
  */
 void bf_sys_dma_free(bf_sys_dma_pool_handle_t hndl, void *v_addr);
 
+/**
+ * Set the depth of the per-thread buffer caches of a DMA memory pool
+ * @param hndl pool handle
+ * @param depth max number of free buffers each thread cache may hold, 0
+ *   disables caching and returns all cached buffers to the pool
+ * @return Status 0 on Success, -1 on failure
+ *
+ *  With caching enabled bf_sys_dma_alloc and bf_sys_dma_free are served from
+ *  a cache private to the calling thread and only touch the pool's shared
+ *  free stack to move half a cache worth of buffers at a time.  A cache that
+ *  runs dry with an empty free stack takes buffers from other threads' caches
+ *  so allocation never fails while free buffers remain.
+ */
+int bf_sys_dma_pool_cache_set(bf_sys_dma_pool_handle_t hndl, int depth);
+
+/**
+ * Get the buffer cache statistics of a DMA memory pool
+ * @param hndl pool handle
+ * @param stats returns the statistics
+ * @return Status 0 on Success, -1 on failure
+ */
+int bf_sys_dma_pool_stats_get(bf_sys_dma_pool_handle_t hndl,
+                              bf_sys_dma_pool_stats_t *stats);
+
 /* convenient wrapper API if one needs just one buffer in the pool */
 /**
  * Allocate a single buffer DMA memory pool
@@ -155,6 +155,10 @@ int bf_sys_log_level_set(int module, int output, int bf_level);
 
 /**
  * trace function (generic)
+ *  while tracing is enabled with bf_sys_trace_enable, the message is recorded
+ *  in binary form in a ring buffer of the calling thread and only formatted
+ *  when read with bf_sys_trace_get, so format must remain valid (e.g. a
+ *  string literal), string arguments are copied
  *
  * @param module
  *  trace module (or facility)
@@ -184,14 +188,27 @@ int bf_sys_trace(int module, int bf_level, const char *format, ...);
  */
 void bf_sys_trace_level_set(int module, int bf_level);
 
+/**
+ * enable or disable tracing
+ *   tracing is disabled until enabled, the trace level only selects which
+ *   messages are recorded while it is enabled
+ * @param enable
+ *  non zero to record trace messages, zero to stop recording them
+ * @return
+ *  none
+ */
+void bf_sys_trace_enable(int enable);
+
 /**
  * get trace ring buffer
+ *  the trace of all threads is merged by time and formatted as one line per
+ *  message, if it does not fit into buf the most recent messages are returned
  *
  * @param buf
- *  buffer to read data into
+ *  buffer to read data into, NUL terminated on return
  * @param size
  *  size of buf
- * @param size
+ * @param len_written
  *  size of data actually read into buf
  * @return
  *  0 on Sucess, -1 on error
@@ -40,6 +40,9 @@
 #define BF_INVALID_DMA_ADDR ((bf_dma_addr_t)(0xFFFFFFFFFFFFFFFFULL))
 
 #define POOL_HDR_SIZE (4 * 1024)
+/* number of per-thread buffer magazines kept by a pool with caching enabled,
+ * threads are hashed onto them round-robin */
+#define POOL_CACHE_CNT 16
 #define ALIGN_TO_BF_PAGE_SIZE(x)                                               \
   (((x) + BF_HUGE_PAGE_SIZE - 1) / BF_HUGE_PAGE_SIZE * BF_HUGE_PAGE_SIZE)
 
@@ -51,6 +54,20 @@ typedef struct {
   void *base_virt_addr;        /* virtual address of the huge page */
 } bf_huge_page_info_t;
 
+/**
+ * per-thread buffer magazine, sits on its own cache line so that threads
+ * working on different magazines do not share the gate
+ */
+typedef struct {
+  volatile int gate;     /* assist for atomic operation */
+  int cnt;               /* number of buffers currently in bufs */
+  uint64_t hits;         /* allocations served from this magazine */
+  uint64_t refills;      /* bulk transfers from the pool's free stack */
+  uint64_t drains;       /* bulk transfers to the pool's free stack */
+  uint64_t steals;       /* allocations served from another magazine */
+  void *bufs[BF_SYS_DMA_POOL_CACHE_DEPTH_MAX];
+} __attribute__((aligned(64))) bf_huge_pool_cache_t;
+
 /* data structures */
 typedef struct {
   int pool_inited;     /* 0 if pool is not initialized */
@@ -76,8 +93,14 @@ typedef struct {
   int dev_id; /* device id that the pool belongs to */
   uint32_t
       subdev_id; /* subdev_id (within the device id) that the pool belongs to */
+  int cache_depth; /* max buffers per magazine, 0 if caching is disabled */
+  bf_huge_pool_cache_t *cache; /* array of POOL_CACHE_CNT magazines */
 } bf_huge_pool_t;
 
+/* magazine index of the calling thread, assigned on first use */
+static __thread int pool_cache_idx = -1;
+static volatile uint32_t pool_cache_next_idx = 0;
+
 static bf_dma_bus_map bf_sys_dma_map_fn = NULL;
 static bf_dma_bus_unmap bf_sys_dma_unmap_fn = NULL;
 
@@ -484,6 +507,11 @@ void bf_sys_dma_pool_destroy(bf_sys_dma_pool_handle_t hndl) {
                   dma_pool->pool_hdr_offset);
   /* free the queue containing the pointers to buffers */
   bf_sys_free(dma_pool->pool_buf_ptr);
+  /* free the per-thread magazines, any buffers parked in them are gone with
+     the huge pages */
+  if (dma_pool->cache) {
+    bf_sys_free(dma_pool->cache);
+  }
   /* free the array of structures containing the base physical
      and virtual addresses of the huge pages in the memory pool */
   bf_sys_free(dma_pool->huge_page_info_ptr);
@@ -528,6 +556,200 @@ static int bf_push_free_buf(bf_huge_pool_t *pool, void *buf_ptr) {
   return err;
 }
 
+static inline void bf_pool_gate_close(volatile int *gate) {
+  do {
+  } while (__sync_val_compare_and_swap(gate, 0, 1) == 1);
+}
+
+static inline void bf_pool_gate_open(volatile int *gate) {
+  __sync_val_compare_and_swap(gate, 1, 0);
+}
+
+/* move up to cnt buffers from the pool's free stack into a magazine, the
+ * caller holds the magazine gate */
+static int bf_pool_cache_refill(bf_huge_pool_t *pool,
+                                bf_huge_pool_cache_t *mag,
+                                int cnt) {
+  int moved = 0;
+
+  bf_pool_gate_close(&pool->pool_gate);
+  while (moved < cnt && pool->pool_buf_offset < (uint32_t)(pool->buf_cnt)) {
+    mag->bufs[mag->cnt++] = (pool->pool_buf_ptr)[pool->pool_buf_offset++];
+    moved++;
+  }
+  bf_pool_gate_open(&pool->pool_gate);
+  return moved;
+}
+
+/* move up to cnt buffers from a magazine back to the pool's free stack, the
+ * caller holds the magazine gate */
+static int bf_pool_cache_drain(bf_huge_pool_t *pool,
+                               bf_huge_pool_cache_t *mag,
+                               int cnt) {
+  int err = 0;
+
+  bf_pool_gate_close(&pool->pool_gate);
+  while (cnt-- && mag->cnt) {
+    if (pool->pool_buf_offset == 0 ||
+        pool->pool_buf_offset > (uint32_t)(pool->buf_cnt)) {
+      err = -1;
+      break;
+    }
+    pool->pool_buf_offset--;
+    (pool->pool_buf_ptr)[pool->pool_buf_offset] = mag->bufs[--mag->cnt];
+  }
+  bf_pool_gate_open(&pool->pool_gate);
+  return err;
+}
+
+static bf_huge_pool_cache_t *bf_pool_cache_get(bf_huge_pool_t *pool) {
+  if (pool_cache_idx < 0) {
+    pool_cache_idx =
+        __sync_fetch_and_add(&pool_cache_next_idx, 1) % POOL_CACHE_CNT;
+  }
+  return &pool->cache[pool_cache_idx];
+}
+
+static int bf_cache_pop_free_buf(bf_huge_pool_t *pool, void **buf_ptr) {
+  bf_huge_pool_cache_t *mag = bf_pool_cache_get(pool);
+  int i, depth, err = -1;
+
+  bf_pool_gate_close(&mag->gate);
+  /* the depth is read under the gate, bf_sys_dma_pool_cache_set changes it
+   * before it drains the magazines */
+  depth = pool->cache_depth;
+  if (mag->cnt == 0 && depth) {
+    /* refill half a magazine so that the following frees have room before
+     * they need to drain again */
+    if (bf_pool_cache_refill(pool, mag, (depth + 1) / 2)) {
+      mag->refills++;
+    }
+  }
+  if (mag->cnt) {
+    *buf_ptr = mag->bufs[--mag->cnt];
+    mag->hits++;
+    err = 0;
+  }
+  bf_pool_gate_open(&mag->gate);
+  if (err == 0) {
+    return 0;
+  }
+
+  /* the free stack is empty, take a buffer parked in another thread's
+   * magazine rather than failing while buffers are still free */
+  for (i = 1; i < POOL_CACHE_CNT && err; i++) {
+    bf_huge_pool_cache_t *other = &pool->cache[(pool_cache_idx + i) %
+                                               POOL_CACHE_CNT];
+    if (other->cnt == 0) {
+      continue;
+    }
+    bf_pool_gate_close(&other->gate);
+    if (other->cnt) {
+      *buf_ptr = other->bufs[--other->cnt];
+      other->steals++;
+      err = 0;
+    }
+    bf_pool_gate_open(&other->gate);
+  }
+  if (err && depth == 0) {
+    /* caching was disabled after the caller checked, the magazines are
+     * drained back to the free stack */
+    err = bf_pop_free_buf(pool, buf_ptr);
+  }
+  return err;
+}
+
+static int bf_cache_push_free_buf(bf_huge_pool_t *pool, void *buf_ptr) {
+  bf_huge_pool_cache_t *mag = bf_pool_cache_get(pool);
+  int depth, err = 0;
+
+  bf_pool_gate_close(&mag->gate);
+  depth = pool->cache_depth;
+  if (depth == 0) {
+    /* caching was disabled after the caller checked, a buffer pushed now
+     * would stay parked in a magazine nobody drains any more */
+    bf_pool_gate_open(&mag->gate);
+    return bf_push_free_buf(pool, buf_ptr);
+  }
+  if (mag->cnt >= depth) {
+    err = bf_pool_cache_drain(pool, mag, (depth + 1) / 2);
+    if (err == 0) {
+      mag->drains++;
+    }
+  }
+  if (err == 0) {
+    mag->bufs[mag->cnt++] = buf_ptr;
+  }
+  bf_pool_gate_open(&mag->gate);
+  return err;
+}
+
+/**
+ *  Enable, resize or disable the per-thread buffer cache of a pool
+ */
+int bf_sys_dma_pool_cache_set(bf_sys_dma_pool_handle_t hndl, int depth) {
+  bf_huge_pool_t *dma_pool = (bf_huge_pool_t *)hndl;
+  int i;
+
+  assert(dma_pool);
+  if (depth < 0 || depth > BF_SYS_DMA_POOL_CACHE_DEPTH_MAX) {
+    return -1;
+  }
+  if (depth && dma_pool->cache == NULL) {
+    dma_pool->cache = (bf_huge_pool_cache_t *)bf_sys_calloc(
+        POOL_CACHE_CNT, sizeof(bf_huge_pool_cache_t));
+    if (dma_pool->cache == NULL) {
+      return -1;
+    }
+  }
+  if (dma_pool->cache == NULL) {
+    return 0;
+  }
+  /* publish the new depth first, a thread that takes a magazine gate after
+   * the magazine was drained below sees it and no longer overfills it */
+  dma_pool->cache_depth = depth;
+  /* return whatever no longer fits back to the free stack */
+  for (i = 0; i < POOL_CACHE_CNT; i++) {
+    bf_huge_pool_cache_t *mag = &dma_pool->cache[i];
+    bf_pool_gate_close(&mag->gate);
+    if (mag->cnt > depth) {
+      bf_pool_cache_drain(dma_pool, mag, mag->cnt - depth);
+    }
+    bf_pool_gate_open(&mag->gate);
+  }
+  return 0;
+}
+
+/**
+ *  Get the buffer cache statistics of a pool
+ */
+int bf_sys_dma_pool_stats_get(bf_sys_dma_pool_handle_t hndl,
+                              bf_sys_dma_pool_stats_t *stats) {
+  bf_huge_pool_t *dma_pool = (bf_huge_pool_t *)hndl;
+  int i;
+
+  assert(dma_pool);
+  if (stats == NULL) {
+    return -1;
+  }
+  memset(stats, 0, sizeof(*stats));
+  stats->buf_cnt = dma_pool->buf_cnt;
+  stats->free_bufs = dma_pool->buf_cnt - dma_pool->pool_buf_offset;
+  stats->cache_depth = dma_pool->cache_depth;
+  if (dma_pool->cache == NULL) {
+    return 0;
+  }
+  for (i = 0; i < POOL_CACHE_CNT; i++) {
+    bf_huge_pool_cache_t *mag = &dma_pool->cache[i];
+    stats->cache_hits += mag->hits;
+    stats->cache_refills += mag->refills;
+    stats->cache_drains += mag->drains;
+    stats->cache_steals += mag->steals;
+    stats->cached_bufs += mag->cnt;
+  }
+  return 0;
+}
+
 /**
  *  Allocate a buffer from a DMA memory pool
  */
@@ -535,12 +757,18 @@ int bf_sys_dma_alloc(bf_sys_dma_pool_handle_t hndl, size_t size, void **v_addr,
                      bf_phys_addr_t *phys_addr) {
   (void)size;
   bf_huge_pool_t *dma_pool = (bf_huge_pool_t *)hndl;
+  int err;
 
   assert(dma_pool);
 
   assert(size <= dma_pool->buf_size);
 
-  if (bf_pop_free_buf(dma_pool, v_addr) < 0) {
+  if (dma_pool->cache_depth) {
+    err = bf_cache_pop_free_buf(dma_pool, v_addr);
+  } else {
+    err = bf_pop_free_buf(dma_pool, v_addr);
+  }
+  if (err < 0) {
     *v_addr = NULL;
     *phys_addr = 0;
     return -1;
@@ -609,7 +837,11 @@ void bf_sys_dma_free(bf_sys_dma_pool_handle_t hndl, void *v_addr) {
   assert(dma_pool);
   assert(v_addr);
 
-  bf_push_free_buf(dma_pool, v_addr);
+  if (dma_pool->cache_depth) {
+    bf_cache_push_free_buf(dma_pool, v_addr);
+  } else {
+    bf_push_free_buf(dma_pool, v_addr);
+  }
 }
 
 /* convenient wrapper APIs if the pool needs just one buffer */
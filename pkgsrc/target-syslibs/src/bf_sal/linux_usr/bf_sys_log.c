@@ -23,13 +23,18 @@
 
 #include <assert.h>
 #include <config.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <wchar.h>
 #include <target-sys/bf_sal/bf_sys_mem.h>
 #include <target-sys/bf_sal/bf_sys_str.h>
 #include <unistd.h>
@@ -43,7 +48,7 @@
 
 /**
  * bf_sys_log implementation for linux userspace
- * using "TBD" library for tracing and zlog for logging
+ * using per-thread binary trace rings for tracing and zlog for logging
  */
 
 /**
@@ -60,6 +65,9 @@ static char *zlog_cur_log_file = NULL;
 /* trace level of an individual module */
 static int bf_sys_trace_level[BF_MOD_MAX];
 
+/* tracing is off until enabled with bf_sys_trace_enable */
+static int bf_sys_trace_enabled;
+
 /* zlog category for an individual module */
 static zlog_category_t *zlog_cat[BF_MOD_MAX];
 
@@ -177,24 +185,499 @@ static void bf_sys_zlog_close(void) {
   }
 }
 
-static int bf_sys_trace_init(int default_level) {
+/* Binary trace rings.
+ *
+ * Every thread that traces gets its own ring of fixed size records so that
+ * recording a trace is lock-free and never contends with other threads.  A
+ * record keeps the format string pointer and the raw arguments, the text is
+ * only formatted when the trace is read with bf_sys_trace_get.  The format
+ * string must therefore outlive the record, which holds for the string
+ * literals passed through the logging macros.  String arguments are copied
+ * into the record, truncated to BF_SYS_TRACE_STR_MAX bytes.
+ *
+ * The writer clears the sequence number of a record before filling it in and
+ * sets it afterwards, the reader copies a record and drops the copy if the
+ * sequence number changed meanwhile.  Each record carries the id of the thread
+ * that wrote it since the ring of an exited thread is reused.
+ */
+#define BF_SYS_TRACE_REC_SZ 128
+#define BF_SYS_TRACE_ARGS_SZ (BF_SYS_TRACE_REC_SZ - 31)
+#define BF_SYS_TRACE_STR_MAX 64
+/* Default per-thread ring size in bytes and the minimum number of records. */
+#define BF_SYS_TRACE_DEF_SIZE (32 * 1024)
+#define BF_SYS_TRACE_MIN_RECS 64
+/* Longest formatted line and conversion specification. */
+#define BF_SYS_TRACE_LINE_MAX 512
+#define BF_SYS_TRACE_SPEC_MAX 32
+
+typedef struct bf_sys_trace_rec_s {
+  uint64_t seq; /* Record index + 1, 0 while being written */
+  uint64_t ts_ns;
+  const char *fmt;
+  int32_t tid;
+  uint8_t module;
+  uint8_t level;
+  uint8_t len; /* Bytes of args in use, arguments that did not fit are
+                * printed as "..." */
+  uint8_t args[BF_SYS_TRACE_ARGS_SZ];
+} bf_sys_trace_rec_t;
+
+typedef struct bf_sys_trace_ring_s {
+  struct bf_sys_trace_ring_s *next;
+  int in_use;
+  int tid;
+  uint64_t head; /* Index of the next record, only written by the owner */
+  uint64_t tail; /* Records before this index have been reset */
+  uint32_t mask;
+  bf_sys_trace_rec_t recs[];
+} bf_sys_trace_ring_t;
+
+typedef enum {
+  BF_SYS_TRACE_ARG_END = 0,
+  BF_SYS_TRACE_ARG_LITERAL,
+  BF_SYS_TRACE_ARG_INT,
+  BF_SYS_TRACE_ARG_LONG,
+  BF_SYS_TRACE_ARG_LLONG,
+  BF_SYS_TRACE_ARG_INTMAX,
+  BF_SYS_TRACE_ARG_SIZE,
+  BF_SYS_TRACE_ARG_PTRDIFF,
+  BF_SYS_TRACE_ARG_DOUBLE,
+  BF_SYS_TRACE_ARG_LDOUBLE,
+  BF_SYS_TRACE_ARG_PTR,
+  BF_SYS_TRACE_ARG_STR,
+  BF_SYS_TRACE_ARG_WSTR, /* Not recorded, printed as an empty string */
+  BF_SYS_TRACE_ARG_COUNT /* %n, not recorded */
+} bf_sys_trace_arg_t;
+
+static bf_sys_trace_ring_t *bf_sys_trace_rings;
+static uint32_t bf_sys_trace_ring_recs =
+    BF_SYS_TRACE_DEF_SIZE / BF_SYS_TRACE_REC_SZ;
+static __thread bf_sys_trace_ring_t *bf_sys_trace_my_ring;
+static pthread_key_t bf_sys_trace_key;
+static pthread_once_t bf_sys_trace_once = PTHREAD_ONCE_INIT;
+
+static const char bf_sys_trace_level_name[BF_LOG_MAX + 1][8] = {
+    "NONE", "CRIT", "ERROR", "WARN", "INFO", "DEBUG"};
+
+/* Hand the ring of an exiting thread over to the next new thread, the records
+ * stay readable until they are overwritten. */
+static void bf_sys_trace_ring_release(void *arg) {
+  bf_sys_trace_ring_t *r = arg;
+  __atomic_store_n(&r->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void bf_sys_trace_key_init(void) {
+  pthread_key_create(&bf_sys_trace_key, bf_sys_trace_ring_release);
+}
+
+static bf_sys_trace_ring_t *bf_sys_trace_ring_get(void) {
+  bf_sys_trace_ring_t *r = bf_sys_trace_my_ring;
+  uint32_t recs;
+
+  if (r)
+    return r;
+  pthread_once(&bf_sys_trace_once, bf_sys_trace_key_init);
+
+  for (r = __atomic_load_n(&bf_sys_trace_rings, __ATOMIC_ACQUIRE); r;
+       r = r->next) {
+    int unused = 0;
+    if (__atomic_compare_exchange_n(&r->in_use, &unused, 1, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+      break;
+  }
+  if (!r) {
+    recs = bf_sys_trace_ring_recs;
+    r = bf_sys_calloc(1, sizeof *r + recs * sizeof r->recs[0]);
+    if (!r)
+      return NULL;
+    r->mask = recs - 1;
+    r->in_use = 1;
+    r->next = __atomic_load_n(&bf_sys_trace_rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&bf_sys_trace_rings, &r->next, r,
+                                        true, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+      ;
+  }
+  r->tid = (int)syscall(SYS_gettid);
+  bf_sys_trace_my_ring = r;
+  pthread_setspecific(bf_sys_trace_key, r);
+  return r;
+}
+
+/* Parses the conversion specification starting at the '%' p points to.
+ * Returns the character following it, the type of its argument and the
+ * number of '*' int arguments preceding that. */
+static const char *bf_sys_trace_spec_parse(const char *p,
+                                           bf_sys_trace_arg_t *type,
+                                           int *stars) {
+  int lng = 0;
+  char mod = 0;
+
+  *stars = 0;
+  p++;
+  while (*p && strchr("-+ #0'", *p)) p++;
+  if (*p == '*') {
+    (*stars)++;
+    p++;
+  }
+  while (*p >= '0' && *p <= '9') p++;
+  if (*p == '.') {
+    p++;
+    if (*p == '*') {
+      (*stars)++;
+      p++;
+    }
+    while (*p >= '0' && *p <= '9') p++;
+  }
+  for (;; p++) {
+    if (*p == 'h')
+      continue;
+    if (*p == 'l') {
+      lng++;
+    } else if (*p == 'q') {
+      lng = 2;
+    } else if (*p == 'L' || *p == 'j' || *p == 'z' || *p == 't') {
+      mod = *p;
+    } else {
+      break;
+    }
+  }
+
+  switch (*p) {
+  case 'd':
+  case 'i':
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+    if (mod == 'j') {
+      *type = BF_SYS_TRACE_ARG_INTMAX;
+    } else if (mod == 'z') {
+      *type = BF_SYS_TRACE_ARG_SIZE;
+    } else if (mod == 't') {
+      *type = BF_SYS_TRACE_ARG_PTRDIFF;
+    } else if (lng >= 2 || mod == 'L') {
+      *type = BF_SYS_TRACE_ARG_LLONG;
+    } else if (lng == 1) {
+      *type = BF_SYS_TRACE_ARG_LONG;
+    } else {
+      *type = BF_SYS_TRACE_ARG_INT;
+    }
+    break;
+  case 'c':
+    *type = BF_SYS_TRACE_ARG_INT;
+    break;
+  case 'e':
+  case 'E':
+  case 'f':
+  case 'F':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    *type = mod == 'L' ? BF_SYS_TRACE_ARG_LDOUBLE : BF_SYS_TRACE_ARG_DOUBLE;
+    break;
+  case 's':
+    *type = lng ? BF_SYS_TRACE_ARG_WSTR : BF_SYS_TRACE_ARG_STR;
+    break;
+  case 'p':
+    *type = BF_SYS_TRACE_ARG_PTR;
+    break;
+  case 'n':
+    *type = BF_SYS_TRACE_ARG_COUNT;
+    break;
+  case '\0':
+    *type = BF_SYS_TRACE_ARG_END;
+    return p;
+  default:
+    /* "%%" and unknown conversions are printed as they are. */
+    *type = BF_SYS_TRACE_ARG_LITERAL;
+    *stars = 0;
+    break;
+  }
+  return p + 1;
+}
+
+#define BF_SYS_TRACE_PUT(T, v)                   \
+  do {                                           \
+    T val_ = (T)(v);                             \
+    if (len + sizeof val_ > BF_SYS_TRACE_ARGS_SZ) \
+      goto done;                                 \
+    memcpy(&rec->args[len], &val_, sizeof val_); \
+    len += sizeof val_;                          \
+  } while (0)
+
+/* Copies the arguments of format from v into rec. */
+static void bf_sys_trace_args_pack(bf_sys_trace_rec_t *rec,
+                                   const char *format, va_list v) {
+  const char *p = format;
+  bf_sys_trace_arg_t type;
+  size_t len = 0, n;
+  const char *str;
+  int stars;
+
+  while ((p = strchr(p, '%')) != NULL) {
+    p = bf_sys_trace_spec_parse(p, &type, &stars);
+    for (int i = 0; i < stars; i++) BF_SYS_TRACE_PUT(int, va_arg(v, int));
+    switch (type) {
+    case BF_SYS_TRACE_ARG_END:
+      goto done;
+    case BF_SYS_TRACE_ARG_LITERAL:
+      break;
+    case BF_SYS_TRACE_ARG_INT:
+      BF_SYS_TRACE_PUT(int, va_arg(v, int));
+      break;
+    case BF_SYS_TRACE_ARG_LONG:
+      BF_SYS_TRACE_PUT(long, va_arg(v, long));
+      break;
+    case BF_SYS_TRACE_ARG_LLONG:
+      BF_SYS_TRACE_PUT(long long, va_arg(v, long long));
+      break;
+    case BF_SYS_TRACE_ARG_INTMAX:
+      BF_SYS_TRACE_PUT(intmax_t, va_arg(v, intmax_t));
+      break;
+    case BF_SYS_TRACE_ARG_SIZE:
+      BF_SYS_TRACE_PUT(size_t, va_arg(v, size_t));
+      break;
+    case BF_SYS_TRACE_ARG_PTRDIFF:
+      BF_SYS_TRACE_PUT(ptrdiff_t, va_arg(v, ptrdiff_t));
+      break;
+    case BF_SYS_TRACE_ARG_DOUBLE:
+      BF_SYS_TRACE_PUT(double, va_arg(v, double));
+      break;
+    case BF_SYS_TRACE_ARG_LDOUBLE:
+      BF_SYS_TRACE_PUT(long double, va_arg(v, long double));
+      break;
+    case BF_SYS_TRACE_ARG_PTR:
+      BF_SYS_TRACE_PUT(void *, va_arg(v, void *));
+      break;
+    case BF_SYS_TRACE_ARG_STR:
+      str = va_arg(v, const char *);
+      if (!str)
+        str = "(null)";
+      if (len + 1 > BF_SYS_TRACE_ARGS_SZ)
+        goto done;
+      n = strnlen(str, BF_SYS_TRACE_STR_MAX);
+      if (n > BF_SYS_TRACE_ARGS_SZ - len - 1) {
+        n = BF_SYS_TRACE_ARGS_SZ - len - 1;
+      }
+      rec->args[len++] = (uint8_t)n;
+      memcpy(&rec->args[len], str, n);
+      len += n;
+      break;
+    case BF_SYS_TRACE_ARG_WSTR:
+    case BF_SYS_TRACE_ARG_COUNT:
+      (void)va_arg(v, void *);
+      break;
+    }
+  }
+done:
+  rec->len = (uint8_t)len;
+}
+
+static void bf_sys_trace_record(int module, int level, const char *format,
+                                va_list v) {
+  bf_sys_trace_ring_t *r = bf_sys_trace_ring_get();
+  bf_sys_trace_rec_t *rec;
+  struct timespec ts;
+  uint64_t idx;
+
+  if (!r)
+    return;
+  idx = r->head;
+  rec = &r->recs[idx & r->mask];
+  __atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  rec->ts_ns = (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+  rec->fmt = format;
+  rec->tid = r->tid;
+  rec->module = (uint8_t)module;
+  rec->level = (uint8_t)level;
+  bf_sys_trace_args_pack(rec, format, v);
+
+  __atomic_store_n(&rec->seq, idx + 1, __ATOMIC_RELEASE);
+  __atomic_store_n(&r->head, idx + 1, __ATOMIC_RELEASE);
+}
+
+#define BF_SYS_TRACE_GET(T, var)                        \
+  do {                                                  \
+    if (off + sizeof(T) > rec->len) goto truncated;     \
+    memcpy(&var, &rec->args[off], sizeof(T));           \
+    off += sizeof(T);                                   \
+  } while (0)
+
+#define BF_SYS_TRACE_PRINT(T)                                           \
+  do {                                                                  \
+    T val_;                                                             \
+    BF_SYS_TRACE_GET(T, val_);                                          \
+    if (stars == 0) {                                                   \
+      n = snprintf(out + pos, size - pos, spec, val_);                  \
+    } else if (stars == 1) {                                            \
+      n = snprintf(out + pos, size - pos, spec, star[0], val_);         \
+    } else {                                                            \
+      n = snprintf(out + pos, size - pos, spec, star[0], star[1], val_); \
+    }                                                                   \
+  } while (0)
+
+/* Formats the message of rec into out, returns its length. */
+static size_t bf_sys_trace_msg_format(const bf_sys_trace_rec_t *rec,
+                                      char *out, size_t size) {
+  char spec[BF_SYS_TRACE_SPEC_MAX];
+  const char *p = rec->fmt, *s;
+  bf_sys_trace_arg_t type;
+  size_t pos = 0, off = 0, slen;
+  int stars, star[2], n;
+  char str[BF_SYS_TRACE_STR_MAX + 1];
+
+  while (*p && pos + 1 < size) {
+    if (*p != '%') {
+      out[pos++] = *p++;
+      continue;
+    }
+    s = p;
+    p = bf_sys_trace_spec_parse(p, &type, &stars);
+    slen = p - s;
+    if (type == BF_SYS_TRACE_ARG_END)
+      break;
+    if (type == BF_SYS_TRACE_ARG_LITERAL || slen >= sizeof spec) {
+      /* "%%" prints a single '%', anything else is copied verbatim. */
+      if (slen == 2 && s[1] == '%')
+        s++, slen = 1;
+      if (slen > size - pos - 1)
+        slen = size - pos - 1;
+      memcpy(out + pos, s, slen);
+      pos += slen;
+      continue;
+    }
+    memcpy(spec, s, slen);
+    spec[slen] = '\0';
+    for (int i = 0; i < stars; i++) BF_SYS_TRACE_GET(int, star[i]);
+
+    n = 0;
+    switch (type) {
+    case BF_SYS_TRACE_ARG_INT:
+      BF_SYS_TRACE_PRINT(int);
+      break;
+    case BF_SYS_TRACE_ARG_LONG:
+      BF_SYS_TRACE_PRINT(long);
+      break;
+    case BF_SYS_TRACE_ARG_LLONG:
+      BF_SYS_TRACE_PRINT(long long);
+      break;
+    case BF_SYS_TRACE_ARG_INTMAX:
+      BF_SYS_TRACE_PRINT(intmax_t);
+      break;
+    case BF_SYS_TRACE_ARG_SIZE:
+      BF_SYS_TRACE_PRINT(size_t);
+      break;
+    case BF_SYS_TRACE_ARG_PTRDIFF:
+      BF_SYS_TRACE_PRINT(ptrdiff_t);
+      break;
+    case BF_SYS_TRACE_ARG_DOUBLE:
+      BF_SYS_TRACE_PRINT(double);
+      break;
+    case BF_SYS_TRACE_ARG_LDOUBLE:
+      BF_SYS_TRACE_PRINT(long double);
+      break;
+    case BF_SYS_TRACE_ARG_PTR:
+      BF_SYS_TRACE_PRINT(void *);
+      break;
+    case BF_SYS_TRACE_ARG_STR: {
+      uint8_t l;
+      BF_SYS_TRACE_GET(uint8_t, l);
+      if (off + l > rec->len)
+        goto truncated;
+      memcpy(str, &rec->args[off], l);
+      str[l] = '\0';
+      off += l;
+      const char *val_ = str;
+      if (stars == 0) {
+        n = snprintf(out + pos, size - pos, spec, val_);
+      } else if (stars == 1) {
+        n = snprintf(out + pos, size - pos, spec, star[0], val_);
+      } else {
+        n = snprintf(out + pos, size - pos, spec, star[0], star[1], val_);
+      }
+      break;
+    }
+    case BF_SYS_TRACE_ARG_WSTR: {
+      const wchar_t *val_ = L"";
+      n = snprintf(out + pos, size - pos, spec, val_);
+      break;
+    }
+    default:
+      break;
+    }
+    if (n > 0)
+      pos += (size_t)n < size - pos ? (size_t)n : size - pos - 1;
+  }
+  out[pos] = '\0';
+  return pos;
+
+truncated:
+  n = snprintf(out + pos, size - pos, "...");
+  if (n > 0)
+    pos += (size_t)n < size - pos ? (size_t)n : size - pos - 1;
+  out[pos] = '\0';
+  return pos;
+}
+
+/* Formats rec as one line of trace output, returns its length. */
+static size_t bf_sys_trace_line_format(const bf_sys_trace_rec_t *rec,
+                                       char *out, size_t size) {
+  time_t secs = rec->ts_ns / 1000000000;
+  struct tm tm;
+  size_t pos;
+  int n;
+
+  localtime_r(&secs, &tm);
+  pos = strftime(out, size, "%Y-%m-%d %H:%M:%S", &tm);
+  n = snprintf(out + pos, size - pos, ".%06u %d %s %s ",
+               (unsigned)(rec->ts_ns % 1000000000 / 1000), (int)rec->tid,
+               zlog_cat_name[rec->module],
+               bf_sys_trace_level_name[rec->level <= BF_LOG_MAX ? rec->level
+                                                                 : 0]);
+  if (n < 0 || (size_t)n >= size - pos)
+    return 0;
+  pos += n;
+  pos += bf_sys_trace_msg_format(rec, out + pos, size - pos - 1);
+  if (pos && out[pos - 1] != '\n') out[pos++] = '\n';
+  out[pos] = '\0';
+  return pos;
+}
+
+static int bf_sys_trace_snap_cmp(const void *a, const void *b) {
+  const bf_sys_trace_rec_t *x = a, *y = b;
+  if (x->ts_ns != y->ts_ns)
+    return x->ts_ns < y->ts_ns ? -1 : 1;
+  return x->seq < y->seq ? -1 : x->seq > y->seq;
+}
+
+static int bf_sys_trace_init(int default_level, size_t ring_size) {
+  uint32_t recs = BF_SYS_TRACE_MIN_RECS;
   int i;
 
   for (i = 0; i < BF_MOD_MAX; i++) {
     bf_sys_trace_level[i] = default_level;
   }
+  /* Rings already handed out to threads keep their size. */
+  if (!ring_size)
+    ring_size = BF_SYS_TRACE_DEF_SIZE;
+  while (recs * 2 * BF_SYS_TRACE_REC_SZ <= ring_size) recs *= 2;
+  bf_sys_trace_ring_recs = recs;
   return 0;
 }
 
 /* arg1 - Path to logging config file.
  * arg2 - Trace level.
- * arg3 - Trace size. */
+ * arg3 - Trace size, in bytes per thread. */
 int bf_sys_log_init(const void *arg1, const void *arg2, const void *arg3) {
   int err;
-  (void)arg3;
 
   err = bf_sys_zlog_init(arg1);
-  err |= bf_sys_trace_init((int)(uintptr_t)arg2);
+  err |= bf_sys_trace_init((int)(uintptr_t)arg2, (size_t)(uintptr_t)arg3);
   return err;
 }
 
@@ -203,6 +686,11 @@ int bf_sys_log_close(void) {
   return 0;
 }
 
+static inline bool bf_sys_trace_is_enabled(int module, int level) {
+  return __atomic_load_n(&bf_sys_trace_enabled, __ATOMIC_RELAXED) &&
+         level <= bf_sys_trace_level[module];
+}
+
 int bf_sys_log(int module, int level, const char *format, ...) {
   if (module >= BF_MOD_MAX)
     return -1;
@@ -219,28 +707,33 @@ int bf_sys_log(int module, int level, const char *format, ...) {
   return 0;
 }
 int bf_sys_trace(int module, int level, const char *format, ...) {
-  if (module >= BF_MOD_MAX)
+  if (module >= BF_MOD_MAX || module < 0)
     return -1;
   int err = 0;
-  (void)format;
-  bool needs_trace = level <= bf_sys_trace_level[module];
+  bool needs_trace = bf_sys_trace_is_enabled(module, level);
 
   if (needs_trace) {
-    /* TBD add call to tracing functions */
+    va_list v;
+    va_start(v, format);
+    bf_sys_trace_record(module, level, format, v);
+    va_end(v);
   }
   return err;
 }
 
 int bf_sys_log_and_trace(int module, int level, const char *format, ...) {
-  if (module >= BF_MOD_MAX)
+  if (module >= BF_MOD_MAX || module < 0)
     return -1;
   int err = 0;
-  bool needs_trace = level <= bf_sys_trace_level[module];
+  bool needs_trace = bf_sys_trace_is_enabled(module, level);
   bool needs_log =
       zlog_would_log_at_level(zlog_cat[module], bf_get_zlog_level(level));
 
   if (needs_trace) {
-    /* TBD add call to tracing functions */
+    va_list v;
+    va_start(v, format);
+    bf_sys_trace_record(module, level, format, v);
+    va_end(v);
   }
   if (needs_log) {
     va_list v;
@@ -258,7 +751,7 @@ int bf_sys_log_is_log_enabled(int module, int level) {
   if (module < 0)
     return -1;
 
-  bool needs_trace = level <= bf_sys_trace_level[module];
+  bool needs_trace = bf_sys_trace_is_enabled(module, level);
   bool needs_log =
       zlog_would_log_at_level(zlog_cat[module], bf_get_zlog_level(level));
 
@@ -345,13 +838,76 @@ void bf_sys_trace_level_set(int module, int bf_level) {
   bf_sys_trace_level[module] = bf_level;
 }
 
+void bf_sys_trace_enable(int enable) {
+  __atomic_store_n(&bf_sys_trace_enabled, enable ? 1 : 0, __ATOMIC_RELAXED);
+}
+
 int bf_sys_trace_get(uint8_t *buf, size_t size, size_t *len_written) {
-  memset(buf, 0, size); /* TBD: replace when implemented */
-  *len_written = size;
+  char line[BF_SYS_TRACE_LINE_MAX];
+  bf_sys_trace_rec_t *snap;
+  bf_sys_trace_ring_t *r;
+  uint64_t head, first;
+  size_t cap = 0, cnt = 0, pos = 0, len, i;
+
+  if (!buf || !size || !len_written) return -1;
+  buf[0] = '\0';
+  *len_written = 0;
+
+  for (r = __atomic_load_n(&bf_sys_trace_rings, __ATOMIC_ACQUIRE); r;
+       r = r->next) {
+    cap += r->mask + 1;
+  }
+  if (!cap) return 0;
+  snap = bf_sys_malloc(cap * sizeof *snap);
+  if (!snap) return -1;
+
+  /* Copy the records of every ring, rings added meanwhile are skipped. */
+  for (r = __atomic_load_n(&bf_sys_trace_rings, __ATOMIC_ACQUIRE); r;
+       r = r->next) {
+    head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    first = head > (uint64_t)r->mask + 1 ? head - r->mask - 1 : 0;
+    if (first < __atomic_load_n(&r->tail, __ATOMIC_RELAXED)) {
+      first = __atomic_load_n(&r->tail, __ATOMIC_RELAXED);
+    }
+    for (uint64_t idx = first; idx < head && cnt < cap; idx++) {
+      bf_sys_trace_rec_t *rec = &r->recs[idx & r->mask];
+      if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != idx + 1) continue;
+      memcpy(&snap[cnt], rec, sizeof *rec);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (__atomic_load_n(&rec->seq, __ATOMIC_RELAXED) != idx + 1) continue;
+      cnt++;
+    }
+  }
+  qsort(snap, cnt, sizeof *snap, bf_sys_trace_snap_cmp);
+
+  /* Output the newest records that fit into buf, oldest first. */
+  for (i = cnt; i > 0; i--) {
+    len = bf_sys_trace_line_format(&snap[i - 1], line, sizeof line);
+    if (pos + len >= size) break;
+    pos += len;
+  }
+  pos = 0;
+  for (; i < cnt; i++) {
+    len = bf_sys_trace_line_format(&snap[i], line, sizeof line);
+    memcpy(buf + pos, line, len);
+    pos += len;
+  }
+  buf[pos] = '\0';
+  *len_written = pos;
+  bf_sys_free(snap);
   return 0;
 }
 
-int bf_sys_trace_reset(void) { return 0; }
+int bf_sys_trace_reset(void) {
+  bf_sys_trace_ring_t *r;
+
+  for (r = __atomic_load_n(&bf_sys_trace_rings, __ATOMIC_ACQUIRE); r;
+       r = r->next) {
+    __atomic_store_n(&r->tail, __atomic_load_n(&r->head, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELAXED);
+  }
+  return 0;
+}
 
 int bf_sys_syslog_level_set(int bf_level) {
   char sed_cmd[100];
@@ -22,31 +22,251 @@
  */
 
 #include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
-#include <libev/ev.h>
 #include <target-sys/bf_sal/bf_sys_mem.h>
 #include <target-sys/bf_sal/bf_sys_timer.h>
 
+/*
+ * Timers are kept in a hierarchical timing wheel with a resolution of one
+ * millisecond.  Level 0 has a slot per tick for the next 256 ticks, each of
+ * the higher levels covers 256 times the range of the level below, so four
+ * levels cover the full 32 bit range of start_msecs and period_msecs.  When
+ * the level 0 index wraps the matching slot of the next level is cascaded
+ * down.  Start and stop are a list insert and unlink, and all timers expiring
+ * on the same tick are run back to back by the timer thread in one batch.
+ *
+ * The per timer state lives in nodes handed out from chunks of
+ * BF_SYS_TW_CHUNK_SZ nodes so that creating a timer does not malloc.
+ */
+#define BF_SYS_TW_LEVELS 4
+#define BF_SYS_TW_BITS 8
+#define BF_SYS_TW_SLOTS (1 << BF_SYS_TW_BITS)
+#define BF_SYS_TW_MASK (BF_SYS_TW_SLOTS - 1)
+#define BF_SYS_TW_CHUNK_SZ 1024
+/* Node is not in the wheel. */
+#define BF_SYS_TW_IDLE 0xFFFF
+/* Node has expired and is waiting in the batch to have its callback run. */
+#define BF_SYS_TW_EXPIRED 0xFFFE
+
+typedef struct bf_sys_tw_link_s {
+  struct bf_sys_tw_link_s *next;
+  struct bf_sys_tw_link_s *prev;
+} bf_sys_tw_link_t;
+
+typedef struct bf_sys_tw_node_s {
+  bf_sys_tw_link_t link; /* Must be first */
+  bf_sys_timer_t *t;
+  uint64_t expires;
+  uint32_t start_ms;
+  uint32_t period_ms;
+  /* Level * BF_SYS_TW_SLOTS + slot the node is linked in, or one of
+   * BF_SYS_TW_IDLE and BF_SYS_TW_EXPIRED. */
+  uint16_t where;
+} bf_sys_tw_node_t;
+
+typedef struct bf_sys_tw_chunk_s {
+  struct bf_sys_tw_chunk_s *next;
+  bf_sys_tw_node_t nodes[BF_SYS_TW_CHUNK_SZ];
+} bf_sys_tw_chunk_t;
+
 typedef struct {
-  ev_async async_w;
   pthread_mutex_t lock;
+  pthread_cond_t cond;
   int inited;
-  struct ev_loop *loop;
-} userdata;
+  struct timespec base;
+  /* Next tick to be processed, everything before it has been run. */
+  uint64_t cur;
+  /* Tick the timer thread sleeps until, used to decide if a start has to wake
+   * it up. */
+  uint64_t wake;
+  uint32_t pending;
+  bf_sys_tw_link_t wheel[BF_SYS_TW_LEVELS][BF_SYS_TW_SLOTS];
+  /* Non-empty level 0 slots. */
+  uint64_t l0_bmp[BF_SYS_TW_SLOTS / 64];
+  bf_sys_tw_link_t expired;
+  bf_sys_tw_node_t *free_list;
+  bf_sys_tw_chunk_t *chunks;
+} bf_sys_tw_t;
+
+static bf_sys_tw_t tw = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+/* Set on the timer thread, which holds tw.lock while running callbacks so that
+ * the API can be called from a callback without deadlocking. */
+static __thread int tw_owner;
+
+static inline void tw_lock(void) {
+  if (!tw_owner) pthread_mutex_lock(&tw.lock);
+}
+
+static inline void tw_unlock(void) {
+  if (!tw_owner) pthread_mutex_unlock(&tw.lock);
+}
+
+static inline void tw_list_init(bf_sys_tw_link_t *head) {
+  head->next = head->prev = head;
+}
+
+static inline bool tw_list_empty(const bf_sys_tw_link_t *head) {
+  return head->next == head;
+}
+
+static inline void tw_list_add_tail(bf_sys_tw_link_t *head,
+                                    bf_sys_tw_link_t *l) {
+  l->prev = head->prev;
+  l->next = head;
+  head->prev->next = l;
+  head->prev = l;
+}
+
+/* Move all entries of src to the tail of dst, src is left empty. */
+static inline void tw_list_splice(bf_sys_tw_link_t *dst,
+                                  bf_sys_tw_link_t *src) {
+  if (tw_list_empty(src)) return;
+  src->next->prev = dst->prev;
+  dst->prev->next = src->next;
+  src->prev->next = dst;
+  dst->prev = src->prev;
+  tw_list_init(src);
+}
+
+static uint64_t tw_now(void) {
+  struct timespec ts;
+  int64_t ns;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  ns = (int64_t)(ts.tv_sec - tw.base.tv_sec) * 1000000000 +
+       (ts.tv_nsec - tw.base.tv_nsec);
+  return ns / 1000000;
+}
+
+static void tw_insert(bf_sys_tw_node_t *n) {
+  uint64_t delta;
+  int level, slot;
+
+  if (n->expires < tw.cur) n->expires = tw.cur;
+  delta = n->expires - tw.cur;
+  for (level = 0; level < BF_SYS_TW_LEVELS - 1; level++) {
+    if (delta < (1ull << (BF_SYS_TW_BITS * (level + 1)))) break;
+  }
+  if (delta >> (BF_SYS_TW_BITS * BF_SYS_TW_LEVELS)) {
+    /* Only possible if tw.cur lags far behind, clamp to the top level. */
+    n->expires = tw.cur + (1ull << (BF_SYS_TW_BITS * BF_SYS_TW_LEVELS)) - 1;
+  }
+  slot = (n->expires >> (BF_SYS_TW_BITS * level)) & BF_SYS_TW_MASK;
+  tw_list_add_tail(&tw.wheel[level][slot], &n->link);
+  n->where = level * BF_SYS_TW_SLOTS + slot;
+  if (level == 0) tw.l0_bmp[slot / 64] |= 1ull << (slot % 64);
+}
+
+static void tw_unlink(bf_sys_tw_node_t *n) {
+  bf_sys_tw_link_t *l = &n->link;
+  int slot = n->where;
+
+  l->prev->next = l->next;
+  l->next->prev = l->prev;
+  if (slot < BF_SYS_TW_SLOTS && tw_list_empty(&tw.wheel[0][slot])) {
+    tw.l0_bmp[slot / 64] &= ~(1ull << (slot % 64));
+  }
+  n->where = BF_SYS_TW_IDLE;
+}
+
+/* Re-file all timers of a slot relative to tw.cur. */
+static void tw_cascade(int level, int slot) {
+  bf_sys_tw_link_t head, *l;
+
+  tw_list_init(&head);
+  tw_list_splice(&head, &tw.wheel[level][slot]);
+  while (!tw_list_empty(&head)) {
+    l = head.next;
+    l->prev->next = l->next;
+    l->next->prev = l->prev;
+    tw_insert((bf_sys_tw_node_t *)l);
+  }
+}
+
+/* Returns the next tick at or after tw.cur that needs processing, either a
+ * non-empty level 0 slot or the next cascade. */
+static uint64_t tw_next_tick(void) {
+  int idx = tw.cur & BF_SYS_TW_MASK;
+  int w = idx / 64;
+  uint64_t bits = tw.l0_bmp[w] & (~0ull << (idx % 64));
+
+  if (!tw.pending) return UINT64_MAX;
+  while (!bits && ++w < BF_SYS_TW_SLOTS / 64) bits = tw.l0_bmp[w];
+  if (bits) {
+    return (tw.cur & ~(uint64_t)BF_SYS_TW_MASK) + w * 64 + __builtin_ctzll(bits);
+  }
+  return (tw.cur | BF_SYS_TW_MASK) + 1;
+}
+
+/* Run the callbacks of all timers expired at tick tw.cur and move on to the
+ * next tick.  Periodic timers are re-armed before their callback runs so the
+ * callback is free to stop, restart or delete its own timer. */
+static void tw_run_tick(uint64_t now) {
+  int idx = tw.cur & BF_SYS_TW_MASK;
+  bf_sys_tw_link_t *l;
+  bf_sys_tw_node_t *n;
+  bf_sys_timer_t *t;
+
+  if (idx == 0) {
+    for (int level = 1; level < BF_SYS_TW_LEVELS; level++) {
+      int slot = (tw.cur >> (BF_SYS_TW_BITS * level)) & BF_SYS_TW_MASK;
+      tw_cascade(level, slot);
+      if (slot) break;
+    }
+  }
+  tw_list_splice(&tw.expired, &tw.wheel[0][idx]);
+  tw.l0_bmp[idx / 64] &= ~(1ull << (idx % 64));
+  for (l = tw.expired.next; l != &tw.expired; l = l->next) {
+    ((bf_sys_tw_node_t *)l)->where = BF_SYS_TW_EXPIRED;
+  }
+  tw.cur++;
+
+  while (!tw_list_empty(&tw.expired)) {
+    n = (bf_sys_tw_node_t *)tw.expired.next;
+    tw_unlink(n);
+    t = n->t;
+    if (n->period_ms) {
+      n->expires += n->period_ms;
+      if (n->expires < now) n->expires = now;
+      tw_insert(n);
+    } else {
+      tw.pending--;
+    }
+    t->cb_fn(t, t->cb_data);
+  }
+}
 
-userdata u;
+static bf_sys_tw_node_t *tw_node_alloc(void) {
+  bf_sys_tw_chunk_t *c;
+  bf_sys_tw_node_t *n;
+
+  if (!tw.free_list) {
+    c = bf_sys_calloc(1, sizeof *c);
+    if (!c) return NULL;
+    c->next = tw.chunks;
+    tw.chunks = c;
+    for (int i = BF_SYS_TW_CHUNK_SZ - 1; i >= 0; i--) {
+      c->nodes[i].link.next = (bf_sys_tw_link_t *)tw.free_list;
+      tw.free_list = &c->nodes[i];
+    }
+  }
+  n = tw.free_list;
+  tw.free_list = (bf_sys_tw_node_t *)n->link.next;
+  n->where = BF_SYS_TW_IDLE;
+  return n;
+}
 
-static void timeout_cb(EV_P_ ev_timer *w, int revents) {
-  /* Call the users callback with data */
-  bf_sys_timer_t *t = (bf_sys_timer_t *)w->data;
-  t->cb_fn(t, t->cb_data);
-  (void)EV_A;
-  (void)revents;
+static void tw_node_free(bf_sys_tw_node_t *n) {
+  n->t = NULL;
+  n->link.next = (bf_sys_tw_link_t *)tw.free_list;
+  tw.free_list = n;
 }
 
 bf_sys_timer_status_t bf_sys_timer_create(bf_sys_timer_t *t,
@@ -54,70 +274,67 @@ bf_sys_timer_status_t bf_sys_timer_create(bf_sys_timer_t *t,
                                           uint32_t period_msecs,
                                           bf_sys_timeout_cb cb_fn,
                                           void *cb_data) {
-  ev_timer *evt;
-  double start = (double)start_msecs / 1000;
-  double period = (double)period_msecs / 1000;
+  bf_sys_tw_node_t *n;
 
   if ((t == NULL) || (cb_fn == NULL)) {
     return BF_SYS_TIMER_INVALID_ARG;
   }
 
-  evt = (ev_timer *)bf_sys_malloc(sizeof(ev_timer));
-  if (!evt) {
+  tw_lock();
+  n = tw_node_alloc();
+  tw_unlock();
+  if (!n) {
     return BF_SYS_TIMER_NO_RESOURCES;
   }
 
-  evt->data = t;
+  n->t = t;
+  n->start_ms = start_msecs;
+  n->period_ms = period_msecs;
   t->cb_fn = cb_fn;
   t->cb_data = cb_data;
-  t->timer = (void *)evt;
-  ev_timer_init(evt, timeout_cb, start, period);
+  t->timer = (void *)n;
   return BF_SYS_TIMER_OK;
 }
 
 bf_sys_timer_status_t bf_sys_timer_start(bf_sys_timer_t *t) {
-  int status = 0;
-  ev_timer *evt = NULL;
+  bf_sys_tw_node_t *n = NULL;
   if ((t == NULL) || (t->timer == NULL)) {
     return BF_SYS_TIMER_INVALID_ARG;
   }
-  evt = (ev_timer *)t->timer;
-  if (!u.inited) {
+  n = (bf_sys_tw_node_t *)t->timer;
+  if (!tw.inited) {
     return BF_SYS_TIMER_NOT_INITED;
   }
-  status = pthread_mutex_lock(&u.lock);
-  if (status != 0) {
-    return BF_SYS_TIMER_NO_RESOURCES;
-  }
-  ev_timer_start(u.loop, evt);
-  ev_async_send(u.loop, &u.async_w);
-  status = pthread_mutex_unlock(&u.lock);
-  if (status != 0) {
-    return BF_SYS_TIMER_NO_RESOURCES;
+  tw_lock();
+  /* Starting a running timer is a no-op. */
+  if (n->where == BF_SYS_TW_IDLE) {
+    uint64_t now = tw_now();
+    /* The wheel is not advanced while it is empty, catch up first. */
+    if (!tw.pending && now > tw.cur) tw.cur = now;
+    n->expires = now + n->start_ms;
+    tw_insert(n);
+    tw.pending++;
+    if (n->expires < tw.wake) pthread_cond_signal(&tw.cond);
   }
+  tw_unlock();
   return BF_SYS_TIMER_OK;
 }
 
 bf_sys_timer_status_t bf_sys_timer_stop(bf_sys_timer_t *t) {
-  int status = 0;
-  ev_timer *evt = NULL;
+  bf_sys_tw_node_t *n = NULL;
   if ((t == NULL) || (t->timer == NULL)) {
     return BF_SYS_TIMER_INVALID_ARG;
   }
-  evt = (ev_timer *)t->timer;
-  if (!u.inited) {
+  n = (bf_sys_tw_node_t *)t->timer;
+  if (!tw.inited) {
     return BF_SYS_TIMER_NOT_INITED;
   }
-  status = pthread_mutex_lock(&u.lock);
-  if (status != 0) {
-    return BF_SYS_TIMER_NO_RESOURCES;
-  }
-  ev_timer_stop(u.loop, evt);
-  ev_async_send(u.loop, &u.async_w);
-  status = pthread_mutex_unlock(&u.lock);
-  if (status != 0) {
-    return BF_SYS_TIMER_NO_RESOURCES;
+  tw_lock();
+  if (n->where != BF_SYS_TW_IDLE) {
+    tw_unlink(n);
+    tw.pending--;
   }
+  tw_unlock();
   return BF_SYS_TIMER_OK;
 }
 
@@ -128,57 +345,69 @@ bf_sys_timer_status_t bf_sys_timer_del(bf_sys_timer_t *t) {
 
   bf_sys_timer_stop(t);
 
-  bf_sys_free(t->timer);
+  tw_lock();
+  tw_node_free((bf_sys_tw_node_t *)t->timer);
+  tw_unlock();
 
   t->cb_fn = NULL;
   t->timer = NULL;
   return BF_SYS_TIMER_OK;
 }
 
-static void async_cb(EV_P_ ev_async *w, int revents) {
-  (void)EV_A;
-  (void)revents;
-  (void)w;
-  /* Do nothing */
-}
-
-static void l_release(EV_P) {
-  pthread_mutex_unlock(&u.lock);
-  (void)EV_A;
-}
-
-static void l_acquire(EV_P) {
-  pthread_mutex_lock(&u.lock);
-  (void)EV_A;
-}
-
 /** Never-ending function. */
 bf_sys_timer_status_t bf_sys_timer_init(void) {
-  u.loop = EV_DEFAULT; /* or ev_default_loop (0); */
+  pthread_condattr_t attr;
+  struct timespec ts;
+  uint64_t now, next, ms;
 
-  if (!u.loop)
+  if (pthread_condattr_init(&attr) ||
+      pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) ||
+      pthread_cond_init(&tw.cond, &attr)) {
     return BF_SYS_TIMER_NO_RESOURCES;
+  }
+  pthread_condattr_destroy(&attr);
+
+  pthread_mutex_lock(&tw.lock);
+  clock_gettime(CLOCK_MONOTONIC, &tw.base);
+  for (int level = 0; level < BF_SYS_TW_LEVELS; level++) {
+    for (int slot = 0; slot < BF_SYS_TW_SLOTS; slot++) {
+      tw_list_init(&tw.wheel[level][slot]);
+    }
+  }
+  tw_list_init(&tw.expired);
+  tw.cur = 0;
+  tw.wake = UINT64_MAX;
+  tw.inited = 1;
+  tw_owner = 1;
+
+  for (;;) {
+    now = tw_now();
+    next = tw_next_tick();
+    if (next <= now) {
+      /* Skip over empty ticks straight to the next one with work. */
+      tw.cur = next;
+      tw_run_tick(now);
+      continue;
+    }
+    if (next == UINT64_MAX) {
+      tw.cur = now;
+      tw.wake = UINT64_MAX;
+      pthread_cond_wait(&tw.cond, &tw.lock);
+    } else {
+      tw.wake = next;
+      ms = next;
+      ts.tv_sec = tw.base.tv_sec + ms / 1000;
+      ts.tv_nsec = tw.base.tv_nsec + (ms % 1000) * 1000000;
+      if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+      }
+      pthread_cond_timedwait(&tw.cond, &tw.lock, &ts);
+    }
+  }
 
-/* dereferencing type-punned pointer will break strict-aliasing rules
- * so, apply temporary GCC diagnostics pragma
- * the possibly breakage is in the third party header file, ev.h
- */
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstrict-aliasing"
-  ev_async_init(&u.async_w, async_cb);
-#pragma GCC diagnostic pop
-
-  ev_async_start(u.loop, &u.async_w);
-
-  u.inited = 1;
-
-  pthread_mutex_init(&u.lock, 0);
-
-  ev_set_loop_release_cb(u.loop, l_release, l_acquire);
-
-  l_acquire(u.loop);
-  ev_loop(u.loop, 0);
-  l_release(u.loop);
+  tw_owner = 0;
+  pthread_mutex_unlock(&tw.lock);
   return BF_SYS_TIMER_OK;
 }
 
@@ -15,8 +15,11 @@
  ******************************************************************************/
 
 #include <assert.h>
+#include <inttypes.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <target-sys/bf_sal/bf_sys_dma.h>
 
@@ -101,6 +104,157 @@ static int test_dma_2_virt(void) {
   return 0;
 }
 
+#define CACHE_TEST_BUF_CNT 256
+#define CACHE_TEST_THREADS 4
+#define CACHE_TEST_ITER 100000
+#define CACHE_TEST_HELD 8
+
+static bf_sys_dma_pool_handle_t cache_hndl;
+
+static void *cache_test_thread(void *arg) {
+  uintptr_t id = (uintptr_t)arg;
+  void *held[CACHE_TEST_HELD];
+  bf_phys_addr_t pa;
+  int i, j;
+
+  for (i = 0; i < CACHE_TEST_ITER; i++) {
+    for (j = 0; j < CACHE_TEST_HELD; j++) {
+      if (bf_sys_dma_alloc(cache_hndl, 64, &held[j], &pa) != 0) {
+        return (void *)1;
+      }
+      /* stamp the buffer, a buffer handed out twice gets overwritten */
+      *(uintptr_t *)held[j] = id;
+    }
+    for (j = 0; j < CACHE_TEST_HELD; j++) {
+      if (*(uintptr_t *)held[j] != id) {
+        return (void *)1;
+      }
+      bf_sys_dma_free(cache_hndl, held[j]);
+    }
+  }
+  return NULL;
+}
+
+static int test_dma_cache(void) {
+  pthread_t thr[CACHE_TEST_THREADS];
+  static void *bufs[CACHE_TEST_BUF_CNT];
+  static uint8_t seen[CACHE_TEST_BUF_CNT];
+  bf_sys_dma_pool_stats_t stats;
+  bf_phys_addr_t pa;
+  void *extra;
+  uintptr_t i;
+  void *thr_err;
+  int result = 0;
+
+  if (bf_sys_dma_pool_create("testcache", &cache_hndl, 0, 0, 64,
+                             CACHE_TEST_BUF_CNT, 64) != 0) {
+    printf("cannot alloc cache test pool\n");
+    return -1;
+  }
+  if (bf_sys_dma_pool_cache_set(cache_hndl, 16) != 0) {
+    printf("cannot enable pool cache\n");
+    result = -1;
+    goto done;
+  }
+
+  for (i = 0; i < CACHE_TEST_THREADS; i++) {
+    pthread_create(&thr[i], NULL, cache_test_thread, (void *)i);
+  }
+  for (i = 0; i < CACHE_TEST_THREADS; i++) {
+    pthread_join(thr[i], &thr_err);
+    if (thr_err != NULL) {
+      printf("cache test thread %d failed\n", (int)i);
+      result = -1;
+    }
+  }
+
+  bf_sys_dma_pool_stats_get(cache_hndl, &stats);
+  if (stats.free_bufs + stats.cached_bufs != stats.buf_cnt) {
+    printf("cache test lost buffers: %u free %u cached of %u\n",
+           stats.free_bufs, stats.cached_bufs, stats.buf_cnt);
+    result = -1;
+    goto done;
+  }
+
+  /* every buffer must still be reachable, including the ones parked in the
+     exited threads' caches */
+  memset(seen, 0, sizeof(seen));
+  for (i = 0; i < CACHE_TEST_BUF_CNT; i++) {
+    int idx;
+    if (bf_sys_dma_alloc(cache_hndl, 64, &bufs[i], &pa) != 0) {
+      printf("cache test could only alloc %d buffers\n", (int)i);
+      result = -1;
+      goto done;
+    }
+    idx = bf_sys_dma_buffer_index(cache_hndl, bufs[i]);
+    if (seen[idx]++) {
+      printf("cache test buffer %d handed out twice\n", idx);
+      result = -1;
+      goto done;
+    }
+  }
+  if (bf_sys_dma_alloc(cache_hndl, 64, &extra, &pa) == 0) {
+    printf("cache test allocated more buffers than the pool holds\n");
+    result = -1;
+    goto done;
+  }
+  for (i = 0; i < CACHE_TEST_BUF_CNT; i++) {
+    bf_sys_dma_free(cache_hndl, bufs[i]);
+  }
+
+  bf_sys_dma_pool_stats_get(cache_hndl, &stats);
+  printf("DMA pool cache test OK: hits %" PRIu64 " refills %" PRIu64
+         " drains %" PRIu64 " steals %" PRIu64 "\n",
+         stats.cache_hits, stats.cache_refills, stats.cache_drains,
+         stats.cache_steals);
+
+done:
+  bf_sys_dma_pool_destroy(cache_hndl);
+  return result;
+}
+
+/* toggle the cache while the threads allocate and free, once it ends
+ * disabled no buffer may be left parked in a magazine */
+static int test_dma_cache_disable(void) {
+  pthread_t thr[CACHE_TEST_THREADS];
+  bf_sys_dma_pool_stats_t stats;
+  uintptr_t i;
+  void *thr_err;
+  int result = 0;
+
+  if (bf_sys_dma_pool_create("testcachedis", &cache_hndl, 0, 0, 64,
+                             CACHE_TEST_BUF_CNT, 64) != 0) {
+    printf("cannot alloc cache disable test pool\n");
+    return -1;
+  }
+  bf_sys_dma_pool_cache_set(cache_hndl, 16);
+  for (i = 0; i < CACHE_TEST_THREADS; i++) {
+    pthread_create(&thr[i], NULL, cache_test_thread, (void *)i);
+  }
+  for (i = 0; i < 1000; i++) {
+    bf_sys_dma_pool_cache_set(cache_hndl, i & 1 ? 16 : 0);
+  }
+  bf_sys_dma_pool_cache_set(cache_hndl, 0);
+  for (i = 0; i < CACHE_TEST_THREADS; i++) {
+    pthread_join(thr[i], &thr_err);
+    if (thr_err != NULL) {
+      printf("cache disable test thread %d failed\n", (int)i);
+      result = -1;
+    }
+  }
+
+  bf_sys_dma_pool_stats_get(cache_hndl, &stats);
+  if (stats.cached_bufs != 0 || stats.free_bufs != stats.buf_cnt) {
+    printf("cache disable test left %u cached %u free of %u\n",
+           stats.cached_bufs, stats.free_bufs, stats.buf_cnt);
+    result = -1;
+  } else {
+    printf("DMA pool cache disable test OK\n");
+  }
+  bf_sys_dma_pool_destroy(cache_hndl);
+  return result;
+}
+
 static int dma_mem_test() {
   int ret, i, j;
   int result = 0;
@@ -147,6 +301,16 @@ static int dma_mem_test() {
   }
 
   result = test_dma_2_virt();
+  if (result != 0) {
+    goto free_dma_buff;
+  }
+
+  result = test_dma_cache();
+  if (result != 0) {
+    goto free_dma_buff;
+  }
+
+  result = test_dma_cache_disable();
 
 free_dma_buff:
   for (i = 0; i < DMA_POOL_CNT; i++) {
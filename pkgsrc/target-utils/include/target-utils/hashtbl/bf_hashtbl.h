@@ -30,6 +30,26 @@ typedef enum bf_hashtbl_sts_t {
 typedef int (*bf_htbl_cmp_fn)(const void *, const void *);
 typedef void (*bf_htbl_free_fn)(void *);
 
+/* How the table gets the nodes linking user data into its buckets. */
+typedef enum bf_hashtbl_mode_t {
+  /* A node is allocated on every insert and freed on every removal. */
+  BF_HASHTBL_MODE_ALLOC,
+  /* Nodes are carved out of slabs owned by the table and recycled through a
+   * free list, the slabs are only released by bf_hashtbl_delete. */
+  BF_HASHTBL_MODE_SLAB,
+  /* The caller embeds a bf_hashtbl_node_t in each object and inserts it with
+   * bf_hashtbl_insert_node, the table never allocates or frees nodes. */
+  BF_HASHTBL_MODE_INTRUSIVE,
+} bf_hashtbl_mode_t;
+
+/* Node linking an object into a hash table.  The comparison and foreach
+ * callbacks are passed a pointer to the node, use bf_hashtbl_get_cmp_data to
+ * get back to the object. */
+typedef struct bf_hashtbl_node_ {
+  void *data;
+  void *link[4]; /* Private to the hash table */
+} bf_hashtbl_node_t;
+
 typedef struct bf_hashtable_ {
   /* Comparison function */
   bf_htbl_cmp_fn cmp_fn;
@@ -38,7 +58,9 @@ typedef struct bf_hashtable_ {
   size_t key_sz;  /* Key size in bytes */
   size_t data_sz; /* Data size in bytes */
   uint32_t seed;  /* Seed for the hash table */
+  bf_hashtbl_mode_t mode;
   void *phtbl;
+  void *slab; /* Node slabs, BF_HASHTBL_MODE_SLAB only */
 } bf_hashtable_t;
 
 bf_hashtbl_sts_t bf_hashtbl_init(bf_hashtable_t *htbl,
@@ -48,10 +70,38 @@ bf_hashtbl_sts_t bf_hashtbl_init(bf_hashtable_t *htbl,
                                  uint8_t data_sz,
                                  uint32_t seed);
 
+/* Same as bf_hashtbl_init but selects how nodes are managed. */
+bf_hashtbl_sts_t bf_hashtbl_init_mode(bf_hashtable_t *htbl,
+                                      int (*fn)(const void *, const void *),
+                                      void (*free_fn)(void *),
+                                      uint8_t key_sz,
+                                      uint8_t data_sz,
+                                      uint32_t seed,
+                                      bf_hashtbl_mode_t mode);
+
 void *bf_hashtbl_search(bf_hashtable_t *htbl, void *key);
 
+/* Look up cnt keys at once, data[i] is set to the object matching keys[i] or
+ * NULL.  All hashes of a batch are computed and their buckets prefetched
+ * before any of them is walked so the cache misses overlap.  Returns the
+ * number of keys found. */
+int bf_hashtbl_search_bulk(bf_hashtable_t *htbl,
+                           void *const *keys,
+                           int cnt,
+                           void **data);
+
 bf_hashtbl_sts_t bf_hashtbl_insert(bf_hashtable_t *htbl, void *node, void *key);
 
+/* Insert an object using the node embedded in it, BF_HASHTBL_MODE_INTRUSIVE
+ * tables only.  The node must stay valid until it is removed. */
+bf_hashtbl_sts_t bf_hashtbl_insert_node(bf_hashtable_t *htbl,
+                                        bf_hashtbl_node_t *hnode,
+                                        void *data,
+                                        void *key);
+
+/* Unlink an embedded node without looking up its key, returns its data. */
+void *bf_hashtbl_remove_node(bf_hashtable_t *htbl, bf_hashtbl_node_t *hnode);
+
 void *bf_hashtbl_get_remove(bf_hashtable_t *htbl, void *key);
 
 typedef void bf_hashtable_foreach_fn_t(void *arg, void *obj);
@@ -56,6 +56,26 @@ int bf_id_allocator_get_next(bf_id_allocator *allocator, unsigned int id);
 void bf_id_allocator_copy(bf_id_allocator *dst_allocator,
                           bf_id_allocator *src_allocator);
 
+/* Variant of the allocator which may be used from several threads at once.
+ * Each thread reserves a block of up to 64 free ids from the shared bitmap and
+ * hands them out without taking the shared lock.  Reserved ids which have not
+ * been handed out can be returned with bf_id_allocator_mt_flush. */
+typedef void *bf_id_allocator_mt;
+
+bf_id_allocator_mt *bf_id_allocator_mt_new(unsigned int size,
+                                           bool zero_based);
+
+void bf_id_allocator_mt_destroy(bf_id_allocator_mt *allocator);
+
+int bf_id_allocator_mt_allocate(bf_id_allocator_mt *allocator);
+
+void bf_id_allocator_mt_release(bf_id_allocator_mt *allocator,
+                                unsigned int id);
+
+int bf_id_allocator_mt_is_set(bf_id_allocator_mt *allocator, unsigned int id);
+
+void bf_id_allocator_mt_flush(bf_id_allocator_mt *allocator);
+
 #ifdef __cplusplus
 }
 #endif
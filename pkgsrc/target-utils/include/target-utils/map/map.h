@@ -17,6 +17,7 @@
 #define _bf_map_h_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* Utility to map an unsigned long to a pointer.  Pointers can be added to a
  * database using unsigned longs as their keys.  They can then be looked up
@@ -33,6 +34,12 @@ typedef enum bf_map_sts_t {
   BF_MAP_KEY_EXISTS
 } bf_map_sts_t;
 
+/* A key/data pair as returned by the bulk accessors below. */
+typedef struct bf_map_pair_t {
+  unsigned long key;
+  void *data;
+} bf_map_pair_t;
+
 bf_map_sts_t bf_map_add(bf_map_t *map, unsigned long key, void *data);
 bf_map_sts_t bf_map_rmv(bf_map_t *map, unsigned long key);
 bf_map_sts_t bf_map_get(bf_map_t *map, unsigned long key, void **data);
@@ -46,4 +53,38 @@ bf_map_sts_t bf_map_init(bf_map_t *map);
 void bf_map_destroy(bf_map_t *map);
 uint32_t bf_map_count(bf_map_t *map);
 
+/* Bulk accessors.  These walk the map once per call rather than once per key
+ * and are intended for table dumps, syncs and HA replay where a large number
+ * of keys are visited in order.
+ *
+ * bf_map_get_many: Looks up cnt keys, storing the data for keys[i] in data[i]
+ *   or NULL if the key is not present.  Keys should be sorted in ascending
+ *   order; each search then continues from the previous key found, so a run
+ *   of present keys costs one step each and absent keys below the next
+ *   present one need no lookup.  Unsorted input is still handled correctly.
+ *   Returns the number of keys found or -1 on error.
+ * bf_map_get_range: Fills pairs with up to max entries whose key lies in the
+ *   range [*cursor, end], in ascending key order.  *done is set once no key of
+ *   the range follows the ones returned; until then *cursor is set to the next
+ *   key so the call can be repeated to continue the scan.  Returns the number
+ *   of pairs filled in or -1 on error.
+ * bf_map_add_sorted: Adds cnt entries whose keys are in strictly ascending
+ *   order.  Either all entries are added or, if any key is already present
+ *   (BF_MAP_KEY_EXISTS) or the keys are not ascending (BF_MAP_ERR), none are.
+ */
+int bf_map_get_many(bf_map_t *map,
+                    const unsigned long *keys,
+                    int cnt,
+                    void **data);
+int bf_map_get_range(bf_map_t *map,
+                     unsigned long *cursor,
+                     unsigned long end,
+                     bf_map_pair_t *pairs,
+                     int max,
+                     bool *done);
+bf_map_sts_t bf_map_add_sorted(bf_map_t *map,
+                               const unsigned long *keys,
+                               void *const *data,
+                               int cnt);
+
 #endif
@@ -18,10 +18,27 @@
 #include "target-utils/hashtbl/bf_hashtbl.h"
 #include "xxhash.h"
 
-typedef struct bf_hashtbl_node_ {
-  void *data;
-  tommy_node tommy_obj;
-} bf_hashtbl_node_t;
+/* The tommy node is kept in the opaque link area of bf_hashtbl_node_t so that
+ * callers can embed nodes without seeing tommyds. */
+#define HTBL_TOMMY_NODE(n) ((tommy_node *)(void *)(n)->link)
+_Static_assert(sizeof(((bf_hashtbl_node_t *)0)->link) >= sizeof(tommy_node),
+               "bf_hashtbl_node_t link area too small");
+
+/* Number of nodes carved out of each slab in BF_HASHTBL_MODE_SLAB. */
+#define BF_HASHTBL_SLAB_NODES 1024
+/* Number of keys bf_hashtbl_search_bulk hashes and prefetches at a time. */
+#define BF_HASHTBL_BULK_WINDOW 16
+
+typedef struct bf_hashtbl_slab_ {
+  struct bf_hashtbl_slab_ *next;
+  bf_hashtbl_node_t nodes[BF_HASHTBL_SLAB_NODES];
+} bf_hashtbl_slab_t;
+
+typedef struct bf_hashtbl_slab_pool_ {
+  bf_hashtbl_slab_t *slabs;
+  /* Free nodes, chained through their data pointer. */
+  bf_hashtbl_node_t *free_list;
+} bf_hashtbl_slab_pool_t;
 
 static bf_hash_t construct_hash(bf_hashtable_t *htbl, unsigned char *key) {
   uint8_t key_sz = htbl->key_sz;
@@ -29,13 +46,49 @@ static bf_hash_t construct_hash(bf_hashtable_t *htbl, unsigned char *key) {
   return XXH32(key, key_sz, htbl->seed);
 }
 
+static bf_hashtbl_node_t *bf_htbl_node_alloc(bf_hashtable_t *htbl) {
+  if (htbl->mode != BF_HASHTBL_MODE_SLAB) {
+    return bf_sys_calloc(1, sizeof(bf_hashtbl_node_t));
+  }
+
+  bf_hashtbl_slab_pool_t *pool = htbl->slab;
+  if (!pool->free_list) {
+    bf_hashtbl_slab_t *slab = bf_sys_malloc(sizeof(bf_hashtbl_slab_t));
+    if (slab == NULL) {
+      return NULL;
+    }
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    for (int i = BF_HASHTBL_SLAB_NODES - 1; i >= 0; i--) {
+      slab->nodes[i].data = pool->free_list;
+      pool->free_list = &slab->nodes[i];
+    }
+  }
+  bf_hashtbl_node_t *hnode = pool->free_list;
+  pool->free_list = hnode->data;
+  return hnode;
+}
+
+static void bf_htbl_node_free(bf_hashtable_t *htbl, bf_hashtbl_node_t *hnode) {
+  if (htbl->mode == BF_HASHTBL_MODE_ALLOC) {
+    bf_sys_free(hnode);
+  } else if (htbl->mode == BF_HASHTBL_MODE_SLAB) {
+    bf_hashtbl_slab_pool_t *pool = htbl->slab;
+    hnode->data = pool->free_list;
+    pool->free_list = hnode;
+  }
+}
+
 static void bf_htbl_foreach_free_fn(void *arg, void *obj) {
   bf_hashtbl_node_t *htbl_node = obj;
   bf_hashtable_t *htbl = arg;
   if (htbl->free_fn) {
     htbl->free_fn(htbl_node->data);
   }
-  bf_sys_free(obj);
+  /* Slab nodes go away with their slabs, embedded nodes with their owner. */
+  if (htbl->mode == BF_HASHTBL_MODE_ALLOC) {
+    bf_sys_free(obj);
+  }
   return;
 }
 
@@ -49,9 +102,24 @@ bf_hashtbl_sts_t bf_hashtbl_init(bf_hashtable_t *htbl,
                                  uint8_t key_sz,
                                  uint8_t data_sz,
                                  uint32_t seed) {
+  return bf_hashtbl_init_mode(
+      htbl, fn, free_fn, key_sz, data_sz, seed, BF_HASHTBL_MODE_ALLOC);
+}
+
+bf_hashtbl_sts_t bf_hashtbl_init_mode(bf_hashtable_t *htbl,
+                                      int (*fn)(const void *, const void *),
+                                      void (*free_fn)(void *),
+                                      uint8_t key_sz,
+                                      uint8_t data_sz,
+                                      uint32_t seed,
+                                      bf_hashtbl_mode_t mode) {
   if (htbl == NULL) {
     return BF_HASHTBL_INVALID_ARG;
   }
+  if (mode != BF_HASHTBL_MODE_ALLOC && mode != BF_HASHTBL_MODE_SLAB &&
+      mode != BF_HASHTBL_MODE_INTRUSIVE) {
+    return BF_HASHTBL_INVALID_ARG;
+  }
   if (key_sz == 0) {
     return BF_HASHTBL_INVALID_ARG;
   }
@@ -66,6 +134,15 @@ bf_hashtbl_sts_t bf_hashtbl_init(bf_hashtable_t *htbl,
   htbl->key_sz = key_sz;
   htbl->data_sz = data_sz;
   htbl->seed = seed;
+  htbl->mode = mode;
+  htbl->slab = NULL;
+
+  if (mode == BF_HASHTBL_MODE_SLAB) {
+    htbl->slab = bf_sys_calloc(1, sizeof(bf_hashtbl_slab_pool_t));
+    if (htbl->slab == NULL) {
+      return BF_HASHTBL_ERR;
+    }
+  }
 
   htbl->phtbl = bf_sys_malloc(sizeof(tommy_hashlin));
   tommy_hashlin_init((tommy_hashlin *)(htbl->phtbl));
@@ -94,6 +171,55 @@ void *bf_hashtbl_search(bf_hashtable_t *htbl, void *key) {
   return htbl_node->data;
 }
 
+int bf_hashtbl_search_bulk(bf_hashtable_t *htbl,
+                           void *const *keys,
+                           int cnt,
+                           void **data) {
+  bf_hash_t hash[BF_HASHTBL_BULK_WINDOW];
+  tommy_hashlin_node **bucket[BF_HASHTBL_BULK_WINDOW];
+  tommy_hashlin_node *head[BF_HASHTBL_BULK_WINDOW];
+  int found = 0;
+
+  if (htbl == NULL || keys == NULL || data == NULL) {
+    return 0;
+  }
+  tommy_hashlin *hashlin = htbl->phtbl;
+
+  for (int base = 0; base < cnt; base += BF_HASHTBL_BULK_WINDOW) {
+    int n = cnt - base;
+    if (n > BF_HASHTBL_BULK_WINDOW) n = BF_HASHTBL_BULK_WINDOW;
+
+    /* Hash the whole window and start fetching the bucket slots... */
+    for (int i = 0; i < n; i++) {
+      if (keys[base + i] == NULL) {
+        bucket[i] = NULL;
+        continue;
+      }
+      hash[i] = construct_hash(htbl, (unsigned char *)keys[base + i]);
+      bucket[i] = tommy_hashlin_bucket_ref(hashlin, hash[i]);
+      __builtin_prefetch(bucket[i]);
+    }
+    /* ...then the first node of each bucket... */
+    for (int i = 0; i < n; i++) {
+      head[i] = bucket[i] ? *bucket[i] : NULL;
+      if (head[i]) __builtin_prefetch(head[i]);
+    }
+    /* ...and only then walk the chains. */
+    for (int i = 0; i < n; i++) {
+      tommy_hashlin_node *t = head[i];
+      data[base + i] = NULL;
+      for (; t; t = t->next) {
+        if (t->key == hash[i] && htbl->cmp_fn(keys[base + i], t->data) == 0) {
+          data[base + i] = ((bf_hashtbl_node_t *)t->data)->data;
+          found++;
+          break;
+        }
+      }
+    }
+  }
+  return found;
+}
+
 bf_hashtbl_sts_t bf_hashtbl_insert(bf_hashtable_t *htbl,
                                    void *node,
                                    void *key) {
@@ -108,8 +234,11 @@ bf_hashtbl_sts_t bf_hashtbl_insert(bf_hashtable_t *htbl,
   if (key == NULL) {
     return BF_HASHTBL_INVALID_ARG;
   }
+  if (htbl->mode == BF_HASHTBL_MODE_INTRUSIVE) {
+    return BF_HASHTBL_INVALID_ARG;
+  }
 
-  hash_tbl_node = bf_sys_calloc(1, sizeof(bf_hashtbl_node_t));
+  hash_tbl_node = bf_htbl_node_alloc(htbl);
   if (hash_tbl_node == NULL) {
     return BF_HASHTBL_ERR;
   }
@@ -118,13 +247,45 @@ bf_hashtbl_sts_t bf_hashtbl_insert(bf_hashtable_t *htbl,
   hash = construct_hash(htbl, (unsigned char *)key);
 
   tommy_hashlin_insert((tommy_hashlin *)htbl->phtbl,
-                       &hash_tbl_node->tommy_obj,
+                       HTBL_TOMMY_NODE(hash_tbl_node),
                        hash_tbl_node,
                        hash);
 
   return BF_HASHTBL_OK;
 }
 
+bf_hashtbl_sts_t bf_hashtbl_insert_node(bf_hashtable_t *htbl,
+                                        bf_hashtbl_node_t *hnode,
+                                        void *data,
+                                        void *key) {
+  if (htbl == NULL || hnode == NULL || data == NULL || key == NULL) {
+    return BF_HASHTBL_INVALID_ARG;
+  }
+  if (htbl->mode != BF_HASHTBL_MODE_INTRUSIVE) {
+    return BF_HASHTBL_INVALID_ARG;
+  }
+
+  hnode->data = data;
+  tommy_hashlin_insert((tommy_hashlin *)htbl->phtbl,
+                       HTBL_TOMMY_NODE(hnode),
+                       hnode,
+                       construct_hash(htbl, (unsigned char *)key));
+  return BF_HASHTBL_OK;
+}
+
+void *bf_hashtbl_remove_node(bf_hashtable_t *htbl, bf_hashtbl_node_t *hnode) {
+  if (htbl == NULL || hnode == NULL) {
+    return NULL;
+  }
+  if (htbl->mode != BF_HASHTBL_MODE_INTRUSIVE) {
+    return NULL;
+  }
+
+  tommy_hashlin_remove_existing((tommy_hashlin *)htbl->phtbl,
+                                HTBL_TOMMY_NODE(hnode));
+  return hnode->data;
+}
+
 void *bf_hashtbl_get_remove(bf_hashtable_t *htbl, void *key) {
   bf_hash_t hash = 0;
   bf_hashtbl_node_t *htbl_node = NULL;
@@ -147,7 +308,7 @@ void *bf_hashtbl_get_remove(bf_hashtable_t *htbl, void *key) {
   ret_node = htbl_node->data;
 
   if (htbl_node) {
-    bf_sys_free(htbl_node);
+    bf_htbl_node_free(htbl, htbl_node);
   }
 
   return ret_node;
@@ -178,5 +339,16 @@ void bf_hashtbl_delete(bf_hashtable_t *htbl) {
   tommy_hashlin_done((tommy_hashlin *)htbl->phtbl);
   bf_sys_free(htbl->phtbl);
 
+  if (htbl->slab) {
+    bf_hashtbl_slab_pool_t *pool = htbl->slab;
+    while (pool->slabs) {
+      bf_hashtbl_slab_t *slab = pool->slabs;
+      pool->slabs = slab->next;
+      bf_sys_free(slab);
+    }
+    bf_sys_free(pool);
+    htbl->slab = NULL;
+  }
+
   return;
 }
@@ -28,7 +28,6 @@
 
 #include <target-sys/bf_sal/bf_sys_intf.h>
 #include <target-utils/id/id.h>
-#include <Judy.h>
 
 //#define BF_ID_ALLOCATOR_TEST 1
 
@@ -36,37 +35,247 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/* The allocator is a bitmap of ids (bit set when the id is allocated) with a
+ * tree of 64-ary summary bitmaps above it.  Each summary level keeps two
+ * bitmaps, one bit per word of the level below:
+ *   full - set when the child word has no free id left
+ *   used - set when the child word has at least one id allocated
+ * Finding the first free id, the next allocated id or the end of a free run is
+ * then a walk up and down the tree with one count-trailing-zeros per level
+ * rather than a scan of the whole bitmap.  Leaf words are allocated in pages on
+ * first use so that large, sparsely used allocators stay small. */
+#define ID_BMP_LEVELS_MAX 6 /* 64^6 covers the full 32 bit id space */
+#define ID_BMP_PAGE_WORDS 1024
+#define ID_BMP_NONE UINT64_MAX
+
 typedef struct bf_id_allocator_int {
-  Pvoid_t PJ1Array;
   uint32_t size;
   bool zero_based;
+  uint64_t cap;      /* Ids covered by the bitmap, multiple of 64 */
+  uint64_t **pages;  /* Leaf pages, NULL while all ids in the page are free */
+  uint32_t n_pages;
+  int levels;        /* Summary levels above the leaves */
+  uint64_t lvl_words[ID_BMP_LEVELS_MAX + 1]; /* [0] is the leaf word count */
+  uint64_t *full[ID_BMP_LEVELS_MAX + 1];
+  uint64_t *used[ID_BMP_LEVELS_MAX + 1];
 } bf_id_allocator_int;
 
+static inline uint64_t id_bmp_leaf(bf_id_allocator_int *a, uint64_t w) {
+  uint64_t *page = a->pages[w / ID_BMP_PAGE_WORDS];
+  return page ? page[w % ID_BMP_PAGE_WORDS] : 0;
+}
+
+/* Candidate bits of word wi at level l: free ids (or words with a free id) if
+ * find_free is set, allocated ids (or words with one) otherwise. */
+static inline uint64_t id_bmp_cand(bf_id_allocator_int *a,
+                                   int l,
+                                   uint64_t wi,
+                                   bool find_free) {
+  if (l == 0) {
+    uint64_t w = id_bmp_leaf(a, wi);
+    return find_free ? ~w : w;
+  }
+  return find_free ? ~a->full[l][wi] : a->used[l][wi];
+}
+
+/* Updates the summary bits of leaf word c after it changed from old to new. */
+static void id_bmp_propagate(bf_id_allocator_int *a,
+                             uint64_t c,
+                             uint64_t old,
+                             uint64_t new) {
+  bool old_full = old == UINT64_MAX, new_full = new == UINT64_MAX;
+  bool old_used = old != 0, new_used = new != 0;
+  int l;
+
+  for (l = 1; l <= a->levels && (old_full != new_full || old_used != new_used);
+       l++) {
+    uint64_t b = 1ull << (c & 63);
+    c >>= 6;
+    if (old_full != new_full) {
+      uint64_t o = a->full[l][c];
+      uint64_t n = new_full ? o | b : o & ~b;
+      a->full[l][c] = n;
+      old_full = o == UINT64_MAX;
+      new_full = n == UINT64_MAX;
+    }
+    if (old_used != new_used) {
+      uint64_t o = a->used[l][c];
+      uint64_t n = new_used ? o | b : o & ~b;
+      a->used[l][c] = n;
+      old_used = o != 0;
+      new_used = n != 0;
+    }
+  }
+}
+
+/* Replaces leaf word w with val, allocating its page if needed.  Returns false
+ * if the page could not be allocated. */
+static bool id_bmp_word_set(bf_id_allocator_int *a, uint64_t w, uint64_t val) {
+  uint64_t **page = &a->pages[w / ID_BMP_PAGE_WORDS];
+  uint64_t old;
+
+  if (!*page) {
+    if (!val) return true;
+    *page = bf_sys_calloc(ID_BMP_PAGE_WORDS, sizeof(uint64_t));
+    if (!*page) return false;
+  }
+  old = (*page)[w % ID_BMP_PAGE_WORDS];
+  (*page)[w % ID_BMP_PAGE_WORDS] = val;
+  id_bmp_propagate(a, w, old, val);
+  return true;
+}
+
+static void id_bmp_free_summary(bf_id_allocator_int *a) {
+  int l;
+  for (l = 1; l <= a->levels; l++) {
+    if (a->full[l]) bf_sys_free(a->full[l]);
+    if (a->used[l]) bf_sys_free(a->used[l]);
+    a->full[l] = a->used[l] = NULL;
+  }
+  a->levels = 0;
+}
+
+/* Sizes the bitmap for cap ids, keeping any ids already allocated.  The leaf
+ * pages are kept and the summary levels rebuilt from them. */
+static bool id_bmp_resize(bf_id_allocator_int *a, uint64_t cap) {
+  uint64_t n_words = (cap + 63) / 64;
+  uint32_t n_pages = (n_words + ID_BMP_PAGE_WORDS - 1) / ID_BMP_PAGE_WORDS;
+  uint64_t **pages;
+  uint64_t w;
+  int l;
+
+  pages = bf_sys_realloc(a->pages, n_pages * sizeof *pages);
+  if (!pages) return false;
+  memset(pages + a->n_pages, 0, (n_pages - a->n_pages) * sizeof *pages);
+  a->pages = pages;
+  a->n_pages = n_pages;
+  a->cap = n_words * 64;
+
+  id_bmp_free_summary(a);
+  a->lvl_words[0] = n_words;
+  for (l = 1; a->lvl_words[l - 1] > 1 || l == 1; l++) {
+    a->lvl_words[l] = (a->lvl_words[l - 1] + 63) / 64;
+    a->full[l] = bf_sys_calloc(a->lvl_words[l], sizeof(uint64_t));
+    a->used[l] = bf_sys_calloc(a->lvl_words[l], sizeof(uint64_t));
+    a->levels = l;
+    if (!a->full[l] || !a->used[l]) {
+      id_bmp_free_summary(a);
+      return false;
+    }
+  }
+  for (w = 0; w < n_words; w++) {
+    uint64_t val = id_bmp_leaf(a, w);
+    if (val) id_bmp_propagate(a, w, 0, val);
+  }
+  return true;
+}
+
+/* Returns the first id at or after p which is free (find_free) or allocated,
+ * or ID_BMP_NONE if there is none. */
+static uint64_t id_bmp_find(bf_id_allocator_int *a,
+                            uint64_t p,
+                            bool find_free) {
+  uint64_t idx = p, wi, w;
+  int l = 0;
+
+  if (p >= a->cap) return ID_BMP_NONE;
+  /* Climb until a word with a candidate at or after idx is found... */
+  for (;;) {
+    wi = idx >> 6;
+    if (wi >= a->lvl_words[l]) return ID_BMP_NONE;
+    w = id_bmp_cand(a, l, wi, find_free) & (UINT64_MAX << (idx & 63));
+    if (w) {
+      idx = (wi << 6) | __builtin_ctzll(w);
+      break;
+    }
+    if (l == a->levels) return ID_BMP_NONE;
+    idx = wi + 1;
+    l++;
+  }
+  /* ...then take the first candidate on each level on the way down. */
+  while (l > 0) {
+    l--;
+    /* Summary bits past the last word read as "not full", running into them
+     * means every existing id after p is taken. */
+    if (idx >= a->lvl_words[l]) return ID_BMP_NONE;
+    w = id_bmp_cand(a, l, idx, find_free);
+    idx = (idx << 6) | __builtin_ctzll(w);
+  }
+  return idx;
+}
+
+static bool id_bmp_test(bf_id_allocator_int *a, uint64_t i) {
+  if (i >= a->cap) return false;
+  return (id_bmp_leaf(a, i >> 6) >> (i & 63)) & 1;
+}
+
+static bool id_bmp_set(bf_id_allocator_int *a, uint64_t i) {
+  if (i >= a->cap) {
+    /* Ids past the initial size may still be set explicitly, grow to fit. */
+    uint64_t cap = a->cap * 2;
+    if (cap <= i) cap = i + 1;
+    if (!id_bmp_resize(a, cap)) return false;
+  }
+  return id_bmp_word_set(a, i >> 6, id_bmp_leaf(a, i >> 6) | 1ull << (i & 63));
+}
+
+static void id_bmp_clear(bf_id_allocator_int *a, uint64_t i) {
+  if (i >= a->cap) return;
+  id_bmp_word_set(a, i >> 6, id_bmp_leaf(a, i >> 6) & ~(1ull << (i & 63)));
+}
+
+/* First fit search for count free ids below limit. */
+static uint64_t id_bmp_find_run(bf_id_allocator_int *a,
+                                unsigned int count,
+                                uint64_t limit) {
+  uint64_t start = 0, first, next;
+
+  for (;;) {
+    first = id_bmp_find(a, start, true);
+    if (first == ID_BMP_NONE || first + count > limit) return ID_BMP_NONE;
+    next = id_bmp_find(a, first, false);
+    if (next == ID_BMP_NONE || next - first >= count) return first;
+    start = next;
+  }
+}
+
+static bf_id_allocator_int *id_bmp_new(unsigned int initial_size,
+                                       bool zero_based) {
+  bf_id_allocator_int *allocator = bf_sys_calloc(1, sizeof *allocator);
+  if (!allocator) return NULL;
+  allocator->zero_based = zero_based;
+  allocator->size = initial_size;
+  if (!id_bmp_resize(allocator, initial_size ? initial_size : 1)) {
+    bf_sys_free(allocator);
+    return NULL;
+  }
+  return allocator;
+}
+
+static void id_bmp_destroy(bf_id_allocator_int *a) {
+  uint32_t i;
+  id_bmp_free_summary(a);
+  for (i = 0; i < a->n_pages; i++) {
+    if (a->pages[i]) bf_sys_free(a->pages[i]);
+  }
+  if (a->pages) bf_sys_free(a->pages);
+  bf_sys_free(a);
+}
+
 /**
 Create the ID allocator
 @param initial_size the initial size of allocator
 */
 bf_id_allocator *bf_id_allocator_new(unsigned int initial_size,
                                      bool zero_based) {
-  bf_id_allocator_int *allocator =
-      (bf_id_allocator_int *)bf_sys_malloc(sizeof(bf_id_allocator_int) * 1);
-  allocator->zero_based = zero_based;
-  allocator->size = initial_size;
-  /* Initialize the Judy array */
-  allocator->PJ1Array = (Pvoid_t)NULL;
-
-  return (bf_id_allocator)allocator;
+  return (bf_id_allocator *)id_bmp_new(initial_size, zero_based);
 }
 /**
 Delete the ID allocator region
 @param allocator allocator allocated with create
 */
 void bf_id_allocator_destroy(bf_id_allocator *allocator) {
-  Word_t Rc_word;
-  /* Free the Judy array */
-  J1FA(Rc_word, ((bf_id_allocator_int *)allocator)->PJ1Array);
-  (void)Rc_word;
-  bf_sys_free(allocator);
+  id_bmp_destroy((bf_id_allocator_int *)allocator);
 }
 
 /**
@@ -76,93 +285,29 @@ Allocate count contiguous ids (max 32)
 */
 int bf_id_allocator_allocate_contiguous(bf_id_allocator *a, uint8_t count) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
+  uint64_t first_empty;
   unsigned int i;
-  int Rc_int;
-  Word_t first_empty = 0;
-  Word_t next_set = 0;
-  Word_t Index = 0;
 
   bf_sys_assert(allocator != NULL);
 
-  Index = 0;
-
-  /* Get the first empty slot : Thanks Judy :-) */
-  if (Index == 0) {
-    J1FE(Rc_int, allocator->PJ1Array, Index);
-  } else {
-    J1NE(Rc_int, allocator->PJ1Array, Index);
-  }
-
-  if (Rc_int == 0) {
-    return -1;
-  }
-
-  if (Index >= allocator->size) {
-    /* If free index returned exceeds the size of the allocator,
-     * then need to wrap around.
-     */
-
-    Index = 0;
-    J1FE(Rc_int, allocator->PJ1Array, Index);
-  }
-
-  first_empty = Index;
-
-  if (first_empty >= allocator->size) {
-    /* Nothing available */
-    return -1;
-  }
-
   if (count == 1) {
-    J1S(Rc_int, allocator->PJ1Array, first_empty);
-
-    if (allocator->zero_based == true) {
-      return first_empty;
+    first_empty = id_bmp_find(allocator, 0, true);
+    if (first_empty >= allocator->size) {
+      /* Nothing available */
+      return -1;
     }
-
-    return first_empty + 1;
-  }
-
-  /* Get next bit set */
-  J1N(Rc_int, allocator->PJ1Array, Index);
-
-  if (Rc_int == 0) {
-    /* No set Bits, which means the Judy array is empty from the
-     * "first_empty" position.
-     */
-    next_set = allocator->size;
   } else {
-    next_set = Index;
-  }
-
-  while (next_set - first_empty < count) {
-    Index = next_set;
-    J1FE(Rc_int, allocator->PJ1Array, Index);
-
-    if (Rc_int == 0) {
+    first_empty = id_bmp_find_run(allocator, count, allocator->size);
+    if (first_empty == ID_BMP_NONE) {
       return -1;
     }
-    first_empty = Index;
-
-    J1N(Rc_int, allocator->PJ1Array, Index);
-
-    if (Rc_int == 0) {
-      /* Check if there are enough */
-      if (allocator->size - Index < count) {
-        return -1;
-      }
-    } else {
-      next_set = Index;
-    }
   }
 
-  if (first_empty > allocator->size) {
-    return -1;
-  }
-
-  /* Set the bit(s) now in the Judy array */
   for (i = 0; i < count; i++) {
-    J1S(Rc_int, allocator->PJ1Array, first_empty + i);
+    if (!id_bmp_set(allocator, first_empty + i)) {
+      while (i--) id_bmp_clear(allocator, first_empty + i);
+      return -1;
+    }
   }
 
   if (allocator->zero_based == true) {
@@ -187,7 +332,6 @@ Free an allocated id
 */
 void bf_id_allocator_release(bf_id_allocator *a, unsigned int id) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
-  int Rc_int;
 
   bf_sys_assert(allocator != NULL);
 
@@ -196,14 +340,7 @@ void bf_id_allocator_release(bf_id_allocator *a, unsigned int id) {
     id = id - 1;
   }
 
-  /* JUdy Unset */
-  J1U(Rc_int, allocator->PJ1Array, id);
-
-  if (Rc_int == 1) {
-    /* Get around set but not used compile error :D
-     * CRINGE.
-     */
-  }
+  id_bmp_clear(allocator, id);
 }
 
 /**
@@ -213,7 +350,6 @@ Set an allocated id
 */
 void bf_id_allocator_set(bf_id_allocator *a, unsigned int id) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
-  int Rc_int;
 
   bf_sys_assert(allocator != NULL);
 
@@ -223,13 +359,8 @@ void bf_id_allocator_set(bf_id_allocator *a, unsigned int id) {
     id = id - 1;
   }
 
-  /* Judy Set */
-  J1S(Rc_int, allocator->PJ1Array, id);
-
-  if (Rc_int == 1) {
-    /* Get around set but not used compile error :D
-     * CRINGE.
-     */
+  if (!id_bmp_set(allocator, id)) {
+    bf_sys_dbgchk(0);
   }
 }
 
@@ -240,7 +371,6 @@ void bf_id_allocator_set(bf_id_allocator *a, unsigned int id) {
   */
 int bf_id_allocator_is_set(bf_id_allocator *a, unsigned int id) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
-  int Rc_int;
 
   bf_sys_assert(allocator != NULL);
   if (allocator->zero_based != true) {
@@ -249,9 +379,8 @@ int bf_id_allocator_is_set(bf_id_allocator *a, unsigned int id) {
     }
     id = id - 1;
   }
-  J1T(Rc_int, allocator->PJ1Array, id);
 
-  return (Rc_int == 1 ? 1 : 0);
+  return id_bmp_test(allocator, id) ? 1 : 0;
 }
 
 /**
@@ -259,24 +388,17 @@ int bf_id_allocator_is_set(bf_id_allocator *a, unsigned int id) {
   */
 int bf_id_allocator_get_first(bf_id_allocator *a) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
-  int Rc_int;
-  Word_t wd_id = 0;
-  unsigned int id = 0;
+  uint64_t first;
 
   if (allocator == NULL) {
     return -1;
   }
-  bf_sys_assert(allocator != NULL);
-  J1F(Rc_int, allocator->PJ1Array, wd_id);
-  if (Rc_int) {
-    if (allocator->zero_based != true) {
-      id = wd_id + 1;
-    }
-  } else {
-    id = -1;
+  first = id_bmp_find(allocator, 0, false);
+  if (first == ID_BMP_NONE) {
+    return -1;
   }
 
-  return id;
+  return allocator->zero_based ? first : first + 1;
 }
 
 /**
@@ -284,14 +406,11 @@ int bf_id_allocator_get_first(bf_id_allocator *a) {
   */
 int bf_id_allocator_get_next(bf_id_allocator *a, unsigned int id) {
   bf_id_allocator_int *allocator = (bf_id_allocator_int *)a;
-  int Rc_int;
-  Word_t curr_id = id;
-  unsigned int id_next = 0;
+  uint64_t curr_id = id, next;
 
   if (allocator == NULL) {
     return -1;
   }
-  bf_sys_assert(allocator != NULL);
   if (allocator->zero_based != true) {
     if (curr_id > 0) {
       curr_id = curr_id - 1;
@@ -299,18 +418,233 @@ int bf_id_allocator_get_next(bf_id_allocator *a, unsigned int id) {
       return -1;
     }
   }
-  J1N(Rc_int, allocator->PJ1Array, curr_id);
-  if (Rc_int) {
-    if (allocator->zero_based != true) {
-      id_next = curr_id + 1;
-    } else {
-      id_next = curr_id;
+  next = id_bmp_find(allocator, curr_id + 1, false);
+  if (next == ID_BMP_NONE) {
+    return -1;
+  }
+
+  return allocator->zero_based ? next : next + 1;
+}
+
+/* Concurrent allocator.  Ids are reserved from the shared bitmap a leaf word
+ * at a time into one of ID_MT_SLOT_CNT per-thread slots; threads are hashed
+ * onto the slots round-robin.  Reserved ids are marked allocated in the shared
+ * bitmap so the shared lock is only taken once per reserved word. */
+#define ID_MT_SLOT_CNT 16
+
+typedef struct id_mt_slot_t {
+  bf_sys_mutex_t lock;
+  uint64_t base; /* First id of the reserved word */
+  uint64_t mask; /* Reserved ids not handed out yet */
+} __attribute__((aligned(64))) id_mt_slot_t;
+
+typedef struct bf_id_allocator_mt_int {
+  bf_sys_mutex_t lock;
+  bf_id_allocator_int *bmp;
+  id_mt_slot_t slots[ID_MT_SLOT_CNT];
+} bf_id_allocator_mt_int;
+
+/* Slot index of the calling thread, assigned on first use */
+static __thread int id_mt_slot_idx = -1;
+static volatile uint32_t id_mt_slot_next_idx = 0;
+
+static id_mt_slot_t *id_mt_slot_get(bf_id_allocator_mt_int *a) {
+  if (id_mt_slot_idx < 0) {
+    id_mt_slot_idx =
+        __sync_fetch_and_add(&id_mt_slot_next_idx, 1) % ID_MT_SLOT_CNT;
+  }
+  return &a->slots[id_mt_slot_idx];
+}
+
+/* Reserves all free ids of the first leaf word which has any.  Called with the
+ * slot lock held. */
+static void id_mt_slot_refill(bf_id_allocator_mt_int *a, id_mt_slot_t *slot) {
+  bf_id_allocator_int *bmp = a->bmp;
+  uint64_t first, w, val, free_ids;
+
+  bf_sys_mutex_lock(&a->lock);
+  first = id_bmp_find(bmp, 0, true);
+  if (first < bmp->size) {
+    w = first >> 6;
+    val = id_bmp_leaf(bmp, w);
+    free_ids = ~val;
+    if ((w + 1) * 64 > bmp->size) {
+      free_ids &= (1ull << (bmp->size & 63)) - 1;
     }
+    if (id_bmp_word_set(bmp, w, val | free_ids)) {
+      slot->base = w * 64;
+      slot->mask = free_ids;
+    }
+  }
+  bf_sys_mutex_unlock(&a->lock);
+}
+
+/* Takes an id reserved by another slot once the shared bitmap is exhausted. */
+static int64_t id_mt_steal(bf_id_allocator_mt_int *a, id_mt_slot_t *own) {
+  int i;
+  for (i = 0; i < ID_MT_SLOT_CNT; i++) {
+    id_mt_slot_t *other = &a->slots[i];
+    int64_t id = -1;
+    if (other == own || !other->mask) continue;
+    /* Never wait on another slot while holding our own. */
+    if (bf_sys_mutex_trylock(&other->lock)) continue;
+    if (other->mask) {
+      id = other->base + __builtin_ctzll(other->mask);
+      other->mask &= other->mask - 1;
+    }
+    bf_sys_mutex_unlock(&other->lock);
+    if (id >= 0) return id;
+  }
+  return -1;
+}
+
+/**
+Create a concurrent ID allocator
+@param size number of ids in the allocator
+@param zero_based first id is 0 when true, 1 otherwise
+*/
+bf_id_allocator_mt *bf_id_allocator_mt_new(unsigned int size,
+                                           bool zero_based) {
+  bf_id_allocator_mt_int *a = bf_sys_calloc(1, sizeof *a);
+  int i;
+
+  if (!a) return NULL;
+  a->bmp = id_bmp_new(size, zero_based);
+  if (!a->bmp) {
+    bf_sys_free(a);
+    return NULL;
+  }
+  bf_sys_mutex_init(&a->lock);
+  for (i = 0; i < ID_MT_SLOT_CNT; i++) bf_sys_mutex_init(&a->slots[i].lock);
+  return (bf_id_allocator_mt *)a;
+}
+
+/**
+Delete a concurrent ID allocator
+@param allocator allocator created with bf_id_allocator_mt_new
+*/
+void bf_id_allocator_mt_destroy(bf_id_allocator_mt *allocator) {
+  bf_id_allocator_mt_int *a = (bf_id_allocator_mt_int *)allocator;
+  int i;
+
+  for (i = 0; i < ID_MT_SLOT_CNT; i++) bf_sys_mutex_del(&a->slots[i].lock);
+  bf_sys_mutex_del(&a->lock);
+  id_bmp_destroy(a->bmp);
+  bf_sys_free(a);
+}
+
+/**
+Allocate an id, safe to call from multiple threads
+@param allocator allocator created with bf_id_allocator_mt_new
+@return the id or -1 if none are free
+*/
+int bf_id_allocator_mt_allocate(bf_id_allocator_mt *allocator) {
+  bf_id_allocator_mt_int *a = (bf_id_allocator_mt_int *)allocator;
+  id_mt_slot_t *slot;
+  int64_t id = -1;
+
+  bf_sys_assert(a != NULL);
+  slot = id_mt_slot_get(a);
+  bf_sys_mutex_lock(&slot->lock);
+  if (!slot->mask) id_mt_slot_refill(a, slot);
+  if (slot->mask) {
+    id = slot->base + __builtin_ctzll(slot->mask);
+    slot->mask &= slot->mask - 1;
   } else {
-    id_next = -1;
+    id = id_mt_steal(a, slot);
   }
+  bf_sys_mutex_unlock(&slot->lock);
 
-  return id_next;
+  if (id < 0) return -1;
+  return a->bmp->zero_based ? id : id + 1;
+}
+
+/**
+Free an id allocated with bf_id_allocator_mt_allocate
+@param allocator allocator created with bf_id_allocator_mt_new
+@param id id to be freed up
+*/
+void bf_id_allocator_mt_release(bf_id_allocator_mt *allocator,
+                                unsigned int id) {
+  bf_id_allocator_mt_int *a = (bf_id_allocator_mt_int *)allocator;
+  id_mt_slot_t *slot;
+  uint64_t i = id;
+
+  bf_sys_assert(a != NULL);
+  if (a->bmp->zero_based != true) {
+    bf_sys_assert(id > 0);
+    i = i - 1;
+  }
+
+  /* Ids from the word this thread has reserved go straight back to it. */
+  slot = id_mt_slot_get(a);
+  bf_sys_mutex_lock(&slot->lock);
+  if (slot->mask && i - slot->base < 64) {
+    slot->mask |= 1ull << (i - slot->base);
+    bf_sys_mutex_unlock(&slot->lock);
+    return;
+  }
+  bf_sys_mutex_unlock(&slot->lock);
+
+  bf_sys_mutex_lock(&a->lock);
+  id_bmp_clear(a->bmp, i);
+  bf_sys_mutex_unlock(&a->lock);
+}
+
+/**
+Check whether an id is allocated, ids reserved but not yet handed out by any
+thread count as free
+@param allocator allocator created with bf_id_allocator_mt_new
+@param id id to check
+*/
+int bf_id_allocator_mt_is_set(bf_id_allocator_mt *allocator, unsigned int id) {
+  bf_id_allocator_mt_int *a = (bf_id_allocator_mt_int *)allocator;
+  uint64_t i = id;
+  bool set;
+  int s;
+
+  bf_sys_assert(a != NULL);
+  if (a->bmp->zero_based != true) {
+    if (id < 1) return 0;
+    i = i - 1;
+  }
+
+  bf_sys_mutex_lock(&a->lock);
+  set = id_bmp_test(a->bmp, i);
+  bf_sys_mutex_unlock(&a->lock);
+  for (s = 0; s < ID_MT_SLOT_CNT && set; s++) {
+    id_mt_slot_t *slot = &a->slots[s];
+    bf_sys_mutex_lock(&slot->lock);
+    if (slot->mask && i - slot->base < 64 &&
+        (slot->mask >> (i - slot->base)) & 1) {
+      set = false;
+    }
+    bf_sys_mutex_unlock(&slot->lock);
+  }
+  return set ? 1 : 0;
+}
+
+/**
+Return all ids reserved by threads but not handed out to the shared bitmap
+@param allocator allocator created with bf_id_allocator_mt_new
+*/
+void bf_id_allocator_mt_flush(bf_id_allocator_mt *allocator) {
+  bf_id_allocator_mt_int *a = (bf_id_allocator_mt_int *)allocator;
+  int s;
+
+  bf_sys_assert(a != NULL);
+  for (s = 0; s < ID_MT_SLOT_CNT; s++) {
+    id_mt_slot_t *slot = &a->slots[s];
+    bf_sys_mutex_lock(&slot->lock);
+    if (slot->mask) {
+      uint64_t w = slot->base >> 6;
+      bf_sys_mutex_lock(&a->lock);
+      id_bmp_word_set(a->bmp, w, id_bmp_leaf(a->bmp, w) & ~slot->mask);
+      bf_sys_mutex_unlock(&a->lock);
+      slot->mask = 0;
+    }
+    bf_sys_mutex_unlock(&slot->lock);
+  }
 }
 
 /**
@@ -16,6 +16,7 @@
 #include <target-utils/map/map.h>
 #include "map_log.h"
 #include <Judy.h>
+#include <stdbool.h>
 #include <target-sys/bf_sal/bf_sys_intf.h>
 
 bf_map_sts_t bf_map_init(bf_map_t *map) {
@@ -144,3 +145,144 @@ uint32_t bf_map_count(bf_map_t *map) {
   JLC(count, (*map), 0, -1);
   return (uint32_t)count;
 }
+
+int bf_map_get_many(bf_map_t *map,
+                    const unsigned long *keys,
+                    int cnt,
+                    void **data) {
+  PWord_t Pvalue = NULL;
+  /* Smallest key present in the map which is >= the previously searched key,
+   * valid while have_next is set.  Any sorted key below it is known to be
+   * absent and does not need a lookup, and the search for a larger key
+   * continues from it. */
+  unsigned long next = 0;
+  bool have_next = false, at_end = false;
+  int i, found = 0;
+
+  if (!map || !keys || !data || cnt < 0) return -1;
+
+  for (i = 0; i < cnt; ++i) {
+    unsigned long key = keys[i];
+    data[i] = NULL;
+    if (i && key < keys[i - 1]) {
+      /* Out of order, restart the search from this key. */
+      have_next = false;
+      at_end = false;
+    }
+    if (at_end) continue;
+    if (have_next && key < next) continue;
+    if (!have_next || key > next) {
+      if (have_next) {
+        /* Step to the key following the last one found, for dense ascending
+         * keys that is the wanted key and needs no search of its own. */
+        JLN(Pvalue, (*map), next);
+        if (Pvalue && PJERR != Pvalue && next < key) {
+          next = key;
+          JLF(Pvalue, (*map), next);
+        }
+      } else {
+        next = key;
+        JLF(Pvalue, (*map), next);
+      }
+      if (PJERR == Pvalue) {
+        bf_sys_dbgchk(PJERR != Pvalue);
+        return -1;
+      } else if (NULL == Pvalue) {
+        at_end = true;
+        continue;
+      }
+      have_next = true;
+    }
+    if (key == next) {
+      data[i] = (void *)(*Pvalue);
+      ++found;
+    }
+  }
+  return found;
+}
+
+int bf_map_get_range(bf_map_t *map,
+                     unsigned long *cursor,
+                     unsigned long end,
+                     bf_map_pair_t *pairs,
+                     int max,
+                     bool *done) {
+  PWord_t Pvalue;
+  unsigned long key;
+  int n = 0;
+
+  if (!map || !cursor || !pairs || !done || max <= 0) return -1;
+  *done = true;
+  key = *cursor;
+  if (key > end) return 0;
+
+  /* Look one key past the last one returned, so the end of the range is
+   * known without a cursor value past it, which would not exist for a range
+   * ending at the largest key. */
+  JLF(Pvalue, (*map), key);
+  while (Pvalue && PJERR != Pvalue && key <= end && n < max) {
+    pairs[n].key = key;
+    pairs[n].data = (void *)(*Pvalue);
+    ++n;
+    JLN(Pvalue, (*map), key);
+  }
+  if (PJERR == Pvalue) {
+    bf_sys_dbgchk(PJERR != Pvalue);
+    return -1;
+  }
+
+  if (Pvalue && key <= end) {
+    *cursor = key;
+    *done = false;
+  }
+  return n;
+}
+
+bf_map_sts_t bf_map_add_sorted(bf_map_t *map,
+                               const unsigned long *keys,
+                               void *const *data,
+                               int cnt) {
+  PWord_t Pvalue;
+  int i;
+
+  if (!map || cnt < 0 || (cnt && (!keys || !data))) return BF_MAP_ERR;
+  if (!cnt) return BF_MAP_OK;
+
+  for (i = 1; i < cnt; ++i) {
+    if (keys[i] <= keys[i - 1]) return BF_MAP_ERR;
+  }
+
+  if (NULL == *map) {
+    /* Empty map, build it directly from the sorted run. */
+    int rc = JudyLInsArray(
+        (PPvoid_t)map, (Word_t)cnt, (const Word_t *)keys, (const Word_t *)data,
+        PJE0);
+    if (1 != rc) {
+      bf_sys_dbgchk(1 == rc);
+      return BF_MAP_ERR;
+    }
+    return BF_MAP_OK;
+  }
+
+  /* Check for collisions first so the add is all or nothing. */
+  for (i = 0; i < cnt; ++i) {
+    JLG(Pvalue, (*map), keys[i]);
+    if (PJERR == Pvalue) {
+      bf_sys_dbgchk(PJERR != Pvalue);
+      return BF_MAP_ERR;
+    } else if (NULL != Pvalue) {
+      return BF_MAP_KEY_EXISTS;
+    }
+  }
+  for (i = 0; i < cnt; ++i) {
+    JLI(Pvalue, (*map), keys[i]);
+    if (PJERR == Pvalue) {
+      bf_sys_dbgchk(PJERR != Pvalue);
+      /* Back out what was added so far. */
+      while (i--) bf_map_rmv(map, keys[i]);
+      return BF_MAP_ERR;
+    }
+    *Pvalue = (Word_t)data[i];
+  }
+  return BF_MAP_OK;
+}